@@ -0,0 +1,577 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+/**
+ * @file sqlogger_bench.cpp
+ * @brief Throughput and latency scenarios of SQLogger (Google Benchmark).
+ *
+ * Write scenarios report the enqueue latency of a log call (p50_ns, p99_ns, p999_ns)
+ * and the sustained rate until the entries are durable (rows_per_s). Read and export
+ * scenarios run against a table of --sqlg_rows prepared entries. Use
+ * --benchmark_format=json (or --benchmark_out=<file> --benchmark_out_format=json)
+ * for machine-readable output.
+ *
+ * Options (besides the --benchmark_* ones):
+ * --sqlg_entries=N  Entries logged per iteration of a write scenario.
+ * --sqlg_rows=N     Rows of the read/export table.
+ * --sqlg_host, --sqlg_port, --sqlg_user, --sqlg_pass, --sqlg_name
+ *                   MySQL/PostgreSQL server (those backends are skipped without --sqlg_host).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "sqlogger/log_manager.h"
+
+#define BENCH_DEFAULT_ENTRIES 20000 /**< Default entries logged per iteration of a write scenario. */
+#define BENCH_DEFAULT_ROWS 50000 /**< Default rows of the read/export table. */
+#define BENCH_ITERATIONS 3 /**< Iterations of every scenario. */
+#define BENCH_MESSAGE_SIZE 64 /**< Message size of the scenarios that do not sweep it. */
+#define BENCH_BATCH_SIZE 1000 /**< Batch size of the scenarios that do not sweep it. */
+#define BENCH_DISTINCT_VALUES 8 /**< Distinct files, functions and thread IDs of the read table. */
+#define BENCH_BASE_TIMESTAMP_US 1735732800000000LL /**< Timestamp of the first row of the read table (one row per millisecond). */
+#define BENCH_DATABASE_FILE "sqlogger_bench.db"
+#define BENCH_EXPORT_FILE "sqlogger_bench_export"
+#define BENCH_DURABLE_TIMEOUT_MSEC 600000
+
+namespace
+{
+    /**
+     * @struct BenchOptions
+     * @brief Command line options of the benchmark.
+     */
+    struct BenchOptions
+    {
+        size_t entries = BENCH_DEFAULT_ENTRIES; /**< Entries logged per write iteration. */
+        size_t rows = BENCH_DEFAULT_ROWS; /**< Rows of the read/export table. */
+        std::string host; /**< Server host (empty = server backends skipped). */
+        int port = 0; /**< Server port (0 = backend default). */
+        std::string user; /**< Server user. */
+        std::string pass; /**< Server password. */
+        std::string name = "sqlogger_bench"; /**< Server database name. */
+    };
+
+    BenchOptions options;
+
+    /**
+     * @enum WriteMode
+     * @brief Write path of a write scenario.
+     */
+    enum class WriteMode
+    {
+        Sync,  /**< Synchronous writes from the calling thread. */
+        Async, /**< Asynchronous writes by the thread pool. */
+        Batch  /**< Asynchronous batched writes. */
+    };
+
+    /**
+     * @brief Gets the name of a write mode.
+     * @param mode Write mode.
+     * @return const char* Name.
+     */
+    const char* modeName(const WriteMode mode)
+    {
+        switch(mode)
+        {
+            case WriteMode::Sync:
+                return "sync";
+            case WriteMode::Async:
+                return "async";
+            default:
+                return "batch";
+        }
+    }
+
+    /**
+     * @brief Builds the logger configuration of a scenario.
+     * @param type Database type.
+     * @param name Logger and table name.
+     * @return LogConfig::Config Configuration.
+     */
+    LogConfig::Config makeConfig(const DataBaseType type, const std::string& name)
+    {
+        LogConfig::Config config;
+        config.name = name;
+        config.databaseType = type;
+        config.databaseTable = name;
+        config.syncMode = true;
+        config.useBatch = false;
+        config.batchSize = BENCH_BATCH_SIZE;
+        config.onlyFileNames = true;
+        config.minLogLevel = LogLevel::Trace;
+        config.numThreads = LOG_DEFAULT_NUM_THREADS;
+
+        if(type == DataBaseType::MySQL || type == DataBaseType::PostgreSQL)
+        {
+            config.databaseName = options.name;
+            config.databaseHost = options.host;
+            config.databaseUser = options.user;
+            config.databasePass = options.pass;
+            if(options.port > 0)
+            {
+                config.databasePort = options.port;
+            }
+        }
+        else
+        {
+            config.databaseName = BENCH_DATABASE_FILE;
+        }
+
+        if(type == DataBaseType::Memory)
+        {
+            // Keep every row: read scenarios expect the whole table
+            config.memoryMaxBytes = 0;
+        }
+        return config;
+    }
+
+    /**
+     * @brief Reports latency percentiles of the samples as counters.
+     * @param state Benchmark state.
+     * @param samples Latencies in nanoseconds (sorted in place).
+     */
+    void setLatencyCounters(benchmark::State& state, std::vector<int64_t> & samples)
+    {
+        if(samples.empty())
+        {
+            return;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](const double p)
+        {
+            const size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+            return static_cast<double>(samples[index]);
+        };
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+    }
+
+    /**
+     * @brief Write scenario: producers log entries, the iteration ends when they are durable.
+     * @param state Benchmark state.
+     * @param type Database type.
+     * @param mode Write path.
+     * @param threads Producer threads.
+     * @param batchSize Batch size (WriteMode::Batch).
+     * @param messageSize Message size in bytes.
+     */
+    void benchWrite(benchmark::State& state, const DataBaseType type, const WriteMode mode,
+                    const int threads, const int batchSize, const size_t messageSize)
+    {
+        const std::string name = "bench_write";
+        LogConfig::Config config = makeConfig(type, name);
+        config.syncMode = mode == WriteMode::Sync;
+        config.useBatch = mode == WriteMode::Batch;
+        config.batchSize = batchSize;
+
+        SQLogger& logger = LogManager::getInstance().createLogger(name, config);
+        logger.clearLogs();
+
+        const std::string message(messageSize, 'x');
+        const size_t perThread = std::max<size_t>(options.entries / threads, 1);
+        std::vector<int64_t> samples;
+        samples.reserve(perThread * threads * BENCH_ITERATIONS);
+        double seconds = 0.0;
+        size_t rows = 0;
+
+        for(auto _ : state)
+        {
+            std::vector<std::vector<int64_t>> latencies(threads);
+            const auto start = std::chrono::steady_clock::now();
+
+            std::vector<std::thread> producers;
+            for(int t = 0; t < threads; ++t)
+            {
+                producers.emplace_back([&logger, &message, &latencies, perThread, t]()
+                {
+                    std::vector<int64_t> & out = latencies[t];
+                    out.reserve(perThread);
+                    for(size_t i = 0; i < perThread; ++i)
+                    {
+                        const auto callStart = std::chrono::steady_clock::now();
+                        SQLOG_INFO(logger) << message;
+                        out.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now() - callStart).count());
+                    }
+                });
+            }
+            for(auto & producer : producers)
+            {
+                producer.join();
+            }
+
+            if(!logger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(BENCH_DURABLE_TIMEOUT_MSEC)))
+            {
+                state.SkipWithError("Entries were not written in time");
+                break;
+            }
+
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            state.SetIterationTime(elapsed);
+            seconds += elapsed;
+            rows += perThread * threads;
+
+            for(auto & threadLatencies : latencies)
+            {
+                samples.insert(samples.end(), threadLatencies.begin(), threadLatencies.end());
+            }
+
+            // Outside the measured (manual) time
+            logger.clearLogs();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(rows));
+        state.counters["rows_per_s"] = seconds > 0.0 ? rows / seconds : 0.0;
+        setLatencyCounters(state, samples);
+
+        LogManager::getInstance().removeLogger(name);
+    }
+
+    /**
+     * @brief Gets the logger of the read/export table, filling the table on first use.
+     * @param type Database type.
+     * @return SQLogger& Logger.
+     */
+    SQLogger& getReadLogger(const DataBaseType type)
+    {
+        static std::map<DataBaseType, SQLogger*> loggers;
+        auto it = loggers.find(type);
+        if(it != loggers.end())
+        {
+            return * it->second;
+        }
+
+        const std::string name = "bench_read_" + DataBaseHelper::databaseTypeToString(type);
+        LogConfig::Config config = makeConfig(type, "bench_read");
+        config.name = name;
+        config.useBatch = true;
+        config.batchSize = std::min(BENCH_BATCH_SIZE, std::max(DataBaseHelper::getMaxBatchSize(type), 1));
+
+        SQLogger& logger = LogManager::getInstance().createLogger(name, config);
+        logger.clearLogs();
+
+        const LogLevel levels[] = { LogLevel::Debug, LogLevel::Info, LogLevel::Warning, LogLevel::Error };
+        LogEntryList entries;
+        entries.reserve(BENCH_BATCH_SIZE);
+        for(size_t i = 0; i < options.rows; ++i)
+        {
+            LogEntry entry{};
+            entry.timestampUs = BENCH_BASE_TIMESTAMP_US + static_cast<int64_t>(i) * 1000;
+            entry.level = LogHelper::levelToString(levels[i % 4]);
+            entry.message = "Bench message " + std::to_string(i);
+            entry.function = "function_" + std::to_string(i % BENCH_DISTINCT_VALUES);
+            entry.file = "file_" + std::to_string(i % BENCH_DISTINCT_VALUES) + ".cpp";
+            entry.line = static_cast<int>(i % 1000);
+            entry.threadId = "thread_" + std::to_string(i % BENCH_DISTINCT_VALUES);
+            entries.push_back(std::move(entry));
+
+            if(entries.size() == BENCH_BATCH_SIZE)
+            {
+                logger.logEntries(entries);
+                entries.clear();
+            }
+        }
+        logger.logEntries(entries);
+        logger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(BENCH_DURABLE_TIMEOUT_MSEC));
+
+        loggers[type] = & logger;
+        return logger;
+    }
+
+    /**
+     * @brief Builds the filters of a read scenario.
+     * @param logger Logger of the read table.
+     * @param type Filter type.
+     * @return std::vector<Filter> Filters.
+     */
+    std::vector<Filter> makeFilters(SQLogger& logger, const Filter::Type type)
+    {
+        auto makeFilter = [type](const std::string & op, const std::string & value)
+        {
+            Filter filter;
+            filter.type = type;
+            filter.field = filter.typeToField();
+            filter.op = op;
+            filter.value = value;
+            return filter;
+        };
+
+        const std::string distinct = std::to_string(BENCH_DISTINCT_VALUES / 2);
+        switch(type)
+        {
+            case Filter::Type::Level:
+                return { makeFilter("=", LogHelper::levelToString(LogLevel::Warning)) };
+            case Filter::Type::File:
+                return { makeFilter("=", "file_" + distinct + ".cpp") };
+            case Filter::Type::Function:
+                return { makeFilter("=", "function_" + distinct) };
+            case Filter::Type::ThreadId:
+                return { makeFilter("=", "thread_" + distinct) };
+            case Filter::Type::TimestampRange:
+            {
+                // About the middle fifth of the table (the text column has a resolution of seconds)
+                const auto base = std::chrono::system_clock::time_point(std::chrono::microseconds(BENCH_BASE_TIMESTAMP_US));
+                const int64_t rows = static_cast<int64_t>(options.rows);
+                return
+                {
+                    makeFilter(">=", LogHelper::formatTime(base + std::chrono::microseconds(rows * 400))),
+                    makeFilter("<", LogHelper::formatTime(base + std::chrono::microseconds(rows * 600)))
+                };
+            }
+#ifdef SQLG_USE_SOURCE_INFO
+            case Filter::Type::SourceId:
+            {
+                const LogEntryList first = logger.getAllLogs(1);
+                return { makeFilter("=", std::to_string(first.empty() ? 0 : first.front().sourceId)) };
+            }
+#endif
+            default:
+                return {};
+        }
+    }
+
+    /**
+     * @brief Read scenario: one filtered query per iteration.
+     * @param state Benchmark state.
+     * @param type Database type.
+     * @param filterType Filter type.
+     */
+    void benchRead(benchmark::State& state, const DataBaseType type, const Filter::Type filterType)
+    {
+        SQLogger& logger = getReadLogger(type);
+        const std::vector<Filter> filters = makeFilters(logger, filterType);
+        size_t rows = 0;
+        double seconds = 0.0;
+
+        for(auto _ : state)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const LogEntryList result = logger.getLogsByFilters(filters);
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            state.SetIterationTime(elapsed);
+            seconds += elapsed;
+            rows += result.size();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(rows));
+        state.counters["rows_per_s"] = seconds > 0.0 ? rows / seconds : 0.0;
+    }
+
+    /**
+     * @brief Export scenario: the whole table is exported once per iteration.
+     * @param state Benchmark state.
+     * @param type Database type.
+     * @param format Export format.
+     */
+    void benchExport(benchmark::State& state, const DataBaseType type, const LogExport::Format format)
+    {
+        SQLogger& logger = getReadLogger(type);
+        const std::string filePath = BENCH_EXPORT_FILE;
+        size_t rows = 0;
+        double seconds = 0.0;
+
+        for(auto _ : state)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            rows += logger.exportLogs(filePath, format);
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            state.SetIterationTime(elapsed);
+            seconds += elapsed;
+        }
+
+        std::error_code error;
+        std::filesystem::remove(filePath, error);
+
+        state.SetItemsProcessed(static_cast<int64_t>(rows));
+        state.counters["rows_per_s"] = seconds > 0.0 ? rows / seconds : 0.0;
+    }
+
+    /**
+     * @brief Registers a scenario with the common settings.
+     * @tparam Function Scenario function.
+     * @tparam Args Scenario arguments.
+     * @param name Scenario name.
+     * @param function Scenario function.
+     * @param args Scenario arguments.
+     */
+    template<typename Function, typename... Args>
+    void registerScenario(const std::string& name, Function function, Args... args)
+    {
+        benchmark::RegisterBenchmark(name.c_str(), function, args...)
+        ->Iterations(BENCH_ITERATIONS)
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+    }
+
+    /**
+     * @brief Registers every scenario of a database type.
+     * @param type Database type.
+     */
+    void registerScenarios(const DataBaseType type)
+    {
+        const std::string db = DataBaseHelper::databaseTypeToString(type);
+        const int maxBatch = DataBaseHelper::getMaxBatchSize(type);
+        const bool batching = maxBatch > 0;
+        const WriteMode sweepMode = batching ? WriteMode::Batch : WriteMode::Async;
+        const int batchSize = batching ? std::min(BENCH_BATCH_SIZE, maxBatch) : 1;
+
+        for(const WriteMode mode : { WriteMode::Sync, WriteMode::Async, WriteMode::Batch })
+        {
+            if(mode == WriteMode::Batch && !batching) continue;
+            registerScenario("write_mode/" + db + "/" + modeName(mode), benchWrite,
+                             type, mode, 1, batchSize, static_cast<size_t>(BENCH_MESSAGE_SIZE));
+        }
+
+        for(const int threads : { 1, 2, 4, 8 })
+        {
+            registerScenario("write_threads/" + db + "/" + modeName(sweepMode) + "/threads:" + std::to_string(threads), benchWrite,
+                             type, sweepMode, threads, batchSize, static_cast<size_t>(BENCH_MESSAGE_SIZE));
+        }
+
+        if(batching)
+        {
+            for(const int size : { 10, 100, 1000, 5000 })
+            {
+                if(size > maxBatch) continue;
+                registerScenario("write_batch/" + db + "/batch:" + std::to_string(size), benchWrite,
+                                 type, WriteMode::Batch, 1, size, static_cast<size_t>(BENCH_MESSAGE_SIZE));
+            }
+        }
+
+        for(const size_t bytes : { 16, 256, 4096 })
+        {
+            registerScenario("write_message/" + db + "/" + modeName(sweepMode) + "/bytes:" + std::to_string(bytes), benchWrite,
+                             type, sweepMode, 1, batchSize, bytes);
+        }
+
+        // The mock backend only measures the logging path
+        if(type == DataBaseType::Mock)
+        {
+            return;
+        }
+
+        const std::pair<Filter::Type, const char*> filterTypes[] =
+        {
+            { Filter::Type::Level, "level" },
+            { Filter::Type::File, "file" },
+            { Filter::Type::Function, "function" },
+            { Filter::Type::ThreadId, "thread_id" },
+            { Filter::Type::TimestampRange, "timestamp_range" }
+#ifdef SQLG_USE_SOURCE_INFO
+            , { Filter::Type::SourceId, "source_id" }
+#endif
+        };
+        for(const auto & filterType : filterTypes)
+        {
+            registerScenario("read/" + db + "/" + filterType.second, benchRead, type, filterType.first);
+        }
+
+        const std::pair<LogExport::Format, const char*> formats[] =
+        {
+            { LogExport::Format::TXT, "txt" },
+            { LogExport::Format::CSV, "csv" },
+            { LogExport::Format::XML, "xml" },
+            { LogExport::Format::JSON, "json" },
+            { LogExport::Format::YAML, "yaml" },
+            { LogExport::Format::NDJSON, "ndjson" },
+            { LogExport::Format::BINARY, "binary" }
+        };
+        for(const auto & format : formats)
+        {
+            registerScenario("export/" + db + "/" + format.second, benchExport, type, format.first);
+        }
+    }
+
+    /**
+     * @brief Takes the --sqlg_* options out of the command line.
+     * @param argc Argument count (updated).
+     * @param argv Arguments (updated).
+     */
+    void parseOptions(int& argc, char** argv)
+    {
+        int kept = 1;
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            auto value = [&arg](const std::string & key, std::string & out)
+            {
+                const std::string prefix = "--sqlg_" + key + "=";
+                if(arg.rfind(prefix, 0) != 0) return false;
+                out = arg.substr(prefix.size());
+                return true;
+            };
+
+            std::string text;
+            if(value("entries", text)) options.entries = std::max(std::stoul(text), 1UL);
+            else if(value("rows", text)) options.rows = std::max(std::stoul(text), 1UL);
+            else if(value("host", text)) options.host = text;
+            else if(value("port", text)) options.port = std::stoi(text);
+            else if(value("user", text)) options.user = text;
+            else if(value("pass", text)) options.pass = text;
+            else if(value("name", text)) options.name = text;
+            else argv[kept++] = argv[i];
+        }
+        argc = kept;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize( & argc, argv);
+    parseOptions(argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    std::vector<DataBaseType> types = { DataBaseType::Mock, DataBaseType::Memory, DataBaseType::SQLite };
+    if(!options.host.empty())
+    {
+#ifdef SQLG_USE_MYSQL
+        types.push_back(DataBaseType::MySQL);
+#endif
+#ifdef SQLG_USE_POSTGRESQL
+        types.push_back(DataBaseType::PostgreSQL);
+#endif
+    }
+
+    std::error_code error;
+    std::filesystem::remove(BENCH_DATABASE_FILE, error);
+
+    for(const DataBaseType type : types)
+    {
+        registerScenarios(type);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    LogManager::getInstance().removeAllLoggers();
+    std::filesystem::remove(BENCH_DATABASE_FILE, error);
+    return 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef MEMORY_DATABASE_H
+#define MEMORY_DATABASE_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/internal/log_strings.h"
+#include "sqlogger/database/database_interface.h"
+
+#define MEMORY_CHUNK_ROWS 4096 /**< Rows per column chunk; whole chunks are evicted. */
+#define MEMORY_DEFAULT_MAX_BYTES (64LL << 20) /**< Memory budget of a log table used when MaxBytes is not given. */
+#define MEMORY_IN_SEPARATOR ',' /**< Separator of the values of IN / NOT IN filters. */
+
+/**
+ * @class MemoryDatabase
+ * @brief In-process log storage without SQL, for benchmarks and short-lived jobs.
+ * Each log table is a ring of column chunks (ids, timestamps, levels, ...) with a fixed
+ * memory budget: once it is exceeded, the oldest chunks are evicted. Function, file,
+ * thread ID and level values are interned in a per-table string pool, so a filter on
+ * them is evaluated once per distinct value instead of once per row.
+ * Connections with the same database name share the data while at least one is open.
+ * The connection string is "Name=<name>;MaxBytes=<bytes>" (both keys optional).
+ * @note SQL is not supported: execute() fails and query() returns no rows, transactions are not available.
+ */
+class MemoryDatabase : public IDatabase
+{
+    public:
+        /**
+         * @brief Constructs a MemoryDatabase object and connects it.
+         * @param connectionString "Name=<name>;MaxBytes=<bytes>", see connect().
+         */
+        explicit MemoryDatabase(const std::string& connectionString);
+
+        /**
+         * @brief Destructor for MemoryDatabase.
+         */
+        ~MemoryDatabase();
+
+        /**
+         * @brief Opens the named in-memory database, creating it if no connection has it open.
+         * @param connectionString "Name=<name>;MaxBytes=<bytes>"; the budget of an already open
+         * database is kept. A value without '=' is taken as the name.
+         * @return True if the connection was successful, false otherwise.
+         */
+        bool connect(const std::string& connectionString) override;
+
+        /**
+         * @brief Disconnects from the database; the data is released with the last connection.
+         */
+        void disconnect() override;
+
+        /**
+         * @brief Checks if the database is connected.
+         * @return True if the database is connected, false otherwise.
+         */
+        bool isConnected() const override;
+
+        /**
+         * @brief Not supported: the memory database does not execute SQL.
+         * @return Always false (getLastError() returns ERR_MSG_MEMORY_NO_SQL).
+         */
+        bool execute(const std::string& query,
+                     const std::vector<std::string> & params = {},
+                     int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Not supported: the memory database does not execute SQL.
+         * @return Always an empty result.
+         */
+        std::vector<std::map<std::string, std::string>> query(const std::string& query,
+                const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Checks if the backend stores log entries natively.
+         * @return Always true.
+         */
+        bool supportsNativeLogs() const override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Appends log entries to the table, evicting the oldest chunks over the budget.
+         * @param table Log table name.
+         * @param entries Entries to store (id is assigned, source UUID and name are ignored).
+         * @return True if the entries were stored, false if not connected.
+         */
+        bool insertLogs(const std::string& table, const LogEntryList& entries) override;
+
+        /**
+         * @brief Passes the log entries matching the filters to a callback.
+         * Filters are compiled once per query; chunks outside a timestamp or ID range are skipped.
+         * @param table Log table name.
+         * @param filters Filters, combined with AND. IN / NOT IN take a comma-separated list,
+         * timestamps are compared in microseconds, LIKE is case-insensitive for ASCII (as in SQLite).
+         * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending, ties in ID order).
+         * @param limit Maximum number of entries (0 or negative = no limit).
+         * @param offset Number of entries to skip, requires a positive limit.
+         * @param callback Function called for each entry; return false to stop reading.
+         * @return size_t Number of entries passed to the callback.
+         * @throws std::invalid_argument If a filter field is not a log table column.
+         * @note The callback runs under the database read lock and must not write to this database.
+         */
+        size_t selectLogs(const std::string& table,
+                          const std::vector<Filter> & filters,
+                          const std::string& orderBy,
+                          const int limit,
+                          const int offset,
+                          const NativeLogCallback& callback) override;
+
+        /**
+         * @brief Removes all rows of a table; IDs are not reused.
+         * @param table Table name (the log table or SOURCES_TABLE_NAME).
+         * @return Always true if connected.
+         */
+        bool clearTable(const std::string& table) override;
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Stores a source.
+         * @param uuid Source UUID, unique.
+         * @param name Source name.
+         * @return int ID of the new source, or SOURCE_NOT_FOUND if the UUID exists.
+         */
+        int insertSource(const std::string& uuid, const std::string& name) override;
+
+        /**
+         * @brief Gets all sources ordered by ID.
+         * @return std::vector<SourceInfo> Stored sources.
+         */
+        std::vector<SourceInfo> selectSources() override;
+#endif
+
+        /**
+         * @brief Not supported: writes are applied immediately.
+         * @return Always false, so group commit falls back to single batches.
+         */
+        bool beginTransaction() override;
+
+        /**
+         * @brief Nothing to commit.
+         * @return Always true.
+         */
+        bool commitTransaction() override;
+
+        /**
+         * @brief Nothing to roll back.
+         * @return Always true.
+         */
+        bool rollbackTransaction() override;
+
+        /**
+         * @brief Gets the last error message.
+         * @return The last error message as a string.
+         */
+        std::string getLastError() const override;
+
+        /**
+        * @brief Drops all tables of the connected database.
+        * @param dbName Ignored; the connected database is cleared.
+        * @return True if connected, false otherwise.
+        */
+        bool dropDatabaseIfExists(const std::string& dbName) override;
+
+        /**
+         * @brief Gets the type of the database.
+         * @return DataBaseType::Memory.
+         */
+        DataBaseType getDatabaseType() const override;
+
+        /**
+         * @brief Gets the memory used by a log table (columns, messages and string pool).
+         * @param table Log table name.
+         * @return size_t Approximate size in bytes.
+         */
+        size_t getMemoryUsage(const std::string& table) const;
+
+        /**
+         * @brief Gets the number of rows evicted from a log table to stay within the budget.
+         * @param table Log table name.
+         * @return uint64_t Evicted rows since the table was created.
+         */
+        uint64_t getEvictedRows(const std::string& table) const;
+
+        /**
+         * @brief Gets the memory budget of each log table.
+         * @return size_t Budget in bytes.
+         */
+        size_t getMaxBytes() const;
+
+    private:
+        /**
+         * @struct StringPool
+         * @brief Interned values of a low-cardinality column.
+         */
+        struct StringPool
+        {
+            std::vector<std::string> values; /**< Id -> value. */
+            std::unordered_map<std::string, uint32_t> ids; /**< Value -> id. */
+            size_t bytes = 0; /**< Approximate memory used. */
+
+            /**
+             * @brief Gets the id of a value, adding it if new.
+             * @param value Value to intern.
+             * @return uint32_t Value id.
+             */
+            uint32_t intern(const std::string& value);
+        };
+
+        /**
+         * @struct Chunk
+         * @brief Up to MEMORY_CHUNK_ROWS consecutive rows stored column by column.
+         * Row i has the ID firstId + i.
+         */
+        struct Chunk
+        {
+            int64_t firstId = 0; /**< ID of the first row. */
+            int64_t minTimestampUs = 0; /**< Smallest timestamp of the chunk. */
+            int64_t maxTimestampUs = 0; /**< Largest timestamp of the chunk. */
+            std::vector<int64_t> timestampsUs; /**< Timestamps in microseconds. */
+            std::vector<int32_t> lines; /**< Line numbers. */
+#ifdef SQLG_USE_SOURCE_INFO
+            std::vector<int32_t> sourceIds; /**< Source IDs. */
+#endif
+            std::vector<uint32_t> levels; /**< Level pool ids. */
+            std::vector<uint32_t> functions; /**< Function pool ids. */
+            std::vector<uint32_t> files; /**< File pool ids. */
+            std::vector<uint32_t> threadIds; /**< Thread ID pool ids. */
+            std::string messages; /**< Message bytes of all rows. */
+            std::vector<uint32_t> messageEnds; /**< End offset of each message in messages. */
+
+            /**
+             * @brief Gets the number of rows.
+             * @return size_t Row count.
+             */
+            size_t rows() const
+            {
+                return timestampsUs.size();
+            }
+
+            /**
+             * @brief Gets the approximate memory used by the chunk.
+             * @return size_t Size in bytes.
+             */
+            size_t bytes() const;
+        };
+
+        /**
+         * @struct Table
+         * @brief Log table: chunk ring and string pools.
+         */
+        struct Table
+        {
+            std::deque<Chunk> chunks; /**< Oldest chunk first. */
+            StringPool levels; /**< Level values. */
+            StringPool functions; /**< Function values. */
+            StringPool files; /**< File values. */
+            StringPool threadIds; /**< Thread ID values. */
+            int64_t nextId = 1; /**< ID of the next row. */
+            size_t sealedBytes = 0; /**< Memory used by all chunks but the last. */
+            int64_t lastTimestampUs = 0; /**< Timestamp of the last appended row. */
+            bool timestampOrdered = true; /**< Rows were appended in timestamp order (no sort needed). */
+            uint64_t evictedRows = 0; /**< Rows dropped to stay within the budget. */
+
+            /**
+             * @brief Gets the approximate memory used by the table.
+             * @return size_t Size in bytes.
+             */
+            size_t bytes() const;
+        };
+
+        /**
+         * @struct Store
+         * @brief Data of one named database, shared by its connections.
+         */
+        struct Store
+        {
+            mutable std::shared_mutex mutex; /**< Readers share, writers are exclusive. */
+            size_t maxBytes = MEMORY_DEFAULT_MAX_BYTES; /**< Budget of each log table. */
+            std::map<std::string, Table> tables; /**< Log tables by name. */
+#ifdef SQLG_USE_SOURCE_INFO
+            std::vector<SourceInfo> sources; /**< Sources ordered by ID. */
+            int nextSourceId = 1; /**< ID of the next source. */
+#endif
+        };
+
+        struct Predicate;
+
+        /**
+         * @brief Compiles a filter against the string pools of a table.
+         * @param table The table.
+         * @param filter The filter.
+         * @return Predicate Compiled filter.
+         * @throws std::invalid_argument If the filter field is not a log table column.
+         */
+        static Predicate compile(const Table& table, const Filter& filter);
+
+        /**
+         * @brief Evaluates the compiled filters on a row.
+         * @param predicates Compiled filters.
+         * @param chunk The chunk.
+         * @param row Row index within the chunk.
+         * @return True if every filter matches.
+         */
+        static bool matches(const std::vector<Predicate> & predicates, const Chunk& chunk, const size_t row);
+
+        /**
+         * @brief Checks if a chunk may hold rows matching the filters (ID and timestamp ranges).
+         * @param predicates Compiled filters.
+         * @param chunk The chunk.
+         * @return False if no row of the chunk can match.
+         */
+        static bool mayMatch(const std::vector<Predicate> & predicates, const Chunk& chunk);
+
+        /**
+         * @brief Rebuilds a log entry from a row.
+         * @param table The table.
+         * @param chunk The chunk.
+         * @param row Row index within the chunk.
+         * @param timestampCache Last formatted second, reused by consecutive rows.
+         * @return LogEntry Entry with the timestamp formatted as LogHelper::formatTime().
+         */
+        static LogEntry toLogEntry(const Table& table, const Chunk& chunk, const size_t row,
+                                   std::pair<int64_t, std::string> & timestampCache);
+
+        /**
+         * @brief Opens a store by name from the process-wide registry.
+         * @param name Database name.
+         * @param maxBytes Budget used if the store is created.
+         * @return std::shared_ptr<Store> The store.
+         */
+        static std::shared_ptr<Store> openStore(const std::string& name, const size_t maxBytes);
+
+        std::shared_ptr<Store> store; /**< Connected store (nullptr when disconnected). */
+        std::string lastError; /**< Last error message. */
+};
+
+#endif // MEMORY_DATABASE_H
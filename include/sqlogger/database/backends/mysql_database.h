@@ -21,16 +21,27 @@
 #define MYSQL_DATABASE_H
 
 #include <mysql.h>
+#include <errmsg.h>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <memory>
+#include <type_traits>
 #include <iostream>
 #include "sqlogger/database/database_interface.h"
 #include "sqlogger/database/database_helper.h"
 #include "sqlogger/log_config.h"
 #include "sqlogger/internal/log_strings.h"
 
+#define MYSQL_STMT_CACHE_SIZE 64 /**< Maximum number of prepared statements kept per connection. */
+#define MYSQL_BULK_INFILE_NAME "sqlogger_bulk" /**< Virtual file name served by the in-memory LOAD DATA LOCAL INFILE handler. */
+
 /**
  * @class MySQLDatabase
  * @brief Implementation of the IDatabase interface for MySQL databases.
@@ -104,6 +115,68 @@ class MySQLDatabase : public IDatabase
         std::vector<std::map<std::string, std::string>> query(const std::string& query,
                 const std::vector<std::string> & params = {}) override;
 
+        /**
+         * @brief Executes an SQL query and returns a compact columnar result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @return ResultSet with column names stored once and values in contiguous storage.
+         */
+        ResultSet queryResultSet(const std::string& query,
+                                 const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param callback Function called for each row; return false to stop reading.
+         * @return True if the query was executed successfully, false otherwise.
+         * @note Rows are read from the database cursor without materializing the result.
+         * The callback must not run other queries on this connection.
+         */
+        bool queryEach(const std::string& query,
+                       const std::vector<std::string> & params,
+                       const RowCallback& callback) override;
+
+
+        /**
+        * @brief Executes an SQL query with typed parameters
+        * @param query The SQL query to execute. Can contain parameter placeholders
+        * @param params Typed parameters, text values are bound without copying where possible
+        * @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+        * @return true if query executed successfully
+        * @note Integers are bound as MYSQL_TYPE_LONGLONG, text points at the caller's buffer.
+        * @see DbParam
+        */
+        bool execute(
+            const std::string& query,
+            const DbParamList& params,
+            int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Checks if the backend implements bulkInsert().
+         * @return Always true, LOAD DATA LOCAL INFILE is used.
+         */
+        bool supportsBulkInsert() const override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Loads rows with LOAD DATA LOCAL INFILE fed from an in-memory buffer.
+         * @param table Target table name.
+         * @param fields Column names.
+         * @param values Row-major values, fields.size() items per row.
+         * @param affectedRows Optional pointer to store number of loaded rows.
+         * @return True if all rows were loaded, false otherwise.
+         * @note Requires local_infile to be enabled on the server.
+         * @note Outside bulkInsert() every LOCAL INFILE request is rejected, so the server
+         *       can never read client files.
+         */
+        bool bulkInsert(
+            const std::string& table,
+            const std::vector<std::string> & fields,
+            const std::vector<std::string> & values,
+            int* affectedRows = nullptr) override;
 
         /**
          * @brief Begins a transaction.
@@ -158,7 +231,51 @@ class MySQLDatabase : public IDatabase
         DataBaseType getDatabaseType() const override;
 
     private:
+        /**
+         * @struct InfileSource
+         * @brief In-memory rows served to LOAD DATA LOCAL INFILE.
+         */
+        struct InfileSource
+        {
+            const std::string* data = nullptr; /**< Encoded rows of the running bulkInsert(), nullptr outside it. */
+            size_t offset = 0; /**< Read position. */
+        };
+
         MYSQL* conn; /**< MySQL connection handle. */
+        InfileSource infileSource; /**< Source of the LOCAL INFILE handler installed for the connection lifetime. */
+
+        /**
+         * @brief LOCAL INFILE init callback: accepts only MYSQL_BULK_INFILE_NAME during bulkInsert().
+         * @param ptr Receives the source, or nullptr if the request is rejected.
+         * @param filename File name requested by the server.
+         * @param userdata The InfileSource.
+         * @return int 0 if accepted, non-zero otherwise.
+         */
+        static int infileInit(void** ptr, const char* filename, void* userdata);
+
+        /**
+         * @brief LOCAL INFILE read callback: copies the next chunk of the in-memory rows.
+         * @param ptr The InfileSource.
+         * @param buf Destination buffer.
+         * @param bufLen Buffer size.
+         * @return int Bytes copied, 0 at the end.
+         */
+        static int infileRead(void* ptr, char* buf, unsigned int bufLen);
+
+        /**
+         * @brief LOCAL INFILE end callback (nothing to release).
+         * @param ptr The InfileSource, or nullptr.
+         */
+        static void infileEnd(void* ptr);
+
+        /**
+         * @brief LOCAL INFILE error callback.
+         * @param ptr The InfileSource, or nullptr if the request was rejected.
+         * @param errorMsg Receives the error message.
+         * @param errorMsgLen Size of errorMsg.
+         * @return int MySQL client error code.
+         */
+        static int infileError(void* ptr, char* errorMsg, unsigned int errorMsgLen);
 
         /**
          * @brief Parses a MySQL connection string.
@@ -174,6 +291,31 @@ class MySQLDatabase : public IDatabase
         */
         bool createDatabaseIfNotExists(const std::string& connectionString);
 
+        /**
+         * @brief Returns a prepared statement for the query, reusing a cached handle if available.
+         * @param query The SQL query text (used as cache key).
+         * @return Prepared statement handle, or nullptr if preparation failed.
+         * @note Least recently used statement is closed when the cache exceeds MYSQL_STMT_CACHE_SIZE.
+         */
+        MYSQL_STMT* getCachedStatement(const std::string& query);
+
+        /**
+         * @brief Closes and removes a cached statement (e.g. after an execution error).
+         * @param query The SQL query text of the statement.
+         */
+        void evictStatement(const std::string& query);
+
+        /**
+         * @brief Closes all cached prepared statements.
+         * @note Must be called before the connection handle is closed.
+         */
+        void clearStatementCache();
+
+        using StmtCacheList = std::list<std::pair<std::string, MYSQL_STMT*>>;
+
+        StmtCacheList stmtCache; /**< Cached statements, most recently used first. */
+        std::unordered_map<std::string, StmtCacheList::iterator> stmtCacheIndex; /**< Query text to cache entry lookup. */
+
         const DataBaseType dbType = DataBaseType::MySQL; /**< The type of the database (MySQL). */
         std::string lastError;  /**< Last error message storage*/
         bool allowCreateDB; /**< Allow create database on server (execute CREATE DATABASE). */
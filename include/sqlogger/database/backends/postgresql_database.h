@@ -22,9 +22,19 @@
 
 #include <sstream>
 #include <iostream>
+#include <list>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
 #include <libpq-fe.h>
 #include "sqlogger/database/database_interface.h"
 
+#define PG_STMT_CACHE_SIZE 64 /**< Maximum number of server-side prepared statements kept per connection. */
+#define PG_STMT_NAME_PREFIX "sqlg_stmt_" /**< Name prefix for server-side prepared statements. */
+#define PG_SQLSTATE_UNKNOWN_STATEMENT "26000" /**< invalid_sql_statement_name: the prepared statement is gone. */
+#define PG_COPY_CHUNK_SIZE 65536 /**< Size of the data chunks sent with PQputCopyData. */
+#define PG_INT8_OID 20 /**< Type OID of bigint, used for binary integer parameters. */
+
 /**
  * @class PostgreSQLDatabase
  * @brief PostgreSQL-specific implementation of IDatabase interface
@@ -96,6 +106,20 @@ class PostgreSQLDatabase : public IDatabase
             const std::vector<std::string> & params = {},
             int* affectedRows = nullptr) override;
 
+        /**
+        * @brief Executes an SQL query with typed parameters
+        * @param query The SQL query to execute. Can contain parameter placeholders
+        * @param params Typed parameters, text values are bound without copying where possible
+        * @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+        * @return true if query executed successfully
+        * @note Integers are sent as binary int8, text in text format.
+        * @see DbParam
+        */
+        bool execute(
+            const std::string& query,
+            const DbParamList& params,
+            int* affectedRows = nullptr) override;
+
         /**
         * @brief Executes an SQL query and returns the result.
         * @param query The SQL query to execute.
@@ -105,6 +129,60 @@ class PostgreSQLDatabase : public IDatabase
         std::vector<std::map<std::string, std::string>> query(const std::string& query,
                 const std::vector<std::string> & params = {}) override;
 
+        /**
+         * @brief Executes an SQL query and returns a compact columnar result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @return ResultSet with column names stored once and values in contiguous storage.
+         */
+        ResultSet queryResultSet(const std::string& query,
+                                 const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param callback Function called for each row; return false to stop reading.
+         * @return True if the query was executed successfully, false otherwise.
+         * @note Rows are read from the database cursor without materializing the result.
+         * The callback must not run other queries on this connection.
+         */
+        bool queryEach(const std::string& query,
+                       const std::vector<std::string> & params,
+                       const RowCallback& callback) override;
+
+        /**
+         * @brief Checks if the backend implements bulkInsert().
+         * @return Always true, COPY FROM STDIN is used.
+         */
+        bool supportsBulkInsert() const override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Checks if query() can run INSERT ... ON CONFLICT ... RETURNING statements.
+         * @return Always true (PostgreSQL 9.5+).
+         */
+        bool supportsReturning() const override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Loads rows with COPY ... FROM STDIN (text format)
+         * @param table Target table name
+         * @param fields Column names
+         * @param values Row-major values, fields.size() items per row
+         * @param affectedRows Optional pointer to store number of loaded rows
+         * @return true if COPY completed successfully
+         */
+        bool bulkInsert(
+            const std::string& table,
+            const std::vector<std::string> & fields,
+            const std::vector<std::string> & values,
+            int* affectedRows = nullptr) override;
+
         /**
          * @brief Begin database transaction
          * @return true if transaction started successfully
@@ -164,6 +242,79 @@ class PostgreSQLDatabase : public IDatabase
          */
         std::map<std::string, std::string> parseConnectionString(const std::string& connectionString);
 
+        /**
+         * @brief Executes a parameterized query through a cached server-side prepared statement
+         * @param query SQL query text (used as cache key)
+         * @param params Text parameter values
+         * @return Query result (caller must PQclear), or nullptr if preparation failed
+         * @note Statement is prepared once per connection with PQprepare and reused via PQexecPrepared
+         */
+        PGresult* execPrepared(const std::string& query, const std::vector<std::string> & params);
+
+        /**
+         * @brief Executes a query with typed parameters through a cached server-side prepared statement
+         * @param query SQL query text
+         * @param params Typed parameter values
+         * @return Query result (caller must PQclear), or nullptr if preparation failed
+         * @note Cached under typedStatementKey(), as integer parameters are prepared as int8
+         */
+        PGresult* execPrepared(const std::string& query, const DbParamList& params);
+
+        /**
+         * @brief Prepares (once) and executes a cached statement
+         * @param query SQL query text
+         * @param cacheKey Statement cache key
+         * @param nParams Number of parameters
+         * @param types Parameter type OIDs (nullptr or 0 = inferred)
+         * @param values Parameter values
+         * @param lengths Parameter lengths (binary parameters only)
+         * @param formats Parameter formats (0 = text, 1 = binary)
+         * @return Query result (caller must PQclear), or nullptr if preparation failed
+         */
+        PGresult* execCached(const std::string& query, const std::string& cacheKey, const int nParams,
+                             const Oid* types, const char* const* values, const int* lengths, const int* formats);
+
+        /**
+         * @brief Gets the statement cache key for a typed parameter list
+         * @param query SQL query text
+         * @param params Typed parameter values
+         * @return Query text followed by the parameter type signature
+         */
+        static std::string typedStatementKey(const std::string& query, const DbParamList& params);
+
+        /**
+         * @brief Deallocates and removes a cached statement
+         * Outside a transaction the statement is deallocated at once; inside one
+         * (possibly aborted, where DEALLOCATE fails) it is deferred to releaseDeferredStatements().
+         * @param query Cache key of the statement (query text for text parameters)
+         */
+        void evictStatement(const std::string& query);
+
+        /**
+         * @brief Removes a cached statement without deallocating it
+         * @param query Cache key of the statement (query text for text parameters)
+         * @return std::string Statement name, or an empty string if the key is not cached
+         */
+        std::string forgetStatement(const std::string& query);
+
+        /**
+         * @brief Deallocates the statements evicted inside a transaction, if no transaction is open now
+         */
+        void releaseDeferredStatements();
+
+        /**
+         * @brief Forgets all cached statements
+         * @note Server-side statements are released together with the session
+         */
+        void clearStatementCache();
+
+        using StmtCacheList = std::list<std::pair<std::string, std::string>>;
+
+        StmtCacheList stmtCache;            ///< Query text and statement name, most recently used first
+        std::unordered_map<std::string, StmtCacheList::iterator> stmtCacheIndex; ///< Query text to cache entry lookup
+        size_t stmtCounter = 0;             ///< Counter for unique statement names
+        std::vector<std::string> deferredDeallocations; ///< Evicted statement names waiting for the end of the transaction
+
         PGconn* conn;                       ///< PostgreSQL connection handle
         std::string lastError;              ///< Last error message storage
         const bool allowCreateDB;           ///< Database creation allowed flag
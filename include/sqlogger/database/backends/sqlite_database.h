@@ -25,12 +25,25 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <optional>
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include "sqlogger/internal/fs_helper.h"
 #include "sqlogger/internal/log_strings.h"
 #include "sqlogger/database/database_interface.h"
 
 #define USE_WAL_MODE 1
+#if USE_WAL_MODE == 1
+    #define SQLITE_DEFAULT_JOURNAL_MODE "WAL" /**< Journal mode used when SQLitePragmas::journalMode is unset. */
+#endif
+#define SQLITE_DEFAULT_SYNCHRONOUS "NORMAL" /**< Synchronous mode used when SQLitePragmas::synchronous is unset. */
+#define SQLITE_DEFAULT_CACHE_SIZE -16384 /**< Page cache size (16 MiB) used when SQLitePragmas::cacheSize is unset. */
+#define SQLITE_DEFAULT_MMAP_SIZE 268435456 /**< Memory map size (256 MiB) used when SQLitePragmas::mmapSize is unset. */
+#define SQLITE_STMT_CACHE_SIZE 64 /**< Maximum number of prepared statements kept per connection. */
+#define SQLITE_RETURNING_MIN_VERSION 3035000 /**< First SQLite version with INSERT ... RETURNING (3.35.0). */
 
 /**
  * @class SQLiteDatabase
@@ -42,9 +55,10 @@ class SQLiteDatabase : public IDatabase
         /**
          * @brief Constructs an SQLiteDatabase object.
          * @param dbPath The path to the SQLite database file.
+         * @param pragmas Connection tuning applied on every (re)connect.
          * @throws std::runtime_error if the database cannot be opened.
          */
-        SQLiteDatabase(const std::string& dbPath);
+        SQLiteDatabase(const std::string& dbPath, const SQLitePragmas& pragmas = SQLitePragmas());
 
         /**
          * @brief Destructor for SQLiteDatabase.
@@ -96,6 +110,20 @@ class SQLiteDatabase : public IDatabase
             const std::vector<std::string> & params = {},
             int* affectedRows = nullptr) override;
 
+        /**
+        * @brief Executes an SQL query with typed parameters
+        * @param query The SQL query to execute. Can contain parameter placeholders
+        * @param params Typed parameters, text values are bound without copying where possible
+        * @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+        * @return true if query executed successfully
+        * @note Integers are bound with sqlite3_bind_int64(), text with SQLITE_STATIC.
+        * @see DbParam
+        */
+        bool execute(
+            const std::string& query,
+            const DbParamList& params,
+            int* affectedRows = nullptr) override;
+
         /**
         * @brief Executes an SQL query and returns the result.
         * @param query The SQL query to execute.
@@ -105,6 +133,37 @@ class SQLiteDatabase : public IDatabase
         std::vector<std::map<std::string, std::string>> query(const std::string& query,
                 const std::vector<std::string> & params = {}) override;
 
+        /**
+         * @brief Executes an SQL query and returns a compact columnar result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @return ResultSet with column names stored once and values in contiguous storage.
+         */
+        ResultSet queryResultSet(const std::string& query,
+                                 const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param callback Function called for each row; return false to stop reading.
+         * @return True if the query was executed successfully, false otherwise.
+         * @note Rows are read from the database cursor without materializing the result.
+         * The callback must not run other queries on this connection.
+         */
+        bool queryEach(const std::string& query,
+                       const std::vector<std::string> & params,
+                       const RowCallback& callback) override;
+
+        /**
+         * @brief Checks if the linked SQLite library supports INSERT ... RETURNING.
+         * @return True for SQLite 3.35.0 and later.
+         */
+        bool supportsReturning() const override
+        {
+            return sqlite3_libversion_number() >= SQLITE_RETURNING_MIN_VERSION;
+        }
+
         /**
          * @brief Begins a transaction.
          * @return True if the transaction was started successfully, false otherwise.
@@ -147,6 +206,13 @@ class SQLiteDatabase : public IDatabase
          */
         void reconnect();
 
+        /**
+         * @brief Applies the configured pragmas to the open connection.
+         * @return True if all pragmas were applied, false otherwise.
+         * @note page_size is applied first since it can't be changed once WAL mode is on.
+         */
+        bool applyPragmas();
+
         /**
         * @brief Creates a database if it does not already exist.
         * @param dbPath The path to the SQLite database file.
@@ -154,8 +220,36 @@ class SQLiteDatabase : public IDatabase
         */
         bool createDatabaseIfNotExists(const std::string& dbPath);
 
+        /**
+         * @brief Returns a prepared statement for the query, reusing a cached handle if available.
+         * @param query The SQL query text (used as cache key).
+         * @return Reset statement with cleared bindings, or nullptr if preparation failed.
+         * @note Least recently used statement is finalized when the cache exceeds SQLITE_STMT_CACHE_SIZE.
+         */
+        sqlite3_stmt* getCachedStatement(const std::string& query);
+
+        /**
+         * @brief Steps a bound statement to completion and resets it.
+         * @param stmt Statement with bound parameters.
+         * @param affectedRows Optional pointer to store number of affected rows.
+         * @return True if the statement completed (SQLITE_DONE).
+         */
+        bool stepStatement(sqlite3_stmt* stmt, int* affectedRows);
+
+        /**
+         * @brief Finalizes all cached prepared statements.
+         * @note Must be called before the connection handle is closed.
+         */
+        void clearStatementCache();
+
+        using StmtCacheList = std::list<std::pair<std::string, sqlite3_stmt*>>;
+
+        StmtCacheList stmtCache; /**< Cached statements, most recently used first. */
+        std::unordered_map<std::string, StmtCacheList::iterator> stmtCacheIndex; /**< Query text to cache entry lookup. */
+
         sqlite3* db; /**< SQLite database handle. */
         std::string dbPath; /**< Path to the database file. */
+        SQLitePragmas pragmas; /**< Connection tuning applied on every (re)connect. */
         const DataBaseType dbType = DataBaseType::SQLite; /**< The type of the database (SQLite). */
 };
 
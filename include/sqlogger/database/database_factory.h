@@ -25,6 +25,7 @@
 #include "sqlogger/database/database_helper.h"
 #include "sqlogger/database/backends/mock_database.h"
 #include "sqlogger/database/backends/sqlite_database.h"
+#include "sqlogger/database/backends/memory_database.h"
 
 #ifdef SQLG_USE_MYSQL
     #include "sqlogger/database/backends/mysql_database.h"
@@ -60,6 +61,7 @@ class DatabaseFactory
         * @brief Creates a database instance of the specified type.
         * @param type The type of database to create (see DataBaseType enum).
         * @param connectionString Connection string/parameters for the database.
+        * @param sqlitePragmas Connection tuning for SQLite (ignored by other backends).
         * @return std::unique_ptr<IDatabase> Pointer to the created database instance.
         *
         * @throws std::invalid_argument If unsupported database type is requested.
@@ -72,9 +74,12 @@ class DatabaseFactory
         * @see DataBaseType for supported database types.
         * @see LogConfig::configToConnectionString() to converts a LogConfig::Config object into a database-specific connection string.
         */
-        static std::unique_ptr<IDatabase> create(const DataBaseType& type, const std::string& connectionString);
+        static std::unique_ptr<IDatabase> create(const DataBaseType& type, const std::string& connectionString,
+                const SQLitePragmas& sqlitePragmas = SQLitePragmas());
 
         friend class LogManager;
+        friend class SQLogger;
+        friend class ShardedDatabase;
 };
 
 #endif // !DATABASE_FACTORY_H
\ No newline at end of file
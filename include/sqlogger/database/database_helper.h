@@ -21,6 +21,7 @@
 #define DATABASE_HELPER_H
 
 #include <string>
+#include <vector>
 #include <optional>
 #include "sqlogger/log_entry.h"
 #include "sqlogger/log_helper.h"
@@ -30,6 +31,7 @@
 #define DB_TYPE_STR_MYSQL "MySQL"
 #define DB_TYPE_STR_POSTGRESQL "PostgreSQL"
 #define DB_TYPE_STR_MONGODB "MongoDB"
+#define DB_TYPE_STR_MEMORY "Memory"
 #define DB_TYPE_STR_UNKNOWN "UNKNOWN"
 
 #define DB_DEFAULT_PORT_NOT_SUPPORTED -1
@@ -38,12 +40,14 @@
 #define DB_DEFAULT_PORT_MYSQL 3306
 #define DB_DEFAULT_PORT_POSTGRESQL 5432
 #define DB_DEFAULT_PORT_MONGODB 27017
+#define DB_DEFAULT_PORT_MEMORY DB_DEFAULT_PORT_NOT_SUPPORTED
 
 #define DB_PARAM_PREFIX_DEFAULT "?"
 #define DB_PARAM_PREFIX_MOCK DB_PARAM_PREFIX_DEFAULT
 #define DB_PARAM_PREFIX_SQLITE DB_PARAM_PREFIX_DEFAULT
 #define DB_PARAM_PREFIX_MYSQL DB_PARAM_PREFIX_DEFAULT
 #define DB_PARAM_PREFIX_POSTGRESQL "$"
+#define DB_PARAM_PREFIX_MEMORY DB_PARAM_PREFIX_DEFAULT
 
 #define DB_BATCH_NOT_SUPPORTED -1
 #define DB_MIN_BATCH_SIZE 1
@@ -52,6 +56,11 @@
 #define DB_MAX_BATCH_SQLITE 1000
 #define DB_MAX_BATCH_MYSQL 5000
 #define DB_MAX_BATCH_POSTGRESQL 10000
+#define DB_MAX_BATCH_BULK 100000 ///< Maximum batch size when the native bulk-load path is enabled.
+#define DB_MAX_BATCH_MEMORY DB_MAX_BATCH_BULK
+
+#define MEMORY_CON_STR_NAME "Name" /**< Connection string key of the database name. */
+#define MEMORY_CON_STR_MAX_BYTES "MaxBytes" /**< Connection string key of the memory budget of each log table. */
 
 /**
  * @enum DataBaseType
@@ -64,7 +73,8 @@ enum class DataBaseType
     SQLite,       /**< SQLite database. */
     MySQL,        /**< MySQL database. */
     PostgreSQL,   /**< PostgreSQL database. */
-    MongoDB       /**< MongoDB database. */
+    MongoDB,      /**< MongoDB database. */
+    Memory        /**< In-process memory database (no SQL). */
 };
 
 /**
@@ -78,6 +88,21 @@ enum class ValueType
     Number   /**< Always treat as number */
 };
 
+/**
+ * @struct SQLitePragmas
+ * @brief SQLite connection tuning applied on every (re)connect.
+ * Unset fields fall back to the SQLITE_DEFAULT_* values of SQLiteDatabase
+ * or keep the SQLite built-in default.
+ */
+struct SQLitePragmas
+{
+    std::optional<std::string> journalMode; /**< PRAGMA journal_mode (DELETE, TRUNCATE, PERSIST, MEMORY, WAL, OFF). */
+    std::optional<std::string> synchronous; /**< PRAGMA synchronous (OFF, NORMAL, FULL, EXTRA). */
+    std::optional<int> cacheSize; /**< PRAGMA cache_size (pages if positive, KiB if negative). */
+    std::optional<long long> mmapSize; /**< PRAGMA mmap_size in bytes (0 = memory mapping disabled). */
+    std::optional<int> pageSize; /**< PRAGMA page_size in bytes, effective only for a new database file. */
+};
+
 /**
  * @namespace DataBaseHelper
  * @brief Provides utility functions for database operations
@@ -110,7 +135,7 @@ namespace DataBaseHelper
     /**
     * @brief Checks if a database type is supported in the current build configuration.
     * Determines whether the database type is available based on compile-time
-    * feature flags (SQLG_USE_MYSQL, SQLG_USE_POSTGRESQL, etc.). Mock and SQLite are always
+    * feature flags (SQLG_USE_MYSQL, SQLG_USE_POSTGRESQL, etc.). Mock, SQLite and Memory are always
     * supported.
     * @param dbType The database type to check
     * @return bool True if the database type is supported, false otherwise
@@ -163,6 +188,73 @@ namespace DataBaseHelper
     */
     int getMaxBatchSize(const DataBaseType& type);
 
+    /**
+    * @brief Checks if the database type has a native bulk-load path.
+    * @param type The database type to check.
+    * @return bool True for PostgreSQL (COPY) and MySQL (LOAD DATA LOCAL INFILE).
+    * @see IDatabase::bulkInsert()
+    */
+    bool isBulkLoadSupported(const DataBaseType& type);
+
+    /**
+    * @brief Checks if the database type benefits from parallel write connections.
+    * @param type The database type to check.
+    * @return bool True for PostgreSQL and MySQL (SQLite allows a single writer at a time).
+    * @see LogConfig::Config::connectionPoolSize
+    */
+    bool isConnectionPoolSupported(const DataBaseType& type);
+
+    /**
+    * @brief Checks if queries of the database type can run on separate connections.
+    * @param type The database type to check.
+    * @return bool True for SQLite (WAL snapshot reads), MySQL and PostgreSQL; false for
+    * in-process backends, whose every connection is a separate database.
+    * @see LogConfig::Config::readPoolSize
+    */
+    bool isReadPoolSupported(const DataBaseType& type);
+
+    /**
+    * @brief Checks if the log table of the database type can be split into daily partitions.
+    * @param type The database type to check.
+    * @return bool True for SQLite (per-day tables behind a view), MySQL and PostgreSQL (native partitions).
+    * @see LogConfig::Config::partitioning
+    */
+    bool isPartitioningSupported(const DataBaseType& type);
+
+    /**
+    * @brief Checks if the message column of the database type can have a full-text index.
+    * @param type The database type to check.
+    * @return bool True for SQLite (FTS5), MySQL (FULLTEXT) and PostgreSQL (GIN over tsvector).
+    * @see LogConfig::Config::fullTextSearch
+    */
+    bool isFullTextSearchSupported(const DataBaseType& type);
+
+    /**
+    * @brief Checks if the message column of the database type can be encrypted.
+    * @param type The database type to check.
+    * @return bool True for SQLite, MySQL and PostgreSQL (the message is stored as text).
+    * @see LogConfig::Config::encryptMessages
+    */
+    bool isEncryptionSupported(const DataBaseType& type);
+
+    /**
+    * @brief Checks if the message column of the database type can be compressed.
+    * @param type The database type to check.
+    * @return bool True for SQLite, MySQL and PostgreSQL (the message is stored as text).
+    * @see LogConfig::Config::compressMessages
+    */
+    bool isMessageCompressionSupported(const DataBaseType& type);
+
+    /**
+    * @brief Encodes rows as tab-separated text for COPY FROM STDIN / LOAD DATA.
+    * Backslash, tab, newline, carriage return and NUL are escaped with a backslash,
+    * which is the default text format of both PostgreSQL COPY and MySQL LOAD DATA.
+    * @param values Row-major values, columns * rows items.
+    * @param columns Number of columns per row.
+    * @return std::string Encoded rows, one per line.
+    */
+    std::string encodeBulkRows(const std::vector<std::string> & values, const size_t columns);
+
     /**
      * @brief Escapes backslashes in a string.
      * @param input The input string to escape.
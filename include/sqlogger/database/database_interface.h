@@ -23,8 +23,11 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <functional>
 #include "sqlogger/log_entry.h"
 #include "sqlogger/database/database_helper.h"
+#include "sqlogger/database/db_param.h"
+#include "sqlogger/database/result_set.h"
 
 #ifndef DB_ALLOW_CREATE
     #define DB_ALLOW_CREATE 1
@@ -34,6 +37,18 @@
     #define DB_ALLOW_DROP 0
 #endif // !DB_ALLOW_DROP
 
+/**
+ * @brief Callback receiving streamed rows: the result set and the row index within it.
+ * Returns false to stop reading.
+ */
+using RowCallback = std::function<bool(const ResultSet& result, const size_t row)>;
+
+/**
+ * @brief Callback receiving log entries read by IDatabase::selectLogs(); the entry may be modified.
+ * Returns false to stop reading.
+ */
+using NativeLogCallback = std::function<bool(LogEntry& entry)>;
+
 /**
  * @class IDatabase
  * @brief Interface for database operations.
@@ -87,6 +102,29 @@ class IDatabase
             const std::vector<std::string> & params = {},
             int* affectedRows = nullptr) = 0;
 
+        /**
+        * @brief Executes an SQL query with typed parameters
+        * @param query The SQL query to execute. Can contain parameter placeholders
+        * @param params Typed parameters, text values are bound without copying where possible
+        * @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+        * @return true if query executed successfully
+        * @note Default implementation converts the parameters to text and calls the text overload.
+        * @see DbParam
+        */
+        virtual bool execute(
+            const std::string& query,
+            const DbParamList& params,
+            int* affectedRows = nullptr)
+        {
+            std::vector<std::string> textParams;
+            textParams.reserve(params.size());
+            for(const auto & param : params)
+            {
+                textParams.emplace_back(param.toString());
+            }
+            return execute(query, textParams, affectedRows);
+        }
+
         /**
          * @brief Executes an SQL query and returns the result.
          * @param query The SQL query to execute.
@@ -96,6 +134,160 @@ class IDatabase
             const std::string& query,
             const std::vector<std::string> & params = {}) = 0;
 
+        /**
+         * @brief Checks if the backend implements bulkInsert().
+         * @return True if a native bulk-load path is available, false otherwise.
+         */
+        virtual bool supportsBulkInsert() const
+        {
+            return false;
+        }
+
+        /**
+         * @brief Loads rows through the native bulk path (COPY, LOAD DATA) instead of INSERT.
+         * @param table Target table name.
+         * @param fields Column names, in the order of the values of each row.
+         * @param values Row-major values, fields.size() items per row.
+         * @param affectedRows Optional pointer to store number of loaded rows (default nullptr).
+         * @return True if all rows were loaded, false otherwise (check getLastError() for details).
+         * @see DataBaseHelper::encodeBulkRows()
+         */
+        virtual bool bulkInsert(
+            const std::string& /*table*/,
+            const std::vector<std::string> & /*fields*/,
+            const std::vector<std::string> & /*values*/,
+            int* /*affectedRows*/ = nullptr)
+        {
+            return false;
+        }
+
+        /**
+         * @brief Checks if query() can run INSERT ... ON CONFLICT ... RETURNING statements.
+         * @return True if upserts return the affected row in the same round trip, false otherwise.
+         * @see QueryBuilder::buildUpsertReturning()
+         */
+        virtual bool supportsReturning() const
+        {
+            return false;
+        }
+
+        /**
+         * @brief Checks if the backend stores log entries natively instead of executing SQL.
+         * LogWriter and LogReader then use insertLogs(), selectLogs(), clearTable()
+         * and the source methods below; no tables, indexes or dictionaries are created.
+         * @return True if the native log methods are implemented, false otherwise.
+         */
+        virtual bool supportsNativeLogs() const
+        {
+            return false;
+        }
+
+        /**
+         * @brief Stores log entries without SQL (see supportsNativeLogs()).
+         * The entry IDs are assigned by the backend.
+         * @param table Log table name.
+         * @param entries Entries to store.
+         * @return True if all entries were stored, false otherwise (check getLastError() for details).
+         */
+        virtual bool insertLogs(const std::string& /*table*/, const LogEntryList& /*entries*/)
+        {
+            return false;
+        }
+
+        /**
+         * @brief Passes the log entries matching the filters to a callback (see supportsNativeLogs()).
+         * Source UUID and name of the entries are left empty.
+         * @param table Log table name.
+         * @param filters Filters, combined with AND.
+         * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending).
+         * @param limit Maximum number of entries (0 or negative = no limit).
+         * @param offset Number of entries to skip, requires a positive limit.
+         * @param callback Function called for each entry; return false to stop reading.
+         * @return size_t Number of entries passed to the callback.
+         * @throws std::invalid_argument If a filter field is not a log table column.
+         */
+        virtual size_t selectLogs(
+            const std::string& /*table*/,
+            const std::vector<Filter> & /*filters*/,
+            const std::string& /*orderBy*/,
+            const int /*limit*/,
+            const int /*offset*/,
+            const NativeLogCallback& /*callback*/)
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Removes all rows of a table (see supportsNativeLogs()).
+         * @param table Table name.
+         * @return True if the table was cleared, false otherwise.
+         */
+        virtual bool clearTable(const std::string& /*table*/)
+        {
+            return false;
+        }
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Stores a source (see supportsNativeLogs()).
+         * @param uuid Source UUID, unique.
+         * @param name Source name.
+         * @return int ID of the new source, or SOURCE_NOT_FOUND if it was not stored (e.g. duplicate UUID).
+         */
+        virtual int insertSource(const std::string& uuid, const std::string& name)
+        {
+            return SOURCE_NOT_FOUND;
+        }
+
+        /**
+         * @brief Gets all sources ordered by ID (see supportsNativeLogs()).
+         * @return std::vector<SourceInfo> Stored sources.
+         */
+        virtual std::vector<SourceInfo> selectSources()
+        {
+            return {};
+        }
+#endif
+
+        /**
+         * @brief Executes an SQL query and returns a compact columnar result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @note Default implementation converts the result of query().
+         * @return ResultSet with column names stored once and values in contiguous storage.
+         */
+        virtual ResultSet queryResultSet(
+            const std::string& query,
+            const std::vector<std::string> & params = {})
+        {
+            return ResultSet::fromRows(this->query(query, params));
+        }
+
+        /**
+         * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param callback Function called for each row; return false to stop reading.
+         * @return True if the query was executed successfully, false otherwise.
+         * @note Default implementation materializes the result with queryResultSet();
+         * backends with cursors override it to keep memory use constant.
+         */
+        virtual bool queryEach(
+            const std::string& query,
+            const std::vector<std::string> & params,
+            const RowCallback& callback)
+        {
+            const ResultSet result = queryResultSet(query, params);
+            for(size_t row = 0; row < result.rowCount(); ++row)
+            {
+                if(!callback(result, row))
+                {
+                    break;
+                }
+            }
+            return true;
+        }
+
         /**
          * @brief Begins a transaction.
          * @return True if the transaction was started successfully, false otherwise.
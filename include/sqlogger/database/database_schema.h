@@ -188,6 +188,16 @@ class DatabaseSchema
                     const std::string& referenceTable,
                     const std::string& referenceField);
 
+                /**
+                 * @brief Partition the table by ranges of a field (PostgreSQL and MySQL)
+                 * The primary key becomes (primary field, partition field), since both
+                 * databases require every unique key to contain the partition key.
+                 * @param fieldName Name of the partition key field
+                 * @return Reference to the TableBuilder for chaining
+                 * @throws std::logic_error if field hasn't been declared
+                 */
+                TableBuilder& setRangePartition(const std::string& fieldName);
+
                 /**
                  * @brief Structure representing a built table definition
                  */
@@ -209,6 +219,7 @@ class DatabaseSchema
                     };
                     std::vector<Field> fields; ///< List of fields in the table
                     std::unordered_map<std::string, std::pair<std::string, std::string>> foreignKeys; ///< Foreign key constraints
+                    std::string partitionField; ///< Range partition key (empty = not partitioned)
                 };
 
                 /**
@@ -221,6 +232,7 @@ class DatabaseSchema
                 std::string tableName; ///< Name of the table being built
                 std::vector<BuiltTable::Field> fields; ///< Fields in the table
                 std::unordered_map<std::string, std::pair<std::string, std::string>> foreignKeys; ///< Foreign key constraints
+                std::string partitionField; ///< Range partition key
 
                 /**
                  * @brief Resolve standard type to database-specific type
@@ -0,0 +1,150 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef DB_PARAM_H
+#define DB_PARAM_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @enum DbParamType
+ * @brief Type of a bound query parameter.
+ */
+enum class DbParamType
+{
+    Null,  /**< SQL NULL. */
+    Int64, /**< 64-bit signed integer. */
+    Text   /**< Text (also used for timestamps in their string form). */
+};
+
+/**
+ * @class DbParam
+ * @brief Non-owning typed query parameter.
+ * Text parameters only reference the caller's storage, which must stay alive
+ * until IDatabase::execute() returns, so backends can bind without copying.
+ */
+class DbParam
+{
+    public:
+        /**
+         * @brief Constructs a NULL parameter.
+         */
+        DbParam() = default;
+
+        /**
+         * @brief Constructs an integer parameter.
+         * @param value Integer value.
+         */
+        DbParam(const int64_t value) : type(DbParamType::Int64), integer(value)
+        {
+        }
+
+        /**
+         * @brief Constructs an integer parameter.
+         * @param value Integer value.
+         */
+        DbParam(const int value) : DbParam(static_cast<int64_t>(value))
+        {
+        }
+
+        /**
+         * @brief Constructs a text parameter referencing a std::string.
+         * @param value Text value (its buffer is null-terminated).
+         */
+        DbParam(const std::string& value) : type(DbParamType::Text), text(value), nullTerminated(true)
+        {
+        }
+
+        /**
+         * @brief Constructs a text parameter referencing a character range.
+         * @param value Text value (not necessarily null-terminated).
+         */
+        DbParam(const std::string_view value) : type(DbParamType::Text), text(value)
+        {
+        }
+
+        DbParam(std::string&&) = delete; // Would dangle
+
+        /**
+         * @brief Gets the parameter type.
+         * @return DbParamType Parameter type.
+         */
+        DbParamType getType() const
+        {
+            return type;
+        }
+
+        /**
+         * @brief Gets the integer value.
+         * @return int64_t Value (0 for non-integer parameters).
+         */
+        int64_t getInt64() const
+        {
+            return integer;
+        }
+
+        /**
+         * @brief Gets the text value.
+         * @return std::string_view Value (empty for non-text parameters).
+         */
+        std::string_view getText() const
+        {
+            return text;
+        }
+
+        /**
+         * @brief Checks if the text value is followed by a null terminator.
+         * @return bool True if getText().data() can be used as a C string.
+         */
+        bool isNullTerminated() const
+        {
+            return nullTerminated;
+        }
+
+        /**
+         * @brief Converts the parameter to its text form.
+         * @return std::string Text value, decimal integer or empty string for NULL.
+         */
+        std::string toString() const
+        {
+            switch(type)
+            {
+                case DbParamType::Int64:
+                    return std::to_string(integer);
+                case DbParamType::Text:
+                    return std::string(text);
+                case DbParamType::Null:
+                default:
+                    return std::string();
+            }
+        }
+
+    private:
+        DbParamType type = DbParamType::Null; /**< Parameter type. */
+        int64_t integer = 0; /**< Integer value. */
+        std::string_view text; /**< Text value (non-owning). */
+        bool nullTerminated = false; /**< Whether text is followed by '\0'. */
+};
+
+using DbParamList = std::vector<DbParam>;
+
+#endif // DB_PARAM_H
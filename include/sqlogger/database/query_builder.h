@@ -23,6 +23,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <functional>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
@@ -35,6 +36,8 @@
     #include "document_builder.h"
 #endif
 
+#define QUERY_TEXT_CACHE_SIZE 64 /**< Maximum number of generated statements kept by QueryBuilder. */
+
 /**
  * @class QueryBuilder
  * @brief Utility class with static methods for building SQL queries.
@@ -74,6 +77,23 @@ class QueryBuilder
                                        int limit = -1,
                                        int offset = -1);
 
+        /**
+         * @brief Builds SELECT ... GROUP BY statement counting the rows of each group
+         * @param dbType Target database type
+         * @param table Table name
+         * @param groupFields Grouping columns, returned under their own names
+         * @param filters WHERE clause conditions
+         * @param bucketSeconds Width of the FIELD_LOG_TIMESTAMP groups in seconds (0 = group by value)
+         * @param timestampFormat Format of the FIELD_LOG_TIMESTAMP column
+         * @return Formatted statement returning the group columns and SQL_COUNT_ALIAS (empty if not supported)
+         */
+        static std::string buildGroupCount(DataBaseType dbType,
+                                           const std::string& table,
+                                           const std::vector<std::string> & groupFields,
+                                           const std::vector<Filter> & filters,
+                                           const int bucketSeconds = 0,
+                                           const TimestampFormat timestampFormat = TimestampFormat::Text);
+
         /**
          * @brief Builds UPDATE SQL statement
          * @param dbType Target database type
@@ -135,6 +155,18 @@ class QueryBuilder
             const std::string& indexName,
             const std::vector<std::string> & columns);
 
+        /**
+         * @brief Builds DROP INDEX statement
+         * @param dbType Target database type
+         * @param tableName Table name
+         * @param indexName Index name
+         * @return Formatted DROP INDEX statement (empty if not supported)
+         */
+        static std::string buildDropIndex(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& indexName);
+
         /**
          * @brief Builds query to check if table exists
          * @param dbType Target database type
@@ -151,6 +183,145 @@ class QueryBuilder
          */
         static std::string buildIndexExistsQuery(DataBaseType dbType, const std::string& indexName);
 
+        /**
+         * @brief Builds query to check if view exists
+         * @param dbType Target database type
+         * @param viewName View name to check
+         * @return Formatted view existence query
+         */
+        static std::string buildViewExistsQuery(DataBaseType dbType, const std::string& viewName);
+
+        /**
+         * @brief Builds query reading the schema version marker of a table
+         * @param dbType Target database type
+         * @param schemaTable Schema version table name
+         * @param table Table whose marker is read
+         * @param requiredTables Tables that must exist for the marker to be returned
+         * @return Formatted query returning FIELD_SCHEMA_VERSION (empty if not supported)
+         */
+        static std::string buildSchemaVersionQuery(DataBaseType dbType,
+                const std::string& schemaTable,
+                const std::string& table,
+                const std::vector<std::string> & requiredTables);
+
+        /**
+         * @brief Builds an INSERT that keeps the existing row on a unique key conflict and returns its columns
+         * @param dbType Target database type
+         * @param table Table name
+         * @param values Vector of column-value pairs
+         * @param conflictField Unique column identifying the row
+         * @param returning Columns returned for the inserted or existing row
+         * @return Formatted statement (empty if the database has no INSERT ... RETURNING)
+         * @see IDatabase::supportsReturning()
+         */
+        static std::string buildUpsertReturning(DataBaseType dbType,
+                                                const std::string& table,
+                                                const std::vector<std::pair<std::string, std::string>> & values,
+                                                const std::string& conflictField,
+                                                const std::vector<std::string> & returning);
+
+        /**
+         * @brief Builds the statement adding a range partition to a partitioned table
+         * @param dbType Target database type
+         * @param tableName Partitioned table name
+         * @param partitionField Partition key field
+         * @param partitionName Partition name (PostgreSQL: table name of the partition)
+         * @param lowerBound Inclusive lower bound (ignored by MySQL)
+         * @param upperBound Exclusive upper bound
+         * @param first Whether this is the first partition (MySQL: partitions the table)
+         * @return Formatted statement (empty if the database has no declarative partitions)
+         */
+        static std::string buildCreatePartition(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& partitionField,
+            const std::string& partitionName,
+            const std::string& lowerBound,
+            const std::string& upperBound,
+            const bool first = false);
+
+        /**
+         * @brief Builds the statement dropping a partition with all its rows
+         * @param dbType Target database type
+         * @param tableName Partitioned table name
+         * @param partitionName Partition name (SQLite and PostgreSQL: table name of the partition)
+         * @return Formatted statement (empty if not supported)
+         */
+        static std::string buildDropPartition(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& partitionName);
+
+        /**
+         * @brief Builds a query listing the partitions of a table ("name" column)
+         * @param dbType Target database type
+         * @param tableName Partitioned table name
+         * @return Formatted query (empty if not supported)
+         */
+        static std::string buildPartitionsQuery(DataBaseType dbType, const std::string& tableName);
+
+        /**
+         * @brief Builds a CREATE VIEW statement concatenating tables with UNION ALL
+         * @param dbType Target database type
+         * @param viewName View name
+         * @param tables Tables with identical columns
+         * @return Formatted CREATE VIEW statement (empty if not supported or no tables)
+         */
+        static std::string buildCreateUnionView(
+            DataBaseType dbType,
+            const std::string& viewName,
+            const std::vector<std::string> & tables);
+
+        /**
+         * @brief Builds a DROP VIEW statement
+         * @param dbType Target database type
+         * @param viewName View name
+         * @return Formatted DROP VIEW statement (empty if not supported)
+         */
+        static std::string buildDropView(DataBaseType dbType, const std::string& viewName);
+
+        /**
+         * @brief Builds the statements creating a full-text index on a text column
+         * @param dbType Target database type
+         * @param tableName Indexed table name
+         * @param indexName Index name
+         * @param field Text column
+         * @return Statements (empty if the database has no full-text index)
+         */
+        static std::vector<std::string> buildCreateFullTextIndex(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& indexName,
+            const std::string& field);
+
+        /**
+         * @brief Builds the statements dropping a full-text index
+         * @param dbType Target database type
+         * @param tableName Indexed table name
+         * @param indexName Index name
+         * @return Statements (empty if the database has no full-text index)
+         */
+        static std::vector<std::string> buildDropFullTextIndex(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& indexName);
+
+        /**
+         * @brief Builds the statement indexing the rows written before the full-text index existed
+         * @param dbType Target database type
+         * @param tableName Indexed table name
+         * @return Formatted statement (empty if not needed)
+         */
+        static std::string buildRebuildFullTextIndex(DataBaseType dbType, const std::string& tableName);
+
+        /**
+         * @brief Converts search words to the value bound to a MATCH filter
+         * @param dbType Target database type
+         * @param text Search words separated by whitespace
+         * @return Search value in the full-text query syntax of the database
+         */
+        static std::string buildMatchValue(DataBaseType dbType, const std::string& text);
+
         /**
         * @brief Builds a batch INSERT query optimized for the specified database type.
         * @param table Name of the table to insert into.
@@ -165,9 +336,26 @@ class QueryBuilder
                                             const size_t numRows,
                                             const DataBaseType dbType);
 
+        /**
+        * @brief Gets the number of statements held by the statement text cache.
+        * @return size_t Cached statements (at most QUERY_TEXT_CACHE_SIZE).
+        */
+        static size_t getCachedTextCount();
+
         QueryBuilder() = delete;
         QueryBuilder(const QueryBuilder&) = delete;
         QueryBuilder& operator=(const QueryBuilder&) = delete;
+
+    private:
+        /**
+        * @brief Gets a generated statement from the statement text cache, building it on a miss.
+        * The text depends only on the statement shape, so it is built once per shape;
+        * the least recently used statement is dropped when the cache exceeds QUERY_TEXT_CACHE_SIZE.
+        * @param key Statement shape (database type, table, fields, row count).
+        * @param build Function building the statement text.
+        * @return std::string Statement text.
+        */
+        static std::string getCachedText(const std::string& key, const std::function<std::string()> & build);
 };
 
 #endif // QUERY_BUILDER_H
\ No newline at end of file
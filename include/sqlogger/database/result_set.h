@@ -0,0 +1,297 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef RESULT_SET_H
+#define RESULT_SET_H
+
+#include <cstdint>
+#include <charconv>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define RESULT_SET_NULL_STR "NULL" /**< NULL placeholder text used by some backends in IDatabase::query(). */
+
+/**
+ * @class ResultSet
+ * @brief Compact query result: column names stored once, all values in one buffer.
+ * Cells are stored row-major; a cell is addressed by (row, column index)
+ * and exposed as std::string_view or parsed on demand by the typed accessors.
+ */
+class ResultSet
+{
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1); /**< Column not found. */
+
+        ResultSet() = default;
+
+        /**
+         * @brief Sets the column names (clears any stored rows).
+         * @param names Column names in result order.
+         */
+        void setColumns(std::vector<std::string> names)
+        {
+            columns = std::move(names);
+            clearRows();
+        }
+
+        /**
+         * @brief Reserves storage for the expected result size.
+         * @param rows Expected number of rows.
+         * @param bytesPerRow Expected text size of one row.
+         */
+        void reserve(const size_t rows, const size_t bytesPerRow = 0)
+        {
+            ends.reserve(rows * columns.size());
+            nulls.reserve(rows * columns.size());
+            data.reserve(rows * bytesPerRow);
+        }
+
+        /**
+         * @brief Appends the next cell value (rows are filled column by column).
+         * @param value Cell text.
+         */
+        void appendValue(const std::string_view value)
+        {
+            data.append(value.data(), value.size());
+            ends.push_back(data.size());
+            nulls.push_back(false);
+        }
+
+        /**
+         * @brief Appends a NULL as the next cell value.
+         */
+        void appendNull()
+        {
+            ends.push_back(data.size());
+            nulls.push_back(true);
+        }
+
+        /**
+         * @brief Removes all rows, keeping the columns.
+         */
+        void clearRows()
+        {
+            data.clear();
+            ends.clear();
+            nulls.clear();
+        }
+
+        /**
+         * @brief Gets the number of complete rows.
+         * @return size_t Row count.
+         */
+        size_t rowCount() const
+        {
+            return columns.empty() ? 0 : ends.size() / columns.size();
+        }
+
+        /**
+         * @brief Gets the number of columns.
+         * @return size_t Column count.
+         */
+        size_t columnCount() const
+        {
+            return columns.size();
+        }
+
+        /**
+         * @brief Checks if the result has no rows.
+         * @return bool True if empty.
+         */
+        bool empty() const
+        {
+            return rowCount() == 0;
+        }
+
+        /**
+         * @brief Gets the column names.
+         * @return const std::vector<std::string>& Column names.
+         */
+        const std::vector<std::string> & getColumns() const
+        {
+            return columns;
+        }
+
+        /**
+         * @brief Finds a column by name.
+         * @param name Column name.
+         * @return size_t Column index, or ResultSet::npos if not found.
+         */
+        size_t columnIndex(const std::string_view name) const
+        {
+            for(size_t i = 0; i < columns.size(); ++i)
+            {
+                if(columns[i] == name)
+                {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        /**
+         * @brief Checks if a cell is NULL.
+         * @param row Row index.
+         * @param column Column index.
+         * @return bool True if NULL (or column is npos).
+         */
+        bool isNull(const size_t row, const size_t column) const
+        {
+            return column == npos || nulls[cell(row, column)];
+        }
+
+        /**
+         * @brief Gets a cell as text.
+         * @param row Row index.
+         * @param column Column index.
+         * @return std::string_view Cell text (empty for NULL or npos), valid while the ResultSet lives.
+         */
+        std::string_view getText(const size_t row, const size_t column) const
+        {
+            if(column == npos)
+            {
+                return std::string_view();
+            }
+            const size_t index = cell(row, column);
+            const size_t begin = index == 0 ? 0 : ends[index - 1];
+            return std::string_view(data.data() + begin, ends[index] - begin);
+        }
+
+        /**
+         * @brief Gets a cell as std::string.
+         * @param row Row index.
+         * @param column Column index.
+         * @return std::string Cell text (empty for NULL or npos).
+         */
+        std::string getString(const size_t row, const size_t column) const
+        {
+            return std::string(getText(row, column));
+        }
+
+        /**
+         * @brief Gets a cell as a 64-bit integer.
+         * @param row Row index.
+         * @param column Column index.
+         * @param defaultValue Value returned for NULL, npos or non-numeric text.
+         * @return int64_t Parsed value.
+         */
+        int64_t getInt64(const size_t row, const size_t column, const int64_t defaultValue = 0) const
+        {
+            const std::string_view text = getText(row, column);
+            int64_t value = defaultValue;
+            if(text.empty() || std::from_chars(text.data(), text.data() + text.size(), value).ec != std::errc())
+            {
+                return defaultValue;
+            }
+            return value;
+        }
+
+        /**
+         * @brief Gets a cell as an integer.
+         * @param row Row index.
+         * @param column Column index.
+         * @param defaultValue Value returned for NULL, npos or non-numeric text.
+         * @return int Parsed value.
+         */
+        int getInt(const size_t row, const size_t column, const int defaultValue = 0) const
+        {
+            return static_cast<int>(getInt64(row, column, defaultValue));
+        }
+
+        /**
+         * @brief Converts to the row-of-maps representation used by IDatabase::query().
+         * @param nullValue Text stored for NULL values.
+         * @return std::vector<std::map<std::string, std::string>> Rows keyed by column name.
+         */
+        std::vector<std::map<std::string, std::string>> toRows(const std::string& nullValue = "") const
+        {
+            std::vector<std::map<std::string, std::string>> rows;
+            rows.reserve(rowCount());
+            for(size_t r = 0; r < rowCount(); ++r)
+            {
+                std::map<std::string, std::string> row;
+                for(size_t c = 0; c < columns.size(); ++c)
+                {
+                    row[columns[c]] = isNull(r, c) ? nullValue : getString(r, c);
+                }
+                rows.push_back(std::move(row));
+            }
+            return rows;
+        }
+
+        /**
+         * @brief Builds a result set from the row-of-maps representation.
+         * @param rows Rows keyed by column name (columns are taken from the first row).
+         * @return ResultSet Converted result.
+         */
+        static ResultSet fromRows(const std::vector<std::map<std::string, std::string>> & rows)
+        {
+            ResultSet result;
+            if(rows.empty())
+            {
+                return result;
+            }
+
+            std::vector<std::string> names;
+            for(const auto & [name, _] : rows.front())
+            {
+                names.push_back(name);
+            }
+            result.setColumns(std::move(names));
+            result.reserve(rows.size());
+
+            for(const auto & row : rows)
+            {
+                for(const auto & name : result.columns)
+                {
+                    auto it = row.find(name);
+                    if(it == row.end())
+                    {
+                        result.appendNull();
+                    }
+                    else
+                    {
+                        result.appendValue(it->second);
+                    }
+                }
+            }
+            return result;
+        }
+
+    private:
+        /**
+         * @brief Gets the flat cell index.
+         * @param row Row index.
+         * @param column Column index.
+         * @return size_t Index into ends/nulls.
+         */
+        size_t cell(const size_t row, const size_t column) const
+        {
+            return row * columns.size() + column;
+        }
+
+        std::vector<std::string> columns; /**< Column names. */
+        std::string data; /**< Concatenated cell text. */
+        std::vector<size_t> ends; /**< End offset of each cell in data. */
+        std::vector<bool> nulls; /**< NULL flag of each cell. */
+};
+
+#endif // RESULT_SET_H
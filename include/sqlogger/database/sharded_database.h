@@ -0,0 +1,321 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef SHARDED_DATABASE_H
+#define SHARDED_DATABASE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "sqlogger/database/database_interface.h"
+#include "sqlogger/log_config.h"
+#include "sqlogger/internal/log_reader.h"
+#include "sqlogger/internal/log_writer.h"
+#include "sqlogger/internal/thread_pool.h"
+
+#define SHARD_PAGE_SIZE 1000 /**< Entries read from a shard at a time by a merge in ID order. */
+
+/**
+ * @class ShardedDatabase
+ * @brief IDatabase spreading the log table across databases of one type (see LogConfig::Config::shards).
+ * The logger sees a backend storing logs natively; every shard keeps the regular SQL schema
+ * through its own LogWriter and LogReader. Written batches go to one shard or are split by
+ * source ID (see ShardRouting), reads run on all shards concurrently and are merged in order,
+ * with limit and offset applied to the merged entries.
+ * Entry IDs are interleaved: local ID * shard count + shard index. Sources are stored on the
+ * first shard and copied to the others with the same ID.
+ * @note A batch split across shards is not atomic: when one shard fails, the others keep their part.
+ */
+class ShardedDatabase : public IDatabase
+{
+    public:
+        /**
+         * @brief Connects every shard and creates its schema.
+         * @param config Configuration with [Database] and the shard targets (see LogConfig::getShardConfigs()).
+         * @throws std::runtime_error If the database type is not specified.
+         * @throws std::invalid_argument If the database type is not supported.
+         */
+        explicit ShardedDatabase(const LogConfig::Config& config);
+
+        /**
+         * @brief Stops the fan-out threads and closes the shards.
+         */
+        ~ShardedDatabase();
+
+        /**
+         * @brief Gets the number of shards.
+         * @return size_t Shard count.
+         */
+        size_t getShardCount() const
+        {
+            return shards.size();
+        }
+
+        /**
+         * @brief Connects the shards that are not connected, each with its own connection string.
+         * @param connectionString Ignored.
+         * @return True if every shard is connected.
+         */
+        bool connect(const std::string& connectionString) override;
+
+        /**
+         * @brief Disconnects every shard.
+         */
+        void disconnect() override;
+
+        /**
+         * @brief Checks if every shard is connected.
+         * @return True if connected.
+         */
+        bool isConnected() const override;
+
+        /**
+         * @brief Executes an SQL query on every shard.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param affectedRows Optional pointer to store the affected rows of all shards.
+         * @return True if the query succeeded on every shard, false otherwise.
+         */
+        bool execute(const std::string& query,
+                     const std::vector<std::string> & params = {},
+                     int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Executes an SQL query with typed parameters on every shard.
+         * @param query The SQL query to execute.
+         * @param params Typed parameters.
+         * @param affectedRows Optional pointer to store the affected rows of all shards.
+         * @return True if the query succeeded on every shard, false otherwise.
+         */
+        bool execute(const std::string& query,
+                     const DbParamList& params,
+                     int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Executes an SQL query on the first shard and returns the result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @return A vector of maps representing the query result.
+         */
+        std::vector<std::map<std::string, std::string>> query(const std::string& query,
+                const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Checks if the backend stores log entries natively instead of executing SQL.
+         * @return Always true: the logger writes and reads through insertLogs() and selectLogs().
+         */
+        bool supportsNativeLogs() const override
+        {
+            return true;
+        }
+
+        /**
+         * @brief Stores log entries on the shards chosen by the routing, in parallel.
+         * @param table Log table name.
+         * @param entries Entries to store.
+         * @return True if all entries were stored, false otherwise (check getLastError() for details).
+         */
+        bool insertLogs(const std::string& table, const LogEntryList& entries) override;
+
+        /**
+         * @brief Reads the matching entries of every shard concurrently and passes them to a callback in order.
+         * @param table Log table name.
+         * @param filters Filters, combined with AND (ID filters are translated to the local IDs of each shard).
+         * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending, ties in ID order).
+         * @param limit Maximum number of entries (0 or negative = no limit).
+         * @param offset Number of entries to skip, requires a positive limit.
+         * @param callback Function called for each entry; return false to stop reading.
+         * @return size_t Number of entries passed to the callback.
+         */
+        size_t selectLogs(const std::string& table,
+                          const std::vector<Filter> & filters,
+                          const std::string& orderBy,
+                          const int limit,
+                          const int offset,
+                          const NativeLogCallback& callback) override;
+
+        /**
+         * @brief Removes all rows of a table on every shard.
+         * @param table Log table or sources table name.
+         * @return True if the table is stored by the sharded database.
+         */
+        bool clearTable(const std::string& table) override;
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Stores a source on the first shard and copies it to the others.
+         * @param uuid Source UUID, unique.
+         * @param name Source name.
+         * @return int ID of the new source, or SOURCE_NOT_FOUND if it was not stored.
+         */
+        int insertSource(const std::string& uuid, const std::string& name) override;
+
+        /**
+         * @brief Gets all sources of the first shard ordered by ID.
+         * @return std::vector<SourceInfo> Stored sources.
+         */
+        std::vector<SourceInfo> selectSources() override;
+#endif
+
+        /**
+         * @brief Begins a transaction on every shard.
+         * @return True if the transaction was started on every shard, false otherwise.
+         */
+        bool beginTransaction() override;
+
+        /**
+         * @brief Commits the current transaction of every shard.
+         * @return True if every shard committed, false otherwise.
+         */
+        bool commitTransaction() override;
+
+        /**
+         * @brief Rolls back the current transaction of every shard.
+         * @return True if every shard rolled back, false otherwise.
+         */
+        bool rollbackTransaction() override;
+
+        /**
+         * @brief Drops every shard database, each with its own connection string.
+         * @param connectionString Ignored.
+         * @return True if every shard was dropped, false otherwise.
+         */
+        bool dropDatabaseIfExists(const std::string& connectionString) override;
+
+        /**
+         * @brief Gets the last error of a failed shard operation.
+         * @return The last error message as a string.
+         */
+        std::string getLastError() const override;
+
+        /**
+         * @brief Gets the type of the shard databases.
+         * @return The database type.
+         */
+        DataBaseType getDatabaseType() const override;
+
+    private:
+        /**
+         * @struct Shard
+         * @brief One database of the sharded log table.
+         */
+        struct Shard
+        {
+            /**
+             * @brief Constructs a shard.
+             * @param database The connected database.
+             * @param connectionString Connection string of the database.
+             * @param logsTableName Log table name.
+             */
+            Shard(std::unique_ptr<IDatabase> database, const std::string& connectionString, const std::string& logsTableName)
+                : database(std::move(database)),
+                  connectionString(connectionString),
+                  writer( * this->database, logsTableName),
+                  reader( * this->database, logsTableName)
+            {
+            }
+
+            std::unique_ptr<IDatabase> database; /**< The connection. */
+            std::string connectionString; /**< Connection string used by connect() and dropDatabaseIfExists(). */
+            LogWriter writer; /**< Writes the entries routed to the shard. */
+            LogReader reader; /**< Reads the entries of the shard. */
+            std::mutex mutex; /**< Serializes the users of the connection. */
+        };
+
+        /**
+         * @brief Runs a task for each of the given shards, concurrently if there are several, and waits for all.
+         * @param indexes Shard indexes.
+         * @param task Function called with a shard index.
+         * @throws Rethrows the first exception of a task once every task has finished.
+         */
+        void forEachShard(const std::vector<size_t> & indexes, const std::function<void(const size_t shard)> & task);
+
+        /**
+         * @brief Runs a task for every shard concurrently and waits for all.
+         * @param task Function called with a shard index.
+         */
+        void forEachShard(const std::function<void(const size_t shard)> & task);
+
+        /**
+         * @brief Writes entries to one shard.
+         * @param shard Shard index.
+         * @param entries Entries to write.
+         * @return True if the entries were written, false otherwise.
+         */
+        bool writeShard(const size_t shard, const LogEntryList& entries);
+
+        /**
+         * @brief Reads entries of one shard and converts their IDs to global IDs.
+         * @param shard Shard index.
+         * @param filters Filters with local IDs.
+         * @param byId True to order by ID (keyset page after afterId), false to order by timestamp.
+         * @param count Maximum number of entries (0 = no limit).
+         * @param afterId Local ID after which an ID ordered page starts.
+         * @return LogEntryList Entries of the shard.
+         */
+        LogEntryList readShard(const size_t shard,
+                               const std::vector<Filter> & filters,
+                               const bool byId,
+                               const size_t count,
+                               const int64_t afterId);
+
+        /**
+         * @brief Translates filters on global entry IDs to the local IDs of a shard.
+         * @param filters Filters of the query.
+         * @param shard Shard index.
+         * @param shardFilters Receives the filters for the shard.
+         * @return bool False if no entry of the shard can match (e.g. "id = X" of another shard).
+         */
+        bool toShardFilters(const std::vector<Filter> & filters, const size_t shard, std::vector<Filter> & shardFilters) const;
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Stores a source of the first shard with the same ID on another shard.
+         * @param shard Shard index.
+         * @param source The source.
+         * @return bool True if the source was stored.
+         */
+        bool copySource(const size_t shard, const SourceInfo& source);
+
+        /**
+         * @brief Copies the sources of the first shard missing on the others (e.g. a shard added later).
+         */
+        void syncSources();
+#endif
+
+        /**
+         * @brief Records the error of a failed shard.
+         * @param shard Shard index.
+         * @param error Error message.
+         */
+        void setLastError(const size_t shard, const std::string& error);
+
+        std::vector<std::unique_ptr<Shard>> shards; /**< The shards, the first also stores the sources. */
+        std::unique_ptr<ThreadPool> pool; /**< Runs the per-shard work of a call in parallel (destroyed before the shards). */
+        std::string logsTableName; /**< Log table name. */
+        ShardRouting routing; /**< Shard choice of written batches. */
+        TimestampFormat timestampFormat; /**< Timestamp column format, decides the merge key. */
+        std::atomic<size_t> nextShard{ 0 }; /**< Next shard of ShardRouting::RoundRobin. */
+        mutable std::mutex errorMutex; /**< Guards lastError. */
+        std::string lastError; /**< Error of the last failed shard. */
+};
+
+#endif // SHARDED_DATABASE_H
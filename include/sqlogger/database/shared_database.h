@@ -0,0 +1,261 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef SHARED_DATABASE_H
+#define SHARED_DATABASE_H
+
+#include <memory>
+#include <mutex>
+#include "sqlogger/database/database_interface.h"
+
+/**
+ * @struct SharedConnection
+ * @brief One database connection used by several loggers (see LogConfig::Config::shareConnection).
+ */
+struct SharedConnection
+{
+    /**
+     * @brief Constructs a shared connection.
+     * @param database The connected database.
+     */
+    explicit SharedConnection(std::unique_ptr<IDatabase> database) : database(std::move(database)) {};
+
+    std::unique_ptr<IDatabase> database; /**< The connection, closed when the last user releases it. */
+    std::recursive_mutex mutex; /**< Serializes the users; held from beginTransaction() to commit or rollback. */
+};
+
+/**
+ * @class SharedDatabase
+ * @brief IDatabase of one logger forwarding to a SharedConnection.
+ * Every call holds the connection mutex, and an open transaction keeps it until it is
+ * committed or rolled back, so statements of other loggers never join it.
+ * Transactions must therefore end on the thread that began them (group commit is not supported).
+ */
+class SharedDatabase : public IDatabase
+{
+    public:
+        /**
+         * @brief Constructs a user of a shared connection.
+         * @param connection The shared connection.
+         */
+        explicit SharedDatabase(std::shared_ptr<SharedConnection> connection) : connection(std::move(connection)) {};
+
+        /**
+         * @brief Rolls back a transaction left open, releasing the connection.
+         */
+        ~SharedDatabase();
+
+        /**
+         * @brief Connects the shared connection unless already connected.
+         * @param connectionString The connection string.
+         * @return True if the connection is open.
+         */
+        bool connect(const std::string& connectionString) override;
+
+        /**
+         * @brief Does nothing: other loggers still use the connection, it is closed with the last of them.
+         */
+        void disconnect() override;
+
+        /**
+         * @brief Checks if the shared connection is open.
+         * @return True if connected.
+         */
+        bool isConnected() const override;
+
+        /**
+         * @brief Executes an SQL query.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param affectedRows Optional pointer to store number of affected rows.
+         * @return True if the query was executed successfully, false otherwise.
+         */
+        bool execute(const std::string& query,
+                     const std::vector<std::string> & params = {},
+                     int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Executes an SQL query with typed parameters.
+         * @param query The SQL query to execute.
+         * @param params Typed parameters.
+         * @param affectedRows Optional pointer to store number of affected rows.
+         * @return True if the query was executed successfully, false otherwise.
+         */
+        bool execute(const std::string& query,
+                     const DbParamList& params,
+                     int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Executes an SQL query and returns the result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @return A vector of maps representing the query result.
+         */
+        std::vector<std::map<std::string, std::string>> query(const std::string& query,
+                const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Executes an SQL query and returns a compact columnar result.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @return ResultSet with the rows of the query.
+         */
+        ResultSet queryResultSet(const std::string& query,
+                                 const std::vector<std::string> & params = {}) override;
+
+        /**
+         * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+         * The connection stays locked until the callback stops or the rows end.
+         * @param query The SQL query to execute.
+         * @param params The parameters to bind to the query.
+         * @param callback Function called for each row; return false to stop reading.
+         * @return True if the query was executed successfully, false otherwise.
+         */
+        bool queryEach(const std::string& query,
+                       const std::vector<std::string> & params,
+                       const RowCallback& callback) override;
+
+        /**
+         * @brief Checks if the backend implements bulkInsert().
+         * @return True if a native bulk-load path is available, false otherwise.
+         */
+        bool supportsBulkInsert() const override;
+
+        /**
+         * @brief Loads rows through the native bulk path of the shared connection.
+         * @param table Target table name.
+         * @param fields Column names.
+         * @param values Row-major values, fields.size() items per row.
+         * @param affectedRows Optional pointer to store number of loaded rows.
+         * @return True if all rows were loaded, false otherwise.
+         */
+        bool bulkInsert(const std::string& table,
+                        const std::vector<std::string> & fields,
+                        const std::vector<std::string> & values,
+                        int* affectedRows = nullptr) override;
+
+        /**
+         * @brief Checks if query() can run INSERT ... ON CONFLICT ... RETURNING statements.
+         * @return True if the shared connection supports it.
+         */
+        bool supportsReturning() const override;
+
+        /**
+         * @brief Checks if the backend stores log entries natively instead of executing SQL.
+         * @return True if the native log methods are implemented, false otherwise.
+         */
+        bool supportsNativeLogs() const override;
+
+        /**
+         * @brief Stores log entries without SQL.
+         * @param table Log table name.
+         * @param entries Entries to store.
+         * @return True if all entries were stored, false otherwise.
+         */
+        bool insertLogs(const std::string& table, const LogEntryList& entries) override;
+
+        /**
+         * @brief Passes the log entries matching the filters to a callback.
+         * @param table Log table name.
+         * @param filters Filters, combined with AND.
+         * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending).
+         * @param limit Maximum number of entries (0 or negative = no limit).
+         * @param offset Number of entries to skip, requires a positive limit.
+         * @param callback Function called for each entry; return false to stop reading.
+         * @return size_t Number of entries passed to the callback.
+         */
+        size_t selectLogs(const std::string& table,
+                          const std::vector<Filter> & filters,
+                          const std::string& orderBy,
+                          const int limit,
+                          const int offset,
+                          const NativeLogCallback& callback) override;
+
+        /**
+         * @brief Removes all rows of a table.
+         * @param table Table name.
+         * @return True if the table was cleared, false otherwise.
+         */
+        bool clearTable(const std::string& table) override;
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Stores a source without SQL.
+         * @param uuid Source UUID, unique.
+         * @param name Source name.
+         * @return int ID of the new source, or SOURCE_NOT_FOUND if it was not stored.
+         */
+        int insertSource(const std::string& uuid, const std::string& name) override;
+
+        /**
+         * @brief Gets all sources ordered by ID.
+         * @return std::vector<SourceInfo> Stored sources.
+         */
+        std::vector<SourceInfo> selectSources() override;
+#endif
+
+        /**
+         * @brief Begins a transaction; the connection stays locked until it ends.
+         * @return True if the transaction was started successfully, false otherwise.
+         */
+        bool beginTransaction() override;
+
+        /**
+         * @brief Commits the current transaction and releases the connection.
+         * @return True if the transaction was committed successfully, false otherwise
+         * (the transaction stays open until it is rolled back).
+         */
+        bool commitTransaction() override;
+
+        /**
+         * @brief Rolls back the current transaction and releases the connection.
+         * @return True if the transaction was rolled back successfully, false otherwise.
+         */
+        bool rollbackTransaction() override;
+
+        /**
+         * @brief Drops the database if it exists.
+         * @param connectionString The connection string.
+         * @return True if the database was successfully dropped, false otherwise.
+         */
+        bool dropDatabaseIfExists(const std::string& connectionString) override;
+
+        /**
+         * @brief Gets the last error message of the shared connection.
+         * @return The last error message as a string.
+         */
+        std::string getLastError() const override;
+
+        /**
+         * @brief Gets the type of the database.
+         * @return The database type.
+         */
+        DataBaseType getDatabaseType() const override;
+
+    private:
+        /**
+         * @brief Releases the connection lock taken by beginTransaction().
+         */
+        void endTransaction();
+
+        std::shared_ptr<SharedConnection> connection; /**< The shared connection. */
+        bool transactionOpen = false; /**< Whether this user holds the connection for a transaction. */
+};
+
+#endif // SHARED_DATABASE_H
@@ -26,6 +26,9 @@
 #include "database_helper.h"
 #include "database_schema.h"
 
+#define SQL_VIEW_MAX_UNION_TERMS 400 /**< UNION ALL terms per compound select of buildUnionViewSQL() (SQLite allows 500). */
+#define SQL_COUNT_ALIAS "count" /**< Column holding the row count of buildSQLGroupCount(). */
+
 /**
  * @brief Array of allowed foreign key actions
  */
@@ -79,6 +82,166 @@ class SQLBuilder
          */
         static std::string buildIndexExistsQuery(DataBaseType dbType, const std::string& indexName);
 
+        /**
+         * @brief Builds query to check if view exists
+         * @param dbType Target database type
+         * @param viewName View name to check
+         * @return Formatted view existence query
+         */
+        static std::string buildViewExistsQuery(DataBaseType dbType, const std::string& viewName);
+
+        /**
+         * @brief Builds query reading the schema version marker of a table
+         * @param dbType Target database type
+         * @param schemaTable Schema version table name
+         * @param table Table whose marker is read
+         * @param requiredTables Tables that must exist for the marker to be returned
+         * @return Formatted query returning FIELD_SCHEMA_VERSION (no row if the marker or a table is missing)
+         */
+        static std::string buildSchemaVersionQuery(DataBaseType dbType,
+                const std::string& schemaTable,
+                const std::string& table,
+                const std::vector<std::string> & requiredTables);
+
+        /**
+         * @brief Builds an INSERT that keeps the existing row on a unique key conflict and returns its columns
+         * @param dbType Target database type (SQLite 3.35+ or PostgreSQL)
+         * @param table Table name
+         * @param values Vector of column-value pairs
+         * @param conflictField Unique column identifying the row
+         * @param returning Columns returned for the inserted or existing row
+         * @return Formatted INSERT ... ON CONFLICT ... RETURNING statement
+         */
+        static std::string buildSQLUpsertReturning(DataBaseType dbType,
+                const std::string& table,
+                const std::vector<std::pair<std::string, std::string>> & values,
+                const std::string& conflictField,
+                const std::vector<std::string> & returning);
+
+        /**
+        * @brief Builds the statement adding a range partition to a partitioned table
+        * @param dbType Target database type (PostgreSQL or MySQL)
+        * @param tableName Partitioned table name
+        * @param partitionField Partition key field
+        * @param partitionName Partition name (PostgreSQL: table name of the partition)
+        * @param lowerBound Inclusive lower bound (PostgreSQL only, MySQL ranges start at the previous partition)
+        * @param upperBound Exclusive upper bound
+        * @param first Whether this is the first partition (MySQL: partitions the table)
+        * @return Formatted statement (empty if not supported)
+        */
+        static std::string buildCreatePartitionSQL(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& partitionField,
+            const std::string& partitionName,
+            const std::string& lowerBound,
+            const std::string& upperBound,
+            const bool first);
+
+        /**
+        * @brief Builds the statement dropping a partition with all its rows
+        * @param dbType Target database type
+        * @param tableName Partitioned table name
+        * @param partitionName Partition name (SQLite and PostgreSQL: table name of the partition)
+        * @return Formatted statement (empty if not supported)
+        */
+        static std::string buildDropPartitionSQL(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& partitionName);
+
+        /**
+        * @brief Builds a query listing the partitions of a table
+        * SQLite has no partitions: the query lists the tables named <table>_p*,
+        * which the caller still has to match exactly.
+        * @param dbType Target database type
+        * @param tableName Partitioned table name
+        * @return Formatted query returning a "name" column
+        */
+        static std::string buildPartitionsQuery(DataBaseType dbType, const std::string& tableName);
+
+        /**
+        * @brief Builds a CREATE VIEW statement concatenating tables with UNION ALL
+        * Tables are grouped into nested compound selects of at most SQL_VIEW_MAX_UNION_TERMS,
+        * staying below the SQLite compound select limit.
+        * @param dbType Target database type
+        * @param viewName View name
+        * @param tables Tables with identical columns (at least one)
+        * @return Formatted CREATE VIEW statement (empty if no tables)
+        */
+        static std::string buildUnionViewSQL(
+            DataBaseType dbType,
+            const std::string& viewName,
+            const std::vector<std::string> & tables);
+
+        /**
+        * @brief Builds a DROP VIEW statement
+        * @param dbType Target database type
+        * @param viewName View name
+        * @return Formatted DROP VIEW statement
+        */
+        static std::string buildDropViewSQL(DataBaseType dbType, const std::string& viewName);
+
+        /**
+        * @brief Builds the statements creating a full-text index on a text column
+        * SQLite: an external content FTS5 table <table>_fts kept in sync by triggers;
+        * PostgreSQL: a GIN index on to_tsvector(FTS_PG_CONFIG, column); MySQL: a FULLTEXT index.
+        * @param dbType Target database type
+        * @param tableName Indexed table name
+        * @param indexName Index name (the SQLite triggers are named after it)
+        * @param field Text column
+        * @return std::vector<std::string> Statements (empty if not supported)
+        */
+        static std::vector<std::string> buildCreateFullTextIndexSQL(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& indexName,
+            const std::string& field);
+
+        /**
+        * @brief Builds the statements dropping a full-text index
+        * @param dbType Target database type
+        * @param tableName Indexed table name
+        * @param indexName Index name
+        * @return std::vector<std::string> Statements (empty if not supported)
+        */
+        static std::vector<std::string> buildDropFullTextIndexSQL(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& indexName);
+
+        /**
+        * @brief Builds the statement indexing the rows written before the full-text index existed
+        * @param dbType Target database type
+        * @param tableName Indexed table name
+        * @return Formatted statement (empty if the database indexes existing rows on creation)
+        */
+        static std::string buildRebuildFullTextIndexSQL(DataBaseType dbType, const std::string& tableName);
+
+        /**
+        * @brief Builds the full-text condition of a MATCH filter
+        * @param dbType Target database type
+        * @param tableName Filtered table name (SQLite: the full-text table is <table>_fts)
+        * @param field Text column
+        * @param placeholder Placeholder of the search value (see buildMatchValue())
+        * @return Formatted condition
+        */
+        static std::string buildMatchCondition(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& field,
+            const std::string& placeholder);
+
+        /**
+        * @brief Converts search words to the full-text query syntax of a database
+        * Every word is quoted, so the words are matched literally and all of them must occur:
+        * "a" "b" (SQLite FTS5), +"a" +"b" (MySQL boolean mode), the words as is (PostgreSQL plainto_tsquery).
+        * @param dbType Target database type
+        * @param text Search words separated by whitespace
+        * @return Search value bound to the MATCH condition
+        */
+        static std::string buildMatchValue(DataBaseType dbType, const std::string& text);
+
         /**
          * @brief Builds SQL INSERT statement
          * @param table Table name
@@ -113,6 +276,40 @@ class SQLBuilder
                                           const std::string& paramPrefix,
                                           DataBaseType dbType);
 
+        /**
+         * @brief Builds SQL SELECT ... GROUP BY statement counting the rows of each group
+         * @param groupFields Grouping columns, returned under their own names
+         * @param table Table name
+         * @param filters WHERE conditions
+         * @param bucketSeconds Width of the FIELD_LOG_TIMESTAMP groups in seconds (0 = group by value)
+         * @param timestampFormat Format of the FIELD_LOG_TIMESTAMP column
+         * @param paramPrefix Parameter prefix
+         * @param dbType Database type
+         * @return Formatted statement returning the group columns and SQL_COUNT_ALIAS, ordered by group
+         */
+        static std::string buildSQLGroupCount(const std::vector<std::string> & groupFields,
+                                              const std::string& table,
+                                              const std::vector<Filter> & filters,
+                                              const int bucketSeconds,
+                                              const TimestampFormat timestampFormat,
+                                              const std::string& paramPrefix,
+                                              DataBaseType dbType);
+
+        /**
+         * @brief Builds the expression truncating a timestamp column to the start of its time bucket
+         * Text timestamps give the bucket start as TIMESTAMP_FMT text, epoch microseconds give
+         * it in seconds since the epoch; buckets are aligned to multiples of their width.
+         * @param dbType Database type
+         * @param field Timestamp column
+         * @param bucketSeconds Bucket width in seconds (positive)
+         * @param timestampFormat Format of the column
+         * @return Formatted expression
+         */
+        static std::string buildTimeBucketExpression(DataBaseType dbType,
+                const std::string& field,
+                const int bucketSeconds,
+                const TimestampFormat timestampFormat);
+
         /**
          * @brief Builds SQL UPDATE statement
          * @param table Table name
@@ -151,6 +348,18 @@ class SQLBuilder
             const std::string& indexName,
             const std::vector<std::string> & columns);
 
+        /**
+        * @brief Builds DROP INDEX SQL statement
+        * @param dbType Target database type
+        * @param tableName Table name
+        * @param indexName Index name
+        * @return Formatted DROP INDEX statement
+        */
+        static std::string buildDropIndexSQL(
+            DataBaseType dbType,
+            const std::string& tableName,
+            const std::string& indexName);
+
         /**
         * @brief Escapes special characters in SQL values
         * @param dbType Target database type
@@ -181,11 +390,13 @@ class SQLBuilder
         * @param dbType Database type
         * @param filters Filter conditions
         * @param paramPrefix Parameter prefix
+        * @param table Filtered table (needed by MATCH filters)
         * @return Formatted WHERE clause
         */
         static std::string buildWhereClause(DataBaseType dbType,
                                             const std::vector<Filter> & filters,
-                                            const std::string& paramPrefix);
+                                            const std::string& paramPrefix,
+                                            const std::string& table = "");
 
         /**
         * @brief Resolves the appropriate auto-increment syntax for a given database type and field type
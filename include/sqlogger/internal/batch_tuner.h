@@ -0,0 +1,159 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef BATCH_TUNER_H
+#define BATCH_TUNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#define BATCH_TUNER_SMOOTHING 4 /**< Weight of the previous average in the smoothed batch latency (1/N for a new sample). */
+
+/**
+ * @class BatchTuner
+ * @brief Runtime controller of the batch size and flush interval of adaptive batching.
+ * Each processed batch reports its write latency and the queue depth behind it:
+ * - latency above the target shrinks the batch size by a quarter;
+ * - a queue deeper than one batch (burst) grows it by half, capped at the size
+ *   the measured per-entry cost allows within the target;
+ * - partial batches with a short queue (idle, timer flushes) move it halfway toward their size.
+ * The flush interval is the target minus the smoothed write latency, so a buffered entry
+ * is written within roughly the target latency.
+ */
+class BatchTuner
+{
+    public:
+        /**
+         * @brief Constructs a tuner.
+         * @param minSize Smallest batch size.
+         * @param maxSize Largest batch size.
+         * @param initialSize Starting batch size (clamped to the range).
+         * @param targetLatency Target write latency of one batch.
+         * @param maxInterval Longest flush interval.
+         */
+        BatchTuner(const size_t minSize, const size_t maxSize, const size_t initialSize,
+                   const std::chrono::microseconds& targetLatency, const std::chrono::milliseconds& maxInterval)
+            : minSize(std::max<size_t>(minSize, 1)),
+              maxSize(std::max(maxSize, std::max<size_t>(minSize, 1))),
+              targetUs(static_cast<uint64_t>(std::max<int64_t>(targetLatency.count(), 1))),
+              maxIntervalMs(std::max<int64_t>(maxInterval.count(), 1)),
+              batchSize(clampSize(initialSize)),
+              intervalMs(maxIntervalMs)
+        {
+        }
+
+        BatchTuner(const BatchTuner&) = delete;
+        BatchTuner& operator=(const BatchTuner&) = delete;
+
+        /**
+         * @brief Records a processed batch and adjusts the batch size and flush interval.
+         * @param size Number of entries in the batch.
+         * @param processTimeUs Time taken to write the batch in microseconds.
+         * @param queueDepth Entries handed over and not yet taken by a writer.
+         */
+        void record(const size_t size, const uint64_t processTimeUs, const uint64_t queueDepth)
+        {
+            if(size == 0)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            averageUs = averageUs == 0
+                        ? processTimeUs
+                        : (averageUs * (BATCH_TUNER_SMOOTHING - 1) + processTimeUs) / BATCH_TUNER_SMOOTHING;
+
+            size_t next = batchSize.load(std::memory_order_relaxed);
+            if(processTimeUs > targetUs)
+            {
+                next -= std::max<size_t>(next / 4, 1);
+            }
+            else if(queueDepth >= next)
+            {
+                // Grow no further than the measured per-entry cost allows within the target
+                const uint64_t perEntryUs = std::max<uint64_t>(processTimeUs / size, 1);
+                next = std::min<uint64_t>(next + next / 2 + 1, std::max<uint64_t>(targetUs / perEntryUs, next));
+            }
+            else if(size < next / 2)
+            {
+                next = (next + size) / 2;
+            }
+            batchSize.store(clampSize(next), std::memory_order_relaxed);
+
+            const int64_t remainingMs = static_cast<int64_t>((targetUs - std::min(averageUs, targetUs)) / 1000);
+            intervalMs.store(std::clamp<int64_t>(remainingMs, 1, maxIntervalMs), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Restarts tuning from a batch size (e.g. after SQLogger::setBatchSize()).
+         * @param size Batch size (clamped to the range).
+         */
+        void reset(const size_t size)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            averageUs = 0;
+            batchSize.store(clampSize(size), std::memory_order_relaxed);
+            intervalMs.store(maxIntervalMs, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the current batch size.
+         * @return size_t Number of buffered entries that triggers a flush.
+         */
+        size_t getBatchSize() const
+        {
+            return batchSize.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the current flush interval.
+         * @return std::chrono::milliseconds Maximum age of a partial batch.
+         */
+        std::chrono::milliseconds getFlushInterval() const
+        {
+            return std::chrono::milliseconds(intervalMs.load(std::memory_order_relaxed));
+        }
+
+    private:
+        /**
+         * @brief Clamps a batch size to the tuner range.
+         * @param size Batch size.
+         * @return size_t Clamped size.
+         */
+        size_t clampSize(const size_t size) const
+        {
+            return std::clamp(size, minSize, maxSize);
+        }
+
+        const size_t minSize; /**< Smallest batch size. */
+        const size_t maxSize; /**< Largest batch size. */
+        const uint64_t targetUs; /**< Target batch latency in microseconds. */
+        const int64_t maxIntervalMs; /**< Longest flush interval in milliseconds. */
+
+        std::mutex mutex; /**< Serializes record() and reset(). */
+        uint64_t averageUs = 0; /**< Smoothed batch latency (0 = no sample yet). */
+        std::atomic<size_t> batchSize; /**< Current batch size. */
+        std::atomic<int64_t> intervalMs; /**< Current flush interval. */
+};
+
+#endif // BATCH_TUNER_H
@@ -0,0 +1,118 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#define BUFFER_POOL_DEFAULT_SIZE 8 /**< Default number of idle buffers kept by a BufferPool. */
+
+/**
+ * @class BufferPool
+ * @brief Pool of recycled std::vector buffers.
+ * A released buffer is cleared but keeps its capacity, so a batch taken from the pool
+ * is usually filled without reallocating (and moving) its elements.
+ * @tparam T Element type.
+ */
+template <typename T>
+class BufferPool
+{
+    public:
+        /**
+         * @brief Constructs a pool.
+         * @param maxBuffers Maximum number of idle buffers kept (further releases are freed).
+         */
+        explicit BufferPool(const size_t maxBuffers = BUFFER_POOL_DEFAULT_SIZE) : maxBuffers(maxBuffers) {};
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        /**
+         * @brief Takes an empty buffer from the pool, or creates one if the pool is empty.
+         * @param capacity Minimum capacity of the returned buffer.
+         * @return std::vector<T> Empty buffer.
+         */
+        std::vector<T> acquire(const size_t capacity = 0)
+        {
+            std::vector<T> buffer;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!buffers.empty())
+                {
+                    buffer = std::move(buffers.back());
+                    buffers.pop_back();
+                    ++reuses;
+                }
+            }
+            buffer.reserve(capacity);
+            return buffer;
+        }
+
+        /**
+         * @brief Returns a buffer to the pool. Its elements are destroyed, its capacity is kept.
+         * @param buffer Buffer to recycle.
+         */
+        void release(std::vector<T>&& buffer)
+        {
+            buffer.clear();
+            if(buffer.capacity() == 0)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if(buffers.size() < maxBuffers)
+            {
+                buffers.push_back(std::move(buffer));
+            }
+        }
+
+        /**
+         * @brief Gets the number of idle buffers.
+         * @return size_t Buffers held by the pool.
+         */
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return buffers.size();
+        }
+
+        /**
+         * @brief Gets the number of acquire() calls served by a recycled buffer.
+         * @return uint64_t Reused buffers.
+         */
+        uint64_t getReuses() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return reuses;
+        }
+
+    private:
+        size_t maxBuffers; /**< Maximum number of idle buffers. */
+        mutable std::mutex mutex; /**< Guards buffers and reuses. */
+        std::vector<std::vector<T>> buffers; /**< Idle buffers. */
+        uint64_t reuses = 0; /**< acquire() calls served from the pool. */
+};
+
+#endif // BUFFER_POOL_H
@@ -0,0 +1,161 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "sqlogger/database/database_interface.h"
+#include "sqlogger/internal/log_strings.h"
+
+#define CONNECTION_POOL_HEALTH_CHECK_MS 30000 /**< Idle time after which a pooled connection is pinged before reuse. */
+#define CONNECTION_POOL_PING_QUERY "SELECT 1" /**< Query used to check an idle connection. */
+
+/**
+ * @class ConnectionPool
+ * @brief Bounded pool of database connections for parallel writers.
+ * Connections are opened lazily on first use, checked before reuse
+ * (isConnected(), plus a ping after being idle for the health check interval)
+ * and reopened through the factory when found broken.
+ */
+class ConnectionPool
+{
+    public:
+        using Factory = std::function<std::unique_ptr<IDatabase>()>; /**< Opens a new connection. */
+
+        /**
+         * @class Lease
+         * @brief Exclusive use of one pooled connection; returns it to the pool on destruction.
+         */
+        class Lease
+        {
+            public:
+                Lease(Lease&& other) noexcept = default;
+                Lease& operator=(Lease&& other) = delete;
+                Lease(const Lease&) = delete;
+                Lease& operator=(const Lease&) = delete;
+
+                ~Lease()
+                {
+                    if(database)
+                    {
+                        pool->release(std::move(database), broken);
+                    }
+                }
+
+                /**
+                 * @brief Gets the leased connection.
+                 * @return IDatabase& The connection.
+                 */
+                IDatabase& get()
+                {
+                    return * database;
+                }
+
+                /**
+                 * @brief Marks the connection as broken, so it is closed instead of reused.
+                 */
+                void invalidate()
+                {
+                    broken = true;
+                }
+
+            private:
+                friend class ConnectionPool;
+
+                Lease(ConnectionPool& pool, std::unique_ptr<IDatabase> database)
+                    : pool( & pool), database(std::move(database)) {}
+
+                ConnectionPool* pool; /**< Owning pool. */
+                std::unique_ptr<IDatabase> database; /**< Leased connection. */
+                bool broken = false; /**< True if the connection must not be reused. */
+        };
+
+        /**
+         * @brief Constructs a pool (no connections are opened yet).
+         * @param maxSize Maximum number of open connections.
+         * @param factory Function opening a new connection.
+         * @param healthCheckInterval Idle time after which a connection is pinged before reuse.
+         */
+        ConnectionPool(const size_t maxSize,
+                       Factory factory,
+                       const std::chrono::milliseconds healthCheckInterval = std::chrono::milliseconds(CONNECTION_POOL_HEALTH_CHECK_MS));
+
+        /**
+         * @brief Takes a connection, waiting while all connections are leased.
+         * @return Lease Exclusive use of a healthy connection.
+         * @throws std::runtime_error If a new connection could not be opened.
+         */
+        Lease acquire();
+
+        /**
+         * @brief Gets the maximum number of connections.
+         * @return size_t Pool size.
+         */
+        size_t getMaxSize() const;
+
+        /**
+         * @brief Gets the number of currently open connections (leased and idle).
+         * @return size_t Open connection count.
+         */
+        size_t getOpenCount() const;
+
+    private:
+        /**
+         * @struct IdleConnection
+         * @brief Connection waiting in the pool.
+         */
+        struct IdleConnection
+        {
+            std::unique_ptr<IDatabase> database; /**< The connection. */
+            std::chrono::steady_clock::time_point lastUsed; /**< When it was returned. */
+        };
+
+        /**
+         * @brief Returns a connection to the pool.
+         * @param database The connection.
+         * @param broken If true, the connection is closed instead of kept.
+         */
+        void release(std::unique_ptr<IDatabase> database, const bool broken);
+
+        /**
+         * @brief Checks if an idle connection can be reused.
+         * @param connection The idle connection.
+         * @return bool True if healthy.
+         */
+        bool isHealthy(const IdleConnection& connection) const;
+
+        const size_t maxSize; /**< Maximum number of open connections. */
+        const Factory factory; /**< Opens new connections. */
+        const std::chrono::milliseconds healthCheckInterval; /**< Idle time before a ping. */
+
+        mutable std::mutex mutex; /**< Protects idle and openCount. */
+        std::condition_variable available; /**< Signals a returned connection or a free slot. */
+        std::vector<IdleConnection> idle; /**< Idle connections (most recently used last). */
+        size_t openCount = 0; /**< Open connections, including ones being opened. */
+};
+
+#endif // CONNECTION_POOL_H
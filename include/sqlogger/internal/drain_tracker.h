@@ -0,0 +1,159 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef DRAIN_TRACKER_H
+#define DRAIN_TRACKER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+/**
+ * @class DrainTracker
+ * @brief Tracks completion of asynchronously written entries by sequence number.
+ * Producers take sequence numbers with a single atomic increment; writers report
+ * completed sequences (in any order) and waiters block on a condition variable
+ * until every sequence below their target is complete.
+ */
+class DrainTracker
+{
+    public:
+        DrainTracker() = default;
+
+        DrainTracker(const DrainTracker&) = delete;
+        DrainTracker& operator=(const DrainTracker&) = delete;
+
+        /**
+         * @brief Reserves sequence numbers for entries about to be handed to a writer.
+         * @param count Number of entries.
+         * @return uint64_t First reserved sequence number (the rest follow contiguously).
+         */
+        uint64_t submit(const uint64_t count = 1)
+        {
+            return nextSequence.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the sequence number the next submitted entry will receive.
+         * @return uint64_t Sequence number (every entry submitted so far is below it).
+         */
+        uint64_t submitted() const
+        {
+            return nextSequence.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Marks a contiguous range of sequence numbers as complete.
+         * Wakes waiters when the completed prefix grows.
+         * @param first First sequence number.
+         * @param count Number of sequence numbers.
+         */
+        void complete(const uint64_t first, const uint64_t count = 1)
+        {
+            if(count == 0)
+            {
+                return;
+            }
+
+            bool notify = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                const uint64_t previous = watermark;
+                const uint64_t end = first + count;
+                if(first == watermark)
+                {
+                    watermark = end;
+                }
+                else
+                {
+                    // Completed ahead of older entries: keep until the gap closes
+                    pending.emplace(first, end);
+                }
+
+                for(auto it = pending.begin(); it != pending.end() && it->first <= watermark; it = pending.erase(it))
+                {
+                    watermark = std::max(watermark, it->second);
+                }
+                notify = waiters > 0 && watermark > previous;
+            }
+
+            if(notify)
+            {
+                condition.notify_all();
+            }
+        }
+
+        /**
+         * @brief Gets the completed prefix.
+         * @return uint64_t Every sequence number below it is complete.
+         */
+        uint64_t completed() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return watermark;
+        }
+
+        /**
+         * @brief Waits without a time limit until every sequence number below the target is complete.
+         * @param target Sequence number to wait for (usually a submitted() snapshot).
+         */
+        void wait(const uint64_t target)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++waiters;
+            condition.wait(lock, [this, target]
+            {
+                return watermark >= target;
+            });
+            --waiters;
+        }
+
+        /**
+         * @brief Waits until every sequence number below the target is complete.
+         * @param target Sequence number to wait for (usually a submitted() snapshot).
+         * @param timeout The maximum time to wait.
+         * @return bool True if the target was reached within the timeout, false otherwise.
+         */
+        bool waitFor(const uint64_t target, const std::chrono::milliseconds& timeout)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++waiters;
+            const bool reached = condition.wait_for(lock, timeout, [this, target]
+            {
+                return watermark >= target;
+            });
+            --waiters;
+            return reached;
+        }
+
+    private:
+        std::atomic<uint64_t> nextSequence{ 0 }; /**< Next sequence number to hand out. */
+
+        mutable std::mutex mutex; /**< Guards watermark, pending and waiters. */
+        std::condition_variable condition; /**< Signalled when the watermark advances. */
+        uint64_t watermark = 0; /**< Every sequence number below it is complete. */
+        std::map<uint64_t, uint64_t> pending; /**< Out-of-order completed ranges (first -> end). */
+        size_t waiters = 0; /**< Threads blocked in waitFor(). */
+};
+
+#endif // DRAIN_TRACKER_H
@@ -0,0 +1,166 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef ERROR_LOG_H
+#define ERROR_LOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "sqlogger/internal/fs_helper.h"
+
+#define ERROR_LOG_FLUSH_INTERVAL_MS 200 /**< Maximum time a line stays in the buffer. */
+#define ERROR_LOG_BUFFER_SIZE (64 * 1024) /**< Buffered bytes that wake the flush thread early. */
+#define ERROR_LOG_RATE_LIMIT 100 /**< Default lines written per second, the rest are counted. */
+#define ERROR_LOG_NOTICE_INTERVAL_MS 30000 /**< Interval of repeat and suppression counts during a storm. */
+#define ERROR_LOG_MAX_BYTES static_cast<uint64_t>(MAX_ERROR_LOG_SIZE * 1024 * 1024) /**< Default size at which the file is rotated. */
+
+/**
+ * @class ErrorLog
+ * @brief Buffered sink of the internal error log.
+ * write() formats the line into a memory buffer and returns; a background thread
+ * (started on the first error) appends the buffer to a file that stays open. A message
+ * repeated from the same location is written once and followed by a repeat count, and
+ * at most rateLimit lines per second are written, the rest are reported as a count.
+ * The file is rotated when the bytes written to it exceed maxBytes, without a stat per line.
+ */
+class ErrorLog
+{
+    public:
+        /**
+         * @struct Stats
+         * @brief Counters of the error log.
+         */
+        struct Stats
+        {
+            uint64_t written = 0; /**< Lines written (notices included). */
+            uint64_t repeated = 0; /**< Repeated messages folded into a repeat count. */
+            uint64_t suppressed = 0; /**< Messages dropped by the rate limit. */
+        };
+
+        /**
+         * @brief Constructs an error log.
+         * @param path Error log file path.
+         * @param rateLimit Lines written per second (0 = unlimited).
+         * @param maxBytes File size at which the file is rotated (0 = never).
+         */
+        explicit ErrorLog(const std::string& path = ERR_LOG_FILE,
+                          const size_t rateLimit = ERROR_LOG_RATE_LIMIT,
+                          const uint64_t maxBytes = ERROR_LOG_MAX_BYTES);
+
+        /**
+         * @brief Writes the buffered lines and stops the flush thread.
+         */
+        ~ErrorLog();
+
+        ErrorLog(const ErrorLog&) = delete;
+        ErrorLog& operator=(const ErrorLog&) = delete;
+
+        /**
+         * @brief Writes the buffered lines and switches to another file.
+         * @param path Error log file path.
+         */
+        void setPath(const std::string& path);
+
+        /**
+         * @brief Gets the error log file path.
+         * @return std::string Path.
+         */
+        std::string getPath() const;
+
+        /**
+         * @brief Buffers an error line.
+         * @param message The error message.
+         * @param function The function where the error occurred.
+         * @param file The file where the error occurred.
+         * @param line The line number where the error occurred.
+         */
+        void write(const std::string& message, const std::string& function, const std::string& file, const int line);
+
+        /**
+         * @brief Writes the buffered lines (and pending repeat and suppression counts) to the file.
+         */
+        void flush();
+
+        /**
+         * @brief Gets the error log counters.
+         * @return Stats Counters.
+         */
+        Stats getStats() const;
+
+    private:
+        /**
+         * @brief Appends the pending repeat and suppression counts to the buffer (mutex held).
+         * @param force Whether to report them before ERROR_LOG_NOTICE_INTERVAL_MS has elapsed.
+         */
+        void appendNotices(const bool force);
+
+        /**
+         * @brief Appends the buffer to the file.
+         * @param force Whether to report pending repeat and suppression counts.
+         */
+        void flushBuffer(const bool force);
+
+        /**
+         * @brief Appends a timestamped line to the buffer (mutex held).
+         * @param text Line text.
+         */
+        void appendLine(const std::string& text);
+
+        /**
+         * @brief Appends lines to the file, rotating it first if it would grow past maxBytes (fileMutex held).
+         * @param data Buffered lines.
+         * @param target Error log file path.
+         */
+        void writeFile(const std::string& data, const std::string& target);
+
+        /**
+         * @brief Flush thread body.
+         */
+        void flushLoop();
+
+        size_t rateLimit; /**< Lines written per second (0 = unlimited). */
+        uint64_t maxBytes; /**< Rotation size (0 = never). */
+
+        mutable std::mutex mutex; /**< Guards the buffer, the dedup and rate limit state and the thread. */
+        std::condition_variable condition; /**< Wakes the flush thread. */
+        std::string path; /**< Error log file path. */
+        std::string buffer; /**< Lines not yet written. */
+        std::string lastMessage; /**< Last message, with its location, for deduplication. */
+        uint64_t repeats = 0; /**< Repeats of lastMessage not yet reported. */
+        uint64_t suppressed = 0; /**< Rate limited messages not yet reported. */
+        std::chrono::steady_clock::time_point windowStart; /**< Start of the rate limit window. */
+        std::chrono::steady_clock::time_point noticeTime; /**< Time of the last repeat and suppression report. */
+        size_t windowLines = 0; /**< Lines written in the rate limit window. */
+        Stats stats; /**< Counters. */
+        std::thread flusher; /**< Flush thread (started by the first write()). */
+        bool stop = false; /**< Flag to stop the flush thread. */
+
+        std::mutex fileMutex; /**< Guards the file, written outside the buffer mutex. */
+        std::ofstream out; /**< Error log file (opened on the first write). */
+        std::string openPath; /**< Path of the open file. */
+        uint64_t fileBytes = 0; /**< Size of the open file, tracked instead of queried. */
+};
+
+#endif // ERROR_LOG_H
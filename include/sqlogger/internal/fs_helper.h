@@ -22,6 +22,7 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <sqlogger/internal/log_strings.h>
 
@@ -61,6 +62,14 @@ namespace FSHelper
      */
     std::string toFilename(const std::string& path);
 
+    /**
+     * @brief Extracts the filename component from a path without copying
+     * @param path The full filesystem path
+     * @return std::string_view Just the filename portion of the path (refers to path's storage)
+     * @note Both '/' and '\' are treated as separators
+     */
+    std::string_view toFilenameView(std::string_view path);
+
     /**
      * @brief Gets the size of a file in megabytes
      * @param path The filesystem path of the file to check
@@ -84,6 +93,16 @@ namespace FSHelper
      */
     bool rotateLog(const std::string& path);
 
+    /**
+     * @brief Rotates numbered segments of a file: path.(keep - 1) becomes path.keep, ..., path becomes path.1
+     * @param path The filesystem path of the current segment
+     * @param keep Number of rotated segments to keep (the oldest is deleted, 0 deletes path)
+     * @param errMsg[out] Reference to string that will contain error message if operation fails
+     * @return true if path no longer exists
+     * @return false if a segment couldn't be renamed or deleted (check errMsg for details)
+     */
+    bool rotateSegments(const std::string& path, const int keep, std::string& errMsg);
+
 };
 
 #endif // !FS_HELPER_H
@@ -0,0 +1,259 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define HISTOGRAM_SUB_BUCKET_BITS 4 /**< Linear sub-buckets per power of two (2^4 = 16, about 6% relative error). */
+#define HISTOGRAM_MAX_EXPONENT 40 /**< Largest recorded value is 2^40 - 1 µs (about 12 days); larger values are clamped. */
+
+/**
+ * @brief Raises an atomic counter to a value if the value is larger.
+ * @param target Counter.
+ * @param value Candidate value.
+ */
+inline void atomicStoreMax(std::atomic<uint64_t>& target, const uint64_t value)
+{
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while(value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Lowers an atomic counter to a value if the value is smaller.
+ * @param target Counter.
+ * @param value Candidate value.
+ */
+inline void atomicStoreMin(std::atomic<uint64_t>& target, const uint64_t value)
+{
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while(value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @class LatencyHistogram
+ * @brief HDR-style latency histogram with microsecond resolution.
+ * Values are counted in log-linear buckets: exact up to 2^HISTOGRAM_SUB_BUCKET_BITS,
+ * then HISTOGRAM_SUB_BUCKET_BITS bits of precision per power of two. Recording is
+ * a few relaxed atomic increments, so any number of threads can record without a lock.
+ */
+class LatencyHistogram
+{
+    public:
+        static constexpr size_t SUB_BUCKETS = size_t(1) << HISTOGRAM_SUB_BUCKET_BITS; /**< Sub-buckets per power of two. */
+        static constexpr size_t BUCKETS = (HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BUCKET_BITS + 1) * SUB_BUCKETS; /**< Number of buckets. */
+
+        /**
+         * @struct Snapshot
+         * @brief Copy of the histogram counters at one point in time.
+         */
+        struct Snapshot
+        {
+            uint64_t count = 0; /**< Number of recorded values. */
+            uint64_t sumUs = 0; /**< Sum of the recorded values in microseconds. */
+            uint64_t maxUs = 0; /**< Largest recorded value in microseconds. */
+            std::vector<uint64_t> buckets; /**< Bucket counts (empty if nothing was recorded). */
+
+            /**
+             * @brief Gets the mean value.
+             * @return double Mean in microseconds (0 if empty).
+             */
+            double meanUs() const
+            {
+                return count > 0 ? static_cast<double>(sumUs) / count : 0.0;
+            }
+
+            /**
+             * @brief Gets a percentile.
+             * @param percentile Percentile in the range [0, 100] (e.g. 99.9).
+             * @return uint64_t Highest value of the bucket holding the percentile, in microseconds (at most maxUs).
+             */
+            uint64_t percentileUs(const double percentile) const
+            {
+                if(count == 0 || buckets.empty())
+                {
+                    return 0;
+                }
+
+                const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+                const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * count + 0.5));
+                uint64_t seen = 0;
+                for(size_t i = 0; i < buckets.size(); ++i)
+                {
+                    seen += buckets[i];
+                    if(seen >= rank)
+                    {
+                        return std::min(bucketHighest(i), maxUs);
+                    }
+                }
+                return maxUs;
+            }
+
+            /**
+             * @brief Counts the values whose bucket lies entirely at or below a limit.
+             * @param limitUs Limit in microseconds.
+             * @return uint64_t Number of values (cumulative, as in a Prometheus "le" bucket).
+             */
+            uint64_t countAtOrBelow(const uint64_t limitUs) const
+            {
+                uint64_t result = 0;
+                for(size_t i = 0; i < buckets.size() && bucketHighest(i) <= limitUs; ++i)
+                {
+                    result += buckets[i];
+                }
+                return result;
+            }
+
+            /**
+             * @brief Adds the counts of another snapshot.
+             * @param other Snapshot to add.
+             */
+            void merge(const Snapshot& other)
+            {
+                if(other.buckets.empty())
+                {
+                    return;
+                }
+                if(buckets.empty())
+                {
+                    buckets.assign(BUCKETS, 0);
+                }
+                for(size_t i = 0; i < BUCKETS; ++i)
+                {
+                    buckets[i] += other.buckets[i];
+                }
+                count += other.count;
+                sumUs += other.sumUs;
+                maxUs = std::max(maxUs, other.maxUs);
+            }
+        };
+
+        LatencyHistogram() = default;
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        /**
+         * @brief Records a value.
+         * @param valueUs Value in microseconds.
+         * @param times Number of occurrences (e.g. the entries of a batch sharing one measurement).
+         */
+        void record(const uint64_t valueUs, const uint64_t times = 1)
+        {
+            counts[bucketIndex(valueUs)].fetch_add(times, std::memory_order_relaxed);
+            total.fetch_add(times, std::memory_order_relaxed);
+            sum.fetch_add(valueUs * times, std::memory_order_relaxed);
+            atomicStoreMax(maximum, valueUs);
+        }
+
+        /**
+         * @brief Copies the counters.
+         * Concurrent record() calls may be partially included.
+         * @return Snapshot Current counters.
+         */
+        Snapshot snapshot() const
+        {
+            Snapshot result;
+            result.count = total.load(std::memory_order_relaxed);
+            result.sumUs = sum.load(std::memory_order_relaxed);
+            result.maxUs = maximum.load(std::memory_order_relaxed);
+            if(result.count > 0)
+            {
+                result.buckets.resize(BUCKETS);
+                for(size_t i = 0; i < BUCKETS; ++i)
+                {
+                    result.buckets[i] = counts[i].load(std::memory_order_relaxed);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Clears the counters.
+         */
+        void reset()
+        {
+            for(auto & bucket : counts)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            total.store(0, std::memory_order_relaxed);
+            sum.store(0, std::memory_order_relaxed);
+            maximum.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the bucket of a value.
+         * @param valueUs Value in microseconds.
+         * @return size_t Bucket index.
+         */
+        static size_t bucketIndex(uint64_t valueUs)
+        {
+            valueUs = std::min(valueUs, (uint64_t(1) << HISTOGRAM_MAX_EXPONENT) - 1);
+            if(valueUs < SUB_BUCKETS)
+            {
+                return static_cast<size_t>(valueUs);
+            }
+
+            size_t exponent = HISTOGRAM_SUB_BUCKET_BITS;
+            while((valueUs >> (exponent + 1)) != 0)
+            {
+                ++exponent;
+            }
+            const size_t shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+            return (exponent - HISTOGRAM_SUB_BUCKET_BITS + 1) * SUB_BUCKETS
+                   + static_cast<size_t>((valueUs >> shift) - SUB_BUCKETS);
+        }
+
+        /**
+         * @brief Gets the highest value counted in a bucket.
+         * @param index Bucket index.
+         * @return uint64_t Value in microseconds.
+         */
+        static uint64_t bucketHighest(const size_t index)
+        {
+            if(index < SUB_BUCKETS)
+            {
+                return index;
+            }
+
+            const size_t shift = index / SUB_BUCKETS - 1;
+            const uint64_t lowest = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+            return lowest + (uint64_t(1) << shift) - 1;
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKETS> counts{}; /**< Bucket counts. */
+        std::atomic<uint64_t> total{ 0 }; /**< Number of recorded values. */
+        std::atomic<uint64_t> sum{ 0 }; /**< Sum of the recorded values. */
+        std::atomic<uint64_t> maximum{ 0 }; /**< Largest recorded value. */
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,234 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_ARGS_H
+#define LOG_ARGS_H
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Call-site location for default arguments (GCC, Clang and MSVC 19.26+)
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+    #define SQLG_CALLER_FUNCTION __builtin_FUNCTION()
+    #define SQLG_CALLER_FILE __builtin_FILE()
+    #define SQLG_CALLER_LINE __builtin_LINE()
+#else
+    #define SQLG_CALLER_FUNCTION ""
+    #define SQLG_CALLER_FILE ""
+    #define SQLG_CALLER_LINE 0
+#endif
+
+/**
+ * @struct LogFormatString
+ * @brief Format string of SQLogger::info() and friends, carrying the caller's source location.
+ * The location is captured by default arguments, so the variadic API needs no macro.
+ */
+struct LogFormatString
+{
+    /**
+     * @brief Constructs a format string with the caller's location.
+     * @tparam S Any type convertible to std::string_view.
+     * @param format The format string ("{}" placeholders, "{{" and "}}" escapes).
+     * @param function The calling function (defaults to the call site).
+     * @param file The calling file (defaults to the call site).
+     * @param line The calling line (defaults to the call site).
+     */
+    template<typename S, typename = std::enable_if_t<std::is_convertible_v<const S&, std::string_view>>>
+    LogFormatString(const S& format,
+                    const char* function = SQLG_CALLER_FUNCTION,
+                    const char* file = SQLG_CALLER_FILE,
+                    const int line = SQLG_CALLER_LINE)
+        : format(format), function(function), file(file), line(line)
+    {
+    }
+
+    std::string_view format; /**< The format string. */
+    const char* function; /**< The calling function. */
+    const char* file; /**< The calling file. */
+    int line; /**< The calling line. */
+};
+
+/**
+ * @class LogArgs
+ * @brief Compact binary pack of format arguments.
+ * Arithmetic values are stored raw and strings by length and bytes, so the
+ * caller only copies bytes; the text is produced later by format(), usually
+ * on the writer thread. Values of other types are converted with operator<< when packed.
+ */
+class LogArgs
+{
+    public:
+        /**
+         * @enum Type
+         * @brief Type tag stored before each argument.
+         */
+        enum class Type : uint8_t
+        {
+            Bool,    /**< bool, printed as true/false. */
+            Char,    /**< Single character. */
+            Int64,   /**< Signed integer. */
+            UInt64,  /**< Unsigned integer. */
+            Double,  /**< Floating point. */
+            Pointer, /**< Pointer address. */
+            String   /**< Text. */
+        };
+
+        LogArgs() = default;
+
+        /**
+         * @brief Packs the arguments.
+         * @tparam Args Argument types.
+         * @param args Arguments to pack.
+         * @return LogArgs Active pack (format() applies to its format string even with no arguments).
+         */
+        template<typename... Args>
+        static LogArgs pack(const Args& ... args)
+        {
+            LogArgs result;
+            result.active = true;
+            (result.add(args), ...);
+            return result;
+        }
+
+        /**
+         * @brief Checks if the pack was created by pack() (the message is a format string).
+         * @return bool True if the message must be formatted.
+         */
+        bool isActive() const
+        {
+            return active;
+        }
+
+        /**
+         * @brief Gets the packed size.
+         * @return size_t Size in bytes.
+         */
+        size_t size() const
+        {
+            return data.size();
+        }
+
+        /**
+         * @brief Gets the packed bytes (e.g. to compare two packs).
+         * @return std::string_view Packed arguments.
+         */
+        std::string_view bytes() const
+        {
+            return data;
+        }
+
+        /**
+         * @brief Formats the packed arguments into a format string.
+         * "{}" (with or without a format spec, which is ignored) takes the next argument,
+         * "{{" and "}}" produce literal braces. Placeholders without an argument are kept as is.
+         * @param format The format string.
+         * @return std::string Formatted text.
+         */
+        std::string format(std::string_view format) const;
+
+    private:
+        /**
+         * @brief Appends a raw value with its type tag.
+         * @param type Type tag.
+         * @param value Pointer to the value bytes.
+         * @param size Value size.
+         */
+        void addRaw(const Type type, const void* value, const size_t size)
+        {
+            data.push_back(static_cast<char>(type));
+            data.append(static_cast<const char*>(value), size);
+        }
+
+        /**
+         * @brief Appends a text argument.
+         * @param text Text value.
+         */
+        void addText(const std::string_view text)
+        {
+            const uint32_t length = static_cast<uint32_t>(text.size());
+            addRaw(Type::String, & length, sizeof(length));
+            data.append(text.data(), length);
+        }
+
+        /**
+         * @brief Appends an argument of any supported type.
+         * @tparam T Argument type.
+         * @param value Argument value.
+         */
+        template<typename T>
+        void add(const T& value)
+        {
+            using Value = std::decay_t<T>;
+            if constexpr(std::is_same_v<Value, bool>)
+            {
+                addRaw(Type::Bool, & value, sizeof(value));
+            }
+            else if constexpr(std::is_same_v<Value, char>)
+            {
+                addRaw(Type::Char, & value, sizeof(value));
+            }
+            else if constexpr(std::is_enum_v<Value>)
+            {
+                add(static_cast<std::underlying_type_t<Value>>(value));
+            }
+            else if constexpr(std::is_integral_v<Value> && std::is_signed_v<Value>)
+            {
+                const int64_t raw = value;
+                addRaw(Type::Int64, & raw, sizeof(raw));
+            }
+            else if constexpr(std::is_integral_v<Value>)
+            {
+                const uint64_t raw = value;
+                addRaw(Type::UInt64, & raw, sizeof(raw));
+            }
+            else if constexpr(std::is_floating_point_v<Value>)
+            {
+                const double raw = static_cast<double>(value);
+                addRaw(Type::Double, & raw, sizeof(raw));
+            }
+            else if constexpr(std::is_same_v<Value, const char*> || std::is_same_v<Value, char*>)
+            {
+                addText(value ? std::string_view(value) : std::string_view("(null)"));
+            }
+            else if constexpr(std::is_convertible_v<const T&, std::string_view>)
+            {
+                addText(std::string_view(value));
+            }
+            else if constexpr(std::is_pointer_v<Value>)
+            {
+                const void* raw = value;
+                addRaw(Type::Pointer, & raw, sizeof(raw));
+            }
+            else
+            {
+                std::ostringstream stream;
+                stream << value;
+                addText(stream.str());
+            }
+        }
+
+        std::string data; /**< Packed arguments (type tag followed by the value). */
+        bool active = false; /**< Set by pack(). */
+};
+
+#endif // LOG_ARGS_H
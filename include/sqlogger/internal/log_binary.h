@@ -0,0 +1,176 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_BINARY_H
+#define LOG_BINARY_H
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sqlogger/log_entry.h"
+
+#define LOG_BINARY_MAGIC "SQLB" /**< First bytes of every block. */
+#define LOG_BINARY_MAGIC_SIZE 4
+#define LOG_BINARY_VERSION 1 /**< Current block version. */
+#define LOG_BINARY_FLAG_SOURCE 0x01 /**< Entries carry source info. */
+
+namespace LogSerializer
+{
+    /**
+    * @namespace Binary
+    * @brief Compact, versioned binary encoding of log entries.
+    *
+    * Entries are encoded in self-contained blocks:
+    * `"SQLB" | version (u8) | flags (u8) | count | dictionary | entries`.
+    * Integers are LEB128 varints (signed values zigzag-encoded). IDs and timestampUs
+    * are deltas to the previous entry, the timestamp text is front-coded against the
+    * previous one, and level, function, file, thread ID and source fields are indexes
+    * into the block's string dictionary. Blocks can be concatenated freely.
+    */
+    namespace Binary
+    {
+        /**
+        * @struct LogEntryView
+        * @brief Decoded entry referencing the encoded buffer instead of copying strings.
+        * Views stay valid while the buffer lives; timestamp points into the Reader and
+        * is valid until the next call to Reader::next().
+        */
+        struct LogEntryView
+        {
+            int id = 0; /**< The unique identifier of the log entry. */
+            int64_t timestampUs = 0; /**< Capture time in microseconds since the epoch (0 if unknown). */
+            std::string_view timestamp; /**< The timestamp text. */
+            std::string_view level; /**< The severity level. */
+            std::string_view message; /**< The message. */
+            std::string_view function; /**< The function where the entry was created. */
+            std::string_view file; /**< The file where the entry was created. */
+            int line = 0; /**< The line number. */
+            std::string_view threadId; /**< The ID of the thread that created the entry. */
+            int sourceId = 0; /**< The SourceID (0 if the block has no source info). */
+            std::string_view sourceUuid; /**< The source UUID. */
+            std::string_view sourceName; /**< The source name. */
+
+            /**
+            * @brief Copies the view into a LogEntry.
+            * @return LogEntry Owning entry.
+            */
+            LogEntry toEntry() const;
+        };
+
+        /**
+        * @class Reader
+        * @brief Sequential zero-copy decoder over one or more concatenated blocks.
+        */
+        class Reader
+        {
+            public:
+                /**
+                * @brief Constructs a reader.
+                * @param data Encoded blocks (must outlive the reader and the views).
+                */
+                explicit Reader(std::string_view data) : data(data) {};
+
+                /**
+                * @brief Decodes the next entry.
+                * @param view Receives the entry.
+                * @return bool True if an entry was decoded, false at the end of the data.
+                * @throws std::runtime_error If the data is corrupt or of an unsupported version.
+                */
+                bool next(LogEntryView& view);
+
+            private:
+                /**
+                * @brief Reads a block header and its dictionary.
+                */
+                void readHeader();
+
+                /**
+                * @brief Reads a varint.
+                * @return uint64_t Value.
+                */
+                uint64_t readVarint();
+
+                /**
+                * @brief Reads a length-prefixed string.
+                * @return std::string_view View into the data.
+                */
+                std::string_view readBytes();
+
+                /**
+                * @brief Reads a dictionary index.
+                * @return std::string_view Dictionary string.
+                */
+                std::string_view readRef();
+
+                std::string_view data; /**< Encoded data. */
+                size_t pos = 0; /**< Read position. */
+                uint64_t remaining = 0; /**< Entries left in the current block. */
+                uint8_t flags = 0; /**< Flags of the current block. */
+                std::vector<std::string_view> dictionary; /**< Dictionary of the current block. */
+                std::string timestamp; /**< Current timestamp text (front-coded). */
+                int64_t lastId = 0; /**< Previous ID. */
+                int64_t lastTimestampUs = 0; /**< Previous timestampUs. */
+        };
+
+        /**
+        * @brief Appends one block with the given entries.
+        * @param out Buffer to append to.
+        * @param entries Entries to encode.
+        * @param count Number of entries.
+        */
+        void appendLogs(std::string& out, const LogEntry* entries, const size_t count);
+
+        /**
+        * @brief Encodes entries into one block.
+        * @param entries Entries to encode.
+        * @return std::string Encoded block.
+        */
+        std::string serializeLogs(const LogEntryList& entries);
+
+        /**
+        * @brief Visits every entry of the encoded blocks without copying strings.
+        * @param data Encoded blocks.
+        * @param callback Called for each entry; return false to stop.
+        * @return size_t Number of entries passed to the callback.
+        * @throws std::runtime_error If the data is corrupt.
+        */
+        size_t parseLogs(std::string_view data, const std::function<bool(const LogEntryView&)> & callback);
+
+        /**
+        * @brief Decodes the encoded blocks into entries.
+        * @param data Encoded blocks.
+        * @return LogEntryList Entries.
+        * @throws std::runtime_error If the data is corrupt.
+        */
+        LogEntryList parseLogs(std::string_view data);
+
+        /**
+        * @brief Checks if data starts with a binary block.
+        * @param data Data to check.
+        * @return bool True if the magic matches.
+        */
+        bool isBinary(std::string_view data);
+    };
+};
+
+#endif // LOG_BINARY_H
@@ -0,0 +1,112 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_CIPHER_H
+#define LOG_CIPHER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "sqlogger/log_entry.h"
+
+#define LOG_CIPHER_PREFIX "aesgcm:" /**< Marks an encrypted message column value. */
+#define LOG_CIPHER_KEY_SIZE 32 /**< AES-256 key size. */
+#define LOG_CIPHER_IV_SIZE 12 /**< GCM nonce size. */
+#define LOG_CIPHER_TAG_SIZE 16 /**< GCM authentication tag size. */
+#define LOG_CIPHER_KEY_CONTEXT "sqlogger-message-key:" /**< Separates the message key from other uses of the pass key. */
+
+/**
+ * @class LogCipher
+ * @brief AES-256-GCM encryption of the message column.
+ * Every thread keeps its own cipher contexts with the key already set, so a message
+ * only costs a nonce reset and one pass of the (AES-NI accelerated) cipher, and
+ * writer threads encrypt their batches in parallel.
+ * Stored value: LOG_CIPHER_PREFIX + base64(nonce | ciphertext | tag).
+ * Requires SQLG_USE_AES.
+ */
+class LogCipher
+{
+    public:
+        /**
+         * @brief Constructs a cipher.
+         * @param passKey Secret the 256-bit key is derived from (SHA-256).
+         * @throws std::runtime_error If passKey is empty or AES support is not compiled in.
+         */
+        explicit LogCipher(const std::string& passKey);
+
+        LogCipher(const LogCipher&) = delete;
+        LogCipher& operator=(const LogCipher&) = delete;
+
+        /**
+         * @brief Checks if the library was built with AES support (SQLG_USE_AES).
+         * @return bool True if LogCipher can be constructed.
+         */
+        static bool isSupported();
+
+        /**
+         * @brief Checks if a stored value was produced by encrypt().
+         * @param value Stored message.
+         * @return bool True if the value has the cipher prefix.
+         */
+        static bool isEncrypted(const std::string_view value)
+        {
+            return value.substr(0, sizeof(LOG_CIPHER_PREFIX) - 1) == LOG_CIPHER_PREFIX;
+        }
+
+        /**
+         * @brief Encrypts a message with a fresh nonce.
+         * @param plaintext Message text.
+         * @return std::string Prefixed, base64 encoded nonce, ciphertext and tag.
+         * @throws std::runtime_error If the cipher fails.
+         */
+        std::string encrypt(const std::string_view plaintext);
+
+        /**
+         * @brief Decrypts a value produced by encrypt().
+         * Values without the cipher prefix (written before encryption was enabled) are returned as is.
+         * @param value Stored message.
+         * @return std::optional<std::string> Message, or std::nullopt if the value is damaged or the key is wrong.
+         */
+        std::optional<std::string> decrypt(const std::string& value) const;
+
+        /**
+         * @brief Encrypts the messages of a batch.
+         * @param entries Entries to write.
+         * @return LogEntryList Copy of the entries with encrypted messages.
+         * @throws std::runtime_error If the cipher fails.
+         */
+        LogEntryList encryptMessages(const LogEntryList& entries);
+
+    private:
+        /**
+         * @brief Gets the next nonce (random base XOR a counter, never repeated by this instance).
+         * @param nonce Output buffer of LOG_CIPHER_IV_SIZE bytes.
+         */
+        void nextNonce(unsigned char* nonce);
+
+        std::array<unsigned char, LOG_CIPHER_KEY_SIZE> key{}; /**< Derived AES-256 key. */
+        std::array<unsigned char, LOG_CIPHER_IV_SIZE> nonceBase{}; /**< Random per instance. */
+        std::atomic<uint64_t> nonceCounter{ 0 }; /**< Messages encrypted by this instance. */
+        uint64_t instanceId = 0; /**< Tells thread contexts of different instances apart. */
+};
+
+#endif // LOG_CIPHER_H
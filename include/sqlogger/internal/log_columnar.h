@@ -0,0 +1,90 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_COLUMNAR_H
+#define LOG_COLUMNAR_H
+
+#include <memory>
+#include <string>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/internal/log_compress.h"
+#include "sqlogger/internal/log_export.h"
+
+#define LOG_COLUMNAR_ROW_GROUP_SIZE (1 << 20) /**< Rows per Parquet row group (batches are buffered up to it). */
+
+/**
+ * @class LogColumnarWriter
+ * @brief Parquet / Arrow IPC file writer behind LogExport::Writer (requires SQLG_USE_ARROW).
+ * Every chunk of entries becomes one Arrow record batch. Level, function, file and
+ * thread ID (and the source UUID and name) are dictionary encoded with dictionaries
+ * kept for the whole file; new values are only appended, so the Arrow IPC file stores
+ * them as dictionary deltas. Parquet batches are buffered into row groups of
+ * LOG_COLUMNAR_ROW_GROUP_SIZE rows.
+ */
+class LogColumnarWriter
+{
+    public:
+        /**
+         * @brief Creates the output file and writes the schema.
+         * @param filePath The path to the output file (its directory must exist).
+         * @param format LogExport::Format::PARQUET or LogExport::Format::ARROW.
+         * @param compression Codec of the Parquet pages / Arrow IPC buffers.
+         * @param useThreads Encode and compress columns on Arrow's thread pool.
+         * @throws std::runtime_error If the format or codec is not supported or the file cannot be created.
+         */
+        LogColumnarWriter(const std::string& filePath,
+                          const LogExport::Format& format,
+                          const LogCompress::Compression& compression,
+                          const bool useThreads);
+
+        /**
+         * @brief Closes the file, discarding errors (call close() to see them).
+         */
+        ~LogColumnarWriter();
+
+        LogColumnarWriter(const LogColumnarWriter&) = delete;
+        LogColumnarWriter& operator=(const LogColumnarWriter&) = delete;
+
+        /**
+         * @brief Checks if a columnar format and codec were compiled in.
+         * @param format Output format.
+         * @param compression Codec (Arrow IPC supports None and Zstd).
+         * @return bool True if the writer can be constructed with them.
+         */
+        static bool isSupported(const LogExport::Format& format, const LogCompress::Compression& compression);
+
+        /**
+         * @brief Writes entries as one record batch.
+         * @param entries The log entries.
+         * @throws std::runtime_error If the batch could not be written.
+         */
+        void write(const LogEntryList& entries);
+
+        /**
+         * @brief Writes the file footer and closes the file.
+         * @throws std::runtime_error If writing failed.
+         */
+        void close();
+
+    private:
+        struct State;
+        std::unique_ptr<State> state; /**< Arrow objects (not exposed, Arrow is a private dependency). */
+};
+
+#endif // LOG_COLUMNAR_H
@@ -0,0 +1,87 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_COMPRESS_H
+#define LOG_COMPRESS_H
+
+#include <string>
+#include <stdexcept>
+#include "sqlogger/internal/log_strings.h"
+
+#define LOG_COMPRESS_GZIP_LEVEL 6 /**< Default gzip level (1 fastest .. 9 smallest). */
+#define LOG_COMPRESS_ZSTD_LEVEL 3 /**< Default zstd level (1 fastest .. 19 smallest). */
+#define LOG_COMPRESS_EXT_GZIP ".gz"
+#define LOG_COMPRESS_EXT_ZSTD ".zst"
+
+/**
+ * @namespace LogCompress
+ * @brief Whole-buffer gzip and zstd compression used by the exporters.
+ * compress() produces one complete gzip member or zstd frame, so independently
+ * compressed chunks can simply be concatenated into a valid stream.
+ * Codecs are available when the library is built with SQLG_USE_ZLIB / SQLG_USE_ZSTD.
+ */
+namespace LogCompress
+{
+    /**
+    * @enum Compression
+    * @brief Compression codec.
+    */
+    enum class Compression
+    {
+        None, /**< Plain output. */
+        Gzip, /**< gzip (RFC 1952), requires SQLG_USE_ZLIB. */
+        Zstd  /**< Zstandard, requires SQLG_USE_ZSTD. */
+    };
+
+    /**
+    * @brief Checks if a codec was compiled in.
+    * @param compression Codec.
+    * @return bool True if compress() and decompress() support the codec.
+    */
+    bool isSupported(const Compression& compression);
+
+    /**
+    * @brief Gets the file extension of a codec.
+    * @param compression Codec.
+    * @return std::string Extension with the leading dot, empty for Compression::None.
+    */
+    std::string extension(const Compression& compression);
+
+    /**
+    * @brief Compresses data into one gzip member or zstd frame.
+    * @param data Data to compress.
+    * @param compression Codec (Compression::None returns the data unchanged).
+    * @param level Compression level, 0 for the codec default.
+    * @return std::string Compressed data.
+    * @throws std::runtime_error If the codec is not supported or compression failed.
+    */
+    std::string compress(const std::string& data, const Compression& compression, const int level = 0);
+
+    /**
+    * @brief Decompresses data made of one or more concatenated gzip members or zstd frames.
+    * @param data Compressed data.
+    * @param compression Codec (Compression::None returns the data unchanged).
+    * @return std::string Decompressed data.
+    * @throws std::runtime_error If the codec is not supported or the data is corrupt.
+    */
+    std::string decompress(const std::string& data, const Compression& compression);
+}
+
+#endif // LOG_COMPRESS_H
@@ -0,0 +1,193 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_DICTIONARY_H
+#define LOG_DICTIONARY_H
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/database/database_interface.h"
+
+#define FIELD_DICT_ID "id"
+#define FIELD_DICT_VALUE "value"
+#define DICT_TABLE_SEPARATOR "_" /**< Dictionary table name: <logs table>_<column>. */
+
+/**
+ * @class LogDictionary
+ * @brief In-process cache of one dictionary table (value <-> id) of the compact schema.
+ * The cache is shared by every writer and reader of a logger and is safe to use from
+ * several threads; the connection is passed per call, so pooled connections can use it.
+ */
+class LogDictionary
+{
+    public:
+        /**
+         * @brief Constructs a dictionary.
+         * @param tableName Dictionary table name.
+         */
+        explicit LogDictionary(const std::string& tableName) : tableName(tableName) {};
+
+        LogDictionary(const LogDictionary&) = delete;
+        LogDictionary& operator=(const LogDictionary&) = delete;
+
+        /**
+         * @brief Creates the dictionary table if it does not exist.
+         * @param database Connection to use.
+         */
+        void createTable(IDatabase& database);
+
+        /**
+         * @brief Gets the id of a value, adding the value to the table if it is new.
+         * Only the first use of a value queries the database.
+         * @param database Connection to use.
+         * @param value Value to encode.
+         * @return std::optional<int64_t> Id, or std::nullopt if the value could not be stored.
+         */
+        std::optional<int64_t> getId(IDatabase& database, const std::string& value);
+
+        /**
+         * @brief Gets the id of a value without adding it.
+         * @param database Connection to use (queried on a cache miss).
+         * @param value Value to look up.
+         * @return std::optional<int64_t> Id, or std::nullopt if the value is not in the table.
+         */
+        std::optional<int64_t> findId(IDatabase& database, const std::string& value);
+
+        /**
+         * @brief Gets a cached value.
+         * @param id Value id.
+         * @return std::string Value, or an empty string if the id is not loaded.
+         */
+        std::string getValue(const int64_t id) const;
+
+        /**
+         * @brief Loads the rows added to the table since the last load.
+         * @param database Connection to use.
+         */
+        void load(IDatabase& database);
+
+        /**
+         * @brief Drops all cached values (e.g. after a rolled back transaction).
+         */
+        void clear();
+
+        /**
+         * @brief Gets the dictionary table name.
+         * @return const std::string& Table name.
+         */
+        const std::string& getTableName() const
+        {
+            return tableName;
+        }
+
+    private:
+        /**
+         * @brief Selects the id of a value from the table.
+         * @param database Connection to use.
+         * @param value Value to look up.
+         * @return std::optional<int64_t> Id, or std::nullopt if not found.
+         */
+        std::optional<int64_t> selectId(IDatabase& database, const std::string& value) const;
+
+        /**
+         * @brief Stores a value <-> id pair in the cache.
+         * @param id Value id.
+         * @param value Value.
+         */
+        void cache(const int64_t id, const std::string& value);
+
+        std::string tableName; /**< Dictionary table name. */
+        mutable std::mutex mutex; /**< Guards ids, values and loadedId. */
+        std::unordered_map<std::string, int64_t> ids; /**< Value -> id. */
+        std::unordered_map<int64_t, std::string> values; /**< Id -> value. */
+        int64_t loadedId = 0; /**< Rows up to this id have been loaded. */
+};
+
+/**
+ * @struct LogDictionaries
+ * @brief Dictionaries of the compact schema columns (function, file and thread ID).
+ */
+struct LogDictionaries
+{
+    /**
+     * @brief Constructs the dictionaries of a log table.
+     * @param logsTableName Log table name.
+     */
+    explicit LogDictionaries(const std::string& logsTableName)
+        : function(logsTableName + DICT_TABLE_SEPARATOR + FIELD_LOG_FUNCTION),
+          file(logsTableName + DICT_TABLE_SEPARATOR + FIELD_LOG_FILE),
+          threadId(logsTableName + DICT_TABLE_SEPARATOR + FIELD_LOG_THREAD_ID)
+    {
+    }
+
+    /**
+     * @brief Gets the dictionary of a log table column.
+     * @param field Column name.
+     * @return LogDictionary* Dictionary, or nullptr if the column is not dictionary-encoded.
+     */
+    LogDictionary* forField(const std::string& field)
+    {
+        if(field == FIELD_LOG_FUNCTION) return & function;
+        if(field == FIELD_LOG_FILE) return & file;
+        if(field == FIELD_LOG_THREAD_ID) return & threadId;
+        return nullptr;
+    }
+
+    /**
+     * @brief Creates the dictionary tables if they do not exist.
+     * @param database Connection to use.
+     */
+    void createTables(IDatabase& database)
+    {
+        function.createTable(database);
+        file.createTable(database);
+        threadId.createTable(database);
+    }
+
+    /**
+     * @brief Loads the rows added to the dictionary tables since the last load.
+     * @param database Connection to use.
+     */
+    void load(IDatabase& database)
+    {
+        function.load(database);
+        file.load(database);
+        threadId.load(database);
+    }
+
+    /**
+     * @brief Drops all cached values.
+     */
+    void clear()
+    {
+        function.clear();
+        file.clear();
+        threadId.clear();
+    }
+
+    LogDictionary function; /**< Function names. */
+    LogDictionary file; /**< File names. */
+    LogDictionary threadId; /**< Thread IDs. */
+};
+
+#endif // LOG_DICTIONARY_H
@@ -20,12 +20,38 @@
 #ifndef LOG_EXPORT_H
 #define LOG_EXPORT_H
 
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 #include "sqlogger/log_entry.h"
 #include "sqlogger/internal/fs_helper.h"
+#include "sqlogger/internal/log_binary.h"
+#include "sqlogger/internal/log_compress.h"
 #include "sqlogger/internal/log_serializer.h"
+#include "sqlogger/internal/thread_pool.h"
+
+#define LOG_EXPORT_BUFFER_SIZE (1 << 20) /**< File write buffer size in bytes. */
+#define LOG_EXPORT_CHUNK_SIZE 4096 /**< Entries formatted per chunk. */
+#define LOG_EXPORT_DEFAULT_THREADS 4 /**< Default number of formatting threads of SQLogger::exportLogs(). */
+#define LOG_EXPORT_PAGE_SIZE 10000 /**< Rows read per keyset page by SQLogger::exportLogs(). */
+
+#define LOG_EXPORT_FORMAT_STR_TXT "TXT"
+#define LOG_EXPORT_FORMAT_STR_CSV "CSV"
+#define LOG_EXPORT_FORMAT_STR_XML "XML"
+#define LOG_EXPORT_FORMAT_STR_JSON "JSON"
+#define LOG_EXPORT_FORMAT_STR_YAML "YAML"
+#define LOG_EXPORT_FORMAT_STR_NDJSON "NDJSON"
+#define LOG_EXPORT_FORMAT_STR_BINARY "BINARY"
+#define LOG_EXPORT_FORMAT_STR_PARQUET "PARQUET"
+#define LOG_EXPORT_FORMAT_STR_ARROW "ARROW"
+
+class LogColumnarWriter;
 
 /**
  * @namespace LogExport
@@ -57,6 +83,10 @@ namespace LogExport
     * @value XML eXtensible Markup Language - Structured, self-describing
     * @value JSON JavaScript Object Notation - Web/API friendly
     * @value YAML YAML Ain't Markup Language - Human-readable configuration
+    * @value NDJSON Newline-delimited JSON (JSON Lines) - One object per line, streamable
+    * @value BINARY LogSerializer::Binary blocks - Compact, read back with LogSerializer::Binary::parseLogs()
+    * @value PARQUET Apache Parquet - Columnar, dictionary encoded, requires SQLG_USE_ARROW
+    * @value ARROW Arrow IPC file (Feather V2) - Columnar, dictionary encoded, requires SQLG_USE_ARROW
     *
     * @note Default format is TXT when not explicitly specified
     * @see exportTo() for the main export function using this enum
@@ -68,9 +98,200 @@ namespace LogExport
         CSV,
         XML,
         JSON,
-        YAML
+        YAML,
+        NDJSON,
+        BINARY,
+        PARQUET,
+        ARROW
     };
 
+    /**
+    * @class Writer
+    * @brief Streaming export writer.
+    * Entries are collected into chunks of LOG_EXPORT_CHUNK_SIZE, formatted (in parallel
+    * when threads > 1) and written in order through a LOG_EXPORT_BUFFER_SIZE buffer,
+    * without per-line flushes. Memory use is bounded by the chunks in flight, so the
+    * writer can be fed straight from a database cursor.
+    * With compression, every chunk is compressed by the thread that formatted it into
+    * its own gzip member / zstd frame; the concatenation is a regular .gz / .zst file.
+    * Columnar formats (see isColumnar()) go through LogColumnarWriter instead: every
+    * chunk becomes one record batch, and the compression selects the codec of the
+    * Parquet pages / Arrow IPC buffers.
+    */
+    class Writer
+    {
+        public:
+            /**
+            * @brief Creates the output file (and its directory) and writes the format header.
+            * @param filePath The path to the output file.
+            * @param format Format of the output file.
+            * @param delimiter The delimiter to use between fields (TXT, CSV).
+            * @param name Whether to include field names in the output (TXT).
+            * @param threads Number of formatting threads (0 or 1 formats on the calling thread;
+            * columnar formats encode columns on Arrow's thread pool when threads > 1).
+            * @param compression Output compression.
+            * @throws std::runtime_error If the file or its directory cannot be created, or the format or compression is not supported.
+            */
+            Writer(const std::string& filePath,
+                   const Format& format,
+                   const std::string& delimiter = ENTRY_DELIMITER,
+                   bool name = true,
+                   const size_t threads = 0,
+                   const LogCompress::Compression& compression = LogCompress::Compression::None);
+
+            /**
+            * @brief Closes the writer, discarding errors (call close() to see them).
+            */
+            ~Writer();
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            /**
+            * @brief Adds an entry to the export.
+            * @param entry The log entry.
+            * @throws std::runtime_error If writing a completed chunk failed.
+            */
+            void write(const LogEntry& entry);
+
+            /**
+            * @brief Formats and writes the remaining entries and the format footer, then closes the file.
+            * @throws std::runtime_error If writing failed.
+            */
+            void close();
+
+            /**
+            * @brief Gets the number of entries added so far.
+            * @return size_t Entry count.
+            */
+            size_t count() const
+            {
+                return entries;
+            }
+
+        private:
+            /**
+            * @brief Hands the current chunk to a formatting thread (or formats it in place).
+            */
+            void submitChunk();
+
+            /**
+            * @brief Writes formatted chunks in order until at most maxPending are in flight.
+            * @param maxPending Number of chunks allowed to stay in flight.
+            */
+            void writePending(const size_t maxPending);
+
+            /**
+            * @brief Compresses formatted text (runs on the formatting thread).
+            * @param text Formatted text.
+            * @return std::string Bytes to write (text itself without compression).
+            */
+            std::string encode(std::string text) const;
+
+            /**
+            * @brief Writes encoded bytes to the file.
+            * @param data Encoded bytes.
+            * @throws std::runtime_error If the write failed.
+            */
+            void writeText(const std::string& data);
+
+            std::string filePath; /**< Output file path. */
+            Format format; /**< Output format. */
+            std::string delimiter; /**< Field delimiter. */
+            bool name; /**< Include field names (TXT). */
+            LogCompress::Compression compression; /**< Output compression. */
+
+            std::vector<char> buffer; /**< File write buffer. */
+            std::ofstream file; /**< Output file. */
+            std::unique_ptr<ThreadPool> pool; /**< Formatting threads (nullptr = calling thread). */
+            std::unique_ptr<LogColumnarWriter> columnar; /**< Writer of a columnar format (nullptr = text formats). */
+            size_t maxInFlight; /**< Chunks formatted ahead of the writer. */
+            std::deque<std::future<std::string>> pending; /**< Chunks being formatted, in output order. */
+            LogEntryList chunk; /**< Entries of the chunk being filled. */
+            size_t entries = 0; /**< Entries added so far. */
+            bool written = false; /**< Set once bytes were written. */
+            bool closed = false; /**< Set by close(). */
+    };
+
+    /**
+    * @brief Converts Format to its string representation
+    * @param format Output format
+    * @return std::string Format name (LOG_EXPORT_FORMAT_STR_*)
+    */
+    std::string formatToString(const Format& format);
+
+    /**
+    * @brief Converts string to Format
+    * @param format Format name (case insensitive)
+    * @return std::optional<Format> Format, or std::nullopt if unknown
+    */
+    std::optional<Format> stringToFormat(const std::string& format);
+
+    /**
+    * @brief Checks if a format stores columns instead of formatted rows.
+    * Columnar formats are written by Writer only; they have no header, footer or entry text.
+    * @param format Output format.
+    * @return bool True for PARQUET and ARROW.
+    */
+    bool isColumnar(const Format& format);
+
+    /**
+    * @brief Checks if a format was compiled in.
+    * @param format Output format.
+    * @return bool False for columnar formats without SQLG_USE_ARROW.
+    */
+    bool isSupported(const Format& format);
+
+    /**
+    * @brief Gets the text written before the first entry.
+    * @param format Output format.
+    * @param delimiter The delimiter to use between fields.
+    * @return std::string Header text (may be empty).
+    */
+    std::string formatHeader(const Format& format, const std::string& delimiter = ENTRY_DELIMITER);
+
+    /**
+    * @brief Gets the text written after the last entry.
+    * @param format Output format.
+    * @param empty Whether no entry was written.
+    * @return std::string Footer text (may be empty).
+    */
+    std::string formatFooter(const Format& format, const bool empty);
+
+    /**
+    * @brief Appends the text of one entry.
+    * @param out Text to append to.
+    * @param format Output format.
+    * @param entry The log entry.
+    * @param first Whether this is the first entry of the output (JSON separators).
+    * @param delimiter The delimiter to use between fields.
+    * @param name Whether to include field names in the output.
+    */
+    void formatEntry(std::string& out,
+                     const Format& format,
+                     const LogEntry& entry,
+                     const bool first,
+                     const std::string& delimiter = ENTRY_DELIMITER,
+                     bool name = true);
+
+    /**
+    * @brief Appends the text of consecutive entries (one binary block for Format::BINARY).
+    * @param out Text to append to.
+    * @param format Output format.
+    * @param entries The log entries.
+    * @param count Number of entries.
+    * @param first Whether the first entry is the first of the output (JSON separators).
+    * @param delimiter The delimiter to use between fields.
+    * @param name Whether to include field names in the output.
+    */
+    void formatEntries(std::string& out,
+                       const Format& format,
+                       const LogEntry* entries,
+                       const size_t count,
+                       const bool first,
+                       const std::string& delimiter = ENTRY_DELIMITER,
+                       bool name = true);
+
     /**
     * @brief Exports log entries to a specified format file.
     * @param filePath The path to the output file.
@@ -78,8 +299,14 @@ namespace LogExport
     * @param entryList The list of log entries to export.
     * @param delimiter The delimiter to use between fields.
     * @param name Whether to include field names in the output.
+    * @param compression Output compression.
     */
-    void exportTo(const std::string& filePath, const Format& format, const LogEntryList& entryList, const std::string& delimiter = ENTRY_DELIMITER, bool name = true);
+    void exportTo(const std::string& filePath,
+                  const Format& format,
+                  const LogEntryList& entryList,
+                  const std::string& delimiter = ENTRY_DELIMITER,
+                  bool name = true,
+                  const LogCompress::Compression& compression = LogCompress::Compression::None);
 
     /**
     * @brief Exports log entries to a text file.
@@ -119,6 +346,13 @@ namespace LogExport
     */
     void exportToYAML(const std::string& filePath, const LogEntryList& entryList);
 
+    /**
+    * @brief Exports log entries to an NDJSON (JSON Lines) file.
+    * @param filePath The path to the output file.
+    * @param entryList The list of log entries to export.
+    */
+    void exportToNDJSON(const std::string& filePath, const LogEntryList& entryList);
+
     /**
     * @brief Escapes special characters in a YAML string.
     * @param str The string to escape.
@@ -0,0 +1,176 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_MESSAGE_COMPRESSOR_H
+#define LOG_MESSAGE_COMPRESSOR_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/database/database_interface.h"
+
+#define LOG_ZSTD_PREFIX "zstd:" /**< Marks a compressed message column value. */
+#define LOG_ZSTD_ID_SEPARATOR ':' /**< Ends the dictionary id after the prefix. */
+#define LOG_ZSTD_TABLE_SUFFIX "_zdict" /**< Dictionary table name: <logs table>_zdict. */
+#define LOG_ZSTD_MIN_SIZE 64 /**< Shorter messages are stored as plain text. */
+#define LOG_ZSTD_LEVEL 3 /**< Compression level of the messages. */
+#define LOG_ZSTD_DICT_SIZE (64 * 1024) /**< Capacity of a trained dictionary. */
+#define LOG_ZSTD_TRAIN_SIZE (16 * LOG_ZSTD_DICT_SIZE) /**< Bytes of messages collected before a dictionary is trained. */
+#define LOG_ZSTD_RETRAIN_MESSAGES 4000000 /**< Messages compressed with a dictionary before the next one is trained. */
+#define FIELD_ZDICT_ID "id"
+#define FIELD_ZDICT_DATA "data"
+#define LOG_ZSTD_DATA_TYPE_MS "MEDIUMTEXT" /**< Dictionary column of MySQL (VARCHAR(256) is too short). */
+
+/**
+ * @class LogMessageCompressor
+ * @brief zstd compression of the message column with dictionaries trained on the log itself.
+ * Log messages are short and repetitive, so each one is compressed on its own against
+ * a shared dictionary: rows stay independently readable and still shrink several times.
+ * Dictionaries are stored base64 encoded in a side table and never changed; a new one is
+ * trained from recent messages after LOG_ZSTD_RETRAIN_MESSAGES, older rows keep theirs.
+ * Stored value: LOG_ZSTD_PREFIX + dictionary id + ':' + base64(zstd frame).
+ * Messages shorter than LOG_ZSTD_MIN_SIZE, and messages written before the first
+ * dictionary was trained, are stored as is. Safe to use from several threads; the
+ * connection is passed per call, so pooled connections can use it. Requires SQLG_USE_ZSTD.
+ */
+class LogMessageCompressor
+{
+    public:
+        /**
+         * @brief Constructs a compressor.
+         * @param logsTableName Log table name (the dictionaries are kept in <logs table>_zdict).
+         * @throws std::runtime_error If zstd support is not compiled in.
+         */
+        explicit LogMessageCompressor(const std::string& logsTableName);
+
+        LogMessageCompressor(const LogMessageCompressor&) = delete;
+        LogMessageCompressor& operator=(const LogMessageCompressor&) = delete;
+
+        /**
+         * @brief Checks if the library was built with zstd support (SQLG_USE_ZSTD).
+         * @return bool True if LogMessageCompressor can be constructed.
+         */
+        static bool isSupported();
+
+        /**
+         * @brief Checks if a stored value was produced by compress().
+         * @param value Stored message.
+         * @return bool True if the value has the compression prefix.
+         */
+        static bool isCompressed(const std::string_view value)
+        {
+            return value.substr(0, sizeof(LOG_ZSTD_PREFIX) - 1) == LOG_ZSTD_PREFIX;
+        }
+
+        /**
+         * @brief Creates the dictionary table if it does not exist.
+         * @param database Connection to use.
+         */
+        void createTable(IDatabase& database);
+
+        /**
+         * @brief Loads the dictionaries added to the table since the last load.
+         * The newest one is used by compress().
+         * @param database Connection to use.
+         */
+        void load(IDatabase& database);
+
+        /**
+         * @brief Drops the loaded dictionaries and loads the stored ones again (e.g. after a rolled back transaction).
+         * @param database Connection to use.
+         */
+        void reload(IDatabase& database);
+
+        /**
+         * @brief Compresses a message with the current dictionary.
+         * @param message Message text.
+         * @return std::string Stored value, the message itself if it is short, no dictionary
+         * is trained yet or compression would not make it smaller.
+         */
+        std::string compress(const std::string_view message) const;
+
+        /**
+         * @brief Decompresses a value produced by compress().
+         * Values without the compression prefix are returned as is.
+         * @param value Stored message.
+         * @return std::optional<std::string> Message, or std::nullopt if the value is damaged or its dictionary is not loaded.
+         */
+        std::optional<std::string> decompress(const std::string& value) const;
+
+        /**
+         * @brief Compresses the messages of a batch.
+         * The messages are also sampled; once enough are collected a dictionary is
+         * trained and stored through the connection before the batch is compressed.
+         * @param database Connection to use for a new dictionary.
+         * @param entries Entries to write.
+         * @return LogEntryList Copy of the entries with compressed messages.
+         */
+        LogEntryList compressMessages(IDatabase& database, const LogEntryList& entries);
+
+        /**
+         * @brief Gets the dictionary table name.
+         * @return const std::string& Table name.
+         */
+        const std::string& getTableName() const
+        {
+            return tableName;
+        }
+
+    private:
+        struct Dictionary; /**< Compression and decompression tables of one stored dictionary. */
+
+        /**
+         * @brief Collects the long messages of a batch as training samples.
+         * Must be called with mutex held.
+         * @param entries Entries to write.
+         * @return bool True if enough samples are collected to train a dictionary.
+         */
+        bool sample(const LogEntryList& entries);
+
+        /**
+         * @brief Trains a dictionary from the collected samples, stores and loads it.
+         * A failure only drops the samples: messages keep the previous dictionary, or are stored as text.
+         * @param database Connection to use.
+         */
+        void train(IDatabase& database);
+
+        /**
+         * @brief Gets a loaded dictionary.
+         * @param id Dictionary id (0 = the current one).
+         * @return std::shared_ptr<const Dictionary> Dictionary, or nullptr if not loaded.
+         */
+        std::shared_ptr<const Dictionary> find(const int64_t id) const;
+
+        std::string tableName; /**< Dictionary table name. */
+        mutable std::mutex mutex; /**< Guards the members below. */
+        std::map<int64_t, std::shared_ptr<const Dictionary>> dictionaries; /**< Loaded dictionaries by id. */
+        int64_t loadedId = 0; /**< Dictionaries up to this id have been loaded (the newest is current). */
+        std::vector<std::string> samples; /**< Messages collected for the next dictionary. */
+        size_t samplesSize = 0; /**< Total size of samples. */
+        uint64_t compressedCount = 0; /**< Messages compressed since the current dictionary was trained. */
+        std::mutex trainMutex; /**< Serializes training, held without mutex. */
+};
+
+#endif // LOG_MESSAGE_COMPRESSOR_H
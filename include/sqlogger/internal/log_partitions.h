@@ -0,0 +1,241 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_PARTITIONS_H
+#define LOG_PARTITIONS_H
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/database/database_helper.h"
+
+#define LOG_DEFAULT_RETENTION_DAYS 0 /**< Default number of past days kept by the retention policy (0 = keep everything). */
+#define LOG_PARTITION_PREFIX "p" /**< Partition names: p<YYYYMMDD>, partition tables: <logs table>_p<YYYYMMDD>. */
+#define LOG_PARTITION_DAY_DIGITS 8 /**< Digits of a partition day (YYYYMMDD). */
+#define FIELD_PARTITION_NAME "name" /**< Column of QueryBuilder::buildPartitionsQuery(). */
+#define SQLITE_SEQUENCE_TABLE "sqlite_sequence" /**< SQLite AUTOINCREMENT sequences. */
+#define FIELD_SEQUENCE_NAME "name"
+#define FIELD_SEQUENCE_SEQ "seq"
+
+/**
+ * @class LogPartitions
+ * @brief Daily partitions of a log table, shared by every writer of a logger.
+ * A day is a local date stored as the integer YYYYMMDD; the partition of a day holds the
+ * entries whose timestamp column is in [day 00:00:00, next day 00:00:00). On PostgreSQL a
+ * partition is a table attached to the partitioned log table, on MySQL a RANGE COLUMNS
+ * partition (holding everything below its upper bound not held by an older partition), and
+ * on SQLite a plain table <logs table>_p<YYYYMMDD> read through a UNION ALL view named
+ * like the log table. The class only tracks the known partitions and computes their names
+ * and bounds; LogWriter runs the DDL. Safe to use from several threads.
+ */
+class LogPartitions
+{
+    public:
+        /**
+         * @brief Constructs the partition set of a log table (empty until assigned).
+         * @param logsTableName Log table name.
+         * @param databaseType Type of the database holding the table.
+         * @param timestampFormat Timestamp column format of the table.
+         * @param retentionDays Past days kept besides the current one (0 = keep everything).
+         */
+        LogPartitions(const std::string& logsTableName,
+                      const DataBaseType databaseType,
+                      const TimestampFormat timestampFormat,
+                      const int retentionDays = LOG_DEFAULT_RETENTION_DAYS);
+
+        LogPartitions(const LogPartitions&) = delete;
+        LogPartitions& operator=(const LogPartitions&) = delete;
+
+        /**
+         * @brief Gets the day of the partition an entry belongs to.
+         * The stored timestamp is used (LogEntry::timestampUs with TimestampFormat::EpochMicros,
+         * LogEntry::timestamp otherwise), falling back to the other field and to today.
+         * @param entry The log entry.
+         * @return int Day as YYYYMMDD.
+         */
+        int dayOf(const LogEntry& entry) const;
+
+        /**
+         * @brief Gets the current local day.
+         * @return int Day as YYYYMMDD.
+         */
+        static int today();
+
+        /**
+         * @brief Adds days to a day.
+         * @param day Day as YYYYMMDD.
+         * @param days Days to add (negative to subtract).
+         * @return int Resulting day as YYYYMMDD.
+         */
+        static int addDays(const int day, const int days);
+
+        /**
+         * @brief Gets the name of the partition of a day.
+         * @param day Day as YYYYMMDD.
+         * @return std::string Partition table name (SQLite, PostgreSQL) or partition name (MySQL).
+         */
+        std::string getName(const int day) const;
+
+        /**
+         * @brief Parses a name returned by QueryBuilder::buildPartitionsQuery().
+         * @param name Partition or partition table name.
+         * @return std::optional<int> Day, or std::nullopt if the name is not a partition of the table.
+         */
+        std::optional<int> parseName(const std::string& name) const;
+
+        /**
+         * @brief Gets the inclusive lower bound of the partition of a day (its first timestamp value).
+         * @param day Day as YYYYMMDD.
+         * @return std::string Timestamp column value at 00:00:00 local time.
+         */
+        std::string getLowerBound(const int day) const;
+
+        /**
+         * @brief Gets the exclusive upper bound of the partition of a day.
+         * @param day Day as YYYYMMDD.
+         * @return std::string Timestamp column value at 00:00:00 of the next day.
+         */
+        std::string getUpperBound(const int day) const;
+
+        /**
+         * @brief Checks if entries of a day can be inserted without creating a partition.
+         * On MySQL any partition of the same or a later day holds them.
+         * @param day Day as YYYYMMDD.
+         * @return bool True if a partition holds the day.
+         */
+        bool covers(const int day) const;
+
+        /**
+         * @brief Gets the newest partition.
+         * @return std::optional<int> Day, or std::nullopt if there is no partition.
+         */
+        std::optional<int> getNewestDay() const;
+
+        /**
+         * @brief Gets the known partitions.
+         * @return std::vector<int> Days, oldest first.
+         */
+        std::vector<int> getDays() const;
+
+        /**
+         * @brief Gets the partitions dropped by the retention policy.
+         * The newest partition is never expired, so the table always has one.
+         * @return std::vector<int> Days older than retentionDays before today, oldest first.
+         */
+        std::vector<int> getExpiredDays() const;
+
+        /**
+         * @brief Replaces the known partitions (e.g. with the ones listed by the database).
+         * The partition written last is forgotten, so the next write synchronizes the ID sequence.
+         * @param days Days of the partitions.
+         */
+        void assign(const std::vector<int> & days);
+
+        /**
+         * @brief Records a created partition.
+         * @param day Day as YYYYMMDD.
+         */
+        void add(const int day);
+
+        /**
+         * @brief Records a dropped partition.
+         * @param day Day as YYYYMMDD.
+         */
+        void remove(const int day);
+
+        /**
+         * @brief Gets the retention policy.
+         * @return int Past days kept besides the current one (0 = keep everything).
+         */
+        int getRetentionDays() const
+        {
+            return retentionDays;
+        }
+
+        /**
+         * @brief Gets the day of the partition written last (SQLite ID sequence synchronization).
+         * @return std::optional<int> Day, or std::nullopt before the first write.
+         */
+        std::optional<int> getLastWrittenDay() const;
+
+        /**
+         * @brief Sets the day of the partition written last.
+         * @param day Day as YYYYMMDD.
+         */
+        void setLastWrittenDay(const int day);
+
+        /**
+         * @brief Gets the lowest ID sequence value of new SQLite partitions.
+         * Keeps IDs increasing after the partitions holding the highest ones were dropped.
+         * @return int64_t Sequence floor.
+         */
+        int64_t getIdFloor() const;
+
+        /**
+         * @brief Raises the sequence floor.
+         * @param id Highest ID assigned so far.
+         */
+        void raiseIdFloor(const int64_t id);
+
+    private:
+        /**
+         * @brief Formats a day as YYYY-MM-DD 00:00:00 (TIMESTAMP_FMT at midnight).
+         * @param day Day as YYYYMMDD.
+         * @return std::string Midnight timestamp text.
+         */
+        static std::string toMidnightText(const int day);
+
+        /**
+         * @brief Gets the local midnight of a day in microseconds since the epoch.
+         * @param day Day as YYYYMMDD.
+         * @return int64_t Midnight in microseconds.
+         */
+        static int64_t toMidnightMicros(const int day);
+
+        /**
+         * @brief Gets the local day of microseconds since the epoch.
+         * @param micros Microseconds since the epoch.
+         * @return std::optional<int> Day, or std::nullopt if the time can't be converted.
+         */
+        static std::optional<int> dayOfMicros(const int64_t micros);
+
+        /**
+         * @brief Gets the day of TIMESTAMP_FMT text.
+         * @param timestamp Timestamp text starting with YYYY-MM-DD.
+         * @return std::optional<int> Day, or std::nullopt if the text has no date.
+         */
+        static std::optional<int> dayOfText(const std::string& timestamp);
+
+        std::string logsTableName; /**< Log table name. */
+        DataBaseType databaseType; /**< Type of the database holding the table. */
+        TimestampFormat timestampFormat; /**< Timestamp column format. */
+        int retentionDays; /**< Past days kept besides the current one (0 = keep everything). */
+
+        mutable std::mutex mutex; /**< Guards days, lastWrittenDay and idFloor. */
+        std::set<int> days; /**< Known partitions. */
+        std::optional<int> lastWrittenDay; /**< Partition written last. */
+        int64_t idFloor = 0; /**< Lowest sequence value of new SQLite partitions. */
+};
+
+#endif // LOG_PARTITIONS_H
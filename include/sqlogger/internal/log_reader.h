@@ -21,7 +21,14 @@
 #define LOG_READER_H
 
 #include <vector>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <memory>
 #include "sqlogger/log_entry.h"
+#include "sqlogger/internal/log_dictionary.h"
+#include "sqlogger/internal/log_cipher.h"
+#include "sqlogger/internal/log_message_compressor.h"
 #include "sqlogger/database/database_interface.h"
 #include "sqlogger/database/query_builder.h"
 
@@ -59,6 +66,108 @@ class LogReader
                                       const int limit = -1,
                                       const int offset = -1);
 
+        /**
+         * @brief Streams log entries matching the filters to a callback, ordered by ID.
+         * Rows are read one at a time from the database cursor, so memory use does not
+         * depend on the result size. With a positive page size the scan is split into
+         * keyset pages (WHERE id > last ORDER BY id LIMIT pageSize), which stay fast at
+         * any depth unlike LIMIT/OFFSET.
+         * @param filters Vector of Filter objects defining search criteria.
+         * @param callback Function called for each entry; return false to stop the scan.
+         * @param pageSize Rows per keyset page (0 streams everything with a single query).
+         * @param afterId Only entries with an ID greater than this are visited (resume point).
+         * @throws std::invalid_argument If filter op is empty or ivalid.
+         * @throws std::runtime_error If a query fails.
+         * @return size_t Number of entries passed to the callback.
+         */
+        size_t forEachLog(const std::vector<Filter> & filters,
+                          const LogCallback& callback,
+                          const int pageSize = 0,
+                          const int64_t afterId = 0);
+
+        /**
+         * @brief Counts the log entries matching the filters per value of a column.
+         * The database groups and counts the rows (GROUP BY), only the counts are transferred.
+         * @param field Log table column (see getLogFields()).
+         * @param filters Filters, combined with AND.
+         * @throws std::invalid_argument If the field or a filter op is invalid.
+         * @return LogCounts Number of entries per value (NULL values are counted under "").
+         */
+        LogCounts countBy(const std::string& field, const std::vector<Filter> & filters = {});
+
+        /**
+         * @brief Counts the log entries matching the filters per time bucket.
+         * @param bucketSeconds Bucket width in seconds, buckets are aligned to multiples of it.
+         * @param filters Filters, combined with AND.
+         * @throws std::invalid_argument If the bucket width or a filter op is invalid.
+         * @return LogCounts Number of entries per bucket start (TIMESTAMP_FMT local time), empty buckets are omitted.
+         */
+        LogCounts histogram(const int bucketSeconds, const std::vector<Filter> & filters = {});
+
+        /**
+         * @brief Counts the log entries matching the filters per time bucket and value of a column.
+         * @param field Log table column (see getLogFields()).
+         * @param bucketSeconds Bucket width in seconds, buckets are aligned to multiples of it.
+         * @param filters Filters, combined with AND.
+         * @throws std::invalid_argument If the field, the bucket width or a filter op is invalid.
+         * @return LogHistogram Number of entries per bucket start (TIMESTAMP_FMT local time) and value.
+         */
+        LogHistogram histogramBy(const std::string& field, const int bucketSeconds, const std::vector<Filter> & filters = {});
+
+        /**
+         * @brief Sets the timestamp column format of the log table.
+         * With TimestampFormat::EpochMicros timestamps are formatted when read and
+         * timestamp filter values (TIMESTAMP_FMT text or microseconds) are converted to integers.
+         * @param format Timestamp format (must match the table).
+         */
+        void setTimestampFormat(const TimestampFormat format)
+        {
+            timestampFormat = format;
+        }
+
+        /**
+         * @brief Selects the compact schema of the log table.
+         * Integer levels and dictionary ids are decoded when read; level filters accept
+         * level names or integers, function, file and thread ID filters support "=", "!=" and "<>".
+         * @param dictionaries Dictionaries of the log table (nullptr = standard schema).
+         */
+        void setCompactSchema(std::shared_ptr<LogDictionaries> dictionaries)
+        {
+            this->dictionaries = std::move(dictionaries);
+        }
+
+        /**
+         * @brief Selects how MATCH filters are evaluated.
+         * With full-text search the words are looked up in the full-text index created by
+         * LogWriter::createIndexes(), otherwise each word becomes a LIKE '%word%' filter.
+         * @param enabled True if the log table has a full-text index on the message column.
+         */
+        void setFullTextSearch(const bool enabled)
+        {
+            fullTextSearch = enabled;
+        }
+
+        /**
+         * @brief Selects the cipher of the message column.
+         * Encrypted messages are decrypted when read; a message that fails to decrypt is returned as stored.
+         * @param cipher Cipher of the log table (nullptr = plaintext messages).
+         */
+        void setCipher(std::shared_ptr<const LogCipher> cipher)
+        {
+            this->cipher = std::move(cipher);
+        }
+
+        /**
+         * @brief Selects the compressor of the message column.
+         * Compressed messages are decompressed when read; dictionaries added by other
+         * writers are loaded before each query. Message filters only see the stored text.
+         * @param messageCompressor Compressor of the log table (nullptr = plain messages).
+         */
+        void setMessageCompression(std::shared_ptr<LogMessageCompressor> messageCompressor)
+        {
+            this->messageCompressor = std::move(messageCompressor);
+        }
+
 #ifdef SQLG_USE_SOURCE_INFO
         /**
          * @brief Retrieves a source by its source ID.
@@ -90,8 +199,150 @@ class LogReader
 #endif
 
     private:
+        /**
+         * @struct LogColumns
+         * @brief Positions of the log fields in a result set.
+         */
+        struct LogColumns
+        {
+            /**
+             * @brief Resolves log column positions once instead of per-row lookups.
+             * @param result Result set returned for getLogFields().
+             */
+            explicit LogColumns(const ResultSet& result);
+
+            size_t id; /**< Log ID column. */
+#ifdef SQLG_USE_SOURCE_INFO
+            size_t sourceId; /**< Source ID column. */
+#endif
+            size_t timestamp; /**< Timestamp column. */
+            size_t level; /**< Level column. */
+            size_t message; /**< Message column. */
+            size_t function; /**< Function column. */
+            size_t file; /**< File column. */
+            size_t line; /**< Line column. */
+            size_t threadId; /**< Thread ID column. */
+        };
+
+        /**
+         * @brief Gets the log table fields read by LogReader.
+         * @return std::vector<std::string> Field names in select order.
+         */
+        static std::vector<std::string> getLogFields();
+
+        /**
+         * @brief Converts a result row to a LogEntry (source UUID and name are left empty).
+         * @param result Result set.
+         * @param row Row index.
+         * @param columns Resolved column positions.
+         * @return LogEntry Converted entry.
+         */
+        LogEntry toLogEntry(const ResultSet& result, const size_t row, const LogColumns& columns) const;
+
+        /**
+         * @brief Reads log entries from a backend that stores them natively (IDatabase::supportsNativeLogs()).
+         * Timestamps are formatted for the configured format and sources are resolved.
+         * @param filters Filters, combined with AND.
+         * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP.
+         * @param limit Maximum number of entries (0 or negative = no limit).
+         * @param offset Number of entries to skip, requires a positive limit.
+         * @param callback Function called for each entry; return false to stop reading.
+         * @return size_t Number of entries passed to the callback.
+         */
+        size_t selectNativeLogs(const std::vector<Filter> & filters,
+                                const std::string& orderBy,
+                                const int limit,
+                                const int offset,
+                                const LogCallback& callback);
+
+        /**
+         * @brief Gets the query parameters for the filters.
+         * @param filters Filters in query order.
+         * @return std::vector<std::string> Filter values (timestamps, levels and dictionary values converted to the column format).
+         * @throws std::invalid_argument If a value cannot be converted or the operator is not supported by the column.
+         */
+        std::vector<std::string> getFilterParams(const std::vector<Filter> & filters) const;
+
+        /**
+         * @brief Callback receiving the group values (in group field order) and the row count of a group.
+         */
+        using GroupCallback = std::function<void(const std::vector<std::string> & keys, const uint64_t count)>;
+
+        /**
+         * @brief Counts the log entries matching the filters per group.
+         * SQL backends run a GROUP BY query, backends storing logs natively are scanned in process.
+         * @param fields Group fields (FIELD_LOG_TIMESTAMP is grouped by time bucket if bucketSeconds > 0).
+         * @param bucketSeconds Time bucket width in seconds (0 = group timestamps by value).
+         * @param filters Filters, combined with AND.
+         * @param callback Function called for each group.
+         * @throws std::invalid_argument If a field or a filter op is invalid.
+         */
+        void countGroups(const std::vector<std::string> & fields,
+                         const int bucketSeconds,
+                         const std::vector<Filter> & filters,
+                         const GroupCallback& callback);
+
+        /**
+         * @brief Converts a group column of a GROUP BY result row to its value.
+         * @param result Result set.
+         * @param row Row index.
+         * @param column Column index.
+         * @param field Group field.
+         * @param bucketSeconds Time bucket width in seconds (0 = timestamps are not bucketed).
+         * @return std::string Value as returned in log entries (bucket start for timestamps, "" for NULL).
+         */
+        std::string getGroupKey(const ResultSet& result,
+                                const size_t row,
+                                const size_t column,
+                                const std::string& field,
+                                const int bucketSeconds) const;
+
+        /**
+         * @brief Gets the group value of a log entry.
+         * @param entry Log entry.
+         * @param field Group field.
+         * @param bucketSeconds Time bucket width in seconds (0 = timestamps are not bucketed).
+         * @return std::string Field value (bucket start for timestamps).
+         */
+        std::string getGroupKey(const LogEntry& entry, const std::string& field, const int bucketSeconds) const;
+
+        /**
+         * @brief Validates the filters and rewrites the MATCH filters the backend cannot run.
+         * MATCH filters without words are dropped; without full-text search (or on a backend
+         * storing logs natively) every word becomes a LIKE '%word%' filter.
+         * @param filters Filters as given by the caller.
+         * @return std::vector<Filter> Filters to query with.
+         * @throws std::invalid_argument If filter op is empty or ivalid.
+         */
+        std::vector<Filter> resolveFilters(const std::vector<Filter> & filters) const;
+
+        /**
+         * @brief Converts a filter value of a compact schema column.
+         * @param filter The filter.
+         * @return std::string Integer level or dictionary id (-1 for values not in the dictionary).
+         * @throws std::invalid_argument If a value cannot be converted or the operator is not supported by the column.
+         */
+        std::string toCompactParam(const Filter& filter) const;
+
+#ifdef SQLG_USE_SOURCE_INFO
+        using SourceCache = std::unordered_map<int, std::optional<SourceInfo>>;
+
+        /**
+         * @brief Resolves a source ID through a per-query cache.
+         * @param sourceId The source ID to resolve.
+         * @param cache Sources already resolved in this query (misses are cached too).
+         * @return const std::optional<SourceInfo>& The source, or std::nullopt if not found or incomplete.
+         */
+        const std::optional<SourceInfo> & resolveSource(const int sourceId, SourceCache& cache);
+#endif
+
         IDatabase& database; /**< The database interface used for reading logs. */
         std::string logsTableName;
+        TimestampFormat timestampFormat = TimestampFormat::Text; /**< Timestamp column format. */
+        std::shared_ptr<LogDictionaries> dictionaries; /**< Dictionaries of the compact schema (nullptr = standard schema). */
+        bool fullTextSearch = false; /**< Whether MATCH filters use the full-text index. */
+        std::shared_ptr<const LogCipher> cipher; /**< Cipher of the message column (nullptr = plaintext). */
+        std::shared_ptr<LogMessageCompressor> messageCompressor; /**< Compressor of the message column (nullptr = plain messages). */
 };
 
 #endif // LOG_READER_H
\ No newline at end of file
@@ -20,7 +20,9 @@
 #ifndef LOG_SERIALIZER_H
 #define LOG_SERIALIZER_H
 
+#include <istream>
 #include <sstream>
+#include <string_view>
 #include "sqlogger/log_entry.h"
 
 #ifdef SQLG_USE_EXTERNAL_JSON_PARSER
@@ -32,15 +34,12 @@ namespace
 {
     struct JsonParser
     {
-        static std::string getString(const std::string& json, const std::string& key);
-        static int getInt(const std::string& json, const std::string& key);
-
         /**
-        * @brief Escapes special characters in a JSON string.
+        * @brief Appends a string to a buffer with JSON escaping (SSE2 / NEON scan for characters to escape).
+        * @param out Buffer to append to.
         * @param str The string to escape.
-        * @return The escaped string.
         */
-        static std::string escapeJsonString(const std::string& str);
+        static void appendEscaped(std::string& out, std::string_view str);
     };
 }
 
@@ -53,11 +52,32 @@ namespace LogSerializer
          */
         std::string serializeLog(const LogEntry& entry);
 
+        /**
+         * @brief Appends the JSON of a single log entry to a reusable buffer
+         */
+        void appendLog(std::string& out, const LogEntry& entry);
+
         /**
          * @brief Serializes multiple logs to JSON array
          */
         std::string serializeLogs(const LogEntryList& logs);
 
+        /**
+         * @brief Serializes a single log entry to one line of JSON (NDJSON / JSON Lines)
+         * The result contains no newline; strings are escaped, so the line can be split on '\n'.
+         */
+        std::string serializeLogLine(const LogEntry& entry);
+
+        /**
+         * @brief Appends one NDJSON line (without the trailing newline) to a reusable buffer
+         */
+        void appendLogLine(std::string& out, const LogEntry& entry);
+
+        /**
+         * @brief Serializes multiple logs to NDJSON, one entry per line
+         */
+        std::string serializeLogLines(const LogEntryList& logs);
+
         /**
          * @brief Serializes filter to JSON
          */
@@ -80,6 +100,22 @@ namespace LogSerializer
         */
         LogEntryList parseLogs(const std::string& jsonArray);
 
+        /**
+         * @brief Parses NDJSON incrementally, one line at a time (blank lines are skipped)
+         * Memory use does not depend on the input size.
+         * @param input Stream positioned at the first line.
+         * @param callback Called for each entry; return false to stop.
+         * @return size_t Number of entries passed to the callback.
+         * @throws std::runtime_error on parse failure
+         */
+        size_t parseLogLines(std::istream& input, const LogCallback& callback);
+
+        /**
+         * @brief Parses an NDJSON string into LogEntryList
+         * @throws std::runtime_error on parse failure
+         */
+        LogEntryList parseLogLines(const std::string& lines);
+
         /**
          * @brief Parses JSON filters
          * @throws std::runtime_error on parse failure
@@ -0,0 +1,158 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_SPOOL_H
+#define LOG_SPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include "sqlogger/log_entry.h"
+
+#define LOG_SPOOL_RECORD_HEADER_SIZE 8 /**< Record header: payload size (u32) and FNV-1a checksum (u32). */
+#define LOG_SPOOL_OFFSET_SUFFIX ".pos" /**< Suffix of the file holding the replayed offset. */
+#define LOG_SPOOL_RETRY_MAX_MS 10000 /**< Upper bound of the replay retry delay. */
+
+/**
+ * @class LogSpool
+ * @brief Append-only local file absorbing log entries while the database is unavailable.
+ * Every append writes one record (header plus a LogSerializer::Binary block) at the end
+ * of the file. A reader replays records from the replayed offset, which is kept in a
+ * side file, so a restart continues where the last replay stopped; a torn record left
+ * by a crash is cut off when the spool is opened. Once everything is replayed the file
+ * is truncated. Records are flushed to the OS on append (they survive a process crash),
+ * the file is not fsync'ed. Safe to use from several threads.
+ */
+class LogSpool
+{
+    public:
+        /**
+         * @brief Opens (or creates) a spool file and recovers its unreplayed records.
+         * @param path Spool file path.
+         * @param maxBytes Maximum file size in bytes (0 = unlimited).
+         * @throws std::runtime_error If the file cannot be opened.
+         */
+        explicit LogSpool(const std::string& path, const uint64_t maxBytes = 0);
+
+        LogSpool(const LogSpool&) = delete;
+        LogSpool& operator=(const LogSpool&) = delete;
+
+        /**
+         * @brief Appends entries as one record.
+         * @param entries Entries to append.
+         * @param count Number of entries.
+         * @return bool False if the spool is full or the write failed.
+         */
+        bool append(const LogEntry* entries, const size_t count);
+
+        /**
+         * @brief Appends entries as one record.
+         * @param entries Entries to append.
+         * @return bool False if the spool is full or the write failed.
+         */
+        bool append(const LogEntryList& entries)
+        {
+            return append(entries.data(), entries.size());
+        }
+
+        /**
+         * @brief Reads the oldest unreplayed records without consuming them.
+         * Whole records are read until at least maxEntries entries are collected.
+         * @param entries Receives the entries.
+         * @param maxEntries Entry count at which reading stops.
+         * @return size_t Number of entries read.
+         * @throws std::runtime_error If a record is corrupt (the spool is cut off before it).
+         */
+        size_t peek(LogEntryList& entries, const size_t maxEntries);
+
+        /**
+         * @brief Marks the records returned by the last peek() as replayed.
+         * Truncates the file when nothing is left to replay.
+         */
+        void consume();
+
+        /**
+         * @brief Checks if every record has been replayed.
+         * @return bool True if the spool is empty.
+         */
+        bool empty() const
+        {
+            return pendingBytes.load(std::memory_order_acquire) == 0;
+        }
+
+        /**
+         * @brief Gets the size of the unreplayed records.
+         * @return uint64_t Size in bytes.
+         */
+        uint64_t size() const
+        {
+            return pendingBytes.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Gets the spool file path.
+         * @return const std::string& Path.
+         */
+        const std::string& getPath() const
+        {
+            return path;
+        }
+
+    private:
+        /**
+         * @brief Loads the replayed offset and cuts off a torn or corrupt tail.
+         */
+        void recover();
+
+        /**
+         * @brief Opens the spool file.
+         * @param truncate Whether to discard the file contents.
+         * @throws std::runtime_error If the file cannot be opened.
+         */
+        void open(const bool truncate);
+
+        /**
+         * @brief Reads the record at an offset.
+         * @param offset Record offset.
+         * @param payload Receives the record payload.
+         * @return bool False if the record is incomplete or its checksum does not match.
+         */
+        bool readRecord(const uint64_t offset, std::string& payload);
+
+        /**
+         * @brief Stores the replayed offset in the side file.
+         */
+        void saveOffset() const;
+
+        std::string path; /**< Spool file path. */
+        std::string offsetPath; /**< Replayed offset file path. */
+        uint64_t maxBytes; /**< Maximum file size (0 = unlimited). */
+
+        mutable std::mutex mutex; /**< Guards the file and the offsets. */
+        std::fstream file; /**< Spool file. */
+        uint64_t readOffset = 0; /**< End of the replayed records. */
+        uint64_t peekOffset = 0; /**< End of the records returned by the last peek(). */
+        uint64_t writeOffset = 0; /**< End of the valid records. */
+        std::atomic<uint64_t> pendingBytes{ 0 }; /**< writeOffset - readOffset, readable without the mutex. */
+};
+
+#endif // LOG_SPOOL_H
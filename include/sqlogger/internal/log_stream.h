@@ -0,0 +1,183 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_STREAM_H
+#define LOG_STREAM_H
+
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define LOG_STREAM_INLINE_SIZE 256 /**< Message bytes formatted without touching the heap. */
+
+/**
+ * @class LogStreamBuffer
+ * @brief Stream buffer formatting into inline storage, spilling longer messages into a std::string.
+ * The spill string keeps its capacity across reset(), so a reused buffer stops allocating.
+ */
+class LogStreamBuffer : public std::streambuf
+{
+    public:
+        LogStreamBuffer()
+        {
+            reset();
+        }
+
+        LogStreamBuffer(const LogStreamBuffer&) = delete;
+        LogStreamBuffer& operator=(const LogStreamBuffer&) = delete;
+
+        /**
+         * @brief Gets the formatted text.
+         * @return std::string_view Text, valid until the next write or reset().
+         */
+        std::string_view view()
+        {
+            if(spill.empty())
+            {
+                return std::string_view(pbase(), pptr() - pbase());
+            }
+            spillInline();
+            return spill;
+        }
+
+        /**
+         * @brief Discards the formatted text (keeps allocated storage).
+         */
+        void reset()
+        {
+            spill.clear();
+            setp(inlineData, inlineData + LOG_STREAM_INLINE_SIZE);
+        }
+
+    protected:
+        /**
+         * @brief Moves the full inline area into the spill string and stores the next character.
+         * @param ch Character to store (or EOF).
+         * @return int_type Non-EOF on success.
+         */
+        int_type overflow(int_type ch) override
+        {
+            spillInline();
+            if(!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                * pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+    private:
+        /**
+         * @brief Appends the inline area to the spill string and empties it.
+         */
+        void spillInline()
+        {
+            spill.append(pbase(), pptr() - pbase());
+            setp(inlineData, inlineData + LOG_STREAM_INLINE_SIZE);
+        }
+
+        char inlineData[LOG_STREAM_INLINE_SIZE]; /**< Inline (small message) storage. */
+        std::string spill; /**< Storage for messages longer than the inline area. */
+};
+
+/**
+ * @class LogStream
+ * @brief Reusable output stream for building log messages.
+ * Streams are taken from and returned to a per-thread free list, so steady-state
+ * logging constructs no stream and allocates no message storage. Nested messages
+ * (logging while formatting another message) simply take another stream.
+ */
+class LogStream
+{
+    public:
+        LogStream() : out( & buffer)
+        {
+        }
+
+        LogStream(const LogStream&) = delete;
+        LogStream& operator=(const LogStream&) = delete;
+
+        /**
+         * @brief Takes a stream from the calling thread's free list (creating one if empty).
+         * @return std::unique_ptr<LogStream> Stream with empty text and default formatting.
+         */
+        static std::unique_ptr<LogStream> acquire()
+        {
+            auto & streams = freeList();
+            if(streams.empty())
+            {
+                return std::make_unique<LogStream>();
+            }
+            std::unique_ptr<LogStream> stream = std::move(streams.back());
+            streams.pop_back();
+            return stream;
+        }
+
+        /**
+         * @brief Resets a stream and returns it to the calling thread's free list.
+         * @param stream Stream to release.
+         */
+        static void release(std::unique_ptr<LogStream> stream)
+        {
+            stream->buffer.reset();
+            stream->out.clear();
+            stream->out.flags(std::ios_base::skipws | std::ios_base::dec);
+            stream->out.precision(6);
+            stream->out.width(0);
+            stream->out.fill(' ');
+            freeList().push_back(std::move(stream));
+        }
+
+        /**
+         * @brief Gets the output stream.
+         * @return std::ostream& Stream to format into.
+         */
+        std::ostream& stream()
+        {
+            return out;
+        }
+
+        /**
+         * @brief Gets the formatted text.
+         * @return std::string_view Text, valid until the stream is written to or released.
+         */
+        std::string_view view()
+        {
+            return buffer.view();
+        }
+
+    private:
+        /**
+         * @brief Gets the calling thread's free list.
+         * @return std::vector<std::unique_ptr<LogStream>>& Free streams.
+         */
+        static std::vector<std::unique_ptr<LogStream>> & freeList()
+        {
+            thread_local std::vector<std::unique_ptr<LogStream>> streams;
+            return streams;
+        }
+
+        LogStreamBuffer buffer; /**< Message storage. */
+        std::ostream out; /**< Formatting stream writing into buffer. */
+};
+
+#endif // LOG_STREAM_H
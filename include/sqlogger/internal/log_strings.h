@@ -21,6 +21,7 @@
 #define LOG_STRINGS_H
 
 #define ERR_MSG_FAILED_QUERY "Failed to execute query"
+#define ERR_MSG_FAILED_STREAM_QUERY "Failed to stream log entries: "
 #define ERR_MSG_FAILED_TASK "Error in processTask: "
 #define ERR_MSG_FAILED_OPEN_ERR_LOG "Failed to open error log file: "
 #define ERR_MSG_TIMEOUT_TASK_QUEUE "Timeout while waiting for task queue to empty"
@@ -30,18 +31,45 @@
 #define ERR_MSG_FAILED_NOT_CONNECTED_DB "Not connected to database"
 #define ERR_MSG_FAILED_OPEN_FILE "Failed to open file: "
 #define ERR_MSG_FAILED_OPEN_FILE_RW "Failed to open file for writing: "
+#define ERR_MSG_FAILED_WRITE_FILE "Failed to write file: "
 #define ERR_MSG_FAILED_ENABLE_WAL "Failed to enable WAL mode"
 #define ERR_MSG_SQL_ERR "SQL error: "
 #define ERR_MSG_FAILED_PREPARE_STMT "Failed to prepare statement: "
 #define ERR_MSG_FAILED_RECONNECT_DB "Failed to reconnect to database"
 #define ERR_MSG_UNKNOWN_EXPORT_FMT "Unknown export format"
+#define ERR_MSG_EXPORT_FMT_NOT_SUPPORTED "Export format is not supported by this build: "
+#define ERR_MSG_EXPORT_FMT_NOT_TEXT "Export format has no text representation: "
+#define ERR_MSG_COLUMNAR_EXPORT_FAILED "Columnar export failed: "
+#define ERR_MSG_COMPRESSION_NOT_SUPPORTED "Compression is not supported by this build: "
+#define ERR_MSG_COMPRESSION_FAILED "Compression failed: "
+#define ERR_MSG_DECOMPRESSION_FAILED "Decompression failed: "
+#define ERR_MSG_BINARY_CORRUPT "Corrupt binary log data"
+#define ERR_MSG_BINARY_VERSION "Unsupported binary log version: "
+#define ERR_MSG_SPOOL_CORRUPT "Corrupt spool record, discarding the rest of: "
+#define ERR_MSG_SPOOL_ENGAGED "Database write failed, spooling entries to: "
+#define ERR_MSG_SPOOL_FULL "Failed to spool entries to: "
+#define ERR_MSG_SPOOL_REPLAY_FAILED "Spool replay failed: "
 #define ERR_MSG_CONNECTION_FAILED "Connection failed: "
+#define ERR_MSG_TRANSPORT_START_FAILED "Failed to start transport server: "
+#define ERR_MSG_TRANSPORT_NO_ENDPOINT "Transport host or port is not configured"
+#define ERR_MSG_TRANSPORT_CALL_FAILED "Transport call failed: "
+#define ERR_MSG_TRANSPORT_INVALID_REQUEST "Invalid transport request"
+#define ERR_MSG_TRANSPORT_NO_HANDLER "No transport handler set for: "
 #define ERR_MSG_MYSQL_INIT_FAILED "MySQL initialization failed"
 #define ERR_MSG_DROP_NOT_ALLOWED "Database drop is not allowed"
 #define ERR_MSG_UNSUPPORTED_DB "Unsupported database type"
 #define ERR_MSG_PASSKEY_EMPTY "Passkey is empty. Set passkey value"
 #define ERR_MSG_FAILED_BATCH_TASK "Batch task failed: "
 #define ERR_MSG_FAILED_BATCH_QUERY "Batch query failed: "
+#define ERR_MSG_FAILED_GROUP_COMMIT "Group commit failed"
+#define ERR_MSG_GROUP_ENTRIES_LOST "Entries of a rolled back group could not be written again: "
+#define ERR_MSG_FAILED_DROP_INDEXES "Failed to drop log table indexes"
+#define ERR_MSG_FAILED_CREATE_INDEXES "Failed to create log table indexes"
+#define ERR_MSG_INVALID_BULK_ROWS "Bulk insert values don't match the number of fields"
+#define ERR_MSG_FAILED_BULK_SEND "Failed to send bulk data"
+#define ERR_MSG_INFILE_REJECTED "LOCAL INFILE request rejected: only bulkInsert() data is served"
+#define ERR_MSG_FAILED_POOL_CONNECT "Failed to open pooled database connection"
+#define ERR_MSG_TABLE_NOT_PARTITIONED "Log table exists and is not partitioned: "
 #define ERR_MSG_LOGGER_EXISTS "Logger exists: "
 #define ERR_MSG_DB_TYPE_NOT_SPECIFIED "Database type not specified"
 #define ERR_MSG_LOGGER_NAME_NOT_FOUND "Logger name not found: "
@@ -52,10 +80,30 @@
 #define ERR_MSG_MISSING_PARAMS "Missing params: "
 #define ERR_MSG_INVALID_PARAMS "Invalid params: "
 #define ERR_MSG_INVALID_OPERATOR "Invalid filter operator: "
+#define ERR_MSG_INVALID_TIMESTAMP "Invalid timestamp filter value: "
+#define ERR_MSG_INVALID_LEVEL "Invalid level filter value: "
+#define ERR_MSG_INVALID_GROUP_FIELD "Invalid group field: "
+#define ERR_MSG_INVALID_BUCKET "Time bucket width must be positive: "
+#define ERR_MSG_COMPACT_FILTER_OP "Filter operator not supported on a compact schema column: "
+#define ERR_MSG_MEMORY_FILTER_FIELD "Filter field not supported by the memory database: "
+#define ERR_MSG_MEMORY_FILTER_VALUE "Filter value is not a number: "
+#define ERR_MSG_MEMORY_NO_SQL "The memory database does not execute SQL"
 #define ERR_MSG_FILTER_OP_EMPTY "Filter operator cannot be empty"
 #define ERR_MSG_UNABLE_DELETE_ERRLOG "Unable to delete error log file: "
 #define ERR_MSG_DELETED_FILE_NOT_EXISTS "File to delete not exists: "
 #define ERR_MSG_UNABLE_OBTAIN_FILESIZE "Unable to obtain file size: "
+#define ERR_MSG_INVALID_CPU "Invalid CPU index: "
+#define ERR_MSG_FAILED_SET_AFFINITY "Failed to set thread affinity: "
+#define ERR_MSG_AFFINITY_NOT_SUPPORTED "Thread affinity is not supported on this platform"
+#define ERR_MSG_INVALID_THREAD_PRIORITY "Invalid thread priority: "
+#define ERR_MSG_FAILED_SET_THREAD_PRIORITY "Failed to set thread priority: "
+#define ERR_MSG_THREAD_PRIORITY_NOT_SUPPORTED "Thread priority is not supported on this platform"
+#define ERR_MSG_THREAD_SETTINGS "Logger thread settings not applied: "
+#define ERR_MSG_QUERY_AFTER_SHUTDOWN "Query after the logger was shut down"
+#define ERR_MSG_CIPHER_NOT_SUPPORTED "Message encryption requires a build with SQLG_USE_AES"
+#define ERR_MSG_MESSAGE_COMPRESSION_NOT_SUPPORTED "Message compression requires a build with SQLG_USE_ZSTD"
+#define ERR_MSG_SHARD_UNKNOWN_TABLE "Table is not stored by the sharded database: "
+#define ERR_MSG_SHARD_FAILED "Shard "
 
 #ifdef SQLG_USE_AES
     #define ERR_MSG_CRYPTO_ENC_INIT_FAILED "Encryption init failed"
@@ -65,6 +113,8 @@
     #define ERR_MSG_CRYPTO_DEC_UPDATE_FAILED "Decryption update failed"
     #define ERR_MSG_CRYPTO_DEC_FINAL_FAILED "Decryption final failed"
     #define ERR_MSG_CRYPTO_EVPCON_FAILED "Failed to create EVP context"
+    #define ERR_MSG_CRYPTO_KEY_FAILED "Key derivation failed"
+    #define ERR_MSG_CRYPTO_RAND_FAILED "Failed to generate random bytes"
 #endif
 
 #ifdef SQLG_USE_SOURCE_INFO
@@ -0,0 +1,241 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_TAIL_CACHE_H
+#define LOG_TAIL_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/database/database_interface.h"
+
+#define LOG_DEFAULT_TAIL_CACHE_SIZE 0 /**< Default number of recent entries kept by the tail cache (0 = disabled). */
+
+/**
+ * @class LogTailCache
+ * @brief Bounded in-process copy of the most recently written log entries.
+ * The writer appends every entry it has written, with the ID assigned by the database
+ * (read back with one keyset query, WHERE id > last ORDER BY id, per write), and
+ * SQLogger::getLogsByFilters() answers from it queries whose result is known to be
+ * complete: the filters must include a lower timestamp bound newer than the floor, the
+ * newest timestamp that may be missing from the cache. The floor moves forward when old
+ * entries are evicted and when the cache cannot follow the table any more (a failed or
+ * rolled back write, a spooled write, a cleared table, an ID gap left by another writer).
+ * Only the =, !=, <>, <, <=, > and >= operators are evaluated; other queries go to the
+ * database. The cache assumes the logger is the only writer of its table; rows added by
+ * another writer are detected at the next write. Safe to use from several threads.
+ */
+class LogTailCache
+{
+    public:
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Looks up a source by ID (called from append() on the writer connection).
+         */
+        using SourceResolver = std::function<std::optional<SourceInfo>(int sourceId)>;
+#endif
+
+        /**
+         * @brief Constructs an empty cache. Its floor is the current time, as the table
+         * may already hold older entries.
+         * @param capacity Maximum number of cached entries.
+         * @param logsTableName Log table name.
+         * @param databaseType Type of the database holding the table.
+         * @param timestampFormat Timestamp column format of the table.
+         */
+        LogTailCache(const size_t capacity,
+                     const std::string& logsTableName,
+                     const DataBaseType databaseType,
+                     const TimestampFormat timestampFormat);
+
+        LogTailCache(const LogTailCache&) = delete;
+        LogTailCache& operator=(const LogTailCache&) = delete;
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Sets the source lookup used to fill the source UUID and name of cached entries.
+         * @param resolver Source lookup (entries of unknown sources invalidate the cache).
+         */
+        void setSourceResolver(SourceResolver resolver);
+#endif
+
+        /**
+         * @brief Adds entries that were just written by the connection.
+         * @param database Connection that wrote the entries (queried for their IDs).
+         * @param entries The written entries, in insert order.
+         */
+        void append(IDatabase& database, const LogEntryList& entries);
+
+        /**
+         * @brief Drops the cached entries and moves the floor to the current time.
+         * Called when the table changes in a way the cache cannot follow.
+         */
+        void invalidate();
+
+        /**
+         * @brief Drops the cached entries and the resolved sources (the table was cleared).
+         */
+        void clear();
+
+        /**
+         * @brief Answers a query from the cache if its result is known to be complete.
+         * The result is the one of LogReader::getLogsByFilters(): ordered by timestamp,
+         * entries with the same timestamp by ID.
+         * @param filters Query filters.
+         * @param limit Maximum number of entries (<= 0 = no limit).
+         * @param offset Entries skipped (only with a positive limit).
+         * @return std::optional<LogEntryList> Entries, or std::nullopt if the database must be queried.
+         */
+        std::optional<LogEntryList> find(const std::vector<Filter> & filters, const int limit, const int offset) const;
+
+        /**
+         * @brief Gets the number of cached entries.
+         * @return size_t Entry count.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Gets the number of queries answered by find().
+         * @return uint64_t Hit count.
+         */
+        uint64_t getHits() const
+        {
+            return hits.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of queries find() passed to the database.
+         * @return uint64_t Miss count.
+         */
+        uint64_t getMisses() const
+        {
+            return misses.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Resets the hit and miss counters.
+         */
+        void resetCounters()
+        {
+            hits = 0;
+            misses = 0;
+        }
+
+    private:
+        struct Predicate;
+
+        /**
+         * @brief Timestamp in the form the table compares it: text or microseconds.
+         */
+        struct Key
+        {
+            std::string text; /**< TimestampFormat::Text. */
+            int64_t micros = 0; /**< TimestampFormat::EpochMicros. */
+        };
+
+        /**
+         * @brief Converts a filter to a predicate.
+         * @param filter The filter.
+         * @return std::optional<Predicate> Predicate, or std::nullopt if the cache cannot evaluate the filter.
+         */
+        std::optional<Predicate> compile(const Filter& filter) const;
+
+        /**
+         * @brief Checks if a lower timestamp bound excludes every entry at or below the floor.
+         * @param predicate Timestamp predicate.
+         * @return bool True if all matching entries are cached.
+         */
+        bool covers(const Predicate& predicate) const;
+
+        /**
+         * @brief Compares the timestamp of an entry with a key.
+         * @param entry The entry.
+         * @param key The key.
+         * @return int Negative, zero or positive.
+         */
+        int compareTimestamp(const LogEntry& entry, const Key& key) const;
+
+        /**
+         * @brief Selects the IDs the database assigned since the last append.
+         * @param database Connection that wrote the entries.
+         * @param filter Range of the new rows (id > last, or timestamp > floor).
+         * @param param Value bound to the filter.
+         * @return std::vector<int64_t> IDs in ascending order.
+         */
+        std::vector<int64_t> selectIds(IDatabase& database, const Filter& filter, const std::string& param) const;
+
+        /**
+         * @brief Converts a written entry to the form LogReader returns it in.
+         * @param entry The entry (the ID is set).
+         * @return bool False if its source could not be resolved.
+         */
+        bool normalize(LogEntry& entry);
+
+        /**
+         * @brief Drops the entries and moves the floor to now (mutex held).
+         */
+        void reset();
+
+        /**
+         * @brief Moves the floor to a key if it is newer.
+         * @param key The key.
+         */
+        void raiseFloor(const Key& key);
+
+        /**
+         * @brief Gets the key of an entry.
+         * @param entry The entry.
+         * @return Key Timestamp key.
+         */
+        Key keyOf(const LogEntry& entry) const;
+
+        /**
+         * @brief Gets the key of the current time.
+         * @return Key Timestamp key.
+         */
+        Key nowKey() const;
+
+        size_t capacity; /**< Maximum number of cached entries. */
+        std::string logsTableName; /**< Log table name. */
+        DataBaseType databaseType; /**< Database of the table. */
+        TimestampFormat timestampFormat; /**< Timestamp column format. */
+        bool binaryText; /**< The database compares text by bytes (not MySQL collations). */
+
+        mutable std::shared_mutex mutex; /**< Guards the members below. */
+        std::deque<LogEntry> entries; /**< Cached entries in ID order. */
+        Key floor; /**< Newest timestamp that may be missing from the cache. */
+        std::optional<int64_t> lastId; /**< ID of the last written row, unknown until the first match. */
+#ifdef SQLG_USE_SOURCE_INFO
+        SourceResolver sourceResolver; /**< Source lookup. */
+        std::unordered_map<int, std::optional<SourceInfo>> sources; /**< Resolved sources. */
+#endif
+
+        mutable std::atomic<uint64_t> hits{ 0 }; /**< Queries answered by find(). */
+        mutable std::atomic<uint64_t> misses{ 0 }; /**< Queries passed to the database. */
+};
+
+#endif // LOG_TAIL_CACHE_H
@@ -0,0 +1,218 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_THROTTLE_H
+#define LOG_THROTTLE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "sqlogger/log_entry.h"
+
+#define LOG_THROTTLE_SHARDS 16 /**< Call-site map shards, each with its own mutex. */
+#define LOG_THROTTLE_LEVELS 6 /**< Number of log levels (Trace ... Fatal) with a rate limit window. */
+#define LOG_THROTTLE_REPEAT_MESSAGE "Last message repeated " /**< Prefix of the repeat count entry. */
+
+/**
+ * @class LogThrottle
+ * @brief Ingest-side sampling, rate limiting and duplicate suppression of SQLogger::logAdd().
+ * Entries are checked in this order:
+ * - an entry identical to the previous one of its call site (file:line) within the
+ *   dedup window is counted; the count is logged as one "Last message repeated N times"
+ *   entry when the site logs again after the window or something else, or on takeRepeats();
+ * - entries below the sample level are kept with the sample rate probability;
+ * - at most perLevel entries per second of each level and perSite entries per second of
+ *   each call site are kept.
+ * Call sites are spread over LOG_THROTTLE_SHARDS mutexes, so concurrent log calls from
+ * different sites rarely contend.
+ */
+class LogThrottle
+{
+    public:
+        /**
+         * @enum Verdict
+         * @brief Result of admit().
+         */
+        enum class Verdict
+        {
+            Accept,      /**< Log the entry. */
+            Sampled,     /**< Dropped by sampling. */
+            RateLimited, /**< Dropped by a rate limit. */
+            Repeated     /**< Folded into the repeat count of its call site. */
+        };
+
+        /**
+         * @struct Repeat
+         * @brief Pending repeat count of a call site.
+         */
+        struct Repeat
+        {
+            LogLevel level = LogLevel::Unknown; /**< Level of the repeated message. */
+            std::string function; /**< Function of the call site. */
+            std::string file; /**< File of the call site. */
+            int line = 0; /**< Line of the call site. */
+            uint64_t count = 0; /**< Repeats not yet logged. */
+
+            /**
+             * @brief Gets the text of the repeat count entry.
+             * @return std::string "Last message repeated N times".
+             */
+            std::string message() const
+            {
+                return LOG_THROTTLE_REPEAT_MESSAGE + std::to_string(count) + " times";
+            }
+        };
+
+        /**
+         * @struct Stats
+         * @brief Suppression counters.
+         */
+        struct Stats
+        {
+            uint64_t sampled = 0; /**< Entries dropped by sampling. */
+            uint64_t rateLimited = 0; /**< Entries dropped by a rate limit. */
+            uint64_t repeated = 0; /**< Entries folded into a repeat count. */
+        };
+
+        /**
+         * @brief Constructs a throttle.
+         * @param sampleRate Probability of keeping an entry below sampleLevel (1 = keep all).
+         * @param sampleLevel Entries below this level are sampled.
+         * @param perSite Entries per second kept for each call site (0 = unlimited).
+         * @param perLevel Entries per second kept for each level (0 = unlimited).
+         * @param dedupWindow Window in which identical entries of a call site are folded (0 = disabled).
+         */
+        LogThrottle(const double sampleRate, const LogLevel sampleLevel,
+                    const size_t perSite, const size_t perLevel,
+                    const std::chrono::milliseconds& dedupWindow);
+
+        LogThrottle(const LogThrottle&) = delete;
+        LogThrottle& operator=(const LogThrottle&) = delete;
+
+        /**
+         * @brief Decides whether an entry is logged.
+         * @param level The severity level.
+         * @param message The message (or format string).
+         * @param args Packed format arguments (compared together with the message).
+         * @param function The calling function.
+         * @param file The calling file.
+         * @param line The calling line.
+         * @param repeat Set to the pending repeat count of the call site when it must be logged
+         * before the entry (the entry itself may still be dropped).
+         * @return Verdict Accept if the entry is logged.
+         */
+        Verdict admit(const LogLevel level, std::string_view message, std::string_view args,
+                      std::string_view function, std::string_view file, const int line,
+                      std::optional<Repeat>& repeat);
+
+        /**
+         * @brief Takes the pending repeat counts of every call site (e.g. on flush).
+         * @return std::vector<Repeat> Repeat counts to log.
+         */
+        std::vector<Repeat> takeRepeats();
+
+        /**
+         * @brief Gets the suppression counters.
+         * @return Stats Counters.
+         */
+        Stats getStats() const;
+
+        /**
+         * @brief Resets the suppression counters.
+         */
+        void resetStats();
+
+    private:
+        /**
+         * @struct Site
+         * @brief State of one call site.
+         */
+        struct Site
+        {
+            std::string file; /**< Call site file (tells sites with the same hash apart). */
+            int line = 0; /**< Call site line. */
+            std::string function; /**< Function of the last message. */
+            std::string message; /**< Last message and its packed arguments. */
+            LogLevel level = LogLevel::Unknown; /**< Level of the last message. */
+            std::chrono::steady_clock::time_point dedupStart; /**< Time the last message was first seen. */
+            uint64_t repeats = 0; /**< Repeats of the last message not yet logged. */
+            std::chrono::steady_clock::time_point windowStart; /**< Start of the rate limit window. */
+            size_t windowCount = 0; /**< Entries kept in the rate limit window. */
+        };
+
+        /**
+         * @struct Shard
+         * @brief Call sites guarded by one mutex.
+         */
+        struct Shard
+        {
+            std::mutex mutex; /**< Guards sites. */
+            std::unordered_map<uint64_t, std::vector<Site>> sites; /**< Call sites by hash of file and line. */
+        };
+
+        /**
+         * @brief Finds or adds a call site (shard mutex held).
+         * @param shard Shard of the site.
+         * @param key Hash of file and line.
+         * @param file The calling file.
+         * @param line The calling line.
+         * @return Site& Call site state.
+         */
+        static Site& getSite(Shard& shard, const uint64_t key, std::string_view file, const int line);
+
+        /**
+         * @brief Checks the sample rate.
+         * @param level The severity level.
+         * @return bool True if the entry is kept.
+         */
+        bool sample(const LogLevel level) const;
+
+        /**
+         * @brief Checks and counts the rate limit of a level.
+         * @param level The severity level.
+         * @param now Current time.
+         * @return bool True if the entry is kept.
+         */
+        bool admitLevel(const LogLevel level, const std::chrono::steady_clock::time_point& now);
+
+        double sampleRate; /**< Probability of keeping an entry below sampleLevel. */
+        LogLevel sampleLevel; /**< Entries below this level are sampled. */
+        size_t perSite; /**< Entries per second of each call site (0 = unlimited). */
+        size_t perLevel; /**< Entries per second of each level (0 = unlimited). */
+        std::chrono::milliseconds dedupWindow; /**< Duplicate folding window (0 = disabled). */
+
+        std::array<Shard, LOG_THROTTLE_SHARDS> shards; /**< Call sites. */
+
+        std::mutex levelMutex; /**< Guards the level windows. */
+        std::array<std::chrono::steady_clock::time_point, LOG_THROTTLE_LEVELS> levelStart{}; /**< Start of each level window. */
+        std::array<size_t, LOG_THROTTLE_LEVELS> levelCount{}; /**< Entries kept in each level window. */
+
+        std::atomic<uint64_t> sampled{ 0 }; /**< See Stats::sampled. */
+        std::atomic<uint64_t> rateLimited{ 0 }; /**< See Stats::rateLimited. */
+        std::atomic<uint64_t> repeated{ 0 }; /**< See Stats::repeated. */
+};
+
+#endif // LOG_THROTTLE_H
@@ -20,11 +20,20 @@
 #ifndef LOG_WRITER_H
 #define LOG_WRITER_H
 
+#include <chrono>
+#include <memory>
 #include "sqlogger/log_entry.h"
+#include "sqlogger/internal/log_dictionary.h"
+#include "sqlogger/internal/log_message_compressor.h"
+#include "sqlogger/internal/log_partitions.h"
+#include "sqlogger/internal/log_tail_cache.h"
 #include "sqlogger/database/database_interface.h"
 #include "sqlogger/database/database_factory.h"
 #include "sqlogger/database/query_builder.h"
 
+#define LOG_GROUP_WRITE_SAVEPOINT "sqlg_write" /**< Savepoint around each write of an open group. */
+#define LOG_ATOMIC_SAVEPOINT "sqlg_atomic" /**< Savepoint around executeAtomically() inside an open group. */
+
 /**
  * @class LogWriter
  * @brief Class for writing log entries to a database.
@@ -54,6 +63,90 @@ class LogWriter
         */
         bool LogWriter::writeLogBatch(const LogEntryList& entries);
 
+        /**
+        * @brief Sets the tail cache that receives the written entries.
+        * A failed write, a rolled back group and a cleared table invalidate the cache.
+        * @param tailCache Tail cache (nullptr = disabled).
+        */
+        void setTailCache(std::shared_ptr<LogTailCache> tailCache);
+
+        /**
+        * @brief Compresses the message column (see LogMessageCompressor).
+        * Must be set before createLogsTable(), which creates the dictionary table.
+        * The tail cache still receives the uncompressed entries.
+        * @param messageCompressor Compressor of the log table (nullptr = plain messages).
+        */
+        void setMessageCompression(std::shared_ptr<LogMessageCompressor> messageCompressor);
+
+        /**
+        * @brief Enables group commit: consecutive batches are coalesced into one transaction.
+        * The transaction is committed after maxBatches batches, once window has elapsed since
+        * it was opened, or on commitPending(). Each write runs under a savepoint, so a failed
+        * batch rolls back only itself; if the group itself is lost (e.g. a failed commit)
+        * its writes are written again one by one, see takeLostEntries().
+        * @param maxBatches Number of batches per transaction (0 or 1 disables group commit).
+        * @param window Maximum transaction age (0 = no time limit).
+        * @warning While a group is open the connection holds the write lock (SQLite).
+        */
+        void setGroupCommit(const size_t maxBatches, const std::chrono::milliseconds window);
+
+        /**
+        * @brief Enables the native bulk-load path for large batches.
+        * Batches with at least threshold entries are written with IDatabase::bulkInsert()
+        * (COPY / LOAD DATA) if the backend supports it, smaller ones with a batch INSERT.
+        * @param threshold Minimum batch size for bulk load (0 = disabled).
+        */
+        void setBulkLoadThreshold(const size_t threshold);
+
+        /**
+        * @brief Sets the timestamp column format used by createLogsTable() and the inserts.
+        * With TimestampFormat::EpochMicros LogEntry::timestampUs is stored and LogEntry::timestamp is ignored.
+        * @param format Timestamp format (must match an existing table).
+        */
+        void setTimestampFormat(const TimestampFormat format);
+
+        /**
+        * @brief Selects the compact schema used by createLogsTable() and the inserts.
+        * The level is stored as an integer (LogHelper::levelToInt()) and function, file
+        * and thread ID as ids into dictionary tables, resolved through the shared cache.
+        * @param dictionaries Dictionaries of the log table (nullptr = standard schema).
+        */
+        void setCompactSchema(std::shared_ptr<LogDictionaries> dictionaries);
+
+        /**
+        * @brief Splits the log table into daily partitions (see LogPartitions).
+        * Must be set before createLogsTable(). Partitions are created for today and tomorrow,
+        * then ahead of the writes, which also drop the partitions expired by the retention policy.
+        * @param partitions Partitions of the log table (nullptr = plain table).
+        */
+        void setPartitions(std::shared_ptr<LogPartitions> partitions);
+
+        /**
+        * @brief Drops the partitions expired by the retention policy, with all their rows.
+        * @return size_t Number of dropped partitions.
+        */
+        size_t dropExpiredPartitions();
+
+        /**
+        * @brief Commits the open group transaction.
+        * @param force If false, commits only when the group window has elapsed.
+        * @return bool True if nothing was pending, the commit succeeded or the writes of the failed group were written again.
+        */
+        bool commitPending(const bool force = true);
+
+        /**
+        * @brief Gets the time left before the open group transaction must be committed.
+        * @return std::chrono::milliseconds Remaining time, or the full window if no group is open.
+        */
+        std::chrono::milliseconds getGroupCommitRemaining() const;
+
+        /**
+        * @brief Gets and resets the number of entries lost with a rolled back group.
+        * They were reported written, then could not be written again after the rollback.
+        * @return size_t Lost entries since the last call.
+        */
+        size_t takeLostEntries();
+
         /**
          * @brief Clears all log entries from the database.
          */
@@ -72,9 +165,41 @@ class LogWriter
         void createLogsTable();
 
         /**
-         * @brief Creates indexes on the log table for faster queries.
+         * @brief Creates the sources table (with source info), the log table and, unless deferred, the indexes.
+         * The layout is recorded in SCHEMA_TABLE_NAME once everything exists; a later start with the
+         * same layout reads that marker instead of probing every table and index.
+         * Must be called after the schema setters (timestamp format, compact schema, indexes, partitions, full-text search).
+         * @param withIndexes False to leave the indexes to a later createIndexes() (Config::deferIndexes).
+         * @return bool True if every index exists afterwards (always true if withIndexes is false).
+         */
+        bool createSchema(const bool withIndexes);
+
+        /**
+         * @brief Creates the configured indexes on the log table (and the source table indexes).
+         * Existing indexes are kept; only MySQL, which lacks CREATE INDEX IF NOT EXISTS, queries for them first.
+         * @return bool True if every index exists afterwards.
+         */
+        bool createIndexes();
+
+        /**
+         * @brief Drops the configured log table indexes, e.g. before a bulk load.
+         * @return bool True if every index was dropped or did not exist.
          */
-        void createIndexes();
+        bool dropIndexes();
+
+        /**
+         * @brief Sets the log table indexes created by createIndexes() and dropped by dropIndexes().
+         * @param indexes Indexes, each a list of columns (empty = no secondary indexes).
+         */
+        void setIndexes(const std::vector<LogIndex> & indexes);
+
+        /**
+         * @brief Adds a full-text index on the message column to the indexes of createIndexes() and dropIndexes().
+         * SQLite uses an FTS5 table kept in sync by triggers, PostgreSQL a GIN index, MySQL a FULLTEXT index;
+         * rows written before the index existed are indexed too. Not supported with SQLite partitions.
+         * @param enabled True to create the full-text index.
+         */
+        void setFullTextSearch(const bool enabled);
 
 #ifdef SQLG_USE_SOURCE_INFO
         /**
@@ -93,11 +218,296 @@ class LogWriter
         * @return The ID of the newly added source, or SOURCE_NOT_FOUND if the operation failed.
         */
         int LogWriter::addSource(const std::string& name, const std::string& uuid = "");
+
+        /**
+        * @brief Adds a source, or gets the stored one with the same UUID, in one round trip.
+        * @param name The name of the source (kept as stored if the UUID exists).
+        * @param uuid The UUID of the source.
+        * @return std::optional<SourceInfo> The stored source, or std::nullopt if the database has no
+        * INSERT ... RETURNING (or it failed); use getSourceByUuid() and addSource() then.
+        */
+        std::optional<SourceInfo> LogWriter::registerSource(const std::string& name, const std::string& uuid);
 #endif
 
     private:
+        /**
+         * @brief Gets the log table columns written by the inserts, in parameter order.
+         * @return const std::vector<std::string>& Column names.
+         */
+        static const std::vector<std::string> & getInsertFields();
+
+        /**
+         * @brief Inserts a log entry.
+         * @param entry The log entry to write.
+         * @param table Target table (the log table or a SQLite partition table).
+         * @return True if the log entry was written successfully, false otherwise.
+         */
+        bool insertLog(const LogEntry& entry, const std::string& table);
+
+        /**
+         * @brief Inserts a batch of log entries (batch INSERT or bulk load).
+         * @param entries List of log entries to insert.
+         * @param table Target table (the log table or a SQLite partition table).
+         * @return bool True if the batch insert succeeded, false otherwise.
+         */
+        bool insertLogBatch(const LogEntryList& entries, const std::string& table);
+
+        /**
+         * @brief Inserts stored (compressed) entries into the log table or their partitions.
+         * @param entries List of log entries to insert.
+         * @return bool True if the insert succeeded, false otherwise.
+         */
+        bool insertEntries(const LogEntryList& entries);
+
+        /**
+         * @brief Inserts a batch of log entries into their partitions.
+         * On SQLite every run of entries of the same day is a separate insert, and
+         * several runs are written in one transaction unless a group is open.
+         * @param entries List of log entries to insert.
+         * @return bool True if the batch insert succeeded, false otherwise.
+         */
+        bool insertPartitionedBatch(const LogEntryList& entries);
+
+        /**
+         * @brief Makes sure the partition of a day exists before writing to it.
+         * Writing to the newest partition creates the next one and applies the retention policy.
+         * @param day Day as YYYYMMDD.
+         * @return bool True if the partition exists.
+         */
+        bool preparePartition(const int day);
+
+        /**
+         * @brief Gets the table the entries of a day are inserted into.
+         * On SQLite switching to another partition table synchronizes its ID sequence first.
+         * @param day Day as YYYYMMDD.
+         * @return std::string Partition table (SQLite) or log table, empty if the sequence could not be synchronized.
+         */
+        std::string getPartitionTable(const int day);
+
+        /**
+         * @brief Creates the partition of a day.
+         * @param day Day as YYYYMMDD.
+         * @return bool True if the partition exists afterwards.
+         */
+        bool createPartition(const int day);
+
+        /**
+         * @brief Creates the partitions of today and tomorrow if missing.
+         * @return bool True if both exist afterwards.
+         */
+        bool createCurrentPartitions();
+
+        /**
+         * @brief Drops partitions with all their rows (the newest is never dropped).
+         * @param days Days of the partitions.
+         * @return size_t Number of dropped partitions.
+         */
+        size_t dropPartitions(const std::vector<int> & days);
+
+        /**
+         * @brief Reloads the partitions from the database.
+         */
+        void loadPartitions();
+
+        /**
+         * @brief Gets the statements recreating the SQLite view over the partition tables.
+         * @param days Days of the partitions in the view.
+         * @return std::vector<std::string> DROP VIEW and CREATE VIEW statements.
+         */
+        std::vector<std::string> getPartitionViewStatements(const std::vector<int> & days) const;
+
+        /**
+         * @brief Moves the SQLite ID sequence of a partition table past every ID assigned so far.
+         * Each table has its own AUTOINCREMENT sequence, so IDs stay unique and ascending across partitions.
+         * @param table Partition table name.
+         * @return bool True if the sequence was updated.
+         */
+        bool syncPartitionSequence(const std::string& table);
+
+        /**
+         * @brief Gets the highest AUTOINCREMENT sequence value of the SQLite partition tables.
+         * @return int64_t Highest sequence value (0 if nothing was written yet).
+         */
+        int64_t getPartitionSequence();
+
+        /**
+         * @brief Executes statements in one transaction (as part of the open group, if any).
+         * @param statements Statements to execute.
+         * @return bool True if every statement succeeded.
+         */
+        bool executeAtomically(const std::vector<std::string> & statements);
+
+        /**
+         * @brief Builds the definition of the log table or of a SQLite partition table.
+         * @param tableName Table name.
+         * @return DatabaseSchema::TableBuilder::BuiltTable Table definition.
+         */
+        DatabaseSchema::TableBuilder::BuiltTable buildLogsTable(const std::string& tableName) const;
+
+        /**
+         * @brief Gets the tables holding the log table indexes.
+         * @return std::vector<std::string> The SQLite partition tables, or the log table.
+         */
+        std::vector<std::string> getIndexedTables() const;
+
+        /**
+         * @brief Gets the statements creating the configured indexes on a table.
+         * @param table Table name.
+         * @return std::vector<std::string> CREATE INDEX statements of the missing indexes.
+         */
+        std::vector<std::string> getCreateIndexStatements(const std::string& table);
+
+        /**
+        * @brief Passes a write to the tail cache.
+        * @param entries The entries of the write.
+        * @param written Whether the write succeeded.
+        */
+        void cacheWritten(const LogEntryList& entries, const bool written);
+
+        /**
+         * @struct CompactColumns
+         * @brief Encoded column values of an entry in the compact schema.
+         */
+        struct CompactColumns
+        {
+            int level; /**< Level as an integer. */
+            int64_t function; /**< Function dictionary id. */
+            int64_t file; /**< File dictionary id. */
+            int64_t threadId; /**< Thread ID dictionary id. */
+        };
+
+        /**
+        * @brief Encodes the level, function, file and thread ID of an entry.
+        * New values are added to the dictionary tables.
+        * @param entry The log entry.
+        * @return std::optional<CompactColumns> Encoded values, or std::nullopt if a dictionary insert failed.
+        */
+        std::optional<CompactColumns> toCompactColumns(const LogEntry& entry);
+
+        /**
+        * @brief Gets the name of a log table index.
+        * Indexes of the default table keep the plain idx_<columns> names, other tables
+        * include the table name, since index names are shared by the whole database.
+        * @param index Index columns.
+        * @param table Indexed table (the log table or a SQLite partition table).
+        * @return std::string Index name.
+        */
+        std::string getIndexName(const LogIndex& index, const std::string& table) const;
+
+        /**
+        * @brief Gets the schema version marker of the current layout.
+        * @return std::string Marker text (schema version, layout, timestamp format, partitioning, indexes).
+        */
+        std::string getSchemaSignature() const;
+
+        /**
+        * @brief Reads the schema version marker of the log table.
+        * @return std::string Stored marker, or an empty string if missing (or a schema table is missing).
+        */
+        std::string loadSchemaVersion();
+
+        /**
+        * @brief Replaces the schema version marker of the log table.
+        * @param signature Marker text (empty = only remove the stored marker).
+        */
+        void storeSchemaVersion(const std::string& signature);
+
+        /**
+        * @brief Checks if an index exists (MySQL only, other backends use IF [NOT] EXISTS).
+        * @param indexName Index name.
+        * @return bool True if the index exists.
+        */
+        bool indexExists(const std::string& indexName);
+
+        /**
+        * @brief Creates the full-text index on the message column if it does not exist.
+        * @return bool True if the index exists afterwards.
+        */
+        bool createFullTextIndex();
+
+        /**
+        * @brief Drops the full-text index on the message column.
+        * @return bool True if the index was dropped or did not exist.
+        */
+        bool dropFullTextIndex();
+
+        /**
+        * @brief Rolls back the open group transaction.
+        * Dictionary ids cached during the group are dropped along with it.
+        */
+        void rollbackGroup();
+
+        /**
+        * @brief Drops the cached state a rollback may have invalidated
+        * (dictionary ids, message dictionaries, partitions and the tail cache).
+        */
+        void resetCaches();
+
+        /**
+        * @brief Starts a write inside the group transaction.
+        * Sets a savepoint, so a failed write rolls back only itself.
+        * @param open Whether a group is opened if none is open.
+        * @return bool True if the write runs in the group, false if it runs on its own.
+        */
+        bool beginGroupWrite(const bool open);
+
+        /**
+        * @brief Ends a write started with beginGroupWrite().
+        * A failed write is rolled back to its savepoint, the writes before it stay in the group.
+        * @param entries The entries of the write (uncompressed).
+        * @param written Whether the write succeeded.
+        * @param batch Whether the write counts as a group batch (and may commit the group).
+        * @return bool True if the write is in the group (or committed), false otherwise.
+        */
+        bool endGroupWrite(const LogEntryList& entries, const bool written, const bool batch);
+
+        /**
+        * @brief Checks whether the group window has elapsed since the open group was started.
+        * @return bool True if the open group must be committed.
+        */
+        bool isCommitDue() const;
+
+        /**
+        * @brief Rolls back to a savepoint and releases it.
+        * @param name Savepoint name.
+        * @return bool True if the transaction is usable again.
+        */
+        bool rollbackToSavepoint(const std::string& name);
+
+        /**
+        * @brief Rolls back the open group and writes its writes again, each on its own.
+        * Entries that still cannot be written are counted by takeLostEntries().
+        * @return bool True if every write of the group was written again.
+        */
+        bool recoverGroup();
+
         IDatabase& database; /**< The database interface used for writing logs. */
         std::string logsTableName;
+
+        size_t bulkLoadThreshold = 0; /**< Minimum batch size written with bulkInsert() (0 = disabled). */
+        TimestampFormat timestampFormat = TimestampFormat::Text; /**< Timestamp column format. */
+        std::shared_ptr<LogDictionaries> dictionaries; /**< Dictionaries of the compact schema (nullptr = standard schema). */
+        std::shared_ptr<LogTailCache> tailCache; /**< Receives the written entries (nullptr = disabled). */
+        std::shared_ptr<LogMessageCompressor> messageCompressor; /**< Compressor of the message column (nullptr = plain messages). */
+        std::shared_ptr<LogPartitions> partitions; /**< Daily partitions of the log table (nullptr = plain table). */
+        bool indexesEnabled = false; /**< Whether new SQLite partition tables get the indexes (set by createIndexes()). */
+        bool fullTextSearch = false; /**< Whether createIndexes() creates the full-text index. */
+        std::vector<LogIndex> indexes = /**< Log table indexes. */
+        {
+            { FIELD_LOG_TIMESTAMP },
+            { FIELD_LOG_LEVEL },
+            { FIELD_LOG_FILE },
+            { FIELD_LOG_THREAD_ID },
+            { FIELD_LOG_FUNCTION }
+        };
+
+        size_t groupCommitBatches = 0; /**< Batches per group transaction (0/1 = disabled). */
+        std::chrono::milliseconds groupCommitWindow{ 0 }; /**< Maximum group transaction age. */
+        bool groupOpen = false; /**< Whether a group transaction is open. */
+        size_t groupBatches = 0; /**< Batches written in the open group. */
+        std::vector<LogEntryList> groupWrites; /**< Uncompressed entries of each write in the open group, for recoverGroup(). */
+        size_t lostEntries = 0; /**< Entries lost with a rolled back group (see takeLostEntries()). */
+        std::chrono::steady_clock::time_point groupStart; /**< When the open group was started. */
 };
 
 #endif // LOG_WRITER_H
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#define MPSC_RING_CACHE_LINE 64 /**< Cache line size used to separate producer and consumer indices. */
+
+/**
+ * @class MPSCRing
+ * @brief Bounded lock-free multi-producer/single-consumer ring buffer.
+ * Each slot carries a sequence number, so producers claim a slot with a single
+ * CAS on the tail index and the consumer never contends with them on a lock.
+ * @tparam T Element type (must be default constructible and movable).
+ * @note Capacity is rounded up to the next power of two.
+ */
+template <typename T>
+class MPSCRing
+{
+    public:
+        /**
+         * @brief Constructs a ring with at least the given capacity.
+         * @param capacity Minimum number of elements the ring can hold.
+         */
+        explicit MPSCRing(size_t capacity)
+            : mask(roundUpPow2(capacity) - 1),
+              slots(new Slot[mask + 1]),
+              head(0),
+              tail(0)
+        {
+            for(size_t i = 0; i <= mask; ++i)
+            {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MPSCRing(const MPSCRing&) = delete;
+        MPSCRing& operator=(const MPSCRing&) = delete;
+
+        /**
+         * @brief Tries to push an element (any producer thread).
+         * @param value Element to move into the ring.
+         * @return True if the element was stored, false if the ring is full.
+         */
+        bool tryPush(T&& value)
+        {
+            size_t pos = tail.load(std::memory_order_relaxed);
+            while(true)
+            {
+                Slot& slot = slots[pos & mask];
+                const size_t seq = slot.sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                if(diff == 0)
+                {
+                    if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        slot.value = std::move(value);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if(diff < 0)
+                {
+                    return false; // Full
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Tries to pop an element (single consumer thread only).
+         * @param value Receives the popped element.
+         * @return True if an element was popped, false if the ring is empty.
+         */
+        bool tryPop(T& value)
+        {
+            const size_t pos = head.load(std::memory_order_relaxed);
+            Slot& slot = slots[pos & mask];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+            if(static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0)
+            {
+                return false; // Empty
+            }
+
+            value = std::move(slot.value);
+            slot.sequence.store(pos + mask + 1, std::memory_order_release);
+            head.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Gets the approximate number of stored elements.
+         * @return Element count (may be stale while producers are active).
+         */
+        size_t size() const
+        {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            const size_t h = head.load(std::memory_order_relaxed);
+            return t >= h ? t - h : 0;
+        }
+
+        /**
+         * @brief Gets the ring capacity.
+         * @return Maximum number of elements.
+         */
+        size_t capacity() const
+        {
+            return mask + 1;
+        }
+
+    private:
+        /**
+         * @struct Slot
+         * @brief Ring slot with its sequence number.
+         */
+        struct Slot
+        {
+            std::atomic<size_t> sequence; /**< Slot sequence (ready for write when == pos, ready for read when == pos + 1). */
+            T value; /**< Stored element. */
+        };
+
+        /**
+         * @brief Rounds a value up to the next power of two.
+         * @param value Value to round (0 and 1 give 2).
+         * @return Power of two >= value.
+         */
+        static size_t roundUpPow2(size_t value)
+        {
+            size_t result = 2;
+            while(result < value)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        const size_t mask; /**< Capacity - 1. */
+        std::unique_ptr<Slot[]> slots; /**< Slot storage. */
+
+        alignas(MPSC_RING_CACHE_LINE) std::atomic<size_t> head; /**< Consumer index. */
+        alignas(MPSC_RING_CACHE_LINE) std::atomic<size_t> tail; /**< Producer index. */
+};
+
+#endif // MPSC_RING_H
@@ -0,0 +1,257 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef SINK_QUEUE_H
+#define SINK_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/log_sink.h"
+#include "sqlogger/internal/thread_helper.h"
+
+/**
+ * @class SinkQueue
+ * @brief Bounded queue and writer thread of one ILogSink.
+ * A log call only copies its item into the queue (the writer is woken when the queue was
+ * empty); the writer takes the whole queue at once, converts the items to entries and
+ * writes them in one ILogSink::write() call, so batches grow with the load. A full queue
+ * drops new items instead of blocking the log call.
+ * @tparam T Queued item type (converted to a LogEntry on the writer thread).
+ */
+template <typename T>
+class SinkQueue
+{
+    public:
+        /// Converts a queued item to the entry handed to the sink
+        using Converter = std::function<LogEntry(T&&)>;
+
+        /**
+         * @struct Stats
+         * @brief Counters of a sink queue.
+         */
+        struct Stats
+        {
+            uint64_t written = 0; /**< Entries written by the sink. */
+            uint64_t dropped = 0; /**< Entries dropped by a full queue or a failed write. */
+        };
+
+        /**
+         * @brief Constructs the queue and starts its writer thread.
+         * @param sink The sink.
+         * @param capacity Maximum number of queued items.
+         * @param convert Item to entry conversion (runs on the writer thread).
+         * @param settings Affinity and priority of the writer thread (it always blocks while idle).
+         */
+        SinkQueue(std::shared_ptr<ILogSink> sink, const size_t capacity, Converter convert,
+                  const ThreadHelper::Settings& settings = ThreadHelper::Settings())
+            : sink(std::move(sink)), capacity(capacity), convert(std::move(convert)), settings(settings)
+        {
+            writer = std::thread( & SinkQueue::writerLoop, this);
+        }
+
+        /**
+         * @brief Writes the queued items and stops the writer thread.
+         */
+        ~SinkQueue()
+        {
+            stop();
+        }
+
+        SinkQueue(const SinkQueue&) = delete;
+        SinkQueue& operator=(const SinkQueue&) = delete;
+
+        /**
+         * @brief Queues a copy of an item.
+         * @param item Item to queue.
+         * @return bool False if the queue is full or stopped (the item is counted as dropped).
+         */
+        bool push(const T& item)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if(stopping || items.size() >= capacity)
+            {
+                ++stats.dropped;
+                return false;
+            }
+
+            const bool wake = items.empty();
+            items.push_back(item);
+            lock.unlock();
+
+            // A non-empty queue is taken by the writer before it waits again
+            if(wake)
+            {
+                ready.notify_one();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Waits until the items queued so far have been written and flushed.
+         * @param timeout The maximum time to wait.
+         * @return bool True if the queue ran empty within the timeout.
+         */
+        bool waitUntilEmpty(const std::chrono::milliseconds& timeout)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return idle.wait_for(lock, timeout, [this]
+            {
+                return items.empty() && !busy;
+            });
+        }
+
+        /**
+         * @brief Writes the queued items and stops the writer thread (later pushes are dropped).
+         */
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_one();
+
+            if(writer.joinable())
+            {
+                writer.join();
+            }
+        }
+
+        /**
+         * @brief Gets the counters.
+         * @return Stats Counters.
+         */
+        Stats getStats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return stats;
+        }
+
+        /**
+         * @brief Resets the counters.
+         */
+        void resetStats()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats = Stats();
+        }
+
+        /**
+         * @brief Gets the sink.
+         * @return const std::shared_ptr<ILogSink>& Sink.
+         */
+        const std::shared_ptr<ILogSink> & getSink() const
+        {
+            return sink;
+        }
+
+    private:
+        /**
+         * @brief Writer thread body.
+         */
+        void writerLoop()
+        {
+            // Errors are reported by the logger's own threads, which apply the same settings
+            std::string errMsg;
+            ThreadHelper::apply(settings, errMsg);
+
+            std::vector<T> taken;
+            LogEntryList entries;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while(true)
+            {
+                ready.wait(lock, [this]
+                {
+                    return stopping || !items.empty();
+                });
+                if(items.empty())
+                {
+                    break;
+                }
+
+                // Both buffers keep their capacity
+                taken.swap(items);
+                busy = true;
+                lock.unlock();
+
+                entries.clear();
+                entries.reserve(taken.size());
+                for(auto & item : taken)
+                {
+                    entries.push_back(convert(std::move(item)));
+                }
+                taken.clear();
+
+                bool written = false;
+                try
+                {
+                    written = sink->write(entries);
+                }
+                catch(const std::exception&)
+                {
+                    written = false;
+                }
+
+                lock.lock();
+                const bool drained = items.empty();
+                lock.unlock();
+                if(drained)
+                {
+                    sink->flush();
+                }
+
+                lock.lock();
+                (written ? stats.written : stats.dropped) += entries.size();
+                busy = false;
+                idle.notify_all();
+            }
+            lock.unlock();
+
+            sink->flush();
+            idle.notify_all();
+        }
+
+        std::shared_ptr<ILogSink> sink; /**< The sink. */
+        size_t capacity; /**< Maximum number of queued items. */
+        Converter convert; /**< Item to entry conversion. */
+        ThreadHelper::Settings settings; /**< Writer thread affinity and priority. */
+
+        mutable std::mutex mutex; /**< Guards items, busy, stopping and stats. */
+        std::condition_variable ready; /**< Signals queued items or stop(). */
+        std::condition_variable idle; /**< Signals a finished write. */
+        std::vector<T> items; /**< Queued items. */
+        bool busy = false; /**< The writer holds taken items. */
+        bool stopping = false; /**< Set by stop(). */
+        Stats stats; /**< Counters. */
+        std::thread writer; /**< Writer thread. */
+};
+
+#endif // SINK_QUEUE_H
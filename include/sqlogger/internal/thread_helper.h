@@ -0,0 +1,97 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef THREAD_HELPER_H
+#define THREAD_HELPER_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#define THREAD_HELPER_HYBRID_SPIN_US 50 /**< Time a WaitStrategy::Hybrid thread spins before it blocks (microseconds). */
+#define THREAD_HELPER_PRIORITY_MIN -20 /**< Highest thread priority (nice value). */
+#define THREAD_HELPER_PRIORITY_MAX 19 /**< Lowest thread priority (nice value). */
+
+/**
+ * @enum WaitStrategy
+ * @brief How an idle logger thread waits for work.
+ */
+enum class WaitStrategy
+{
+    Block, /**< Sleep on a condition variable (or timer) until woken. */
+    Spin, /**< Busy-spin while idle: lowest wake-up latency, one core per thread. */
+    Hybrid /**< Spin for THREAD_HELPER_HYBRID_SPIN_US, then block. */
+};
+
+/**
+ * @namespace ThreadHelper
+ * @brief Placement of the logger's own threads (CPU affinity, priority and idle wait).
+ */
+namespace ThreadHelper
+{
+    /**
+     * @struct Settings
+     * @brief Settings applied by every logger thread when it starts.
+     */
+    struct Settings
+    {
+        std::vector<int> cpus; /**< CPUs the thread may run on (empty = any). */
+        std::optional<int> priority; /**< Nice value (THREAD_HELPER_PRIORITY_MIN - THREAD_HELPER_PRIORITY_MAX, unset = inherited). */
+        WaitStrategy wait = WaitStrategy::Block; /**< Idle wait of the thread pool workers and the ring writer. */
+    };
+
+    /**
+     * @brief Applies the affinity and priority of the settings to the calling thread.
+     * @param settings Settings to apply.
+     * @param errMsg[out] Error message of the first setting that could not be applied.
+     * @return bool True if every setting was applied.
+     */
+    bool apply(const Settings& settings, std::string& errMsg);
+
+    /**
+     * @brief Restricts the calling thread to a set of CPUs.
+     * @param cpus CPU indexes (empty = no change).
+     * @param errMsg[out] Error message.
+     * @return bool True on success, false if the call failed or the platform has no affinity API.
+     */
+    bool setAffinity(const std::vector<int> & cpus, std::string& errMsg);
+
+    /**
+     * @brief Gets the CPUs the calling thread may run on.
+     * @return std::vector<int> CPU indexes (empty if the platform has no affinity API).
+     */
+    std::vector<int> getAffinity();
+
+    /**
+     * @brief Sets the priority of the calling thread.
+     * Linux sets the thread's nice value (raising it requires CAP_SYS_NICE), Windows maps
+     * it to the nearest thread priority class.
+     * @param priority Nice value (THREAD_HELPER_PRIORITY_MIN - THREAD_HELPER_PRIORITY_MAX).
+     * @param errMsg[out] Error message.
+     * @return bool True on success, false if the call failed or the platform has no per-thread priority.
+     */
+    bool setPriority(const int priority, std::string& errMsg);
+
+    /**
+     * @brief Hints the CPU that the calling thread is spinning.
+     */
+    void relax();
+};
+
+#endif // THREAD_HELPER_H
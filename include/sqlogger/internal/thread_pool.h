@@ -21,43 +21,229 @@
 #define THREAD_POOL_H
 
 #include <vector>
+#include <deque>
 #include <thread>
-#include <queue>
-#include <functional>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "sqlogger/internal/thread_helper.h"
+
+#define THREAD_POOL_TASK_INLINE_SIZE 64 /**< Callables up to this size are stored in the task itself (no allocation). */
+#define THREAD_POOL_CACHE_LINE 64 /**< Cache line size used to separate per-worker queues. */
 
 /**
  * @class ThreadPool
- * @brief A thread pool for managing and executing tasks concurrently.
+ * @brief A work-stealing thread pool for managing and executing tasks concurrently.
+ * Every worker owns a task deque; tasks are spread over the deques round-robin
+ * (or pushed to the caller's own deque when enqueued from a worker), and an idle
+ * worker steals from the other deques. Tasks are taken in FIFO order, so a
+ * single worker runs them in enqueue order.
+ * Workers apply ThreadHelper::Settings (affinity, priority) when they start and
+ * wait for tasks with its WaitStrategy.
  */
 class ThreadPool
 {
     public:
+        /**
+         * @class Task
+         * @brief Move-only type-erased callable with small-buffer storage.
+         * Replaces std::function: move-only captures are allowed and callables
+         * up to THREAD_POOL_TASK_INLINE_SIZE bytes are stored without allocation.
+         */
+        class Task
+        {
+            public:
+                Task() = default;
+
+                /**
+                 * @brief Constructs a task from a callable.
+                 * @param fn Callable taking no arguments.
+                 */
+                template <class F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+                Task(F&& fn)
+                {
+                    using Fn = std::decay_t<F>;
+                    if constexpr(isInline<Fn>())
+                    {
+                        new(storage) Fn(std::forward<F>(fn));
+                        ops = & Ops<Fn, true>::table;
+                    }
+                    else
+                    {
+                        * reinterpret_cast<Fn**>(storage) = new Fn(std::forward<F>(fn));
+                        ops = & Ops<Fn, false>::table;
+                    }
+                }
+
+                Task(Task&& other) noexcept
+                {
+                    moveFrom(other);
+                }
+
+                Task& operator=(Task&& other) noexcept
+                {
+                    if(this != & other)
+                    {
+                        reset();
+                        moveFrom(other);
+                    }
+                    return * this;
+                }
+
+                Task(const Task&) = delete;
+                Task& operator=(const Task&) = delete;
+
+                ~Task()
+                {
+                    reset();
+                }
+
+                /**
+                 * @brief Runs the stored callable.
+                 */
+                void operator()()
+                {
+                    ops->invoke(storage);
+                }
+
+                /**
+                 * @brief Checks if the task holds a callable.
+                 * @return True if not empty.
+                 */
+                explicit operator bool() const
+                {
+                    return ops != nullptr;
+                }
+
+            private:
+                /**
+                 * @struct OpsTable
+                 * @brief Type-erased operations of the stored callable.
+                 */
+                struct OpsTable
+                {
+                    void (*invoke)(unsigned char* storage); /**< Calls the callable. */
+                    void (*move)(unsigned char* dst, unsigned char* src) noexcept; /**< Moves the callable and destroys the source. */
+                    void (*destroy)(unsigned char* storage) noexcept; /**< Destroys the callable. */
+                };
+
+                /**
+                 * @brief Operations for a callable type.
+                 * @tparam Fn Callable type.
+                 * @tparam Inline True if stored in the buffer, false if heap-allocated.
+                 */
+                template <class Fn, bool Inline>
+                struct Ops
+                {
+                    static Fn* get(unsigned char* storage)
+                    {
+                        if constexpr(Inline)
+                        {
+                            return std::launder(reinterpret_cast<Fn*>(storage));
+                        }
+                        else
+                        {
+                            return * reinterpret_cast<Fn**>(storage);
+                        }
+                    }
+
+                    static void invoke(unsigned char* storage)
+                    {
+                        ( * get(storage))();
+                    }
+
+                    static void move(unsigned char* dst, unsigned char* src) noexcept
+                    {
+                        if constexpr(Inline)
+                        {
+                            new(dst) Fn(std::move( * get(src)));
+                            get(src)->~Fn();
+                        }
+                        else
+                        {
+                            * reinterpret_cast<Fn**>(dst) = get(src);
+                        }
+                    }
+
+                    static void destroy(unsigned char* storage) noexcept
+                    {
+                        if constexpr(Inline)
+                        {
+                            get(storage)->~Fn();
+                        }
+                        else
+                        {
+                            delete get(storage);
+                        }
+                    }
+
+                    static constexpr OpsTable table{ & invoke, & move, & destroy };
+                };
+
+                /**
+                 * @brief Checks if a callable type fits the inline buffer.
+                 * @tparam Fn Callable type.
+                 * @return True if stored inline.
+                 */
+                template <class Fn>
+                static constexpr bool isInline()
+                {
+                    return sizeof(Fn) <= THREAD_POOL_TASK_INLINE_SIZE
+                           && alignof(Fn) <= alignof(std::max_align_t)
+                           && std::is_nothrow_move_constructible_v<Fn>;
+                }
+
+                void moveFrom(Task& other) noexcept
+                {
+                    ops = other.ops;
+                    if(ops)
+                    {
+                        ops->move(storage, other.storage);
+                        other.ops = nullptr;
+                    }
+                }
+
+                void reset() noexcept
+                {
+                    if(ops)
+                    {
+                        ops->destroy(storage);
+                        ops = nullptr;
+                    }
+                }
+
+                alignas(std::max_align_t) unsigned char storage[THREAD_POOL_TASK_INLINE_SIZE]; /**< Inline callable or heap pointer. */
+                const OpsTable* ops = nullptr; /**< Operations of the stored callable (nullptr if empty). */
+        };
+
         /**
          * @brief Constructs a ThreadPool with the specified number of threads.
+         * Returns once every worker has applied the settings.
          * @param numThreads The number of threads in the pool.
+         * @param settings Affinity, priority and idle wait of the workers.
          */
-        ThreadPool(size_t numThreads);
+        ThreadPool(size_t numThreads, const ThreadHelper::Settings& settings = ThreadHelper::Settings());
 
         /**
-         * @brief Destructor for ThreadPool. Stops all threads.
+         * @brief Destructor for ThreadPool. Runs the queued tasks and stops all threads.
          */
         ~ThreadPool();
 
         /**
          * @brief Enqueues a task to be executed by the ThreadPool.
-         * @param task The task to be executed.
+         * @param task The task to be executed (move-only callables are allowed).
          */
         template <class F>
         void enqueue(F&& task)
         {
-            {
-                std::unique_lock<std::mutex> lock(queueMutex);
-                tasks.emplace(std::forward<F>(task));
-            }
-            condition.notify_one();
+            push(Task(std::forward<F>(task)));
         }
 
         /**
@@ -71,16 +257,68 @@ class ThreadPool
         */
         bool isQueueEmpty();
 
+        /**
+        * @brief Gets the error of a worker that could not apply the settings.
+        * @return std::string Error message (empty if every worker applied them).
+        */
+        std::string getSetupError() const;
+
     private:
+        /**
+         * @struct WorkerQueue
+         * @brief Task deque owned by one worker (other workers steal from it).
+         */
+        struct alignas(THREAD_POOL_CACHE_LINE) WorkerQueue
+        {
+            std::mutex mutex; /**< Protects tasks. */
+            std::deque<Task> tasks; /**< Queued tasks. */
+        };
+
+        /**
+         * @brief Pushes a task to a worker queue and wakes a worker.
+         * @param task The task to queue.
+         */
+        void push(Task&& task);
+
+        /**
+         * @brief Takes a task from the worker's own queue, or steals one from another queue.
+         * @param index The worker index.
+         * @param task Receives the task.
+         * @return True if a task was taken.
+         */
+        bool tryTake(size_t index, Task& task);
+
+        /**
+         * @brief Worker thread body.
+         * @param index The worker index.
+         */
+        void workerLoop(size_t index);
+
+        /**
+         * @brief Waits until a task is queued or the pool stops, as chosen by the wait strategy.
+         * @param idleSince Time the worker ran out of tasks.
+         * @return False if the pool stopped with no queued tasks (the worker must exit).
+         */
+        bool waitForTask(const std::chrono::steady_clock::time_point& idleSince);
+
+        ThreadHelper::Settings settings; /**< Worker affinity, priority and idle wait. */
+        std::vector<std::unique_ptr<WorkerQueue>> queues; /**< Per-worker task queues. */
         std::vector<std::thread> workers; /**< Worker threads. */
-        std::queue<std::function<void()>> tasks; /**< Task queue. */
 
-        std::mutex queueMutex; /**< Mutex for synchronizing access to the task queue. */
+        mutable std::mutex waitMutex; /**< Mutex for idle workers and completion waiters. */
         std::condition_variable condition; /**< Condition variable for task notification. */
-        std::condition_variable completionCondition;
+        std::condition_variable completionCondition; /**< Condition variable for completion notification. */
+        std::condition_variable startCondition; /**< Signals a worker that applied the settings. */
+        size_t startedWorkers = 0; /**< Workers that applied the settings (guarded by waitMutex). */
+        std::string setupError; /**< First settings error of a worker (guarded by waitMutex). */
 
         std::atomic<bool> stop; /**< Flag to stop the ThreadPool. */
-        std::atomic<size_t> tasksInProgress;
+        std::atomic<size_t> queuedTasks; /**< Tasks queued and not yet taken by a worker. */
+        std::atomic<size_t> tasksInProgress; /**< Tasks being executed. */
+        std::atomic<size_t> nextQueue; /**< Round-robin queue index for external enqueues. */
+
+        static thread_local ThreadPool* currentPool; /**< Pool of the current worker thread (nullptr outside workers). */
+        static thread_local size_t currentIndex; /**< Worker index of the current thread. */
 };
 
-#endif // THREAD_POOL_H
\ No newline at end of file
+#endif // THREAD_POOL_H
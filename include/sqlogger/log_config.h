@@ -27,6 +27,8 @@
 #include "sqlogger/log_helper.h"
 #include "sqlogger/database/database_helper.h"
 #include "sqlogger/log_crypto.h"
+#include "sqlogger/internal/log_export.h"
+#include "sqlogger/internal/thread_helper.h"
 #include "sqlogger/transport/transport_helper.h"
 
 // Defaults
@@ -35,24 +37,121 @@
 #define LOG_DEFAULT_SYNC_MODE 1 ///< Default synchronization mode (true for synchronous logging).
 #define LOG_DEFAULT_ONLY_FILE_NAMES 0 ///< Default whether to log only filenames (without full paths).
 constexpr LogLevel LOG_DEFAULT_MIN_LOG_LEVEL = LogLevel::Trace; ///< Default minimum log level for messages to be logged.
+#define LOG_DEFAULT_FLUSH_INTERVAL_MS 0 ///< Default maximum age of a partial batch before it is flushed (0 = disabled).
+#define LOG_DEFAULT_MAX_BATCH_BYTES 0 ///< Default batch buffer size in bytes that triggers a flush (0 = disabled).
+#define LOG_DEFAULT_ADAPTIVE_BATCH 0 ///< Default whether the batch size and flush interval are tuned at runtime.
+#define LOG_DEFAULT_TARGET_BATCH_LATENCY_MS 20 ///< Default target write latency of one batch for adaptive batching.
+#define LOG_DEFAULT_GROUP_COMMIT_BATCHES 0 ///< Default number of batches per group-commit transaction (0 = disabled).
+#define LOG_DEFAULT_GROUP_COMMIT_WINDOW_MS 0 ///< Default maximum group-commit transaction age (0 = no time limit).
+#define LOG_DEFAULT_BULK_LOAD_THRESHOLD 0 ///< Default minimum batch size written through the native bulk-load path (0 = disabled).
+#define LOG_DEFAULT_CONNECTION_POOL_SIZE 0 ///< Default number of pooled write connections for asynchronous mode (0 = single shared connection).
+#define LOG_DEFAULT_READ_POOL_SIZE 0 ///< Default number of pooled query connections (0 = queries use the write connection).
+#define LOG_DEFAULT_USE_RING 0 ///< Default whether to use the lock-free ingestion ring.
+#define LOG_DEFAULT_RING_CAPACITY 65536 ///< Default ingestion ring capacity (rounded up to a power of two).
+constexpr LogLevel LOG_DEFAULT_RING_DROP_LEVEL = LogLevel::Warning; ///< Default level below which messages are dropped by BackPressure::DropBelowLevel.
+#define LOG_DEFAULT_SPOOL_MAX_BYTES (256LL << 20) ///< Default maximum size of the local spool file (0 = unlimited).
+#define LOG_DEFAULT_SPOOL_RETRY_MS 500 ///< Default delay before the spool is replayed again after a failed write.
+#define LOG_DEFAULT_SAMPLE_RATE 1.0 ///< Default probability of keeping a sampled entry (1 = sampling disabled).
+constexpr LogLevel LOG_DEFAULT_SAMPLE_LEVEL = LogLevel::Warning; ///< Default level below which entries are sampled.
+#define LOG_DEFAULT_RATE_LIMIT_PER_SITE 0 ///< Default entries per second kept for each call site (0 = unlimited).
+#define LOG_DEFAULT_RATE_LIMIT_PER_LEVEL 0 ///< Default entries per second kept for each level (0 = unlimited).
+#define LOG_DEFAULT_DEDUP_WINDOW_MS 0 ///< Default window in which identical entries of a call site are folded (0 = disabled).
+constexpr WaitStrategy LOG_DEFAULT_WAIT_STRATEGY = WaitStrategy::Block; ///< Default idle wait of the logger threads.
+#define LOG_DEFAULT_SINK_QUEUE_SIZE 65536 ///< Default number of entries queued for each sink before new entries are dropped.
+constexpr LogExport::Format LOG_DEFAULT_FILE_SINK_FORMAT = LogExport::Format::NDJSON; ///< Default format of the file sink.
+#define LOG_DEFAULT_FILE_SINK_MAX_BYTES (64LL << 20) ///< Default size at which the file sink is rotated (0 = no size limit).
+#define LOG_DEFAULT_FILE_SINK_ROTATE_SECONDS 0 ///< Default age at which the file sink is rotated (0 = no age limit).
+#define LOG_DEFAULT_FILE_SINK_MAX_FILES 5 ///< Default number of rotated file sink segments kept.
 
 #define LOG_INI_SECTION_LOGGER "Logger"
 #define LOG_INI_KEY_NAME "Name"
 #define LOG_INI_KEY_SYNC_MODE "SyncMode"
 #define LOG_INI_KEY_NUM_THREADS "NumThreads"
+#define LOG_INI_KEY_THREAD_AFFINITY "ThreadAffinity"
+#define LOG_INI_KEY_THREAD_PRIORITY "ThreadPriority"
+#define LOG_INI_KEY_WAIT_STRATEGY "WaitStrategy"
+#define LOG_INI_KEY_CONNECTION_POOL_SIZE "ConnectionPoolSize"
+#define LOG_INI_KEY_READ_POOL_SIZE "ReadPoolSize"
 #define LOG_INI_KEY_ONLY_FILE_NAMES "OnlyFileNames"
 #define LOG_INI_KEY_MIN_LOG_LEVEL "MinLogLevel"
 #define LOG_INI_KEY_USE_BATCH "UseBatch"
 #define LOG_INI_KEY_BATCH_SIZE "BatchSize"
+#define LOG_INI_KEY_FLUSH_INTERVAL_MS "FlushIntervalMs"
+#define LOG_INI_KEY_MAX_BATCH_BYTES "MaxBatchBytes"
+#define LOG_INI_KEY_ADAPTIVE_BATCH "AdaptiveBatch"
+#define LOG_INI_KEY_TARGET_BATCH_LATENCY_MS "TargetBatchLatencyMs"
+#define LOG_INI_KEY_GROUP_COMMIT_BATCHES "GroupCommitBatches"
+#define LOG_INI_KEY_GROUP_COMMIT_WINDOW_MS "GroupCommitWindowMs"
+#define LOG_INI_KEY_BULK_LOAD_THRESHOLD "BulkLoadThreshold"
+#define LOG_INI_KEY_USE_RING "UseRing"
+#define LOG_INI_KEY_RING_CAPACITY "RingCapacity"
+#define LOG_INI_KEY_BACK_PRESSURE "BackPressure"
+#define LOG_INI_KEY_BACK_PRESSURE_LEVEL "BackPressureLevel"
+#define LOG_INI_KEY_PRIORITY_LEVEL "PriorityLevel"
+#define LOG_INI_KEY_SPOOL_PATH "SpoolPath"
+#define LOG_INI_KEY_SPOOL_MAX_BYTES "SpoolMaxBytes"
+#define LOG_INI_KEY_SPOOL_RETRY_MS "SpoolRetryMs"
+#define LOG_INI_KEY_TAIL_CACHE_SIZE "TailCacheSize"
+#define LOG_INI_KEY_SAMPLE_RATE "SampleRate"
+#define LOG_INI_KEY_SAMPLE_LEVEL "SampleLevel"
+#define LOG_INI_KEY_RATE_LIMIT_PER_SITE "RateLimitPerSite"
+#define LOG_INI_KEY_RATE_LIMIT_PER_LEVEL "RateLimitPerLevel"
+#define LOG_INI_KEY_DEDUP_WINDOW_MS "DedupWindowMs"
+#define LOG_INI_KEY_SINK_QUEUE_SIZE "SinkQueueSize"
+#define LOG_INI_KEY_FILE_SINK_PATH "FileSinkPath"
+#define LOG_INI_KEY_FILE_SINK_FORMAT "FileSinkFormat"
+#define LOG_INI_KEY_FILE_SINK_MAX_BYTES "FileSinkMaxBytes"
+#define LOG_INI_KEY_FILE_SINK_ROTATE_SECONDS "FileSinkRotateSeconds"
+#define LOG_INI_KEY_FILE_SINK_MAX_FILES "FileSinkMaxFiles"
+
+#define LOG_WAIT_STRATEGY_STR_BLOCK "Block"
+#define LOG_WAIT_STRATEGY_STR_SPIN "Spin"
+#define LOG_WAIT_STRATEGY_STR_HYBRID "Hybrid"
+
+#define LOG_CPU_LIST_DELIMITER "," /**< Separates CPUs in a CPU list ("0,2,4-7"). */
+#define LOG_CPU_RANGE_DELIMITER "-" /**< Separates the first and last CPU of a range. */
+#define LOG_CPU_INDEX_MAX 1023 /**< Highest CPU index accepted in a CPU list. */
+
+#define LOG_BACK_PRESSURE_STR_BLOCK "Block"
+#define LOG_BACK_PRESSURE_STR_DROP_NEWEST "DropNewest"
+#define LOG_BACK_PRESSURE_STR_DROP_BELOW_LEVEL "DropBelowLevel"
 
 #define LOG_INI_SECTION_DATABASE "Database"
 #define LOG_INI_KEY_DATABASE_NAME "Name"
 #define LOG_INI_KEY_DATABASE_TABLE "Table"
 #define LOG_INI_KEY_DATABASE_HOST "Host"
 #define LOG_INI_KEY_DATABASE_PORT "Port"
+#define LOG_INI_KEY_DATABASE_READ_HOST "ReadHost"
+#define LOG_INI_KEY_DATABASE_READ_PORT "ReadPort"
 #define LOG_INI_KEY_DATABASE_USER "User"
 #define LOG_INI_KEY_DATABASE_PASS "Pass"
 #define LOG_INI_KEY_DATABASE_TYPE "Type"
+#define LOG_INI_KEY_DATABASE_TIMESTAMP_FORMAT "TimestampFormat"
+#define LOG_INI_KEY_DATABASE_SCHEMA "Schema"
+#define LOG_INI_KEY_DATABASE_INDEXES "Indexes"
+#define LOG_INI_KEY_DATABASE_DEFER_INDEXES "DeferIndexes"
+#define LOG_INI_KEY_DATABASE_MEMORY_MAX_BYTES "MemoryMaxBytes"
+#define LOG_INI_KEY_DATABASE_PARTITIONING "Partitioning"
+#define LOG_INI_KEY_DATABASE_RETENTION_DAYS "RetentionDays"
+#define LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH "FullTextSearch"
+#define LOG_INI_KEY_DATABASE_SHARE_CONNECTION "ShareConnection"
+#define LOG_INI_KEY_DATABASE_ENCRYPT_MESSAGES "EncryptMessages"
+#define LOG_INI_KEY_DATABASE_SHARD_ROUTING "ShardRouting"
+#define LOG_INI_KEY_DATABASE_COMPRESS_MESSAGES "CompressMessages"
+#define LOG_INI_SECTION_DATABASE_SHARD_SEPARATOR "." /**< Shard sections: [Database.1], [Database.2]... */
+#define LOG_SHARDS_MAX 64 /**< Highest number of shard sections read from an INI file. */
+
+#define LOG_TIMESTAMP_FORMAT_STR_TEXT "Text"
+#define LOG_TIMESTAMP_FORMAT_STR_EPOCH_MICROS "EpochMicros"
+
+#define LOG_SCHEMA_LAYOUT_STR_STANDARD "Standard"
+#define LOG_SCHEMA_LAYOUT_STR_COMPACT "Compact"
+
+#define LOG_PARTITIONING_STR_NONE "None"
+#define LOG_PARTITIONING_STR_DAILY "Daily"
+
+#define LOG_SHARD_ROUTING_STR_SOURCE "Source"
+#define LOG_SHARD_ROUTING_STR_ROUND_ROBIN "RoundRobin"
 
 #ifdef SQLG_USE_SOURCE_INFO
     #define LOG_INI_SECTION_SOURCE "Source"
@@ -60,10 +159,21 @@ constexpr LogLevel LOG_DEFAULT_MIN_LOG_LEVEL = LogLevel::Trace; ///< Default min
     #define LOG_INI_KEY_SOURCE_NAME "Name"
 #endif
 
+#define LOG_INI_SECTION_SQLITE "SQLite"
+#define LOG_INI_KEY_SQLITE_JOURNAL_MODE "JournalMode"
+#define LOG_INI_KEY_SQLITE_SYNCHRONOUS "Synchronous"
+#define LOG_INI_KEY_SQLITE_CACHE_SIZE "CacheSize"
+#define LOG_INI_KEY_SQLITE_MMAP_SIZE "MmapSize"
+#define LOG_INI_KEY_SQLITE_PAGE_SIZE "PageSize"
+
 #define LOG_INI_SECTION_TRANSPORT "Transport"
 #define LOG_INI_KEY_TRANSPORT_TYPE "Type"
 #define LOG_INI_KEY_TRANSPORT_HOST "Host"
 #define LOG_INI_KEY_TRANSPORT_PORT "Port"
+#define LOG_INI_KEY_TRANSPORT_BATCH_MAX_ENTRIES "BatchMaxEntries"
+#define LOG_INI_KEY_TRANSPORT_BATCH_MAX_BYTES "BatchMaxBytes"
+#define LOG_INI_KEY_TRANSPORT_BATCH_MAX_DELAY "BatchMaxDelay"
+#define LOG_INI_KEY_TRANSPORT_BATCH_MAX_IN_FLIGHT "BatchMaxInFlight"
 
 #define CON_STR_HOST LOG_INI_KEY_DATABASE_HOST
 #define CON_STR_PORT LOG_INI_KEY_DATABASE_PORT
@@ -75,11 +185,16 @@ constexpr LogLevel LOG_DEFAULT_MIN_LOG_LEVEL = LogLevel::Trace; ///< Default min
 #define LOG_NUM_THREADS_MAX 256
 #define LOG_MIN_PORT_NUM 0
 #define LOG_MAX_PORT_NUM 65535
+#define LOG_RING_CAPACITY_MIN 2
+#define LOG_RING_CAPACITY_MAX (1 << 24)
+#define LOG_SQLITE_PAGE_SIZE_MIN 512
+#define LOG_SQLITE_PAGE_SIZE_MAX 65536
 
 constexpr char* LOG_DEFAULT_INI_FILENAME = SQLOGGER_PROJECT_NAME ".ini";
 
 constexpr char* tagLogger = "[" LOG_INI_SECTION_LOGGER "]";
 constexpr char* tagDatabase = "[" LOG_INI_SECTION_DATABASE "]";
+constexpr char* tagSQLite = "[" LOG_INI_SECTION_SQLITE "]";
 
 #ifdef SQLG_USE_SOURCE_INFO
     constexpr char* tagSource = "[" LOG_INI_SECTION_SOURCE "]";
@@ -106,6 +221,17 @@ constexpr const char* dangerousSQLPatterns[] =
     "shutdown", "1=1", " or "
 };
 
+/**
+ * @enum BackPressure
+ * @brief Policy applied by the ingestion ring when it is full.
+ */
+enum class BackPressure
+{
+    Block, /**< Producer waits until a slot is free. */
+    DropNewest, /**< New message is discarded. */
+    DropBelowLevel /**< New message is discarded if below the drop level, otherwise producer waits. */
+};
+
 /**
  * @namespace LogConfig
  * @brief Provides configuration management for the logging system
@@ -174,6 +300,19 @@ namespace LogConfig
             std::vector<std::pair<std::string, std::string>> invalidParams; ///< List of invalid parameters with error details
     };
 
+    /**
+     * @struct DatabaseTarget
+     * @brief Connection parameters of a shard ([Database.N] in INI); unset values are taken from [Database].
+     */
+    struct DatabaseTarget
+    {
+        std::optional<std::string> name; ///< Database name (file name of SQLite).
+        std::optional<std::string> host; ///< Host address.
+        std::optional<int> port; ///< Port number.
+        std::optional<std::string> user; ///< Username.
+        std::optional<std::string> pass; ///< Password.
+    };
+
     /**
      * @struct Config
      * @brief Configuration settings for the logger.
@@ -183,20 +322,76 @@ namespace LogConfig
             std::optional<std::string> name; ///< Logger name.
             std::optional<bool> syncMode; ///< Synchronization mode (true for synchronous logging).
             std::optional<size_t> numThreads; ///< Number of threads for asynchronous logging.
+            std::optional<std::vector<int>> threadAffinity; ///< CPUs the logger's threads (writers, ring writer, flush timer, spool drainer, sinks) run on (unset = any).
+            std::optional<int> threadPriority; ///< Nice value of the logger's threads (THREAD_HELPER_PRIORITY_MIN - THREAD_HELPER_PRIORITY_MAX, unset = inherited).
+            std::optional<WaitStrategy> waitStrategy; ///< Idle wait of the writer threads and the ring writer.
+            std::optional<int> connectionPoolSize; ///< Write connections used in parallel by asynchronous workers, MySQL/PostgreSQL only (0 = single shared connection).
+            std::optional<int> readPoolSize; ///< Query connections used without the write locks, SQLite (WAL)/MySQL/PostgreSQL only (0 = queries use the write connection).
             std::optional<bool> onlyFileNames; ///< Whether to log only filenames (without full paths).
             std::optional<LogLevel> minLogLevel; ///< Minimum log level for messages to be logged.
             std::optional<std::string> databaseName; ///< Name of the database to use for logging.
             std::optional<std::string> databaseTable; ///< Name of the table to use for logging.
             std::optional<std::string> databaseHost; ///< Host address of the database.
             std::optional<int> databasePort; ///< Port number of the database.
+            std::optional<std::string> databaseReadHost; ///< Replica host queried by the read pool, MySQL/PostgreSQL only (default: databaseHost).
+            std::optional<int> databaseReadPort; ///< Replica port queried by the read pool (default: databasePort).
             std::optional<std::string> databaseUser; ///< Username for the database.
             std::optional<std::string> databasePass; ///< Password for the database.
             std::optional<DataBaseType> databaseType; ///< Type of the database (e.g., MySQL, SQLite).
+            std::optional<TimestampFormat> timestampFormat; ///< Timestamp column format, must match an existing table (default: Text).
+            std::optional<SchemaLayout> schemaLayout; ///< Log table layout, must match an existing table (default: Standard).
+            std::optional<std::vector<LogIndex>> indexes; ///< Log table indexes, "timestamp,level+timestamp" in INI (default: timestamp, level, file, thread_id, func; empty = none).
+            std::optional<bool> deferIndexes; ///< Start in bulk-load mode: indexes are built by SQLogger::endBulkLoad() instead of at construction.
+            std::optional<long long> memoryMaxBytes; ///< Memory budget of each log table of the Memory database in bytes, oldest entries are evicted (0 = unlimited).
+            std::optional<Partitioning> partitioning; ///< Daily partitions of the log table, SQLite/MySQL/PostgreSQL only, must match an existing table (default: None).
+            std::optional<int> retentionDays; ///< Past days kept by dropping older partitions, requires Daily partitioning (0 = keep everything).
+            std::optional<bool> fullTextSearch; ///< Full-text index on the message column used by SQLogger::searchLogs(), SQLite/MySQL/PostgreSQL only (default: false).
+            std::optional<bool> shareConnection; ///< LogManager loggers with the same database and connection parameters use one connection; disables group commit (default: false).
+            std::optional<bool> encryptMessages; ///< AES-256-GCM encryption of the message column with a key derived from passKey, requires SQLG_USE_AES, SQLite/MySQL/PostgreSQL only (default: false).
+            std::optional<std::vector<DatabaseTarget>> shards; ///< Further databases of the same type the log table is sharded across, with [Database] as the first shard (unset or empty = no sharding).
+            std::optional<ShardRouting> shardRouting; ///< Shard each written batch goes to (default: Source).
+            std::optional<bool> compressMessages; ///< zstd compression of the message column with dictionaries trained on the log, requires SQLG_USE_ZSTD, SQLite/MySQL/PostgreSQL only (default: false).
             std::optional<bool> useBatch;
             std::optional<int> batchSize;
+            std::optional<int> flushIntervalMs; ///< Maximum age of a partial batch in milliseconds before a background flush (0 = disabled).
+            std::optional<int> maxBatchBytes; ///< Approximate batch buffer size in bytes that triggers a flush (0 = disabled).
+            std::optional<bool> adaptiveBatch; ///< Tune batch size and flush interval at runtime toward targetBatchLatencyMs (batchSize is the starting size, flushIntervalMs the longest interval).
+            std::optional<int> targetBatchLatencyMs; ///< Target write latency of one batch in milliseconds for adaptive batching.
+            std::optional<int> groupCommitBatches; ///< Number of consecutive batches coalesced into one transaction (0/1 = disabled).
+            std::optional<int> groupCommitWindowMs; ///< Maximum age of a group-commit transaction in milliseconds (0 = no time limit).
+            std::optional<int> bulkLoadThreshold; ///< Minimum batch size written with COPY / LOAD DATA instead of INSERT (0 = disabled).
+            std::optional<bool> useRing; ///< Whether to ingest through the lock-free ring drained by a dedicated writer thread.
+            std::optional<int> ringCapacity; ///< Ingestion ring capacity.
+            std::optional<BackPressure> backPressure; ///< Policy applied when the ingestion ring is full.
+            std::optional<LogLevel> backPressureLevel; ///< Drop threshold for BackPressure::DropBelowLevel.
+            std::optional<LogLevel> priorityLevel; ///< Entries at or above this level are written and committed before the log call returns in batch mode, together with the entries buffered before them (unset = disabled).
+            std::optional<std::string> spoolPath; ///< Local spool file absorbing writes while the database fails (empty = disabled).
+            std::optional<long long> spoolMaxBytes; ///< Maximum spool file size in bytes (0 = unlimited).
+            std::optional<int> spoolRetryMs; ///< Delay in milliseconds before a failed spool replay is retried (doubled up to LOG_SPOOL_RETRY_MAX_MS).
+            std::optional<int> tailCacheSize; ///< Recently written entries kept in memory to answer getLogsByFilters() (0 = disabled, not used with a connection pool).
+            std::optional<double> sampleRate; ///< Probability (0 - 1) of keeping an entry below sampleLevel, checked in the log call (1 = keep all).
+            std::optional<LogLevel> sampleLevel; ///< Entries below this level are sampled.
+            std::optional<int> rateLimitPerSite; ///< Entries per second kept for each call site (file:line), the rest are dropped (0 = unlimited).
+            std::optional<int> rateLimitPerLevel; ///< Entries per second kept for each level, the rest are dropped (0 = unlimited).
+            std::optional<int> dedupWindowMs; ///< Identical entries of a call site within this window are logged once plus a "Last message repeated N times" entry (0 = disabled).
+            std::optional<int> sinkQueueSize; ///< Entries queued for each sink (see SQLogger::addSink()) before new entries are dropped.
+            std::optional<std::string> fileSinkPath; ///< File every entry is also appended to, independently of the database (empty = disabled).
+            std::optional<LogExport::Format> fileSinkFormat; ///< Format of the file sink.
+            std::optional<long long> fileSinkMaxBytes; ///< Size in bytes at which the file sink is rotated (0 = no size limit).
+            std::optional<int> fileSinkRotateSeconds; ///< Age in seconds at which the file sink is rotated (0 = no age limit).
+            std::optional<int> fileSinkMaxFiles; ///< Rotated file sink segments kept (path.1 is the newest, 0 = rotated segments are deleted).
+            std::optional<std::string> sqliteJournalMode; ///< SQLite journal mode (e.g. WAL).
+            std::optional<std::string> sqliteSynchronous; ///< SQLite synchronous mode (e.g. NORMAL).
+            std::optional<int> sqliteCacheSize; ///< SQLite page cache size (pages if positive, KiB if negative).
+            std::optional<long long> sqliteMmapSize; ///< SQLite memory map size in bytes.
+            std::optional<int> sqlitePageSize; ///< SQLite page size in bytes, effective only for a new database file.
             std::optional<TransportType> transportType;
             std::optional<std::string> transportHost;
             std::optional<int> transportPort;
+            std::optional<int> transportBatchMaxEntries; /**< Entries per pushed batch (see TransportBatcher). */
+            std::optional<int> transportBatchMaxBytes; /**< Approximate bytes per pushed batch. */
+            std::optional<int> transportBatchMaxDelay; /**< Milliseconds an entry may wait for its batch to fill. */
+            std::optional<int> transportBatchMaxInFlight; /**< Batches sent but not yet acknowledged. */
 
 #ifdef SQLG_USE_SOURCE_INFO
             std::optional<std::string> sourceUuid;  /**< The universally unique identifier (UUID) of the source. */
@@ -313,6 +508,10 @@ namespace LogConfig
              * @details Checks:
              * - Thread count is within allowed range (1-256)
              * - Thread count is present if async mode is enabled
+             * - Connection pool size is within allowed range (0-256) and used only with MySQL/PostgreSQL
+             * - Tail cache size is not negative (the cache is not used with a connection pool)
+             * - CPU indexes of the thread affinity are not negative
+             * - Thread priority is within THREAD_HELPER_PRIORITY_MIN - THREAD_HELPER_PRIORITY_MAX
              */
             ValidateResult validateThreads() const;
 
@@ -325,6 +524,7 @@ namespace LogConfig
              * @details Checks:
              * - Batch size is within allowed range for database type (1-10000 depends on database type)
              * - Batch size is present if async mode is enabled
+             * - Flush interval, max batch bytes and group commit settings are not negative
              * @see getMaxBatchSize()
              * @see DB_MAX_BATCH_SQLITE, DB_MAX_BATCH_MYSQL, DB_MAX_BATCH_POSTGRESQL
              */
@@ -348,6 +548,66 @@ namespace LogConfig
              */
             ValidateResult validateLogLevel() const;
 
+            /**
+             * @brief Validates ingestion ring configuration
+             * @return ValidateResult Contains:
+             * - success: true if ring configuration is valid
+             * - missingParams: Empty (ring parameters have default values)
+             * - invalidParams: Contains error if ring capacity is out of valid range
+             * @details Checks:
+             * - Ring capacity is within allowed range (LOG_RING_CAPACITY_MIN - LOG_RING_CAPACITY_MAX)
+             */
+            ValidateResult validateRing() const;
+
+            /**
+             * @brief Validates spool configuration
+             * @return ValidateResult Contains:
+             * - success: true if spool configuration is valid
+             * - missingParams: Empty (spool parameters have default values)
+             * - invalidParams: Contains errors for negative sizes or delays
+             * @details Checks:
+             * - Spool max bytes and retry delay are not negative
+             */
+            ValidateResult validateSpool() const;
+
+            /**
+             * @brief Validates sampling, rate limit and duplicate suppression configuration
+             * @return ValidateResult Contains:
+             * - success: true if the throttling configuration is valid
+             * - missingParams: Empty (throttling parameters have default values)
+             * - invalidParams: Contains errors for out of range values
+             * @details Checks:
+             * - Sample rate is within 0 - 1
+             * - Rate limits and dedup window are not negative
+             */
+            ValidateResult validateThrottle() const;
+
+            /**
+             * @brief Validates sink configuration
+             * @return ValidateResult Contains:
+             * - success: true if the sink configuration is valid
+             * - missingParams: Empty (sink parameters have default values)
+             * - invalidParams: Contains errors for out of range values
+             * @details Checks:
+             * - Sink queue size is positive
+             * - File sink rotation size, age and segment count are not negative
+             */
+            ValidateResult validateSinks() const;
+
+            /**
+             * @brief Validates SQLite pragma configuration
+             * @return ValidateResult Contains:
+             * - success: true if SQLite configuration is valid
+             * - missingParams: Empty (SQLite parameters have default values)
+             * - invalidParams: Contains errors for unknown modes or out of range sizes
+             * @details Checks:
+             * - Journal mode is one of DELETE, TRUNCATE, PERSIST, MEMORY, WAL, OFF
+             * - Synchronous mode is one of OFF, NORMAL, FULL, EXTRA
+             * - Page size is a power of two within LOG_SQLITE_PAGE_SIZE_MIN - LOG_SQLITE_PAGE_SIZE_MAX
+             * - Memory map size is not negative
+             */
+            ValidateResult validateSQLite() const;
+
 #ifdef SQLG_USE_SOURCE_INFO
             /**
              * @brief Validates source UUID configuration (if enabled)
@@ -375,6 +635,7 @@ namespace LogConfig
     *
     * @note Connection string format varies by database type:
     *       - Mock/SQLite: Returns just the database name (or empty string)
+    *       - Memory: "Name=value;MaxBytes=value" format (MaxBytes only if memoryMaxBytes is set)
     *       - MySQL: "host=value;user=value;password=value" format
     *       - PostgreSQL: "host=value user=value password=value" format (space-separated)
     *       - MongoDB: "host=value;user=value;password=value" format
@@ -387,6 +648,151 @@ namespace LogConfig
     * @see StringHelper::join()
     */
     std::string configToConnectionString(const Config& config);
+
+    /**
+    * @brief Extracts SQLite connection tuning from a LogConfig::Config object
+    * @param config Configuration object containing [SQLite] parameters
+    * @return SQLitePragmas Pragmas to apply on every SQLite (re)connect
+    * @see SQLiteDatabase
+    */
+    SQLitePragmas configToSQLitePragmas(const Config& config);
+
+    /**
+    * @brief Gets the configuration of every shard
+    * @param config Configuration object containing [Database] and the shard targets
+    * @return std::vector<Config> One configuration per shard ([Database] first), only the
+    *         connection parameters differ; a single item if sharding is not configured
+    */
+    std::vector<Config> getShardConfigs(const Config& config);
+
+    /**
+    * @brief Gets the maximum batch size allowed by a configuration
+    * @param config Configuration object containing database type and bulk-load threshold
+    * @return int DataBaseHelper::getMaxBatchSize() of the database type, or DB_MAX_BATCH_BULK
+    *         if the backend supports bulk load and every batch too large for an INSERT
+    *         (bulkLoadThreshold <= INSERT limit) goes through it
+    * @see DataBaseHelper::isBulkLoadSupported()
+    */
+    int getMaxBatchSize(const Config& config);
+
+    /**
+    * @brief Extracts the logger thread settings from a LogConfig::Config object
+    * @param config Configuration object containing thread affinity, priority and wait strategy
+    * @return ThreadHelper::Settings Settings applied by every logger thread when it starts
+    */
+    ThreadHelper::Settings getThreadSettings(const Config& config);
+
+    /**
+    * @brief Converts WaitStrategy to its string representation
+    * @param strategy Wait strategy
+    * @return std::string Strategy name (LOG_WAIT_STRATEGY_STR_*)
+    */
+    std::string waitStrategyToString(const WaitStrategy strategy);
+
+    /**
+    * @brief Converts string to WaitStrategy
+    * @param strategy Strategy name (case insensitive)
+    * @return std::optional<WaitStrategy> Strategy, or std::nullopt if unknown
+    */
+    std::optional<WaitStrategy> stringToWaitStrategy(const std::string& strategy);
+
+    /**
+    * @brief Converts a CPU list to its string representation
+    * @param cpus CPU indexes
+    * @return std::string CPUs separated by LOG_CPU_LIST_DELIMITER
+    */
+    std::string cpuListToString(const std::vector<int> & cpus);
+
+    /**
+    * @brief Converts string to a CPU list
+    * @param cpus CPUs and ranges separated by LOG_CPU_LIST_DELIMITER ("0,2,4-7", spaces ignored)
+    * @return std::optional<std::vector<int>> CPU indexes, or std::nullopt if an item is not a CPU or range
+    */
+    std::optional<std::vector<int>> stringToCpuList(const std::string& cpus);
+
+    /**
+    * @brief Converts BackPressure to its string representation
+    * @param policy Back-pressure policy
+    * @return std::string Policy name (LOG_BACK_PRESSURE_STR_*)
+    */
+    std::string backPressureToString(const BackPressure policy);
+
+    /**
+    * @brief Converts string to BackPressure
+    * @param policy Policy name (case insensitive)
+    * @return std::optional<BackPressure> Policy, or std::nullopt if unknown
+    */
+    std::optional<BackPressure> stringToBackPressure(const std::string& policy);
+
+    /**
+    * @brief Converts TimestampFormat to its string representation
+    * @param format Timestamp format
+    * @return std::string Format name (LOG_TIMESTAMP_FORMAT_STR_*)
+    */
+    std::string timestampFormatToString(const TimestampFormat format);
+
+    /**
+    * @brief Converts string to TimestampFormat
+    * @param format Format name (case insensitive)
+    * @return std::optional<TimestampFormat> Format, or std::nullopt if unknown
+    */
+    std::optional<TimestampFormat> stringToTimestampFormat(const std::string& format);
+
+    /**
+    * @brief Converts SchemaLayout to its string representation
+    * @param layout Schema layout
+    * @return std::string Layout name (LOG_SCHEMA_LAYOUT_STR_*)
+    */
+    std::string schemaLayoutToString(const SchemaLayout layout);
+
+    /**
+    * @brief Converts string to SchemaLayout
+    * @param layout Layout name (case insensitive)
+    * @return std::optional<SchemaLayout> Layout, or std::nullopt if unknown
+    */
+    std::optional<SchemaLayout> stringToSchemaLayout(const std::string& layout);
+
+    /**
+    * @brief Converts Partitioning to its string representation
+    * @param partitioning Partitioning mode
+    * @return std::string Mode name (LOG_PARTITIONING_STR_*)
+    */
+    std::string partitioningToString(const Partitioning partitioning);
+
+    /**
+    * @brief Converts string to Partitioning
+    * @param partitioning Mode name (case insensitive)
+    * @return std::optional<Partitioning> Mode, or std::nullopt if unknown
+    */
+    std::optional<Partitioning> stringToPartitioning(const std::string& partitioning);
+
+    /**
+    * @brief Converts ShardRouting to its string representation
+    * @param routing Shard routing
+    * @return std::string Routing name (LOG_SHARD_ROUTING_STR_*)
+    */
+    std::string shardRoutingToString(const ShardRouting routing);
+
+    /**
+    * @brief Converts string to ShardRouting
+    * @param routing Routing name (case insensitive)
+    * @return std::optional<ShardRouting> Routing, or std::nullopt if unknown
+    */
+    std::optional<ShardRouting> stringToShardRouting(const std::string& routing);
+
+    /**
+    * @brief Converts an index list to its string representation
+    * @param indexes Indexes
+    * @return std::string Indexes separated by INDEX_DELIMITER, columns by INDEX_COLUMN_DELIMITER
+    */
+    std::string indexesToString(const std::vector<LogIndex> & indexes);
+
+    /**
+    * @brief Converts string to an index list
+    * @param indexes Indexes separated by INDEX_DELIMITER, columns by INDEX_COLUMN_DELIMITER (spaces ignored)
+    * @return std::optional<std::vector<LogIndex>> Indexes, or std::nullopt if a column is not an indexable log field
+    */
+    std::optional<std::vector<LogIndex>> stringToIndexes(const std::string& indexes);
 };
 
 #endif // !LOG_CONFIG_H
\ No newline at end of file
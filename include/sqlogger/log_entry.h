@@ -20,6 +20,7 @@
 #ifndef LOG_ENTRY_H
 #define LOG_ENTRY_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -29,6 +30,7 @@
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
+#include <functional>
 #include "sqlogger/internal/log_strings.h"
 
 #ifdef SQLG_USE_SOURCE_INFO
@@ -100,12 +102,27 @@
 #define ENTRY_DELIMITER ","
 #define TIMESTAMP_FMT "%Y-%m-%d %H:%M:%S"
 
+#define SCHEMA_TABLE_NAME "sqlogger_schema" /**< Schema version markers, one row per log table. */
+#define FIELD_SCHEMA_TABLE "table_name"
+#define FIELD_SCHEMA_VERSION "version"
+#define SCHEMA_VERSION 1 /**< Bumped whenever the tables or indexes created by LogWriter::createSchema() change. */
+#define SCHEMA_SIGNATURE_DELIMITER ";" /**< Separates the parts of a schema version marker. */
+
+#define INDEX_PREFIX "idx_"
+#define INDEX_DELIMITER "," /**< Separates indexes in an index list ("timestamp,level+timestamp"). */
+#define INDEX_COLUMN_DELIMITER "+" /**< Separates the columns of a composite index. */
+#define FTS_SUFFIX "_fts" /**< Full-text index name: idx_message_fts; SQLite full-text table: <logs table>_fts. */
+#define FTS_PG_CONFIG "simple" /**< PostgreSQL text search configuration (no stemming, no stop words). */
+
+#define FILTER_OP_MATCH "MATCH" /**< Full-text search: the value is a list of words, all of them must occur in the column. */
+
 constexpr const char* ALLOWED_FILTER_OP[] =
 {
     "=", ">", "<", ">=", "<=", "!=", "<>",
     "LIKE", "NOT LIKE",
     "IN", "NOT IN",
-    "IS NULL", "IS NOT NULL"
+    "IS NULL", "IS NOT NULL",
+    FILTER_OP_MATCH
 };
 
 #ifdef SQLG_USE_SOURCE_INFO
@@ -123,6 +140,51 @@ struct SourceInfo
 };
 #endif
 
+/**
+ * @enum TimestampFormat
+ * @brief Storage format of the log table timestamp column.
+ */
+enum class TimestampFormat
+{
+    Text,       /**< Local time text (TIMESTAMP_FMT), second resolution. */
+    EpochMicros /**< 64-bit integer microseconds since the Unix epoch, formatted when read. */
+};
+
+/**
+ * @enum SchemaLayout
+ * @brief Layout of the log table columns.
+ */
+enum class SchemaLayout
+{
+    Standard, /**< Level, function, file and thread ID stored as text on every row. */
+    Compact   /**< Level stored as an integer, function, file and thread ID as ids into dictionary tables. */
+};
+
+/**
+ * @enum Partitioning
+ * @brief Partitioning of the log table by the timestamp column.
+ */
+enum class Partitioning
+{
+    None, /**< A single log table. */
+    Daily /**< One partition per local day: declarative partitions on PostgreSQL and MySQL, per-day tables behind a view on SQLite. */
+};
+
+/**
+ * @enum ShardRouting
+ * @brief Choice of the shard a written batch is stored in.
+ */
+enum class ShardRouting
+{
+    Source,    /**< Entries go to the shard of their source ID (hash), so a source stays on one shard; RoundRobin without SQLG_USE_SOURCE_INFO. */
+    RoundRobin /**< Whole batches go to the shards in turn. */
+};
+
+/**
+ * @brief Columns of a log table index, in key order (more than one for a composite index).
+ */
+using LogIndex = std::vector<std::string>;
+
 /**
  * @enum LogLevel
  * @brief Enumeration representing the severity level of a log entry.
@@ -298,6 +360,7 @@ struct LogEntry
     std::string sourceUuid;  /**< The UUID. */
     std::string sourceName;  /**< The name of the source. */
 #endif
+    int64_t timestampUs = 0; /**< Capture time in microseconds since the epoch (0 if unknown). */
 
     /**
      * @brief Converts the log entry to a string.
@@ -367,4 +430,19 @@ struct LogEntry
 // Alias for a list of log entries
 using LogEntryList = std::vector<LogEntry>;
 
+/**
+ * @brief Callback receiving streamed log entries; returns false to stop.
+ */
+using LogCallback = std::function<bool(const LogEntry& entry)>;
+
+/**
+ * @brief Number of log entries per column value (see SQLogger::countBy()).
+ */
+using LogCounts = std::map<std::string, uint64_t>;
+
+/**
+ * @brief Number of log entries per time bucket start and column value (see SQLogger::histogramBy()).
+ */
+using LogHistogram = std::map<std::string, LogCounts>;
+
 #endif // LOG_ENTRY_H
\ No newline at end of file
@@ -20,6 +20,9 @@
 #ifndef LOG_HELPER_H
 #define LOG_HELPER_H
 
+#include <cstdint>
+#include <ctime>
+#include <optional>
 #include "sqlogger/log_entry.h"
 
 /**
@@ -43,6 +46,13 @@ namespace StringHelper
     * @return std::vector<std::string> The resulting vector of strings
     */
     std::vector<std::string> split(const std::string& str, const std::string& delimiter);
+
+    /**
+    * @brief Splits a string into words separated by whitespace
+    * @param str The string to split
+    * @return std::vector<std::string> The words (empty parts are skipped)
+    */
+    std::vector<std::string> splitWords(const std::string& str);
 };
 
 /**
@@ -135,6 +145,39 @@ namespace LogHelper
     */
     std::chrono::system_clock::time_point parseTime(const std::string& timestamp, const char* timeFormat = TIMESTAMP_FMT);
 
+    /**
+    * @brief Converts a time_point to microseconds since the epoch
+    * @param tp The time_point to convert
+    * @return int64_t Microseconds since the Unix epoch
+    */
+    int64_t toEpochMicros(const std::chrono::system_clock::time_point& tp);
+
+    /**
+    * @brief Converts a time to local calendar time (thread-safe, unlike std::localtime)
+    * @param time Seconds since the Unix epoch
+    * @param tm Receives the local calendar time
+    * @return bool False if the time can't be converted
+    * @note Uses localtime_s on Windows and localtime_r elsewhere
+    */
+    bool toLocalTime(const std::time_t time, std::tm& tm);
+
+    /**
+    * @brief Formats microseconds since the epoch as local time with a microsecond fraction
+    * @param micros Microseconds since the Unix epoch
+    * @return std::string TIMESTAMP_FMT text followed by ".ffffff"
+    * @note Uses the system's local time zone for conversion
+    */
+    std::string formatEpochMicros(const int64_t micros);
+
+    /**
+    * @brief Parses a timestamp into microseconds since the epoch
+    * @param timestamp Either an integer (already in microseconds) or TIMESTAMP_FMT text
+    *        with an optional ".ffffff" fraction (local time)
+    * @return std::optional<int64_t> Microseconds, or std::nullopt if the text can't be parsed
+    * @see formatEpochMicros() for inverse operation
+    */
+    std::optional<int64_t> parseEpochMicros(const std::string& timestamp);
+
     /**
      * @brief Gets the current timestamp as a string.
      * @param timeFormat The format of the timestamp.
@@ -148,5 +191,11 @@ namespace LogHelper
      * @return The string representation of the thread ID.
      */
     std::string threadIdToString(std::thread::id id);
+
+    /**
+     * @brief Gets the calling thread's ID as a string.
+     * @return const std::string& Thread ID, converted once per thread and cached.
+     */
+    const std::string& currentThreadId();
 };
 #endif // !LOG_HELPER_H
@@ -27,6 +27,8 @@
 #include "sqlogger/logger.h"
 #include "sqlogger/log_config.h"
 #include "sqlogger/database/database_factory.h"
+#include "sqlogger/database/shared_database.h"
+#include "sqlogger/database/sharded_database.h"
 
 /**
  * @class LogManager
@@ -34,6 +36,8 @@
  *
  * Provides thread-safe logger creation and access using configuration objects.
  * Integrates with DatabaseFactory for backend creation.
+ * Lookups read an immutable snapshot of the loggers without taking the manager mutex;
+ * creating or removing a logger publishes a new snapshot.
  */
 class LogManager
 {
@@ -75,6 +79,14 @@ class LogManager
          */
         SQLogger& getLogger(const std::string& name);
 
+        /**
+         * @brief Gets a handle of an existing logger by name, without throwing
+         * The handle keeps the logger object alive after removeLogger() (it is shut down then)
+         * @param name Logger name to retrieve
+         * @return std::shared_ptr<SQLogger> The logger, or nullptr if not found
+         */
+        std::shared_ptr<SQLogger> findLogger(const std::string& name) const;
+
         /**
          * @brief Removes a logger by name
          * @param name Logger name to remove
@@ -111,14 +123,15 @@ class LogManager
         int removeIf(Predicate&& predicate)
         {
             std::lock_guard<std::mutex> lock(mutex);
+            auto updated = std::make_shared<LoggerMap>( * std::atomic_load( & loggers));
             int removedCount = 0;
 
-            for(auto it = loggers.begin(); it != loggers.end();)
+            for(auto it = updated->begin(); it != updated->end();)
             {
                 if(predicate(it->first, * (it->second)))
                 {
                     it->second->shutdown();
-                    it = loggers.erase(it);
+                    it = updated->erase(it);
                     ++removedCount;
                 }
                 else
@@ -127,9 +140,27 @@ class LogManager
                 }
             }
 
+            std::atomic_store( & loggers, std::shared_ptr<const LoggerMap>(std::move(updated)));
             return removedCount;
         };
 
+        /**
+         * @brief Calls a visitor for every managed logger.
+         * The walk covers the loggers at the time of the call; the visitor may create or remove loggers.
+         * @tparam Visitor A callable type that accepts (const std::string&, SQLogger&).
+         * @param visitor A callable object invoked once per logger.
+         * @see removeIf()
+         */
+        template<typename Visitor>
+        void forEach(Visitor&& visitor)
+        {
+            const auto snapshot = std::atomic_load( & loggers);
+            for(auto & logger : * snapshot)
+            {
+                visitor(logger.first, * (logger.second));
+            }
+        };
+
         /**
         * @brief Gets the number of active logger instances currently managed.
         * This method returns the current count of logger instances that have been
@@ -153,7 +184,15 @@ class LogManager
          */
         std::map<std::string, LogConfig::Config> getAllLoggersConfigs();
 
+        /**
+         * @brief Gets the number of open connections shared by loggers
+         * @return int Connections used by loggers created with LogConfig::Config::shareConnection
+         */
+        int getSharedConnectionCount() const;
+
     private:
+        using LoggerMap = std::unordered_map<std::string, std::shared_ptr<SQLogger>>;
+
         LogManager() = default;
         ~LogManager() = default;
 
@@ -173,8 +212,18 @@ class LogManager
          */
         std::unique_ptr<IDatabase> createDatabase(const LogConfig::Config& config);
 
-        std::unordered_map<std::string, std::unique_ptr<SQLogger>> loggers;
-        std::mutex mutex;
+        /**
+         * @brief Gets a user of the shared connection for a configuration, opening it on first use
+         * The caller holds the manager mutex.
+         * @param config Configuration object containing database parameters
+         * @return std::unique_ptr<IDatabase> Database forwarding to the shared connection
+         * @see createDatabase()
+         */
+        std::unique_ptr<IDatabase> createSharedDatabase(const LogConfig::Config& config);
+
+        std::shared_ptr<const LoggerMap> loggers = std::make_shared<const LoggerMap>(); /**< Snapshot read by lookups (std::atomic_load/std::atomic_store). */
+        std::unordered_map<std::string, std::weak_ptr<SharedConnection>> connections; /**< Shared connections by type and connection string. */
+        mutable std::mutex mutex; /**< Serializes the updates of loggers and connections. */
 };
 
 #endif // LOG_MANAGER_H
\ No newline at end of file
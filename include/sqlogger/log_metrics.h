@@ -0,0 +1,179 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_METRICS_H
+#define LOG_METRICS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sqlogger/log_manager.h"
+#include "sqlogger/transport/transport_interface.h"
+
+#define METRICS_PREFIX "sqlogger_" /**< Prefix of every metric name. */
+#define METRICS_DEFAULT_INTERVAL_MS 10000 /**< Default publish interval of LogMetrics. */
+#define METRICS_LABEL_LOGGER "logger" /**< Label holding the logger name. */
+#define METRICS_LABEL_DB_TYPE "db_type" /**< Label holding the database type. */
+#define METRICS_LABEL_SOURCE "source" /**< Label holding the source name (or UUID). */
+
+/**
+ * @class LogMetrics
+ * @brief Publishes the statistics of every logger registered in LogManager as metrics.
+ * format() renders SQLogger::Stats in the Prometheus text exposition format (or OpenMetrics),
+ * one series per logger labelled by logger name, database type and source. Latency
+ * histograms become Prometheus histograms in seconds.
+ *
+ * For a pull endpoint, serve scrape() from the application's HTTP handler. For periodic
+ * publishing, start() a LogMetrics: each round writes a text file (for the node_exporter
+ * textfile collector), calls a handler with the text and/or pushes each logger's Stats
+ * through an ITransport (pushStats(), received by a StatsHandler).
+ */
+class LogMetrics
+{
+    public:
+        /**
+         * @enum Format
+         * @brief Exposition format.
+         */
+        enum class Format
+        {
+            Prometheus, /**< Prometheus text format 0.0.4. */
+            OpenMetrics /**< OpenMetrics 1.0 text format (terminated by "# EOF"). */
+        };
+
+        /**
+         * @struct Sample
+         * @brief Statistics of one logger with its labels.
+         */
+        struct Sample
+        {
+            std::string logger; /**< Logger name. */
+            std::string databaseType; /**< Database type. */
+            std::string source; /**< Source name or UUID (empty without SQLG_USE_SOURCE_INFO). */
+            SQLogger::Stats stats; /**< Logger statistics. */
+        };
+
+        /// Handler receiving the rendered metrics of every publish round
+        using Handler = std::function<void(const std::string&)>;
+
+        /**
+         * @brief Constructs a stopped publisher.
+         * @param interval Publish interval.
+         */
+        explicit LogMetrics(const std::chrono::milliseconds& interval = std::chrono::milliseconds(METRICS_DEFAULT_INTERVAL_MS));
+
+        /**
+         * @brief Destructor. Stops the publish thread.
+         */
+        ~LogMetrics();
+
+        LogMetrics(const LogMetrics&) = delete;
+        LogMetrics& operator=(const LogMetrics&) = delete;
+
+        /**
+         * @brief Collects the statistics of every logger registered in LogManager.
+         * @return std::vector<Sample> One sample per logger, ordered by logger name.
+         */
+        static std::vector<Sample> collect();
+
+        /**
+         * @brief Renders samples as metrics text.
+         * @param samples Samples to render.
+         * @param format Exposition format.
+         * @return std::string Metrics text.
+         */
+        static std::string format(const std::vector<Sample> & samples, const Format format = Format::Prometheus);
+
+        /**
+         * @brief Collects and renders the statistics of every registered logger (the body of a /metrics response).
+         * @param format Exposition format.
+         * @return std::string Metrics text.
+         */
+        static std::string scrape(const Format format = Format::Prometheus);
+
+        /**
+         * @brief Gets the HTTP Content-Type of a format.
+         * @param format Exposition format.
+         * @return const char* Content type.
+         */
+        static const char* contentType(const Format format);
+
+        /**
+         * @brief Writes the metrics to a file every round (replaced atomically, so readers never see a partial file).
+         * @param path File path (empty disables the file).
+         * @param format Exposition format (OpenMetrics is not read by the node_exporter textfile collector).
+         */
+        void setTextFile(const std::string& path, const Format format = Format::Prometheus);
+
+        /**
+         * @brief Calls a handler with the metrics every round.
+         * @param handler Handler (empty disables it).
+         * @param format Exposition format.
+         */
+        void setHandler(Handler handler, const Format format = Format::Prometheus);
+
+        /**
+         * @brief Pushes the Stats of every logger through a transport every round.
+         * @param transport Transport client (nullptr disables pushing); must outlive the publisher.
+         */
+        void setTransport(ITransport* transport);
+
+        /**
+         * @brief Starts the publish thread (the first round runs after one interval).
+         */
+        void start();
+
+        /**
+         * @brief Stops the publish thread.
+         */
+        void stop();
+
+        /**
+         * @brief Publishes one round now.
+         * @return bool False if the text file could not be written.
+         */
+        bool publish();
+
+    private:
+        /**
+         * @brief Publish thread body.
+         */
+        void publishLoop();
+
+        std::chrono::milliseconds interval; /**< Publish interval. */
+
+        std::mutex mutex; /**< Guards the targets below. */
+        std::string textFile; /**< Text file path (empty if disabled). */
+        Format textFileFormat = Format::Prometheus; /**< Format of the text file. */
+        Handler handler; /**< Metrics handler (empty if disabled). */
+        Format handlerFormat = Format::Prometheus; /**< Format passed to the handler. */
+        ITransport* transport = nullptr; /**< Transport client (nullptr if disabled). */
+
+        std::thread publisher; /**< Publish thread. */
+        std::mutex stopMutex; /**< Mutex for publish thread wake-ups. */
+        std::condition_variable stopCondition; /**< Wakes the publish thread on stop(). */
+        bool stopping = false; /**< Flag to stop the publish thread (guarded by stopMutex). */
+};
+
+#endif // LOG_METRICS_H
@@ -0,0 +1,175 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "sqlogger/log_entry.h"
+#include "sqlogger/internal/log_export.h"
+
+#define LOG_FILE_SINK_DEFAULT_MAX_FILES 5 /**< Default number of rotated segments kept by LogFileSink. */
+
+/**
+ * @class ILogSink
+ * @brief Destination of log entries besides the logger's database.
+ * Every sink added to a logger gets its own queue and thread, so a slow sink (or a slow
+ * database) never delays another one; write() and flush() are called from that thread only.
+ * @see SQLogger::addSink()
+ */
+class ILogSink
+{
+    public:
+        virtual ~ILogSink() = default;
+
+        /**
+         * @brief Writes a batch of entries.
+         * @param entries The log entries, in logging order.
+         * @return bool True if the entries were written.
+         */
+        virtual bool write(const LogEntryList& entries) = 0;
+
+        /**
+         * @brief Hands buffered entries to the destination (called whenever the sink's queue runs empty).
+         */
+        virtual void flush() {}
+
+        /**
+         * @brief Gets a name of the sink for diagnostics.
+         * @return std::string Sink name.
+         */
+        virtual std::string getName() const = 0;
+};
+
+/**
+ * @class LogFileSink
+ * @brief Append-only file sink.
+ * Entries are formatted with LogExport and written through a LOG_EXPORT_BUFFER_SIZE
+ * stream buffer, so a batch costs one write call instead of one per line. The file is
+ * rotated to numbered segments (path.1 is the newest) by size and/or age; formats with
+ * a header and footer (XML, JSON) get them per segment.
+ */
+class LogFileSink : public ILogSink
+{
+    public:
+        /**
+         * @brief Opens (or creates) the current segment and its directory.
+         * An existing non-empty segment is appended to, except for XML and JSON, whose closed
+         * document is rotated first.
+         * @param path Path of the current segment.
+         * @param format Output format.
+         * @param maxBytes Rotation size in bytes (0 = no size limit).
+         * @param rotateInterval Rotation age of a segment (0 = no age limit).
+         * @param maxFiles Number of rotated segments kept (0 = rotated segments are deleted).
+         * @throws std::runtime_error If the file or its directory cannot be created.
+         */
+        LogFileSink(const std::string& path,
+                    const LogExport::Format& format = LogExport::Format::NDJSON,
+                    const uint64_t maxBytes = 0,
+                    const std::chrono::seconds& rotateInterval = std::chrono::seconds(0),
+                    const int maxFiles = LOG_FILE_SINK_DEFAULT_MAX_FILES);
+
+        /**
+         * @brief Writes the buffered entries and the format footer.
+         */
+        ~LogFileSink() override;
+
+        LogFileSink(const LogFileSink&) = delete;
+        LogFileSink& operator=(const LogFileSink&) = delete;
+
+        /**
+         * @brief Appends entries to the current segment, rotating it first when it is full or too old.
+         * @param entries The log entries.
+         * @return bool True if the entries were handed to the stream buffer.
+         */
+        bool write(const LogEntryList& entries) override;
+
+        /**
+         * @brief Writes the stream buffer to the file.
+         */
+        void flush() override;
+
+        /**
+         * @brief Gets the path of the current segment.
+         * @return std::string Path.
+         */
+        std::string getName() const override
+        {
+            return path;
+        }
+
+        /**
+         * @brief Gets the number of rotations since the sink was created.
+         * @return uint64_t Rotation count.
+         */
+        uint64_t getRotations() const;
+
+    private:
+        /**
+         * @brief Opens the current segment for appending and writes the header to an empty one.
+         * @return bool True if the segment is open.
+         */
+        bool open();
+
+        /**
+         * @brief Writes the footer and closes the current segment.
+         */
+        void close();
+
+        /**
+         * @brief Closes the current segment, shifts the numbered segments and opens a new one.
+         * @return bool True if the new segment is open.
+         */
+        bool rotate();
+
+        /**
+         * @brief Checks if the current segment must be rotated before more entries are appended.
+         * @return bool True if the segment holds entries and reached maxBytes or rotateInterval.
+         */
+        bool needRotation() const;
+
+        /**
+         * @brief Writes text to the current segment.
+         * @param data Text to write.
+         * @return bool True if the stream accepted the text.
+         */
+        bool writeText(const std::string& data);
+
+        std::string path; /**< Path of the current segment. */
+        LogExport::Format format; /**< Output format. */
+        uint64_t maxBytes; /**< Rotation size (0 = no size limit). */
+        std::chrono::seconds rotateInterval; /**< Rotation age (0 = no age limit). */
+        int maxFiles; /**< Rotated segments kept. */
+
+        mutable std::mutex mutex; /**< Guards the members below. */
+        std::vector<char> buffer; /**< Stream buffer. */
+        std::ofstream file; /**< Current segment. */
+        std::string text; /**< Formatted entries of the chunk being written (reused). */
+        uint64_t fileBytes = 0; /**< Size of the current segment including buffered bytes. */
+        bool empty = true; /**< No entry in the current segment yet. */
+        std::chrono::steady_clock::time_point opened; /**< Time the current segment was opened. */
+        uint64_t rotations = 0; /**< Rotations so far. */
+};
+
+#endif // LOG_SINK_H
@@ -27,16 +27,31 @@
 #include <condition_variable>
 #include <atomic>
 #include <chrono>
+#include <functional>
+#include <future>
 #include <sstream>
 #include <fstream>
 #include <iostream>
 #include "sqlogger_config.h"
 #include "sqlogger/log_entry.h"
 #include "sqlogger/log_helper.h"
+#include "sqlogger/log_sink.h"
 #include "sqlogger/internal/log_writer.h"
 #include "sqlogger/internal/log_reader.h"
 #include "sqlogger/internal/log_export.h"
 #include "sqlogger/internal/thread_pool.h"
+#include "sqlogger/internal/connection_pool.h"
+#include "sqlogger/internal/mpsc_ring.h"
+#include "sqlogger/internal/drain_tracker.h"
+#include "sqlogger/internal/log_stream.h"
+#include "sqlogger/internal/log_args.h"
+#include "sqlogger/internal/log_spool.h"
+#include "sqlogger/internal/error_log.h"
+#include "sqlogger/internal/latency_histogram.h"
+#include "sqlogger/internal/buffer_pool.h"
+#include "sqlogger/internal/batch_tuner.h"
+#include "sqlogger/internal/log_throttle.h"
+#include "sqlogger/internal/sink_queue.h"
 #include "sqlogger/log_config.h"
 
 // Macros for symbol export (for Windows)
@@ -54,17 +69,30 @@
 
 using namespace LogHelper;
 
+// Lowest level compiled into the SQLOG_* macros: 0 = Trace, 1 = Debug, 2 = Info, 3 = Warning, 4 = Error, 5 = Fatal
+#ifndef SQLG_MIN_COMPILED_LEVEL
+    #define SQLG_MIN_COMPILED_LEVEL 0
+#endif
+
+// Checks the level before the message is built: disabled calls evaluate no streamed operand,
+// and levels below SQLG_MIN_COMPILED_LEVEL are constant-false and compiled out
+#define SQLOG_AT(logger, level) \
+    if(!(static_cast<int>(level) >= SQLG_MIN_COMPILED_LEVEL && (logger).isLevelEnabled(level))) {} \
+    else LogMessage(logger, level, __func__, __FILE__, __LINE__, currentThreadId())
+
 // Macros for simplified logging
-#define SQLOG_TRACE(logger)   LogMessage(logger, LogLevel::Trace, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()))
-#define SQLOG_DEBUG(logger)   LogMessage(logger, LogLevel::Debug, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()))
-#define SQLOG_INFO(logger)    LogMessage(logger, LogLevel::Info, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()))
-#define SQLOG_WARNING(logger) LogMessage(logger, LogLevel::Warning, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()))
-#define SQLOG_ERROR(logger)   LogMessage(logger, LogLevel::Error, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()))
-#define SQLOG_FATAL(logger)   LogMessage(logger, LogLevel::Fatal, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()))
+#define SQLOG_TRACE(logger)   SQLOG_AT(logger, LogLevel::Trace)
+#define SQLOG_DEBUG(logger)   SQLOG_AT(logger, LogLevel::Debug)
+#define SQLOG_INFO(logger)    SQLOG_AT(logger, LogLevel::Info)
+#define SQLOG_WARNING(logger) SQLOG_AT(logger, LogLevel::Warning)
+#define SQLOG_ERROR(logger)   SQLOG_AT(logger, LogLevel::Error)
+#define SQLOG_FATAL(logger)   SQLOG_AT(logger, LogLevel::Fatal)
 
 // Log internal error macros
 #define LOG_INTERNAL_ERROR(message) logError(message, __func__, __FILE__, __LINE__)
 
+#define LOG_RING_IDLE_SLEEP_US 200 ///< Ring writer sleep interval when the ingestion ring is empty (microseconds).
+
 class LogManager; // Forward declaration
 
 /**
@@ -115,22 +143,42 @@ class LOGGER_API SQLogger
         /**
          * @struct Stats
          * @brief Structure representing statistics about the logger.
+         * The latency histograms have microsecond resolution, so the time spent queued
+         * (queueWait) can be told apart from the time spent in the database (dbExecute).
          */
         struct Stats
         {
             uint64_t totalLogged = 0;
             uint64_t totalFailed = 0;
+            uint64_t totalDropped = 0;
+            uint64_t totalSpooled = 0;
+            uint64_t totalReplayed = 0;
+            uint64_t totalSampled = 0; /**< Entries dropped by sampling (LogConfig::Config::sampleRate). */
+            uint64_t totalRateLimited = 0; /**< Entries dropped by a call-site or level rate limit. */
+            uint64_t totalRepeated = 0; /**< Identical entries folded into a "Last message repeated N times" entry. */
+            uint64_t totalSinkWritten = 0; /**< Entries written by the sinks added with addSink() (counted per sink). */
+            uint64_t totalSinkDropped = 0; /**< Entries a sink missed because its queue was full or its write failed (counted per sink). */
+            uint64_t tailCacheHits = 0; /**< getLogsByFilters() calls answered by the tail cache. */
+            uint64_t tailCacheMisses = 0; /**< getLogsByFilters() calls passed to the database by the tail cache. */
             uint64_t maxBatchSize = 0;
             uint64_t minBatchSize = 0;
             double avgBatchSize = 0.0;
             uint64_t maxProcessTimeMs = 0;
             uint64_t totalProcessTimeMs = 0;
             uint32_t flushCount = 0;
+            uint64_t maxProcessTimeUs = 0; /**< Longest processTask()/processBatch() call. */
+            uint64_t totalProcessTimeUs = 0; /**< Time spent in processTask()/processBatch(). */
+            uint64_t queueDepth = 0; /**< Entries handed over by log calls and not yet taken by a writer. */
+            uint64_t maxQueueDepth = 0; /**< Largest queueDepth seen. */
+            LatencyHistogram::Snapshot enqueueLatency; /**< Time a log call spends handing its entry over (per entry). */
+            LatencyHistogram::Snapshot queueWait; /**< Time from the hand-over until a writer takes the entry (per entry). */
+            LatencyHistogram::Snapshot dbExecute; /**< Time of one database write (per single or batch write). */
+            LatencyHistogram::Snapshot endToEnd; /**< Time from LogTask::timestamp until the entry is written (per written entry). */
 
             double avgProcessTime() const
             {
                 return (totalLogged > 0)
-                       ? static_cast<double>(totalProcessTimeMs) / totalLogged
+                       ? static_cast<double>(totalProcessTimeUs) / 1000.0 / totalLogged
                        : 0.0;
             };
         };
@@ -184,6 +232,102 @@ class LOGGER_API SQLogger
         */
         void log(const LogLevel level, const std::string& message);
 
+        /**
+         * @brief Logs entries received from another process (e.g. by a LogCollector).
+         * The entries take the same path as local log calls (ring, batch buffer or asynchronous
+         * drain), so entries of all senders are merged into the logger's batches and group commits.
+         * Level, message, location, thread ID and timestampUs are kept (the timestamp text is
+         * parsed if timestampUs is 0); entries below the minimum level are skipped.
+         * @param entries The log entries (with SQLG_USE_SOURCE_INFO, a positive sourceId is stored
+         * instead of the logger's own source).
+         * @return size_t Number of entries accepted.
+         */
+        size_t logEntries(const LogEntryList& entries);
+
+        /**
+         * @brief Logs a message with "{}" placeholders, e.g. logFormat(LogLevel::Info, "user {} took {} ms", id, ms).
+         * The arguments are copied into a compact LogArgs pack and the text is formatted
+         * when the entry is written, i.e. on the writer thread in asynchronous mode.
+         * The caller's function, file and line are taken from the format string.
+         * @param level The severity level of the log message.
+         * @param format The format string ("{}" placeholders, "{{" and "}}" escapes).
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void logFormat(const LogLevel level, const LogFormatString& format, const Args& ... args)
+        {
+            if(static_cast<int>(level) >= SQLG_MIN_COMPILED_LEVEL && isLevelEnabled(level))
+            {
+                logAdd(level, format.format, format.function, format.file, format.line, currentThreadId(), LogArgs::pack(args...));
+            }
+        }
+
+        /**
+         * @brief Logs a formatted Trace message (see logFormat()).
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void trace(const LogFormatString& format, const Args& ... args)
+        {
+            logFormat(LogLevel::Trace, format, args...);
+        }
+
+        /**
+         * @brief Logs a formatted Debug message (see logFormat()).
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void debug(const LogFormatString& format, const Args& ... args)
+        {
+            logFormat(LogLevel::Debug, format, args...);
+        }
+
+        /**
+         * @brief Logs a formatted Info message (see logFormat()).
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void info(const LogFormatString& format, const Args& ... args)
+        {
+            logFormat(LogLevel::Info, format, args...);
+        }
+
+        /**
+         * @brief Logs a formatted Warning message (see logFormat()).
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void warning(const LogFormatString& format, const Args& ... args)
+        {
+            logFormat(LogLevel::Warning, format, args...);
+        }
+
+        /**
+         * @brief Logs a formatted Error message (see logFormat()).
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void error(const LogFormatString& format, const Args& ... args)
+        {
+            logFormat(LogLevel::Error, format, args...);
+        }
+
+        /**
+         * @brief Logs a formatted Fatal message (see logFormat()).
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename... Args>
+        void fatal(const LogFormatString& format, const Args& ... args)
+        {
+            logFormat(LogLevel::Fatal, format, args...);
+        }
+
         /**
          * @brief Clears all log entries from the database.
          */
@@ -195,6 +339,10 @@ class LOGGER_API SQLogger
 
         /**
         * @brief Retrieves log entries from the database matching specified filters.
+        * With LogConfig::Config::tailCacheSize set, queries with a recent lower timestamp
+        * bound are answered from the tail cache without the database.
+        * With LogConfig::Config::readPoolSize set, the query runs on a separate connection
+        * and does not block logging.
         *
         * @param filters Vector of Filter objects defining search criteria.
         *        Each filter specifies:
@@ -214,6 +362,102 @@ class LOGGER_API SQLogger
                                       const int limit = -1,
                                       const int offset = -1);
 
+        /**
+        * @brief Runs getLogsByFilters() on the query threads without blocking the caller.
+        * With LogConfig::Config::readPoolSize set there is one query thread per read connection,
+        * so independent queries run concurrently; otherwise one thread serializes them on the
+        * write connection.
+        * @param filters Vector of Filter objects defining search criteria.
+        * @param limit Maximum number of log entries to return (-1 = no limit).
+        * @param offset Number of log entries to skip (-1 = disabled).
+        * @return std::future<LogEntryList> Entries, or the query's exception
+        *         (std::runtime_error once the logger is shut down).
+        */
+        std::future<LogEntryList> getLogsByFiltersAsync(const std::vector<Filter> & filters,
+                const int limit = -1,
+                const int offset = -1);
+
+        /**
+        * @brief Runs getLogsByFilters() on the query threads and passes the result to a callback
+        * (the callback style of ITransport::LogPullHandler).
+        * The callback runs on a query thread; a failed query is reported to the error log and
+        * passes an empty list.
+        * @param filters Vector of Filter objects defining search criteria.
+        * @param limit Maximum number of log entries to return (-1 = no limit).
+        * @param offset Number of log entries to skip (-1 = disabled).
+        * @param callback Receives the entries.
+        */
+        void getLogsByFiltersAsync(const std::vector<Filter> & filters,
+                                   const int limit,
+                                   const int offset,
+                                   std::function<void(LogEntryList)> callback);
+
+        /**
+        * @brief Retrieves log entries whose message contains all of the given words.
+        * Shortcut for a FILTER_OP_MATCH filter on the message column, which can be combined
+        * with other filters in getLogsByFilters(). With LogConfig::Config::fullTextSearch set
+        * the words are looked up in the full-text index (whole words, case insensitive),
+        * otherwise every word is matched as a substring with LIKE.
+        * @param text Search words separated by whitespace (no words = all entries).
+        * @param limit Maximum number of log entries to return (-1 = no limit).
+        * @param offset Number of log entries to skip (-1 = disabled), requires positive limit.
+        * @return LogEntryList List of log entries ordered by timestamp (descending).
+        */
+        LogEntryList searchLogs(const std::string& text,
+                                const int limit = -1,
+                                const int offset = -1);
+
+        /**
+        * @brief Counts the log entries matching the filters per value of a column.
+        * The database groups and counts the rows (GROUP BY), only the counts are transferred.
+        * @param field Log table column, e.g. FIELD_LOG_LEVEL or FIELD_LOG_FILE.
+        * @param filters Filters, combined with AND.
+        * @return LogCounts Number of entries per value (NULL values are counted under "").
+        * @throws std::invalid_argument If the field or a filter op is invalid.
+        */
+        LogCounts countBy(const std::string& field, const std::vector<Filter> & filters = {});
+
+        /**
+        * @brief Counts the log entries matching the filters per time bucket.
+        * @param bucketSeconds Bucket width in seconds (e.g. 60 for entries per minute),
+        *        buckets are aligned to multiples of it.
+        * @param filters Filters, combined with AND.
+        * @return LogCounts Number of entries per bucket start (TIMESTAMP_FMT local time), empty buckets are omitted.
+        * @throws std::invalid_argument If the bucket width or a filter op is invalid.
+        */
+        LogCounts histogram(const int bucketSeconds, const std::vector<Filter> & filters = {});
+
+        /**
+        * @brief Counts the log entries matching the filters per time bucket and value of a column,
+        * e.g. errors per minute per source.
+        * @param field Log table column, e.g. FIELD_LOG_SOURCES_ID.
+        * @param bucketSeconds Bucket width in seconds, buckets are aligned to multiples of it.
+        * @param filters Filters, combined with AND.
+        * @return LogHistogram Number of entries per bucket start (TIMESTAMP_FMT local time) and value.
+        * @throws std::invalid_argument If the field, the bucket width or a filter op is invalid.
+        */
+        LogHistogram histogramBy(const std::string& field, const int bucketSeconds, const std::vector<Filter> & filters = {});
+
+        /**
+        * @brief Streams log entries matching the filters to a callback, ordered by ID.
+        * Memory use is constant regardless of the number of matching entries.
+        * @param filters Vector of Filter objects defining search criteria.
+        * @param callback Function called for each entry; return false to stop the scan.
+        * @param pageSize Rows per keyset page (WHERE id > last ORDER BY id LIMIT pageSize).
+        *        - 0 streams everything with a single query (default); without LogConfig::Config::readPoolSize
+        *        the callback runs with the database lock held and must not log to or query this logger
+        *        - Positive values read a page, release the database lock and then pass the page to the
+        *        callback, so logging is not blocked and the callback may log (memory use grows with pageSize)
+        *        (with LogConfig::Config::readPoolSize set logging is never blocked by the scan)
+        * @param afterId Only entries with an ID greater than this are visited (resume point).
+        * @return size_t Number of entries passed to the callback.
+        * @throws std::runtime_error If a query fails.
+        */
+        size_t forEachLog(const std::vector<Filter> & filters,
+                          const LogCallback& callback,
+                          const int pageSize = 0,
+                          const int64_t afterId = 0);
+
         /**
          * @brief Retrieves all log entries.
          * @param limit Maximum number of log entries to return.
@@ -286,12 +530,74 @@ class LOGGER_API SQLogger
         void setLogLevel(LogLevel minLevel);
 
         /**
-         * @brief Waits until the task queue is empty.
+         * @brief Waits until every task handed to the writers so far has been written.
+         * Returns as soon as the last of them lands; tasks logged during the wait are not waited for.
          * @param timeout The maximum time to wait.
-         * @return True if the queue is empty within the timeout, false otherwise.
+         * @return True if the tasks were written within the timeout, false otherwise.
          */
         bool waitUntilEmpty(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
 
+        /**
+         * @brief Adds a sink that receives every entry handed to the logger from now on.
+         * The sink gets its own bounded queue and writer thread, fed by the log call before the
+         * entry takes the database path, so neither a slow database nor another sink delays it.
+         * A full queue drops the sink's copy of new entries (see Stats::totalSinkDropped).
+         * @param sink The sink.
+         * @param queueSize Maximum number of entries queued for the sink.
+         * @see LogConfig::Config::fileSinkPath
+         */
+        void addSink(std::shared_ptr<ILogSink> sink, const size_t queueSize = LOG_DEFAULT_SINK_QUEUE_SIZE);
+
+        /**
+         * @brief Waits until every sink has written and flushed the entries queued so far.
+         * @param timeout The maximum time to wait for each sink.
+         * @return True if every sink queue ran empty within the timeout, false otherwise.
+         */
+        bool waitForSinks(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
+
+        /**
+         * @brief Waits until entries logged before the given time point are committed to the database.
+         * Flushes the batch buffer, waits for the writers and commits the open group-commit transaction.
+         * Entries held in the local spool count as durable (see waitForSpool()).
+         * @param before Entries whose log call returned before this time point are waited for.
+         * @param timeout The maximum time to wait.
+         * @return True if the entries are durable within the timeout, false otherwise.
+         */
+        bool waitUntilDurable(const std::chrono::system_clock::time_point& before = std::chrono::system_clock::now(),
+                              const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
+
+        /**
+         * @brief Waits until the local spool has been replayed into the database.
+         * @param timeout The maximum time to wait.
+         * @return True if the spool is empty (or disabled) within the timeout, false otherwise.
+         * @see LogConfig::Config::spoolPath
+         */
+        bool waitForSpool(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
+
+        /**
+         * @brief Enters bulk-load mode: drops the configured log table indexes.
+         * Rows written until endBulkLoad() maintain no secondary index, which makes a
+         * large backfill much cheaper; queries without an index scan the table meanwhile.
+         * @return True if the indexes were dropped, false otherwise.
+         * @see Config::deferIndexes
+         */
+        bool beginBulkLoad();
+
+        /**
+         * @brief Leaves bulk-load mode: waits for pending writes and rebuilds the log table indexes.
+         * @param timeout The maximum time to wait for pending writes before building the indexes.
+         * @return True if every index was built, false otherwise.
+         */
+        bool endBulkLoad(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(1000));
+
+        /**
+         * @brief Applies the retention policy now: drops the expired daily partitions with all their rows.
+         * Writes apply it as well, each time they reach the newest partition.
+         * @return size_t Number of dropped partitions (0 if the log table is not partitioned).
+         * @see LogConfig::Config::partitioning, LogConfig::Config::retentionDays
+         */
+        size_t applyRetention();
+
         /**
         * @brief Exports log entries to a specified format file.
         * @param filePath The path to the output file.
@@ -299,13 +605,48 @@ class LOGGER_API SQLogger
         * @param entryList The list of log entries to export.
         * @param delimiter The delimiter to use between fields.
         * @param name Whether to include field names in the output.
+        * @param compression Output compression.
         */
-        static void exportTo(const std::string& filePath, const LogExport::Format& format, const LogEntryList& entryList, const std::string& delimiter = ENTRY_DELIMITER, bool name = true);
+        static void exportTo(const std::string& filePath,
+                             const LogExport::Format& format,
+                             const LogEntryList& entryList,
+                             const std::string& delimiter = ENTRY_DELIMITER,
+                             bool name = true,
+                             const LogCompress::Compression& compression = LogCompress::Compression::None);
 
+        /**
+        * @brief Exports the log entries matching the filters straight from the database, ordered by ID.
+        * Entries are streamed page by page (see forEachLog()) into a LogExport::Writer,
+        * so the result set is never held in memory.
+        * @param filePath The path to the output file.
+        * @param format Format of the output file.
+        * @param filters Vector of Filter objects defining search criteria (empty exports everything).
+        * @param delimiter The delimiter to use between fields.
+        * @param name Whether to include field names in the output.
+        * @param threads Number of formatting (and compression) threads (0 or 1 formats on the calling thread).
+        * @param compression Output compression, applied per chunk on the formatting threads.
+        * @return size_t Number of exported entries.
+        * @throws std::runtime_error If the file cannot be created or written, or reading the entries fails.
+        */
+        size_t exportLogs(const std::string& filePath,
+                          const LogExport::Format& format,
+                          const std::vector<Filter> & filters = {},
+                          const std::string& delimiter = ENTRY_DELIMITER,
+                          bool name = true,
+                          const size_t threads = LOG_EXPORT_DEFAULT_THREADS,
+                          const LogCompress::Compression& compression = LogCompress::Compression::None);
+
+        /**
+        * @brief Sets the internal error log file (buffered lines are written to the previous one first).
+        * @param errLogFile The error log file path.
+        */
         void setErrorLogPath(const std::string& errLogFile);
 
         /**
         * @brief Logs an error message to the error log file.
+        * The line is buffered and written by a background thread; repeated messages
+        * and messages over the rate limit are reported as counts.
+        * @see ErrorLog
         * @param errorMessage The error message to log.
         * @param function The function where the log message was created.
         * @param file The file where the log message was created.
@@ -358,12 +699,22 @@ class LOGGER_API SQLogger
 
         /**
          * @brief Gets the current batch size used for buffered logging operations.
+         * With adaptive batching this is the size currently chosen by the tuner.
          * @return int The maximum number of log entries that will be buffered
          * before being written to the database. Returns 0 if batching is disabled.
          * @see setBatchSize()
+         * @see LogConfig::Config::adaptiveBatch
          */
         int getBatchSize() const;
 
+        /**
+         * @brief Gets the current maximum age of a partial batch before a background flush.
+         * With adaptive batching this is the interval currently chosen by the tuner.
+         * @return std::chrono::milliseconds Flush interval (0 = disabled).
+         * @see LogConfig::Config::flushIntervalMs
+         */
+        std::chrono::milliseconds getFlushInterval() const;
+
         /**
          * @brief Gets the type of database currently used by the logger.
          * @return DataBaseType The database type (SQLite, MySQL, PostgreSQL, etc.).
@@ -378,6 +729,17 @@ class LOGGER_API SQLogger
          */
         LogLevel getMinLogLevel() const;
 
+        /**
+         * @brief Checks if messages of the given level are logged.
+         * Lock-free, used by the SQLOG_* macros before a message is built.
+         * @param level The severity level to check.
+         * @return bool True if level is at or above the minimum log level.
+         */
+        bool isLevelEnabled(const LogLevel level) const
+        {
+            return level >= minLevel.load(std::memory_order_relaxed);
+        }
+
         /**
          * @brief Gets the number of worker threads used for asynchronous logging.
          * @return size_t Number of active worker threads processing log entries.
@@ -423,6 +785,15 @@ class LOGGER_API SQLogger
         */
         int addSource(const std::string& name, const std::string& uuid);
 
+        /**
+        * @brief Gets the ID of a source by UUID, adding the source if it is new.
+        * Unlike addSource(), the logger's own source is not changed (used for remote senders).
+        * @param name The name of the source.
+        * @param uuid The UUID of the source.
+        * @return The source ID, or SOURCE_NOT_FOUND if the source could not be added.
+        */
+        int findOrAddSource(const std::string& name, const std::string& uuid);
+
         /**
          * @brief Retrieves a source by its source ID.
          * @param sourceId The source ID of the source to retrieve.
@@ -486,6 +857,9 @@ class LOGGER_API SQLogger
 #ifdef SQLG_USE_SOURCE_INFO
             int sourceId;  /**< The source ID. */
 #endif
+            LogArgs args; /**< Deferred format arguments (message is the format string if active). */
+            uint64_t sequence = 0; /**< Drain sequence number (asynchronous writes only). */
+            std::chrono::steady_clock::time_point enqueued{}; /**< Time the task was handed to enqueueTask(). */
         };
 
         friend class LogMessage;
@@ -498,20 +872,51 @@ class LOGGER_API SQLogger
         * @param file The file where the log message was created.
         * @param line The line number where the log message was created.
         * @param threadId The ID of the thread that created the log message.
+        * @param args Format arguments (if active, message is their format string).
         */
-        void logAdd(const LogLevel level, const std::string& message, const std::string& function, const std::string& file, int line, const std::string& threadId);
+        void logAdd(const LogLevel level, std::string_view message, std::string_view function, std::string_view file, int line, std::string_view threadId,
+                    LogArgs args = LogArgs());
+
+        /**
+         * @brief Hands a task to the configured write path and records the enqueue latency and queue depth.
+         * @param task The log task.
+         * @return bool False if the task was dropped by the ring back-pressure policy.
+         * @see dispatchTask()
+         */
+        bool enqueueTask(LogTask&& task);
+
+        /**
+         * @brief Logs the "Last message repeated N times" entry of a call site.
+         * @param repeat The pending repeat count.
+         * @param threadId The ID of the thread logging the entry.
+         */
+        void logRepeat(const LogThrottle::Repeat& repeat, std::string_view threadId);
+
+        /**
+         * @brief Logs the pending repeat counts of every call site (before a flush).
+         */
+        void logPendingRepeats();
+
+        /**
+         * @brief Hands a task to the configured write path (ring, batch buffer, synchronous or asynchronous write).
+         * @param task The log task.
+         * @return bool False if the task was dropped by the ring back-pressure policy.
+         */
+        bool dispatchTask(LogTask&& task);
 
         /**
          * @brief Processes a single log task.
-         * @param task The log task to process.
+         * The task's strings are moved into the written entry.
+         * @param task The log task to process (only its level, timestamps and sequence are kept).
          */
-        void processTask(const LogTask& task);
+        void processTask(LogTask& task);
 
         /**
          * @brief Processes a batch of log tasks.
-         * @param batch The batch of log tasks to process.
+         * The tasks' strings are moved into the written entries, the entry list is taken from entryBuffers.
+         * @param batch The batch of log tasks to process (only their level, timestamps and sequence are kept).
          */
-        void processBatch(const std::vector<LogTask> & batch);
+        void processBatch(std::vector<LogTask> & batch);
 
         /**
          * @brief Forces immediate processing (writes to the database) of all batched log entries, if useBatch = true.
@@ -526,42 +931,285 @@ class LOGGER_API SQLogger
          */
         void flushBatch();
 
+        /**
+         * @brief Writes a batch ending with a priority entry in the calling thread and commits
+         * the open group-commit transaction. Called without batchMutex, so other producers keep
+         * buffering; in async mode it first waits for the batches handed to the thread pool
+         * before it, so the priority entry is stored behind them.
+         * @param batch The batch taken out of the batch buffer.
+         * @param before drain.submitted() when the batch was taken out.
+         */
+        void writePriorityBatch(std::vector<LogTask> & batch, const uint64_t before);
+
+        /**
+         * @brief Checks if entries of the given level take the priority path.
+         * @param level The severity level to check.
+         * @return bool True if level is at or above LogConfig::Config::priorityLevel.
+         */
+        bool isPriorityLevel(const LogLevel level) const
+        {
+            return config.priorityLevel.has_value() && level >= config.priorityLevel.value();
+        }
+
         /**
         * @brief Converts an internal LogTask structure to a persistent LogEntry.
-        * @param task The source LogTask containing raw logging information.
+        * @param task The source LogTask containing raw logging information (its strings are moved from).
         * @return LogEntry Log entry ready for storage.
         * @note Automatically generates timestamp and log level in string representation.
         * @warning The returned entry's ID field will be 0 until stored in database.
         * @warning Returned LogEntry not contain SourceInfo information.
         */
-        LogEntry convertTaskToEntry(const LogTask& task) const;
+        LogEntry convertTaskToEntry(LogTask&& task) const;
 
         /**
          * @brief Updates statistics for a single log entry processing operation.
          * This method updates internal performance metrics when a single log entry
          * has been processed (written to database or exported).
-         * @param processTimeMs The time taken to process the log entry in milliseconds.
+         * @param processTimeUs The time taken to process the log entry in microseconds.
          * @param success Whether the operation was successful (default: true).
          * If false, increments the failed entries counter.
          */
-        void updateSingleEntryStats(const uint64_t processTimeMs, const bool success = true);
+        void updateSingleEntryStats(const uint64_t processTimeUs, const bool success = true);
 
         /**
          * @brief Updates statistics for batch log entries processing.
          * Updates aggregated performance metrics when a batch of log entries
          * has been processed. Handles both successful and failed batch operations.
          * @param batchSize Number of log entries in the processed batch.
-         * @param processTimeMs Total time taken to process the entire batch in milliseconds.
+         * @param processTimeUs Total time taken to process the entire batch in microseconds.
          * @param success Whether the batch operation succeeded (default: true).
          * If false, all entries in batch are counted as failed.
          */
-        void updateBatchStats(const size_t batchSize, const uint64_t processTimeMs, const bool success = true);
+        void updateBatchStats(const size_t batchSize, const uint64_t processTimeUs, const bool success = true);
+
+        /**
+         * @brief Records that a writer took a task: its queue wait, and the lower queue depth.
+         * @param task The log task.
+         * @param taken The time the writer took the task.
+         */
+        void recordTaken(const LogTask& task, const std::chrono::steady_clock::time_point& taken);
+
+        /**
+         * @brief Records the end-to-end latency of a written task.
+         * @param task The log task.
+         * @param written The time the task was written.
+         */
+        void recordWritten(const LogTask& task, const std::chrono::system_clock::time_point& written);
 
         /**
         * @brief Shuts down the logger and stops all worker threads.
         */
         void shutdown();
 
+        /**
+         * @brief Background flush timer thread body.
+         * Flushes the batch buffer once its oldest entry is older than getFlushInterval()
+         * and commits the open group transaction once groupCommitWindowMs has elapsed.
+         * @see LogConfig::Config::flushIntervalMs
+         * @see LogConfig::Config::groupCommitWindowMs
+         */
+        void flushTimerLoop();
+
+        /**
+         * @brief Stops the background flush timer thread.
+         */
+        void stopFlushTimer();
+
+        /**
+         * @brief Commits the open group-commit transaction (if any).
+         * @param force If false, commits only when the group window has elapsed.
+         * @see LogWriter::commitPending()
+         */
+        void commitGroup(const bool force = true);
+
+        /**
+         * @brief Counts the entries the writer lost with a rolled back group as failed.
+         * @note Must be called with dbMutex held.
+         * @see LogWriter::takeLostEntries()
+         */
+        void countLostEntries();
+
+        /**
+         * @brief Gets the approximate memory footprint of a task, used for maxBatchBytes accounting.
+         * @param task The log task.
+         * @return size_t Size in bytes (struct size plus string payloads).
+         */
+        static size_t taskSizeBytes(const LogTask& task);
+
+        /**
+         * @brief Pushes a task into the ingestion ring applying the back-pressure policy.
+         * Lock-free on the fast path; when the ring is full the task is either dropped
+         * or the producer spins until the writer frees a slot (see BackPressure).
+         * @param task The log task to enqueue.
+         * @return True if the task was enqueued, false if it was dropped.
+         * @see LogConfig::Config::backPressure
+         */
+        bool ringPush(LogTask&& task);
+
+        /**
+         * @brief Ring writer thread body.
+         * Drains the ingestion ring, builds batches of up to batchSize tasks and
+         * writes them to the database. Exits after the ring is drained once stop is requested.
+         */
+        void ringWriterLoop();
+
+        /**
+         * @brief Thread pool task writing the tasks queued by asynchronous non-batch logging.
+         * Takes everything queued so far and writes it with as few batch INSERTs as the
+         * database allows, so concurrent log calls do not each wait for dbMutex.
+         * With a connection pool, up to connectionPoolSize drains run in parallel.
+         */
+        void drainAsyncTasks();
+
+        /**
+         * @brief Reports written tasks to the drain tracker.
+         * Consecutive sequence numbers are reported as one range.
+         * @param tasks The written (or failed) tasks.
+         */
+        void completeTasks(const std::vector<LogTask> & tasks);
+
+        /**
+         * @brief Writes entries through a connection leased from the connection pool.
+         * Used instead of the shared connection (and dbMutex) when connectionPoolSize > 0,
+         * so asynchronous workers write in parallel.
+         * @param entries The log entries to write.
+         * @return True if the entries were written successfully, false otherwise.
+         * @throws std::runtime_error If no pooled connection could be opened.
+         */
+        bool writePooled(const LogEntryList& entries);
+
+        /**
+         * @brief Runs a query with a log reader.
+         * With a read pool the reader works on a leased query connection, so logging keeps
+         * writing while the query runs (SQLite WAL readers see the last committed snapshot,
+         * a replica may lag behind the primary). The open group-commit transaction is
+         * committed first, so every entry written so far is visible. Without a read pool
+         * the shared reader is used under logMutex and dbMutex.
+         * @tparam Func Callable taking LogReader&.
+         * @param query The query.
+         * @return The result of the query.
+         * @throws std::runtime_error If no pooled connection could be opened.
+         */
+        template<typename Func>
+        auto withReader(Func&& query)
+        {
+            if(!readPool)
+            {
+                std::scoped_lock lock(logMutex, dbMutex);
+                return query(reader);
+            }
+
+            if(config.groupCommitBatches.value_or(LOG_DEFAULT_GROUP_COMMIT_BATCHES) > 1)
+            {
+                commitGroup();
+            }
+
+            ConnectionPool::Lease lease = readPool->acquire();
+            LogReader pooledReader(lease.get(), config.databaseTable.value_or(LOG_TABLE_NAME));
+            pooledReader.setTimestampFormat(config.timestampFormat.value_or(TimestampFormat::Text));
+            pooledReader.setCompactSchema(dictionaries);
+            pooledReader.setFullTextSearch(fullTextIndexed);
+            pooledReader.setCipher(cipher);
+            pooledReader.setMessageCompression(messageCompressor);
+            try
+            {
+                return query(pooledReader);
+            }
+            catch(...)
+            {
+                // Reopen on next use in case the connection is broken
+                lease.invalidate();
+                throw;
+            }
+        }
+
+        /**
+         * @brief Stops the ring writer thread after it drains the ingestion ring.
+         */
+        void stopRingWriter();
+
+        /**
+         * @brief Writes entries through the pooled or the shared connection.
+         * With message encryption the batch is encrypted first, by the calling worker and
+         * without dbMutex, so pooled workers encrypt in parallel.
+         * @param entries The log entries to write.
+         * @return True if the entries were written successfully, false otherwise.
+         */
+        bool writeEntries(const LogEntryList& entries);
+
+        /**
+         * @brief Writes entries as they are stored through the pooled or the shared connection.
+         * @param entries The log entries to write (messages already encrypted if enabled).
+         * @return True if the entries were written successfully, false otherwise.
+         */
+        bool writeStored(const LogEntryList& entries);
+
+        /**
+         * @brief Writes entries to the database, or to the local spool if it is enabled and
+         * the write fails. While the spool holds entries, new entries are appended behind
+         * them without touching the database, so the order is kept and a failing backend
+         * (and its reconnect) stays off the logging path until the spool is replayed.
+         * With message encryption the spool holds the encrypted entries, as stored.
+         * @param entries The log entries to write.
+         * @return True if the entries were written or spooled, false otherwise.
+         */
+        bool writeOrSpool(const LogEntryList& entries);
+
+        /**
+         * @brief Appends entries to the local spool and wakes the spool drainer.
+         * @param entries The log entries to spool (messages already encrypted if enabled).
+         * @return True if the entries were spooled, false if the spool is full or failed.
+         */
+        bool spoolEntries(const LogEntryList& entries);
+
+        /**
+         * @brief Replays the oldest spooled entries into the database.
+         * The entries are consumed only after they are written and committed.
+         * @param maxEntries Entries replayed in one batch.
+         * @return True if the entries were replayed, false if writing failed.
+         */
+        bool replaySpool(const size_t maxEntries);
+
+        /**
+         * @brief Spool drainer thread body.
+         * Replays the spool in batches of the database's maximum batch size while it holds
+         * entries; a failed replay is retried after spoolRetryMs, doubled up to LOG_SPOOL_RETRY_MAX_MS.
+         */
+        void spoolDrainerLoop();
+
+        /**
+         * @brief Stops the spool drainer thread. Unreplayed entries stay in the spool file.
+         */
+        void stopSpoolDrainer();
+
+        /**
+         * @brief Writes the queued entries of every sink and stops the sink threads.
+         */
+        void stopSinks();
+
+        /**
+         * @brief Applies the configured affinity and priority to the calling logger thread.
+         * Failures are reported to the error log; the thread keeps running unpinned.
+         */
+        void applyThreadSettings();
+
+        /**
+         * @brief Queues a task on the query threads, starting them on first use.
+         * @param task The task to run.
+         * @return bool False if the logger is shut down (the task is not run).
+         */
+        bool enqueueQuery(std::function<void()> task);
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Registers the logger's source (constructor argument, Config::sourceUuid or a new default source).
+         * Uses one upsert where the database supports INSERT ... RETURNING. The caller holds dbMutex.
+         */
+        void registerSource();
+#endif
+
+        ErrorLog errorLog; /**< Internal error log (declared first, so it outlives every thread that reports errors). */
+
         std::mutex logMutex; /**< Mutex for log access synchronization. */
 
         std::mutex dbMutex; /**< Mutex for database access synchronization. */
@@ -572,30 +1220,103 @@ class LOGGER_API SQLogger
 
         LogWriter writer; /**< The log writer used for writing log entries. */
         LogReader reader; /**< The log reader used for reading log entries. */
-
+        std::shared_ptr<LogDictionaries> dictionaries; /**< Dictionary cache of the compact schema, shared with pooled writers (nullptr = standard schema). */
+        std::shared_ptr<LogTailCache> tailCache; /**< Recently written entries answering getLogsByFilters() (nullptr = disabled). */
+        std::shared_ptr<LogPartitions> partitions; /**< Daily partitions of the log table, shared with pooled writers (nullptr = plain table). */
+        bool fullTextSearch = false; /**< Whether the writer maintains a full-text index on the message column. */
+        std::atomic<bool> fullTextIndexed{ false }; /**< Whether the full-text index exists (MATCH filters use it, dropped in bulk-load mode). */
+        std::shared_ptr<LogCipher> cipher; /**< Cipher of the message column, shared with pooled readers (nullptr = plaintext). */
+        std::shared_ptr<LogMessageCompressor> messageCompressor; /**< Compressor of the message column, shared with pooled writers and readers (nullptr = plain messages). */
+
+        std::unique_ptr<ConnectionPool> connectionPool; /**< Parallel write connections for asynchronous workers (nullptr if disabled). */
+        std::unique_ptr<ConnectionPool> readPool; /**< Query connections used without logMutex and dbMutex (nullptr = queries use the write connection). */
         ThreadPool threadPool; /**< The thread pool for processing log tasks. */
+        std::mutex queryPoolMutex; /**< Guards queryPool and queryPoolStopped. */
+        std::unique_ptr<ThreadPool> queryPool; /**< Threads of getLogsByFiltersAsync() (started on first use). */
+        size_t queryThreads = 1; /**< Size of queryPool (one per read connection). */
+        bool queryPoolStopped = false; /**< Set by shutdown(), no more queries are queued. */
 
         std::atomic<bool> running; /**< Flag indicating whether the logger is running. */
+        std::atomic<LogLevel> minLevel; /**< Minimum log level (mirrors config.minLogLevel for lock-free checks). */
 
-        mutable std::mutex statsMutex; /**< Mutex for statistics synchronization. */
-        Stats currentStats; /**< Current logger statistics. */
+        /**
+         * @struct StatsCounters
+         * @brief Lock-free counters behind getStats() (updated with relaxed atomics by any thread).
+         */
+        struct StatsCounters
+        {
+            std::atomic<uint64_t> totalLogged{ 0 }; /**< Processed entries. */
+            std::atomic<uint64_t> totalFailed{ 0 }; /**< Entries that could not be written or spooled. */
+            std::atomic<uint64_t> totalSpooled{ 0 }; /**< Entries appended to the spool. */
+            std::atomic<uint64_t> totalReplayed{ 0 }; /**< Entries replayed from the spool. */
+            std::atomic<uint64_t> batchEntries{ 0 }; /**< Entries processed by processBatch(). */
+            std::atomic<uint64_t> maxBatchSize{ 0 }; /**< Largest batch. */
+            std::atomic<uint64_t> minBatchSize{ UINT64_MAX }; /**< Smallest batch (UINT64_MAX if none). */
+            std::atomic<uint32_t> flushCount{ 0 }; /**< Batches processed. */
+            std::atomic<uint64_t> totalProcessTimeUs{ 0 }; /**< Time spent processing. */
+            std::atomic<uint64_t> maxProcessTimeUs{ 0 }; /**< Longest processing call. */
+            std::atomic<uint64_t> queueDepth{ 0 }; /**< Entries handed over and not yet taken by a writer. */
+            std::atomic<uint64_t> maxQueueDepth{ 0 }; /**< Largest queue depth. */
+            LatencyHistogram enqueueLatency; /**< See Stats::enqueueLatency. */
+            LatencyHistogram queueWait; /**< See Stats::queueWait. */
+            LatencyHistogram dbExecute; /**< See Stats::dbExecute. */
+            LatencyHistogram endToEnd; /**< See Stats::endToEnd. */
+        };
+
+        StatsCounters statsCounters; /**< Current logger statistics. */
 
         std::recursive_mutex batchMutex; /**< Mutex for batch access synchronization. */
         std::vector<LogTask> batchBuffer; /**< Batch buffer (LogTasks). */
+        size_t batchBytes = 0; /**< Approximate size of the batch buffer in bytes. */
+
+        std::unique_ptr<LogThrottle> throttle; /**< Sampling, rate limiting and duplicate suppression (nullptr if disabled). */
+        std::unique_ptr<BatchTuner> batchTuner; /**< Batch size and flush interval controller (nullptr if adaptiveBatch = false). */
+
+        /// Sink queues, replaced as a whole by addSink() so log calls read them without a lock
+        using SinkQueueList = std::vector<std::shared_ptr<SinkQueue<LogTask>>>;
+        std::shared_ptr<const SinkQueueList> sinkQueues; /**< Accessed with std::atomic_load()/std::atomic_store() (nullptr = no sinks). */
+        std::mutex sinksMutex; /**< Serializes addSink() and stopSinks(). */
+
+        BufferPool<LogTask> taskBuffers; /**< Recycled task vectors (batch buffer and asynchronous hand-off). */
+        BufferPool<LogEntry> entryBuffers; /**< Recycled entry lists of processTask()/processBatch(). */
+
+        std::thread flushTimer; /**< Background thread flushing aged partial batches. */
+        std::atomic<bool> flushTimerStarted{ false }; /**< True while the flush timer runs; read by producers instead of flushTimer.joinable(). */
+        std::mutex flushTimerMutex; /**< Mutex for flush timer wake-ups. */
+        std::condition_variable flushTimerCondition; /**< Wakes the flush timer on shutdown or when the batch buffer starts filling. */
+        bool flushTimerStop = false; /**< Flag to stop the flush timer (guarded by flushTimerMutex). */
+        uint64_t flushTimerWakes = 0; /**< Wake-up generation, bumped when the batch buffer becomes non-empty (guarded by flushTimerMutex). */
+
+        std::unique_ptr<MPSCRing<LogTask>> ingestRing; /**< Lock-free ingestion ring (nullptr if useRing = false). */
+        std::thread ringWriter; /**< Thread draining the ingestion ring. */
+        std::atomic<bool> ringStop{ false }; /**< Flag to stop the ring writer. */
+        std::atomic<uint64_t> ringDropped{ 0 }; /**< Tasks dropped by the back-pressure policy. */
+
+        std::mutex asyncMutex; /**< Mutex for the asynchronous hand-off queue. */
+        std::vector<LogTask> asyncTasks; /**< Tasks logged asynchronously and not yet taken by drainAsyncTasks(). */
+        size_t asyncDrainsScheduled = 0; /**< drainAsyncTasks() tasks queued or running (guarded by asyncMutex). */
+
+        DrainTracker drain; /**< Completion tracking of asynchronously written tasks. */
+
+        std::unique_ptr<LogSpool> spool; /**< Local spool of entries that could not be written (nullptr if disabled). */
+        std::thread spoolDrainer; /**< Thread replaying the spool into the database. */
+        std::mutex spoolMutex; /**< Mutex for spool drainer wake-ups. */
+        std::condition_variable spoolCondition; /**< Wakes the spool drainer and waitForSpool(). */
+        bool spoolStop = false; /**< Flag to stop the spool drainer (guarded by spoolMutex). */
 
 #ifdef SQLG_USE_SOURCE_INFO
         std::atomic<int> sourceId; /**< The source ID. */
         std::optional<SourceInfo> sourceInfo; /**< The source info. */
         mutable std::mutex sourceMutex;  /**< Mutex for source info synchronization. */
 #endif
-        std::mutex errorLogMutex;
-        std::string errorLogFile = ERR_LOG_FILE;
 
 };
 
 /**
  * @class LogMessage
  * @brief Helper class for simplified logging.
+ * Source location and thread ID are only referenced (the macros pass string literals
+ * and the cached thread ID), and the text is formatted into a reused per-thread LogStream.
  */
 class LogMessage
 {
@@ -608,15 +1329,16 @@ class LogMessage
          * @param file The file where the log message was created.
          * @param line The line number where the log message was created.
          * @param threadId The ID of the thread that created the log message.
+         * @note func, file and threadId are not copied and must outlive the LogMessage.
          */
-        LogMessage(SQLogger& logger, LogLevel level, const std::string& func, const std::string& file, int line, const std::string& threadId)
-            : logger(logger), level(level), func(func), file(file), line(line), threadId(threadId) {}
+        LogMessage(SQLogger& logger, LogLevel level, std::string_view func, std::string_view file, int line, std::string_view threadId)
+            : logger(logger), level(level), func(func), file(file), line(line), threadId(threadId), stream(LogStream::acquire()) {}
 
         LogMessage(const LogMessage&) = delete; /**< Deleted copy constructor. */
         LogMessage& operator=(const LogMessage&) = delete; /**< Deleted copy assignment operator. */
 
-        LogMessage(LogMessage&&) = default; /**< Default move constructor. */
-        LogMessage& operator=(LogMessage&&) = default; /**< Default move assignment operator. */
+        LogMessage(LogMessage&&) = default; /**< Default move constructor (the moved-from message logs nothing). */
+        LogMessage& operator=(LogMessage&&) = delete; /**< Deleted move assignment operator. */
 
         /**
          * @brief Overloads the << operator for appending to the log message.
@@ -627,7 +1349,7 @@ class LogMessage
         template<typename T>
         LogMessage& operator<<(const T& value)
         {
-            stream << value;
+            stream->stream() << value;
             return *this;
         }
 
@@ -636,17 +1358,21 @@ class LogMessage
          */
         ~LogMessage()
         {
-            logger.logAdd(level, stream.str(), func, file, line, threadId);
+            if(stream)
+            {
+                logger.logAdd(level, stream->view(), func, file, line, threadId);
+                LogStream::release(std::move(stream));
+            }
         }
 
     private:
         SQLogger& logger; /**< The logger used for logging. */
         LogLevel level; /**< The severity level of the log message. */
-        std::string func; /**< The function where the log message was created. */
-        std::string file; /**< The file where the log message was created. */
+        std::string_view func; /**< The function where the log message was created. */
+        std::string_view file; /**< The file where the log message was created. */
         int line; /**< The line number where the log message was created. */
-        std::string threadId; /**< The ID of the thread that created the log message. */
-        std::ostringstream stream; /**< The stream used to build the log message. */
+        std::string_view threadId; /**< The ID of the thread that created the log message. */
+        std::unique_ptr<LogStream> stream; /**< The stream used to build the log message (nullptr once moved from). */
 };
 
 #endif // LOGGER_H
\ No newline at end of file
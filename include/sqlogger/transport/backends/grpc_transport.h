@@ -0,0 +1,170 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef GRPC_TRANSPORT_H
+#define GRPC_TRANSPORT_H
+
+#include <memory>
+#include "sqlogger/transport/transport_interface.h"
+
+#define GRPC_TRANSPORT_SERVICE "/sqlogger.LogService/" /**< Method prefix of the log service. */
+#define GRPC_TRANSPORT_METHOD_PUSH_LOGS GRPC_TRANSPORT_SERVICE "PushLogs" /**< Bidi stream: batches in, acks out. */
+#define GRPC_TRANSPORT_METHOD_PULL_LOGS GRPC_TRANSPORT_SERVICE "PullLogs" /**< Server stream: one query in, blocks out. */
+#define GRPC_TRANSPORT_METHOD_PUSH_STATS GRPC_TRANSPORT_SERVICE "PushStats" /**< Unary: logger statistics. */
+#define GRPC_TRANSPORT_MAX_MESSAGE_SIZE (64 << 20) /**< Largest batch or block accepted. */
+#define GRPC_TRANSPORT_SERVER_WINDOW 8 /**< Unacknowledged batches per stream before the server stops reading. */
+#define GRPC_TRANSPORT_PULL_CHUNK 1000 /**< Entries per PullLogs response block. */
+#define GRPC_TRANSPORT_STOP_TIMEOUT_MSEC 5000 /**< Grace period of stop() and of closing the push stream. */
+
+/**
+ * @class GrpcTransport
+ * @brief ITransport over gRPC, used both by app nodes (client) and by a collector (server).
+ *
+ * The client side (pushLogs, pullLogs, pushStats) connects to the [Transport] Host and Port;
+ * the server side is started with start() and dispatches to the handlers.
+ * Messages use the generic gRPC API, so no generated code is needed:
+ * - PushLogs: one long-lived bidi stream; every batch is a LogSerializer::Binary block and is
+ *   answered by a one-byte ack (1 = stored) in order. The client keeps at most
+ *   BatchMaxInFlight batches unacknowledged and pushLogs() blocks beyond that; the server
+ *   stops reading after GRPC_TRANSPORT_SERVER_WINDOW unacknowledged batches, so HTTP/2
+ *   flow control carries a slow handler (e.g. a full logger queue) back to the producers.
+ * - PullLogs: the query (limit, offset and filters) is answered by a stream of binary blocks.
+ * - PushStats: unary call with the SQLogger::Stats counters.
+ */
+class GrpcTransport : public ITransport
+{
+    public:
+        /**
+         * @brief Constructs a transport (nothing is connected or bound yet).
+         * @param config Configuration ([Transport] Host, Port and BatchMaxInFlight).
+         */
+        explicit GrpcTransport(const LogConfig::Config& config);
+
+        /**
+         * @brief Closes the push stream and stops the server.
+         */
+        ~GrpcTransport() override;
+
+        GrpcTransport(const GrpcTransport&) = delete;
+        GrpcTransport& operator=(const GrpcTransport&) = delete;
+
+        /**
+         * @brief Starts the server side
+         * @param host The host address to listen to
+         * @param port The port number to use (0 picks a free port, see getPort())
+         * @return true if started successfully, false otherwise
+         */
+        bool start(const std::string& host, uint16_t port) override;
+
+        /**
+         * @brief Stops the server side and closes the client push stream
+         */
+        void stop() override;
+
+        /**
+         * @brief Checks if the server side is running
+         * @return true if the server is active, false otherwise
+         */
+        bool isRunning() const override;
+
+        /**
+         * @brief Gets the port the server listens to
+         * @return uint16_t Bound port, 0 if the server is not running
+         */
+        uint16_t getPort() const;
+
+        /**
+         * @brief Sets the handler for log pushes (batches are split into single entries)
+         * @param handler Callback function to handle incoming log pushes
+         */
+        void setLogPushHandler(LogPushHandler handler) override;
+
+        /**
+         * @brief Sets the handler for batched log pushes (takes precedence over setLogPushHandler)
+         * @param handler Callback function to handle incoming log batches
+         */
+        void setLogBatchPushHandler(LogBatchPushHandler handler) override;
+
+        /**
+         * @brief Sets the handler for log pull operations
+         * @param handler Callback function to handle log retrieval requests
+         */
+        void setLogPullHandler(LogPullHandler handler) override;
+
+        /**
+         * @brief Sets the handler for configuration updates
+         * @param handler Callback function to handle configuration changes
+         */
+        void setConfigHandler(ConfigHandler handler) override;
+
+        /**
+         * @brief Sets the handler for error notifications
+         * @param handler Callback function to handle transport errors
+         */
+        void setErrorHandler(ErrorHandler handler) override;
+
+        /**
+         * @brief Sets the handler for statistics updates
+         * @param handler Callback function to receive statistics
+         */
+        void setStatsHandler(StatsHandler handler) override;
+
+        /**
+         * @brief Pushes a log entry as a batch of one
+         * @param entry The log entry to send
+         * @param callback Callback to receive operation status (true = success)
+         */
+        void pushLog(const LogEntry& entry, std::function<void(bool)> callback) override;
+
+        /**
+         * @brief Pushes a batch over the push stream, blocking while BatchMaxInFlight batches are unacknowledged
+         * @param entries The log entries to send
+         * @param callback Callback to receive the batch status (true = success), called once
+         */
+        void pushLogs(const LogEntryList& entries, std::function<void(bool)> callback) override;
+
+        /**
+         * @brief Retrieves logs matching specified filters from the server
+         * @param filters Vector of filters to apply
+         * @param limit Maximum number of entries to return
+         * @param offset Pagination offset
+         * @param callback Callback to receive the resulting LogEntryList (empty on failure)
+         */
+        void pullLogs(const std::vector<Filter> & filters, int limit, int offset,
+                      std::function<void(LogEntryList)> callback) override;
+
+        /**
+         * @brief Publishes statistics to the server
+         * @param stats Statistics data to send
+         */
+        void pushStats(const SQLogger::Stats& stats) override;
+
+        /**
+         * @brief Gets current transport statistics
+         * @return TransportStats structure with current metrics
+         */
+        TransportStats getStats() const override;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl; /**< gRPC state, kept out of the header. */
+};
+
+#endif // !GRPC_TRANSPORT_H
@@ -0,0 +1,140 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef LOG_COLLECTOR_H
+#define LOG_COLLECTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "sqlogger/logger.h"
+#include "sqlogger/transport/transport_interface.h"
+
+#define LOG_COLLECTOR_ACK_TIMEOUT_MSEC 10000 /**< Longest wait for a durable ack. */
+
+/**
+ * @class LogCollector
+ * @brief Server mode: stores the batches pushed to a transport through one SQLogger.
+ *
+ * Many app nodes push to one collector instead of each holding a database connection.
+ * Received entries go through SQLogger::logEntries(), so the batches of all senders are
+ * merged into the logger's batches; configure the logger with useBatch, a large batchSize,
+ * groupCommitBatches and connectionPoolSize to group-commit them and spread the writes
+ * over pooled connections. With durable acks, batches are acknowledged after
+ * SQLogger::waitUntilDurable(), one wait for all batches received meanwhile.
+ * With SQLG_USE_SOURCE_INFO, the sender's source (UUID and name) is registered and kept.
+ * Pull requests are answered with SQLogger::getLogsByFilters().
+ */
+class LogCollector
+{
+    public:
+        /**
+         * @struct Stats
+         * @brief Collector counters.
+         */
+        struct Stats
+        {
+            uint64_t batches = 0; /**< Batches received. */
+            uint64_t entries = 0; /**< Entries accepted by the logger. */
+            uint64_t skipped = 0; /**< Entries skipped (below the minimum level or dropped by back-pressure). */
+            uint64_t failedBatches = 0; /**< Batches acknowledged with failure. */
+            uint64_t sources = 0; /**< Distinct remote sources seen. */
+        };
+
+        /**
+         * @brief Binds the transport handlers to the logger.
+         * @param transport Server transport (must outlive the collector).
+         * @param logger Logger storing the entries (must outlive the collector).
+         * @param durableAcks Acknowledge after the entries are committed (true) or once queued (false).
+         */
+        LogCollector(ITransport& transport, SQLogger& logger, const bool durableAcks = true);
+
+        /**
+         * @brief Stops the collector.
+         */
+        ~LogCollector();
+
+        LogCollector(const LogCollector&) = delete;
+        LogCollector& operator=(const LogCollector&) = delete;
+
+        /**
+         * @brief Starts the transport server.
+         * @param host The host address to listen to.
+         * @param port The port number to use.
+         * @return bool True if the transport started.
+         */
+        bool start(const std::string& host, uint16_t port);
+
+        /**
+         * @brief Stops the transport and acknowledges the batches still waiting for durability.
+         */
+        void stop();
+
+        /**
+         * @brief Gets the collector counters.
+         * @return Stats Counters.
+         */
+        Stats getStats() const;
+
+    private:
+        /**
+         * @brief Push handler: hands a batch to the logger and schedules its ack.
+         * @param entries Received entries.
+         * @param callback Batch status callback.
+         */
+        void onBatch(const LogEntryList& entries, std::function<void(bool)> callback);
+
+        /**
+         * @brief Ack thread body: waits for durability once per group of received batches.
+         */
+        void ackLoop();
+
+#ifdef SQLG_USE_SOURCE_INFO
+        /**
+         * @brief Gets the local ID of a sender's source, registering it on first use.
+         * @param uuid Source UUID.
+         * @param name Source name.
+         * @return int Source ID, or 0 to store the logger's own source.
+         */
+        int resolveSource(const std::string& uuid, const std::string& name);
+#endif
+
+        ITransport& transport; /**< Server transport. */
+        SQLogger& logger; /**< Destination logger. */
+        bool durableAcks; /**< Ack after commit. */
+
+        mutable std::mutex mutex; /**< Guards the members below. */
+        std::condition_variable cv; /**< Signals pending acks and stop. */
+        std::vector<std::function<void(bool)>> pendingAcks; /**< Batches waiting for durability. */
+        Stats stats; /**< Counters. */
+        bool stopping = false; /**< Set by stop(). */
+        std::thread ackThread; /**< Durable ack thread. */
+
+#ifdef SQLG_USE_SOURCE_INFO
+        std::mutex sourceMutex; /**< Guards sources. */
+        std::unordered_map<std::string, int> sources; /**< Source UUID -> local source ID. */
+#endif
+};
+
+#endif // LOG_COLLECTOR_H
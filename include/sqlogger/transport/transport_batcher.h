@@ -0,0 +1,152 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#ifndef TRANSPORT_BATCHER_H
+#define TRANSPORT_BATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "sqlogger/transport/transport_interface.h"
+
+#define TRANSPORT_BATCH_DEFAULT_MAX_ENTRIES 1000 /**< Entries per batch. */
+#define TRANSPORT_BATCH_DEFAULT_MAX_BYTES (1 << 20) /**< Approximate bytes per batch. */
+#define TRANSPORT_BATCH_DEFAULT_MAX_DELAY_MSEC 20 /**< Linger time of a partial batch. */
+#define TRANSPORT_BATCH_DEFAULT_MAX_IN_FLIGHT 4 /**< Unacknowledged batches. */
+#define TRANSPORT_BATCH_ENTRY_OVERHEAD 32 /**< Bytes added to the string sizes of an entry. */
+
+/**
+ * @struct TransportBatchPolicy
+ * @brief Client-side batching and pipelining limits of a TransportBatcher.
+ * A batch is sent when it holds maxEntries entries or about maxBytes bytes, or
+ * maxDelay after its first entry, whichever comes first.
+ */
+struct TransportBatchPolicy
+{
+    size_t maxEntries = TRANSPORT_BATCH_DEFAULT_MAX_ENTRIES; /**< Entries per batch. */
+    size_t maxBytes = TRANSPORT_BATCH_DEFAULT_MAX_BYTES; /**< Approximate bytes per batch. */
+    std::chrono::milliseconds maxDelay = std::chrono::milliseconds(TRANSPORT_BATCH_DEFAULT_MAX_DELAY_MSEC); /**< Linger time. */
+    size_t maxInFlight = TRANSPORT_BATCH_DEFAULT_MAX_IN_FLIGHT; /**< Batches sent but not acknowledged; push() blocks beyond it. */
+
+    /**
+     * @brief Builds a policy from the [Transport] Batch* settings (defaults for unset values).
+     * @param config Configuration.
+     * @return TransportBatchPolicy Policy.
+     */
+    static TransportBatchPolicy fromConfig(const LogConfig::Config& config);
+};
+
+/**
+ * @class TransportBatcher
+ * @brief Collects entries into batches for ITransport::pushLogs().
+ * Up to maxInFlight batches are pipelined; when all slots are taken, push() blocks
+ * until the transport acknowledges a batch, which propagates back-pressure to the caller.
+ * Per-entry callbacks are called with the status of the batch that carried the entry.
+ */
+class TransportBatcher
+{
+    public:
+        /**
+         * @struct Stats
+         * @brief Batching counters.
+         */
+        struct Stats
+        {
+            uint64_t batches = 0; /**< Batches sent. */
+            uint64_t entries = 0; /**< Entries sent. */
+            uint64_t failedBatches = 0; /**< Batches acknowledged with failure. */
+        };
+
+        /**
+         * @brief Constructs a batcher and starts its linger thread.
+         * @param transport Transport to push to (must outlive the batcher).
+         * @param policy Batching limits.
+         */
+        TransportBatcher(ITransport& transport, const TransportBatchPolicy& policy = TransportBatchPolicy());
+
+        /**
+         * @brief Sends the pending batch, waits for in-flight batches and stops the linger thread.
+         */
+        ~TransportBatcher();
+
+        TransportBatcher(const TransportBatcher&) = delete;
+        TransportBatcher& operator=(const TransportBatcher&) = delete;
+
+        /**
+         * @brief Adds an entry to the current batch, sending the batch when it is full.
+         * @param entry The log entry.
+         * @param callback Optional status callback of the entry.
+         */
+        void push(const LogEntry& entry, std::function<void(bool)> callback = nullptr);
+
+        /**
+         * @brief Sends the current batch and waits until every batch is acknowledged.
+         * @param timeout Maximum time to wait.
+         * @return bool True if nothing is in flight anymore.
+         */
+        bool flush(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(5000));
+
+        /**
+         * @brief Gets the batching counters.
+         * @return Stats Counters.
+         */
+        Stats getStats() const;
+
+    private:
+        /**
+         * @brief Sends the current batch once an in-flight slot is free.
+         * @param lock Held lock on mutex (released while pushing).
+         */
+        void sendBatch(std::unique_lock<std::mutex>& lock);
+
+        /**
+         * @brief Sends partial batches after maxDelay.
+         */
+        void lingerLoop();
+
+        /**
+         * @brief Estimates the encoded size of an entry.
+         * @param entry The log entry.
+         * @return size_t Size in bytes.
+         */
+        static size_t entrySize(const LogEntry& entry);
+
+        ITransport& transport; /**< Destination. */
+        TransportBatchPolicy policy; /**< Limits. */
+
+        mutable std::mutex mutex; /**< Guards every member below. */
+        std::condition_variable cv; /**< Signals new batches, freed slots and stop. */
+        LogEntryList batch; /**< Batch being filled. */
+        std::vector<std::function<void(bool)>> callbacks; /**< Entry callbacks of the batch. */
+        size_t batchBytes = 0; /**< Estimated size of the batch. */
+        std::chrono::steady_clock::time_point batchStart; /**< Time of the first entry of the batch. */
+        uint64_t generation = 0; /**< Incremented for every sent batch. */
+        size_t inFlight = 0; /**< Batches sent but not acknowledged. */
+        Stats stats; /**< Counters. */
+        bool stop = false; /**< Stops the linger thread. */
+        std::thread lingerThread; /**< Sends partial batches. */
+};
+
+#endif // TRANSPORT_BATCHER_H
@@ -28,6 +28,10 @@
     #include "sqlogger/transport/backends/rest_transport.h"
 #endif
 
+#ifdef SQLG_USE_GRPC
+    #include "sqlogger/transport/backends/grpc_transport.h"
+#endif
+
 class LogManager; // Forward declaration
 
 /**
@@ -58,6 +62,7 @@ class TransportFactory
          * @throws std::invalid_argument If unknown transport type is requested
          * @note Actual available transports depend on compile-time definitions:
          * - REST transport requires SQLG_USE_REST definition
+         * - gRPC transport requires SQLG_USE_GRPC definition
          */
         static std::unique_ptr<ITransport> create(const TransportType& type, const LogConfig::Config& config);
 
@@ -22,6 +22,8 @@
 
 #include <functional>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include "sqlogger/logger.h"
 #include "sqlogger/log_entry.h"
 #include "sqlogger/log_config.h"
@@ -51,6 +53,9 @@ class ITransport
         /// Handler type for log push operations
         using LogPushHandler = std::function<void(const LogEntry&, std::function<void(bool)>)>;
 
+        /// Handler type for batched log push operations (one callback per batch)
+        using LogBatchPushHandler = std::function<void(const LogEntryList&, std::function<void(bool)>)>;
+
         /// Handler type for log pull operations
         using LogPullHandler = std::function<void(const std::vector<Filter> &, int, int, std::function<void(LogEntryList)>)>;
 
@@ -88,6 +93,20 @@ class ITransport
          */
         virtual void setLogPushHandler(LogPushHandler handler) = 0;
 
+        /**
+         * @brief Sets the handler for batched log pushes
+         * The default adapts per-entry pushes for transports without batch support,
+         * so the handler receives batches of one entry.
+         * @param handler Callback function to handle incoming log batches
+         */
+        virtual void setLogBatchPushHandler(LogBatchPushHandler handler)
+        {
+            setLogPushHandler([handler = std::move(handler)](const LogEntry & entry, std::function<void(bool)> callback)
+            {
+                handler(LogEntryList{ entry }, std::move(callback));
+            });
+        }
+
         /**
          * @brief Sets the handler for log pull operations
          * @param handler Callback function to handle log retrieval requests
@@ -119,6 +138,48 @@ class ITransport
          */
         virtual void pushLog(const LogEntry& entry, std::function<void(bool)> callback) = 0;
 
+        /**
+         * @brief Pushes a batch of log entries through the transport
+         * Transports should send the batch as one request; the default falls back to
+         * pushLog() per entry and reports success only if every entry succeeded.
+         * @param entries The log entries to send
+         * @param callback Callback to receive the batch status (true = success), called once
+         */
+        virtual void pushLogs(const LogEntryList& entries, std::function<void(bool)> callback)
+        {
+            if(entries.empty())
+            {
+                if(callback) callback(true);
+                return;
+            }
+
+            struct Pending
+            {
+                std::mutex mutex;
+                size_t remaining;
+                bool success = true;
+                std::function<void(bool)> callback;
+            };
+            auto pending = std::make_shared<Pending>();
+            pending->remaining = entries.size();
+            pending->callback = std::move(callback);
+
+            for(const auto & entry : entries)
+            {
+                pushLog(entry, [pending](bool success)
+                {
+                    std::unique_lock<std::mutex> lock(pending->mutex);
+                    pending->success = pending->success && success;
+                    if(--pending->remaining == 0)
+                    {
+                        const bool result = pending->success;
+                        lock.unlock();
+                        if(pending->callback) pending->callback(result);
+                    }
+                });
+            }
+        }
+
         /**
          * @brief Retrieves logs matching specified filters
          * @param filters Vector of filters to apply
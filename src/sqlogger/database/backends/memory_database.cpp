@@ -0,0 +1,1150 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <stdexcept>
+#include <string_view>
+#include "sqlogger/database/backends/memory_database.h"
+#include "sqlogger/log_helper.h"
+
+namespace
+{
+    /**
+     * @enum FilterOp
+     * @brief Filter operator resolved once per query.
+     */
+    enum class FilterOp
+    {
+        Equal,
+        NotEqual,
+        Less,
+        Greater,
+        LessEqual,
+        GreaterEqual,
+        Like,
+        NotLike,
+        In,
+        NotIn,
+        IsNull,
+        IsNotNull
+    };
+
+    /**
+     * @brief Converts a filter operator.
+     * @param op Operator text (one of ALLOWED_FILTER_OP).
+     * @return FilterOp Operator.
+     * @throws std::invalid_argument If the operator is not allowed.
+     */
+    FilterOp toFilterOp(const std::string& op)
+    {
+        if(op == "=") return FilterOp::Equal;
+        if(op == "!=" || op == "<>") return FilterOp::NotEqual;
+        if(op == "<") return FilterOp::Less;
+        if(op == ">") return FilterOp::Greater;
+        if(op == "<=") return FilterOp::LessEqual;
+        if(op == ">=") return FilterOp::GreaterEqual;
+        if(op == "LIKE") return FilterOp::Like;
+        if(op == "NOT LIKE") return FilterOp::NotLike;
+        if(op == "IN") return FilterOp::In;
+        if(op == "NOT IN") return FilterOp::NotIn;
+        if(op == "IS NULL") return FilterOp::IsNull;
+        if(op == "IS NOT NULL") return FilterOp::IsNotNull;
+        throw std::invalid_argument(ERR_MSG_INVALID_OPERATOR + op);
+    }
+
+    /**
+     * @brief Matches a text against a LIKE pattern as SQLite does.
+     * '%' matches any sequence, '_' any single character, ASCII letters ignore case.
+     * @param text Text to match.
+     * @param pattern LIKE pattern.
+     * @return True if the whole text matches.
+     */
+    bool likeMatch(const std::string_view text, const std::string_view pattern)
+    {
+        size_t t = 0;
+        size_t p = 0;
+        size_t starPattern = std::string_view::npos;
+        size_t starText = 0;
+
+        while(t < text.size())
+        {
+            if(p < pattern.size() && pattern[p] == '%')
+            {
+                starPattern = p++;
+                starText = t;
+            }
+            else if(p < pattern.size()
+                    && (pattern[p] == '_'
+                        || std::tolower(static_cast<unsigned char>(pattern[p])) == std::tolower(static_cast<unsigned char>(text[t]))))
+            {
+                ++p;
+                ++t;
+            }
+            else if(starPattern != std::string_view::npos)
+            {
+                // Let the last '%' absorb one more character
+                p = starPattern + 1;
+                t = ++starText;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while(p < pattern.size() && pattern[p] == '%')
+        {
+            ++p;
+        }
+        return p == pattern.size();
+    }
+
+    /**
+     * @brief Splits the value of an IN / NOT IN filter.
+     * @param value Comma-separated values (spaces around items are ignored).
+     * @return std::vector<std::string> Items.
+     */
+    std::vector<std::string> splitList(const std::string& value)
+    {
+        std::vector<std::string> items;
+        size_t start = 0;
+        while(start <= value.size())
+        {
+            size_t end = value.find(MEMORY_IN_SEPARATOR, start);
+            if(end == std::string::npos)
+            {
+                end = value.size();
+            }
+
+            size_t first = start;
+            size_t last = end;
+            while(first < last && std::isspace(static_cast<unsigned char>(value[first]))) ++first;
+            while(last > first && std::isspace(static_cast<unsigned char>(value[last - 1]))) --last;
+            items.emplace_back(value.substr(first, last - first));
+
+            start = end + 1;
+        }
+        return items;
+    }
+
+    /**
+     * @brief Parses an integer filter value.
+     * @param value Filter value.
+     * @return int64_t Parsed value.
+     * @throws std::invalid_argument If the value is not an integer.
+     */
+    int64_t toNumber(const std::string& value)
+    {
+        int64_t number = 0;
+        const char* end = value.data() + value.size();
+        const auto result = std::from_chars(value.data(), end, number);
+        if(value.empty() || result.ec != std::errc() || result.ptr != end)
+        {
+            throw std::invalid_argument(ERR_MSG_MEMORY_FILTER_VALUE + value);
+        }
+        return number;
+    }
+
+    /**
+     * @brief Evaluates a filter on a text value.
+     * @param value Column value.
+     * @param op Operator.
+     * @param operands Filter values (IN / NOT IN: all items, otherwise one).
+     * @return True if the value matches.
+     */
+    bool testText(const std::string_view value, const FilterOp op, const std::vector<std::string> & operands)
+    {
+        switch(op)
+        {
+            case FilterOp::Equal:
+                return value == operands[0];
+            case FilterOp::NotEqual:
+                return value != operands[0];
+            case FilterOp::Less:
+                return value < operands[0];
+            case FilterOp::Greater:
+                return value > operands[0];
+            case FilterOp::LessEqual:
+                return value <= operands[0];
+            case FilterOp::GreaterEqual:
+                return value >= operands[0];
+            case FilterOp::Like:
+                return likeMatch(value, operands[0]);
+            case FilterOp::NotLike:
+                return !likeMatch(value, operands[0]);
+            case FilterOp::In:
+                return std::find(operands.begin(), operands.end(), value) != operands.end();
+            case FilterOp::NotIn:
+                return std::find(operands.begin(), operands.end(), value) == operands.end();
+            case FilterOp::IsNull:
+                return false;
+            case FilterOp::IsNotNull:
+            default:
+                return true;
+        }
+    }
+
+    /**
+     * @brief Evaluates a filter on an integer value.
+     * @param value Column value.
+     * @param op Operator (not LIKE / NOT LIKE).
+     * @param operands Filter values (IN / NOT IN: all items, otherwise one).
+     * @return True if the value matches.
+     */
+    bool testNumber(const int64_t value, const FilterOp op, const std::vector<int64_t> & operands)
+    {
+        switch(op)
+        {
+            case FilterOp::Equal:
+                return value == operands[0];
+            case FilterOp::NotEqual:
+                return value != operands[0];
+            case FilterOp::Less:
+                return value < operands[0];
+            case FilterOp::Greater:
+                return value > operands[0];
+            case FilterOp::LessEqual:
+                return value <= operands[0];
+            case FilterOp::GreaterEqual:
+                return value >= operands[0];
+            case FilterOp::In:
+                return std::find(operands.begin(), operands.end(), value) != operands.end();
+            case FilterOp::NotIn:
+                return std::find(operands.begin(), operands.end(), value) == operands.end();
+            case FilterOp::IsNull:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    /**
+     * @brief Formats a timestamp as LogHelper::formatTime() does (second resolution).
+     * @param micros Microseconds since the epoch.
+     * @param cache Last formatted second and its text.
+     * @return const std::string& Formatted timestamp.
+     */
+    const std::string& formatSeconds(const int64_t micros, std::pair<int64_t, std::string> & cache)
+    {
+        int64_t seconds = micros / 1000000;
+        if(micros % 1000000 < 0)
+        {
+            --seconds;
+        }
+
+        if(cache.first != seconds || cache.second.empty())
+        {
+            cache.first = seconds;
+            cache.second = LogHelper::formatTime(std::chrono::system_clock::time_point(std::chrono::seconds(seconds)));
+        }
+        return cache.second;
+    }
+}
+
+/**
+ * @struct MemoryDatabase::Predicate
+ * @brief Filter compiled against the string pools of a table.
+ */
+struct MemoryDatabase::Predicate
+{
+    /**
+     * @enum Column
+     * @brief Filtered column.
+     */
+    enum class Column
+    {
+        Id,
+        Timestamp,
+        Line,
+        SourceId,
+        Level,
+        Function,
+        File,
+        ThreadId,
+        Message
+    };
+
+    Column column = Column::Id; /**< Filtered column. */
+    FilterOp op = FilterOp::Equal; /**< Operator. */
+    std::vector<int64_t> numbers; /**< Operands of an integer comparison. */
+    std::vector<std::string> texts; /**< Operands of a text comparison. */
+    std::vector<char> pooled; /**< Pooled columns: match result of each pool id. */
+
+    /**
+     * @brief Checks if the operator compares integers (the ID and timestamp ranges can prune chunks).
+     * @return True for integer columns compared without LIKE.
+     */
+    bool isNumeric() const
+    {
+        return (column == Column::Id || column == Column::Timestamp || column == Column::Line || column == Column::SourceId)
+               && op != FilterOp::Like && op != FilterOp::NotLike;
+    }
+};
+
+/**
+ * @brief Gets the id of a value, adding it if new.
+ * @param value Value to intern.
+ * @return uint32_t Value id.
+ */
+uint32_t MemoryDatabase::StringPool::intern(const std::string& value)
+{
+    auto it = ids.find(value);
+    if(it != ids.end())
+    {
+        return it->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(values.size());
+    values.push_back(value);
+    ids.emplace(value, id);
+    // Value kept twice (vector and hash key) plus the hash node
+    bytes += 2 * (sizeof(std::string) + value.size()) + 4 * sizeof(void*);
+    return id;
+}
+
+/**
+ * @brief Gets the approximate memory used by the chunk.
+ * @return size_t Size in bytes.
+ */
+size_t MemoryDatabase::Chunk::bytes() const
+{
+    return sizeof(Chunk)
+           + timestampsUs.capacity() * sizeof(int64_t)
+           + lines.capacity() * sizeof(int32_t)
+#ifdef SQLG_USE_SOURCE_INFO
+           + sourceIds.capacity() * sizeof(int32_t)
+#endif
+           + (levels.capacity() + functions.capacity() + files.capacity() + threadIds.capacity()) * sizeof(uint32_t)
+           + messages.capacity()
+           + messageEnds.capacity() * sizeof(uint32_t);
+}
+
+/**
+ * @brief Gets the approximate memory used by the table.
+ * @return size_t Size in bytes.
+ */
+size_t MemoryDatabase::Table::bytes() const
+{
+    return sealedBytes
+           + (chunks.empty() ? 0 : chunks.back().bytes())
+           + levels.bytes + functions.bytes + files.bytes + threadIds.bytes;
+}
+
+/**
+ * @brief Constructs a MemoryDatabase object and connects it.
+ * @param connectionString "Name=<name>;MaxBytes=<bytes>", see connect().
+ * @throws std::runtime_error If the connection string is invalid.
+ */
+MemoryDatabase::MemoryDatabase(const std::string& connectionString)
+{
+    if(!connect(connectionString))
+    {
+        throw std::runtime_error(lastError);
+    }
+}
+
+/**
+ * @brief Destructor for MemoryDatabase.
+ */
+MemoryDatabase::~MemoryDatabase()
+{
+    disconnect();
+}
+
+/**
+ * @brief Opens the named in-memory database, creating it if no connection has it open.
+ * @param connectionString "Name=<name>;MaxBytes=<bytes>"; the budget of an already open
+ * database is kept. A value without '=' is taken as the name.
+ * @return True if the connection was successful, false otherwise.
+ */
+bool MemoryDatabase::connect(const std::string& connectionString)
+{
+    std::string name = connectionString;
+    size_t maxBytes = MEMORY_DEFAULT_MAX_BYTES;
+
+    if(connectionString.find('=') != std::string::npos)
+    {
+        name = DataBaseHelper::parseKeyValueString(connectionString, MEMORY_CON_STR_NAME, ';').value_or("");
+
+        const auto maxBytesValue = DataBaseHelper::parseKeyValueString(connectionString, MEMORY_CON_STR_MAX_BYTES, ';');
+        if(maxBytesValue.has_value())
+        {
+            unsigned long long value = 0;
+            const char* end = maxBytesValue->data() + maxBytesValue->size();
+            const auto result = std::from_chars(maxBytesValue->data(), end, value);
+            if(maxBytesValue->empty() || result.ec != std::errc() || result.ptr != end)
+            {
+                lastError = std::string(ERR_MSG_INVALID_PARAMS) + MEMORY_CON_STR_MAX_BYTES + "=" + maxBytesValue.value();
+                return false;
+            }
+            maxBytes = static_cast<size_t>(value);
+        }
+    }
+
+    store = openStore(name, maxBytes);
+    return true;
+}
+
+/**
+ * @brief Disconnects from the database; the data is released with the last connection.
+ */
+void MemoryDatabase::disconnect()
+{
+    store.reset();
+}
+
+/**
+ * @brief Checks if the database is connected.
+ * @return True if the database is connected, false otherwise.
+ */
+bool MemoryDatabase::isConnected() const
+{
+    return store != nullptr;
+}
+
+/**
+ * @brief Not supported: the memory database does not execute SQL.
+ * @return Always false (getLastError() returns ERR_MSG_MEMORY_NO_SQL).
+ */
+bool MemoryDatabase::execute(const std::string& /*query*/,
+                             const std::vector<std::string> & /*params*/,
+                             int* /*affectedRows*/)
+{
+    lastError = ERR_MSG_MEMORY_NO_SQL;
+    return false;
+}
+
+/**
+ * @brief Not supported: the memory database does not execute SQL.
+ * @return Always an empty result.
+ */
+std::vector<std::map<std::string, std::string>> MemoryDatabase::query(const std::string& /*query*/,
+        const std::vector<std::string> & /*params*/)
+{
+    lastError = ERR_MSG_MEMORY_NO_SQL;
+    return {};
+}
+
+/**
+ * @brief Appends log entries to the table, evicting the oldest chunks over the budget.
+ * @param table Log table name.
+ * @param entries Entries to store (id is assigned, source UUID and name are ignored).
+ * @return True if the entries were stored, false if not connected.
+ */
+bool MemoryDatabase::insertLogs(const std::string& table, const LogEntryList& entries)
+{
+    if(!store)
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(store->mutex);
+    Table& data = store->tables[table];
+
+    auto evict = [ & ]()
+    {
+        while(store->maxBytes > 0 && data.chunks.size() > 1 && data.bytes() > store->maxBytes)
+        {
+            data.sealedBytes -= data.chunks.front().bytes();
+            data.evictedRows += data.chunks.front().rows();
+            data.chunks.pop_front();
+        }
+    };
+
+    for(const auto & entry : entries)
+    {
+        if(data.chunks.empty() || data.chunks.back().rows() >= MEMORY_CHUNK_ROWS)
+        {
+            if(!data.chunks.empty())
+            {
+                data.sealedBytes += data.chunks.back().bytes();
+                evict();
+            }
+
+            data.chunks.emplace_back();
+            Chunk& chunk = data.chunks.back();
+            chunk.firstId = data.nextId;
+            chunk.timestampsUs.reserve(MEMORY_CHUNK_ROWS);
+            chunk.lines.reserve(MEMORY_CHUNK_ROWS);
+#ifdef SQLG_USE_SOURCE_INFO
+            chunk.sourceIds.reserve(MEMORY_CHUNK_ROWS);
+#endif
+            chunk.levels.reserve(MEMORY_CHUNK_ROWS);
+            chunk.functions.reserve(MEMORY_CHUNK_ROWS);
+            chunk.files.reserve(MEMORY_CHUNK_ROWS);
+            chunk.threadIds.reserve(MEMORY_CHUNK_ROWS);
+            chunk.messageEnds.reserve(MEMORY_CHUNK_ROWS);
+        }
+
+        Chunk& chunk = data.chunks.back();
+        const int64_t timestampUs = entry.timestampUs != 0
+                                    ? entry.timestampUs
+                                    : LogHelper::parseEpochMicros(entry.timestamp).value_or(0);
+
+        if((chunk.rows() > 0 || data.chunks.size() > 1) && timestampUs < data.lastTimestampUs)
+        {
+            data.timestampOrdered = false;
+        }
+        data.lastTimestampUs = timestampUs;
+
+        if(chunk.rows() == 0)
+        {
+            chunk.minTimestampUs = timestampUs;
+            chunk.maxTimestampUs = timestampUs;
+        }
+        else
+        {
+            chunk.minTimestampUs = std::min(chunk.minTimestampUs, timestampUs);
+            chunk.maxTimestampUs = std::max(chunk.maxTimestampUs, timestampUs);
+        }
+
+        chunk.timestampsUs.push_back(timestampUs);
+        chunk.lines.push_back(entry.line);
+#ifdef SQLG_USE_SOURCE_INFO
+        chunk.sourceIds.push_back(entry.sourceId);
+#endif
+        chunk.levels.push_back(data.levels.intern(entry.level));
+        chunk.functions.push_back(data.functions.intern(entry.function));
+        chunk.files.push_back(data.files.intern(entry.file));
+        chunk.threadIds.push_back(data.threadIds.intern(entry.threadId));
+        chunk.messages.append(entry.message);
+        chunk.messageEnds.push_back(static_cast<uint32_t>(chunk.messages.size()));
+        ++data.nextId;
+    }
+
+    evict();
+    return true;
+}
+
+/**
+ * @brief Passes the log entries matching the filters to a callback.
+ * Filters are compiled once per query; chunks outside a timestamp or ID range are skipped.
+ * @param table Log table name.
+ * @param filters Filters, combined with AND. IN / NOT IN take a comma-separated list,
+ * timestamps are compared in microseconds, LIKE is case-insensitive for ASCII (as in SQLite).
+ * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending, ties in ID order).
+ * @param limit Maximum number of entries (0 or negative = no limit).
+ * @param offset Number of entries to skip, requires a positive limit.
+ * @param callback Function called for each entry; return false to stop reading.
+ * @return size_t Number of entries passed to the callback.
+ * @throws std::invalid_argument If a filter field is not a log table column.
+ * @note The callback runs under the database read lock and must not write to this database.
+ */
+size_t MemoryDatabase::selectLogs(const std::string& table,
+                                  const std::vector<Filter> & filters,
+                                  const std::string& orderBy,
+                                  const int limit,
+                                  const int offset,
+                                  const NativeLogCallback& callback)
+{
+    if(!store)
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return 0;
+    }
+
+    static const Table emptyTable;
+
+    std::shared_lock<std::shared_mutex> lock(store->mutex);
+    auto it = store->tables.find(table);
+    const Table& data = it != store->tables.end() ? it->second : emptyTable;
+
+    std::vector<Predicate> predicates;
+    predicates.reserve(filters.size());
+    for(const auto & filter : filters)
+    {
+        predicates.push_back(compile(data, filter));
+    }
+
+    const size_t skip = limit > 0 && offset > 0 ? static_cast<size_t>(offset) : 0;
+    const size_t maxRows = limit > 0 ? static_cast<size_t>(limit) : SIZE_MAX;
+    size_t skipped = 0;
+    size_t passed = 0;
+    std::pair<int64_t, std::string> timestampCache { INT64_MIN, std::string() };
+
+    // Returns false once the scan must stop
+    auto emit = [ & ](const Chunk & chunk, const size_t row)
+    {
+        if(skipped < skip)
+        {
+            ++skipped;
+            return true;
+        }
+        ++passed;
+        LogEntry entry = toLogEntry(data, chunk, row, timestampCache);
+        return callback(entry) && passed < maxRows;
+    };
+
+    if(orderBy == FIELD_LOG_TIMESTAMP && !data.timestampOrdered)
+    {
+        // Rows arrived out of timestamp order: sort the matches, collected in ID order
+        std::vector<std::pair<const Chunk*, size_t>> rows;
+        for(const auto & chunk : data.chunks)
+        {
+            if(!mayMatch(predicates, chunk))
+            {
+                continue;
+            }
+            for(size_t row = 0; row < chunk.rows(); ++row)
+            {
+                if(matches(predicates, chunk, row))
+                {
+                    rows.emplace_back( & chunk, row);
+                }
+            }
+        }
+
+        std::stable_sort(rows.begin(), rows.end(), [](const auto & a, const auto & b)
+        {
+            return a.first->timestampsUs[a.second] < b.first->timestampsUs[b.second];
+        });
+
+        for(const auto & row : rows)
+        {
+            if(!emit( * row.first, row.second))
+            {
+                break;
+            }
+        }
+        return passed;
+    }
+
+    for(const auto & chunk : data.chunks)
+    {
+        if(!mayMatch(predicates, chunk))
+        {
+            continue;
+        }
+        for(size_t row = 0; row < chunk.rows(); ++row)
+        {
+            if(matches(predicates, chunk, row) && !emit(chunk, row))
+            {
+                return passed;
+            }
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief Removes all rows of a table; IDs are not reused.
+ * @param table Table name (the log table or SOURCES_TABLE_NAME).
+ * @return Always true if connected.
+ */
+bool MemoryDatabase::clearTable(const std::string& table)
+{
+    if(!store)
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(store->mutex);
+#ifdef SQLG_USE_SOURCE_INFO
+    if(table == SOURCES_TABLE_NAME)
+    {
+        store->sources.clear();
+        return true;
+    }
+#endif
+
+    auto it = store->tables.find(table);
+    if(it != store->tables.end())
+    {
+        Table& data = it->second;
+        data.chunks.clear();
+        data.levels = StringPool();
+        data.functions = StringPool();
+        data.files = StringPool();
+        data.threadIds = StringPool();
+        data.sealedBytes = 0;
+        data.timestampOrdered = true;
+    }
+    return true;
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @brief Stores a source.
+ * @param uuid Source UUID, unique.
+ * @param name Source name.
+ * @return int ID of the new source, or SOURCE_NOT_FOUND if the UUID exists.
+ */
+int MemoryDatabase::insertSource(const std::string& uuid, const std::string& name)
+{
+    if(!store)
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return SOURCE_NOT_FOUND;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(store->mutex);
+    for(const auto & source : store->sources)
+    {
+        if(source.uuid == uuid)
+        {
+            return SOURCE_NOT_FOUND;
+        }
+    }
+
+    const int id = store->nextSourceId++;
+    store->sources.push_back(SourceInfo { id, uuid, name });
+    return id;
+}
+
+/**
+ * @brief Gets all sources ordered by ID.
+ * @return std::vector<SourceInfo> Stored sources.
+ */
+std::vector<SourceInfo> MemoryDatabase::selectSources()
+{
+    if(!store)
+    {
+        return {};
+    }
+
+    std::shared_lock<std::shared_mutex> lock(store->mutex);
+    return store->sources;
+}
+#endif
+
+/**
+ * @brief Not supported: writes are applied immediately.
+ * @return Always false, so group commit falls back to single batches.
+ */
+bool MemoryDatabase::beginTransaction()
+{
+    return false;
+}
+
+/**
+ * @brief Nothing to commit.
+ * @return Always true.
+ */
+bool MemoryDatabase::commitTransaction()
+{
+    return true;
+}
+
+/**
+ * @brief Nothing to roll back.
+ * @return Always true.
+ */
+bool MemoryDatabase::rollbackTransaction()
+{
+    return true;
+}
+
+/**
+ * @brief Gets the last error message.
+ * @return The last error message as a string.
+ */
+std::string MemoryDatabase::getLastError() const
+{
+    return lastError;
+}
+
+/**
+* @brief Drops all tables of the connected database.
+* @param dbName Ignored; the connected database is cleared.
+* @return True if connected, false otherwise.
+*/
+bool MemoryDatabase::dropDatabaseIfExists(const std::string& /*dbName*/)
+{
+    if(!store)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(store->mutex);
+    store->tables.clear();
+#ifdef SQLG_USE_SOURCE_INFO
+    store->sources.clear();
+    store->nextSourceId = 1;
+#endif
+    return true;
+}
+
+/**
+ * @brief Gets the type of the database.
+ * @return DataBaseType::Memory.
+ */
+DataBaseType MemoryDatabase::getDatabaseType() const
+{
+    return DataBaseType::Memory;
+}
+
+/**
+ * @brief Gets the memory used by a log table (columns, messages and string pool).
+ * @param table Log table name.
+ * @return size_t Approximate size in bytes.
+ */
+size_t MemoryDatabase::getMemoryUsage(const std::string& table) const
+{
+    if(!store)
+    {
+        return 0;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(store->mutex);
+    auto it = store->tables.find(table);
+    return it != store->tables.end() ? it->second.bytes() : 0;
+}
+
+/**
+ * @brief Gets the number of rows evicted from a log table to stay within the budget.
+ * @param table Log table name.
+ * @return uint64_t Evicted rows since the table was created.
+ */
+uint64_t MemoryDatabase::getEvictedRows(const std::string& table) const
+{
+    if(!store)
+    {
+        return 0;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(store->mutex);
+    auto it = store->tables.find(table);
+    return it != store->tables.end() ? it->second.evictedRows : 0;
+}
+
+/**
+ * @brief Gets the memory budget of each log table.
+ * @return size_t Budget in bytes.
+ */
+size_t MemoryDatabase::getMaxBytes() const
+{
+    return store ? store->maxBytes : 0;
+}
+
+/**
+ * @brief Compiles a filter against the string pools of a table.
+ * @param table The table.
+ * @param filter The filter.
+ * @return Predicate Compiled filter.
+ * @throws std::invalid_argument If the filter field is not a log table column.
+ */
+MemoryDatabase::Predicate MemoryDatabase::compile(const Table& table, const Filter& filter)
+{
+    Predicate predicate;
+    predicate.op = toFilterOp(filter.op);
+
+    const StringPool* pool = nullptr;
+    if(filter.field == FIELD_LOG_ID) predicate.column = Predicate::Column::Id;
+    else if(filter.field == FIELD_LOG_TIMESTAMP) predicate.column = Predicate::Column::Timestamp;
+    else if(filter.field == FIELD_LOG_LINE) predicate.column = Predicate::Column::Line;
+#ifdef SQLG_USE_SOURCE_INFO
+    else if(filter.field == FIELD_LOG_SOURCES_ID) predicate.column = Predicate::Column::SourceId;
+#endif
+    else if(filter.field == FIELD_LOG_MESSAGE) predicate.column = Predicate::Column::Message;
+    else if(filter.field == FIELD_LOG_LEVEL)
+    {
+        predicate.column = Predicate::Column::Level;
+        pool = & table.levels;
+    }
+    else if(filter.field == FIELD_LOG_FUNCTION)
+    {
+        predicate.column = Predicate::Column::Function;
+        pool = & table.functions;
+    }
+    else if(filter.field == FIELD_LOG_FILE)
+    {
+        predicate.column = Predicate::Column::File;
+        pool = & table.files;
+    }
+    else if(filter.field == FIELD_LOG_THREAD_ID)
+    {
+        predicate.column = Predicate::Column::ThreadId;
+        pool = & table.threadIds;
+    }
+    else
+    {
+        throw std::invalid_argument(ERR_MSG_MEMORY_FILTER_FIELD + filter.field);
+    }
+
+    if(predicate.op == FilterOp::IsNull || predicate.op == FilterOp::IsNotNull)
+    {
+        return predicate;
+    }
+
+    std::vector<std::string> operands = predicate.op == FilterOp::In || predicate.op == FilterOp::NotIn
+                                        ? splitList(filter.value)
+                                        : std::vector<std::string> { filter.value };
+
+    if(pool)
+    {
+        // Evaluated once per distinct value
+        predicate.pooled.resize(pool->values.size());
+        for(size_t id = 0; id < pool->values.size(); ++id)
+        {
+            predicate.pooled[id] = testText(pool->values[id], predicate.op, operands);
+        }
+    }
+    else if(!predicate.isNumeric())
+    {
+        predicate.texts = std::move(operands);
+    }
+    else
+    {
+        for(const auto & operand : operands)
+        {
+            if(predicate.column != Predicate::Column::Timestamp)
+            {
+                predicate.numbers.push_back(toNumber(operand));
+                continue;
+            }
+
+            const auto micros = LogHelper::parseEpochMicros(operand);
+            if(!micros.has_value())
+            {
+                throw std::invalid_argument(ERR_MSG_INVALID_TIMESTAMP + operand);
+            }
+            predicate.numbers.push_back(micros.value());
+        }
+    }
+    return predicate;
+}
+
+/**
+ * @brief Evaluates the compiled filters on a row.
+ * @param predicates Compiled filters.
+ * @param chunk The chunk.
+ * @param row Row index within the chunk.
+ * @return True if every filter matches.
+ */
+bool MemoryDatabase::matches(const std::vector<Predicate> & predicates, const Chunk& chunk, const size_t row)
+{
+    for(const auto & predicate : predicates)
+    {
+        // Columns are never NULL
+        if(predicate.op == FilterOp::IsNull)
+        {
+            return false;
+        }
+        if(predicate.op == FilterOp::IsNotNull)
+        {
+            continue;
+        }
+
+        bool match = false;
+        switch(predicate.column)
+        {
+            case Predicate::Column::Level:
+                match = predicate.pooled[chunk.levels[row]];
+                break;
+            case Predicate::Column::Function:
+                match = predicate.pooled[chunk.functions[row]];
+                break;
+            case Predicate::Column::File:
+                match = predicate.pooled[chunk.files[row]];
+                break;
+            case Predicate::Column::ThreadId:
+                match = predicate.pooled[chunk.threadIds[row]];
+                break;
+            case Predicate::Column::Message:
+            {
+                const size_t begin = row > 0 ? chunk.messageEnds[row - 1] : 0;
+                const std::string_view message(chunk.messages.data() + begin, chunk.messageEnds[row] - begin);
+                match = testText(message, predicate.op, predicate.texts);
+            }
+            break;
+            default:
+            {
+                int64_t value = 0;
+                switch(predicate.column)
+                {
+                    case Predicate::Column::Id:
+                        value = chunk.firstId + static_cast<int64_t>(row);
+                        break;
+                    case Predicate::Column::Timestamp:
+                        value = chunk.timestampsUs[row];
+                        break;
+                    case Predicate::Column::Line:
+                        value = chunk.lines[row];
+                        break;
+#ifdef SQLG_USE_SOURCE_INFO
+                    case Predicate::Column::SourceId:
+                        value = chunk.sourceIds[row];
+                        break;
+#endif
+                    default:
+                        break;
+                }
+
+                if(predicate.isNumeric())
+                {
+                    match = testNumber(value, predicate.op, predicate.numbers);
+                }
+                else if(predicate.column == Predicate::Column::Timestamp)
+                {
+                    // LIKE on a timestamp matches its text form
+                    std::pair<int64_t, std::string> cache { INT64_MIN, std::string() };
+                    match = testText(formatSeconds(value, cache), predicate.op, predicate.texts);
+                }
+                else
+                {
+                    match = testText(std::to_string(value), predicate.op, predicate.texts);
+                }
+            }
+            break;
+        }
+
+        if(!match)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a chunk may hold rows matching the filters (ID and timestamp ranges).
+ * @param predicates Compiled filters.
+ * @param chunk The chunk.
+ * @return False if no row of the chunk can match.
+ */
+bool MemoryDatabase::mayMatch(const std::vector<Predicate> & predicates, const Chunk& chunk)
+{
+    if(chunk.rows() == 0)
+    {
+        return false;
+    }
+
+    for(const auto & predicate : predicates)
+    {
+        if(predicate.op == FilterOp::IsNull)
+        {
+            return false;
+        }
+
+        int64_t low = 0;
+        int64_t high = 0;
+        if(predicate.column == Predicate::Column::Id)
+        {
+            low = chunk.firstId;
+            high = chunk.firstId + static_cast<int64_t>(chunk.rows()) - 1;
+        }
+        else if(predicate.column == Predicate::Column::Timestamp)
+        {
+            low = chunk.minTimestampUs;
+            high = chunk.maxTimestampUs;
+        }
+        else
+        {
+            continue;
+        }
+
+        if(!predicate.isNumeric())
+        {
+            continue;
+        }
+
+        switch(predicate.op)
+        {
+            case FilterOp::Equal:
+                if(predicate.numbers[0] < low || predicate.numbers[0] > high) return false;
+                break;
+            case FilterOp::Less:
+                if(low >= predicate.numbers[0]) return false;
+                break;
+            case FilterOp::LessEqual:
+                if(low > predicate.numbers[0]) return false;
+                break;
+            case FilterOp::Greater:
+                if(high <= predicate.numbers[0]) return false;
+                break;
+            case FilterOp::GreaterEqual:
+                if(high < predicate.numbers[0]) return false;
+                break;
+            case FilterOp::In:
+                if(std::none_of(predicate.numbers.begin(), predicate.numbers.end(), [ & ](const int64_t value)
+            {
+                return value >= low && value <= high;
+            }))
+                {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rebuilds a log entry from a row.
+ * @param table The table.
+ * @param chunk The chunk.
+ * @param row Row index within the chunk.
+ * @param timestampCache Last formatted second, reused by consecutive rows.
+ * @return LogEntry Entry with the timestamp formatted as LogHelper::formatTime().
+ */
+LogEntry MemoryDatabase::toLogEntry(const Table& table, const Chunk& chunk, const size_t row,
+                                    std::pair<int64_t, std::string> & timestampCache)
+{
+    const size_t begin = row > 0 ? chunk.messageEnds[row - 1] : 0;
+
+    LogEntry entry {};
+    entry.id = static_cast<int>(chunk.firstId + static_cast<int64_t>(row));
+#ifdef SQLG_USE_SOURCE_INFO
+    entry.sourceId = chunk.sourceIds[row];
+#endif
+    entry.timestampUs = chunk.timestampsUs[row];
+    entry.timestamp = formatSeconds(entry.timestampUs, timestampCache);
+    entry.level = table.levels.values[chunk.levels[row]];
+    entry.message.assign(chunk.messages.data() + begin, chunk.messageEnds[row] - begin);
+    entry.function = table.functions.values[chunk.functions[row]];
+    entry.file = table.files.values[chunk.files[row]];
+    entry.line = chunk.lines[row];
+    entry.threadId = table.threadIds.values[chunk.threadIds[row]];
+    return entry;
+}
+
+/**
+ * @brief Opens a store by name from the process-wide registry.
+ * @param name Database name.
+ * @param maxBytes Budget used if the store is created.
+ * @return std::shared_ptr<Store> The store.
+ */
+std::shared_ptr<MemoryDatabase::Store> MemoryDatabase::openStore(const std::string& name, const size_t maxBytes)
+{
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<Store>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for(auto it = registry.begin(); it != registry.end();)
+    {
+        it = it->second.expired() ? registry.erase(it) : std::next(it);
+    }
+
+    std::shared_ptr<Store> store = registry[name].lock();
+    if(!store)
+    {
+        store = std::make_shared<Store>();
+        store->maxBytes = maxBytes;
+        registry[name] = store;
+    }
+    return store;
+}
@@ -158,6 +158,11 @@ bool MySQLDatabase::connect(const std::string& connectionString)
 
     auto params = parseConnectionString(connectionString);
 
+    // Allow LOAD DATA LOCAL INFILE for bulkInsert(); the handler serves only its in-memory rows
+    unsigned int localInfile = 1;
+    mysql_options(conn, MYSQL_OPT_LOCAL_INFILE, & localInfile);
+    mysql_set_local_infile_handler(conn, infileInit, infileRead, infileEnd, infileError, & infileSource);
+
     if(!mysql_real_connect(conn, params[CON_STR_HOST].c_str(), params[CON_STR_USER].c_str(),
                            params[CON_STR_PASS].c_str(), params[CON_STR_DB].c_str(), std::stoi(params[CON_STR_PORT].c_str()), nullptr, 0))
     {
@@ -172,6 +177,7 @@ bool MySQLDatabase::connect(const std::string& connectionString)
  */
 void MySQLDatabase::disconnect()
 {
+    clearStatementCache();
     if(conn)
     {
         mysql_close(conn);
@@ -230,18 +236,12 @@ bool MySQLDatabase::execute(
     }
 
     // Parameterized query execution
-    MYSQL_STMT* stmt = mysql_stmt_init(conn);
+    MYSQL_STMT* stmt = getCachedStatement(query);
     if(!stmt)
     {
         return false;
     }
 
-    if(mysql_stmt_prepare(stmt, query.c_str(), query.size()))
-    {
-        mysql_stmt_close(stmt);
-        return false;
-    }
-
     // Bind parameters
     std::vector<MYSQL_BIND> binds(params.size());
     std::vector<std::vector<char>> buffers(params.size());
@@ -260,13 +260,87 @@ bool MySQLDatabase::execute(
 
     if(mysql_stmt_bind_param(stmt, binds.data()))
     {
-        mysql_stmt_close(stmt);
+        evictStatement(query);
         return false;
     }
 
     if(mysql_stmt_execute(stmt))
     {
-        mysql_stmt_close(stmt);
+        evictStatement(query);
+        return false;
+    }
+
+    if(affectedRows)
+    {
+        * affectedRows = mysql_stmt_affected_rows(stmt);
+    }
+
+    return true;
+}
+
+/**
+* @brief Executes an SQL query with typed parameters
+* @param query The SQL query to execute. Can contain parameter placeholders
+* @param params Typed parameters, text values are bound without copying where possible
+* @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+* @return true if query executed successfully
+* @note Integers are bound as MYSQL_TYPE_LONGLONG, text points at the caller's buffer.
+* @see DbParam
+*/
+bool MySQLDatabase::execute(
+    const std::string& query,
+    const DbParamList& params,
+    int* affectedRows)
+{
+    if(params.empty())
+    {
+        return execute(query, std::vector<std::string>(), affectedRows);
+    }
+
+    MYSQL_STMT* stmt = getCachedStatement(query);
+    if(!stmt)
+    {
+        return false;
+    }
+
+    std::vector<MYSQL_BIND> binds(params.size());
+    std::vector<unsigned long> lengths(params.size());
+    std::vector<long long> integers(params.size());
+
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+        binds[i] = MYSQL_BIND();
+        switch(params[i].getType())
+        {
+            case DbParamType::Int64:
+                integers[i] = params[i].getInt64();
+                binds[i].buffer_type = MYSQL_TYPE_LONGLONG;
+                binds[i].buffer = & integers[i];
+                break;
+            case DbParamType::Text:
+                // Input-only binding, the client library does not write through the buffer
+                lengths[i] = static_cast<unsigned long>(params[i].getText().size());
+                binds[i].buffer_type = MYSQL_TYPE_STRING;
+                binds[i].buffer = const_cast<char*>(params[i].getText().data());
+                binds[i].buffer_length = lengths[i];
+                binds[i].length = & lengths[i];
+                break;
+            case DbParamType::Null:
+            default:
+                binds[i].buffer_type = MYSQL_TYPE_NULL;
+                break;
+        }
+    }
+
+    if(mysql_stmt_bind_param(stmt, binds.data()))
+    {
+        evictStatement(query);
+        return false;
+    }
+
+    if(mysql_stmt_execute(stmt))
+    {
+        evictStatement(query);
         return false;
     }
 
@@ -275,7 +349,6 @@ bool MySQLDatabase::execute(
         * affectedRows = mysql_stmt_affected_rows(stmt);
     }
 
-    mysql_stmt_close(stmt);
     return true;
 }
 
@@ -289,22 +362,29 @@ std::vector<std::map<std::string, std::string>> MySQLDatabase::query(
     const std::string& query,
     const std::vector<std::string> & params)
 {
-    std::vector<std::map<std::string, std::string>> result;
+    return queryResultSet(query, params).toRows(params.empty() ? RESULT_SET_NULL_STR : "");
+}
+
+/**
+ * @brief Executes an SQL query and returns a compact columnar result.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @return ResultSet with column names stored once and values in contiguous storage.
+ */
+ResultSet MySQLDatabase::queryResultSet(
+    const std::string& query,
+    const std::vector<std::string> & params)
+{
+    ResultSet result;
 
     if(!params.empty())
     {
-        MYSQL_STMT* stmt = mysql_stmt_init(conn);
+        MYSQL_STMT* stmt = getCachedStatement(query);
         if(!stmt)
         {
             return result;
         }
 
-        if(mysql_stmt_prepare(stmt, query.c_str(), query.size()) != 0)
-        {
-            mysql_stmt_close(stmt);
-            return result;
-        }
-
         // Bind parameters
         std::vector<MYSQL_BIND> binds(params.size());
         std::vector<std::vector<char>> buffers(params.size());
@@ -323,27 +403,27 @@ std::vector<std::map<std::string, std::string>> MySQLDatabase::query(
 
         if(mysql_stmt_bind_param(stmt, binds.data()) != 0)
         {
-            mysql_stmt_close(stmt);
+            evictStatement(query);
             return result;
         }
 
         if(mysql_stmt_execute(stmt) != 0)
         {
-            mysql_stmt_close(stmt);
+            evictStatement(query);
             return result;
         }
 
         // Store result to enable row counting
         if(mysql_stmt_store_result(stmt) != 0)
         {
-            mysql_stmt_close(stmt);
+            evictStatement(query);
             return result;
         }
 
         MYSQL_RES* meta = mysql_stmt_result_metadata(stmt);
         if(!meta)
         {
-            mysql_stmt_close(stmt);
+            evictStatement(query);
             return result;
         }
 
@@ -351,39 +431,51 @@ std::vector<std::map<std::string, std::string>> MySQLDatabase::query(
         std::vector<MYSQL_BIND> result_binds(numFields);
         std::vector<std::vector<char>> result_buffers(numFields);
         std::vector<unsigned long> lengths(numFields);
+        // my_bool was replaced by bool in MySQL 8.0
+        using NullFlag = std::remove_pointer_t<decltype(MYSQL_BIND::is_null)>;
+        std::unique_ptr<NullFlag[]> isNull(new NullFlag[numFields]());
 
         MYSQL_FIELD* fields = mysql_fetch_fields(meta);
+        std::vector<std::string> columns;
+        columns.reserve(numFields);
         for(int i = 0; i < numFields; ++i)
         {
+            columns.emplace_back(fields[i].name);
             result_buffers[i].resize(fields[i].max_length > 0 ? fields[i].max_length + 1 : 256);
 
             result_binds[i].buffer_type = MYSQL_TYPE_STRING;
             result_binds[i].buffer = result_buffers[i].data();
             result_binds[i].buffer_length = result_buffers[i].size();
             result_binds[i].length = & lengths[i];
-            result_binds[i].is_null = nullptr;
+            result_binds[i].is_null = & isNull[i];
         }
+        result.setColumns(std::move(columns));
+        result.reserve(mysql_stmt_num_rows(stmt));
 
         if(mysql_stmt_bind_result(stmt, result_binds.data()) != 0)
         {
             mysql_free_result(meta);
-            mysql_stmt_close(stmt);
+            evictStatement(query);
             return result;
         }
 
         while(mysql_stmt_fetch(stmt) == 0)
         {
-            std::map<std::string, std::string> rowData;
             for(int i = 0; i < numFields; ++i)
             {
-                std::string value(result_buffers[i].data(), lengths[i]);
-                rowData[fields[i].name] = value;
+                if(isNull[i])
+                {
+                    result.appendNull();
+                }
+                else
+                {
+                    result.appendValue(std::string_view(result_buffers[i].data(), lengths[i]));
+                }
             }
-            result.push_back(rowData);
         }
 
         mysql_free_result(meta);
-        mysql_stmt_close(stmt);
+        mysql_stmt_free_result(stmt);
     }
     else
     {
@@ -401,15 +493,29 @@ std::vector<std::map<std::string, std::string>> MySQLDatabase::query(
         int numFields = mysql_num_fields(res);
         MYSQL_ROW row;
 
+        std::vector<std::string> columns;
+        columns.reserve(numFields);
+        for(int i = 0; i < numFields; ++i)
+        {
+            columns.emplace_back(mysql_fetch_field_direct(res, i)->name);
+        }
+        result.setColumns(std::move(columns));
+        result.reserve(mysql_num_rows(res));
+
         while((row = mysql_fetch_row(res)))
         {
-            std::map<std::string, std::string> rowData;
+            unsigned long* rowLengths = mysql_fetch_lengths(res);
             for(int i = 0; i < numFields; ++i)
             {
-                MYSQL_FIELD* field = mysql_fetch_field_direct(res, i);
-                rowData[field->name] = row[i] ? row[i] : "NULL";
+                if(!row[i])
+                {
+                    result.appendNull();
+                }
+                else
+                {
+                    result.appendValue(std::string_view(row[i], rowLengths[i]));
+                }
             }
-            result.push_back(rowData);
         }
 
         mysql_free_result(res);
@@ -418,6 +524,287 @@ std::vector<std::map<std::string, std::string>> MySQLDatabase::query(
     return result;
 }
 
+/**
+ * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @param callback Function called for each row; return false to stop reading.
+ * @return True if the query was executed successfully, false otherwise.
+ * @note Uses unbuffered results (mysql_use_result / no mysql_stmt_store_result), so rows are read
+ * from the database cursor without materializing the result.
+ * The callback must not run other queries on this connection.
+ */
+bool MySQLDatabase::queryEach(
+    const std::string& query,
+    const std::vector<std::string> & params,
+    const RowCallback& callback)
+{
+    ResultSet row;
+
+    if(!params.empty())
+    {
+        MYSQL_STMT* stmt = getCachedStatement(query);
+        if(!stmt)
+        {
+            return false;
+        }
+
+        // Bind parameters
+        std::vector<MYSQL_BIND> binds(params.size());
+        for(size_t i = 0; i < params.size(); ++i)
+        {
+            binds[i].buffer_type = MYSQL_TYPE_STRING;
+            binds[i].buffer = const_cast<char*>(params[i].data());
+            binds[i].buffer_length = params[i].length();
+            binds[i].is_null = nullptr;
+            binds[i].length = & binds[i].buffer_length;
+        }
+
+        if(mysql_stmt_bind_param(stmt, binds.data()) != 0 || mysql_stmt_execute(stmt) != 0)
+        {
+            evictStatement(query);
+            return false;
+        }
+
+        MYSQL_RES* meta = mysql_stmt_result_metadata(stmt);
+        if(!meta)
+        {
+            mysql_stmt_free_result(stmt);
+            evictStatement(query);
+            return false;
+        }
+
+        int numFields = mysql_num_fields(meta);
+        std::vector<MYSQL_BIND> result_binds(numFields);
+        std::vector<std::vector<char>> result_buffers(numFields);
+        std::vector<unsigned long> lengths(numFields);
+        // my_bool was replaced by bool in MySQL 8.0
+        using NullFlag = std::remove_pointer_t<decltype(MYSQL_BIND::is_null)>;
+        std::unique_ptr<NullFlag[]> isNull(new NullFlag[numFields]());
+
+        MYSQL_FIELD* fields = mysql_fetch_fields(meta);
+        std::vector<std::string> columns;
+        columns.reserve(numFields);
+        for(int i = 0; i < numFields; ++i)
+        {
+            columns.emplace_back(fields[i].name);
+            result_buffers[i].resize(256); // max_length is unknown without mysql_stmt_store_result
+
+            result_binds[i].buffer_type = MYSQL_TYPE_STRING;
+            result_binds[i].buffer = result_buffers[i].data();
+            result_binds[i].buffer_length = result_buffers[i].size();
+            result_binds[i].length = & lengths[i];
+            result_binds[i].is_null = & isNull[i];
+        }
+        row.setColumns(std::move(columns));
+        mysql_free_result(meta);
+
+        if(mysql_stmt_bind_result(stmt, result_binds.data()) != 0)
+        {
+            mysql_stmt_free_result(stmt);
+            evictStatement(query);
+            return false;
+        }
+
+        int rc;
+        while((rc = mysql_stmt_fetch(stmt)) == 0 || rc == MYSQL_DATA_TRUNCATED)
+        {
+            bool rebind = false;
+            for(int i = 0; i < numFields; ++i)
+            {
+                if(!isNull[i] && lengths[i] > result_buffers[i].size())
+                {
+                    // Grow the buffer and fetch the full value of the truncated column
+                    result_buffers[i].resize(lengths[i]);
+                    result_binds[i].buffer = result_buffers[i].data();
+                    result_binds[i].buffer_length = result_buffers[i].size();
+                    if(mysql_stmt_fetch_column(stmt, & result_binds[i], i, 0) != 0)
+                    {
+                        rc = 1;
+                        break;
+                    }
+                    rebind = true;
+                }
+            }
+
+            if(rc == 1 || (rebind && mysql_stmt_bind_result(stmt, result_binds.data()) != 0))
+            {
+                rc = 1;
+                break;
+            }
+
+            row.clearRows();
+            for(int i = 0; i < numFields; ++i)
+            {
+                if(isNull[i])
+                {
+                    row.appendNull();
+                }
+                else
+                {
+                    row.appendValue(std::string_view(result_buffers[i].data(), lengths[i]));
+                }
+            }
+
+            if(!callback(row, 0))
+            {
+                rc = MYSQL_NO_DATA;
+                break;
+            }
+        }
+
+        // Discards any unread rows
+        mysql_stmt_free_result(stmt);
+        return rc == MYSQL_NO_DATA;
+    }
+
+    if(mysql_query(conn, query.c_str()) != 0)
+    {
+        return false;
+    }
+
+    MYSQL_RES* res = mysql_use_result(conn);
+    if(!res)
+    {
+        return false;
+    }
+
+    int numFields = mysql_num_fields(res);
+    std::vector<std::string> columns;
+    columns.reserve(numFields);
+    for(int i = 0; i < numFields; ++i)
+    {
+        columns.emplace_back(mysql_fetch_field_direct(res, i)->name);
+    }
+    row.setColumns(std::move(columns));
+
+    bool stopped = false;
+    MYSQL_ROW dbRow;
+    while((dbRow = mysql_fetch_row(res)))
+    {
+        unsigned long* rowLengths = mysql_fetch_lengths(res);
+        row.clearRows();
+        for(int i = 0; i < numFields; ++i)
+        {
+            if(!dbRow[i])
+            {
+                row.appendNull();
+            }
+            else
+            {
+                row.appendValue(std::string_view(dbRow[i], rowLengths[i]));
+            }
+        }
+
+        if(!callback(row, 0))
+        {
+            stopped = true;
+            break;
+        }
+    }
+
+    const bool success = stopped || mysql_errno(conn) == 0;
+
+    // Reads and discards any unread rows
+    mysql_free_result(res);
+    return success;
+}
+
+/**
+ * @brief LOCAL INFILE init callback: accepts only MYSQL_BULK_INFILE_NAME during bulkInsert().
+ * @param ptr Receives the source, or nullptr if the request is rejected.
+ * @param filename File name requested by the server.
+ * @param userdata The InfileSource.
+ * @return int 0 if accepted, non-zero otherwise.
+ */
+int MySQLDatabase::infileInit(void** ptr, const char* filename, void* userdata)
+{
+    auto* source = static_cast<InfileSource*>(userdata);
+    if(!source->data || !filename || std::strcmp(filename, MYSQL_BULK_INFILE_NAME) != 0)
+    {
+        * ptr = nullptr;
+        return 1;
+    }
+    * ptr = source;
+    return 0;
+}
+
+/**
+ * @brief LOCAL INFILE read callback: copies the next chunk of the in-memory rows.
+ * @param ptr The InfileSource.
+ * @param buf Destination buffer.
+ * @param bufLen Buffer size.
+ * @return int Bytes copied, 0 at the end.
+ */
+int MySQLDatabase::infileRead(void* ptr, char* buf, unsigned int bufLen)
+{
+    auto* source = static_cast<InfileSource*>(ptr);
+    const size_t count = std::min(static_cast<size_t>(bufLen), source->data->size() - source->offset);
+    std::memcpy(buf, source->data->data() + source->offset, count);
+    source->offset += count;
+    return static_cast<int>(count);
+}
+
+/**
+ * @brief LOCAL INFILE end callback (nothing to release).
+ * @param ptr The InfileSource, or nullptr.
+ */
+void MySQLDatabase::infileEnd(void* /*ptr*/)
+{
+}
+
+/**
+ * @brief LOCAL INFILE error callback.
+ * @param ptr The InfileSource, or nullptr if the request was rejected.
+ * @param errorMsg Receives the error message.
+ * @param errorMsgLen Size of errorMsg.
+ * @return int MySQL client error code.
+ */
+int MySQLDatabase::infileError(void* ptr, char* errorMsg, unsigned int errorMsgLen)
+{
+    std::snprintf(errorMsg, errorMsgLen, "%s", ptr ? ERR_MSG_FAILED_BULK_SEND : ERR_MSG_INFILE_REJECTED);
+    return CR_UNKNOWN_ERROR;
+}
+
+/**
+ * @brief Loads rows with LOAD DATA LOCAL INFILE fed from an in-memory buffer.
+ * @param table Target table name.
+ * @param fields Column names.
+ * @param values Row-major values, fields.size() items per row.
+ * @param affectedRows Optional pointer to store number of loaded rows.
+ * @return True if all rows were loaded, false otherwise.
+ * @note Requires local_infile to be enabled on the server.
+ */
+bool MySQLDatabase::bulkInsert(
+    const std::string& table,
+    const std::vector<std::string> & fields,
+    const std::vector<std::string> & values,
+    int* affectedRows)
+{
+    if(!conn || fields.empty() || values.size() % fields.size() != 0)
+    {
+        return false;
+    }
+
+    const std::string data = DataBaseHelper::encodeBulkRows(values, fields.size());
+
+    // Default FIELDS/LINES options match DataBaseHelper::encodeBulkRows()
+    const std::string loadQuery = "LOAD DATA LOCAL INFILE '" MYSQL_BULK_INFILE_NAME "' INTO TABLE " + table
+                                  + " (" + StringHelper::join(fields, ", ") + ")";
+
+    // Armed only for this query; the handler rejects requests while data is nullptr
+    infileSource = InfileSource{ & data, 0 };
+    const bool success = mysql_real_query(conn, loadQuery.c_str(), static_cast<unsigned long>(loadQuery.size())) == 0;
+    infileSource = InfileSource{};
+
+    if(success && affectedRows)
+    {
+        * affectedRows = static_cast<int>(mysql_affected_rows(conn));
+    }
+
+    return success;
+}
+
 /**
  * @brief Begins a transaction.
  * @return True if the transaction was started successfully, false otherwise.
@@ -458,6 +845,79 @@ std::string MySQLDatabase::getLastError() const
     return ERR_MSG_FAILED_NOT_CONNECTED_DB;
 }
 
+/**
+ * @brief Returns a prepared statement for the query, reusing a cached handle if available.
+ * @param query The SQL query text (used as cache key).
+ * @return Prepared statement handle, or nullptr if preparation failed.
+ * @note Least recently used statement is closed when the cache exceeds MYSQL_STMT_CACHE_SIZE.
+ */
+MYSQL_STMT* MySQLDatabase::getCachedStatement(const std::string& query)
+{
+    auto it = stmtCacheIndex.find(query);
+    if(it != stmtCacheIndex.end())
+    {
+        // Move to front (most recently used)
+        stmtCache.splice(stmtCache.begin(), stmtCache, it->second);
+        return it->second->second;
+    }
+
+    MYSQL_STMT* stmt = mysql_stmt_init(conn);
+    if(!stmt)
+    {
+        return nullptr;
+    }
+
+    if(mysql_stmt_prepare(stmt, query.c_str(), query.size()))
+    {
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+
+    stmtCache.emplace_front(query, stmt);
+    stmtCacheIndex[query] = stmtCache.begin();
+
+    // Evict least recently used
+    if(stmtCache.size() > MYSQL_STMT_CACHE_SIZE)
+    {
+        mysql_stmt_close(stmtCache.back().second);
+        stmtCacheIndex.erase(stmtCache.back().first);
+        stmtCache.pop_back();
+    }
+
+    return stmt;
+}
+
+/**
+ * @brief Closes and removes a cached statement (e.g. after an execution error).
+ * @param query The SQL query text of the statement.
+ */
+void MySQLDatabase::evictStatement(const std::string& query)
+{
+    auto it = stmtCacheIndex.find(query);
+    if(it == stmtCacheIndex.end())
+    {
+        return;
+    }
+
+    mysql_stmt_close(it->second->second);
+    stmtCache.erase(it->second);
+    stmtCacheIndex.erase(it);
+}
+
+/**
+ * @brief Closes all cached prepared statements.
+ * @note Must be called before the connection handle is closed.
+ */
+void MySQLDatabase::clearStatementCache()
+{
+    for(auto & [query, stmt] : stmtCache)
+    {
+        mysql_stmt_close(stmt);
+    }
+    stmtCache.clear();
+    stmtCacheIndex.clear();
+}
+
 /**
  * @brief Gets the type of the database.
  * @return The database type (MySQL in this case).
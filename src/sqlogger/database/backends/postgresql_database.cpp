@@ -67,6 +67,9 @@ bool PostgreSQLDatabase::connect(const std::string& connectionString)
         disconnect();
     }
 
+    // Statements of a previous session don't exist in the new one
+    clearStatementCache();
+
     conn = PQconnectdb(connectionString.c_str());
     if(PQstatus(conn) != CONNECTION_OK)
     {
@@ -81,6 +84,7 @@ bool PostgreSQLDatabase::connect(const std::string& connectionString)
  */
 void PostgreSQLDatabase::disconnect()
 {
+    clearStatementCache();
     if(conn)
     {
         PQfinish(conn);
@@ -132,21 +136,63 @@ bool PostgreSQLDatabase::execute(
 
     lastError.clear();
 
-    // Convert params to array of C strings
-    std::vector<const char*> paramValues(params.size());
-    for(size_t i = 0; i < params.size(); ++i)
+    PGresult* res = execPrepared(query, params);
+    if(!res)
     {
-        paramValues[i] = params[i].c_str();
+        return false;
+    }
+
+    bool success = (PQresultStatus(res) == PGRES_COMMAND_OK ||
+                    PQresultStatus(res) == PGRES_TUPLES_OK);
+
+    if(success && affectedRows)
+    {
+        char* countStr = PQcmdTuples(res);
+        * affectedRows = countStr[0] ? std::stoi(countStr) : 0;
+    }
+
+    if(!success)
+    {
+        lastError = PQerrorMessage(conn);
+        evictStatement(query);
+    }
+
+    PQclear(res);
+    return success;
+}
+
+/**
+* @brief Executes an SQL query with typed parameters
+* @param query The SQL query to execute. Can contain parameter placeholders
+* @param params Typed parameters, text values are bound without copying where possible
+* @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+* @return true if query executed successfully
+* @note Integers are sent as binary int8, text in text format.
+* @see DbParam
+*/
+bool PostgreSQLDatabase::execute(
+    const std::string& query,
+    const DbParamList& params,
+    int* affectedRows)
+{
+    if(params.empty())
+    {
+        return execute(query, std::vector<std::string>(), affectedRows);
+    }
+
+    if(!isConnected())
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return false;
     }
 
-    PGresult* res = PQexecParams(conn,
-                                 query.c_str(),
-                                 params.size(),
-                                 nullptr,  // let PostgreSQL infer param types
-                                 paramValues.data(),
-                                 nullptr,  // param lengths (null means strings are null-terminated)
-                                 nullptr,  // param formats (0=text, 1=binary)
-                                 0);       // result format (0=text, 1=binary)
+    lastError.clear();
+
+    PGresult* res = execPrepared(query, params);
+    if(!res)
+    {
+        return false;
+    }
 
     bool success = (PQresultStatus(res) == PGRES_COMMAND_OK ||
                     PQresultStatus(res) == PGRES_TUPLES_OK);
@@ -160,6 +206,7 @@ bool PostgreSQLDatabase::execute(
     if(!success)
     {
         lastError = PQerrorMessage(conn);
+        evictStatement(typedStatementKey(query, params));
     }
 
     PQclear(res);
@@ -175,7 +222,19 @@ bool PostgreSQLDatabase::execute(
 std::vector<std::map<std::string, std::string>> PostgreSQLDatabase::query(const std::string& query,
         const std::vector<std::string> & params)
 {
-    std::vector<std::map<std::string, std::string>> result;
+    return queryResultSet(query, params).toRows();
+}
+
+/**
+ * @brief Executes an SQL query and returns a compact columnar result.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @return ResultSet with column names stored once and values in contiguous storage.
+ */
+ResultSet PostgreSQLDatabase::queryResultSet(const std::string& query,
+        const std::vector<std::string> & params)
+{
+    ResultSet result;
     if(!isConnected())
     {
         lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
@@ -184,25 +243,16 @@ std::vector<std::map<std::string, std::string>> PostgreSQLDatabase::query(const
 
     lastError.clear();
 
-    // Convert params to array of C strings
-    std::vector<const char*> paramValues(params.size());
-    for(size_t i = 0; i < params.size(); ++i)
+    PGresult* res = execPrepared(query, params);
+    if(!res)
     {
-        paramValues[i] = params[i].c_str();
+        return result;
     }
 
-    PGresult* res = PQexecParams(conn,
-                                 query.c_str(),
-                                 params.size(),
-                                 nullptr,  // let PostgreSQL infer param types
-                                 paramValues.data(),
-                                 nullptr,  // param lengths (null means strings are null-terminated)
-                                 nullptr,  // param formats (0=text, 1=binary)
-                                 0);       // result format (0=text, 1=binary)
-
     if(PQresultStatus(res) != PGRES_TUPLES_OK)
     {
         lastError = PQerrorMessage(conn);
+        evictStatement(query);
         PQclear(res);
         return result;
     }
@@ -210,14 +260,28 @@ std::vector<std::map<std::string, std::string>> PostgreSQLDatabase::query(const
     int rowCount = PQntuples(res);
     int colCount = PQnfields(res);
 
+    std::vector<std::string> columns;
+    columns.reserve(colCount);
+    for(int j = 0; j < colCount; ++j)
+    {
+        columns.emplace_back(PQfname(res, j));
+    }
+    result.setColumns(std::move(columns));
+    result.reserve(rowCount);
+
     for(int i = 0; i < rowCount; ++i)
     {
-        std::map<std::string, std::string> row;
         for(int j = 0; j < colCount; ++j)
         {
-            row[PQfname(res, j)] = PQgetvalue(res, i, j) ? PQgetvalue(res, i, j) : "NULL";
+            if(PQgetisnull(res, i, j))
+            {
+                result.appendNull();
+            }
+            else
+            {
+                result.appendValue(std::string_view(PQgetvalue(res, i, j), PQgetlength(res, i, j)));
+            }
         }
-        result.push_back(row);
     }
 
     PQclear(res);
@@ -225,6 +289,185 @@ std::vector<std::map<std::string, std::string>> PostgreSQLDatabase::query(const
     return result;
 }
 
+/**
+ * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @param callback Function called for each row; return false to stop reading.
+ * @return True if the query was executed successfully, false otherwise.
+ * @note Uses libpq single-row mode, so rows are read from the database cursor without materializing the result.
+ * The callback must not run other queries on this connection.
+ */
+bool PostgreSQLDatabase::queryEach(const std::string& query,
+                                   const std::vector<std::string> & params,
+                                   const RowCallback& callback)
+{
+    if(!isConnected())
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return false;
+    }
+
+    lastError.clear();
+
+    std::vector<const char*> paramValues(params.size());
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+        paramValues[i] = params[i].c_str();
+    }
+
+    if(!PQsendQueryParams(conn,
+                          query.c_str(),
+                          static_cast<int>(params.size()),
+                          nullptr,
+                          paramValues.data(),
+                          nullptr,
+                          nullptr,
+                          0)
+            || !PQsetSingleRowMode(conn))
+    {
+        lastError = PQerrorMessage(conn);
+        while(PGresult* res = PQgetResult(conn))
+        {
+            PQclear(res);
+        }
+        return false;
+    }
+
+    ResultSet row;
+    bool columnsSet = false;
+    bool stopped = false;
+    bool success = true;
+
+    while(PGresult* res = PQgetResult(conn))
+    {
+        const ExecStatusType status = PQresultStatus(res);
+
+        if(status == PGRES_SINGLE_TUPLE && !stopped)
+        {
+            const int colCount = PQnfields(res);
+            if(!columnsSet)
+            {
+                std::vector<std::string> columns;
+                columns.reserve(colCount);
+                for(int j = 0; j < colCount; ++j)
+                {
+                    columns.emplace_back(PQfname(res, j));
+                }
+                row.setColumns(std::move(columns));
+                columnsSet = true;
+            }
+
+            row.clearRows();
+            for(int j = 0; j < colCount; ++j)
+            {
+                if(PQgetisnull(res, 0, j))
+                {
+                    row.appendNull();
+                }
+                else
+                {
+                    row.appendValue(std::string_view(PQgetvalue(res, 0, j), PQgetlength(res, 0, j)));
+                }
+            }
+
+            if(!callback(row, 0))
+            {
+                // Drain the remaining rows; cancelling could abort an open transaction
+                stopped = true;
+            }
+        }
+        else if(status != PGRES_SINGLE_TUPLE && status != PGRES_TUPLES_OK && !stopped)
+        {
+            lastError = PQerrorMessage(conn);
+            success = false;
+        }
+
+        PQclear(res);
+    }
+
+    return success;
+}
+
+/**
+ * @brief Loads rows with COPY ... FROM STDIN (text format)
+ * @param table Target table name
+ * @param fields Column names
+ * @param values Row-major values, fields.size() items per row
+ * @param affectedRows Optional pointer to store number of loaded rows
+ * @return true if COPY completed successfully
+ */
+bool PostgreSQLDatabase::bulkInsert(
+    const std::string& table,
+    const std::vector<std::string> & fields,
+    const std::vector<std::string> & values,
+    int* affectedRows)
+{
+    if(!isConnected())
+    {
+        lastError = ERR_MSG_FAILED_NOT_CONNECTED_DB;
+        return false;
+    }
+
+    lastError.clear();
+
+    if(fields.empty() || values.size() % fields.size() != 0)
+    {
+        lastError = ERR_MSG_INVALID_BULK_ROWS;
+        return false;
+    }
+
+    const std::string copyQuery = "COPY " + table + " (" + StringHelper::join(fields, ", ") + ") FROM STDIN";
+
+    PGresult* res = PQexec(conn, copyQuery.c_str());
+    if(PQresultStatus(res) != PGRES_COPY_IN)
+    {
+        lastError = PQerrorMessage(conn);
+        PQclear(res);
+        return false;
+    }
+    PQclear(res);
+
+    const std::string data = DataBaseHelper::encodeBulkRows(values, fields.size());
+
+    bool sent = true;
+    for(size_t offset = 0; offset < data.size(); offset += PG_COPY_CHUNK_SIZE)
+    {
+        const size_t chunk = std::min(static_cast<size_t>(PG_COPY_CHUNK_SIZE), data.size() - offset);
+        if(PQputCopyData(conn, data.data() + offset, static_cast<int>(chunk)) != 1)
+        {
+            sent = false;
+            break;
+        }
+    }
+
+    if(PQputCopyEnd(conn, sent ? nullptr : ERR_MSG_FAILED_BULK_SEND) != 1)
+    {
+        sent = false;
+    }
+
+    bool success = sent;
+    while((res = PQgetResult(conn)) != nullptr)
+    {
+        if(PQresultStatus(res) != PGRES_COMMAND_OK)
+        {
+            success = false;
+        }
+        else if(affectedRows)
+        {
+            * affectedRows = std::atoi(PQcmdTuples(res));
+        }
+        PQclear(res);
+    }
+
+    if(!success)
+    {
+        lastError = PQerrorMessage(conn);
+    }
+
+    return success;
+}
+
 /**
  * @brief Starts database transaction
  * @return true if transaction started successfully
@@ -431,3 +674,267 @@ std::map<std::string, std::string> PostgreSQLDatabase::parseConnectionString(con
     }
     return params;
 }
+
+/**
+ * @brief Executes a parameterized query through a cached server-side prepared statement
+ * @param query SQL query text (used as cache key)
+ * @param params Text parameter values
+ * @return Query result (caller must PQclear), or nullptr if preparation failed
+ * @note Statement is prepared once per connection with PQprepare and reused via PQexecPrepared
+ */
+PGresult* PostgreSQLDatabase::execPrepared(const std::string& query, const std::vector<std::string> & params)
+{
+    // Convert params to array of C strings
+    std::vector<const char*> paramValues(params.size());
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+        paramValues[i] = params[i].c_str();
+    }
+
+    // Statements without parameters (DDL, transaction control) are not cached
+    if(params.empty())
+    {
+        return PQexecParams(conn,
+                            query.c_str(),
+                            0,
+                            nullptr,  // let PostgreSQL infer param types
+                            nullptr,  // no param values
+                            nullptr,  // param lengths (null means strings are null-terminated)
+                            nullptr,  // param formats (0=text, 1=binary)
+                            0);       // result format (0=text, 1=binary)
+    }
+
+    return execCached(query, query, static_cast<int>(params.size()), nullptr, paramValues.data(), nullptr, nullptr);
+}
+
+/**
+ * @brief Executes a query with typed parameters through a cached server-side prepared statement
+ * @param query SQL query text
+ * @param params Typed parameter values
+ * @return Query result (caller must PQclear), or nullptr if preparation failed
+ * @note Cached under typedStatementKey(), as integer parameters are prepared as int8
+ */
+PGresult* PostgreSQLDatabase::execPrepared(const std::string& query, const DbParamList& params)
+{
+    const size_t count = params.size();
+    std::vector<Oid> types(count, 0);
+    std::vector<const char*> values(count, nullptr);
+    std::vector<int> lengths(count, 0);
+    std::vector<int> formats(count, 0);
+    std::vector<std::array<char, 8>> integers(count);
+    std::vector<std::string> copies;
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        switch(params[i].getType())
+        {
+            case DbParamType::Int64:
+            {
+                // Binary int8 is big-endian
+                const uint64_t value = static_cast<uint64_t>(params[i].getInt64());
+                for(size_t b = 0; b < 8; ++b)
+                {
+                    integers[i][b] = static_cast<char>((value >> (56 - 8 * b)) & 0xFF);
+                }
+                types[i] = PG_INT8_OID;
+                values[i] = integers[i].data();
+                lengths[i] = 8;
+                formats[i] = 1;
+                break;
+            }
+            case DbParamType::Text:
+                if(params[i].isNullTerminated())
+                {
+                    values[i] = params[i].getText().data();
+                }
+                else
+                {
+                    // Text format needs a C string
+                    if(copies.empty())
+                    {
+                        copies.reserve(count);
+                    }
+                    copies.emplace_back(params[i].getText());
+                    values[i] = copies.back().c_str();
+                }
+                break;
+            case DbParamType::Null:
+            default:
+                break;
+        }
+    }
+
+    return execCached(query, typedStatementKey(query, params), static_cast<int>(count),
+                      types.data(), values.data(), lengths.data(), formats.data());
+}
+
+/**
+ * @brief Gets the statement cache key for a typed parameter list
+ * @param query SQL query text
+ * @param params Typed parameter values
+ * @return Query text followed by the parameter type signature
+ */
+std::string PostgreSQLDatabase::typedStatementKey(const std::string& query, const DbParamList& params)
+{
+    std::string key;
+    key.reserve(query.size() + params.size() + 1);
+    key += query;
+    key += '\n';
+    for(const auto & param : params)
+    {
+        key += param.getType() == DbParamType::Int64 ? 'i' : '-';
+    }
+    return key;
+}
+
+/**
+ * @brief Prepares (once) and executes a cached statement
+ * @param query SQL query text
+ * @param cacheKey Statement cache key
+ * @param nParams Number of parameters
+ * @param types Parameter type OIDs (nullptr or 0 = inferred)
+ * @param values Parameter values
+ * @param lengths Parameter lengths (binary parameters only)
+ * @param formats Parameter formats (0 = text, 1 = binary)
+ * @return Query result (caller must PQclear), or nullptr if preparation failed
+ */
+PGresult* PostgreSQLDatabase::execCached(const std::string& query, const std::string& cacheKey, const int nParams,
+        const Oid* types, const char* const* values, const int* lengths, const int* formats)
+{
+    if(PQstatus(conn) != CONNECTION_OK)
+    {
+        // The session and its statements are gone
+        clearStatementCache();
+    }
+    releaseDeferredStatements();
+
+    std::string stmtName;
+    auto it = stmtCacheIndex.find(cacheKey);
+    const bool cached = it != stmtCacheIndex.end();
+    if(cached)
+    {
+        // Move to front (most recently used)
+        stmtCache.splice(stmtCache.begin(), stmtCache, it->second);
+        stmtName = it->second->second;
+    }
+    else
+    {
+        stmtName = PG_STMT_NAME_PREFIX + std::to_string(++stmtCounter);
+
+        PGresult* prep = PQprepare(conn,
+                                   stmtName.c_str(),
+                                   query.c_str(),
+                                   nParams,
+                                   types); // nullptr or 0 lets PostgreSQL infer param types
+
+        if(PQresultStatus(prep) != PGRES_COMMAND_OK)
+        {
+            lastError = PQerrorMessage(conn);
+            PQclear(prep);
+            return nullptr;
+        }
+        PQclear(prep);
+
+        stmtCache.emplace_front(cacheKey, stmtName);
+        stmtCacheIndex[cacheKey] = stmtCache.begin();
+
+        // Evict least recently used
+        if(stmtCache.size() > PG_STMT_CACHE_SIZE)
+        {
+            evictStatement(stmtCache.back().first);
+        }
+    }
+
+    PGresult* res = PQexecPrepared(conn,
+                                   stmtName.c_str(),
+                                   nParams,
+                                   values,
+                                   lengths,  // param lengths (null means strings are null-terminated)
+                                   formats,  // param formats (0=text, 1=binary)
+                                   0);       // result format (0=text, 1=binary)
+
+    const char* sqlState = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+    if(sqlState && std::string(sqlState) == PG_SQLSTATE_UNKNOWN_STATEMENT)
+    {
+        // Deallocated behind the cache (e.g. DISCARD ALL or a pooler switching sessions)
+        forgetStatement(cacheKey);
+        if(cached && PQtransactionStatus(conn) == PQTRANS_IDLE)
+        {
+            // Nothing was aborted: prepare again and retry once
+            PQclear(res);
+            return execCached(query, cacheKey, nParams, types, values, lengths, formats);
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Deallocates and removes a cached statement
+ * @param query Cache key of the statement (query text for text parameters)
+ */
+void PostgreSQLDatabase::evictStatement(const std::string& query)
+{
+    const std::string stmtName = forgetStatement(query);
+    if(stmtName.empty() || !isConnected())
+    {
+        return;
+    }
+
+    if(PQtransactionStatus(conn) != PQTRANS_IDLE)
+    {
+        // DEALLOCATE fails in an aborted transaction and would abort an open one on error
+        deferredDeallocations.push_back(stmtName);
+        return;
+    }
+
+    const std::string deallocQuery = "DEALLOCATE " + stmtName;
+    PQclear(PQexec(conn, deallocQuery.c_str()));
+}
+
+/**
+ * @brief Removes a cached statement without deallocating it
+ * @param query Cache key of the statement (query text for text parameters)
+ * @return std::string Statement name, or an empty string if the key is not cached
+ */
+std::string PostgreSQLDatabase::forgetStatement(const std::string& query)
+{
+    auto it = stmtCacheIndex.find(query);
+    if(it == stmtCacheIndex.end())
+    {
+        return "";
+    }
+
+    const std::string stmtName = it->second->second;
+    stmtCache.erase(it->second);
+    stmtCacheIndex.erase(it);
+    return stmtName;
+}
+
+/**
+ * @brief Deallocates the statements evicted inside a transaction, if no transaction is open now
+ */
+void PostgreSQLDatabase::releaseDeferredStatements()
+{
+    if(deferredDeallocations.empty() || !isConnected() || PQtransactionStatus(conn) != PQTRANS_IDLE)
+    {
+        return;
+    }
+
+    for(const auto & stmtName : deferredDeallocations)
+    {
+        const std::string deallocQuery = "DEALLOCATE " + stmtName;
+        PQclear(PQexec(conn, deallocQuery.c_str()));
+    }
+    deferredDeallocations.clear();
+}
+
+/**
+ * @brief Forgets all cached statements
+ * @note Server-side statements are released together with the session
+ */
+void PostgreSQLDatabase::clearStatementCache()
+{
+    stmtCache.clear();
+    stmtCacheIndex.clear();
+    deferredDeallocations.clear();
+}
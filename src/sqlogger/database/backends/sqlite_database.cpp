@@ -22,9 +22,10 @@
 /**
  * @brief Constructs an SQLiteDatabase object.
  * @param dbPath The path to the SQLite database file.
+ * @param pragmas Connection tuning applied on every (re)connect.
  * @throws std::runtime_error if the database cannot be opened.
  */
-SQLiteDatabase::SQLiteDatabase(const std::string& dbPath) : dbPath(dbPath), db(nullptr)
+SQLiteDatabase::SQLiteDatabase(const std::string& dbPath, const SQLitePragmas& pragmas) : db(nullptr), dbPath(dbPath), pragmas(pragmas)
 {
     std::string errMsg;
     if(!FSHelper::createDir(dbPath, errMsg))
@@ -75,6 +76,7 @@ bool SQLiteDatabase::connect(const std::string& path)
 {
     if(db)
     {
+        clearStatementCache();
         sqlite3_close(db);
     }
 
@@ -83,12 +85,67 @@ bool SQLiteDatabase::connect(const std::string& path)
         return false;
     }
 
-#if USE_WAL_MODE == 1
-    if(!execute("PRAGMA journal_mode=WAL;"))
+    return applyPragmas();
+}
+
+/**
+ * @brief Applies the configured pragmas to the open connection.
+ * @return True if all pragmas were applied, false otherwise.
+ * @note page_size is applied first since it can't be changed once WAL mode is on.
+ */
+bool SQLiteDatabase::applyPragmas()
+{
+    std::vector<std::string> statements;
+
+    if(pragmas.pageSize)
     {
-        return false;
+        statements.emplace_back("PRAGMA page_size=" + std::to_string( * pragmas.pageSize) + ";");
     }
+
+#ifdef SQLITE_DEFAULT_JOURNAL_MODE
+    const std::optional<std::string> journalMode = pragmas.journalMode.value_or(SQLITE_DEFAULT_JOURNAL_MODE);
+#else
+    const std::optional<std::string> journalMode = pragmas.journalMode;
 #endif
+    const std::string synchronous = pragmas.synchronous.value_or(SQLITE_DEFAULT_SYNCHRONOUS);
+
+    // Mode names are spliced into the statement, accept keywords only
+    auto isKeyword = [](const std::string & value)
+    {
+        return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c)
+        {
+            return std::isalpha(c);
+        });
+    };
+
+    if(journalMode)
+    {
+        if(!isKeyword( * journalMode))
+        {
+            return false;
+        }
+        statements.emplace_back("PRAGMA journal_mode=" + * journalMode + ";");
+    }
+
+    if(!isKeyword(synchronous))
+    {
+        return false;
+    }
+    statements.emplace_back("PRAGMA synchronous=" + synchronous + ";");
+    statements.emplace_back("PRAGMA cache_size=" + std::to_string(pragmas.cacheSize.value_or(SQLITE_DEFAULT_CACHE_SIZE)) + ";");
+    statements.emplace_back("PRAGMA mmap_size=" + std::to_string(pragmas.mmapSize.value_or(SQLITE_DEFAULT_MMAP_SIZE)) + ";");
+
+    // sqlite3_exec directly: execute() reconnects on failure, which would re-enter here
+    for(const auto & statement : statements)
+    {
+        char* errMsg = nullptr;
+        if(sqlite3_exec(db, statement.c_str(), nullptr, nullptr, & errMsg) != SQLITE_OK)
+        {
+            std::cerr << ERR_MSG_SQL_ERR << (errMsg ? errMsg : statement) << std::endl;
+            sqlite3_free(errMsg);
+            return false;
+        }
+    }
 
     return true;
 }
@@ -100,6 +157,7 @@ void SQLiteDatabase::disconnect()
 {
     if(db)
     {
+        clearStatementCache();
         sqlite3_close(db);
         db = nullptr;
     }
@@ -139,8 +197,8 @@ bool SQLiteDatabase::execute(
     }
 
     // Parameterized query execution
-    sqlite3_stmt* stmt;
-    if(sqlite3_prepare_v2(db, query.c_str(), -1, & stmt, nullptr) != SQLITE_OK)
+    sqlite3_stmt* stmt = getCachedStatement(query);
+    if(!stmt)
     {
         std::cerr << ERR_MSG_FAILED_PREPARE_STMT << sqlite3_errmsg(db) << std::endl;
         return false;
@@ -152,6 +210,66 @@ bool SQLiteDatabase::execute(
         sqlite3_bind_text(stmt, i + 1, params[i].c_str(), -1, SQLITE_TRANSIENT);
     }
 
+    return stepStatement(stmt, affectedRows);
+}
+
+/**
+* @brief Executes an SQL query with typed parameters
+* @param query The SQL query to execute. Can contain parameter placeholders
+* @param params Typed parameters, text values are bound without copying where possible
+* @param affectedRows Optional pointer to store number of affected rows (default nullptr)
+* @return true if query executed successfully
+* @note Integers are bound with sqlite3_bind_int64(), text with SQLITE_STATIC.
+* @see DbParam
+*/
+bool SQLiteDatabase::execute(
+    const std::string& query,
+    const DbParamList& params,
+    int* affectedRows)
+{
+    if(params.empty())
+    {
+        return execute(query, std::vector<std::string>(), affectedRows);
+    }
+
+    sqlite3_stmt* stmt = getCachedStatement(query);
+    if(!stmt)
+    {
+        std::cerr << ERR_MSG_FAILED_PREPARE_STMT << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    // Parameters outlive the step, so text is bound in place (SQLITE_STATIC)
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+        const int index = static_cast<int>(i + 1);
+        switch(params[i].getType())
+        {
+            case DbParamType::Int64:
+                sqlite3_bind_int64(stmt, index, params[i].getInt64());
+                break;
+            case DbParamType::Text:
+                sqlite3_bind_text(stmt, index, params[i].getText().data(),
+                                  static_cast<int>(params[i].getText().size()), SQLITE_STATIC);
+                break;
+            case DbParamType::Null:
+            default:
+                sqlite3_bind_null(stmt, index);
+                break;
+        }
+    }
+
+    return stepStatement(stmt, affectedRows);
+}
+
+/**
+ * @brief Steps a bound statement to completion and resets it.
+ * @param stmt Statement with bound parameters.
+ * @param affectedRows Optional pointer to store number of affected rows.
+ * @return True if the statement completed (SQLITE_DONE).
+ */
+bool SQLiteDatabase::stepStatement(sqlite3_stmt* stmt, int* affectedRows)
+{
     int rc = sqlite3_step(stmt);
     bool success = (rc == SQLITE_DONE);
 
@@ -160,7 +278,7 @@ bool SQLiteDatabase::execute(
         * affectedRows = sqlite3_changes(db);
     }
 
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
 
     if(!success)
     {
@@ -180,40 +298,132 @@ bool SQLiteDatabase::execute(
 std::vector<std::map<std::string, std::string>> SQLiteDatabase::query(const std::string& query,
         const std::vector<std::string> & params)
 {
-    std::vector<std::map<std::string, std::string>> result;
-    sqlite3_stmt* stmt;
+    return queryResultSet(query, params).toRows();
+}
+
+/**
+ * @brief Executes an SQL query and returns a compact columnar result.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @return ResultSet with column names stored once and values in contiguous storage.
+ */
+ResultSet SQLiteDatabase::queryResultSet(const std::string& query,
+        const std::vector<std::string> & params)
+{
+    ResultSet result;
+    sqlite3_stmt* stmt = getCachedStatement(query);
+
+    if(!stmt)
+    {
+        std::cerr << ERR_MSG_FAILED_QUERY << ": " << sqlite3_errmsg(db) << std::endl;
+        return result;
+    }
 
-    if(sqlite3_prepare_v2(db, query.c_str(), -1, & stmt, nullptr) == SQLITE_OK)
+    // Bind parameters
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+        sqlite3_bind_text(stmt, i + 1, params[i].c_str(), -1, SQLITE_STATIC);
+    }
+
+    const int columnCount = sqlite3_column_count(stmt);
+    std::vector<std::string> columns;
+    columns.reserve(columnCount);
+    for(int i = 0; i < columnCount; ++i)
     {
-        // Bind parameters
-        for(size_t i = 0; i < params.size(); ++i)
+        columns.emplace_back(sqlite3_column_name(stmt, i));
+    }
+    result.setColumns(std::move(columns));
+
+    while(sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        for(int i = 0; i < columnCount; ++i)
         {
-            sqlite3_bind_text(stmt, i + 1, params[i].c_str(), -1, SQLITE_TRANSIENT);
+            if(sqlite3_column_type(stmt, i) == SQLITE_NULL)
+            {
+                result.appendNull();
+                continue;
+            }
+
+            const char* value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+            result.appendValue(std::string_view(value ? value : "", sqlite3_column_bytes(stmt, i)));
         }
+    }
 
-        while(sqlite3_step(stmt) == SQLITE_ROW)
-        {
-            std::map<std::string, std::string> row;
-            int columnCount = sqlite3_column_count(stmt);
+    sqlite3_reset(stmt);
+    return result;
+}
+
+/**
+ * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @param callback Function called for each row; return false to stop reading.
+ * @return True if the query was executed successfully, false otherwise.
+ * @note Rows are read from the database cursor without materializing the result.
+ * The callback must not run other queries on this connection.
+ */
+bool SQLiteDatabase::queryEach(const std::string& query,
+                               const std::vector<std::string> & params,
+                               const RowCallback& callback)
+{
+    sqlite3_stmt* stmt = getCachedStatement(query);
+
+    if(!stmt)
+    {
+        std::cerr << ERR_MSG_FAILED_QUERY << ": " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    // Bind parameters
+    for(size_t i = 0; i < params.size(); ++i)
+    {
+        sqlite3_bind_text(stmt, i + 1, params[i].c_str(), -1, SQLITE_STATIC);
+    }
+
+    const int columnCount = sqlite3_column_count(stmt);
+    std::vector<std::string> columns;
+    columns.reserve(columnCount);
+    for(int i = 0; i < columnCount; ++i)
+    {
+        columns.emplace_back(sqlite3_column_name(stmt, i));
+    }
+
+    // One-row buffer reused for every step
+    ResultSet row;
+    row.setColumns(std::move(columns));
 
-            for(int i = 0; i < columnCount; ++i)
+    int rc;
+    while((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        row.clearRows();
+        for(int i = 0; i < columnCount; ++i)
+        {
+            if(sqlite3_column_type(stmt, i) == SQLITE_NULL)
             {
-                const char* columnName = sqlite3_column_name(stmt, i);
-                const char* columnValue = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-                row[columnName] = columnValue ? columnValue : "";
+                row.appendNull();
+                continue;
             }
 
-            result.push_back(row);
+            const char* value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+            row.appendValue(std::string_view(value ? value : "", sqlite3_column_bytes(stmt, i)));
         }
 
-        sqlite3_finalize(stmt);
+        if(!callback(row, 0))
+        {
+            rc = SQLITE_DONE;
+            break;
+        }
     }
-    else
+
+    sqlite3_reset(stmt);
+
+    if(rc != SQLITE_DONE)
     {
         std::cerr << ERR_MSG_FAILED_QUERY << ": " << sqlite3_errmsg(db) << std::endl;
+        return false;
     }
 
-    return result;
+    return true;
 }
 
 /**
@@ -256,6 +466,59 @@ std::string SQLiteDatabase::getLastError() const
     return "Database is not connected.";
 }
 
+/**
+ * @brief Returns a prepared statement for the query, reusing a cached handle if available.
+ * @param query The SQL query text (used as cache key).
+ * @return Reset statement with cleared bindings, or nullptr if preparation failed.
+ * @note Least recently used statement is finalized when the cache exceeds SQLITE_STMT_CACHE_SIZE.
+ */
+sqlite3_stmt* SQLiteDatabase::getCachedStatement(const std::string& query)
+{
+    auto it = stmtCacheIndex.find(query);
+    if(it != stmtCacheIndex.end())
+    {
+        // Move to front (most recently used)
+        stmtCache.splice(stmtCache.begin(), stmtCache, it->second);
+        sqlite3_stmt* stmt = it->second->second;
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        return stmt;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if(sqlite3_prepare_v2(db, query.c_str(), -1, & stmt, nullptr) != SQLITE_OK)
+    {
+        return nullptr;
+    }
+
+    stmtCache.emplace_front(query, stmt);
+    stmtCacheIndex[query] = stmtCache.begin();
+
+    // Evict least recently used
+    if(stmtCache.size() > SQLITE_STMT_CACHE_SIZE)
+    {
+        sqlite3_finalize(stmtCache.back().second);
+        stmtCacheIndex.erase(stmtCache.back().first);
+        stmtCache.pop_back();
+    }
+
+    return stmt;
+}
+
+/**
+ * @brief Finalizes all cached prepared statements.
+ * @note Must be called before the connection handle is closed.
+ */
+void SQLiteDatabase::clearStatementCache()
+{
+    for(auto & [query, stmt] : stmtCache)
+    {
+        sqlite3_finalize(stmt);
+    }
+    stmtCache.clear();
+    stmtCacheIndex.clear();
+}
+
 /**
  * @brief Reconnects to the database.
  * @throws std::runtime_error if reconnection fails.
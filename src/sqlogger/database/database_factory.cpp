@@ -23,6 +23,7 @@
 * @brief Creates a database instance of the specified type.
 * @param type The type of database to create (see DataBaseType enum).
 * @param connectionString Connection string/parameters for the database.
+* @param sqlitePragmas Connection tuning for SQLite (ignored by other backends).
 * @return std::unique_ptr<IDatabase> Pointer to the created database instance.
 *
 * @throws std::invalid_argument If unsupported database type is requested.
@@ -35,7 +36,8 @@
 * @see DataBaseType for supported database types.
 * @see LogConfig::configToConnectionString() to converts a LogConfig::Config object into a database-specific connection string.
 */
-std::unique_ptr<IDatabase> DatabaseFactory::create(const DataBaseType& type, const std::string& connectionString)
+std::unique_ptr<IDatabase> DatabaseFactory::create(const DataBaseType& type, const std::string& connectionString,
+        const SQLitePragmas& sqlitePragmas)
 {
     switch(type)
     {
@@ -43,7 +45,10 @@ std::unique_ptr<IDatabase> DatabaseFactory::create(const DataBaseType& type, con
             return std::make_unique<MockDatabase>();
 
         case DataBaseType::SQLite:
-            return std::make_unique<SQLiteDatabase>(connectionString);
+            return std::make_unique<SQLiteDatabase>(connectionString, sqlitePragmas);
+
+        case DataBaseType::Memory:
+            return std::make_unique<MemoryDatabase>(connectionString);
 
 #ifdef SQLG_USE_MYSQL
         case DataBaseType::MySQL:
@@ -19,6 +19,137 @@
 
 #include "sqlogger/database/database_helper.h"
 
+/**
+* @brief Checks if the database type has a native bulk-load path.
+* @param type The database type to check.
+* @return bool True for PostgreSQL (COPY) and MySQL (LOAD DATA LOCAL INFILE).
+* @see IDatabase::bulkInsert()
+*/
+bool DataBaseHelper::isBulkLoadSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Checks if the database type benefits from parallel write connections.
+* @param type The database type to check.
+* @return bool True for PostgreSQL and MySQL (SQLite allows a single writer at a time).
+* @see LogConfig::Config::connectionPoolSize
+*/
+bool DataBaseHelper::isConnectionPoolSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Checks if queries of the database type can run on separate connections.
+* @param type The database type to check.
+* @return bool True for SQLite (WAL snapshot reads), MySQL and PostgreSQL; false for
+* in-process backends, whose every connection is a separate database.
+* @see LogConfig::Config::readPoolSize
+*/
+bool DataBaseHelper::isReadPoolSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::SQLite || type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Checks if the log table of the database type can be split into daily partitions.
+* @param type The database type to check.
+* @return bool True for SQLite (per-day tables behind a view), MySQL and PostgreSQL (native partitions).
+* @see LogConfig::Config::partitioning
+*/
+bool DataBaseHelper::isPartitioningSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::SQLite || type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Checks if the message column of the database type can have a full-text index.
+* @param type The database type to check.
+* @return bool True for SQLite (FTS5), MySQL (FULLTEXT) and PostgreSQL (GIN over tsvector).
+* @see LogConfig::Config::fullTextSearch
+*/
+bool DataBaseHelper::isFullTextSearchSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::SQLite || type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Checks if the message column of the database type can be encrypted.
+* @param type The database type to check.
+* @return bool True for SQLite, MySQL and PostgreSQL (the message is stored as text).
+* @see LogConfig::Config::encryptMessages
+*/
+bool DataBaseHelper::isEncryptionSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::SQLite || type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Checks if the message column of the database type can be compressed.
+* @param type The database type to check.
+* @return bool True for SQLite, MySQL and PostgreSQL (the message is stored as text).
+* @see LogConfig::Config::compressMessages
+*/
+bool DataBaseHelper::isMessageCompressionSupported(const DataBaseType& type)
+{
+    return type == DataBaseType::SQLite || type == DataBaseType::PostgreSQL || type == DataBaseType::MySQL;
+}
+
+/**
+* @brief Encodes rows as tab-separated text for COPY FROM STDIN / LOAD DATA.
+* Backslash, tab, newline, carriage return and NUL are escaped with a backslash,
+* which is the default text format of both PostgreSQL COPY and MySQL LOAD DATA.
+* @param values Row-major values, columns * rows items.
+* @param columns Number of columns per row.
+* @return std::string Encoded rows, one per line.
+*/
+std::string DataBaseHelper::encodeBulkRows(const std::vector<std::string> & values, const size_t columns)
+{
+    std::string out;
+    if(columns == 0)
+    {
+        return out;
+    }
+
+    size_t total = values.size();
+    for(const auto & value : values)
+    {
+        total += value.size();
+    }
+    out.reserve(total + total / 16);
+
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        for(const char c : values[i])
+        {
+            switch(c)
+            {
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\0':
+                    out += "\\0";
+                    break;
+                default:
+                    out += c;
+            }
+        }
+        out += ((i + 1) % columns == 0) ? '\n' : '\t';
+    }
+    return out;
+}
+
 /**
  * @brief Checks if the database type is an embedded database
  * @details Embedded databases run in the same process as the application
@@ -49,6 +180,7 @@ bool DataBaseHelper::isDataBaseServer(const DataBaseType& dbType)
     {
         case DataBaseType::Mock:
         case DataBaseType::SQLite:
+        case DataBaseType::Memory:
             return false;
             break;
 
@@ -67,7 +199,7 @@ bool DataBaseHelper::isDataBaseServer(const DataBaseType& dbType)
 /**
  * @brief Checks if a database type is supported in the current build configuration.
  * Determines whether the database type is available based on compile-time
- * feature flags (SQLG_USE_MYSQL, SQLG_USE_POSTGRESQL, etc.). Mock and SQLite are always
+ * feature flags (SQLG_USE_MYSQL, SQLG_USE_POSTGRESQL, etc.). Mock, SQLite and Memory are always
  * supported.
  * @param dbType The database type to check
  * @return bool True if the database type is supported, false otherwise
@@ -79,6 +211,7 @@ bool DataBaseHelper::isDataBaseSupported(const DataBaseType& dbType)
     {
         case DataBaseType::Mock:
         case DataBaseType::SQLite:
+        case DataBaseType::Memory:
             return true;
             break;
 
@@ -151,6 +284,10 @@ int DataBaseHelper::getDataBaseDefaultPort(const DataBaseType& dbType)
             return DB_DEFAULT_PORT_MONGODB;
             break;
 
+        case DataBaseType::Memory:
+            return DB_DEFAULT_PORT_MEMORY;
+            break;
+
         default:
             return DB_DEFAULT_PORT_NOT_SUPPORTED;
             break;
@@ -169,6 +306,7 @@ DataBaseType DataBaseHelper::stringToDatabaseType(const std::string& stringType)
     if(LogHelper::toUpperCase(stringType) == LogHelper::toUpperCase(DB_TYPE_STR_MYSQL)) return DataBaseType::MySQL;
     if(LogHelper::toUpperCase(stringType) == LogHelper::toUpperCase(DB_TYPE_STR_POSTGRESQL)) return DataBaseType::PostgreSQL;
     if(LogHelper::toUpperCase(stringType) == LogHelper::toUpperCase(DB_TYPE_STR_MONGODB)) return DataBaseType::MongoDB;
+    if(LogHelper::toUpperCase(stringType) == LogHelper::toUpperCase(DB_TYPE_STR_MEMORY)) return DataBaseType::Memory;
     throw std::invalid_argument(ERR_MSG_UNSUPPORTED_DB);
 };
 
@@ -196,6 +334,9 @@ std::string DataBaseHelper::databaseTypeToString(const DataBaseType& type)
         case DataBaseType::MongoDB:
             return DB_TYPE_STR_MONGODB;
             break;
+        case DataBaseType::Memory:
+            return DB_TYPE_STR_MEMORY;
+            break;
         default:
             throw std::invalid_argument(ERR_MSG_UNSUPPORTED_DB);
             break;
@@ -229,6 +370,9 @@ std::string DataBaseHelper::databaseTypePrefix(const DataBaseType& type)
         case DataBaseType::MongoDB:
             return "";
             break;
+        case DataBaseType::Memory:
+            return DB_PARAM_PREFIX_MEMORY;
+            break;
         default:
             throw std::invalid_argument(ERR_MSG_UNSUPPORTED_DB);
             break;
@@ -262,6 +406,9 @@ int DataBaseHelper::getMaxBatchSize(const DataBaseType& type)
         case DataBaseType::MongoDB:
             return DB_BATCH_NOT_SUPPORTED;
             break;
+        case DataBaseType::Memory:
+            return DB_MAX_BATCH_MEMORY;
+            break;
         default:
             throw std::invalid_argument(ERR_MSG_UNSUPPORTED_DB);
             break;
@@ -598,6 +745,9 @@ std::optional<std::string> DataBaseHelper::extractParamFromConnectionString(
         case DataBaseType::MySQL:
             return parseKeyValueString(connectionString, paramName, ';');
 
+        case DataBaseType::Memory:
+            return parseKeyValueString(connectionString, paramName, ';');
+
         case DataBaseType::PostgreSQL:
             return parseKeyValueString(connectionString, paramName, ' ');
 
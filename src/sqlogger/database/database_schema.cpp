@@ -87,13 +87,36 @@ DatabaseSchema::TableBuilder& DatabaseSchema::TableBuilder::addForeignKey(
     return *this;
 }
 
+/**
+ * @brief Partition the table by ranges of a field (PostgreSQL and MySQL)
+ * The primary key becomes (primary field, partition field), since both
+ * databases require every unique key to contain the partition key.
+ * @param fieldName Name of the partition key field
+ * @return Reference to the TableBuilder for chaining
+ * @throws std::logic_error if field hasn't been declared
+ */
+DatabaseSchema::TableBuilder& DatabaseSchema::TableBuilder::setRangePartition(const std::string& fieldName)
+{
+    if(std::none_of(fields.begin(), fields.end(),
+                    [ & ](const auto & f)
+{
+    return f.name == fieldName;
+}))
+    {
+        throw std::logic_error("Field must be declared before partitioning by it");
+    }
+
+    partitionField = fieldName;
+    return *this;
+}
+
 /**
  * @brief Build the table definition
  * @return BuiltTable structure containing the table definition
  */
 DatabaseSchema::TableBuilder::BuiltTable DatabaseSchema::TableBuilder::build() const
 {
-    BuiltTable result{ tableName, fields, foreignKeys };
+    BuiltTable result{ tableName, fields, foreignKeys, partitionField };
     return result;
 }
 
@@ -17,8 +17,37 @@
  * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
  */
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include "sqlogger/database/query_builder.h"
 
+namespace
+{
+    /**
+     * @struct TextCache
+     * @brief Statements generated by QueryBuilder, keyed by shape.
+     */
+    struct TextCache
+    {
+        using List = std::list<std::pair<std::string, std::string>>;
+
+        std::mutex mutex; /**< Guards entries and index. */
+        List entries; /**< Shape and statement text, most recently used first. */
+        std::unordered_map<std::string, List::iterator> index; /**< Shape to entry lookup. */
+    };
+
+    /**
+     * @brief Gets the process-wide statement text cache.
+     * @return TextCache& The cache.
+     */
+    TextCache& getTextCache()
+    {
+        static TextCache cache;
+        return cache;
+    }
+}
+
 /**
  * @brief Builds an INSERT statement for the specified database type
  * @param dbType Target database type
@@ -93,6 +122,42 @@ std::string QueryBuilder::buildSelect(DataBaseType dbType,
     }
 }
 
+/**
+ * @brief Builds a SELECT ... GROUP BY statement counting the rows of each group
+ * @param dbType Target database type
+ * @param table Table name
+ * @param groupFields Grouping columns, returned under their own names
+ * @param filters WHERE clause conditions
+ * @param bucketSeconds Width of the FIELD_LOG_TIMESTAMP groups in seconds (0 = group by value)
+ * @param timestampFormat Format of the FIELD_LOG_TIMESTAMP column
+ * @return Formatted statement returning the group columns and SQL_COUNT_ALIAS (empty if not supported)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildGroupCount(DataBaseType dbType,
+        const std::string& table,
+        const std::vector<std::string> & groupFields,
+        const std::vector<Filter> & filters,
+        const int bucketSeconds,
+        const TimestampFormat timestampFormat)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+            return SQLBuilder::buildSQLGroupCount(groupFields, table, filters, bucketSeconds, timestampFormat, "?", dbType);
+
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildSQLGroupCount(groupFields, table, filters, bucketSeconds, timestampFormat, "$", dbType);
+
+        case DataBaseType::MongoDB:
+            return "";
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
 /**
  * @brief Builds an UPDATE SQL statement for the specified database type
  * @param dbType Target database type
@@ -232,6 +297,35 @@ std::string QueryBuilder::buildCreateIndex(
     }
 }
 
+/**
+ * @brief Builds a DROP INDEX statement
+ * @param dbType Target database type
+ * @param tableName Name of the indexed table
+ * @param indexName Name of the index to drop
+ * @return Formatted DROP INDEX statement (empty if not supported)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildDropIndex(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& indexName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildDropIndexSQL(dbType, tableName, indexName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
 /**
  * @brief Builds a query to check if a table exists
  * @param dbType Target database type
@@ -307,7 +401,20 @@ std::string QueryBuilder::buildBatchInsert(const std::string& table,
         case DataBaseType::SQLite:
         case DataBaseType::MySQL:
         case DataBaseType::PostgreSQL:
-            return SQLBuilder::buildSQLBatchInsert(table, fields, numRows, dbType);
+        {
+            // Separators can't occur in identifiers accepted by the config validation
+            std::string key = "batch_insert\x1f" + std::to_string(static_cast<int>(dbType)) + "\x1f" + table;
+            for(const auto & field : fields)
+            {
+                key += "\x1f" + field;
+            }
+            key += "\x1f" + std::to_string(numRows);
+
+            return getCachedText(key, [ & ]()
+            {
+                return SQLBuilder::buildSQLBatchInsert(table, fields, numRows, dbType);
+            });
+        }
 
 #ifdef SQLG_USE_MONGODB
         case DataBaseType::MongoDB:
@@ -318,3 +425,383 @@ std::string QueryBuilder::buildBatchInsert(const std::string& table,
             throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
     }
 }
+
+/**
+ * @brief Builds a query to check if a view exists
+ * @param dbType Target database type
+ * @param viewName Name of the view to check
+ * @return Formatted view existence query
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildViewExistsQuery(DataBaseType dbType, const std::string& viewName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildViewExistsQuery(dbType, viewName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds a query reading the schema version marker of a table
+ * @param dbType Target database type
+ * @param schemaTable Schema version table name
+ * @param table Table whose marker is read
+ * @param requiredTables Tables that must exist for the marker to be returned
+ * @return Formatted query returning FIELD_SCHEMA_VERSION (empty if not supported)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildSchemaVersionQuery(DataBaseType dbType,
+        const std::string& schemaTable,
+        const std::string& table,
+        const std::vector<std::string> & requiredTables)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildSchemaVersionQuery(dbType, schemaTable, table, requiredTables);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds an INSERT that keeps the existing row on a unique key conflict and returns its columns
+ * @param dbType Target database type
+ * @param table Table name
+ * @param values Vector of column-value pairs
+ * @param conflictField Unique column identifying the row
+ * @param returning Columns returned for the inserted or existing row
+ * @return Formatted statement (empty if the database has no INSERT ... RETURNING)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildUpsertReturning(DataBaseType dbType,
+        const std::string& table,
+        const std::vector<std::pair<std::string, std::string>> & values,
+        const std::string& conflictField,
+        const std::vector<std::string> & returning)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+        case DataBaseType::MySQL:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildSQLUpsertReturning(dbType, table, values, conflictField, returning);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds the statement adding a range partition to a partitioned table
+ * @param dbType Target database type
+ * @param tableName Partitioned table name
+ * @param partitionField Partition key field
+ * @param partitionName Partition name (PostgreSQL: table name of the partition)
+ * @param lowerBound Inclusive lower bound (ignored by MySQL)
+ * @param upperBound Exclusive upper bound
+ * @param first Whether this is the first partition (MySQL: partitions the table)
+ * @return Formatted statement (empty if the database has no declarative partitions)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildCreatePartition(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& partitionField,
+    const std::string& partitionName,
+    const std::string& lowerBound,
+    const std::string& upperBound,
+    const bool first)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+        case DataBaseType::SQLite:
+            return "";
+
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildCreatePartitionSQL(dbType, tableName, partitionField, partitionName, lowerBound, upperBound, first);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds the statement dropping a partition with all its rows
+ * @param dbType Target database type
+ * @param tableName Partitioned table name
+ * @param partitionName Partition name (SQLite and PostgreSQL: table name of the partition)
+ * @return Formatted statement (empty if not supported)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildDropPartition(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& partitionName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildDropPartitionSQL(dbType, tableName, partitionName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds a query listing the partitions of a table ("name" column)
+ * @param dbType Target database type
+ * @param tableName Partitioned table name
+ * @return Formatted query (empty if not supported)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildPartitionsQuery(DataBaseType dbType, const std::string& tableName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildPartitionsQuery(dbType, tableName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds a CREATE VIEW statement concatenating tables with UNION ALL
+ * @param dbType Target database type
+ * @param viewName View name
+ * @param tables Tables with identical columns
+ * @return Formatted CREATE VIEW statement (empty if not supported or no tables)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildCreateUnionView(
+    DataBaseType dbType,
+    const std::string& viewName,
+    const std::vector<std::string> & tables)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildUnionViewSQL(dbType, viewName, tables);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds a DROP VIEW statement
+ * @param dbType Target database type
+ * @param viewName View name
+ * @return Formatted DROP VIEW statement (empty if not supported)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildDropView(DataBaseType dbType, const std::string& viewName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildDropViewSQL(dbType, viewName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds the statements creating a full-text index on a text column
+ * @param dbType Target database type
+ * @param tableName Indexed table name
+ * @param indexName Index name
+ * @param field Text column
+ * @return Statements (empty if the database has no full-text index)
+ * @throws runtime_error If database type is unsupported
+ */
+std::vector<std::string> QueryBuilder::buildCreateFullTextIndex(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& indexName,
+    const std::string& field)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return {};
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildCreateFullTextIndexSQL(dbType, tableName, indexName, field);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds the statements dropping a full-text index
+ * @param dbType Target database type
+ * @param tableName Indexed table name
+ * @param indexName Index name
+ * @return Statements (empty if the database has no full-text index)
+ * @throws runtime_error If database type is unsupported
+ */
+std::vector<std::string> QueryBuilder::buildDropFullTextIndex(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& indexName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return {};
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildDropFullTextIndexSQL(dbType, tableName, indexName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds the statement indexing the rows written before the full-text index existed
+ * @param dbType Target database type
+ * @param tableName Indexed table name
+ * @return Formatted statement (empty if not needed)
+ * @throws runtime_error If database type is unsupported
+ */
+std::string QueryBuilder::buildRebuildFullTextIndex(DataBaseType dbType, const std::string& tableName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::MongoDB:
+            return "";
+
+        case DataBaseType::SQLite:
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+            return SQLBuilder::buildRebuildFullTextIndexSQL(dbType, tableName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Converts search words to the value bound to a MATCH filter
+ * @param dbType Target database type
+ * @param text Search words separated by whitespace
+ * @return Search value in the full-text query syntax of the database
+ */
+std::string QueryBuilder::buildMatchValue(DataBaseType dbType, const std::string& text)
+{
+    return SQLBuilder::buildMatchValue(dbType, text);
+}
+
+/**
+* @brief Gets the number of statements held by the statement text cache.
+* @return size_t Cached statements (at most QUERY_TEXT_CACHE_SIZE).
+*/
+size_t QueryBuilder::getCachedTextCount()
+{
+    TextCache& cache = getTextCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.entries.size();
+}
+
+/**
+* @brief Gets a generated statement from the statement text cache, building it on a miss.
+* The text depends only on the statement shape, so it is built once per shape;
+* the least recently used statement is dropped when the cache exceeds QUERY_TEXT_CACHE_SIZE.
+* @param key Statement shape (database type, table, fields, row count).
+* @param build Function building the statement text.
+* @return std::string Statement text.
+*/
+std::string QueryBuilder::getCachedText(const std::string& key, const std::function<std::string()> & build)
+{
+    TextCache& cache = getTextCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.index.find(key);
+        if(it != cache.index.end())
+        {
+            // Move to front (most recently used)
+            cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+            return it->second->second;
+        }
+    }
+
+    // Built without the lock, a concurrent miss of the same shape builds the same text
+    std::string text = build();
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if(cache.index.find(key) == cache.index.end())
+    {
+        cache.entries.emplace_front(key, text);
+        cache.index[key] = cache.entries.begin();
+
+        // Evict least recently used
+        if(cache.entries.size() > QUERY_TEXT_CACHE_SIZE)
+        {
+            cache.index.erase(cache.entries.back().first);
+            cache.entries.pop_back();
+        }
+    }
+    return text;
+}
@@ -0,0 +1,841 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <algorithm>
+#include <future>
+#include "sqlogger/database/sharded_database.h"
+
+/**
+ * @brief Rounds a division toward negative infinity.
+ * @param value Dividend.
+ * @param divisor Positive divisor.
+ * @return int64_t Quotient.
+ */
+static int64_t floorDiv(const int64_t value, const int64_t divisor)
+{
+    const int64_t quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+/**
+ * @brief Connects every shard and creates its schema.
+ * @param config Configuration with [Database] and the shard targets (see LogConfig::getShardConfigs()).
+ * @throws std::runtime_error If the database type is not specified.
+ * @throws std::invalid_argument If the database type is not supported.
+ */
+ShardedDatabase::ShardedDatabase(const LogConfig::Config& config)
+    : logsTableName(config.databaseTable.value_or(LOG_TABLE_NAME)),
+      routing(config.shardRouting.value_or(ShardRouting::Source)),
+      timestampFormat(config.timestampFormat.value_or(TimestampFormat::Text))
+{
+    const bool compact = config.schemaLayout.value_or(SchemaLayout::Standard) == SchemaLayout::Compact;
+
+    for(const auto & shardConfig : LogConfig::getShardConfigs(config))
+    {
+        const std::string connectionString = LogConfig::configToConnectionString(shardConfig);
+        auto shard = std::make_unique<Shard>(DatabaseFactory::create( * shardConfig.databaseType,
+                                             connectionString,
+                                             LogConfig::configToSQLitePragmas(shardConfig)),
+                                             connectionString,
+                                             logsTableName);
+
+        shard->writer.setTimestampFormat(timestampFormat);
+        shard->reader.setTimestampFormat(timestampFormat);
+
+        // Each shard has its own dictionary tables, the ids differ between shards
+        std::shared_ptr<LogDictionaries> dictionaries;
+        if(compact && !shard->database->supportsNativeLogs())
+        {
+            dictionaries = std::make_shared<LogDictionaries>(logsTableName);
+            shard->writer.setCompactSchema(dictionaries);
+            shard->reader.setCompactSchema(dictionaries);
+        }
+
+        // Each shard trains its dictionaries on its own messages
+        std::shared_ptr<LogMessageCompressor> messageCompressor;
+        if(config.compressMessages.value_or(false) && !shard->database->supportsNativeLogs()
+                && DataBaseHelper::isMessageCompressionSupported(shard->database->getDatabaseType()))
+        {
+            messageCompressor = std::make_shared<LogMessageCompressor>(logsTableName);
+            shard->writer.setMessageCompression(messageCompressor);
+            shard->reader.setMessageCompression(messageCompressor);
+        }
+
+        if(config.indexes.has_value())
+        {
+            shard->writer.setIndexes(config.indexes.value());
+        }
+        shard->writer.setBulkLoadThreshold(std::max(config.bulkLoadThreshold.value_or(LOG_DEFAULT_BULK_LOAD_THRESHOLD), 0));
+        shard->writer.createSchema(true);
+
+        if(dictionaries)
+        {
+            dictionaries->load( * shard->database);
+        }
+        if(messageCompressor)
+        {
+            messageCompressor->load( * shard->database);
+        }
+
+        shards.push_back(std::move(shard));
+    }
+
+    pool = std::make_unique<ThreadPool>(shards.size(), LogConfig::getThreadSettings(config));
+
+#ifdef SQLG_USE_SOURCE_INFO
+    syncSources();
+#endif
+}
+
+/**
+ * @brief Stops the fan-out threads and closes the shards.
+ */
+ShardedDatabase::~ShardedDatabase()
+{
+    pool.reset();
+}
+
+/**
+ * @brief Connects the shards that are not connected, each with its own connection string.
+ * @param connectionString Ignored.
+ * @return True if every shard is connected.
+ */
+bool ShardedDatabase::connect(const std::string& /*connectionString*/)
+{
+    bool connected = true;
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if(!shard->database->isConnected() && !shard->database->connect(shard->connectionString))
+        {
+            connected = false;
+        }
+    }
+    return connected;
+}
+
+/**
+ * @brief Disconnects every shard.
+ */
+void ShardedDatabase::disconnect()
+{
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->database->disconnect();
+    }
+}
+
+/**
+ * @brief Checks if every shard is connected.
+ * @return True if connected.
+ */
+bool ShardedDatabase::isConnected() const
+{
+    for(const auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if(!shard->database->isConnected())
+        {
+            return false;
+        }
+    }
+    return !shards.empty();
+}
+
+/**
+ * @brief Executes an SQL query on every shard.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @param affectedRows Optional pointer to store the affected rows of all shards.
+ * @return True if the query succeeded on every shard, false otherwise.
+ */
+bool ShardedDatabase::execute(const std::string& query,
+                              const std::vector<std::string> & params,
+                              int* affectedRows)
+{
+    std::atomic<bool> executed{ true };
+    std::atomic<int> total{ 0 };
+    forEachShard([ & ](const size_t shard)
+    {
+        int rows = 0;
+        std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+        if(!shards[shard]->database->execute(query, params, & rows))
+        {
+            executed = false;
+            setLastError(shard, shards[shard]->database->getLastError());
+        }
+        total += rows;
+    });
+
+    if(affectedRows)
+    {
+        * affectedRows = total;
+    }
+    return executed;
+}
+
+/**
+ * @brief Executes an SQL query with typed parameters on every shard.
+ * @param query The SQL query to execute.
+ * @param params Typed parameters.
+ * @param affectedRows Optional pointer to store the affected rows of all shards.
+ * @return True if the query succeeded on every shard, false otherwise.
+ */
+bool ShardedDatabase::execute(const std::string& query,
+                              const DbParamList& params,
+                              int* affectedRows)
+{
+    std::atomic<bool> executed{ true };
+    std::atomic<int> total{ 0 };
+    forEachShard([ & ](const size_t shard)
+    {
+        int rows = 0;
+        std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+        if(!shards[shard]->database->execute(query, params, & rows))
+        {
+            executed = false;
+            setLastError(shard, shards[shard]->database->getLastError());
+        }
+        total += rows;
+    });
+
+    if(affectedRows)
+    {
+        * affectedRows = total;
+    }
+    return executed;
+}
+
+/**
+ * @brief Executes an SQL query on the first shard and returns the result.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @return A vector of maps representing the query result.
+ */
+std::vector<std::map<std::string, std::string>> ShardedDatabase::query(const std::string& query,
+        const std::vector<std::string> & params)
+{
+    std::lock_guard<std::mutex> lock(shards.front()->mutex);
+    return shards.front()->database->query(query, params);
+}
+
+/**
+ * @brief Stores log entries on the shards chosen by the routing, in parallel.
+ * @param table Log table name.
+ * @param entries Entries to store.
+ * @return True if all entries were stored, false otherwise (check getLastError() for details).
+ */
+bool ShardedDatabase::insertLogs(const std::string& table, const LogEntryList& entries)
+{
+    if(table != logsTableName)
+    {
+        setLastError(0, ERR_MSG_SHARD_UNKNOWN_TABLE + table);
+        return false;
+    }
+
+    if(entries.empty())
+    {
+        return true;
+    }
+
+#ifdef SQLG_USE_SOURCE_INFO
+    if(routing == ShardRouting::RoundRobin || shards.size() == 1)
+#endif
+    {
+        return writeShard(nextShard.fetch_add(1) % shards.size(), entries);
+    }
+
+#ifdef SQLG_USE_SOURCE_INFO
+
+    // Source routing: a batch of one source (the usual case) is not copied
+    std::vector<size_t> targets;
+    targets.reserve(entries.size());
+    bool singleShard = true;
+    for(const auto & entry : entries)
+    {
+        targets.push_back(std::hash<int>()(entry.sourceId) % shards.size());
+        singleShard = singleShard && targets.back() == targets.front();
+    }
+
+    if(singleShard)
+    {
+        return writeShard(targets.front(), entries);
+    }
+
+    std::vector<LogEntryList> groups(shards.size());
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        groups[targets[i]].push_back(entries[i]);
+    }
+
+    std::vector<size_t> indexes;
+    for(size_t shard = 0; shard < groups.size(); ++shard)
+    {
+        if(!groups[shard].empty())
+        {
+            indexes.push_back(shard);
+        }
+    }
+
+    std::atomic<bool> written{ true };
+    forEachShard(indexes, [ & ](const size_t shard)
+    {
+        if(!writeShard(shard, groups[shard]))
+        {
+            written = false;
+        }
+    });
+    return written;
+#endif
+}
+
+/**
+ * @brief Reads the matching entries of every shard concurrently and passes them to a callback in order.
+ * Ordered by timestamp, each shard returns its first limit + offset entries in one query
+ * (all of them without a limit); ordered by ID, shards are read in keyset pages of
+ * SHARD_PAGE_SIZE entries, so a full scan keeps a page per shard in memory.
+ * @param table Log table name.
+ * @param filters Filters, combined with AND (ID filters are translated to the local IDs of each shard).
+ * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending, ties in ID order).
+ * @param limit Maximum number of entries (0 or negative = no limit).
+ * @param offset Number of entries to skip, requires a positive limit.
+ * @param callback Function called for each entry; return false to stop reading.
+ * @return size_t Number of entries passed to the callback.
+ */
+size_t ShardedDatabase::selectLogs(const std::string& table,
+                                   const std::vector<Filter> & filters,
+                                   const std::string& orderBy,
+                                   const int limit,
+                                   const int offset,
+                                   const NativeLogCallback& callback)
+{
+    if(table != logsTableName)
+    {
+        return 0;
+    }
+
+    const bool byId = orderBy == FIELD_LOG_ID;
+    const size_t skip = limit > 0 ? static_cast<size_t>(std::max(offset, 0)) : 0;
+    const size_t wanted = limit > 0 ? static_cast<size_t>(limit) + skip : 0;
+    const size_t pageSize = byId ? (wanted > 0 ? std::min<size_t>(wanted, SHARD_PAGE_SIZE) : SHARD_PAGE_SIZE) : wanted;
+
+    /**
+     * @struct Cursor
+     * @brief Read position in the entries of one shard.
+     */
+    struct Cursor
+    {
+        std::vector<Filter> filters; /**< Filters with local IDs. */
+        LogEntryList entries; /**< Current page. */
+        size_t next = 0; /**< Next entry of the page. */
+        int64_t lastId = 0; /**< Local ID of the last entry read (keyset resume point). */
+        bool exhausted = false; /**< No entries after the current page. */
+    };
+
+    std::vector<Cursor> cursors(shards.size());
+    std::vector<size_t> indexes;
+    for(size_t shard = 0; shard < shards.size(); ++shard)
+    {
+        if(toShardFilters(filters, shard, cursors[shard].filters))
+        {
+            indexes.push_back(shard);
+        }
+        else
+        {
+            cursors[shard].exhausted = true;
+        }
+    }
+
+    auto fetch = [ & ](const size_t shard)
+    {
+        Cursor& cursor = cursors[shard];
+        cursor.entries = readShard(shard, cursor.filters, byId, pageSize, cursor.lastId);
+        cursor.next = 0;
+        cursor.exhausted = !byId || cursor.entries.size() < pageSize;
+        if(!cursor.entries.empty())
+        {
+            cursor.lastId = (cursor.entries.back().id - static_cast<int64_t>(shard)) / static_cast<int64_t>(shards.size());
+        }
+    };
+
+    // First pages in parallel, later ones when a shard runs out
+    forEachShard(indexes, fetch);
+
+    auto before = [ & ](const LogEntry & a, const LogEntry & b)
+    {
+        if(!byId)
+        {
+            if(timestampFormat == TimestampFormat::EpochMicros)
+            {
+                if(a.timestampUs != b.timestampUs) return a.timestampUs < b.timestampUs;
+            }
+            else if(a.timestamp != b.timestamp)
+            {
+                return a.timestamp < b.timestamp;
+            }
+        }
+        return a.id < b.id;
+    };
+
+    size_t skipped = 0;
+    size_t passed = 0;
+    while(true)
+    {
+        Cursor* best = nullptr;
+        for(const size_t shard : indexes)
+        {
+            Cursor& cursor = cursors[shard];
+            if(cursor.next == cursor.entries.size())
+            {
+                if(cursor.exhausted)
+                    continue;
+
+                fetch(shard);
+                if(cursor.entries.empty())
+                    continue;
+            }
+
+            if(!best || before(cursor.entries[cursor.next], best->entries[best->next]))
+            {
+                best = & cursor;
+            }
+        }
+
+        if(!best)
+            break;
+
+        LogEntry& entry = best->entries[best->next++];
+        if(skipped < skip)
+        {
+            ++skipped;
+            continue;
+        }
+
+        ++passed;
+        if(!callback(entry) || (limit > 0 && passed >= static_cast<size_t>(limit)))
+            break;
+    }
+    return passed;
+}
+
+/**
+ * @brief Removes all rows of a table on every shard.
+ * @param table Log table or sources table name.
+ * @return True if the table is stored by the sharded database.
+ */
+bool ShardedDatabase::clearTable(const std::string& table)
+{
+#ifdef SQLG_USE_SOURCE_INFO
+    if(table == SOURCES_TABLE_NAME)
+    {
+        forEachShard([ & ](const size_t shard)
+        {
+            std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+            shards[shard]->writer.clearSources();
+        });
+        return true;
+    }
+#endif
+
+    if(table != logsTableName)
+    {
+        return false;
+    }
+
+    forEachShard([ & ](const size_t shard)
+    {
+        std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+        shards[shard]->writer.clearLogs();
+    });
+    return true;
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @brief Stores a source on the first shard and copies it to the others.
+ * @param uuid Source UUID, unique.
+ * @param name Source name.
+ * @return int ID of the new source, or SOURCE_NOT_FOUND if it was not stored.
+ */
+int ShardedDatabase::insertSource(const std::string& uuid, const std::string& name)
+{
+    int sourceId = SOURCE_NOT_FOUND;
+    {
+        std::lock_guard<std::mutex> lock(shards.front()->mutex);
+        sourceId = shards.front()->writer.addSource(name, uuid);
+    }
+
+    if(sourceId == SOURCE_NOT_FOUND)
+    {
+        return SOURCE_NOT_FOUND;
+    }
+
+    const SourceInfo source{ sourceId, uuid, name };
+    for(size_t shard = 1; shard < shards.size(); ++shard)
+    {
+        if(!copySource(shard, source))
+        {
+            return SOURCE_NOT_FOUND;
+        }
+    }
+    return sourceId;
+}
+
+/**
+ * @brief Gets all sources of the first shard ordered by ID.
+ * @return std::vector<SourceInfo> Stored sources.
+ */
+std::vector<SourceInfo> ShardedDatabase::selectSources()
+{
+    std::lock_guard<std::mutex> lock(shards.front()->mutex);
+    return shards.front()->reader.getAllSources();
+}
+
+/**
+ * @brief Stores a source of the first shard with the same ID on another shard.
+ * @param shard Shard index.
+ * @param source The source.
+ * @return bool True if the source was stored.
+ */
+bool ShardedDatabase::copySource(const size_t shard, const SourceInfo& source)
+{
+    std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+    IDatabase& database = * shards[shard]->database;
+
+    const std::string query = QueryBuilder::buildInsert(
+                                  database.getDatabaseType(),
+                                  SOURCES_TABLE_NAME,
+    {
+        {FIELD_SOURCES_ID, std::to_string(source.sourceId)},
+        {FIELD_SOURCES_UUID, source.uuid},
+        {FIELD_SOURCES_NAME, source.name}
+    });
+
+    if(!database.execute(query, DbParamList{ DbParam(source.sourceId), DbParam(source.uuid), DbParam(source.name) }))
+    {
+        setLastError(shard, database.getLastError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Copies the sources of the first shard missing on the others (e.g. a shard added later).
+ */
+void ShardedDatabase::syncSources()
+{
+    const std::vector<SourceInfo> sources = selectSources();
+    for(size_t shard = 1; shard < shards.size(); ++shard)
+    {
+        std::vector<SourceInfo> stored;
+        {
+            std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+            stored = shards[shard]->reader.getAllSources();
+        }
+
+        for(const auto & source : sources)
+        {
+            const bool found = std::any_of(stored.begin(), stored.end(), [ & ](const SourceInfo & other)
+            {
+                return other.sourceId == source.sourceId;
+            });
+            if(!found)
+            {
+                copySource(shard, source);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Begins a transaction on every shard.
+ * @return True if the transaction was started on every shard, false otherwise.
+ */
+bool ShardedDatabase::beginTransaction()
+{
+    bool started = true;
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        started = shard->database->beginTransaction() && started;
+    }
+    return started;
+}
+
+/**
+ * @brief Commits the current transaction of every shard.
+ * @return True if every shard committed, false otherwise.
+ */
+bool ShardedDatabase::commitTransaction()
+{
+    bool committed = true;
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        committed = shard->database->commitTransaction() && committed;
+    }
+    return committed;
+}
+
+/**
+ * @brief Rolls back the current transaction of every shard.
+ * @return True if every shard rolled back, false otherwise.
+ */
+bool ShardedDatabase::rollbackTransaction()
+{
+    bool rolledBack = true;
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        rolledBack = shard->database->rollbackTransaction() && rolledBack;
+    }
+    return rolledBack;
+}
+
+/**
+ * @brief Drops every shard database, each with its own connection string.
+ * @param connectionString Ignored.
+ * @return True if every shard was dropped, false otherwise.
+ */
+bool ShardedDatabase::dropDatabaseIfExists(const std::string& /*connectionString*/)
+{
+    bool dropped = true;
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        dropped = shard->database->dropDatabaseIfExists(shard->connectionString) && dropped;
+    }
+    return dropped;
+}
+
+/**
+ * @brief Gets the last error of a failed shard operation.
+ * @return The last error message as a string.
+ */
+std::string ShardedDatabase::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return lastError;
+}
+
+/**
+ * @brief Gets the type of the shard databases.
+ * @return The database type.
+ */
+DataBaseType ShardedDatabase::getDatabaseType() const
+{
+    return shards.front()->database->getDatabaseType();
+}
+
+/**
+ * @brief Runs a task for each of the given shards, concurrently if there are several, and waits for all.
+ * The caller runs the first task itself.
+ * @param indexes Shard indexes.
+ * @param task Function called with a shard index.
+ * @throws Rethrows the first exception of a task once every task has finished.
+ */
+void ShardedDatabase::forEachShard(const std::vector<size_t> & indexes, const std::function<void(const size_t shard)> & task)
+{
+    if(indexes.empty())
+    {
+        return;
+    }
+
+    std::vector<std::future<void>> results;
+    results.reserve(indexes.size() - 1);
+    for(size_t i = 1; i < indexes.size(); ++i)
+    {
+        std::packaged_task<void()> job([ & task, shard = indexes[i]]()
+        {
+            task(shard);
+        });
+        results.push_back(job.get_future());
+        pool->enqueue(std::move(job));
+    }
+
+    std::exception_ptr error;
+    try
+    {
+        task(indexes.front());
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+    }
+
+    // Every task references the caller's state: wait for all before rethrowing
+    for(auto & result : results)
+    {
+        try
+        {
+            result.get();
+        }
+        catch(...)
+        {
+            if(!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Runs a task for every shard concurrently and waits for all.
+ * @param task Function called with a shard index.
+ */
+void ShardedDatabase::forEachShard(const std::function<void(const size_t shard)> & task)
+{
+    std::vector<size_t> indexes(shards.size());
+    for(size_t shard = 0; shard < indexes.size(); ++shard)
+    {
+        indexes[shard] = shard;
+    }
+    forEachShard(indexes, task);
+}
+
+/**
+ * @brief Writes entries to one shard.
+ * @param shard Shard index.
+ * @param entries Entries to write.
+ * @return True if the entries were written, false otherwise.
+ */
+bool ShardedDatabase::writeShard(const size_t shard, const LogEntryList& entries)
+{
+    std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+    if(!shards[shard]->writer.writeLogBatch(entries))
+    {
+        setLastError(shard, shards[shard]->database->getLastError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads entries of one shard and converts their IDs to global IDs.
+ * @param shard Shard index.
+ * @param filters Filters with local IDs.
+ * @param byId True to order by ID (keyset page after afterId), false to order by timestamp.
+ * @param count Maximum number of entries (0 = no limit).
+ * @param afterId Local ID after which an ID ordered page starts.
+ * @return LogEntryList Entries of the shard.
+ */
+LogEntryList ShardedDatabase::readShard(const size_t shard,
+                                        const std::vector<Filter> & filters,
+                                        const bool byId,
+                                        const size_t count,
+                                        const int64_t afterId)
+{
+    LogEntryList entries;
+    {
+        std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+        if(byId)
+        {
+            entries.reserve(count);
+            shards[shard]->reader.forEachLog(filters, [ & ](const LogEntry & entry)
+            {
+                entries.push_back(entry);
+                return count == 0 || entries.size() < count;
+            }, 0, afterId);
+        }
+        else
+        {
+            entries = shards[shard]->reader.getLogsByFilters(filters, count > 0 ? static_cast<int>(count) : -1);
+        }
+    }
+
+    const int shardCount = static_cast<int>(shards.size());
+    for(auto & entry : entries)
+    {
+        entry.id = entry.id * shardCount + static_cast<int>(shard);
+    }
+    return entries;
+}
+
+/**
+ * @brief Translates filters on global entry IDs to the local IDs of a shard.
+ * Global ID G is local ID (G - shard) / count on its shard, so a range bound becomes the
+ * nearest local ID of the shard inside the range.
+ * @param filters Filters of the query.
+ * @param shard Shard index.
+ * @param shardFilters Receives the filters for the shard.
+ * @return bool False if no entry of the shard can match (e.g. "id = X" of another shard).
+ */
+bool ShardedDatabase::toShardFilters(const std::vector<Filter> & filters, const size_t shard, std::vector<Filter> & shardFilters) const
+{
+    const int64_t count = static_cast<int64_t>(shards.size());
+    shardFilters.clear();
+    shardFilters.reserve(filters.size());
+
+    for(const auto & filter : filters)
+    {
+        if(filter.field != FIELD_LOG_ID || !LogHelper::isNumeric(filter.value)
+                || filter.value.find('.') != std::string::npos)
+        {
+            shardFilters.push_back(filter);
+            continue;
+        }
+
+        const int64_t relative = std::stoll(filter.value) - static_cast<int64_t>(shard);
+        const int64_t below = floorDiv(relative, count); // Largest local ID <= the bound
+        const bool exact = relative - below * count == 0;
+
+        Filter local = filter;
+        if(filter.op == "=")
+        {
+            if(!exact)
+                return false;
+            local.value = std::to_string(below);
+        }
+        else if(filter.op == "!=" || filter.op == "<>")
+        {
+            if(!exact)
+                continue; // Not an ID of this shard
+            local.value = std::to_string(below);
+        }
+        else if(filter.op == ">" || filter.op == "<=")
+        {
+            local.value = std::to_string(below);
+        }
+        else if(filter.op == ">=" || filter.op == "<")
+        {
+            local.value = std::to_string(exact ? below : below + 1);
+        }
+        shardFilters.push_back(std::move(local));
+    }
+    return true;
+}
+
+/**
+ * @brief Records the error of a failed shard.
+ * @param shard Shard index.
+ * @param error Error message.
+ */
+void ShardedDatabase::setLastError(const size_t shard, const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(errorMutex);
+    lastError = ERR_MSG_SHARD_FAILED + std::to_string(shard) + ": " + error;
+}
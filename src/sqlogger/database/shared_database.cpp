@@ -0,0 +1,330 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include "sqlogger/database/shared_database.h"
+
+/**
+ * @brief Rolls back a transaction left open, releasing the connection.
+ */
+SharedDatabase::~SharedDatabase()
+{
+    if(transactionOpen)
+    {
+        rollbackTransaction();
+    }
+}
+
+/**
+ * @brief Connects the shared connection unless already connected.
+ * @param connectionString The connection string.
+ * @return True if the connection is open.
+ */
+bool SharedDatabase::connect(const std::string& connectionString)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->isConnected() || connection->database->connect(connectionString);
+}
+
+/**
+ * @brief Does nothing: other loggers still use the connection, it is closed with the last of them.
+ */
+void SharedDatabase::disconnect()
+{
+}
+
+/**
+ * @brief Checks if the shared connection is open.
+ * @return True if connected.
+ */
+bool SharedDatabase::isConnected() const
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->isConnected();
+}
+
+/**
+ * @brief Executes an SQL query.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @param affectedRows Optional pointer to store number of affected rows.
+ * @return True if the query was executed successfully, false otherwise.
+ */
+bool SharedDatabase::execute(const std::string& query,
+                             const std::vector<std::string> & params,
+                             int* affectedRows)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->execute(query, params, affectedRows);
+}
+
+/**
+ * @brief Executes an SQL query with typed parameters.
+ * @param query The SQL query to execute.
+ * @param params Typed parameters.
+ * @param affectedRows Optional pointer to store number of affected rows.
+ * @return True if the query was executed successfully, false otherwise.
+ */
+bool SharedDatabase::execute(const std::string& query,
+                             const DbParamList& params,
+                             int* affectedRows)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->execute(query, params, affectedRows);
+}
+
+/**
+ * @brief Executes an SQL query and returns the result.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @return A vector of maps representing the query result.
+ */
+std::vector<std::map<std::string, std::string>> SharedDatabase::query(const std::string& query,
+        const std::vector<std::string> & params)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->query(query, params);
+}
+
+/**
+ * @brief Executes an SQL query and returns a compact columnar result.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @return ResultSet with the rows of the query.
+ */
+ResultSet SharedDatabase::queryResultSet(const std::string& query,
+        const std::vector<std::string> & params)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->queryResultSet(query, params);
+}
+
+/**
+ * @brief Executes an SQL query and passes the result rows to a callback one at a time.
+ * The connection stays locked until the callback stops or the rows end.
+ * @param query The SQL query to execute.
+ * @param params The parameters to bind to the query.
+ * @param callback Function called for each row; return false to stop reading.
+ * @return True if the query was executed successfully, false otherwise.
+ */
+bool SharedDatabase::queryEach(const std::string& query,
+                               const std::vector<std::string> & params,
+                               const RowCallback& callback)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->queryEach(query, params, callback);
+}
+
+/**
+ * @brief Checks if the backend implements bulkInsert().
+ * @return True if a native bulk-load path is available, false otherwise.
+ */
+bool SharedDatabase::supportsBulkInsert() const
+{
+    return connection->database->supportsBulkInsert();
+}
+
+/**
+ * @brief Loads rows through the native bulk path of the shared connection.
+ * @param table Target table name.
+ * @param fields Column names.
+ * @param values Row-major values, fields.size() items per row.
+ * @param affectedRows Optional pointer to store number of loaded rows.
+ * @return True if all rows were loaded, false otherwise.
+ */
+bool SharedDatabase::bulkInsert(const std::string& table,
+                                const std::vector<std::string> & fields,
+                                const std::vector<std::string> & values,
+                                int* affectedRows)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->bulkInsert(table, fields, values, affectedRows);
+}
+
+/**
+ * @brief Checks if query() can run INSERT ... ON CONFLICT ... RETURNING statements.
+ * @return True if the shared connection supports it.
+ */
+bool SharedDatabase::supportsReturning() const
+{
+    return connection->database->supportsReturning();
+}
+
+/**
+ * @brief Checks if the backend stores log entries natively instead of executing SQL.
+ * @return True if the native log methods are implemented, false otherwise.
+ */
+bool SharedDatabase::supportsNativeLogs() const
+{
+    return connection->database->supportsNativeLogs();
+}
+
+/**
+ * @brief Stores log entries without SQL.
+ * @param table Log table name.
+ * @param entries Entries to store.
+ * @return True if all entries were stored, false otherwise.
+ */
+bool SharedDatabase::insertLogs(const std::string& table, const LogEntryList& entries)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->insertLogs(table, entries);
+}
+
+/**
+ * @brief Passes the log entries matching the filters to a callback.
+ * @param table Log table name.
+ * @param filters Filters, combined with AND.
+ * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP (ascending).
+ * @param limit Maximum number of entries (0 or negative = no limit).
+ * @param offset Number of entries to skip, requires a positive limit.
+ * @param callback Function called for each entry; return false to stop reading.
+ * @return size_t Number of entries passed to the callback.
+ */
+size_t SharedDatabase::selectLogs(const std::string& table,
+                                  const std::vector<Filter> & filters,
+                                  const std::string& orderBy,
+                                  const int limit,
+                                  const int offset,
+                                  const NativeLogCallback& callback)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->selectLogs(table, filters, orderBy, limit, offset, callback);
+}
+
+/**
+ * @brief Removes all rows of a table.
+ * @param table Table name.
+ * @return True if the table was cleared, false otherwise.
+ */
+bool SharedDatabase::clearTable(const std::string& table)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->clearTable(table);
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @brief Stores a source without SQL.
+ * @param uuid Source UUID, unique.
+ * @param name Source name.
+ * @return int ID of the new source, or SOURCE_NOT_FOUND if it was not stored.
+ */
+int SharedDatabase::insertSource(const std::string& uuid, const std::string& name)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->insertSource(uuid, name);
+}
+
+/**
+ * @brief Gets all sources ordered by ID.
+ * @return std::vector<SourceInfo> Stored sources.
+ */
+std::vector<SourceInfo> SharedDatabase::selectSources()
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->selectSources();
+}
+#endif
+
+/**
+ * @brief Begins a transaction; the connection stays locked until it ends.
+ * @return True if the transaction was started successfully, false otherwise.
+ */
+bool SharedDatabase::beginTransaction()
+{
+    connection->mutex.lock();
+    if(!connection->database->beginTransaction())
+    {
+        connection->mutex.unlock();
+        return false;
+    }
+    transactionOpen = true;
+    return true;
+}
+
+/**
+ * @brief Commits the current transaction and releases the connection.
+ * @return True if the transaction was committed successfully, false otherwise
+ * (the transaction stays open until it is rolled back).
+ */
+bool SharedDatabase::commitTransaction()
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    const bool committed = connection->database->commitTransaction();
+    if(committed)
+    {
+        endTransaction();
+    }
+    return committed;
+}
+
+/**
+ * @brief Rolls back the current transaction and releases the connection.
+ * @return True if the transaction was rolled back successfully, false otherwise.
+ */
+bool SharedDatabase::rollbackTransaction()
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    const bool rolledBack = connection->database->rollbackTransaction();
+    endTransaction();
+    return rolledBack;
+}
+
+/**
+ * @brief Drops the database if it exists.
+ * @param connectionString The connection string.
+ * @return True if the database was successfully dropped, false otherwise.
+ */
+bool SharedDatabase::dropDatabaseIfExists(const std::string& connectionString)
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->dropDatabaseIfExists(connectionString);
+}
+
+/**
+ * @brief Gets the last error message of the shared connection.
+ * @return The last error message as a string.
+ */
+std::string SharedDatabase::getLastError() const
+{
+    std::lock_guard<std::recursive_mutex> lock(connection->mutex);
+    return connection->database->getLastError();
+}
+
+/**
+ * @brief Gets the type of the database.
+ * @return The database type.
+ */
+DataBaseType SharedDatabase::getDatabaseType() const
+{
+    return connection->database->getDatabaseType();
+}
+
+/**
+ * @brief Releases the connection lock taken by beginTransaction().
+ */
+void SharedDatabase::endTransaction()
+{
+    // The caller still holds its own lock level, so the connection stays locked until it returns
+    if(transactionOpen)
+    {
+        transactionOpen = false;
+        connection->mutex.unlock();
+    }
+}
@@ -115,7 +115,7 @@ std::string SQLBuilder::buildSQLSelect(
     // WHERE
     if(!filters.empty())
     {
-        query << " WHERE " << buildWhereClause(dbType, filters, paramPrefix);
+        query << " WHERE " << buildWhereClause(dbType, filters, paramPrefix, table);
     }
 
     // ORDER BY
@@ -145,6 +145,110 @@ std::string SQLBuilder::buildSQLSelect(
     return query.str();
 }
 
+/**
+ * @brief Builds a SQL SELECT ... GROUP BY statement counting the rows of each group
+ * Groups are referenced by position, since the bucket expression is returned under
+ * the name of the timestamp column it is computed from.
+ * @param groupFields Grouping columns, returned under their own names
+ * @param table Name of the table to query
+ * @param filters WHERE clause conditions
+ * @param bucketSeconds Width of the FIELD_LOG_TIMESTAMP groups in seconds (0 = group by value)
+ * @param timestampFormat Format of the FIELD_LOG_TIMESTAMP column
+ * @param paramPrefix Prefix for parameter placeholders
+ * @param dbType Target database type
+ * @return Formatted statement returning the group columns and SQL_COUNT_ALIAS, ordered by group
+ */
+std::string SQLBuilder::buildSQLGroupCount(
+    const std::vector<std::string> & groupFields,
+    const std::string& table,
+    const std::vector<Filter> & filters,
+    const int bucketSeconds,
+    const TimestampFormat timestampFormat,
+    const std::string& paramPrefix,
+    DataBaseType dbType)
+{
+    std::stringstream query;
+    query << "SELECT ";
+
+    std::vector<std::string> positions;
+    for(size_t i = 0; i < groupFields.size(); ++i)
+    {
+        const std::string column = formatIdentifier(dbType, groupFields[i]);
+        if(bucketSeconds > 0 && groupFields[i] == FIELD_LOG_TIMESTAMP)
+        {
+            query << buildTimeBucketExpression(dbType, groupFields[i], bucketSeconds, timestampFormat) << " AS " << column;
+        }
+        else
+        {
+            query << column;
+        }
+        query << ", ";
+        positions.push_back(std::to_string(i + 1));
+    }
+    query << "COUNT(*) AS " << formatIdentifier(dbType, SQL_COUNT_ALIAS);
+
+    query << " FROM " << formatIdentifier(dbType, table);
+
+    if(!filters.empty())
+    {
+        query << " WHERE " << buildWhereClause(dbType, filters, paramPrefix, table);
+    }
+
+    if(!positions.empty())
+    {
+        const std::string groups = StringHelper::join(positions, ", ");
+        query << " GROUP BY " << groups << " ORDER BY " << groups;
+    }
+
+    return query.str();
+}
+
+/**
+ * @brief Builds the expression truncating a timestamp column to the start of its time bucket
+ * Text timestamps give the bucket start as TIMESTAMP_FMT text, epoch microseconds give
+ * it in seconds since the epoch; buckets are aligned to multiples of their width.
+ * @param dbType Target database type
+ * @param field Timestamp column
+ * @param bucketSeconds Bucket width in seconds (positive)
+ * @param timestampFormat Format of the column
+ * @return Formatted expression
+ * @throws runtime_error If database type is unsupported
+ */
+std::string SQLBuilder::buildTimeBucketExpression(DataBaseType dbType,
+        const std::string& field,
+        const int bucketSeconds,
+        const TimestampFormat timestampFormat)
+{
+    const std::string column = formatIdentifier(dbType, field);
+    const std::string width = std::to_string(bucketSeconds);
+
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        const std::string micros = std::to_string(static_cast<int64_t>(bucketSeconds) * 1000000);
+        const std::string div = dbType == DataBaseType::MySQL ? " DIV " : " / ";
+        return "(" + column + div + micros + ") * " + width;
+    }
+
+    // Text is local time: the seconds are counted as if it were UTC and converted back
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::SQLite:
+            return "datetime((CAST(strftime('%s', " + column + ") AS INTEGER) / " + width + ") * " + width + ", 'unixepoch')";
+
+        case DataBaseType::MySQL:
+            return "DATE_FORMAT(DATE_ADD('1970-01-01', INTERVAL FLOOR(TIMESTAMPDIFF(SECOND, '1970-01-01', " + column
+                   + ") / " + width + ") * " + width + " SECOND), '%Y-%m-%d %H:%i:%s')";
+
+        case DataBaseType::PostgreSQL:
+            return "to_char(TIMESTAMP '1970-01-01' + FLOOR(EXTRACT(EPOCH FROM CAST(" + column + " AS TIMESTAMP)) / "
+                   + width + ") * " + width + " * INTERVAL '1 second', 'YYYY-MM-DD HH24:MI:SS')";
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
 /**
  * @brief Builds a standard SQL UPDATE statement
  * @param table Name of the table to update
@@ -195,7 +299,9 @@ std::string SQLBuilder::buildSQLDelete(const std::string& table,
     // WHERE clause
     if(!filters.empty())
     {
-        query << " WHERE " << buildWhereClause(DataBaseType::PostgreSQL, filters, paramPrefix + "1");
+        // "$" placeholders are numbered by buildWhereClause(), "?" placeholders are positional
+        const DataBaseType placeholders = paramPrefix == "$" ? DataBaseType::PostgreSQL : DataBaseType::SQLite;
+        query << " WHERE " << buildWhereClause(placeholders, filters, paramPrefix, table);
     }
 
     return query.str();
@@ -220,10 +326,17 @@ std::string SQLBuilder::buildSQLDelete(const std::string& table,
  * @note Handles PostgreSQL's SERIAL/BIGSERIAL types specially for auto-increment fields
  * @note Automatically adds "IF NOT EXISTS" clause to prevent errors on existing tables
  * @note Properly formats the query with newlines and indentation for readability
+ * @note A range partitioned table gets a composite primary key; PostgreSQL declares
+ * PARTITION BY RANGE here, MySQL gets its partitions from buildCreatePartitionSQL()
+ * and, not supporting foreign keys on partitioned tables, no foreign keys
  */
 std::string SQLBuilder::buildCreateTable(const DatabaseSchema::TableBuilder::BuiltTable& table,
         DataBaseType dbType)
 {
+    const bool partitioned = !table.partitionField.empty()
+                             && (dbType == DataBaseType::PostgreSQL || dbType == DataBaseType::MySQL);
+    std::string primaryField;
+
     std::string query = "CREATE TABLE IF NOT EXISTS " + formatIdentifier(dbType, table.name) + " (\n";
 
     for(const auto & field : table.fields)
@@ -243,8 +356,16 @@ std::string SQLBuilder::buildCreateTable(const DatabaseSchema::TableBuilder::Bui
             query += field.getDbType(dbType);
         }
 
-        // PRIMARY
-        if(field.isPrimary)
+        // PRIMARY (partitioned: table constraint below)
+        if(field.isPrimary && partitioned)
+        {
+            primaryField = field.name;
+            if(field.isAutoincrement && dbType == DataBaseType::MySQL)
+            {
+                query += " " + resolveAutoIncrement(dbType);
+            }
+        }
+        else if(field.isPrimary)
         {
             query += " PRIMARY KEY";
 
@@ -266,22 +387,454 @@ std::string SQLBuilder::buildCreateTable(const DatabaseSchema::TableBuilder::Bui
         query += ",\n";
     }
 
+    if(!primaryField.empty())
+    {
+        query += "  PRIMARY KEY (" + formatIdentifier(dbType, primaryField) + ", "
+                 + formatIdentifier(dbType, table.partitionField) + "),\n";
+    }
+
     // FOREIGN KEY
+    const bool foreignKeys = !partitioned || dbType != DataBaseType::MySQL;
     for(const auto & [field, ref] : table.foreignKeys)
     {
+        if(!foreignKeys) break;
         query += "  FOREIGN KEY (" + formatIdentifier(dbType, field) + ") REFERENCES " +
                  formatIdentifier(dbType, ref.first) + " (" + formatIdentifier(dbType, ref.second) + "),\n";
     }
 
-    if(!table.fields.empty() || !table.foreignKeys.empty())
+    if(!table.fields.empty() || (foreignKeys && !table.foreignKeys.empty()))
     {
         query = query.substr(0, query.size() - 2);
     }
-    query += "\n);";
+    query += "\n)";
+
+    if(partitioned && dbType == DataBaseType::PostgreSQL)
+    {
+        query += " PARTITION BY RANGE (" + formatIdentifier(dbType, table.partitionField) + ")";
+    }
+    query += ";";
+
+    return query;
+}
+
+/**
+* @brief Builds the statement adding a range partition to a partitioned table
+* @param dbType Target database type (PostgreSQL or MySQL)
+* @param tableName Partitioned table name
+* @param partitionField Partition key field
+* @param partitionName Partition name (PostgreSQL: table name of the partition)
+* @param lowerBound Inclusive lower bound (PostgreSQL only, MySQL ranges start at the previous partition)
+* @param upperBound Exclusive upper bound
+* @param first Whether this is the first partition (MySQL: partitions the table)
+* @return Formatted statement (empty if not supported)
+*/
+std::string SQLBuilder::buildCreatePartitionSQL(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& partitionField,
+    const std::string& partitionName,
+    const std::string& lowerBound,
+    const std::string& upperBound,
+    const bool first)
+{
+    switch(dbType)
+    {
+        case DataBaseType::PostgreSQL:
+            return "CREATE TABLE IF NOT EXISTS " + formatIdentifier(dbType, partitionName)
+                   + " PARTITION OF " + formatIdentifier(dbType, tableName)
+                   + " FOR VALUES FROM (" + formatValue(dbType, lowerBound)
+                   + ") TO (" + formatValue(dbType, upperBound) + ")";
+
+        case DataBaseType::MySQL:
+        {
+            const std::string partition = "PARTITION " + formatIdentifier(dbType, partitionName)
+                                          + " VALUES LESS THAN (" + formatValue(dbType, upperBound) + ")";
+            if(first)
+            {
+                return "ALTER TABLE " + formatIdentifier(dbType, tableName)
+                       + " PARTITION BY RANGE COLUMNS(" + formatIdentifier(dbType, partitionField) + ") (" + partition + ")";
+            }
+            return "ALTER TABLE " + formatIdentifier(dbType, tableName) + " ADD PARTITION (" + partition + ")";
+        }
+
+        default:
+            return "";
+    }
+}
+
+/**
+* @brief Builds the statement dropping a partition with all its rows
+* @param dbType Target database type
+* @param tableName Partitioned table name
+* @param partitionName Partition name (SQLite and PostgreSQL: table name of the partition)
+* @return Formatted statement (empty if not supported)
+*/
+std::string SQLBuilder::buildDropPartitionSQL(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& partitionName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+        case DataBaseType::PostgreSQL:
+            return "DROP TABLE IF EXISTS " + formatIdentifier(dbType, partitionName);
+
+        case DataBaseType::MySQL:
+            return "ALTER TABLE " + formatIdentifier(dbType, tableName) + " DROP PARTITION " + formatIdentifier(dbType, partitionName);
+
+        default:
+            return "";
+    }
+}
+
+/**
+* @brief Builds a query listing the partitions of a table
+* SQLite has no partitions: the query lists the tables named <table>_p*,
+* which the caller still has to match exactly.
+* @param dbType Target database type
+* @param tableName Partitioned table name
+* @return Formatted query returning a "name" column
+* @throws runtime_error If database type is unsupported
+*/
+std::string SQLBuilder::buildPartitionsQuery(DataBaseType dbType, const std::string& tableName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+            return "SELECT name FROM sqlite_master WHERE type = 'table' AND name LIKE "
+                   + formatValue(dbType, tableName + "_p%");
+
+        case DataBaseType::MySQL:
+            return "SELECT partition_name AS name FROM information_schema.partitions "
+                   "WHERE table_schema = DATABASE() AND partition_name IS NOT NULL AND table_name = "
+                   + formatValue(dbType, tableName);
+
+        case DataBaseType::PostgreSQL:
+            return "SELECT c.relname AS name FROM pg_inherits i "
+                   "JOIN pg_class c ON c.oid = i.inhrelid "
+                   "JOIN pg_class p ON p.oid = i.inhparent WHERE p.relname = "
+                   + formatValue(dbType, tableName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+* @brief Builds a CREATE VIEW statement concatenating tables with UNION ALL
+* Tables are grouped into nested compound selects of at most SQL_VIEW_MAX_UNION_TERMS,
+* staying below the SQLite compound select limit.
+* @param dbType Target database type
+* @param viewName View name
+* @param tables Tables with identical columns (at least one)
+* @return Formatted CREATE VIEW statement (empty if no tables)
+*/
+std::string SQLBuilder::buildUnionViewSQL(
+    DataBaseType dbType,
+    const std::string& viewName,
+    const std::vector<std::string> & tables)
+{
+    if(tables.empty())
+    {
+        return "";
+    }
+
+    std::vector<std::string> terms;
+    terms.reserve(tables.size());
+    for(const auto & table : tables)
+    {
+        terms.push_back("SELECT * FROM " + formatIdentifier(dbType, table));
+    }
+
+    while(terms.size() > SQL_VIEW_MAX_UNION_TERMS)
+    {
+        std::vector<std::string> groups;
+        for(size_t i = 0; i < terms.size(); i += SQL_VIEW_MAX_UNION_TERMS)
+        {
+            const size_t end = std::min(terms.size(), i + SQL_VIEW_MAX_UNION_TERMS);
+            std::vector<std::string> group(terms.begin() + i, terms.begin() + end);
+            groups.push_back("SELECT * FROM (" + StringHelper::join(group, " UNION ALL ") + ")");
+        }
+        terms.swap(groups);
+    }
+
+    return "CREATE VIEW " + formatIdentifier(dbType, viewName) + " AS " + StringHelper::join(terms, " UNION ALL ");
+}
+
+/**
+* @brief Builds the statements creating a full-text index on a text column
+* SQLite: an external content FTS5 table <table>_fts kept in sync by triggers;
+* PostgreSQL: a GIN index on to_tsvector(FTS_PG_CONFIG, column); MySQL: a FULLTEXT index.
+* @param dbType Target database type
+* @param tableName Indexed table name
+* @param indexName Index name (the SQLite triggers are named after it)
+* @param field Text column
+* @return std::vector<std::string> Statements (empty if not supported)
+*/
+std::vector<std::string> SQLBuilder::buildCreateFullTextIndexSQL(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& indexName,
+    const std::string& field)
+{
+    const std::string table = formatIdentifier(dbType, tableName);
+    const std::string column = formatIdentifier(dbType, field);
+
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+        {
+            const std::string ftsTable = formatIdentifier(dbType, tableName + FTS_SUFFIX);
+            const std::string insertNew = "INSERT INTO " + ftsTable + "(rowid, " + column + ") VALUES (new."
+                                          + formatIdentifier(dbType, FIELD_LOG_ID) + ", new." + column + ");";
+            const std::string deleteOld = "INSERT INTO " + ftsTable + "(" + ftsTable + ", rowid, " + column
+                                          + ") VALUES ('delete', old." + formatIdentifier(dbType, FIELD_LOG_ID)
+                                          + ", old." + column + ");";
+            return
+            {
+                "CREATE VIRTUAL TABLE IF NOT EXISTS " + ftsTable + " USING fts5(" + column
+                + ", content=" + formatValue(dbType, tableName, ValueType::String)
+                + ", content_rowid=" + formatValue(dbType, FIELD_LOG_ID, ValueType::String) + ")",
+                "CREATE TRIGGER IF NOT EXISTS " + formatIdentifier(dbType, indexName + "_ai")
+                + " AFTER INSERT ON " + table + " BEGIN " + insertNew + " END",
+                "CREATE TRIGGER IF NOT EXISTS " + formatIdentifier(dbType, indexName + "_ad")
+                + " AFTER DELETE ON " + table + " BEGIN " + deleteOld + " END",
+                "CREATE TRIGGER IF NOT EXISTS " + formatIdentifier(dbType, indexName + "_au")
+                + " AFTER UPDATE ON " + table + " BEGIN " + deleteOld + " " + insertNew + " END"
+            };
+        }
+
+        case DataBaseType::PostgreSQL:
+            return
+            {
+                "CREATE INDEX IF NOT EXISTS " + formatIdentifier(dbType, indexName) + " ON " + table
+                + " USING GIN (to_tsvector('" FTS_PG_CONFIG "', " + column + "))"
+            };
+
+        case DataBaseType::MySQL:
+            return
+            {
+                "CREATE FULLTEXT INDEX " + formatIdentifier(dbType, indexName) + " ON " + table + " (" + column + ")"
+            };
+
+        default:
+            return {};
+    }
+}
+
+/**
+* @brief Builds the statements dropping a full-text index
+* @param dbType Target database type
+* @param tableName Indexed table name
+* @param indexName Index name
+* @return std::vector<std::string> Statements (empty if not supported)
+*/
+std::vector<std::string> SQLBuilder::buildDropFullTextIndexSQL(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& indexName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+            return
+            {
+                "DROP TRIGGER IF EXISTS " + formatIdentifier(dbType, indexName + "_ai"),
+                "DROP TRIGGER IF EXISTS " + formatIdentifier(dbType, indexName + "_ad"),
+                "DROP TRIGGER IF EXISTS " + formatIdentifier(dbType, indexName + "_au"),
+                "DROP TABLE IF EXISTS " + formatIdentifier(dbType, tableName + FTS_SUFFIX)
+            };
+
+        case DataBaseType::PostgreSQL:
+            return { "DROP INDEX IF EXISTS " + formatIdentifier(dbType, indexName) };
+
+        case DataBaseType::MySQL:
+            return { "ALTER TABLE " + formatIdentifier(dbType, tableName) + " DROP INDEX " + formatIdentifier(dbType, indexName) };
+
+        default:
+            return {};
+    }
+}
+
+/**
+* @brief Builds the statement indexing the rows written before the full-text index existed
+* @param dbType Target database type
+* @param tableName Indexed table name
+* @return Formatted statement (empty if the database indexes existing rows on creation)
+*/
+std::string SQLBuilder::buildRebuildFullTextIndexSQL(DataBaseType dbType, const std::string& tableName)
+{
+    if(dbType != DataBaseType::SQLite)
+    {
+        return "";
+    }
+
+    const std::string ftsTable = formatIdentifier(dbType, tableName + FTS_SUFFIX);
+    return "INSERT INTO " + ftsTable + "(" + ftsTable + ") VALUES ('rebuild')";
+}
+
+/**
+* @brief Builds the full-text condition of a MATCH filter
+* @param dbType Target database type
+* @param tableName Filtered table name (SQLite: the full-text table is <table>_fts)
+* @param field Text column
+* @param placeholder Placeholder of the search value (see buildMatchValue())
+* @return Formatted condition
+*/
+std::string SQLBuilder::buildMatchCondition(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& field,
+    const std::string& placeholder)
+{
+    const std::string column = formatIdentifier(dbType, field);
+
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+        {
+            const std::string ftsTable = formatIdentifier(dbType, tableName + FTS_SUFFIX);
+            return formatIdentifier(dbType, FIELD_LOG_ID) + " IN (SELECT rowid FROM " + ftsTable
+                   + " WHERE " + ftsTable + " MATCH " + placeholder + ")";
+        }
+
+        case DataBaseType::PostgreSQL:
+            return "to_tsvector('" FTS_PG_CONFIG "', " + column + ") @@ plainto_tsquery('" FTS_PG_CONFIG "', " + placeholder + ")";
+
+        case DataBaseType::MySQL:
+            return "MATCH(" + column + ") AGAINST(" + placeholder + " IN BOOLEAN MODE)";
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+* @brief Converts search words to the full-text query syntax of a database
+* Every word is quoted, so the words are matched literally and all of them must occur:
+* "a" "b" (SQLite FTS5), +"a" +"b" (MySQL boolean mode), the words as is (PostgreSQL plainto_tsquery).
+* @param dbType Target database type
+* @param text Search words separated by whitespace
+* @return Search value bound to the MATCH condition
+*/
+std::string SQLBuilder::buildMatchValue(DataBaseType dbType, const std::string& text)
+{
+    if(dbType == DataBaseType::PostgreSQL)
+    {
+        return text;
+    }
+
+    std::vector<std::string> terms;
+    for(const auto & word : StringHelper::splitWords(text))
+    {
+        std::string term = dbType == DataBaseType::MySQL ? "+\"" : "\"";
+        for(const char c : word)
+        {
+            if(c == '"')
+            {
+                // FTS5 escapes quotes by doubling them, MySQL can't quote them at all
+                term += dbType == DataBaseType::MySQL ? " " : "\"\"";
+                continue;
+            }
+            term += c;
+        }
+        terms.push_back(term + "\"");
+    }
+    return StringHelper::join(terms, " ");
+}
 
+/**
+ * @brief Builds a query to check if a view exists
+ * @param dbType Target database type
+ * @param viewName Name of the view to check
+ * @return Formatted view existence query
+ * @throws runtime_error If database type is unsupported
+ */
+std::string SQLBuilder::buildViewExistsQuery(DataBaseType dbType, const std::string& viewName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+            return "SELECT 1 FROM sqlite_master WHERE type = 'view' AND name = " + formatValue(dbType, viewName);
+
+        case DataBaseType::MySQL:
+            return "SELECT 1 FROM information_schema.views WHERE table_name = " + formatValue(dbType, viewName);
+
+        case DataBaseType::PostgreSQL:
+            return "SELECT 1 FROM pg_views WHERE viewname = " + formatValue(dbType, viewName);
+
+        default:
+            throw std::runtime_error(ERR_MSG_UNSUPPORTED_DB);
+    }
+}
+
+/**
+ * @brief Builds a query reading the schema version marker of a table
+ * @param dbType Target database type
+ * @param schemaTable Schema version table name
+ * @param table Table whose marker is read
+ * @param requiredTables Tables that must exist for the marker to be returned
+ * @return Formatted query returning FIELD_SCHEMA_VERSION (no row if the marker or a table is missing)
+ */
+std::string SQLBuilder::buildSchemaVersionQuery(DataBaseType dbType,
+        const std::string& schemaTable,
+        const std::string& table,
+        const std::vector<std::string> & requiredTables)
+{
+    std::string query = "SELECT " + formatIdentifier(dbType, FIELD_SCHEMA_VERSION)
+                        + " FROM " + formatIdentifier(dbType, schemaTable)
+                        + " WHERE " + formatIdentifier(dbType, FIELD_SCHEMA_TABLE) + " = " + formatValue(dbType, table);
+
+    // A table dropped behind the logger's back invalidates its marker
+    for(const auto & required : requiredTables)
+    {
+        query += " AND EXISTS (" + buildTableExistsQuery(dbType, required) + ")";
+    }
+    return query;
+}
+
+/**
+ * @brief Builds an INSERT that keeps the existing row on a unique key conflict and returns its columns
+ * @param dbType Target database type (SQLite 3.35+ or PostgreSQL)
+ * @param table Table name
+ * @param values Vector of column-value pairs
+ * @param conflictField Unique column identifying the row
+ * @param returning Columns returned for the inserted or existing row
+ * @return Formatted INSERT ... ON CONFLICT ... RETURNING statement
+ */
+std::string SQLBuilder::buildSQLUpsertReturning(DataBaseType dbType,
+        const std::string& table,
+        const std::vector<std::pair<std::string, std::string>> & values,
+        const std::string& conflictField,
+        const std::vector<std::string> & returning)
+{
+    const std::string paramPrefix = dbType == DataBaseType::PostgreSQL ? DB_PARAM_PREFIX_POSTGRESQL : DB_PARAM_PREFIX_SQLITE;
+    const std::string conflict = formatIdentifier(dbType, conflictField);
+
+    // DO NOTHING would return no row for an existing key, the no-op update returns it
+    std::string query = buildSQLInsert(table, values, paramPrefix, dbType)
+                        + " ON CONFLICT (" + conflict + ") DO UPDATE SET " + conflict + " = excluded." + conflict
+                        + " RETURNING ";
+    for(size_t i = 0; i < returning.size(); ++i)
+    {
+        if(i > 0) query += ", ";
+        query += formatIdentifier(dbType, returning[i]);
+    }
     return query;
 }
 
+/**
+* @brief Builds a DROP VIEW statement
+* @param dbType Target database type
+* @param viewName View name
+* @return Formatted DROP VIEW statement
+*/
+std::string SQLBuilder::buildDropViewSQL(DataBaseType dbType, const std::string& viewName)
+{
+    return "DROP VIEW IF EXISTS " + formatIdentifier(dbType, viewName);
+}
+
 /**
 * @brief Builds CREATE INDEX SQL statement
 * @param dbType Target database type
@@ -337,6 +890,32 @@ std::string SQLBuilder::buildCreateIndexSQL(
     }
 }
 
+/**
+* @brief Builds DROP INDEX SQL statement
+* @param dbType Target database type
+* @param tableName Table name
+* @param indexName Index name
+* @return Formatted DROP INDEX statement
+*/
+std::string SQLBuilder::buildDropIndexSQL(
+    DataBaseType dbType,
+    const std::string& tableName,
+    const std::string& indexName)
+{
+    switch(dbType)
+    {
+        case DataBaseType::SQLite:
+        case DataBaseType::PostgreSQL:
+            return "DROP INDEX IF EXISTS " + indexName;
+
+        case DataBaseType::MySQL:
+            return "ALTER TABLE " + tableName + " DROP INDEX " + indexName;
+
+        default:
+            return "";
+    }
+}
+
 /**
  * @brief Builds a query to check if a table exists
  * @param dbType Target database type
@@ -395,12 +974,14 @@ std::string SQLBuilder::buildIndexExistsQuery(DataBaseType dbType, const std::st
  * @param dbType Target database type
  * @param filters Filter conditions
  * @param paramPrefix Prefix for parameter placeholders
+ * @param table Filtered table (needed by MATCH filters)
  * @return Formatted WHERE clause
  * @throws runtime_error If database type is unsupported
  */
 std::string SQLBuilder::buildWhereClause(DataBaseType dbType,
         const std::vector<Filter> & filters,
-        const std::string& paramPrefix)
+        const std::string& paramPrefix,
+        const std::string& table)
 {
     std::stringstream whereClause;
 
@@ -408,6 +989,21 @@ std::string SQLBuilder::buildWhereClause(DataBaseType dbType,
     {
         if(i > 0) whereClause << " AND ";
 
+        if(filters[i].op == FILTER_OP_MATCH && dbType != DataBaseType::Mock)
+        {
+            std::string placeholder = formatValue(dbType, buildMatchValue(dbType, filters[i].value), ValueType::String);
+            if(dbType == DataBaseType::PostgreSQL)
+            {
+                placeholder = paramPrefix + std::to_string(i + 1);
+            }
+            else if(!paramPrefix.empty())
+            {
+                placeholder = paramPrefix;
+            }
+            whereClause << buildMatchCondition(dbType, table, filters[i].field, placeholder);
+            continue;
+        }
+
         // Format condition based on database type
         switch(dbType)
         {
@@ -673,40 +1269,50 @@ std::string SQLBuilder::buildSQLBatchInsert(
         return "";
     }
 
-    std::stringstream query;
-
     // INSERT clause
-    query << "INSERT INTO " << formatIdentifier(dbType, table) << " (";
+    std::string query = "INSERT INTO " + formatIdentifier(dbType, table) + " (";
 
     // Field names
     for(size_t i = 0; i < fields.size(); ++i)
     {
-        if(i > 0) query << ", ";
-        query << formatIdentifier(dbType, fields[i]);
+        if(i > 0) query += ", ";
+        query += formatIdentifier(dbType, fields[i]);
     }
-    query << ") VALUES ";
+    query += ") VALUES ";
 
-    // Value placeholders
-    for(size_t row = 0; row < numRows; ++row)
+    if(dbType != DataBaseType::PostgreSQL)
     {
-        if(row > 0) query << ", ";
-        query << "(";
-
+        // Positional placeholders: every row is the same block, built once
+        std::string row = "(";
         for(size_t col = 0; col < fields.size(); ++col)
         {
-            if(col > 0) query << ", ";
+            if(col > 0) row += ", ";
+            row += paramPrefix;
+        }
+        row += ")";
 
-            switch(dbType)
-            {
-                case DataBaseType::PostgreSQL:
-                    query << paramPrefix << (row* fields.size() + col + 1);
-                    break;
-                default:
-                    query << paramPrefix;
-            }
+        query.reserve(query.size() + numRows * (row.size() + 2));
+        for(size_t i = 0; i < numRows; ++i)
+        {
+            if(i > 0) query += ", ";
+            query += row;
         }
-        query << ")";
+        return query;
     }
 
-    return query.str();
+    // Numbered placeholders ($1, $2, ...)
+    size_t param = 1;
+    for(size_t i = 0; i < numRows; ++i)
+    {
+        query += i > 0 ? ", (" : "(";
+        for(size_t col = 0; col < fields.size(); ++col, ++param)
+        {
+            if(col > 0) query += ", ";
+            query += paramPrefix;
+            query += std::to_string(param);
+        }
+        query += ")";
+    }
+
+    return query;
 }
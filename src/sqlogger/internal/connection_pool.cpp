@@ -0,0 +1,150 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include "sqlogger/internal/connection_pool.h"
+
+/**
+ * @brief Constructs a pool (no connections are opened yet).
+ * @param maxSize Maximum number of open connections.
+ * @param factory Function opening a new connection.
+ * @param healthCheckInterval Idle time after which a connection is pinged before reuse.
+ */
+ConnectionPool::ConnectionPool(const size_t maxSize,
+                               Factory factory,
+                               const std::chrono::milliseconds healthCheckInterval)
+    : maxSize(std::max<size_t>(maxSize, 1)),
+      factory(std::move(factory)),
+      healthCheckInterval(healthCheckInterval)
+{
+}
+
+/**
+ * @brief Takes a connection, waiting while all connections are leased.
+ * @return Lease Exclusive use of a healthy connection.
+ * @throws std::runtime_error If a new connection could not be opened.
+ */
+ConnectionPool::Lease ConnectionPool::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    available.wait(lock, [this]
+    {
+        return !idle.empty() || openCount < maxSize;
+    });
+
+    if(!idle.empty())
+    {
+        IdleConnection connection = std::move(idle.back());
+        idle.pop_back();
+        lock.unlock();
+
+        if(isHealthy(connection))
+        {
+            return Lease( * this, std::move(connection.database));
+        }
+
+        // Broken: keep the slot and reopen below
+        connection.database.reset();
+    }
+    else
+    {
+        ++openCount;
+        lock.unlock();
+    }
+
+    try
+    {
+        std::unique_ptr<IDatabase> database = factory();
+        if(!database || !database->isConnected())
+        {
+            throw std::runtime_error(ERR_MSG_FAILED_POOL_CONNECT);
+        }
+        return Lease( * this, std::move(database));
+    }
+    catch(...)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            --openCount;
+        }
+        available.notify_one();
+        throw;
+    }
+}
+
+/**
+ * @brief Gets the maximum number of connections.
+ * @return size_t Pool size.
+ */
+size_t ConnectionPool::getMaxSize() const
+{
+    return maxSize;
+}
+
+/**
+ * @brief Gets the number of currently open connections (leased and idle).
+ * @return size_t Open connection count.
+ */
+size_t ConnectionPool::getOpenCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return openCount;
+}
+
+/**
+ * @brief Returns a connection to the pool.
+ * @param database The connection.
+ * @param broken If true, the connection is closed instead of kept.
+ */
+void ConnectionPool::release(std::unique_ptr<IDatabase> database, const bool broken)
+{
+    if(broken)
+    {
+        database.reset();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --openCount;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.push_back({ std::move(database), std::chrono::steady_clock::now() });
+    }
+    available.notify_one();
+}
+
+/**
+ * @brief Checks if an idle connection can be reused.
+ * @param connection The idle connection.
+ * @return bool True if healthy.
+ */
+bool ConnectionPool::isHealthy(const IdleConnection& connection) const
+{
+    if(!connection.database->isConnected())
+    {
+        return false;
+    }
+
+    if(std::chrono::steady_clock::now() - connection.lastUsed < healthCheckInterval)
+    {
+        return true;
+    }
+
+    return connection.database->execute(CONNECTION_POOL_PING_QUERY);
+}
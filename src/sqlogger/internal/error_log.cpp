@@ -0,0 +1,290 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <filesystem>
+#include "sqlogger/internal/error_log.h"
+#include "sqlogger/log_helper.h"
+
+/**
+ * @brief Constructs an error log.
+ * @param path Error log file path.
+ * @param rateLimit Lines written per second (0 = unlimited).
+ * @param maxBytes File size at which the file is rotated (0 = never).
+ */
+ErrorLog::ErrorLog(const std::string& path, const size_t rateLimit, const uint64_t maxBytes)
+    : rateLimit(rateLimit),
+      maxBytes(maxBytes),
+      path(path),
+      windowStart(std::chrono::steady_clock::now()),
+      noticeTime(windowStart)
+{
+}
+
+/**
+ * @brief Writes the buffered lines and stops the flush thread.
+ */
+ErrorLog::~ErrorLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    condition.notify_all();
+    if(flusher.joinable())
+    {
+        flusher.join();
+    }
+    flush();
+}
+
+/**
+ * @brief Writes the buffered lines and switches to another file.
+ * @param path Error log file path.
+ */
+void ErrorLog::setPath(const std::string& path)
+{
+    flush();
+    std::lock_guard<std::mutex> lock(mutex);
+    this->path = path;
+}
+
+/**
+ * @brief Gets the error log file path.
+ * @return std::string Path.
+ */
+std::string ErrorLog::getPath() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return path;
+}
+
+/**
+ * @brief Buffers an error line.
+ * @param message The error message.
+ * @param function The function where the error occurred.
+ * @param file The file where the error occurred.
+ * @param line The line number where the error occurred.
+ */
+void ErrorLog::write(const std::string& message, const std::string& function, const std::string& file, const int line)
+{
+    std::string text;
+    text.reserve(message.size() + function.size() + file.size() + 16);
+    text += "\"";
+    text += message;
+    text += "\" ";
+    text += function;
+    text += " ";
+    text += file;
+    text += ":";
+    text += std::to_string(line);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!flusher.joinable() && !stop)
+    {
+        flusher = std::thread( & ErrorLog::flushLoop, this);
+    }
+
+    const bool idle = buffer.empty() && repeats == 0 && suppressed == 0;
+    if(text == lastMessage)
+    {
+        ++repeats;
+        ++stats.repeated;
+    }
+    else
+    {
+        // The repeat count belongs right after the repeated line
+        appendNotices(repeats > 0);
+        lastMessage = text;
+
+        const auto now = std::chrono::steady_clock::now();
+        if(now - windowStart >= std::chrono::seconds(1))
+        {
+            windowStart = now;
+            windowLines = 0;
+        }
+
+        if(rateLimit > 0 && windowLines >= rateLimit)
+        {
+            ++suppressed;
+            ++stats.suppressed;
+        }
+        else
+        {
+            ++windowLines;
+            appendLine(text);
+        }
+    }
+
+    if(idle || buffer.size() >= ERROR_LOG_BUFFER_SIZE)
+    {
+        condition.notify_all();
+    }
+}
+
+/**
+ * @brief Writes the buffered lines (and pending repeat and suppression counts) to the file.
+ */
+void ErrorLog::flush()
+{
+    flushBuffer(true);
+}
+
+/**
+ * @brief Gets the error log counters.
+ * @return Stats Counters.
+ */
+ErrorLog::Stats ErrorLog::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+/**
+ * @brief Appends the pending repeat and suppression counts to the buffer (mutex held).
+ * @param force Whether to report them before ERROR_LOG_NOTICE_INTERVAL_MS has elapsed.
+ */
+void ErrorLog::appendNotices(const bool force)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if(!force && now - noticeTime < std::chrono::milliseconds(ERROR_LOG_NOTICE_INTERVAL_MS))
+    {
+        return;
+    }
+    noticeTime = now;
+
+    if(repeats > 0)
+    {
+        appendLine("\"Last message repeated " + std::to_string(repeats) + " times\"");
+        repeats = 0;
+    }
+    if(suppressed > 0)
+    {
+        appendLine("\"" + std::to_string(suppressed) + " messages suppressed by the rate limit\"");
+        suppressed = 0;
+    }
+}
+
+/**
+ * @brief Appends the buffer to the file.
+ * @param force Whether to report pending repeat and suppression counts.
+ */
+void ErrorLog::flushBuffer(const bool force)
+{
+    // fileMutex first, so concurrent flushes write their chunks in order
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+
+    std::string data;
+    std::string target;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        appendNotices(force);
+        data.swap(buffer);
+        target = path;
+    }
+
+    if(!data.empty())
+    {
+        writeFile(data, target);
+    }
+}
+
+/**
+ * @brief Appends a timestamped line to the buffer (mutex held).
+ * @param text Line text.
+ */
+void ErrorLog::appendLine(const std::string& text)
+{
+    buffer += LogHelper::getCurrentTimestamp();
+    buffer += " [ERROR] ";
+    buffer += text;
+    buffer += "\n";
+    ++stats.written;
+}
+
+/**
+ * @brief Appends lines to the file, rotating it first if it would grow past maxBytes (fileMutex held).
+ * @param data Buffered lines.
+ * @param target Error log file path.
+ */
+void ErrorLog::writeFile(const std::string& data, const std::string& target)
+{
+    if(!out.is_open() || openPath != target)
+    {
+        out.close();
+        out.clear();
+
+        // The only stat: the size is tracked from here on
+        std::error_code error;
+        const auto size = std::filesystem::file_size(target, error);
+        fileBytes = error ? 0 : static_cast<uint64_t>(size);
+
+        out.open(target, std::ios::app);
+        openPath = target;
+    }
+
+    if(out.is_open() && maxBytes > 0 && fileBytes > 0 && fileBytes + data.size() > maxBytes)
+    {
+        out.close();
+        FSHelper::rotateLog(target);
+        out.clear();
+        out.open(target, std::ios::app);
+        fileBytes = 0;
+    }
+
+    if(!out.is_open())
+    {
+        std::cerr << ERR_MSG_FAILED_OPEN_ERR_LOG << target << std::endl;
+        openPath.clear();
+        return;
+    }
+
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    out.flush();
+    fileBytes += data.size();
+}
+
+/**
+ * @brief Flush thread body.
+ */
+void ErrorLog::flushLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!stop)
+    {
+        if(buffer.empty() && repeats == 0 && suppressed == 0)
+        {
+            // Nothing to write: sleep until the next error
+            condition.wait(lock, [this]
+            {
+                return stop || !buffer.empty() || repeats > 0 || suppressed > 0;
+            });
+            continue;
+        }
+
+        condition.wait_for(lock, std::chrono::milliseconds(ERROR_LOG_FLUSH_INTERVAL_MS), [this]
+        {
+            return stop || buffer.size() >= ERROR_LOG_BUFFER_SIZE;
+        });
+
+        lock.unlock();
+        flushBuffer(false);
+        lock.lock();
+    }
+}
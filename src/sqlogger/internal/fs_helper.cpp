@@ -87,6 +87,18 @@ std::string FSHelper::toFilename(const std::string& path)
     return std::filesystem::path(path).filename().string();
 }
 
+/**
+ * @brief Extracts the filename component from a path without copying
+ * @param path The full filesystem path
+ * @return std::string_view Just the filename portion of the path (refers to path's storage)
+ * @note Both '/' and '\' are treated as separators
+ */
+std::string_view FSHelper::toFilenameView(std::string_view path)
+{
+    const size_t separator = path.find_last_of("/\\");
+    return separator == std::string_view::npos ? path : path.substr(separator + 1);
+}
+
 /**
  * @brief Gets the size of a file in megabytes
  * @param path The filesystem path of the file to check
@@ -134,3 +146,38 @@ bool FSHelper::rotateLog(const std::string& path)
     return true;
 }
 
+/**
+ * @brief Rotates numbered segments of a file: path.(keep - 1) becomes path.keep, ..., path becomes path.1
+ * @param path The filesystem path of the current segment
+ * @param keep Number of rotated segments to keep (the oldest is deleted, 0 deletes path)
+ * @param errMsg[out] Reference to string that will contain error message if operation fails
+ * @return true if path no longer exists
+ * @return false if a segment couldn't be renamed or deleted (check errMsg for details)
+ */
+bool FSHelper::rotateSegments(const std::string& path, const int keep, std::string& errMsg)
+{
+    std::error_code error;
+    if(keep <= 0)
+    {
+        std::filesystem::remove(path, error);
+    }
+    else
+    {
+        std::filesystem::remove(path + "." + std::to_string(keep), error);
+        for(int index = keep - 1; index >= 0 && !error; --index)
+        {
+            const std::string from = index == 0 ? path : path + "." + std::to_string(index);
+            if(std::filesystem::exists(from, error))
+            {
+                std::filesystem::rename(from, path + "." + std::to_string(index + 1), error);
+            }
+        }
+    }
+
+    if(error)
+    {
+        errMsg = error.message();
+        return false;
+    }
+    return true;
+}
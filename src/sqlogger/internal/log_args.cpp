@@ -0,0 +1,136 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include "sqlogger/internal/log_args.h"
+#include <charconv>
+#include <cstdio>
+
+/**
+ * @brief Formats the packed arguments into a format string.
+ * "{}" (with or without a format spec, which is ignored) takes the next argument,
+ * "{{" and "}}" produce literal braces. Placeholders without an argument are kept as is.
+ * @param format The format string.
+ * @return std::string Formatted text.
+ */
+std::string LogArgs::format(std::string_view format) const
+{
+    std::string result;
+    result.reserve(format.size() + data.size());
+
+    size_t offset = 0;
+    auto read = [this, & offset](void* value, const size_t size)
+    {
+        std::memcpy(value, data.data() + offset, size);
+        offset += size;
+    };
+
+    for(size_t i = 0; i < format.size(); ++i)
+    {
+        const char ch = format[i];
+        if(ch == '}' && i + 1 < format.size() && format[i + 1] == '}')
+        {
+            result.push_back('}');
+            ++i;
+            continue;
+        }
+        if(ch != '{')
+        {
+            result.push_back(ch);
+            continue;
+        }
+        if(i + 1 < format.size() && format[i + 1] == '{')
+        {
+            result.push_back('{');
+            ++i;
+            continue;
+        }
+
+        const size_t close = format.find('}', i);
+        if(close == std::string_view::npos || offset >= data.size())
+        {
+            // Unterminated placeholder or no argument left: keep the text
+            const size_t end = close == std::string_view::npos ? format.size() : close + 1;
+            result.append(format.substr(i, end - i));
+            i = end - 1;
+            continue;
+        }
+        i = close;
+
+        char buffer[32];
+        const Type type = static_cast<Type>(data[offset++]);
+        switch(type)
+        {
+            case Type::Bool:
+            {
+                bool value = false;
+                read( & value, sizeof(value));
+                result.append(value ? "true" : "false");
+                break;
+            }
+            case Type::Char:
+            {
+                char value = 0;
+                read( & value, sizeof(value));
+                result.push_back(value);
+                break;
+            }
+            case Type::Int64:
+            {
+                int64_t value = 0;
+                read( & value, sizeof(value));
+                result.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                break;
+            }
+            case Type::UInt64:
+            {
+                uint64_t value = 0;
+                read( & value, sizeof(value));
+                result.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                break;
+            }
+            case Type::Double:
+            {
+                // Same text as the default operator<< (precision 6, %g)
+                double value = 0;
+                read( & value, sizeof(value));
+                const int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+                result.append(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+                break;
+            }
+            case Type::Pointer:
+            {
+                const void* value = nullptr;
+                read( & value, sizeof(value));
+                const int length = std::snprintf(buffer, sizeof(buffer), "%p", value);
+                result.append(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+                break;
+            }
+            case Type::String:
+            default:
+            {
+                uint32_t length = 0;
+                read( & length, sizeof(length));
+                result.append(data.data() + offset, length);
+                offset += length;
+                break;
+            }
+        }
+    }
+    return result;
+}
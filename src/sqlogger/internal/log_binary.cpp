@@ -0,0 +1,376 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <cstring>
+#include <unordered_map>
+#include "sqlogger/internal/log_binary.h"
+#include "sqlogger/internal/log_strings.h"
+
+/**
+ * @brief Appends an unsigned LEB128 varint.
+ * @param out Buffer to append to.
+ * @param value Value.
+ */
+static void appendVarint(std::string& out, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+/**
+ * @brief Maps a signed value to an unsigned one with small magnitudes kept small.
+ * @param value Signed value.
+ * @return uint64_t Zigzag-encoded value.
+ */
+static uint64_t zigzag(const int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Reverses zigzag().
+ * @param value Zigzag-encoded value.
+ * @return int64_t Signed value.
+ */
+static int64_t unzigzag(const uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * @brief Appends a length-prefixed string.
+ * @param out Buffer to append to.
+ * @param value String.
+ */
+static void appendBytes(std::string& out, std::string_view value)
+{
+    appendVarint(out, value.size());
+    out.append(value.data(), value.size());
+}
+
+/**
+ * @brief Copies the view into a LogEntry.
+ * @return LogEntry Owning entry.
+ */
+LogEntry LogSerializer::Binary::LogEntryView::toEntry() const
+{
+    LogEntry entry{};
+    entry.id = id;
+    entry.timestampUs = timestampUs;
+    entry.timestamp = std::string(timestamp);
+    entry.level = std::string(level);
+    entry.message = std::string(message);
+    entry.function = std::string(function);
+    entry.file = std::string(file);
+    entry.line = line;
+    entry.threadId = std::string(threadId);
+#ifdef SQLG_USE_SOURCE_INFO
+    entry.sourceId = sourceId;
+    entry.sourceUuid = std::string(sourceUuid);
+    entry.sourceName = std::string(sourceName);
+#endif
+    return entry;
+}
+
+/**
+ * @brief Decodes the next entry.
+ * @param view Receives the entry.
+ * @return bool True if an entry was decoded, false at the end of the data.
+ * @throws std::runtime_error If the data is corrupt or of an unsupported version.
+ */
+bool LogSerializer::Binary::Reader::next(LogEntryView& view)
+{
+    while(remaining == 0)
+    {
+        if(pos >= data.size())
+        {
+            return false;
+        }
+        readHeader();
+    }
+    --remaining;
+
+    lastId += unzigzag(readVarint());
+    lastTimestampUs += unzigzag(readVarint());
+    view.id = static_cast<int>(lastId);
+    view.timestampUs = lastTimestampUs;
+
+    const uint64_t prefix = readVarint();
+    if(prefix > timestamp.size())
+    {
+        throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+    }
+    const std::string_view suffix = readBytes();
+    timestamp.resize(static_cast<size_t>(prefix));
+    timestamp.append(suffix.data(), suffix.size());
+    view.timestamp = timestamp;
+
+    view.level = readRef();
+    view.message = readBytes();
+    view.function = readRef();
+    view.file = readRef();
+    view.line = static_cast<int>(unzigzag(readVarint()));
+    view.threadId = readRef();
+
+    if(flags & LOG_BINARY_FLAG_SOURCE)
+    {
+        view.sourceId = static_cast<int>(unzigzag(readVarint()));
+        view.sourceUuid = readRef();
+        view.sourceName = readRef();
+    }
+    else
+    {
+        view.sourceId = 0;
+        view.sourceUuid = std::string_view();
+        view.sourceName = std::string_view();
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a block header and its dictionary.
+ */
+void LogSerializer::Binary::Reader::readHeader()
+{
+    if(data.size() - pos < LOG_BINARY_MAGIC_SIZE + 2
+            || std::memcmp(data.data() + pos, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) != 0)
+    {
+        throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+    }
+    pos += LOG_BINARY_MAGIC_SIZE;
+
+    const uint8_t version = static_cast<uint8_t>(data[pos++]);
+    if(version == 0 || version > LOG_BINARY_VERSION)
+    {
+        throw std::runtime_error(ERR_MSG_BINARY_VERSION + std::to_string(version));
+    }
+    flags = static_cast<uint8_t>(data[pos++]);
+
+    remaining = readVarint();
+    const uint64_t dictionarySize = readVarint();
+    if(dictionarySize > data.size() - pos)
+    {
+        throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+    }
+    dictionary.clear();
+    dictionary.reserve(static_cast<size_t>(dictionarySize));
+    for(uint64_t i = 0; i < dictionarySize; ++i)
+    {
+        dictionary.push_back(readBytes());
+    }
+
+    // Deltas restart with every block
+    timestamp.clear();
+    lastId = 0;
+    lastTimestampUs = 0;
+}
+
+/**
+ * @brief Reads a varint.
+ * @return uint64_t Value.
+ */
+uint64_t LogSerializer::Binary::Reader::readVarint()
+{
+    uint64_t value = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        if(pos >= data.size())
+        {
+            throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+        }
+        const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+}
+
+/**
+ * @brief Reads a length-prefixed string.
+ * @return std::string_view View into the data.
+ */
+std::string_view LogSerializer::Binary::Reader::readBytes()
+{
+    const uint64_t size = readVarint();
+    if(size > data.size() - pos)
+    {
+        throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+    }
+    const std::string_view value = data.substr(pos, static_cast<size_t>(size));
+    pos += static_cast<size_t>(size);
+    return value;
+}
+
+/**
+ * @brief Reads a dictionary index.
+ * @return std::string_view Dictionary string.
+ */
+std::string_view LogSerializer::Binary::Reader::readRef()
+{
+    const uint64_t index = readVarint();
+    if(index >= dictionary.size())
+    {
+        throw std::runtime_error(ERR_MSG_BINARY_CORRUPT);
+    }
+    return dictionary[static_cast<size_t>(index)];
+}
+
+/**
+ * @brief Appends one block with the given entries.
+ * @param out Buffer to append to.
+ * @param entries Entries to encode.
+ * @param count Number of entries.
+ */
+void LogSerializer::Binary::appendLogs(std::string& out, const LogEntry* entries, const size_t count)
+{
+    std::vector<std::string_view> dictionary;
+    std::unordered_map<std::string_view, uint64_t> indexes;
+    auto ref = [ & ](std::string_view value)
+    {
+        auto [it, added] = indexes.try_emplace(value, dictionary.size());
+        if(added)
+        {
+            dictionary.push_back(value);
+        }
+        return it->second;
+    };
+
+    std::string body;
+    body.reserve(count * 64);
+    int64_t lastId = 0;
+    int64_t lastTimestampUs = 0;
+    std::string_view lastTimestamp;
+    for(size_t i = 0; i < count; ++i)
+    {
+        const LogEntry& entry = entries[i];
+        appendVarint(body, zigzag(entry.id - lastId));
+        appendVarint(body, zigzag(entry.timestampUs - lastTimestampUs));
+        lastId = entry.id;
+        lastTimestampUs = entry.timestampUs;
+
+        // Front coding: length shared with the previous timestamp, then the rest
+        size_t prefix = 0;
+        const size_t limit = std::min(lastTimestamp.size(), entry.timestamp.size());
+        while(prefix < limit && lastTimestamp[prefix] == entry.timestamp[prefix])
+        {
+            ++prefix;
+        }
+        appendVarint(body, prefix);
+        appendBytes(body, std::string_view(entry.timestamp).substr(prefix));
+        lastTimestamp = entry.timestamp;
+
+        appendVarint(body, ref(entry.level));
+        appendBytes(body, entry.message);
+        appendVarint(body, ref(entry.function));
+        appendVarint(body, ref(entry.file));
+        appendVarint(body, zigzag(entry.line));
+        appendVarint(body, ref(entry.threadId));
+#ifdef SQLG_USE_SOURCE_INFO
+        appendVarint(body, zigzag(entry.sourceId));
+        appendVarint(body, ref(entry.sourceUuid));
+        appendVarint(body, ref(entry.sourceName));
+#endif
+    }
+
+    out.append(LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE);
+    out += static_cast<char>(LOG_BINARY_VERSION);
+#ifdef SQLG_USE_SOURCE_INFO
+    out += static_cast<char>(LOG_BINARY_FLAG_SOURCE);
+#else
+    out += static_cast<char>(0);
+#endif
+    appendVarint(out, count);
+    appendVarint(out, dictionary.size());
+    for(const auto & value : dictionary)
+    {
+        appendBytes(out, value);
+    }
+    out += body;
+}
+
+/**
+ * @brief Encodes entries into one block.
+ * @param entries Entries to encode.
+ * @return std::string Encoded block.
+ */
+std::string LogSerializer::Binary::serializeLogs(const LogEntryList& entries)
+{
+    std::string result;
+    appendLogs(result, entries.data(), entries.size());
+    return result;
+}
+
+/**
+ * @brief Visits every entry of the encoded blocks without copying strings.
+ * @param data Encoded blocks.
+ * @param callback Called for each entry; return false to stop.
+ * @return size_t Number of entries passed to the callback.
+ * @throws std::runtime_error If the data is corrupt.
+ */
+size_t LogSerializer::Binary::parseLogs(std::string_view data, const std::function<bool(const LogEntryView&)> & callback)
+{
+    Reader reader(data);
+    LogEntryView view;
+    size_t count = 0;
+    while(reader.next(view))
+    {
+        ++count;
+        if(!callback(view))
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Decodes the encoded blocks into entries.
+ * @param data Encoded blocks.
+ * @return LogEntryList Entries.
+ * @throws std::runtime_error If the data is corrupt.
+ */
+LogEntryList LogSerializer::Binary::parseLogs(std::string_view data)
+{
+    LogEntryList entries;
+    parseLogs(data, [ & entries](const LogEntryView & view)
+    {
+        entries.push_back(view.toEntry());
+        return true;
+    });
+    return entries;
+}
+
+/**
+ * @brief Checks if data starts with a binary block.
+ * @param data Data to check.
+ * @return bool True if the magic matches.
+ */
+bool LogSerializer::Binary::isBinary(std::string_view data)
+{
+    return data.size() >= LOG_BINARY_MAGIC_SIZE
+           && std::memcmp(data.data(), LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) == 0;
+}
@@ -0,0 +1,293 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <stdexcept>
+#include "sqlogger/internal/log_cipher.h"
+#include "sqlogger/internal/log_strings.h"
+
+#ifdef SQLG_USE_AES
+    #include <openssl/evp.h>
+    #include <openssl/rand.h>
+#endif
+
+namespace
+{
+    std::atomic<uint64_t> nextInstanceId{ 1 }; /**< Ids of LogCipher instances (0 = none). */
+
+#ifdef SQLG_USE_AES
+    /**
+     * @struct ThreadContext
+     * @brief Cipher context of one thread, keyed once for the instance that last used it.
+     */
+    struct ThreadContext
+    {
+        ~ThreadContext()
+        {
+            if(ctx)
+            {
+                EVP_CIPHER_CTX_free(ctx);
+            }
+        }
+
+        /**
+         * @brief Gets the context with the key of an instance set.
+         * @param owner Instance id.
+         * @param key AES-256 key of the instance.
+         * @param encrypt True for encryption, false for decryption.
+         * @return EVP_CIPHER_CTX* Context ready for a nonce.
+         * @throws std::runtime_error If the context could not be created or keyed.
+         */
+        EVP_CIPHER_CTX* get(const uint64_t owner, const unsigned char* key, const bool encrypt)
+        {
+            if(ctx && this->owner == owner)
+            {
+                return ctx;
+            }
+
+            if(!ctx)
+            {
+                ctx = EVP_CIPHER_CTX_new();
+                if(!ctx) throw std::runtime_error(ERR_MSG_CRYPTO_EVPCON_FAILED);
+            }
+
+            const int keyed = encrypt
+                              ? EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key, nullptr)
+                              : EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key, nullptr);
+            if(keyed != 1)
+            {
+                this->owner = 0;
+                throw std::runtime_error(encrypt ? ERR_MSG_CRYPTO_ENC_INIT_FAILED : ERR_MSG_CRYPTO_DEC_INIT_FAILED);
+            }
+            this->owner = owner;
+            return ctx;
+        }
+
+        EVP_CIPHER_CTX* ctx = nullptr; /**< OpenSSL context. */
+        uint64_t owner = 0; /**< Instance whose key is set. */
+    };
+
+    thread_local ThreadContext encryptContext; /**< Encryption context of the thread. */
+    thread_local ThreadContext decryptContext; /**< Decryption context of the thread. */
+#endif
+}
+
+/**
+ * @brief Constructs a cipher.
+ * @param passKey Secret the 256-bit key is derived from (SHA-256).
+ * @throws std::runtime_error If passKey is empty or AES support is not compiled in.
+ */
+LogCipher::LogCipher(const std::string& passKey)
+    : instanceId(nextInstanceId.fetch_add(1, std::memory_order_relaxed))
+{
+    if(passKey.empty())
+    {
+        throw std::runtime_error(ERR_MSG_PASSKEY_EMPTY);
+    }
+
+#ifdef SQLG_USE_AES
+    const std::string material = std::string(LOG_CIPHER_KEY_CONTEXT) + passKey;
+    unsigned int size = 0;
+    if(EVP_Digest(material.data(), material.size(), key.data(), & size, EVP_sha256(), nullptr) != 1
+            || size != key.size())
+    {
+        throw std::runtime_error(ERR_MSG_CRYPTO_KEY_FAILED);
+    }
+
+    if(RAND_bytes(nonceBase.data(), static_cast<int>(nonceBase.size())) != 1)
+    {
+        throw std::runtime_error(ERR_MSG_CRYPTO_RAND_FAILED);
+    }
+#else
+    throw std::runtime_error(ERR_MSG_CIPHER_NOT_SUPPORTED);
+#endif
+}
+
+/**
+ * @brief Checks if the library was built with AES support (SQLG_USE_AES).
+ * @return bool True if LogCipher can be constructed.
+ */
+bool LogCipher::isSupported()
+{
+#ifdef SQLG_USE_AES
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Encrypts a message with a fresh nonce.
+ * @param plaintext Message text.
+ * @return std::string Prefixed, base64 encoded nonce, ciphertext and tag.
+ * @throws std::runtime_error If the cipher fails.
+ */
+std::string LogCipher::encrypt(const std::string_view plaintext)
+{
+#ifdef SQLG_USE_AES
+    EVP_CIPHER_CTX* ctx = encryptContext.get(instanceId, key.data(), true);
+
+    std::string raw(LOG_CIPHER_IV_SIZE + plaintext.size() + LOG_CIPHER_TAG_SIZE, '\0');
+    unsigned char* nonce = reinterpret_cast<unsigned char*>(raw.data());
+    unsigned char* body = nonce + LOG_CIPHER_IV_SIZE;
+    nextNonce(nonce);
+
+    int len = 0;
+    int total = 0;
+    if(EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce) != 1)
+    {
+        encryptContext.owner = 0;
+        throw std::runtime_error(ERR_MSG_CRYPTO_ENC_INIT_FAILED);
+    }
+    if(EVP_EncryptUpdate(ctx, body, & len,
+                         reinterpret_cast<const unsigned char*>(plaintext.data()), static_cast<int>(plaintext.size())) != 1)
+    {
+        encryptContext.owner = 0;
+        throw std::runtime_error(ERR_MSG_CRYPTO_ENC_UPDATE_FAILED);
+    }
+    total = len;
+    if(EVP_EncryptFinal_ex(ctx, body + total, & len) != 1
+            || EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, LOG_CIPHER_TAG_SIZE, body + plaintext.size()) != 1)
+    {
+        encryptContext.owner = 0;
+        throw std::runtime_error(ERR_MSG_CRYPTO_ENC_FINAL_FAILED);
+    }
+
+    const size_t prefixSize = sizeof(LOG_CIPHER_PREFIX) - 1;
+    std::string result(prefixSize + 4 * ((raw.size() + 2) / 3) + 1, '\0');
+    result.replace(0, prefixSize, LOG_CIPHER_PREFIX);
+    const int encoded = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(result.data() + prefixSize),
+                                        reinterpret_cast<const unsigned char*>(raw.data()), static_cast<int>(raw.size()));
+    result.resize(prefixSize + static_cast<size_t>(encoded));
+    return result;
+#else
+    (void)plaintext;
+    throw std::runtime_error(ERR_MSG_CIPHER_NOT_SUPPORTED);
+#endif
+}
+
+/**
+ * @brief Decrypts a value produced by encrypt().
+ * Values without the cipher prefix (written before encryption was enabled) are returned as is.
+ * @param value Stored message.
+ * @return std::optional<std::string> Message, or std::nullopt if the value is damaged or the key is wrong.
+ */
+std::optional<std::string> LogCipher::decrypt(const std::string& value) const
+{
+    if(!isEncrypted(value))
+    {
+        return value;
+    }
+
+#ifdef SQLG_USE_AES
+    const size_t prefixSize = sizeof(LOG_CIPHER_PREFIX) - 1;
+    const size_t encodedSize = value.size() - prefixSize;
+    if(encodedSize == 0 || encodedSize % 4 != 0)
+    {
+        return std::nullopt;
+    }
+
+    std::string raw(encodedSize / 4 * 3, '\0');
+    const int decoded = EVP_DecodeBlock(reinterpret_cast<unsigned char*>(raw.data()),
+                                        reinterpret_cast<const unsigned char*>(value.data() + prefixSize),
+                                        static_cast<int>(encodedSize));
+    if(decoded < 0)
+    {
+        return std::nullopt;
+    }
+
+    // EVP_DecodeBlock counts the padding as zero bytes
+    size_t rawSize = static_cast<size_t>(decoded);
+    if(value.back() == '=') --rawSize;
+    if(value[value.size() - 2] == '=') --rawSize;
+    if(rawSize < LOG_CIPHER_IV_SIZE + LOG_CIPHER_TAG_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    const unsigned char* nonce = reinterpret_cast<const unsigned char*>(raw.data());
+    const unsigned char* body = nonce + LOG_CIPHER_IV_SIZE;
+    const size_t bodySize = rawSize - LOG_CIPHER_IV_SIZE - LOG_CIPHER_TAG_SIZE;
+    unsigned char* tag = reinterpret_cast<unsigned char*>(raw.data()) + LOG_CIPHER_IV_SIZE + bodySize;
+
+    try
+    {
+        EVP_CIPHER_CTX* ctx = decryptContext.get(instanceId, key.data(), false);
+
+        std::string plaintext(bodySize, '\0');
+        int len = 0;
+        int total = 0;
+        if(EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce) != 1
+                || EVP_DecryptUpdate(ctx, reinterpret_cast<unsigned char*>(plaintext.data()), & len,
+                                     body, static_cast<int>(bodySize)) != 1)
+        {
+            decryptContext.owner = 0;
+            return std::nullopt;
+        }
+        total = len;
+        if(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, LOG_CIPHER_TAG_SIZE, tag) != 1
+                || EVP_DecryptFinal_ex(ctx, reinterpret_cast<unsigned char*>(plaintext.data()) + total, & len) != 1)
+        {
+            // Wrong key or modified value
+            return std::nullopt;
+        }
+        plaintext.resize(static_cast<size_t>(total + len));
+        return plaintext;
+    }
+    catch(const std::exception&)
+    {
+        return std::nullopt;
+    }
+#else
+    return std::nullopt;
+#endif
+}
+
+/**
+ * @brief Encrypts the messages of a batch.
+ * @param entries Entries to write.
+ * @return LogEntryList Copy of the entries with encrypted messages.
+ * @throws std::runtime_error If the cipher fails.
+ */
+LogEntryList LogCipher::encryptMessages(const LogEntryList& entries)
+{
+    LogEntryList encrypted = entries;
+    for(LogEntry& entry : encrypted)
+    {
+        entry.message = encrypt(entry.message);
+    }
+    return encrypted;
+}
+
+/**
+ * @brief Gets the next nonce (random base XOR a counter, never repeated by this instance).
+ * @param nonce Output buffer of LOG_CIPHER_IV_SIZE bytes.
+ */
+void LogCipher::nextNonce(unsigned char* nonce)
+{
+    uint64_t counter = nonceCounter.fetch_add(1, std::memory_order_relaxed);
+    for(size_t i = 0; i < LOG_CIPHER_IV_SIZE; ++i)
+    {
+        nonce[i] = nonceBase[i];
+    }
+    for(size_t i = 0; i < sizeof(counter); ++i)
+    {
+        nonce[LOG_CIPHER_IV_SIZE - 1 - i] ^= static_cast<unsigned char>(counter & 0xFF);
+        counter >>= 8;
+    }
+}
@@ -0,0 +1,409 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "sqlogger/internal/log_columnar.h"
+#include "sqlogger/internal/log_strings.h"
+
+#ifdef SQLG_USE_ARROW
+    #include <arrow/api.h>
+    #include <arrow/io/file.h>
+    #include <arrow/ipc/writer.h>
+    #include <arrow/util/compression.h>
+    #include <parquet/arrow/writer.h>
+    #include <parquet/properties.h>
+
+/**
+ * @brief Throws if an Arrow call failed.
+ * @param status Result of the call.
+ * @throws std::runtime_error With the Arrow error message.
+ */
+static void check(const arrow::Status& status)
+{
+    if(!status.ok())
+    {
+        throw std::runtime_error(ERR_MSG_COLUMNAR_EXPORT_FAILED + status.ToString());
+    }
+}
+
+/**
+ * @brief Gets the value of an Arrow result.
+ * @tparam T Value type.
+ * @param result Result of the call.
+ * @return T Value.
+ * @throws std::runtime_error With the Arrow error message.
+ */
+template<typename T>
+static T unwrap(arrow::Result<T> result)
+{
+    check(result.status());
+    return std::move(result).ValueUnsafe();
+}
+
+/**
+ * @brief Finishes a builder.
+ * @param builder Builder of a column.
+ * @return std::shared_ptr<arrow::Array> Built array (the builder is reset).
+ */
+static std::shared_ptr<arrow::Array> finish(arrow::ArrayBuilder& builder)
+{
+    std::shared_ptr<arrow::Array> array;
+    check(builder.Finish( & array));
+    return array;
+}
+
+/**
+ * @brief Maps a codec to the Arrow codec.
+ * @param compression Codec.
+ * @return arrow::Compression::type Arrow codec.
+ */
+static arrow::Compression::type toArrowCodec(const LogCompress::Compression& compression)
+{
+    switch(compression)
+    {
+        case LogCompress::Compression::Gzip:
+            return arrow::Compression::GZIP;
+        case LogCompress::Compression::Zstd:
+            return arrow::Compression::ZSTD;
+        case LogCompress::Compression::None:
+        default:
+            return arrow::Compression::UNCOMPRESSED;
+    }
+}
+
+/**
+ * @class DictionaryColumn
+ * @brief Dictionary encoded column with one dictionary for the whole file.
+ */
+class DictionaryColumn
+{
+    public:
+        /**
+         * @brief Appends a value.
+         * @param value Column value.
+         */
+        void append(const std::string& value)
+        {
+            auto it = ids.find(value);
+            if(it == ids.end())
+            {
+                it = ids.emplace(value, static_cast<int32_t>(values.size())).first;
+                values.push_back(value);
+                dictionary.reset();
+            }
+            indices.UnsafeAppend(it->second);
+        }
+
+        /**
+         * @brief Reserves space for the values of a batch.
+         * @param rows Rows of the batch.
+         */
+        void reserve(const int64_t rows)
+        {
+            check(indices.Reserve(rows));
+        }
+
+        /**
+         * @brief Builds the column of the appended values.
+         * The dictionary array is rebuilt only when values were added, so unchanged
+         * dictionaries are not written again.
+         * @return std::shared_ptr<arrow::Array> Dictionary array.
+         */
+        std::shared_ptr<arrow::Array> finish()
+        {
+            if(!dictionary)
+            {
+                arrow::StringBuilder builder;
+                check(builder.AppendValues(values));
+                dictionary = ::finish(builder);
+            }
+            return unwrap(arrow::DictionaryArray::FromArrays(type(), ::finish(indices), dictionary));
+        }
+
+        /**
+         * @brief Gets the Arrow type of dictionary encoded strings.
+         * @return std::shared_ptr<arrow::DataType> dictionary<int32, utf8>.
+         */
+        static std::shared_ptr<arrow::DataType> type()
+        {
+            return arrow::dictionary(arrow::int32(), arrow::utf8());
+        }
+
+    private:
+        std::unordered_map<std::string, int32_t> ids; /**< Value -> index. */
+        std::vector<std::string> values; /**< Values in index order. */
+        std::shared_ptr<arrow::Array> dictionary; /**< Built dictionary (nullptr = values were added). */
+        arrow::Int32Builder indices; /**< Indices of the current batch. */
+};
+#endif
+
+/**
+ * @struct LogColumnarWriter::State
+ * @brief Arrow objects of an open file.
+ */
+struct LogColumnarWriter::State
+{
+#ifdef SQLG_USE_ARROW
+    /**
+     * @brief Converts entries to a record batch.
+     * @param entries The log entries.
+     * @return std::shared_ptr<arrow::RecordBatch> Batch matching schema.
+     */
+    std::shared_ptr<arrow::RecordBatch> toBatch(const LogEntryList& entries)
+    {
+        const int64_t rows = static_cast<int64_t>(entries.size());
+        arrow::Int64Builder ids;
+        arrow::StringBuilder timestamps;
+        arrow::StringBuilder messages;
+        arrow::Int32Builder lines;
+        check(ids.Reserve(rows));
+        check(lines.Reserve(rows));
+        level.reserve(rows);
+        function.reserve(rows);
+        file.reserve(rows);
+        threadId.reserve(rows);
+#ifdef SQLG_USE_SOURCE_INFO
+        arrow::Int32Builder sourceIds;
+        check(sourceIds.Reserve(rows));
+        sourceUuid.reserve(rows);
+        sourceName.reserve(rows);
+#endif
+
+        for(const auto & entry : entries)
+        {
+            ids.UnsafeAppend(entry.id);
+            check(timestamps.Append(entry.timestamp));
+            level.append(entry.level);
+            check(messages.Append(entry.message));
+            function.append(entry.function);
+            file.append(entry.file);
+            lines.UnsafeAppend(entry.line);
+            threadId.append(entry.threadId);
+#ifdef SQLG_USE_SOURCE_INFO
+            sourceIds.UnsafeAppend(entry.sourceId);
+            sourceUuid.append(entry.sourceUuid);
+            sourceName.append(entry.sourceName);
+#endif
+        }
+
+        return arrow::RecordBatch::Make(schema, rows,
+        {
+            ::finish(ids),
+            ::finish(timestamps),
+            level.finish(),
+            ::finish(messages),
+            function.finish(),
+            file.finish(),
+            ::finish(lines),
+            threadId.finish()
+#ifdef SQLG_USE_SOURCE_INFO
+            , ::finish(sourceIds)
+            , sourceUuid.finish()
+            , sourceName.finish()
+#endif
+        });
+    }
+
+    std::shared_ptr<arrow::Schema> schema; /**< Columns of the file. */
+    std::shared_ptr<arrow::io::FileOutputStream> output; /**< Output file. */
+    std::unique_ptr<parquet::arrow::FileWriter> parquet; /**< Parquet writer (nullptr for Arrow IPC). */
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> ipc; /**< Arrow IPC writer (nullptr for Parquet). */
+    DictionaryColumn level; /**< Level column. */
+    DictionaryColumn function; /**< Function column. */
+    DictionaryColumn file; /**< File column. */
+    DictionaryColumn threadId; /**< Thread ID column. */
+#ifdef SQLG_USE_SOURCE_INFO
+    DictionaryColumn sourceUuid; /**< Source UUID column. */
+    DictionaryColumn sourceName; /**< Source name column. */
+#endif
+#endif
+    bool closed = false; /**< Set by close(). */
+};
+
+/**
+ * @brief Creates the output file and writes the schema.
+ * @param filePath The path to the output file (its directory must exist).
+ * @param format LogExport::Format::PARQUET or LogExport::Format::ARROW.
+ * @param compression Codec of the Parquet pages / Arrow IPC buffers.
+ * @param useThreads Encode and compress columns on Arrow's thread pool.
+ * @throws std::runtime_error If the format or codec is not supported or the file cannot be created.
+ */
+LogColumnarWriter::LogColumnarWriter(const std::string& filePath,
+                                     const LogExport::Format& format,
+                                     const LogCompress::Compression& compression,
+                                     const bool useThreads)
+    : state(std::make_unique<State>())
+{
+    if(!isSupported(format, LogCompress::Compression::None))
+    {
+        throw std::runtime_error(ERR_MSG_EXPORT_FMT_NOT_SUPPORTED + LogExport::formatToString(format));
+    }
+    if(!isSupported(format, compression))
+    {
+        throw std::runtime_error(ERR_MSG_COMPRESSION_NOT_SUPPORTED + LogCompress::extension(compression));
+    }
+
+#ifdef SQLG_USE_ARROW
+    state->schema = arrow::schema(
+    {
+        arrow::field(EXP_FIELD_ID, arrow::int64(), false),
+        arrow::field(EXP_FIELD_TIMESTAMP, arrow::utf8(), false),
+        arrow::field(EXP_FIELD_LEVEL, DictionaryColumn::type(), false),
+        arrow::field(EXP_FIELD_MESSAGE, arrow::utf8(), false),
+        arrow::field(EXP_FIELD_FUNCTION, DictionaryColumn::type(), false),
+        arrow::field(EXP_FIELD_FILE, DictionaryColumn::type(), false),
+        arrow::field(EXP_FIELD_LINE, arrow::int32(), false),
+        arrow::field(EXP_FIELD_THREAD_ID, DictionaryColumn::type(), false)
+#ifdef SQLG_USE_SOURCE_INFO
+        , arrow::field(EXP_FIELD_SOURCE_ID, arrow::int32(), false)
+        , arrow::field(EXP_FIELD_SOURCE_UUID, DictionaryColumn::type(), false)
+        , arrow::field(EXP_FIELD_SOURCE_NAME, DictionaryColumn::type(), false)
+#endif
+    });
+
+    state->output = unwrap(arrow::io::FileOutputStream::Open(filePath));
+    const arrow::Compression::type codec = toArrowCodec(compression);
+    if(format == LogExport::Format::PARQUET)
+    {
+        parquet::WriterProperties::Builder properties;
+        properties.compression(codec);
+        properties.max_row_group_length(LOG_COLUMNAR_ROW_GROUP_SIZE);
+        parquet::ArrowWriterProperties::Builder arrowProperties;
+        arrowProperties.store_schema(); // readers get the dictionary types back
+        arrowProperties.set_use_threads(useThreads);
+        state->parquet = unwrap(parquet::arrow::FileWriter::Open( * state->schema,
+                                arrow::default_memory_pool(),
+                                state->output,
+                                properties.build(),
+                                arrowProperties.build()));
+    }
+    else
+    {
+        arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+        options.emit_dictionary_deltas = true;
+        options.use_threads = useThreads;
+        if(codec != arrow::Compression::UNCOMPRESSED)
+        {
+            options.codec = unwrap(arrow::util::Codec::Create(codec));
+        }
+        state->ipc = unwrap(arrow::ipc::MakeFileWriter(state->output, state->schema, options));
+    }
+#else
+    (void)filePath;
+    (void)useThreads;
+#endif
+}
+
+/**
+ * @brief Closes the file, discarding errors (call close() to see them).
+ */
+LogColumnarWriter::~LogColumnarWriter()
+{
+    try
+    {
+        close();
+    }
+    catch(...)
+    {
+    }
+}
+
+/**
+ * @brief Checks if a columnar format and codec were compiled in.
+ * @param format Output format.
+ * @param compression Codec (Arrow IPC supports None and Zstd).
+ * @return bool True if the writer can be constructed with them.
+ */
+bool LogColumnarWriter::isSupported(const LogExport::Format& format, const LogCompress::Compression& compression)
+{
+#ifdef SQLG_USE_ARROW
+    if(!LogExport::isColumnar(format))
+    {
+        return false;
+    }
+
+    const arrow::Compression::type codec = toArrowCodec(compression);
+    if(format == LogExport::Format::ARROW && codec == arrow::Compression::GZIP)
+    {
+        return false;
+    }
+    return arrow::util::Codec::IsAvailable(codec);
+#else
+    (void)format;
+    (void)compression;
+    return false;
+#endif
+}
+
+/**
+ * @brief Writes entries as one record batch.
+ * @param entries The log entries.
+ * @throws std::runtime_error If the batch could not be written.
+ */
+void LogColumnarWriter::write(const LogEntryList& entries)
+{
+#ifdef SQLG_USE_ARROW
+    if(entries.empty() || state->closed)
+    {
+        return;
+    }
+
+    const std::shared_ptr<arrow::RecordBatch> batch = state->toBatch(entries);
+    if(state->parquet)
+    {
+        check(state->parquet->WriteRecordBatch( * batch));
+    }
+    else
+    {
+        check(state->ipc->WriteRecordBatch( * batch));
+    }
+#else
+    (void)entries;
+#endif
+}
+
+/**
+ * @brief Writes the file footer and closes the file.
+ * @throws std::runtime_error If writing failed.
+ */
+void LogColumnarWriter::close()
+{
+    if(state->closed)
+    {
+        return;
+    }
+    state->closed = true;
+
+#ifdef SQLG_USE_ARROW
+    if(state->parquet)
+    {
+        check(state->parquet->Close());
+    }
+    if(state->ipc)
+    {
+        check(state->ipc->Close());
+    }
+    if(state->output)
+    {
+        check(state->output->Close());
+    }
+#endif
+}
@@ -0,0 +1,281 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include "sqlogger/internal/log_compress.h"
+
+#ifdef SQLG_USE_ZLIB
+    #include <zlib.h>
+#endif
+
+#ifdef SQLG_USE_ZSTD
+    #include <zstd.h>
+#endif
+
+/**
+* @brief Gets the codec name for error messages.
+* @param compression Codec.
+* @return const char* Codec name.
+*/
+static const char* compressionName(const LogCompress::Compression& compression)
+{
+    switch(compression)
+    {
+        case LogCompress::Compression::Gzip:
+            return "gzip";
+        case LogCompress::Compression::Zstd:
+            return "zstd";
+        default:
+            return "none";
+    }
+}
+
+#ifdef SQLG_USE_ZLIB
+/**
+* @brief Compresses data into one gzip member.
+* @param data Data to compress.
+* @param level Compression level.
+* @return std::string Compressed data.
+*/
+static std::string gzipCompress(const std::string& data, const int level)
+{
+    z_stream stream{};
+    // 15 + 16: maximum window with a gzip header and trailer
+    if(deflateInit2( & stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw std::runtime_error(std::string(ERR_MSG_COMPRESSION_FAILED) + "gzip");
+    }
+
+    std::string result(deflateBound( & stream, static_cast<uLong>(data.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    const int status = deflate( & stream, Z_FINISH);
+    const size_t size = stream.total_out;
+    deflateEnd( & stream);
+    if(status != Z_STREAM_END)
+    {
+        throw std::runtime_error(std::string(ERR_MSG_COMPRESSION_FAILED) + "gzip");
+    }
+
+    result.resize(size);
+    return result;
+}
+
+/**
+* @brief Decompresses concatenated gzip members.
+* @param data Compressed data.
+* @return std::string Decompressed data.
+*/
+static std::string gzipDecompress(const std::string& data)
+{
+    z_stream stream{};
+    // 15 + 32: maximum window, detect the gzip/zlib header
+    if(inflateInit2( & stream, 15 + 32) != Z_OK)
+    {
+        throw std::runtime_error(std::string(ERR_MSG_DECOMPRESSION_FAILED) + "gzip");
+    }
+
+    std::string result;
+    char buffer[1 << 16];
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+
+    int status = Z_OK;
+    do
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        status = inflate( & stream, Z_NO_FLUSH);
+        if(status != Z_OK && status != Z_STREAM_END)
+        {
+            break;
+        }
+        result.append(buffer, sizeof(buffer) - stream.avail_out);
+        if(status == Z_STREAM_END && stream.avail_in > 0)
+        {
+            inflateReset( & stream); // next member
+        }
+    }
+    // Stop at the end of the input unless the output buffer filled up
+    while(stream.avail_in > 0 || (status == Z_OK && stream.avail_out == 0));
+    inflateEnd( & stream);
+
+    if(status != Z_STREAM_END)
+    {
+        throw std::runtime_error(std::string(ERR_MSG_DECOMPRESSION_FAILED) + "gzip");
+    }
+    return result;
+}
+#endif
+
+#ifdef SQLG_USE_ZSTD
+/**
+* @brief Compresses data into one zstd frame.
+* @param data Data to compress.
+* @param level Compression level.
+* @return std::string Compressed data.
+*/
+static std::string zstdCompress(const std::string& data, const int level)
+{
+    std::string result(ZSTD_compressBound(data.size()), '\0');
+    const size_t size = ZSTD_compress(result.data(), result.size(), data.data(), data.size(), level);
+    if(ZSTD_isError(size))
+    {
+        throw std::runtime_error(std::string(ERR_MSG_COMPRESSION_FAILED) + ZSTD_getErrorName(size));
+    }
+    result.resize(size);
+    return result;
+}
+
+/**
+* @brief Decompresses concatenated zstd frames.
+* @param data Compressed data.
+* @return std::string Decompressed data.
+*/
+static std::string zstdDecompress(const std::string& data)
+{
+    ZSTD_DStream* stream = ZSTD_createDStream();
+    if(stream == nullptr)
+    {
+        throw std::runtime_error(std::string(ERR_MSG_DECOMPRESSION_FAILED) + "zstd");
+    }
+
+    std::string result;
+    std::string buffer(ZSTD_DStreamOutSize(), '\0');
+    ZSTD_inBuffer input{ data.data(), data.size(), 0 };
+    size_t status = 0;
+    while(input.pos < input.size)
+    {
+        ZSTD_outBuffer output{ buffer.data(), buffer.size(), 0 };
+        status = ZSTD_decompressStream(stream, & output, & input);
+        if(ZSTD_isError(status))
+        {
+            ZSTD_freeDStream(stream);
+            throw std::runtime_error(std::string(ERR_MSG_DECOMPRESSION_FAILED) + ZSTD_getErrorName(status));
+        }
+        result.append(buffer.data(), output.pos);
+    }
+    ZSTD_freeDStream(stream);
+
+    if(status != 0)
+    {
+        throw std::runtime_error(std::string(ERR_MSG_DECOMPRESSION_FAILED) + "zstd: truncated frame");
+    }
+    return result;
+}
+#endif
+
+/**
+* @brief Checks if a codec was compiled in.
+* @param compression Codec.
+* @return bool True if compress() and decompress() support the codec.
+*/
+bool LogCompress::isSupported(const Compression& compression)
+{
+    switch(compression)
+    {
+        case Compression::None:
+            return true;
+#ifdef SQLG_USE_ZLIB
+        case Compression::Gzip:
+            return true;
+#endif
+#ifdef SQLG_USE_ZSTD
+        case Compression::Zstd:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+* @brief Gets the file extension of a codec.
+* @param compression Codec.
+* @return std::string Extension with the leading dot, empty for Compression::None.
+*/
+std::string LogCompress::extension(const Compression& compression)
+{
+    switch(compression)
+    {
+        case Compression::Gzip:
+            return LOG_COMPRESS_EXT_GZIP;
+        case Compression::Zstd:
+            return LOG_COMPRESS_EXT_ZSTD;
+        default:
+            return "";
+    }
+}
+
+/**
+* @brief Compresses data into one gzip member or zstd frame.
+* @param data Data to compress.
+* @param compression Codec (Compression::None returns the data unchanged).
+* @param level Compression level, 0 for the codec default.
+* @return std::string Compressed data.
+* @throws std::runtime_error If the codec is not supported or compression failed.
+*/
+std::string LogCompress::compress(const std::string& data, const Compression& compression, const int level)
+{
+    (void)level; // unused when no codec is compiled in
+    switch(compression)
+    {
+        case Compression::None:
+            return data;
+#ifdef SQLG_USE_ZLIB
+        case Compression::Gzip:
+            return gzipCompress(data, level > 0 ? level : LOG_COMPRESS_GZIP_LEVEL);
+#endif
+#ifdef SQLG_USE_ZSTD
+        case Compression::Zstd:
+            return zstdCompress(data, level > 0 ? level : LOG_COMPRESS_ZSTD_LEVEL);
+#endif
+        default:
+            throw std::runtime_error(std::string(ERR_MSG_COMPRESSION_NOT_SUPPORTED) + compressionName(compression));
+    }
+}
+
+/**
+* @brief Decompresses data made of one or more concatenated gzip members or zstd frames.
+* @param data Compressed data.
+* @param compression Codec (Compression::None returns the data unchanged).
+* @return std::string Decompressed data.
+* @throws std::runtime_error If the codec is not supported or the data is corrupt.
+*/
+std::string LogCompress::decompress(const std::string& data, const Compression& compression)
+{
+    switch(compression)
+    {
+        case Compression::None:
+            return data;
+#ifdef SQLG_USE_ZLIB
+        case Compression::Gzip:
+            return gzipDecompress(data);
+#endif
+#ifdef SQLG_USE_ZSTD
+        case Compression::Zstd:
+            return zstdDecompress(data);
+#endif
+        default:
+            throw std::runtime_error(std::string(ERR_MSG_COMPRESSION_NOT_SUPPORTED) + compressionName(compression));
+    }
+}
@@ -0,0 +1,207 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <algorithm>
+#include "sqlogger/internal/log_dictionary.h"
+#include "sqlogger/database/database_schema.h"
+#include "sqlogger/database/query_builder.h"
+
+/**
+ * @brief Creates the dictionary table if it does not exist.
+ * @param database Connection to use.
+ */
+void LogDictionary::createTable(IDatabase& database)
+{
+    auto table = DatabaseSchema::createTableBuilder(tableName)
+                 .addStandardField<FieldType::Int64>(FIELD_DICT_ID, true, false, true) // PRIMARY AUTOINCREMENT KEY
+                 .addStandardField<FieldType::String>(FIELD_DICT_VALUE, false, false, false, true) // UNIQUE KEY
+                 .build();
+
+    std::string query = QueryBuilder::buildCreateTable(
+                            table,
+                            database.getDatabaseType()
+                        );
+
+    if(!query.empty())
+    {
+        database.execute(query);
+    }
+}
+
+/**
+ * @brief Gets the id of a value, adding the value to the table if it is new.
+ * Only the first use of a value queries the database.
+ * @param database Connection to use.
+ * @param value Value to encode.
+ * @return std::optional<int64_t> Id, or std::nullopt if the value could not be stored.
+ */
+std::optional<int64_t> LogDictionary::getId(IDatabase& database, const std::string& value)
+{
+    auto id = findId(database, value);
+    if(id.has_value())
+    {
+        return id;
+    }
+
+    std::string query = QueryBuilder::buildInsert(
+                            database.getDatabaseType(),
+                            tableName,
+    { {FIELD_DICT_VALUE, value} }
+                        );
+
+    // A failed insert may mean another connection added the value first
+    database.execute(query, DbParamList{ DbParam(value) });
+
+    id = selectId(database, value);
+    if(id.has_value())
+    {
+        cache(id.value(), value);
+    }
+    return id;
+}
+
+/**
+ * @brief Gets the id of a value without adding it.
+ * @param database Connection to use (queried on a cache miss).
+ * @param value Value to look up.
+ * @return std::optional<int64_t> Id, or std::nullopt if the value is not in the table.
+ */
+std::optional<int64_t> LogDictionary::findId(IDatabase& database, const std::string& value)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(value);
+        if(it != ids.end())
+        {
+            return it->second;
+        }
+    }
+
+    auto id = selectId(database, value);
+    if(id.has_value())
+    {
+        cache(id.value(), value);
+    }
+    return id;
+}
+
+/**
+ * @brief Gets a cached value.
+ * @param id Value id.
+ * @return std::string Value, or an empty string if the id is not loaded.
+ */
+std::string LogDictionary::getValue(const int64_t id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = values.find(id);
+    return it != values.end() ? it->second : std::string();
+}
+
+/**
+ * @brief Loads the rows added to the table since the last load.
+ * @param database Connection to use.
+ */
+void LogDictionary::load(IDatabase& database)
+{
+    int64_t afterId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        afterId = loadedId;
+    }
+
+    std::vector<Filter> filters =
+    {
+        {Filter::Type::Unknown, FIELD_DICT_ID, ">", std::to_string(afterId)}
+    };
+
+    std::string query = QueryBuilder::buildSelect(
+                            database.getDatabaseType(),
+                            tableName,
+    { FIELD_DICT_ID, FIELD_DICT_VALUE },
+    filters,
+    FIELD_DICT_ID
+                        );
+
+    const ResultSet result = database.queryResultSet(query, { std::to_string(afterId) });
+    const size_t colId = result.columnIndex(FIELD_DICT_ID);
+    const size_t colValue = result.columnIndex(FIELD_DICT_VALUE);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        const int64_t id = result.getInt64(row, colId);
+        const std::string value = result.getString(row, colValue);
+        ids[value] = id;
+        values[id] = value;
+        loadedId = std::max(loadedId, id);
+    }
+}
+
+/**
+ * @brief Drops all cached values (e.g. after a rolled back transaction).
+ */
+void LogDictionary::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ids.clear();
+    values.clear();
+    loadedId = 0;
+}
+
+/**
+ * @brief Selects the id of a value from the table.
+ * @param database Connection to use.
+ * @param value Value to look up.
+ * @return std::optional<int64_t> Id, or std::nullopt if not found.
+ */
+std::optional<int64_t> LogDictionary::selectId(IDatabase& database, const std::string& value) const
+{
+    std::vector<Filter> filters =
+    {
+        {Filter::Type::Unknown, FIELD_DICT_VALUE, "=", value}
+    };
+
+    std::string query = QueryBuilder::buildSelect(
+                            database.getDatabaseType(),
+                            tableName,
+    { FIELD_DICT_ID },
+    filters,
+    "", // no ordering
+    1   // limit to 1 result
+                        );
+
+    const ResultSet result = database.queryResultSet(query, { value });
+    if(result.rowCount() == 0)
+    {
+        return std::nullopt;
+    }
+    return result.getInt64(0, result.columnIndex(FIELD_DICT_ID));
+}
+
+/**
+ * @brief Stores a value <-> id pair in the cache.
+ * @param id Value id.
+ * @param value Value.
+ */
+void LogDictionary::cache(const int64_t id, const std::string& value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ids[value] = id;
+    values[id] = value;
+}
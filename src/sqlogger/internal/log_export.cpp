@@ -18,166 +18,627 @@
  */
 
 #include "sqlogger/internal/log_export.h"
+#include "sqlogger/internal/log_columnar.h"
+#include "sqlogger/log_helper.h"
 
 /**
- * @brief Exports log entries to a text file.
- * @param filePath The path to the output file.
- * @param entryList The list of log entries to export.
- * @param delimiter The delimiter to use between fields.
- * @param name Whether to include field names in the output.
+ * @brief Appends an XML element.
+ * @param out Text to append to.
+ * @param indent Indentation.
+ * @param tag Element name.
+ * @param value Element text.
  */
-void LogExport::exportToTXT(const std::string& filePath, const LogEntryList& entryList, const std::string& delimiter, bool name)
+static void appendXmlField(std::string& out, const char* indent, const char* tag, const std::string& value)
 {
-    std::ofstream outFile(filePath);
-    if(!outFile.is_open())
+    out += indent;
+    out += "<";
+    out += tag;
+    out += ">";
+    out += value;
+    out += "</";
+    out += tag;
+    out += ">\n";
+}
+
+/**
+ * @brief Appends a quoted YAML field.
+ * @param out Text to append to.
+ * @param indent Indentation.
+ * @param key Field name.
+ * @param value Field value (escaped here).
+ */
+static void appendYamlField(std::string& out, const char* indent, const char* key, const std::string& value)
+{
+    out += indent;
+    out += key;
+    out += ": \"";
+    out += LogExport::escapeYamlString(value);
+    out += "\"\n";
+}
+
+/**
+ * @brief Converts Format to its string representation
+ * @param format Output format
+ * @return std::string Format name (LOG_EXPORT_FORMAT_STR_*)
+ */
+std::string LogExport::formatToString(const Format& format)
+{
+    switch(format)
     {
-        throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + filePath);
+        case Format::CSV:
+            return LOG_EXPORT_FORMAT_STR_CSV;
+        case Format::XML:
+            return LOG_EXPORT_FORMAT_STR_XML;
+        case Format::JSON:
+            return LOG_EXPORT_FORMAT_STR_JSON;
+        case Format::YAML:
+            return LOG_EXPORT_FORMAT_STR_YAML;
+        case Format::NDJSON:
+            return LOG_EXPORT_FORMAT_STR_NDJSON;
+        case Format::BINARY:
+            return LOG_EXPORT_FORMAT_STR_BINARY;
+        case Format::PARQUET:
+            return LOG_EXPORT_FORMAT_STR_PARQUET;
+        case Format::ARROW:
+            return LOG_EXPORT_FORMAT_STR_ARROW;
+        case Format::TXT:
+        default:
+            return LOG_EXPORT_FORMAT_STR_TXT;
     }
-    for(const auto & entry : entryList)
+}
+
+/**
+ * @brief Converts string to Format
+ * @param format Format name (case insensitive)
+ * @return std::optional<Format> Format, or std::nullopt if unknown
+ */
+std::optional<LogExport::Format> LogExport::stringToFormat(const std::string& format)
+{
+    const std::string lower = LogHelper::toLowerCase(format);
+
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_TXT)) return Format::TXT;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_CSV)) return Format::CSV;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_XML)) return Format::XML;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_JSON)) return Format::JSON;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_YAML)) return Format::YAML;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_NDJSON)) return Format::NDJSON;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_BINARY)) return Format::BINARY;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_PARQUET)) return Format::PARQUET;
+    if(lower == LogHelper::toLowerCase(LOG_EXPORT_FORMAT_STR_ARROW)) return Format::ARROW;
+
+    return std::nullopt;
+}
+
+/**
+* @brief Checks if a format stores columns instead of formatted rows.
+* Columnar formats are written by Writer only; they have no header, footer or entry text.
+* @param format Output format.
+* @return bool True for PARQUET and ARROW.
+*/
+bool LogExport::isColumnar(const Format& format)
+{
+    return format == Format::PARQUET || format == Format::ARROW;
+}
+
+/**
+* @brief Checks if a format was compiled in.
+* @param format Output format.
+* @return bool False for columnar formats without SQLG_USE_ARROW.
+*/
+bool LogExport::isSupported(const Format& format)
+{
+    return !isColumnar(format) || LogColumnarWriter::isSupported(format, LogCompress::Compression::None);
+}
+
+/**
+ * @brief Gets the text written before the first entry.
+ * @param format Output format.
+ * @param delimiter The delimiter to use between fields.
+ * @return std::string Header text (may be empty).
+ */
+std::string LogExport::formatHeader(const Format& format, const std::string& delimiter)
+{
+    switch(format)
     {
-        outFile << entry.print(delimiter, name) << std::endl;
+        case Format::CSV:
+            return std::string(EXP_FIELD_ID) + delimiter
+                   + EXP_FIELD_TIMESTAMP + delimiter
+                   + EXP_FIELD_LEVEL + delimiter
+                   + EXP_FIELD_MESSAGE + delimiter
+                   + EXP_FIELD_FUNCTION + delimiter
+                   + EXP_FIELD_FILE + delimiter
+                   + EXP_FIELD_LINE + delimiter
+                   + EXP_FIELD_THREAD_ID
+#ifdef SQLG_USE_SOURCE_INFO
+                   + delimiter + EXP_FIELD_SOURCE + "/" + EXP_FIELD_SOURCE_ID
+                   + delimiter + EXP_FIELD_SOURCE + "/" + EXP_FIELD_SOURCE_UUID
+                   + delimiter + EXP_FIELD_SOURCE + "/" + EXP_FIELD_SOURCE_NAME
+#endif
+                   + "\n";
+        case Format::XML:
+            return std::string("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<") + EXP_LOG_ENTRIES + ">\n";
+        case Format::JSON:
+            return "[\n";
+        case Format::TXT:
+        case Format::YAML:
+        case Format::NDJSON:
+        case Format::BINARY:
+            return "";
+        case Format::PARQUET:
+        case Format::ARROW:
+            throw std::runtime_error(ERR_MSG_EXPORT_FMT_NOT_TEXT + formatToString(format));
+        default:
+            throw std::runtime_error(ERR_MSG_UNKNOWN_EXPORT_FMT);
     }
+}
 
-    outFile.close();
+/**
+ * @brief Gets the text written after the last entry.
+ * @param format Output format.
+ * @param empty Whether no entry was written.
+ * @return std::string Footer text (may be empty).
+ */
+std::string LogExport::formatFooter(const Format& format, const bool empty)
+{
+    switch(format)
+    {
+        case Format::XML:
+            return std::string("</") + EXP_LOG_ENTRIES + ">\n";
+        case Format::JSON:
+            return empty ? "]\n" : "\n]\n";
+        default:
+            return "";
+    }
 }
 
 /**
- * @brief Exports log entries to a CSV file.
- * @param filePath The path to the output file.
- * @param entryList The list of log entries to export.
+ * @brief Appends the text of one entry.
+ * @param out Text to append to.
+ * @param format Output format.
+ * @param entry The log entry.
+ * @param first Whether this is the first entry of the output (JSON separators).
  * @param delimiter The delimiter to use between fields.
+ * @param name Whether to include field names in the output.
  */
-void LogExport::exportToCSV(const std::string& filePath, const LogEntryList& entryList, const std::string& delimiter)
+void LogExport::formatEntry(std::string& out,
+                            const Format& format,
+                            const LogEntry& entry,
+                            const bool first,
+                            const std::string& delimiter,
+                            bool name)
 {
-    std::ofstream outFile(filePath);
-    if(!outFile.is_open())
+    switch(format)
     {
-        throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + filePath);
-    }
-    outFile << EXP_FIELD_ID << delimiter
-            << EXP_FIELD_TIMESTAMP << delimiter
-            << EXP_FIELD_LEVEL << delimiter
-            << EXP_FIELD_MESSAGE << delimiter
-            << EXP_FIELD_FUNCTION << delimiter
-            << EXP_FIELD_FILE << delimiter
-            << EXP_FIELD_LINE << delimiter
-            << EXP_FIELD_THREAD_ID
+        case Format::TXT:
+            out += entry.print(delimiter, name);
+            out += "\n";
+            break;
+        case Format::CSV:
+            out += std::to_string(entry.id) + delimiter;
+            out += entry.timestamp + delimiter;
+            out += entry.level + delimiter;
+            out += "\"" + entry.message + "\"" + delimiter;
+            out += entry.function + delimiter;
+            out += entry.file + delimiter;
+            out += std::to_string(entry.line) + delimiter;
+            out += entry.threadId;
 #ifdef SQLG_USE_SOURCE_INFO
-            << delimiter << EXP_FIELD_SOURCE << "/" << EXP_FIELD_SOURCE_ID
-            << delimiter << EXP_FIELD_SOURCE << "/" << EXP_FIELD_SOURCE_UUID
-            << delimiter << EXP_FIELD_SOURCE << "/" << EXP_FIELD_SOURCE_NAME
+            out += delimiter + std::to_string(entry.sourceId);
+            out += delimiter + entry.sourceUuid;
+            out += delimiter + entry.sourceName;
 #endif
-            << std::endl;
-    for(const auto & entry : entryList)
-    {
-        outFile << entry.id << delimiter
-                << entry.timestamp << delimiter
-                << entry.level << delimiter
-                << "\"" << entry.message << "\"" << delimiter
-                << entry.function << delimiter
-                << entry.file << delimiter
-                << entry.line << delimiter
-                << entry.threadId
+            out += "\n";
+            break;
+        case Format::XML:
+            out += std::string("  <") + EXP_LOG_ENTRY + ">\n";
+            appendXmlField(out, "    ", EXP_FIELD_ID, std::to_string(entry.id));
+            appendXmlField(out, "    ", EXP_FIELD_TIMESTAMP, entry.timestamp);
+            appendXmlField(out, "    ", EXP_FIELD_LEVEL, entry.level);
+            appendXmlField(out, "    ", EXP_FIELD_MESSAGE, entry.message);
+            appendXmlField(out, "    ", EXP_FIELD_FUNCTION, entry.function);
+            appendXmlField(out, "    ", EXP_FIELD_FILE, entry.file);
+            appendXmlField(out, "    ", EXP_FIELD_LINE, std::to_string(entry.line));
+            appendXmlField(out, "    ", EXP_FIELD_THREAD_ID, entry.threadId);
+#ifdef SQLG_USE_SOURCE_INFO
+            out += std::string("  <") + EXP_FIELD_SOURCE + ">\n";
+            appendXmlField(out, "    ", EXP_FIELD_SOURCE_ID, std::to_string(entry.sourceId));
+            appendXmlField(out, "    ", EXP_FIELD_SOURCE_UUID, entry.sourceUuid);
+            appendXmlField(out, "    ", EXP_FIELD_SOURCE_NAME, entry.sourceName);
+            out += std::string("  </") + EXP_FIELD_SOURCE + ">\n";
+#endif
+            out += std::string("  </") + EXP_LOG_ENTRY + ">\n";
+            break;
+        case Format::JSON:
+            if(!first)
+            {
+                out += ",\n";
+            }
+            LogSerializer::Json::appendLog(out, entry);
+            break;
+        case Format::NDJSON:
+            LogSerializer::Json::appendLogLine(out, entry);
+            out += "\n";
+            break;
+        case Format::BINARY:
+            LogSerializer::Binary::appendLogs(out, & entry, 1);
+            break;
+        case Format::YAML:
+            out += std::string("- ") + EXP_FIELD_ID + ": " + std::to_string(entry.id) + "\n";
+            appendYamlField(out, "  ", EXP_FIELD_TIMESTAMP, entry.timestamp);
+            appendYamlField(out, "  ", EXP_FIELD_LEVEL, entry.level);
+            appendYamlField(out, "  ", EXP_FIELD_MESSAGE, entry.message);
+            appendYamlField(out, "  ", EXP_FIELD_FUNCTION, entry.function);
+            appendYamlField(out, "  ", EXP_FIELD_FILE, entry.file);
+            out += std::string("  ") + EXP_FIELD_LINE + ": " + std::to_string(entry.line) + "\n";
+            appendYamlField(out, "  ", EXP_FIELD_THREAD_ID, entry.threadId);
 #ifdef SQLG_USE_SOURCE_INFO
-                << delimiter << entry.sourceId
-                << delimiter << entry.sourceUuid
-                << delimiter << entry.sourceName
+            out += std::string("  ") + EXP_FIELD_SOURCE + ":\n";
+            appendYamlField(out, "    ", EXP_FIELD_SOURCE_ID, std::to_string(entry.sourceId));
+            appendYamlField(out, "    ", EXP_FIELD_SOURCE_UUID, entry.sourceUuid);
+            appendYamlField(out, "    ", EXP_FIELD_SOURCE_NAME, entry.sourceName);
 #endif
-                << std::endl;
+            break;
+        case Format::PARQUET:
+        case Format::ARROW:
+            throw std::runtime_error(ERR_MSG_EXPORT_FMT_NOT_TEXT + formatToString(format));
+        default:
+            throw std::runtime_error(ERR_MSG_UNKNOWN_EXPORT_FMT);
+    }
+}
+
+/**
+ * @brief Appends the text of consecutive entries (one binary block for Format::BINARY).
+ * @param out Text to append to.
+ * @param format Output format.
+ * @param entries The log entries.
+ * @param count Number of entries.
+ * @param first Whether the first entry is the first of the output (JSON separators).
+ * @param delimiter The delimiter to use between fields.
+ * @param name Whether to include field names in the output.
+ */
+void LogExport::formatEntries(std::string& out,
+                              const Format& format,
+                              const LogEntry* entries,
+                              const size_t count,
+                              const bool first,
+                              const std::string& delimiter,
+                              bool name)
+{
+    if(format == Format::BINARY)
+    {
+        // One dictionary per chunk
+        LogSerializer::Binary::appendLogs(out, entries, count);
+        return;
     }
 
-    outFile.close();
+    for(size_t i = 0; i < count; ++i)
+    {
+        formatEntry(out, format, entries[i], first && i == 0, delimiter, name);
+    }
 }
 
 /**
- * @brief Exports log entries to an XML file.
+ * @brief Creates the output file (and its directory) and writes the format header.
  * @param filePath The path to the output file.
- * @param entryList The list of log entries to export.
+ * @param format Format of the output file.
+ * @param delimiter The delimiter to use between fields (TXT, CSV).
+ * @param name Whether to include field names in the output (TXT).
+ * @param threads Number of formatting threads (0 or 1 formats on the calling thread;
+ * columnar formats encode columns on Arrow's thread pool when threads > 1).
+ * @param compression Output compression.
+ * @throws std::runtime_error If the file or its directory cannot be created, or the format or compression is not supported.
  */
-void LogExport::exportToXML(const std::string& filePath, const LogEntryList& entryList)
+LogExport::Writer::Writer(const std::string& filePath,
+                          const Format& format,
+                          const std::string& delimiter,
+                          bool name,
+                          const size_t threads,
+                          const LogCompress::Compression& compression)
+    : filePath(filePath),
+      format(format),
+      delimiter(delimiter),
+      name(name),
+      compression(compression),
+      buffer(LOG_EXPORT_BUFFER_SIZE),
+      maxInFlight(threads > 1 ? threads * 2 : 0)
 {
-    std::ofstream outFile(filePath);
-    if(!outFile.is_open())
+    if(isColumnar(format))
+    {
+        if(!isSupported(format))
+        {
+            throw std::runtime_error(ERR_MSG_EXPORT_FMT_NOT_SUPPORTED + formatToString(format));
+        }
+        if(!LogColumnarWriter::isSupported(format, compression))
+        {
+            throw std::runtime_error(ERR_MSG_COMPRESSION_NOT_SUPPORTED + LogCompress::extension(compression));
+        }
+
+        std::string errMsg;
+        if(!FSHelper::createDir(filePath, errMsg))
+        {
+            throw std::runtime_error(ERR_MSG_FAILED_CREATE_DIR + errMsg);
+        }
+
+        columnar = std::make_unique<LogColumnarWriter>(filePath, format, compression, threads > 1);
+        chunk.reserve(LOG_EXPORT_CHUNK_SIZE);
+        return;
+    }
+
+    const std::string header = formatHeader(format, delimiter); // validates the format
+    if(!LogCompress::isSupported(compression))
+    {
+        throw std::runtime_error(ERR_MSG_COMPRESSION_NOT_SUPPORTED + LogCompress::extension(compression));
+    }
+
+    std::string errMsg;
+    if(!FSHelper::createDir(filePath, errMsg))
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_CREATE_DIR + errMsg);
+    }
+
+    // The buffer must be set before the file is opened to take effect
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+    if(!file.is_open())
     {
         throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + filePath);
     }
-    outFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
-    outFile << "<" << EXP_LOG_ENTRIES << ">" << std::endl;
-    for(const auto & entry : entryList)
+
+    if(threads > 1)
     {
-        outFile << "  <" << EXP_LOG_ENTRY << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_ID << ">" << entry.id << "</" << EXP_FIELD_ID << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_TIMESTAMP << ">" << entry.timestamp << "</" << EXP_FIELD_TIMESTAMP << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_LEVEL << ">" << entry.level << "</" << EXP_FIELD_LEVEL << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_MESSAGE << ">" << entry.message << "</" << EXP_FIELD_MESSAGE << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_FUNCTION << ">" << entry.function << "</" << EXP_FIELD_FUNCTION << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_FILE << ">" << entry.file << "</" << EXP_FIELD_FILE << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_LINE << ">" << entry.line << "</" << EXP_FIELD_LINE << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_THREAD_ID << ">" << entry.threadId << "</" << EXP_FIELD_THREAD_ID << ">" << std::endl;
-#ifdef SQLG_USE_SOURCE_INFO
-        outFile << "  <" << EXP_FIELD_SOURCE << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_SOURCE_ID << ">" << entry.sourceId << "</" << EXP_FIELD_SOURCE_ID << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_SOURCE_UUID << ">" << entry.sourceUuid << "</" << EXP_FIELD_SOURCE_UUID << ">" << std::endl;
-        outFile << "    <" << EXP_FIELD_SOURCE_NAME << ">" << entry.sourceName << "</" << EXP_FIELD_SOURCE_NAME << ">" << std::endl;
-        outFile << "  </" << EXP_FIELD_SOURCE << ">" << std::endl;
-#endif
-        outFile << "  </" << EXP_LOG_ENTRY << ">" << std::endl;
+        pool = std::make_unique<ThreadPool>(threads);
     }
-    outFile << "</" << EXP_LOG_ENTRIES << ">" << std::endl;
 
-    outFile.close();
+    chunk.reserve(LOG_EXPORT_CHUNK_SIZE);
+    writeText(encode(header));
 }
 
 /**
- * @brief Exports log entries to a JSON file.
- * @param filePath The path to the output file.
- * @param entryList The list of log entries to export.
+ * @brief Closes the writer, discarding errors (call close() to see them).
  */
-void LogExport::exportToJSON(const std::string& filePath, const LogEntryList& entryList)
+LogExport::Writer::~Writer()
 {
-    std::ofstream outFile(filePath);
-    if(!outFile.is_open())
+    try
     {
-        throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + filePath);
+        close();
+    }
+    catch(...)
+    {
+        // The pool is destroyed before the settings its tasks read
     }
+}
 
-    outFile << LogSerializer::Json::serializeLogs(entryList);
-    outFile.close();
+/**
+ * @brief Adds an entry to the export.
+ * @param entry The log entry.
+ * @throws std::runtime_error If writing a completed chunk failed.
+ */
+void LogExport::Writer::write(const LogEntry& entry)
+{
+    chunk.push_back(entry);
+    ++entries;
+    if(chunk.size() >= LOG_EXPORT_CHUNK_SIZE)
+    {
+        submitChunk();
+    }
 }
 
 /**
- * @brief Exports log entries to a YAML file.
- * @param filePath The path to the output file.
- * @param entryList The list of log entries to export.
+ * @brief Formats and writes the remaining entries and the format footer, then closes the file.
+ * @throws std::runtime_error If writing failed.
  */
-void LogExport::exportToYAML(const std::string& filePath, const LogEntryList& entryList)
+void LogExport::Writer::close()
 {
-    std::ofstream outFile(filePath);
-    if(!outFile.is_open())
+    if(closed)
     {
-        throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + filePath);
+        return;
+    }
+    closed = true;
+
+    submitChunk();
+    if(columnar)
+    {
+        columnar->close();
+        return;
+    }
+
+    writePending(0);
+    std::string footer = formatFooter(format, entries == 0);
+    if(!footer.empty() || (!written && compression != LogCompress::Compression::None))
+    {
+        // An empty compressed export still needs one (empty) member to be a valid file
+        writeText(LogCompress::compress(footer, compression));
+    }
+
+    file.close();
+    if(file.fail())
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_WRITE_FILE + filePath);
+    }
+}
+
+/**
+ * @brief Hands the current chunk to a formatting thread (or formats it in place).
+ */
+void LogExport::Writer::submitChunk()
+{
+    if(chunk.empty())
+    {
+        return;
+    }
+
+    if(columnar)
+    {
+        // Dictionaries grow across batches, so batches are built in order
+        columnar->write(chunk);
+        chunk.clear();
+        return;
+    }
+
+    const bool first = entries == chunk.size();
+    if(!pool)
+    {
+        std::string text;
+        formatEntries(text, format, chunk.data(), chunk.size(), first, delimiter, name);
+        chunk.clear();
+        writeText(encode(std::move(text)));
+        return;
+    }
+
+    auto promise = std::make_shared<std::promise<std::string>>();
+    pending.push_back(promise->get_future());
+    pool->enqueue([this, promise, first, list = std::move(chunk)]()
+    {
+        try
+        {
+            std::string text;
+            formatEntries(text, format, list.data(), list.size(), first, delimiter, name);
+            promise->set_value(encode(std::move(text)));
+        }
+        catch(...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    chunk = LogEntryList();
+    chunk.reserve(LOG_EXPORT_CHUNK_SIZE);
+    writePending(maxInFlight);
+}
+
+/**
+ * @brief Writes formatted chunks in order until at most maxPending are in flight.
+ * @param maxPending Number of chunks allowed to stay in flight.
+ */
+void LogExport::Writer::writePending(const size_t maxPending)
+{
+    while(pending.size() > maxPending)
+    {
+        std::string text = pending.front().get();
+        pending.pop_front();
+        writeText(text);
+    }
+}
+
+/**
+ * @brief Compresses formatted text (runs on the formatting thread).
+ * @param text Formatted text.
+ * @return std::string Bytes to write (text itself without compression).
+ */
+std::string LogExport::Writer::encode(std::string text) const
+{
+    if(compression == LogCompress::Compression::None || text.empty())
+    {
+        return text;
+    }
+    return LogCompress::compress(text, compression);
+}
+
+/**
+ * @brief Writes encoded bytes to the file.
+ * @param data Encoded bytes.
+ * @throws std::runtime_error If the write failed.
+ */
+void LogExport::Writer::writeText(const std::string& data)
+{
+    if(data.empty())
+    {
+        return;
     }
 
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if(file.fail())
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_WRITE_FILE + filePath);
+    }
+    written = true;
+}
+
+/**
+ * @brief Exports log entries to a file through a Writer.
+ * @param filePath The path to the output file.
+ * @param format Format of the output file.
+ * @param entryList The list of log entries to export.
+ * @param delimiter The delimiter to use between fields.
+ * @param name Whether to include field names in the output.
+ * @param compression Output compression.
+ */
+static void exportList(const std::string& filePath,
+                       const LogExport::Format& format,
+                       const LogEntryList& entryList,
+                       const std::string& delimiter,
+                       bool name,
+                       const LogCompress::Compression& compression = LogCompress::Compression::None)
+{
+    LogExport::Writer writer(filePath, format, delimiter, name, 0, compression);
     for(const auto & entry : entryList)
     {
-        outFile << "-";
-        outFile << " " << EXP_FIELD_ID << ": " << entry.id << std::endl;
-        outFile << "  " << EXP_FIELD_TIMESTAMP << ": " << "\"" << escapeYamlString(entry.timestamp) << "\"" << std::endl;
-        outFile << "  " << EXP_FIELD_LEVEL << ": " << "\"" << escapeYamlString(entry.level) << "\"" << std::endl;
-        outFile << "  " << EXP_FIELD_MESSAGE << ": " << "\"" << escapeYamlString(entry.message) << "\"" << std::endl;
-        outFile << "  " << EXP_FIELD_FUNCTION << ": " << "\"" << escapeYamlString(entry.function) << "\"" << std::endl;
-        outFile << "  " << EXP_FIELD_FILE << ": " << "\"" << escapeYamlString(entry.file) << "\"" << std::endl;
-        outFile << "  " << EXP_FIELD_LINE << ": " << entry.line << std::endl;
-        outFile << "  " << EXP_FIELD_THREAD_ID << ": " << "\"" << escapeYamlString(entry.threadId) << "\"" << std::endl;
-#ifdef SQLG_USE_SOURCE_INFO
-        outFile << "  " << EXP_FIELD_SOURCE << ":" << std::endl;
-        outFile << "    " << EXP_FIELD_SOURCE_ID << ": " << "\"" << entry.sourceId << "\"" << std::endl;
-        outFile << "    " << EXP_FIELD_SOURCE_UUID << ": " << "\"" << escapeYamlString(entry.sourceUuid) << "\"" << std::endl;
-        outFile << "    " << EXP_FIELD_SOURCE_NAME << ": " << "\"" << escapeYamlString(entry.sourceName) << "\"" << std::endl;
-#endif
+        writer.write(entry);
     }
+    writer.close();
+}
+
+/**
+ * @brief Exports log entries to a text file.
+ * @param filePath The path to the output file.
+ * @param entryList The list of log entries to export.
+ * @param delimiter The delimiter to use between fields.
+ * @param name Whether to include field names in the output.
+ */
+void LogExport::exportToTXT(const std::string& filePath, const LogEntryList& entryList, const std::string& delimiter, bool name)
+{
+    exportList(filePath, Format::TXT, entryList, delimiter, name);
+}
+
+/**
+ * @brief Exports log entries to a CSV file.
+ * @param filePath The path to the output file.
+ * @param entryList The list of log entries to export.
+ * @param delimiter The delimiter to use between fields.
+ */
+void LogExport::exportToCSV(const std::string& filePath, const LogEntryList& entryList, const std::string& delimiter)
+{
+    exportList(filePath, Format::CSV, entryList, delimiter, true);
+}
+
+/**
+ * @brief Exports log entries to an XML file.
+ * @param filePath The path to the output file.
+ * @param entryList The list of log entries to export.
+ */
+void LogExport::exportToXML(const std::string& filePath, const LogEntryList& entryList)
+{
+    exportList(filePath, Format::XML, entryList, ENTRY_DELIMITER, true);
+}
+
+/**
+ * @brief Exports log entries to a JSON file.
+ * @param filePath The path to the output file.
+ * @param entryList The list of log entries to export.
+ */
+void LogExport::exportToJSON(const std::string& filePath, const LogEntryList& entryList)
+{
+    exportList(filePath, Format::JSON, entryList, ENTRY_DELIMITER, true);
+}
 
-    outFile.close();
+/**
+ * @brief Exports log entries to a YAML file.
+ * @param filePath The path to the output file.
+ * @param entryList The list of log entries to export.
+ */
+void LogExport::exportToYAML(const std::string& filePath, const LogEntryList& entryList)
+{
+    exportList(filePath, Format::YAML, entryList, ENTRY_DELIMITER, true);
+}
+
+/**
+ * @brief Exports log entries to an NDJSON (JSON Lines) file.
+ * @param filePath The path to the output file.
+ * @param entryList The list of log entries to export.
+ */
+void LogExport::exportToNDJSON(const std::string& filePath, const LogEntryList& entryList)
+{
+    exportList(filePath, Format::NDJSON, entryList, ENTRY_DELIMITER, true);
 }
 
 /**
@@ -187,36 +648,16 @@ void LogExport::exportToYAML(const std::string& filePath, const LogEntryList& en
 * @param entryList The list of log entries to export.
 * @param delimiter The delimiter to use between fields.
 * @param name Whether to include field names in the output.
+* @param compression Output compression.
 */
-void LogExport::exportTo(const std::string& filePath, const Format& format, const LogEntryList& entryList, const std::string& delimiter, bool name)
+void LogExport::exportTo(const std::string& filePath,
+                         const Format& format,
+                         const LogEntryList& entryList,
+                         const std::string& delimiter,
+                         bool name,
+                         const LogCompress::Compression& compression)
 {
-    std::string errMsg;
-    if(!FSHelper::createDir(filePath, errMsg))
-    {
-        throw std::runtime_error(ERR_MSG_FAILED_CREATE_DIR + errMsg);
-    }
-
-    switch(format)
-    {
-        case Format::TXT:
-            exportToTXT(filePath, entryList, delimiter, name);
-            break;
-        case Format::CSV:
-            exportToCSV(filePath, entryList, delimiter);
-            break;
-        case Format::XML:
-            exportToXML(filePath, entryList);
-            break;
-        case Format::JSON:
-            exportToJSON(filePath, entryList);
-            break;
-        case Format::YAML:
-            exportToYAML(filePath, entryList);
-            break;
-        default:
-            throw std::runtime_error(ERR_MSG_UNKNOWN_EXPORT_FMT);
-            break;
-    }
+    exportList(filePath, format, entryList, delimiter, name, compression);
 }
 
 /**
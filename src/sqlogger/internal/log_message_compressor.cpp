@@ -0,0 +1,492 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include "sqlogger/internal/log_message_compressor.h"
+#include "sqlogger/internal/base64.h"
+#include "sqlogger/internal/log_strings.h"
+#include "sqlogger/database/database_schema.h"
+#include "sqlogger/database/query_builder.h"
+
+#ifdef SQLG_USE_ZSTD
+    #include <zstd.h>
+    #include <zdict.h>
+#endif
+
+#ifdef SQLG_USE_ZSTD
+namespace
+{
+    /**
+     * @struct ThreadContexts
+     * @brief zstd contexts of one thread, reused for every message.
+     */
+    struct ThreadContexts
+    {
+        ~ThreadContexts()
+        {
+            ZSTD_freeCCtx(compression);
+            ZSTD_freeDCtx(decompression);
+        }
+
+        ZSTD_CCtx* compression = nullptr; /**< Compression context (created on first use). */
+        ZSTD_DCtx* decompression = nullptr; /**< Decompression context (created on first use). */
+    };
+
+    thread_local ThreadContexts contexts; /**< Contexts of the thread. */
+}
+
+/**
+ * @struct LogMessageCompressor::Dictionary
+ * @brief Compression and decompression tables of one stored dictionary.
+ * The tables are read-only once created, so threads share them with their own contexts.
+ */
+struct LogMessageCompressor::Dictionary
+{
+    /**
+     * @brief Builds the tables of a dictionary.
+     * @param id Dictionary id.
+     * @param data Trained dictionary.
+     */
+    Dictionary(const int64_t id, const std::vector<unsigned char> & data)
+        : id(id),
+          cdict(ZSTD_createCDict(data.data(), data.size(), LOG_ZSTD_LEVEL)),
+          ddict(ZSTD_createDDict(data.data(), data.size()))
+    {
+    }
+
+    ~Dictionary()
+    {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+    }
+
+    Dictionary(const Dictionary&) = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+
+    /**
+     * @brief Compresses a message.
+     * @param message Message text.
+     * @return std::string Stored value, or the message itself if it would not get smaller.
+     */
+    std::string compress(const std::string_view message) const
+    {
+        if(!contexts.compression)
+        {
+            contexts.compression = ZSTD_createCCtx();
+        }
+
+        std::vector<unsigned char> frame(ZSTD_compressBound(message.size()));
+        const size_t size = contexts.compression
+                            ? ZSTD_compress_usingCDict(contexts.compression, frame.data(), frame.size(),
+                                    message.data(), message.size(), cdict)
+                            : 0;
+
+        const std::string header = LOG_ZSTD_PREFIX + std::to_string(id) + LOG_ZSTD_ID_SEPARATOR;
+        if(contexts.compression == nullptr || ZSTD_isError(size)
+                || header.size() + 4 * ((size + 2) / 3) >= message.size())
+        {
+            return std::string(message);
+        }
+        frame.resize(size);
+        return header + Base64::base64Encode(frame);
+    }
+
+    /**
+     * @brief Decompresses a frame.
+     * @param frame Frame produced by compress().
+     * @return std::optional<std::string> Message, or std::nullopt if the frame is damaged.
+     */
+    std::optional<std::string> decompress(const std::vector<unsigned char> & frame) const
+    {
+        const unsigned long long size = ZSTD_getFrameContentSize(frame.data(), frame.size());
+        if(size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+        {
+            return std::nullopt;
+        }
+
+        if(!contexts.decompression)
+        {
+            contexts.decompression = ZSTD_createDCtx();
+            if(!contexts.decompression)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::string message(static_cast<size_t>(size), '\0');
+        const size_t written = ZSTD_decompress_usingDDict(contexts.decompression, message.data(), message.size(),
+                               frame.data(), frame.size(), ddict);
+        if(ZSTD_isError(written) || written != message.size())
+        {
+            return std::nullopt;
+        }
+        return message;
+    }
+
+    int64_t id; /**< Dictionary id. */
+    ZSTD_CDict* cdict; /**< Compression table. */
+    ZSTD_DDict* ddict; /**< Decompression table. */
+};
+#else
+struct LogMessageCompressor::Dictionary
+{
+};
+#endif
+
+/**
+ * @brief Constructs a compressor.
+ * @param logsTableName Log table name (the dictionaries are kept in <logs table>_zdict).
+ * @throws std::runtime_error If zstd support is not compiled in.
+ */
+LogMessageCompressor::LogMessageCompressor(const std::string& logsTableName)
+    : tableName(logsTableName + LOG_ZSTD_TABLE_SUFFIX)
+{
+#ifndef SQLG_USE_ZSTD
+    throw std::runtime_error(ERR_MSG_MESSAGE_COMPRESSION_NOT_SUPPORTED);
+#endif
+}
+
+/**
+ * @brief Checks if the library was built with zstd support (SQLG_USE_ZSTD).
+ * @return bool True if LogMessageCompressor can be constructed.
+ */
+bool LogMessageCompressor::isSupported()
+{
+#ifdef SQLG_USE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Creates the dictionary table if it does not exist.
+ * @param database Connection to use.
+ */
+void LogMessageCompressor::createTable(IDatabase& database)
+{
+    auto table = DatabaseSchema::createTableBuilder(tableName)
+                 .addStandardField<FieldType::Int64>(FIELD_ZDICT_ID, true, false, true) // PRIMARY AUTOINCREMENT KEY
+                 .addField(FIELD_ZDICT_DATA, [](DataBaseType type)
+    {
+        return type == DataBaseType::MySQL ? LOG_ZSTD_DATA_TYPE_MS : DB_STRING_TYPE_DEF;
+    }, false, false)
+    .build();
+
+    std::string query = QueryBuilder::buildCreateTable(
+                            table,
+                            database.getDatabaseType()
+                        );
+
+    if(!query.empty())
+    {
+        database.execute(query);
+    }
+}
+
+/**
+ * @brief Loads the dictionaries added to the table since the last load.
+ * The newest one is used by compress().
+ * @param database Connection to use.
+ */
+void LogMessageCompressor::load(IDatabase& database)
+{
+    int64_t afterId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        afterId = loadedId;
+    }
+
+    std::vector<Filter> filters =
+    {
+        {Filter::Type::Unknown, FIELD_ZDICT_ID, ">", std::to_string(afterId)}
+    };
+
+    std::string query = QueryBuilder::buildSelect(
+                            database.getDatabaseType(),
+                            tableName,
+    { FIELD_ZDICT_ID, FIELD_ZDICT_DATA },
+    filters,
+    FIELD_ZDICT_ID
+                        );
+
+    const ResultSet result = database.queryResultSet(query, { std::to_string(afterId) });
+    if(result.rowCount() == 0)
+    {
+        return;
+    }
+
+    const size_t colId = result.columnIndex(FIELD_ZDICT_ID);
+    const size_t colData = result.columnIndex(FIELD_ZDICT_DATA);
+
+    // Building the tables takes a while, the lock is only needed to publish them
+    int64_t lastId = afterId;
+    std::vector<std::shared_ptr<const Dictionary>> loaded;
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        const int64_t id = result.getInt64(row, colId);
+        lastId = std::max(lastId, id);
+#ifdef SQLG_USE_ZSTD
+        auto dictionary = std::make_shared<const Dictionary>(id, Base64::base64Decode(result.getString(row, colData)));
+        if(dictionary->cdict && dictionary->ddict)
+        {
+            loaded.push_back(std::move(dictionary));
+        }
+#else
+        (void)colData;
+#endif
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+#ifdef SQLG_USE_ZSTD
+    for(auto & dictionary : loaded)
+    {
+        dictionaries.emplace(dictionary->id, std::move(dictionary));
+    }
+#endif
+    if(lastId > loadedId)
+    {
+        loadedId = lastId;
+        compressedCount = 0;
+    }
+}
+
+/**
+ * @brief Drops the loaded dictionaries and loads the stored ones again (e.g. after a rolled back transaction).
+ * @param database Connection to use.
+ */
+void LogMessageCompressor::reload(IDatabase& database)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dictionaries.clear();
+        loadedId = 0;
+    }
+    load(database);
+}
+
+/**
+ * @brief Compresses a message with the current dictionary.
+ * @param message Message text.
+ * @return std::string Stored value, the message itself if it is short, no dictionary
+ * is trained yet or compression would not make it smaller.
+ */
+std::string LogMessageCompressor::compress(const std::string_view message) const
+{
+#ifdef SQLG_USE_ZSTD
+    if(message.size() >= LOG_ZSTD_MIN_SIZE)
+    {
+        const auto dictionary = find(0);
+        if(dictionary)
+        {
+            return dictionary->compress(message);
+        }
+    }
+#endif
+    return std::string(message);
+}
+
+/**
+ * @brief Decompresses a value produced by compress().
+ * Values without the compression prefix are returned as is.
+ * @param value Stored message.
+ * @return std::optional<std::string> Message, or std::nullopt if the value is damaged or its dictionary is not loaded.
+ */
+std::optional<std::string> LogMessageCompressor::decompress(const std::string& value) const
+{
+    if(!isCompressed(value))
+    {
+        return value;
+    }
+
+#ifdef SQLG_USE_ZSTD
+    const size_t start = sizeof(LOG_ZSTD_PREFIX) - 1;
+    const size_t separator = value.find(LOG_ZSTD_ID_SEPARATOR, start);
+    int64_t id = 0;
+    if(separator == std::string::npos
+            || std::from_chars(value.data() + start, value.data() + separator, id).ptr != value.data() + separator)
+    {
+        return std::nullopt;
+    }
+
+    const auto dictionary = find(id);
+    if(!dictionary)
+    {
+        return std::nullopt;
+    }
+    return dictionary->decompress(Base64::base64Decode(value.substr(separator + 1)));
+#else
+    return std::nullopt;
+#endif
+}
+
+/**
+ * @brief Compresses the messages of a batch.
+ * The messages are also sampled; once enough are collected a dictionary is
+ * trained and stored through the connection before the batch is compressed.
+ * @param database Connection to use for a new dictionary.
+ * @param entries Entries to write.
+ * @return LogEntryList Copy of the entries with compressed messages.
+ */
+LogEntryList LogMessageCompressor::compressMessages(IDatabase& database, const LogEntryList& entries)
+{
+    LogEntryList result = entries;
+#ifdef SQLG_USE_ZSTD
+    bool ready = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(dictionaries.empty() || compressedCount >= LOG_ZSTD_RETRAIN_MESSAGES)
+        {
+            ready = sample(entries);
+        }
+    }
+    if(ready)
+    {
+        train(database);
+    }
+
+    const auto dictionary = find(0);
+    if(!dictionary)
+    {
+        return result;
+    }
+
+    for(auto & entry : result)
+    {
+        if(entry.message.size() >= LOG_ZSTD_MIN_SIZE)
+        {
+            entry.message = dictionary->compress(entry.message);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    compressedCount += result.size();
+#else
+    (void)database;
+#endif
+    return result;
+}
+
+/**
+ * @brief Collects the long messages of a batch as training samples.
+ * Must be called with mutex held.
+ * @param entries Entries to write.
+ * @return bool True if enough samples are collected to train a dictionary.
+ */
+bool LogMessageCompressor::sample(const LogEntryList& entries)
+{
+    for(const auto & entry : entries)
+    {
+        if(samplesSize >= LOG_ZSTD_TRAIN_SIZE)
+        {
+            break;
+        }
+        if(entry.message.size() >= LOG_ZSTD_MIN_SIZE)
+        {
+            samples.push_back(entry.message);
+            samplesSize += entry.message.size();
+        }
+    }
+    return samplesSize >= LOG_ZSTD_TRAIN_SIZE;
+}
+
+/**
+ * @brief Trains a dictionary from the collected samples, stores and loads it.
+ * A failure only drops the samples: messages keep the previous dictionary, or are stored as text.
+ * @param database Connection to use.
+ */
+void LogMessageCompressor::train(IDatabase& database)
+{
+#ifdef SQLG_USE_ZSTD
+    // Another writer is already training on these samples
+    std::unique_lock<std::mutex> trainLock(trainMutex, std::try_to_lock);
+    if(!trainLock.owns_lock())
+    {
+        return;
+    }
+
+    std::vector<std::string> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(samplesSize < LOG_ZSTD_TRAIN_SIZE)
+        {
+            return;
+        }
+        batch.swap(samples);
+        samplesSize = 0;
+    }
+
+    std::string buffer;
+    std::vector<size_t> sizes;
+    sizes.reserve(batch.size());
+    for(const auto & message : batch)
+    {
+        buffer += message;
+        sizes.push_back(message.size());
+    }
+
+    std::vector<unsigned char> data(LOG_ZSTD_DICT_SIZE);
+    const size_t size = ZDICT_trainFromBuffer(data.data(), data.size(), buffer.data(),
+                        sizes.data(), static_cast<unsigned>(sizes.size()));
+    if(ZDICT_isError(size))
+    {
+        // Too few distinct messages: the current dictionary stays for another period
+        std::lock_guard<std::mutex> lock(mutex);
+        compressedCount = 0;
+        return;
+    }
+    data.resize(size);
+
+    const std::string encoded = Base64::base64Encode(data);
+    std::string query = QueryBuilder::buildInsert(
+                            database.getDatabaseType(),
+                            tableName,
+    { {FIELD_ZDICT_DATA, encoded} }
+                        );
+
+    if(database.execute(query, DbParamList{ DbParam(encoded) }))
+    {
+        load(database);
+    }
+#else
+    (void)database;
+#endif
+}
+
+/**
+ * @brief Gets a loaded dictionary.
+ * @param id Dictionary id (0 = the current one).
+ * @return std::shared_ptr<const Dictionary> Dictionary, or nullptr if not loaded.
+ */
+std::shared_ptr<const LogMessageCompressor::Dictionary> LogMessageCompressor::find(const int64_t id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(dictionaries.empty())
+    {
+        return nullptr;
+    }
+    if(id == 0)
+    {
+        return dictionaries.rbegin()->second;
+    }
+    auto it = dictionaries.find(id);
+    return it != dictionaries.end() ? it->second : nullptr;
+}
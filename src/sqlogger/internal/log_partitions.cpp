@@ -0,0 +1,389 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <ctime>
+#include "sqlogger/internal/log_partitions.h"
+#include "sqlogger/log_helper.h"
+
+/**
+ * @brief Constructs the partition set of a log table (empty until assigned).
+ * @param logsTableName Log table name.
+ * @param databaseType Type of the database holding the table.
+ * @param timestampFormat Timestamp column format of the table.
+ * @param retentionDays Past days kept besides the current one (0 = keep everything).
+ */
+LogPartitions::LogPartitions(const std::string& logsTableName,
+                             const DataBaseType databaseType,
+                             const TimestampFormat timestampFormat,
+                             const int retentionDays)
+    : logsTableName(logsTableName),
+      databaseType(databaseType),
+      timestampFormat(timestampFormat),
+      retentionDays(std::max(retentionDays, 0))
+{
+}
+
+/**
+ * @brief Gets the day of the partition an entry belongs to.
+ * The stored timestamp is used (LogEntry::timestampUs with TimestampFormat::EpochMicros,
+ * LogEntry::timestamp otherwise), falling back to the other field and to today.
+ * @param entry The log entry.
+ * @return int Day as YYYYMMDD.
+ */
+int LogPartitions::dayOf(const LogEntry& entry) const
+{
+    std::optional<int> day;
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        day = entry.timestampUs != 0 ? dayOfMicros(entry.timestampUs) : std::nullopt;
+        if(!day.has_value())
+        {
+            day = dayOfText(entry.timestamp);
+        }
+    }
+    else
+    {
+        day = dayOfText(entry.timestamp);
+        if(!day.has_value() && entry.timestampUs != 0)
+        {
+            day = dayOfMicros(entry.timestampUs);
+        }
+    }
+    return day.value_or(today());
+}
+
+/**
+ * @brief Gets the current local day.
+ * @return int Day as YYYYMMDD.
+ */
+int LogPartitions::today()
+{
+    std::tm tm = {};
+    LogHelper::toLocalTime(std::time(nullptr), tm);
+    return (tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday;
+}
+
+/**
+ * @brief Adds days to a day.
+ * @param day Day as YYYYMMDD.
+ * @param days Days to add (negative to subtract).
+ * @return int Resulting day as YYYYMMDD.
+ */
+int LogPartitions::addDays(const int day, const int days)
+{
+    // Noon keeps DST shifts from moving the result to another day
+    std::tm tm = {};
+    tm.tm_year = day / 10000 - 1900;
+    tm.tm_mon = day / 100 % 100 - 1;
+    tm.tm_mday = day % 100 + days;
+    tm.tm_hour = 12;
+    tm.tm_isdst = -1;
+    std::mktime( & tm);
+    return (tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday;
+}
+
+/**
+ * @brief Gets the name of the partition of a day.
+ * @param day Day as YYYYMMDD.
+ * @return std::string Partition table name (SQLite, PostgreSQL) or partition name (MySQL).
+ */
+std::string LogPartitions::getName(const int day) const
+{
+    const std::string name = LOG_PARTITION_PREFIX + std::to_string(day);
+    return databaseType == DataBaseType::MySQL ? name : logsTableName + "_" + name;
+}
+
+/**
+ * @brief Parses a name returned by QueryBuilder::buildPartitionsQuery().
+ * @param name Partition or partition table name.
+ * @return std::optional<int> Day, or std::nullopt if the name is not a partition of the table.
+ */
+std::optional<int> LogPartitions::parseName(const std::string& name) const
+{
+    const std::string prefix = databaseType == DataBaseType::MySQL
+                               ? std::string(LOG_PARTITION_PREFIX)
+                               : logsTableName + "_" + LOG_PARTITION_PREFIX;
+    if(name.size() != prefix.size() + LOG_PARTITION_DAY_DIGITS || name.compare(0, prefix.size(), prefix) != 0)
+    {
+        return std::nullopt;
+    }
+
+    int day = 0;
+    for(size_t i = prefix.size(); i < name.size(); ++i)
+    {
+        if(!std::isdigit(static_cast<unsigned char>(name[i])))
+        {
+            return std::nullopt;
+        }
+        day = day * 10 + (name[i] - '0');
+    }
+    return day;
+}
+
+/**
+ * @brief Gets the inclusive lower bound of the partition of a day (its first timestamp value).
+ * @param day Day as YYYYMMDD.
+ * @return std::string Timestamp column value at 00:00:00 local time.
+ */
+std::string LogPartitions::getLowerBound(const int day) const
+{
+    return timestampFormat == TimestampFormat::EpochMicros
+           ? std::to_string(toMidnightMicros(day))
+           : toMidnightText(day);
+}
+
+/**
+ * @brief Gets the exclusive upper bound of the partition of a day.
+ * @param day Day as YYYYMMDD.
+ * @return std::string Timestamp column value at 00:00:00 of the next day.
+ */
+std::string LogPartitions::getUpperBound(const int day) const
+{
+    return getLowerBound(addDays(day, 1));
+}
+
+/**
+ * @brief Checks if entries of a day can be inserted without creating a partition.
+ * On MySQL any partition of the same or a later day holds them.
+ * @param day Day as YYYYMMDD.
+ * @return bool True if a partition holds the day.
+ */
+bool LogPartitions::covers(const int day) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(databaseType == DataBaseType::MySQL)
+    {
+        return days.lower_bound(day) != days.end();
+    }
+    return days.count(day) != 0;
+}
+
+/**
+ * @brief Gets the newest partition.
+ * @return std::optional<int> Day, or std::nullopt if there is no partition.
+ */
+std::optional<int> LogPartitions::getNewestDay() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(days.empty())
+    {
+        return std::nullopt;
+    }
+    return * days.rbegin();
+}
+
+/**
+ * @brief Gets the known partitions.
+ * @return std::vector<int> Days, oldest first.
+ */
+std::vector<int> LogPartitions::getDays() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<int>(days.begin(), days.end());
+}
+
+/**
+ * @brief Gets the partitions dropped by the retention policy.
+ * The newest partition is never expired, so the table always has one.
+ * @return std::vector<int> Days older than retentionDays before today, oldest first.
+ */
+std::vector<int> LogPartitions::getExpiredDays() const
+{
+    std::vector<int> expired;
+    if(retentionDays == 0)
+    {
+        return expired;
+    }
+
+    const int oldestKept = addDays(today(), -retentionDays);
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto it = days.begin(); it != days.end() && * it < oldestKept; ++it)
+    {
+        if(std::next(it) != days.end())
+        {
+            expired.push_back( * it);
+        }
+    }
+    return expired;
+}
+
+/**
+ * @brief Replaces the known partitions (e.g. with the ones listed by the database).
+ * The partition written last is forgotten, so the next write synchronizes the ID sequence.
+ * @param days Days of the partitions.
+ */
+void LogPartitions::assign(const std::vector<int> & days)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->days = std::set<int>(days.begin(), days.end());
+    lastWrittenDay.reset();
+}
+
+/**
+ * @brief Records a created partition.
+ * @param day Day as YYYYMMDD.
+ */
+void LogPartitions::add(const int day)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    days.insert(day);
+}
+
+/**
+ * @brief Records a dropped partition.
+ * @param day Day as YYYYMMDD.
+ */
+void LogPartitions::remove(const int day)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    days.erase(day);
+    if(lastWrittenDay == day)
+    {
+        lastWrittenDay.reset();
+    }
+}
+
+/**
+ * @brief Gets the day of the partition written last (SQLite ID sequence synchronization).
+ * @return std::optional<int> Day, or std::nullopt before the first write.
+ */
+std::optional<int> LogPartitions::getLastWrittenDay() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastWrittenDay;
+}
+
+/**
+ * @brief Sets the day of the partition written last.
+ * @param day Day as YYYYMMDD.
+ */
+void LogPartitions::setLastWrittenDay(const int day)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    lastWrittenDay = day;
+}
+
+/**
+ * @brief Gets the lowest ID sequence value of new SQLite partitions.
+ * Keeps IDs increasing after the partitions holding the highest ones were dropped.
+ * @return int64_t Sequence floor.
+ */
+int64_t LogPartitions::getIdFloor() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return idFloor;
+}
+
+/**
+ * @brief Raises the sequence floor.
+ * @param id Highest ID assigned so far.
+ */
+void LogPartitions::raiseIdFloor(const int64_t id)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    idFloor = std::max(idFloor, id);
+}
+
+/**
+ * @brief Formats a day as YYYY-MM-DD 00:00:00 (TIMESTAMP_FMT at midnight).
+ * @param day Day as YYYYMMDD.
+ * @return std::string Midnight timestamp text.
+ */
+std::string LogPartitions::toMidnightText(const int day)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d 00:00:00", day / 10000, day / 100 % 100, day % 100);
+    return buffer;
+}
+
+/**
+ * @brief Gets the local midnight of a day in microseconds since the epoch.
+ * @param day Day as YYYYMMDD.
+ * @return int64_t Midnight in microseconds.
+ */
+int64_t LogPartitions::toMidnightMicros(const int day)
+{
+    std::tm tm = {};
+    tm.tm_year = day / 10000 - 1900;
+    tm.tm_mon = day / 100 % 100 - 1;
+    tm.tm_mday = day % 100;
+    tm.tm_isdst = -1;
+    return static_cast<int64_t>(std::mktime( & tm)) * 1000000;
+}
+
+/**
+ * @brief Gets the local day of microseconds since the epoch.
+ * @param micros Microseconds since the epoch.
+ * @return std::optional<int> Day, or std::nullopt if the time can't be converted.
+ */
+std::optional<int> LogPartitions::dayOfMicros(const int64_t micros)
+{
+    // Floor division keeps times before 1970 on the right day
+    int64_t seconds = micros / 1000000;
+    if(micros % 1000000 < 0)
+    {
+        --seconds;
+    }
+
+    std::tm tm = {};
+    if(!LogHelper::toLocalTime(static_cast<std::time_t>(seconds), tm))
+    {
+        return std::nullopt;
+    }
+    return (tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday;
+}
+
+/**
+ * @brief Gets the day of TIMESTAMP_FMT text.
+ * @param timestamp Timestamp text starting with YYYY-MM-DD.
+ * @return std::optional<int> Day, or std::nullopt if the text has no date.
+ */
+std::optional<int> LogPartitions::dayOfText(const std::string& timestamp)
+{
+    // YYYY-MM-DD
+    static const char pattern[] = "dddd-dd-dd";
+    const size_t length = sizeof(pattern) - 1;
+    if(timestamp.size() < length)
+    {
+        return std::nullopt;
+    }
+
+    int day = 0;
+    for(size_t i = 0; i < length; ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(timestamp[i]);
+        if(pattern[i] == 'd')
+        {
+            if(!std::isdigit(c))
+            {
+                return std::nullopt;
+            }
+            day = day * 10 + (c - '0');
+        }
+        else if(c != pattern[i])
+        {
+            return std::nullopt;
+        }
+    }
+    return day;
+}
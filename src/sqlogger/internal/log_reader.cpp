@@ -17,7 +17,78 @@
  * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
  */
 
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
 #include "sqlogger/internal/log_reader.h"
+#include "sqlogger/log_helper.h"
+
+namespace
+{
+    /**
+     * @brief Counts the days from 1970-01-01 to a civil date (proleptic Gregorian calendar).
+     * @param year Year.
+     * @param month Month (1-12).
+     * @param day Day of month (1-31).
+     * @return int64_t Days since the epoch (negative before it).
+     */
+    int64_t daysFromCivil(int64_t year, const int64_t month, const int64_t day)
+    {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const int64_t yearOfEra = year - era * 400;
+        const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    /**
+     * @brief Truncates TIMESTAMP_FMT text to the start of its time bucket.
+     * The text is bucketed as is, like the SQL expression of SQLBuilder::buildTimeBucketExpression().
+     * @param timestamp Timestamp text (a fraction after the seconds is ignored).
+     * @param bucketSeconds Bucket width in seconds (positive).
+     * @return std::string Bucket start as TIMESTAMP_FMT text, or the text itself if it can't be parsed.
+     */
+    std::string bucketOfText(const std::string& timestamp, const int bucketSeconds)
+    {
+        int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+        if(std::sscanf(timestamp.c_str(), "%d-%d-%d %d:%d:%d", & year, & month, & day, & hour, & minute, & second) != 6)
+        {
+            return timestamp;
+        }
+
+        int64_t seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+        seconds -= ((seconds % bucketSeconds) + bucketSeconds) % bucketSeconds;
+
+        // Civil date from days, inverse of daysFromCivil()
+        const int64_t days = (seconds >= 0 ? seconds : seconds - 86399) / 86400 + 719468;
+        const int64_t daySeconds = seconds - (days - 719468) * 86400;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64_t dayOfEra = days - era * 146097;
+        const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+        const int64_t civilDay = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        const int64_t civilMonth = monthIndex + (monthIndex < 10 ? 3 : -9);
+        const int64_t civilYear = yearOfEra + era * 400 + (civilMonth <= 2);
+
+        char text[32];
+        std::snprintf(text, sizeof(text), "%04d-%02d-%02d %02d:%02d:%02d",
+                      static_cast<int>(civilYear), static_cast<int>(civilMonth), static_cast<int>(civilDay),
+                      static_cast<int>(daySeconds / 3600), static_cast<int>(daySeconds / 60 % 60), static_cast<int>(daySeconds % 60));
+        return text;
+    }
+
+    /**
+     * @brief Formats the start of an epoch time bucket.
+     * @param seconds Bucket start in seconds since the epoch.
+     * @return std::string Bucket start as TIMESTAMP_FMT local time.
+     */
+    std::string formatBucket(const int64_t seconds)
+    {
+        return LogHelper::formatTime(std::chrono::system_clock::time_point(std::chrono::seconds(seconds)));
+    }
+}
 
 /**
 * @brief Retrieves log entries from the database matching specified filters.
@@ -40,86 +111,724 @@ LogEntryList LogReader::getLogsByFilters(const std::vector<Filter> & filters,
         const int limit,
         const int offset)
 {
-    for(const auto & filter : filters)
+    const std::vector<Filter> queryFilters = resolveFilters(filters);
+
+    if(database.supportsNativeLogs())
     {
-        if(!filter.isAllowedOp())
+        LogEntryList logs;
+        selectNativeLogs(queryFilters, FIELD_LOG_TIMESTAMP, limit, offset, [ & ](const LogEntry & entry)
         {
-            throw std::invalid_argument(ERR_MSG_INVALID_OPERATOR + filter.op);
-        }
+            logs.push_back(entry);
+            return true;
+        });
+        return logs;
     }
 
-    std::vector<std::string> fields =
-    {
-        FIELD_LOG_ID,
-#ifdef SQLG_USE_SOURCE_INFO
-        FIELD_LOG_SOURCES_ID,
-#endif
-        FIELD_LOG_TIMESTAMP,
-        FIELD_LOG_LEVEL,
-        FIELD_LOG_MESSAGE,
-        FIELD_LOG_FUNCTION,
-        FIELD_LOG_FILE,
-        FIELD_LOG_LINE,
-        FIELD_LOG_THREAD_ID
-    };
-
     // Build the query using QueryBuilder
     std::string query = QueryBuilder::buildSelect(
                             database.getDatabaseType(),
                             logsTableName,
-                            fields,
-                            filters,
+                            getLogFields(),
+                            queryFilters,
                             FIELD_LOG_TIMESTAMP,
                             limit,
                             offset
                         );
 
     // Prepare parameters for the query
-    std::vector<std::string> params;
-    for(const auto & filter : filters)
+    const std::vector<std::string> params = getFilterParams(queryFilters);
+
+    // Execute the query
+    const ResultSet result = database.queryResultSet(query, params);
+    if(dictionaries)
     {
-        params.push_back(filter.value);
+        // Values added since the last read
+        dictionaries->load(database);
+    }
+    if(messageCompressor)
+    {
+        messageCompressor->load(database);
     }
 
-    // Execute the query
-    auto result = database.query(query, params);
+    const LogColumns columns(result);
     LogEntryList logs;
+    logs.reserve(result.rowCount());
+
+#ifdef SQLG_USE_SOURCE_INFO
+    // Each distinct source is looked up once per query, not once per row
+    SourceCache sources;
+#endif
 
     // Convert results to LogEntry objects
-    for(const auto & row : result)
+    for(size_t row = 0; row < result.rowCount(); ++row)
     {
+        logs.push_back(toLogEntry(result, row, columns));
 #ifdef SQLG_USE_SOURCE_INFO
-        auto src = getSourceById(std::stoi(row.at(FIELD_LOG_SOURCES_ID)));
-        bool srcHasValue = false;
-        if(src.has_value() && !src.value().uuid.empty() && !src.value().name.empty())
+        const auto & src = resolveSource(logs.back().sourceId, sources);
+        if(src.has_value())
         {
-            srcHasValue = true;
+            logs.back().sourceUuid = src.value().uuid;
+            logs.back().sourceName = src.value().name;
         }
 #endif
-        logs.push_back(
-        {
-            std::stoi(row.at(FIELD_LOG_ID)),
+    }
+
+    return logs;
+}
+
+/**
+ * @brief Streams log entries matching the filters to a callback, ordered by ID.
+ * Rows are read one at a time from the database cursor, so memory use does not
+ * depend on the result size. With a positive page size the scan is split into
+ * keyset pages (WHERE id > last ORDER BY id LIMIT pageSize), which stay fast at
+ * any depth unlike LIMIT/OFFSET.
+ * @param filters Vector of Filter objects defining search criteria.
+ * @param callback Function called for each entry; return false to stop the scan.
+ * @param pageSize Rows per keyset page (0 streams everything with a single query).
+ * @param afterId Only entries with an ID greater than this are visited (resume point).
+ * @throws std::invalid_argument If filter op is empty or ivalid.
+ * @throws std::runtime_error If a query fails.
+ * @return size_t Number of entries passed to the callback.
+ */
+size_t LogReader::forEachLog(const std::vector<Filter> & filters,
+                             const LogCallback& callback,
+                             const int pageSize,
+                             const int64_t afterId)
+{
+    const std::vector<Filter> queryFilters = resolveFilters(filters);
+
+    if(database.supportsNativeLogs())
+    {
+        // The backend streams without materializing, keyset pages are not needed
+        std::vector<Filter> nativeFilters = queryFilters;
+        nativeFilters.push_back({ Filter::Type::Unknown, FIELD_LOG_ID, ">", std::to_string(afterId) });
+        return selectNativeLogs(nativeFilters, FIELD_LOG_ID, 0, 0, callback);
+    }
+
 #ifdef SQLG_USE_SOURCE_INFO
-            row.count(FIELD_LOG_SOURCES_ID) ? std::stoi(row.at(FIELD_LOG_SOURCES_ID)) : SOURCE_NOT_FOUND,
+    // The cursor keeps the connection busy, so resolve sources up front
+    std::unordered_map<int, SourceInfo> sources;
+    for(auto & source : getAllSources())
+    {
+        if(!source.uuid.empty() && !source.name.empty())
+        {
+            sources.emplace(source.sourceId, std::move(source));
+        }
+    }
 #endif
-            row.at(FIELD_LOG_TIMESTAMP),
-            row.at(FIELD_LOG_LEVEL),
-            row.at(FIELD_LOG_MESSAGE),
-            row.at(FIELD_LOG_FUNCTION),
-            row.at(FIELD_LOG_FILE),
-            std::stoi(row.at(FIELD_LOG_LINE)),
-            row.at(FIELD_LOG_THREAD_ID)
+
+    const std::vector<std::string> fields = getLogFields();
+    std::vector<Filter> pageFilters = queryFilters;
+    pageFilters.push_back({ Filter::Type::Unknown, FIELD_LOG_ID, ">", std::to_string(afterId) });
+
+    size_t visited = 0;
+    bool stopped = false;
+
+    while(true)
+    {
+        const std::string query = QueryBuilder::buildSelect(
+                                      database.getDatabaseType(),
+                                      logsTableName,
+                                      fields,
+                                      pageFilters,
+                                      FIELD_LOG_ID,
+                                      pageSize
+                                  );
+
+        const std::vector<std::string> params = getFilterParams(pageFilters);
+        if(dictionaries)
+        {
+            // The cursor keeps the connection busy, so load new values before each page
+            dictionaries->load(database);
+        }
+        if(messageCompressor)
+        {
+            messageCompressor->load(database);
+        }
+
+        size_t pageRows = 0;
+        int64_t lastId = 0;
+        std::optional<LogColumns> columns;
+
+        const bool executed = database.queryEach(query, params, [ & ](const ResultSet & result, const size_t row)
+        {
+            if(!columns.has_value())
+            {
+                columns.emplace(result);
+            }
+
+            LogEntry entry = toLogEntry(result, row, columns.value());
 #ifdef SQLG_USE_SOURCE_INFO
-            , srcHasValue ? src.value().uuid : ""
-            , srcHasValue ? src.value().name : ""
+            auto it = sources.find(entry.sourceId);
+            if(it != sources.end())
+            {
+                entry.sourceUuid = it->second.uuid;
+                entry.sourceName = it->second.name;
+            }
 #endif
+            lastId = entry.id;
+            ++pageRows;
+            ++visited;
+
+            if(!callback(entry))
+            {
+                stopped = true;
+                return false;
+            }
+            return true;
+        });
+
+        if(!executed)
+        {
+            throw std::runtime_error(ERR_MSG_FAILED_STREAM_QUERY + database.getLastError());
+        }
+
+        if(stopped || pageSize <= 0 || pageRows < static_cast<size_t>(pageSize))
+        {
+            break;
+        }
+
+        pageFilters.back().value = std::to_string(lastId);
+    }
+
+    return visited;
+}
+
+/**
+ * @brief Counts the log entries matching the filters per value of a column.
+ * The database groups and counts the rows (GROUP BY), only the counts are transferred.
+ * @param field Log table column (see getLogFields()).
+ * @param filters Filters, combined with AND.
+ * @throws std::invalid_argument If the field or a filter op is invalid.
+ * @return LogCounts Number of entries per value (NULL values are counted under "").
+ */
+LogCounts LogReader::countBy(const std::string& field, const std::vector<Filter> & filters)
+{
+    LogCounts counts;
+    countGroups({ field }, 0, filters, [ & ](const std::vector<std::string> & keys, const uint64_t count)
+    {
+        counts[keys[0]] += count;
+    });
+    return counts;
+}
+
+/**
+ * @brief Counts the log entries matching the filters per time bucket.
+ * @param bucketSeconds Bucket width in seconds, buckets are aligned to multiples of it.
+ * @param filters Filters, combined with AND.
+ * @throws std::invalid_argument If the bucket width or a filter op is invalid.
+ * @return LogCounts Number of entries per bucket start (TIMESTAMP_FMT local time), empty buckets are omitted.
+ */
+LogCounts LogReader::histogram(const int bucketSeconds, const std::vector<Filter> & filters)
+{
+    if(bucketSeconds <= 0)
+    {
+        throw std::invalid_argument(ERR_MSG_INVALID_BUCKET + std::to_string(bucketSeconds));
+    }
+
+    LogCounts counts;
+    countGroups({ FIELD_LOG_TIMESTAMP }, bucketSeconds, filters, [ & ](const std::vector<std::string> & keys, const uint64_t count)
+    {
+        counts[keys[0]] += count;
+    });
+    return counts;
+}
+
+/**
+ * @brief Counts the log entries matching the filters per time bucket and value of a column.
+ * @param field Log table column (see getLogFields()).
+ * @param bucketSeconds Bucket width in seconds, buckets are aligned to multiples of it.
+ * @param filters Filters, combined with AND.
+ * @throws std::invalid_argument If the field, the bucket width or a filter op is invalid.
+ * @return LogHistogram Number of entries per bucket start (TIMESTAMP_FMT local time) and value.
+ */
+LogHistogram LogReader::histogramBy(const std::string& field, const int bucketSeconds, const std::vector<Filter> & filters)
+{
+    if(bucketSeconds <= 0)
+    {
+        throw std::invalid_argument(ERR_MSG_INVALID_BUCKET + std::to_string(bucketSeconds));
+    }
+
+    LogHistogram histogram;
+    countGroups({ FIELD_LOG_TIMESTAMP, field }, bucketSeconds, filters, [ & ](const std::vector<std::string> & keys, const uint64_t count)
+    {
+        histogram[keys[0]][keys[1]] += count;
+    });
+    return histogram;
+}
+
+/**
+ * @brief Counts the log entries matching the filters per group.
+ * SQL backends run a GROUP BY query, backends storing logs natively are scanned in process.
+ * @param fields Group fields (FIELD_LOG_TIMESTAMP is grouped by time bucket if bucketSeconds > 0).
+ * @param bucketSeconds Time bucket width in seconds (0 = group timestamps by value).
+ * @param filters Filters, combined with AND.
+ * @param callback Function called for each group.
+ * @throws std::invalid_argument If a field or a filter op is invalid.
+ */
+void LogReader::countGroups(const std::vector<std::string> & fields,
+                            const int bucketSeconds,
+                            const std::vector<Filter> & filters,
+                            const GroupCallback& callback)
+{
+    const std::vector<std::string> logFields = getLogFields();
+    for(const auto & field : fields)
+    {
+        if(std::find(logFields.begin(), logFields.end(), field) == logFields.end())
+        {
+            throw std::invalid_argument(ERR_MSG_INVALID_GROUP_FIELD + field);
+        }
+    }
+
+    const std::vector<Filter> queryFilters = resolveFilters(filters);
+
+    if(database.supportsNativeLogs())
+    {
+        // In process: nothing crosses a wire, so count while scanning
+        std::map<std::vector<std::string>, uint64_t> groups;
+        selectNativeLogs(queryFilters, FIELD_LOG_ID, 0, 0, [ & ](const LogEntry & entry)
+        {
+            std::vector<std::string> keys;
+            keys.reserve(fields.size());
+            for(const auto & field : fields)
+            {
+                keys.push_back(getGroupKey(entry, field, bucketSeconds));
+            }
+            ++groups[keys];
+            return true;
         });
+
+        for(const auto & group : groups)
+        {
+            callback(group.first, group.second);
+        }
+        return;
     }
 
-    return logs;
+    const std::string query = QueryBuilder::buildGroupCount(
+                                  database.getDatabaseType(),
+                                  logsTableName,
+                                  fields,
+                                  queryFilters,
+                                  bucketSeconds,
+                                  timestampFormat
+                              );
+
+    if(query.empty())
+    {
+        return;
+    }
+
+    const ResultSet result = database.queryResultSet(query, getFilterParams(queryFilters));
+    if(dictionaries)
+    {
+        // Values added since the last read
+        dictionaries->load(database);
+    }
+    if(messageCompressor)
+    {
+        messageCompressor->load(database);
+    }
+
+    std::vector<size_t> columns;
+    for(const auto & field : fields)
+    {
+        columns.push_back(result.columnIndex(field));
+    }
+    const size_t countColumn = result.columnIndex(SQL_COUNT_ALIAS);
+
+    std::vector<std::string> keys(fields.size());
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        for(size_t i = 0; i < fields.size(); ++i)
+        {
+            keys[i] = getGroupKey(result, row, columns[i], fields[i], bucketSeconds);
+        }
+        callback(keys, static_cast<uint64_t>(result.getInt64(row, countColumn)));
+    }
+}
+
+/**
+ * @brief Converts a group column of a GROUP BY result row to its value.
+ * @param result Result set.
+ * @param row Row index.
+ * @param column Column index.
+ * @param field Group field.
+ * @param bucketSeconds Time bucket width in seconds (0 = timestamps are not bucketed).
+ * @return std::string Value as returned in log entries (bucket start for timestamps, "" for NULL).
+ */
+std::string LogReader::getGroupKey(const ResultSet& result,
+                                   const size_t row,
+                                   const size_t column,
+                                   const std::string& field,
+                                   const int bucketSeconds) const
+{
+    if(result.isNull(row, column))
+    {
+        return "";
+    }
+
+    if(field == FIELD_LOG_TIMESTAMP && timestampFormat == TimestampFormat::EpochMicros)
+    {
+        return bucketSeconds > 0
+               ? formatBucket(result.getInt64(row, column))
+               : LogHelper::formatEpochMicros(result.getInt64(row, column));
+    }
+
+    if(dictionaries)
+    {
+        if(field == FIELD_LOG_LEVEL)
+        {
+            return LogHelper::levelToString(LogHelper::intToLevel(result.getInt(row, column, LogHelper::levelToInt(LogLevel::Unknown))));
+        }
+
+        LogDictionary* dictionary = dictionaries->forField(field);
+        if(dictionary)
+        {
+            return dictionary->getValue(result.getInt64(row, column));
+        }
+    }
+
+    return result.getString(row, column);
 }
 
+/**
+ * @brief Gets the group value of a log entry.
+ * @param entry Log entry.
+ * @param field Group field.
+ * @param bucketSeconds Time bucket width in seconds (0 = timestamps are not bucketed).
+ * @return std::string Field value (bucket start for timestamps).
+ */
+std::string LogReader::getGroupKey(const LogEntry& entry, const std::string& field, const int bucketSeconds) const
+{
+    if(field == FIELD_LOG_TIMESTAMP)
+    {
+        if(bucketSeconds <= 0)
+        {
+            return entry.timestamp;
+        }
+
+        if(timestampFormat == TimestampFormat::EpochMicros && entry.timestampUs != 0)
+        {
+            const int64_t width = static_cast<int64_t>(bucketSeconds) * 1000000;
+            return formatBucket(entry.timestampUs / width * bucketSeconds);
+        }
+        return bucketOfText(entry.timestamp, bucketSeconds);
+    }
+
+    if(field == FIELD_LOG_ID) return std::to_string(entry.id);
+    if(field == FIELD_LOG_LEVEL) return entry.level;
+    if(field == FIELD_LOG_MESSAGE) return entry.message;
+    if(field == FIELD_LOG_FUNCTION) return entry.function;
+    if(field == FIELD_LOG_FILE) return entry.file;
+    if(field == FIELD_LOG_LINE) return std::to_string(entry.line);
+    if(field == FIELD_LOG_THREAD_ID) return entry.threadId;
 #ifdef SQLG_USE_SOURCE_INFO
+    if(field == FIELD_LOG_SOURCES_ID) return entry.sourceId == SOURCE_NOT_FOUND ? "" : std::to_string(entry.sourceId);
+#endif
+    return "";
+}
+
+/**
+ * @brief Reads log entries from a backend that stores them natively (IDatabase::supportsNativeLogs()).
+ * Timestamps are formatted for the configured format and sources are resolved.
+ * @param filters Filters, combined with AND.
+ * @param orderBy FIELD_LOG_ID or FIELD_LOG_TIMESTAMP.
+ * @param limit Maximum number of entries (0 or negative = no limit).
+ * @param offset Number of entries to skip, requires a positive limit.
+ * @param callback Function called for each entry; return false to stop reading.
+ * @return size_t Number of entries passed to the callback.
+ */
+size_t LogReader::selectNativeLogs(const std::vector<Filter> & filters,
+                                   const std::string& orderBy,
+                                   const int limit,
+                                   const int offset,
+                                   const LogCallback& callback)
+{
+#ifdef SQLG_USE_SOURCE_INFO
+    // The callback runs under the backend lock, so resolve sources up front
+    std::unordered_map<int, SourceInfo> sources;
+    for(auto & source : getAllSources())
+    {
+        if(!source.uuid.empty() && !source.name.empty())
+        {
+            sources.emplace(source.sourceId, std::move(source));
+        }
+    }
+#endif
+
+    const bool epochTimestamps = timestampFormat == TimestampFormat::EpochMicros;
+
+    return database.selectLogs(logsTableName, filters, orderBy, limit, offset, [ & ](LogEntry & entry)
+    {
+        if(epochTimestamps)
+        {
+            entry.timestamp = LogHelper::formatEpochMicros(entry.timestampUs);
+        }
+        if(cipher)
+        {
+            auto message = cipher->decrypt(entry.message);
+            if(message.has_value())
+            {
+                entry.message = std::move(message.value());
+            }
+        }
+#ifdef SQLG_USE_SOURCE_INFO
+        auto it = sources.find(entry.sourceId);
+        if(it != sources.end())
+        {
+            entry.sourceUuid = it->second.uuid;
+            entry.sourceName = it->second.name;
+        }
+#endif
+        return callback(entry);
+    });
+}
+
+/**
+ * @brief Gets the log table fields read by LogReader.
+ * @return std::vector<std::string> Field names in select order.
+ */
+std::vector<std::string> LogReader::getLogFields()
+{
+    return
+    {
+        FIELD_LOG_ID,
+#ifdef SQLG_USE_SOURCE_INFO
+        FIELD_LOG_SOURCES_ID,
+#endif
+        FIELD_LOG_TIMESTAMP,
+        FIELD_LOG_LEVEL,
+        FIELD_LOG_MESSAGE,
+        FIELD_LOG_FUNCTION,
+        FIELD_LOG_FILE,
+        FIELD_LOG_LINE,
+        FIELD_LOG_THREAD_ID
+    };
+}
+
+/**
+ * @brief Resolves log column positions once instead of per-row lookups.
+ * @param result Result set returned for getLogFields().
+ */
+LogReader::LogColumns::LogColumns(const ResultSet& result)
+    : id(result.columnIndex(FIELD_LOG_ID)),
+#ifdef SQLG_USE_SOURCE_INFO
+      sourceId(result.columnIndex(FIELD_LOG_SOURCES_ID)),
+#endif
+      timestamp(result.columnIndex(FIELD_LOG_TIMESTAMP)),
+      level(result.columnIndex(FIELD_LOG_LEVEL)),
+      message(result.columnIndex(FIELD_LOG_MESSAGE)),
+      function(result.columnIndex(FIELD_LOG_FUNCTION)),
+      file(result.columnIndex(FIELD_LOG_FILE)),
+      line(result.columnIndex(FIELD_LOG_LINE)),
+      threadId(result.columnIndex(FIELD_LOG_THREAD_ID))
+{
+}
+
+/**
+ * @brief Converts a result row to a LogEntry (source UUID and name are left empty).
+ * @param result Result set.
+ * @param row Row index.
+ * @param columns Resolved column positions.
+ * @return LogEntry Converted entry.
+ */
+LogEntry LogReader::toLogEntry(const ResultSet& result, const size_t row, const LogColumns& columns) const
+{
+    const bool epochTimestamps = timestampFormat == TimestampFormat::EpochMicros;
+
+    LogEntry entry
+    {
+        result.getInt(row, columns.id),
+#ifdef SQLG_USE_SOURCE_INFO
+        result.isNull(row, columns.sourceId)
+        ? SOURCE_NOT_FOUND
+        : result.getInt(row, columns.sourceId, SOURCE_NOT_FOUND),
+#endif
+        epochTimestamps ? std::string() : result.getString(row, columns.timestamp),
+        dictionaries
+        ? LogHelper::levelToString(LogHelper::intToLevel(result.getInt(row, columns.level, LogHelper::levelToInt(LogLevel::Unknown))))
+        : result.getString(row, columns.level),
+        result.getString(row, columns.message),
+        dictionaries
+        ? dictionaries->function.getValue(result.getInt64(row, columns.function))
+        : result.getString(row, columns.function),
+        dictionaries
+        ? dictionaries->file.getValue(result.getInt64(row, columns.file))
+        : result.getString(row, columns.file),
+        result.getInt(row, columns.line),
+        dictionaries
+        ? dictionaries->threadId.getValue(result.getInt64(row, columns.threadId))
+        : result.getString(row, columns.threadId)
+#ifdef SQLG_USE_SOURCE_INFO
+        , ""
+        , ""
+#endif
+    };
+
+    if(epochTimestamps)
+    {
+        // Stored as an integer: format only now, when read
+        entry.timestampUs = result.getInt64(row, columns.timestamp);
+        entry.timestamp = LogHelper::formatEpochMicros(entry.timestampUs);
+    }
+
+    if(messageCompressor)
+    {
+        auto message = messageCompressor->decompress(entry.message);
+        if(message.has_value())
+        {
+            entry.message = std::move(message.value());
+        }
+    }
+
+    if(cipher)
+    {
+        auto message = cipher->decrypt(entry.message);
+        if(message.has_value())
+        {
+            entry.message = std::move(message.value());
+        }
+    }
+    return entry;
+}
+
+/**
+ * @brief Gets the query parameters for the filters.
+ * @param filters Filters in query order.
+ * @return std::vector<std::string> Filter values (timestamps converted to the column format).
+ */
+std::vector<std::string> LogReader::getFilterParams(const std::vector<Filter> & filters) const
+{
+    std::vector<std::string> params;
+    params.reserve(filters.size());
+    for(const auto & filter : filters)
+    {
+        if(filter.op == FILTER_OP_MATCH)
+        {
+            params.push_back(QueryBuilder::buildMatchValue(database.getDatabaseType(), filter.value));
+        }
+        else if(timestampFormat == TimestampFormat::EpochMicros && filter.field == FIELD_LOG_TIMESTAMP)
+        {
+            const auto micros = LogHelper::parseEpochMicros(filter.value);
+            if(!micros.has_value())
+            {
+                throw std::invalid_argument(ERR_MSG_INVALID_TIMESTAMP + filter.value);
+            }
+            params.push_back(std::to_string(micros.value()));
+        }
+        else if(dictionaries && (filter.field == FIELD_LOG_LEVEL || dictionaries->forField(filter.field)))
+        {
+            params.push_back(toCompactParam(filter));
+        }
+        else
+        {
+            params.push_back(filter.value);
+        }
+    }
+    return params;
+}
+
+/**
+ * @brief Validates the filters and rewrites the MATCH filters the backend cannot run.
+ * MATCH filters without words are dropped; without full-text search (or on a backend
+ * storing logs natively) every word becomes a LIKE '%word%' filter.
+ * @param filters Filters as given by the caller.
+ * @return std::vector<Filter> Filters to query with.
+ * @throws std::invalid_argument If filter op is empty or ivalid.
+ */
+std::vector<Filter> LogReader::resolveFilters(const std::vector<Filter> & filters) const
+{
+    std::vector<Filter> resolved;
+    resolved.reserve(filters.size());
+    for(const auto & filter : filters)
+    {
+        if(!filter.isAllowedOp())
+        {
+            throw std::invalid_argument(ERR_MSG_INVALID_OPERATOR + filter.op);
+        }
+
+        if(filter.op != FILTER_OP_MATCH)
+        {
+            resolved.push_back(filter);
+            continue;
+        }
+
+        const std::vector<std::string> words = StringHelper::splitWords(filter.value);
+        if(words.empty())
+            continue; // Matches everything
+
+        if(fullTextSearch && !database.supportsNativeLogs())
+        {
+            resolved.push_back(filter);
+            continue;
+        }
+
+        for(const auto & word : words)
+        {
+            resolved.push_back({ filter.type, filter.field, "LIKE", "%" + word + "%" });
+        }
+    }
+    return resolved;
+}
+
+/**
+ * @brief Converts a filter value of a compact schema column.
+ * @param filter The filter.
+ * @return std::string Integer level or dictionary id (-1 for values not in the dictionary).
+ * @throws std::invalid_argument If a value cannot be converted or the operator is not supported by the column.
+ */
+std::string LogReader::toCompactParam(const Filter& filter) const
+{
+    if(filter.field == FIELD_LOG_LEVEL)
+    {
+        const LogLevel level = LogHelper::stringToLevel(filter.value);
+        if(level != LogLevel::Unknown)
+        {
+            return std::to_string(LogHelper::levelToInt(level));
+        }
+
+        const std::string& value = filter.value;
+        int levelInt = 0;
+        if(value.empty() || std::from_chars(value.data(), value.data() + value.size(), levelInt).ec != std::errc())
+        {
+            throw std::invalid_argument(ERR_MSG_INVALID_LEVEL + value);
+        }
+        return value;
+    }
+
+    // Ids carry no order, only equality can be mapped
+    if(filter.op != "=" && filter.op != "!=" && filter.op != "<>")
+    {
+        throw std::invalid_argument(ERR_MSG_COMPACT_FILTER_OP + filter.op);
+    }
+
+    const auto id = dictionaries->forField(filter.field)->findId(database, filter.value);
+    return std::to_string(id.value_or(-1));
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @brief Resolves a source ID through a per-query cache.
+ * @param sourceId The source ID to resolve.
+ * @param cache Sources already resolved in this query (misses are cached too).
+ * @return const std::optional<SourceInfo>& The source, or std::nullopt if not found or incomplete.
+ */
+const std::optional<SourceInfo> & LogReader::resolveSource(const int sourceId, SourceCache& cache)
+{
+    auto it = cache.find(sourceId);
+    if(it == cache.end())
+    {
+        auto src = getSourceById(sourceId);
+        if(src.has_value() && (src.value().uuid.empty() || src.value().name.empty()))
+        {
+            src.reset();
+        }
+        it = cache.emplace(sourceId, std::move(src)).first;
+    }
+    return it->second;
+}
+
 /**
  * @brief Retrieves a source by its source ID.
  * @param sourceId The source ID of the source to retrieve.
@@ -127,6 +836,18 @@ LogEntryList LogReader::getLogsByFilters(const std::vector<Filter> & filters,
  */
 std::optional<SourceInfo> LogReader::getSourceById(const int sourceId)
 {
+    if(database.supportsNativeLogs())
+    {
+        for(auto & source : database.selectSources())
+        {
+            if(source.sourceId == sourceId)
+            {
+                return source;
+            }
+        }
+        return std::nullopt;
+    }
+
     std::vector<Filter> filters =
     {
         {Filter::Type::SourceId, FIELD_SOURCES_ID, "=", std::to_string(sourceId)}
@@ -171,6 +892,18 @@ std::optional<SourceInfo> LogReader::getSourceById(const int sourceId)
  */
 std::optional<SourceInfo> LogReader::getSourceByUuid(const std::string& uuid)
 {
+    if(database.supportsNativeLogs())
+    {
+        for(auto & source : database.selectSources())
+        {
+            if(source.uuid == uuid)
+            {
+                return source;
+            }
+        }
+        return std::nullopt;
+    }
+
     std::vector<Filter> filters =
     {
         {Filter::Type::Unknown, FIELD_SOURCES_UUID, "=", uuid}
@@ -215,6 +948,18 @@ std::optional<SourceInfo> LogReader::getSourceByUuid(const std::string& uuid)
  */
 std::optional<SourceInfo> LogReader::getSourceByName(const std::string& name)
 {
+    if(database.supportsNativeLogs())
+    {
+        for(auto & source : database.selectSources())
+        {
+            if(source.name == name)
+            {
+                return source;
+            }
+        }
+        return std::nullopt;
+    }
+
     std::vector<Filter> filters =
     {
         {Filter::Type::Unknown, FIELD_SOURCES_NAME, "=", name}
@@ -258,6 +1003,11 @@ std::optional<SourceInfo> LogReader::getSourceByName(const std::string& name)
  */
 std::vector<SourceInfo> LogReader::getAllSources()
 {
+    if(database.supportsNativeLogs())
+    {
+        return database.selectSources();
+    }
+
     std::vector<std::string> fields =
     {
         FIELD_SOURCES_ID,
@@ -273,16 +1023,21 @@ std::vector<SourceInfo> LogReader::getAllSources()
                             FIELD_SOURCES_ID // order by ID
                         );
 
-    auto result = database.query(query);
+    const ResultSet result = database.queryResultSet(query);
     std::vector<SourceInfo> sources;
+    sources.reserve(result.rowCount());
+
+    const size_t colId = result.columnIndex(FIELD_SOURCES_ID);
+    const size_t colUuid = result.columnIndex(FIELD_SOURCES_UUID);
+    const size_t colName = result.columnIndex(FIELD_SOURCES_NAME);
 
-    for(const auto & row : result)
+    for(size_t row = 0; row < result.rowCount(); ++row)
     {
         sources.push_back(SourceInfo
         {
-            std::stoi(row.at(FIELD_SOURCES_ID)),
-            row.at(FIELD_SOURCES_UUID),
-               row.at(FIELD_SOURCES_NAME)
+            result.getInt(row, colId),
+            result.getString(row, colUuid),
+            result.getString(row, colName)
         });
     }
 
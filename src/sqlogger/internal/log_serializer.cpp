@@ -19,75 +19,630 @@
 
 #include "sqlogger/internal/log_serializer.h"
 
-std::string JsonParser::getString(const std::string& json, const std::string& key)
-{
-    size_t pos = json.find("\"" + key + "\":");
-    if(pos == std::string::npos) throw std::runtime_error("Key '" + key + "' not found");
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+    #define LOG_JSON_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define LOG_JSON_SIMD_NEON
+#endif
 
-    size_t start = json.find('"', pos + key.length() + 3) + 1;
-    size_t end = json.find('"', start);
-    return json.substr(start, end - start);
-}
+#define LOG_JSON_ENTRY_RESERVE 256 /**< Bytes reserved per serialized entry. */
 
-int JsonParser::getInt(const std::string& json, const std::string& key)
+/**
+ * @brief Finds the first character that must be escaped in a JSON string ('"', '\\' or a control character).
+ * Scans 16 bytes per step with SSE2 / NEON when available.
+ * @param begin Start of the text.
+ * @param end End of the text.
+ * @return const char* First character to escape, or end.
+ */
+static const char* findJsonEscape(const char* begin, const char* end)
 {
-    size_t pos = json.find("\"" + key + "\":");
-    if(pos == std::string::npos) throw std::runtime_error("Key '" + key + "' not found");
-
-    size_t start = json.find_first_of("0123456789-", pos + key.length() + 3);
-    size_t end = json.find_first_not_of("0123456789", start);
-    return std::stoi(json.substr(start, end - start));
+    const char* p = begin;
+#if defined(LOG_JSON_SIMD_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    for(; end - p >= 16; p += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                             _mm_cmpeq_epi8(chunk, backslash)),
+                                             _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk)); // chunk <= 0x1F
+        const int mask = _mm_movemask_epi8(special);
+        if(mask != 0)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward( & index, static_cast<unsigned long>(mask));
+            return p + index;
+#else
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+#endif
+        }
+    }
+#elif defined(LOG_JSON_SIMD_NEON)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    for(; end - p >= 16; p += 16)
+    {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(chunk, quote),
+                                            vceqq_u8(chunk, backslash)),
+                                            vcltq_u8(chunk, space));
+        if(vmaxvq_u8(special) != 0)
+        {
+            break; // the scalar loop finds the position within this block
+        }
+    }
+#endif
+    for(; p < end; ++p)
+    {
+        const unsigned char c = static_cast<unsigned char>( * p);
+        if(c == '"' || c == '\\' || c < 0x20)
+        {
+            return p;
+        }
+    }
+    return end;
 }
 
 /**
- * @brief Escapes special characters in a JSON string.
+ * @brief Appends a string to a buffer with JSON escaping.
+ * Runs of characters that need no escaping are copied in bulk.
+ * @param out Buffer to append to.
  * @param str The string to escape.
- * @return The escaped string.
  */
-std::string JsonParser::escapeJsonString(const std::string& str)
+void JsonParser::appendEscaped(std::string& out, std::string_view str)
 {
-    std::ostringstream oss;
-    for(char c : str)
+    static const char hex[] = "0123456789abcdef";
+    const char* p = str.data();
+    const char* end = p + str.size();
+    while(p < end)
     {
-        switch(c)
+        const char* next = findJsonEscape(p, end);
+        out.append(p, static_cast<size_t>(next - p));
+        if(next == end)
+        {
+            break;
+        }
+
+        switch( * next)
         {
             case '"':
-                oss << "\\\"";
+                out += "\\\"";
                 break;
             case '\\':
-                oss << "\\\\";
+                out += "\\\\";
                 break;
             case '\b':
-                oss << "\\b";
+                out += "\\b";
                 break;
             case '\f':
-                oss << "\\f";
+                out += "\\f";
                 break;
             case '\n':
-                oss << "\\n";
+                out += "\\n";
                 break;
             case '\r':
-                oss << "\\r";
+                out += "\\r";
                 break;
             case '\t':
-                oss << "\\t";
+                out += "\\t";
                 break;
             default:
-                if(static_cast<unsigned char>(c) <= 0x1F)
+                out += "\\u00";
+                out += hex[(static_cast<unsigned char>( * next) >> 4) & 0xF];
+                out += hex[static_cast<unsigned char>( * next) & 0xF];
+                break;
+        }
+        p = next + 1;
+    }
+}
+
+namespace
+{
+/**
+ * @class JsonReader
+ * @brief Single-pass reader over a JSON text, used by the built-in parser.
+ * Entries are parsed field by field in one scan instead of one key search per field.
+ */
+class JsonReader
+{
+    public:
+        /**
+         * @brief Constructs a reader.
+         * @param begin Start of the text.
+         * @param end End of the text.
+         */
+        JsonReader(const char* begin, const char* end) : p(begin), end(end) {};
+
+        /**
+         * @brief Skips whitespace.
+         */
+        void skipSpace()
+        {
+            while(p < end && (* p == ' ' || * p == '\n' || * p == '\r' || * p == '\t'))
+            {
+                ++p;
+            }
+        }
+
+        /**
+         * @brief Consumes a character if it comes next (after whitespace).
+         * @param c Expected character.
+         * @return bool True if consumed.
+         */
+        bool consume(const char c)
+        {
+            skipSpace();
+            if(p < end && * p == c)
+            {
+                ++p;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Consumes a character that must come next.
+         * @param c Expected character.
+         * @throws std::runtime_error If another character follows.
+         */
+        void expect(const char c)
+        {
+            if(!consume(c))
+            {
+                throw std::runtime_error(std::string("Expected '") + c + "'");
+            }
+        }
+
+        /**
+         * @brief Checks if the text is exhausted (after whitespace).
+         * @return bool True at the end.
+         */
+        bool atEnd()
+        {
+            skipSpace();
+            return p >= end;
+        }
+
+        /**
+         * @brief Reads a string value, decoding escapes (\\uXXXX to UTF-8).
+         * @param out Receives the decoded string.
+         */
+        void readString(std::string& out)
+        {
+            expect('"');
+            out.clear();
+            while(true)
+            {
+                const char* run = p;
+                while(p < end && * p != '"' && * p != '\\')
+                {
+                    ++p;
+                }
+                out.append(run, static_cast<size_t>(p - run));
+                if(p >= end)
+                {
+                    throw std::runtime_error("Unterminated string");
+                }
+                if( * p++ == '"')
+                {
+                    return;
+                }
+                readEscape(out);
+            }
+        }
+
+        /**
+         * @brief Reads an integer value (a quoted integer is accepted too).
+         * @return int64_t Value.
+         */
+        int64_t readInt()
+        {
+            skipSpace();
+            if(p < end && * p == '"')
+            {
+                std::string text;
+                readString(text);
+                return std::stoll(text);
+            }
+
+            const bool negative = p < end && * p == '-';
+            if(negative)
+            {
+                ++p;
+            }
+            if(p >= end || * p < '0' || * p > '9')
+            {
+                throw std::runtime_error("Expected a number");
+            }
+            int64_t value = 0;
+            while(p < end && * p >= '0' && * p <= '9')
+            {
+                value = value * 10 + ( * p++ - '0');
+            }
+            // Fractions and exponents are not used by log entries
+            while(p < end && (* p == '.' || * p == 'e' || * p == 'E' || * p == '+' || * p == '-' || ( * p >= '0' && * p <= '9')))
+            {
+                ++p;
+            }
+            return negative ? -value : value;
+        }
+
+        /**
+         * @brief Skips any value (string, number, literal, object or array).
+         */
+        void skipValue()
+        {
+            skipSpace();
+            if(p >= end)
+            {
+                throw std::runtime_error("Expected a value");
+            }
+
+            if( * p == '"')
+            {
+                std::string ignored;
+                readString(ignored);
+            }
+            else if( * p == '{' || * p == '[')
+            {
+                const char open = * p;
+                const char close = open == '{' ? '}' : ']';
+                ++p;
+                if(consume(close))
                 {
-                    oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
-                        << static_cast<int>(c);
+                    return;
                 }
-                else
+                do
+                {
+                    if(open == '{')
+                    {
+                        std::string key;
+                        readString(key);
+                        expect(':');
+                    }
+                    skipValue();
+                }
+                while(consume(','));
+                expect(close);
+            }
+            else
+            {
+                while(p < end && * p != ',' && * p != '}' && * p != ']' && * p != ' ' && * p != '\n' && * p != '\r' && * p != '\t')
+                {
+                    ++p;
+                }
+            }
+        }
+
+    private:
+        /**
+         * @brief Decodes the escape sequence after a backslash.
+         * @param out String to append the decoded character to.
+         */
+        void readEscape(std::string& out)
+        {
+            if(p >= end)
+            {
+                throw std::runtime_error("Unterminated string");
+            }
+            switch( * p++)
+            {
+                case '"':
+                    out += '"';
+                    break;
+                case '\\':
+                    out += '\\';
+                    break;
+                case '/':
+                    out += '/';
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u':
+                {
+                    uint32_t code = readHex4();
+                    if(code >= 0xD800 && code <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u')
+                    {
+                        p += 2;
+                        const uint32_t low = readHex4();
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Invalid escape sequence");
+            }
+        }
+
+        /**
+         * @brief Reads the 4 hex digits of a \\u escape.
+         * @return uint32_t Code unit.
+         */
+        uint32_t readHex4()
+        {
+            if(end - p < 4)
+            {
+                throw std::runtime_error("Invalid unicode escape");
+            }
+            uint32_t code = 0;
+            for(int i = 0; i < 4; ++i)
+            {
+                const char c = * p++;
+                code <<= 4;
+                if(c >= '0' && c <= '9') code |= static_cast<uint32_t>(c - '0');
+                else if(c >= 'a' && c <= 'f') code |= static_cast<uint32_t>(c - 'a' + 10);
+                else if(c >= 'A' && c <= 'F') code |= static_cast<uint32_t>(c - 'A' + 10);
+                else throw std::runtime_error("Invalid unicode escape");
+            }
+            return code;
+        }
+
+        /**
+         * @brief Appends a code point as UTF-8.
+         * @param out String to append to.
+         * @param code Code point.
+         */
+        static void appendUtf8(std::string& out, const uint32_t code)
+        {
+            if(code < 0x80)
+            {
+                out += static_cast<char>(code);
+            }
+            else if(code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if(code < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        const char* p; /**< Current position. */
+        const char* end; /**< End of the text. */
+};
+}
+
+/**
+ * @brief Reads one log entry object.
+ * Fields may come in any order; unknown fields are skipped.
+ * @param reader Reader positioned before the object.
+ * @return LogEntry Parsed entry.
+ * @throws std::runtime_error If the object is malformed or a field is missing.
+ */
+static LogEntry readLogEntry(JsonReader& reader)
+{
+    enum : unsigned
+    {
+        HasId = 1 << 0,
+        HasTimestamp = 1 << 1,
+        HasLevel = 1 << 2,
+        HasMessage = 1 << 3,
+        HasFunction = 1 << 4,
+        HasFile = 1 << 5,
+        HasLine = 1 << 6,
+        HasThreadId = 1 << 7
+    };
+    static const std::pair<unsigned, const char*> required[] =
+    {
+        {HasId, EXP_FIELD_ID}, {HasTimestamp, EXP_FIELD_TIMESTAMP}, {HasLevel, EXP_FIELD_LEVEL},
+        {HasMessage, EXP_FIELD_MESSAGE}, {HasFunction, EXP_FIELD_FUNCTION}, {HasFile, EXP_FIELD_FILE},
+        {HasLine, EXP_FIELD_LINE}, {HasThreadId, EXP_FIELD_THREAD_ID}
+    };
+
+    LogEntry entry;
+    unsigned found = 0;
+    std::string key;
+
+    reader.expect('{');
+    if(!reader.consume('}'))
+    {
+        do
+        {
+            reader.readString(key);
+            reader.expect(':');
+            if(key == EXP_FIELD_ID)
+            {
+                entry.id = static_cast<int>(reader.readInt());
+                found |= HasId;
+            }
+            else if(key == EXP_FIELD_TIMESTAMP)
+            {
+                reader.readString(entry.timestamp);
+                found |= HasTimestamp;
+            }
+            else if(key == EXP_FIELD_LEVEL)
+            {
+                reader.readString(entry.level);
+                found |= HasLevel;
+            }
+            else if(key == EXP_FIELD_MESSAGE)
+            {
+                reader.readString(entry.message);
+                found |= HasMessage;
+            }
+            else if(key == EXP_FIELD_FUNCTION)
+            {
+                reader.readString(entry.function);
+                found |= HasFunction;
+            }
+            else if(key == EXP_FIELD_FILE)
+            {
+                reader.readString(entry.file);
+                found |= HasFile;
+            }
+            else if(key == EXP_FIELD_LINE)
+            {
+                entry.line = static_cast<int>(reader.readInt());
+                found |= HasLine;
+            }
+            else if(key == EXP_FIELD_THREAD_ID)
+            {
+                reader.readString(entry.threadId);
+                found |= HasThreadId;
+            }
+#ifdef SQLG_USE_SOURCE_INFO
+            else if(key == EXP_FIELD_SOURCE)
+            {
+                reader.expect('{');
+                if(!reader.consume('}'))
                 {
-                    oss << c;
+                    do
+                    {
+                        reader.readString(key);
+                        reader.expect(':');
+                        if(key == EXP_FIELD_SOURCE_ID)
+                        {
+                            entry.sourceId = static_cast<int>(reader.readInt());
+                        }
+                        else if(key == EXP_FIELD_SOURCE_UUID)
+                        {
+                            reader.readString(entry.sourceUuid);
+                        }
+                        else if(key == EXP_FIELD_SOURCE_NAME)
+                        {
+                            reader.readString(entry.sourceName);
+                        }
+                        else
+                        {
+                            reader.skipValue();
+                        }
+                    }
+                    while(reader.consume(','));
+                    reader.expect('}');
                 }
+            }
+#endif
+            else
+            {
+                reader.skipValue();
+            }
         }
+        while(reader.consume(','));
+        reader.expect('}');
     }
-    return oss.str();
+
+    for(const auto & [flag, name] : required)
+    {
+        if((found & flag) == 0)
+        {
+            throw std::runtime_error("Key '" + std::string(name) + "' not found");
+        }
+    }
+    return entry;
 }
 
-std::string LogSerializer::Json::serializeLog(const LogEntry& entry)
+/**
+ * @brief Reads one filter object.
+ * Fields may come in any order; unknown fields are skipped.
+ * @param reader Reader positioned before the object.
+ * @return Filter Parsed filter.
+ * @throws std::runtime_error If the object is malformed or a field is missing.
+ */
+static Filter readFilter(JsonReader& reader)
+{
+    enum : unsigned
+    {
+        HasField = 1 << 0,
+        HasOp = 1 << 1,
+        HasValue = 1 << 2
+    };
+    static const std::pair<unsigned, const char*> required[] =
+    {
+        {HasField, EXP_FILTER_FIELD}, {HasOp, EXP_FILTER_OP}, {HasValue, EXP_FILTER_VALUE}
+    };
+
+    Filter filter;
+    unsigned found = 0;
+    std::string key;
+
+    reader.expect('{');
+    if(!reader.consume('}'))
+    {
+        do
+        {
+            reader.readString(key);
+            reader.expect(':');
+            if(key == EXP_FILTER_FIELD)
+            {
+                reader.readString(filter.field);
+                found |= HasField;
+            }
+            else if(key == EXP_FILTER_OP)
+            {
+                reader.readString(filter.op);
+                found |= HasOp;
+            }
+            else if(key == EXP_FILTER_VALUE)
+            {
+                reader.readString(filter.value);
+                found |= HasValue;
+            }
+            else
+            {
+                reader.skipValue();
+            }
+        }
+        while(reader.consume(','));
+        reader.expect('}');
+    }
+
+    for(const auto & [flag, name] : required)
+    {
+        if((found & flag) == 0)
+        {
+            throw std::runtime_error("Key '" + std::string(name) + "' not found");
+        }
+    }
+    filter.type = Filter::fieldToType(filter.field);
+    return filter;
+}
+
+/**
+ * @brief Appends a quoted, escaped JSON string value.
+ * @param out Buffer to append to.
+ * @param value String value.
+ */
+static void appendJsonString(std::string& out, const std::string& value)
+{
+    out += '"';
+    JsonParser::appendEscaped(out, value);
+    out += '"';
+}
+
+void LogSerializer::Json::appendLog(std::string& out, const LogEntry& entry)
 {
 #ifdef SQLG_USE_EXTERNAL_JSON_PARSER
 
@@ -110,45 +665,132 @@ std::string LogSerializer::Json::serializeLog(const LogEntry& entry)
     source[EXP_FIELD_SOURCE_NAME] = entry.sourceName;
     json[EXP_FIELD_SOURCE] = source;
 #endif
-    return json.dump(2);
+    out += json.dump(2);
 
 #else
-    std::ostringstream oss;
-    oss << "  {" << std::endl
-        << "    \"" << EXP_FIELD_ID << "\": " << entry.id << "," << std::endl
-        << "    \"" << EXP_FIELD_TIMESTAMP << "\": \"" << JsonParser::escapeJsonString(entry.timestamp) << "\"," << std::endl
-        << "    \"" << EXP_FIELD_LEVEL << "\": \"" << JsonParser::escapeJsonString(entry.level) << "\"," << std::endl
-        << "    \"" << EXP_FIELD_MESSAGE << "\": \"" << JsonParser::escapeJsonString(entry.message) << "\"," << std::endl
-        << "    \"" << EXP_FIELD_FUNCTION << "\": \"" << JsonParser::escapeJsonString(entry.function) << "\"," << std::endl
-        << "    \"" << EXP_FIELD_FILE << "\": \"" << JsonParser::escapeJsonString(entry.file) << "\"," << std::endl
-        << "    \"" << EXP_FIELD_LINE << "\": " << entry.line << "," << std::endl
-        << "    \"" << EXP_FIELD_THREAD_ID << "\": \"" << JsonParser::escapeJsonString(entry.threadId) << "\"";
+    out += "  {\n    \"" EXP_FIELD_ID "\": ";
+    out += std::to_string(entry.id);
+    out += ",\n    \"" EXP_FIELD_TIMESTAMP "\": ";
+    appendJsonString(out, entry.timestamp);
+    out += ",\n    \"" EXP_FIELD_LEVEL "\": ";
+    appendJsonString(out, entry.level);
+    out += ",\n    \"" EXP_FIELD_MESSAGE "\": ";
+    appendJsonString(out, entry.message);
+    out += ",\n    \"" EXP_FIELD_FUNCTION "\": ";
+    appendJsonString(out, entry.function);
+    out += ",\n    \"" EXP_FIELD_FILE "\": ";
+    appendJsonString(out, entry.file);
+    out += ",\n    \"" EXP_FIELD_LINE "\": ";
+    out += std::to_string(entry.line);
+    out += ",\n    \"" EXP_FIELD_THREAD_ID "\": ";
+    appendJsonString(out, entry.threadId);
 #ifdef SQLG_USE_SOURCE_INFO
-    oss << "," << std::endl
-        << "    \"" << EXP_FIELD_SOURCE << "\": " << std::endl
-        << "    {" << std::endl
-        << "      \"" << EXP_FIELD_SOURCE_ID << "\": \"" << entry.sourceId << "\"," << std::endl
-        << "      \"" << EXP_FIELD_SOURCE_UUID << "\": \"" << JsonParser::escapeJsonString(entry.sourceUuid) << "\"," << std::endl
-        << "      \"" << EXP_FIELD_SOURCE_NAME << "\": \"" << JsonParser::escapeJsonString(entry.sourceName) << "\"" << std::endl
-        << "    }";
+    out += ",\n    \"" EXP_FIELD_SOURCE "\": \n    {\n      \"" EXP_FIELD_SOURCE_ID "\": \"";
+    out += std::to_string(entry.sourceId);
+    out += "\",\n      \"" EXP_FIELD_SOURCE_UUID "\": ";
+    appendJsonString(out, entry.sourceUuid);
+    out += ",\n      \"" EXP_FIELD_SOURCE_NAME "\": ";
+    appendJsonString(out, entry.sourceName);
+    out += "\n    }";
 #endif
-    oss << std::endl << "  }";
-    return oss.str();
+    out += "\n  }";
 #endif
 }
 
+std::string LogSerializer::Json::serializeLog(const LogEntry& entry)
+{
+    std::string result;
+    result.reserve(LOG_JSON_ENTRY_RESERVE + entry.message.size());
+    appendLog(result, entry);
+    return result;
+}
+
 std::string LogSerializer::Json::serializeLogs(const LogEntryList& entries)
 {
-    std::ostringstream oss;
-    oss << "[" << std::endl;
+    std::string result;
+    result.reserve(entries.size() * LOG_JSON_ENTRY_RESERVE + 4);
+    result += "[\n";
     for(size_t i = 0; i < entries.size(); ++i)
     {
-        const auto& entry = entries[i];
-        oss << LogSerializer::Json::serializeLog(entry);
-        oss << (i < entries.size() - 1 ? "," : "") << std::endl;
+        appendLog(result, entries[i]);
+        result += i < entries.size() - 1 ? ",\n" : "\n";
     }
-    oss << "]" << std::endl;
-    return oss.str();
+    result += "]\n";
+    return result;
+}
+
+void LogSerializer::Json::appendLogLine(std::string& out, const LogEntry& entry)
+{
+#ifdef SQLG_USE_EXTERNAL_JSON_PARSER
+
+    nlohmann::json json;
+
+    json[EXP_FIELD_ID] = entry.id;
+    json[EXP_FIELD_TIMESTAMP] = entry.timestamp;
+    json[EXP_FIELD_LEVEL] = entry.level;
+    json[EXP_FIELD_MESSAGE] = entry.message;
+    json[EXP_FIELD_FUNCTION] = entry.function;
+    json[EXP_FIELD_FILE] = entry.file;
+    json[EXP_FIELD_LINE] = entry.line;
+    json[EXP_FIELD_THREAD_ID] = entry.threadId;
+
+#ifdef SQLG_USE_SOURCE_INFO
+    nlohmann::json source;
+    source[EXP_FIELD_SOURCE_ID] = entry.sourceId;
+    source[EXP_FIELD_SOURCE_UUID] = entry.sourceUuid;
+    source[EXP_FIELD_SOURCE_NAME] = entry.sourceName;
+    json[EXP_FIELD_SOURCE] = source;
+#endif
+    out += json.dump();
+
+#else
+    out += "{\"" EXP_FIELD_ID "\":";
+    out += std::to_string(entry.id);
+    out += ",\"" EXP_FIELD_TIMESTAMP "\":";
+    appendJsonString(out, entry.timestamp);
+    out += ",\"" EXP_FIELD_LEVEL "\":";
+    appendJsonString(out, entry.level);
+    out += ",\"" EXP_FIELD_MESSAGE "\":";
+    appendJsonString(out, entry.message);
+    out += ",\"" EXP_FIELD_FUNCTION "\":";
+    appendJsonString(out, entry.function);
+    out += ",\"" EXP_FIELD_FILE "\":";
+    appendJsonString(out, entry.file);
+    out += ",\"" EXP_FIELD_LINE "\":";
+    out += std::to_string(entry.line);
+    out += ",\"" EXP_FIELD_THREAD_ID "\":";
+    appendJsonString(out, entry.threadId);
+#ifdef SQLG_USE_SOURCE_INFO
+    out += ",\"" EXP_FIELD_SOURCE "\":{\"" EXP_FIELD_SOURCE_ID "\":";
+    out += std::to_string(entry.sourceId);
+    out += ",\"" EXP_FIELD_SOURCE_UUID "\":";
+    appendJsonString(out, entry.sourceUuid);
+    out += ",\"" EXP_FIELD_SOURCE_NAME "\":";
+    appendJsonString(out, entry.sourceName);
+    out += "}";
+#endif
+    out += "}";
+#endif
+}
+
+std::string LogSerializer::Json::serializeLogLine(const LogEntry& entry)
+{
+    std::string line;
+    line.reserve(LOG_JSON_ENTRY_RESERVE + entry.message.size());
+    appendLogLine(line, entry);
+    return line;
+}
+
+std::string LogSerializer::Json::serializeLogLines(const LogEntryList& entries)
+{
+    std::string lines;
+    lines.reserve(entries.size() * LOG_JSON_ENTRY_RESERVE);
+    for(const auto & entry : entries)
+    {
+        appendLogLine(lines, entry);
+        lines += "\n";
+    }
+    return lines;
 }
 
 std::string LogSerializer::Json::serializeFilter(const Filter& filter)
@@ -162,25 +804,28 @@ std::string LogSerializer::Json::serializeFilter(const Filter& filter)
 
     return json.dump(2);
 #else
-    std::ostringstream oss;
-    oss << "  {" << std::endl
-        << "    \"" << EXP_FILTER_FIELD << "\": " << filter.field << "\"," << std::endl
-        << "    \"" << EXP_FILTER_OP << "\": \"" << filter.op << "\"," << std::endl
-        << "    \"" << EXP_FILTER_VALUE << "\": \"" << filter.value << "\"," << std::endl
-        << std::endl << "  }" << std::endl;
-    return oss.str();
+    std::string out = "  {\n    \"" EXP_FILTER_FIELD "\": ";
+    appendJsonString(out, filter.field);
+    out += ",\n    \"" EXP_FILTER_OP "\": ";
+    appendJsonString(out, filter.op);
+    out += ",\n    \"" EXP_FILTER_VALUE "\": ";
+    appendJsonString(out, filter.value);
+    out += "\n  }";
+    return out;
 #endif
 }
 
 std::string LogSerializer::Json::serializeFilters(const std::vector<Filter> & filters)
 {
     std::ostringstream oss;
+    oss << "[" << std::endl;
     for(size_t i = 0; i < filters.size(); ++i)
     {
         const auto& filter = filters[i];
         oss << LogSerializer::Json::serializeFilter(filter)
             << (i < filters.size() - 1 ? "," : "") << std::endl;
     }
+    oss << "]";
     return oss.str();
 }
 
@@ -220,24 +865,8 @@ LogEntry LogSerializer::Json::parseLog(const std::string& jsonString)
 #else
     try
     {
-        entry.id = JsonParser::getInt(jsonString, EXP_FIELD_ID);
-        entry.timestamp = JsonParser::getString(jsonString, EXP_FIELD_TIMESTAMP);
-        entry.level = JsonParser::getString(jsonString, EXP_FIELD_LEVEL);
-        entry.message = JsonParser::getString(jsonString, EXP_FIELD_MESSAGE);
-        entry.function = JsonParser::getString(jsonString, EXP_FIELD_FUNCTION);
-        entry.file = JsonParser::getString(jsonString, EXP_FIELD_FILE);
-        entry.line = JsonParser::getInt(jsonString, EXP_FIELD_LINE);
-        entry.threadId = JsonParser::getString(jsonString, EXP_FIELD_THREAD_ID);
-
-#ifdef SQLG_USE_SOURCE_INFO
-        size_t source_start = jsonString.find("\"" + std::string(EXP_FIELD_SOURCE) + "\":{");
-        if(source_start != std::string::npos)
-        {
-            entry.sourceId = JsonParser::getInt(jsonString.substr(source_start), EXP_FIELD_SOURCE_ID);
-            entry.sourceUuid = JsonParser::getString(jsonString.substr(source_start), EXP_FIELD_SOURCE_UUID);
-            entry.sourceName = JsonParser::getString(jsonString.substr(source_start), EXP_FIELD_SOURCE_NAME);
-        }
-#endif
+        JsonReader reader(jsonString.data(), jsonString.data() + jsonString.size());
+        entry = readLogEntry(reader);
     }
     catch(const std::exception& e)
     {
@@ -270,40 +899,70 @@ LogEntryList LogSerializer::Json::parseLogs(const std::string& jsonArray)
     }
 
 #else
-    size_t start_pos = jsonArray.find('[');
-    size_t end_pos = jsonArray.rfind(']');
-
-    if(start_pos == std::string::npos || end_pos == std::string::npos)
+    const size_t start = jsonArray.find('[');
+    if(start == std::string::npos)
     {
         throw std::runtime_error("Invalid JSON array format");
     }
 
-    std::string content = jsonArray.substr(start_pos + 1, end_pos - start_pos - 1);
-    size_t brace_level = 0;
-    size_t item_start = 0;
-
-    for(size_t i = 0; i < content.size(); ++i)
+    JsonReader reader(jsonArray.data() + start + 1, jsonArray.data() + jsonArray.size());
+    try
     {
-        if(content[i] == '{')
+        if(!reader.consume(']'))
         {
-            if(brace_level == 0) item_start = i;
-            brace_level++;
-        }
-        else if(content[i] == '}')
-        {
-            brace_level--;
-            if(brace_level == 0)
+            do
             {
-                std::string item = content.substr(item_start, i - item_start + 1);
-                logs.push_back(parseLog(item));
+                logs.push_back(readLogEntry(reader));
             }
+            while(reader.consume(','));
+            reader.expect(']');
         }
     }
+    catch(const std::exception& e)
+    {
+        throw std::runtime_error("Failed to parse logs array: " + std::string(e.what()));
+    }
 #endif
 
     return logs;
 }
 
+size_t LogSerializer::Json::parseLogLines(std::istream& input, const LogCallback& callback)
+{
+    size_t count = 0;
+    std::string line;
+    while(std::getline(input, line))
+    {
+        if(!line.empty() && line.back() == '\r')
+        {
+            line.pop_back(); // CRLF input
+        }
+        if(line.find_first_not_of(" \t") == std::string::npos)
+        {
+            continue;
+        }
+
+        ++count;
+        if(!callback(parseLog(line)))
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+LogEntryList LogSerializer::Json::parseLogLines(const std::string& lines)
+{
+    LogEntryList logs;
+    std::istringstream input(lines);
+    parseLogLines(input, [ & logs](const LogEntry & entry)
+    {
+        logs.push_back(entry);
+        return true;
+    });
+    return logs;
+}
+
 std::vector<Filter> LogSerializer::Json::parseFilters(const std::string& jsonString)
 {
     std::vector<Filter> filters;
@@ -345,29 +1004,33 @@ std::vector<Filter> LogSerializer::Json::parseFilters(const std::string& jsonStr
     }
 
 #else
-    size_t pos = 0;
-    while((pos = jsonString.find('{', pos)) != std::string::npos)
+    JsonReader reader(jsonString.data(), jsonString.data() + jsonString.size());
+    try
     {
-        size_t end = jsonString.find('}', pos);
-        if(end == std::string::npos) break;
-
-        std::string filterStr = jsonString.substr(pos, end - pos + 1);
-
-        Filter filter;
-        try
+        if(reader.atEnd())
         {
-            filter.field = JsonParser::getString(filterStr, EXP_FILTER_FIELD);
-            filter.op = JsonParser::getString(filterStr, EXP_FILTER_OP);
-            filter.value = JsonParser::getString(filterStr, EXP_FILTER_VALUE);
-            filter.type = Filter::fieldToType(filter.field);
-            filters.push_back(filter);
+            return filters;
+        }
+        if(reader.consume('['))
+        {
+            if(!reader.consume(']'))
+            {
+                do
+                {
+                    filters.push_back(readFilter(reader));
+                }
+                while(reader.consume(','));
+                reader.expect(']');
+            }
         }
-        catch(const std::exception& e)
+        else
         {
-            throw std::runtime_error("Invalid filter format: " + std::string(e.what()));
+            filters.push_back(readFilter(reader));
         }
-
-        pos = end + 1;
+    }
+    catch(const std::exception& e)
+    {
+        throw std::runtime_error("Invalid filter format: " + std::string(e.what()));
     }
 #endif
 
@@ -0,0 +1,310 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include "sqlogger/internal/log_spool.h"
+#include "sqlogger/internal/log_binary.h"
+#include "sqlogger/internal/fs_helper.h"
+#include "sqlogger/internal/log_strings.h"
+
+/**
+ * @brief Computes the FNV-1a checksum of a record payload.
+ * @param data Payload bytes.
+ * @param size Payload size.
+ * @return uint32_t Checksum.
+ */
+static uint32_t spoolChecksum(const char* data, const size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Stores a 32-bit value in little-endian order.
+ * @param out Destination (4 bytes).
+ * @param value Value.
+ */
+static void putUInt32(char* out, const uint32_t value)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+/**
+ * @brief Loads a little-endian 32-bit value.
+ * @param in Source (4 bytes).
+ * @return uint32_t Value.
+ */
+static uint32_t getUInt32(const char* in)
+{
+    uint32_t value = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Opens (or creates) a spool file and recovers its unreplayed records.
+ * @param path Spool file path.
+ * @param maxBytes Maximum file size in bytes (0 = unlimited).
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+LogSpool::LogSpool(const std::string& path, const uint64_t maxBytes)
+    : path(path),
+      offsetPath(path + LOG_SPOOL_OFFSET_SUFFIX),
+      maxBytes(maxBytes)
+{
+    std::string errMsg;
+    if(!FSHelper::createDir(path, errMsg))
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_CREATE_DIR + errMsg);
+    }
+
+    recover();
+}
+
+/**
+ * @brief Appends entries as one record.
+ * @param entries Entries to append.
+ * @param count Number of entries.
+ * @return bool False if the spool is full or the write failed.
+ */
+bool LogSpool::append(const LogEntry* entries, const size_t count)
+{
+    if(count == 0)
+    {
+        return true;
+    }
+
+    std::string record(LOG_SPOOL_RECORD_HEADER_SIZE, '\0');
+    LogSerializer::Binary::appendLogs(record, entries, count);
+
+    const size_t payloadSize = record.size() - LOG_SPOOL_RECORD_HEADER_SIZE;
+    putUInt32( & record[0], static_cast<uint32_t>(payloadSize));
+    putUInt32( & record[4], spoolChecksum(record.data() + LOG_SPOOL_RECORD_HEADER_SIZE, payloadSize));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(maxBytes > 0 && writeOffset + record.size() > maxBytes)
+    {
+        return false;
+    }
+
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(writeOffset));
+    file.write(record.data(), static_cast<std::streamsize>(record.size()));
+    file.flush();
+    if(!file)
+    {
+        // Whatever was written past writeOffset is overwritten by the next append
+        file.clear();
+        return false;
+    }
+
+    writeOffset += record.size();
+    pendingBytes.store(writeOffset - readOffset, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Reads the oldest unreplayed records without consuming them.
+ * Whole records are read until at least maxEntries entries are collected.
+ * @param entries Receives the entries.
+ * @param maxEntries Entry count at which reading stops.
+ * @return size_t Number of entries read.
+ * @throws std::runtime_error If a record is corrupt (the spool is cut off before it).
+ */
+size_t LogSpool::peek(LogEntryList& entries, const size_t maxEntries)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const size_t before = entries.size();
+    uint64_t offset = readOffset;
+    std::string payload;
+    while(offset < writeOffset && entries.size() - before < maxEntries)
+    {
+        if(!readRecord(offset, payload))
+        {
+            writeOffset = offset;
+            peekOffset = offset;
+            pendingBytes.store(writeOffset - readOffset, std::memory_order_release);
+            throw std::runtime_error(ERR_MSG_SPOOL_CORRUPT + path);
+        }
+
+        LogEntryList records = LogSerializer::Binary::parseLogs(payload);
+        entries.insert(entries.end(),
+                       std::make_move_iterator(records.begin()),
+                       std::make_move_iterator(records.end()));
+        offset += LOG_SPOOL_RECORD_HEADER_SIZE + payload.size();
+    }
+
+    peekOffset = offset;
+    return entries.size() - before;
+}
+
+/**
+ * @brief Marks the records returned by the last peek() as replayed.
+ * Truncates the file when nothing is left to replay.
+ */
+void LogSpool::consume()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    readOffset = std::max(readOffset, peekOffset);
+    if(readOffset >= writeOffset)
+    {
+        open(true);
+        readOffset = 0;
+        writeOffset = 0;
+    }
+    peekOffset = readOffset;
+    pendingBytes.store(writeOffset - readOffset, std::memory_order_release);
+    saveOffset();
+}
+
+/**
+ * @brief Loads the replayed offset and cuts off a torn or corrupt tail.
+ */
+void LogSpool::recover()
+{
+    std::error_code error;
+    const uint64_t fileSize = std::filesystem::exists(path, error)
+                              ? static_cast<uint64_t>(std::filesystem::file_size(path, error))
+                              : 0;
+
+    std::ifstream offsetFile(offsetPath);
+    uint64_t storedOffset = 0;
+    if(!(offsetFile >> storedOffset) || storedOffset > fileSize)
+    {
+        storedOffset = 0;
+    }
+    offsetFile.close();
+
+    open(false);
+
+    readOffset = storedOffset;
+    writeOffset = fileSize;
+
+    // Keep the records up to the first one that is incomplete or corrupt
+    uint64_t offset = readOffset;
+    std::string payload;
+    while(offset < writeOffset && readRecord(offset, payload))
+    {
+        offset += LOG_SPOOL_RECORD_HEADER_SIZE + payload.size();
+    }
+    writeOffset = offset;
+
+    if(readOffset >= writeOffset)
+    {
+        open(true);
+        readOffset = 0;
+        writeOffset = 0;
+    }
+    else if(writeOffset < fileSize)
+    {
+        file.close();
+        std::filesystem::resize_file(path, writeOffset, error);
+        open(false);
+    }
+
+    peekOffset = readOffset;
+    pendingBytes.store(writeOffset - readOffset, std::memory_order_release);
+    saveOffset();
+}
+
+/**
+ * @brief Opens the spool file.
+ * @param truncate Whether to discard the file contents.
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+void LogSpool::open(const bool truncate)
+{
+    if(file.is_open())
+    {
+        file.close();
+    }
+
+    if(truncate || !std::filesystem::exists(path))
+    {
+        // in | out requires an existing file
+        std::ofstream create(path, std::ios::binary | std::ios::trunc);
+    }
+
+    file.clear();
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if(!file.is_open())
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + path);
+    }
+}
+
+/**
+ * @brief Reads the record at an offset.
+ * @param offset Record offset.
+ * @param payload Receives the record payload.
+ * @return bool False if the record is incomplete or its checksum does not match.
+ */
+bool LogSpool::readRecord(const uint64_t offset, std::string& payload)
+{
+    if(offset + LOG_SPOOL_RECORD_HEADER_SIZE > writeOffset)
+    {
+        return false;
+    }
+
+    char header[LOG_SPOOL_RECORD_HEADER_SIZE];
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+    if(!file.read(header, sizeof(header)))
+    {
+        return false;
+    }
+
+    const uint32_t size = getUInt32(header);
+    if(offset + LOG_SPOOL_RECORD_HEADER_SIZE + size > writeOffset)
+    {
+        return false;
+    }
+
+    payload.resize(size);
+    if(size > 0 && !file.read( & payload[0], size))
+    {
+        return false;
+    }
+    return spoolChecksum(payload.data(), payload.size()) == getUInt32(header + 4);
+}
+
+/**
+ * @brief Stores the replayed offset in the side file.
+ */
+void LogSpool::saveOffset() const
+{
+    std::ofstream offsetFile(offsetPath, std::ios::trunc);
+    offsetFile << readOffset;
+}
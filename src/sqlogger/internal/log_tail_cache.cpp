@@ -0,0 +1,720 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <mutex>
+#include "sqlogger/internal/log_tail_cache.h"
+#include "sqlogger/database/query_builder.h"
+#include "sqlogger/log_helper.h"
+
+namespace
+{
+    /**
+     * @enum CompareOp
+     * @brief Comparison evaluated by the cache.
+     */
+    enum class CompareOp
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    /**
+     * @brief Converts a filter operator.
+     * @param op Filter operator.
+     * @return std::optional<CompareOp> Comparison, or std::nullopt for LIKE, IN, IS NULL and unknown operators.
+     */
+    std::optional<CompareOp> toCompareOp(const std::string& op)
+    {
+        if(op == "=") return CompareOp::Equal;
+        if(op == "!=" || op == "<>") return CompareOp::NotEqual;
+        if(op == "<") return CompareOp::Less;
+        if(op == "<=") return CompareOp::LessEqual;
+        if(op == ">") return CompareOp::Greater;
+        if(op == ">=") return CompareOp::GreaterEqual;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Applies a comparison to a three-way comparison result.
+     * @param op Comparison.
+     * @param result Negative, zero or positive.
+     * @return bool Comparison outcome.
+     */
+    bool test(const CompareOp op, const int result)
+    {
+        switch(op)
+        {
+            case CompareOp::Equal:
+                return result == 0;
+            case CompareOp::NotEqual:
+                return result != 0;
+            case CompareOp::Less:
+                return result < 0;
+            case CompareOp::LessEqual:
+                return result <= 0;
+            case CompareOp::Greater:
+                return result > 0;
+            case CompareOp::GreaterEqual:
+                return result >= 0;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Three-way comparison of two integers.
+     */
+    int compareNumbers(const int64_t a, const int64_t b)
+    {
+        return a < b ? -1 : (a > b ? 1 : 0);
+    }
+
+    /**
+     * @brief Parses a whole string as an integer.
+     * @param value Text.
+     * @return std::optional<int64_t> Number, or std::nullopt if the text is not an integer.
+     */
+    std::optional<int64_t> toInteger(const std::string& value)
+    {
+        int64_t number = 0;
+        const auto result = std::from_chars(value.data(), value.data() + value.size(), number);
+        if(value.empty() || result.ec != std::errc() || result.ptr != value.data() + value.size())
+        {
+            return std::nullopt;
+        }
+        return number;
+    }
+
+    /**
+     * @brief Checks if a level string is one of the LOG_LEVEL_* names.
+     * Other spellings are stored and compared differently by the compact schema.
+     */
+    bool isCanonicalLevel(const std::string& level)
+    {
+        for(const char* name :
+                {
+                    LOG_LEVEL_UNKNOWN, LOG_LEVEL_TRACE, LOG_LEVEL_DEBUG, LOG_LEVEL_INFO,
+                    LOG_LEVEL_WARNING, LOG_LEVEL_ERROR, LOG_LEVEL_FATAL
+                })
+        {
+            if(level == name)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+/**
+ * @struct LogTailCache::Predicate
+ * @brief Filter compiled for the cache.
+ */
+struct LogTailCache::Predicate
+{
+    /**
+     * @enum Column
+     * @brief Log table column of the filter.
+     */
+    enum class Column
+    {
+        Id,
+        Line,
+#ifdef SQLG_USE_SOURCE_INFO
+        SourceId,
+#endif
+        Timestamp,
+        Level,
+        Message,
+        Function,
+        File,
+        ThreadId
+    };
+
+    Column column; /**< Filtered column. */
+    CompareOp op; /**< Comparison. */
+    int64_t number = 0; /**< Value of the integer columns. */
+    Key key; /**< Value of the timestamp. */
+    std::string text; /**< Value of the text columns. */
+};
+
+/**
+ * @brief Constructs an empty cache. Its floor is the current time, as the table
+ * may already hold older entries.
+ * @param capacity Maximum number of cached entries.
+ * @param logsTableName Log table name.
+ * @param databaseType Type of the database holding the table.
+ * @param timestampFormat Timestamp column format of the table.
+ */
+LogTailCache::LogTailCache(const size_t capacity,
+                           const std::string& logsTableName,
+                           const DataBaseType databaseType,
+                           const TimestampFormat timestampFormat)
+    : capacity(capacity),
+      logsTableName(logsTableName),
+      databaseType(databaseType),
+      timestampFormat(timestampFormat),
+      binaryText(databaseType != DataBaseType::MySQL)
+{
+    floor = nowKey();
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @brief Sets the source lookup used to fill the source UUID and name of cached entries.
+ * @param resolver Source lookup (entries of unknown sources invalidate the cache).
+ */
+void LogTailCache::setSourceResolver(SourceResolver resolver)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    sourceResolver = std::move(resolver);
+    sources.clear();
+}
+#endif
+
+/**
+ * @brief Adds entries that were just written by the connection.
+ * Once the last ID is known the new rows are selected by ID; the first time (and
+ * after the table was cleared) they are selected by timestamp above the floor.
+ * A row count that does not match the entries means that another writer added
+ * rows, and the cache starts over.
+ * @param database Connection that wrote the entries (queried for their IDs).
+ * @param entries The written entries, in insert order.
+ */
+void LogTailCache::append(IDatabase& database, const LogEntryList& entries)
+{
+    if(entries.empty())
+    {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    try
+    {
+        // Rows of the write with a known ID, in ID order
+        std::vector<size_t> rows;
+        std::vector<int64_t> ids;
+        if(lastId.has_value())
+        {
+            ids = selectIds(database, { Filter::Type::Unknown, FIELD_LOG_ID, ">", "" }, std::to_string(lastId.value()));
+            if(!ids.empty())
+            {
+                lastId = ids.back();
+            }
+            if(ids.size() != entries.size())
+            {
+                reset();
+                return;
+            }
+            rows.resize(entries.size());
+            for(size_t i = 0; i < rows.size(); ++i)
+            {
+                rows[i] = i;
+            }
+        }
+        else
+        {
+            // The last entry has the highest ID of the write only if it is above the floor
+            if(compareTimestamp(entries.back(), floor) <= 0)
+            {
+                return;
+            }
+            for(size_t i = 0; i < entries.size(); ++i)
+            {
+                if(compareTimestamp(entries[i], floor) > 0)
+                {
+                    rows.push_back(i);
+                }
+            }
+
+            ids = selectIds(database, { Filter::Type::TimestampRange, FIELD_LOG_TIMESTAMP, ">", "" },
+                            timestampFormat == TimestampFormat::EpochMicros ? std::to_string(floor.micros) : floor.text);
+            if(ids.size() != rows.size())
+            {
+                reset();
+                return;
+            }
+            lastId = ids.back();
+        }
+
+        for(size_t k = 0; k < rows.size(); ++k)
+        {
+            const LogEntry& written = entries[rows[k]];
+            if(compareTimestamp(written, floor) <= 0)
+            {
+                // Never returned by find()
+                continue;
+            }
+
+            LogEntry entry = written;
+            entry.id = static_cast<int>(ids[k]);
+            if(!normalize(entry))
+            {
+                reset();
+                return;
+            }
+            this->entries.push_back(std::move(entry));
+        }
+
+        while(this->entries.size() > capacity)
+        {
+            raiseFloor(keyOf(this->entries.front()));
+            this->entries.pop_front();
+        }
+    }
+    catch(const std::exception&)
+    {
+        reset();
+    }
+}
+
+/**
+ * @brief Drops the cached entries and moves the floor to the current time.
+ * Called when the table changes in a way the cache cannot follow.
+ */
+void LogTailCache::invalidate()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    reset();
+}
+
+/**
+ * @brief Drops the cached entries and the resolved sources (the table was cleared).
+ * The IDs of a cleared table may start over, so the next append() selects by timestamp.
+ */
+void LogTailCache::clear()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    reset();
+    lastId.reset();
+#ifdef SQLG_USE_SOURCE_INFO
+    sources.clear();
+#endif
+}
+
+/**
+ * @brief Answers a query from the cache if its result is known to be complete.
+ * The result is the one of LogReader::getLogsByFilters(): ordered by timestamp,
+ * entries with the same timestamp by ID.
+ * @param filters Query filters.
+ * @param limit Maximum number of entries (<= 0 = no limit).
+ * @param offset Entries skipped (only with a positive limit).
+ * @return std::optional<LogEntryList> Entries, or std::nullopt if the database must be queried.
+ */
+std::optional<LogEntryList> LogTailCache::find(const std::vector<Filter> & filters, const int limit, const int offset) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    std::vector<Predicate> predicates;
+    predicates.reserve(filters.size());
+    bool covered = false;
+    for(const auto & filter : filters)
+    {
+        auto predicate = compile(filter);
+        if(!predicate.has_value())
+        {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        covered = covered || covers(predicate.value());
+        predicates.push_back(std::move(predicate.value()));
+    }
+
+    if(!covered)
+    {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    auto matches = [ & ](const LogEntry & entry)
+    {
+        for(const auto & predicate : predicates)
+        {
+            int result = 0;
+            switch(predicate.column)
+            {
+                case Predicate::Column::Id:
+                    result = compareNumbers(entry.id, predicate.number);
+                    break;
+                case Predicate::Column::Line:
+                    result = compareNumbers(entry.line, predicate.number);
+                    break;
+#ifdef SQLG_USE_SOURCE_INFO
+                case Predicate::Column::SourceId:
+                    result = compareNumbers(entry.sourceId, predicate.number);
+                    break;
+#endif
+                case Predicate::Column::Timestamp:
+                    result = compareTimestamp(entry, predicate.key);
+                    break;
+                case Predicate::Column::Level:
+                    result = entry.level.compare(predicate.text);
+                    break;
+                case Predicate::Column::Message:
+                    result = entry.message.compare(predicate.text);
+                    break;
+                case Predicate::Column::Function:
+                    result = entry.function.compare(predicate.text);
+                    break;
+                case Predicate::Column::File:
+                    result = entry.file.compare(predicate.text);
+                    break;
+                case Predicate::Column::ThreadId:
+                    result = entry.threadId.compare(predicate.text);
+                    break;
+            }
+            if(!test(predicate.op, result))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<const LogEntry*> found;
+    for(const auto & entry : entries)
+    {
+        if(matches(entry))
+        {
+            found.push_back( & entry);
+        }
+    }
+
+    // Entries are in ID order, so entries with the same timestamp stay in ID order
+    const bool epochTimestamps = timestampFormat == TimestampFormat::EpochMicros;
+    std::stable_sort(found.begin(), found.end(), [ & ](const LogEntry * a, const LogEntry * b)
+    {
+        return epochTimestamps ? a->timestampUs < b->timestampUs : a->timestamp < b->timestamp;
+    });
+
+    size_t begin = 0;
+    size_t end = found.size();
+    if(limit > 0)
+    {
+        begin = std::min(found.size(), static_cast<size_t>(std::max(offset, 0)));
+        end = std::min(found.size(), begin + static_cast<size_t>(limit));
+    }
+
+    LogEntryList result;
+    result.reserve(end - begin);
+    for(size_t i = begin; i < end; ++i)
+    {
+        result.push_back( * found[i]);
+    }
+
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief Gets the number of cached entries.
+ * @return size_t Entry count.
+ */
+size_t LogTailCache::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries.size();
+}
+
+/**
+ * @brief Converts a filter to a predicate.
+ * Text columns are compared for (in)equality only and not on MySQL, whose collations
+ * ignore case and trailing spaces; levels must be spelled as LOG_LEVEL_* names.
+ * @param filter The filter.
+ * @return std::optional<Predicate> Predicate, or std::nullopt if the cache cannot evaluate the filter.
+ */
+std::optional<LogTailCache::Predicate> LogTailCache::compile(const Filter& filter) const
+{
+    const auto op = toCompareOp(filter.op);
+    if(!op.has_value())
+    {
+        return std::nullopt;
+    }
+
+    Predicate predicate;
+    predicate.op = op.value();
+
+    const std::string& field = filter.field;
+    if(field == FIELD_LOG_ID || field == FIELD_LOG_LINE
+#ifdef SQLG_USE_SOURCE_INFO
+            || field == FIELD_LOG_SOURCES_ID
+#endif
+      )
+    {
+        const auto number = toInteger(filter.value);
+        if(!number.has_value())
+        {
+            return std::nullopt;
+        }
+        predicate.number = number.value();
+        predicate.column = field == FIELD_LOG_ID ? Predicate::Column::Id : Predicate::Column::Line;
+#ifdef SQLG_USE_SOURCE_INFO
+        if(field == FIELD_LOG_SOURCES_ID)
+        {
+            predicate.column = Predicate::Column::SourceId;
+        }
+#endif
+        return predicate;
+    }
+
+    if(field == FIELD_LOG_TIMESTAMP)
+    {
+        predicate.column = Predicate::Column::Timestamp;
+        if(timestampFormat == TimestampFormat::EpochMicros)
+        {
+            const auto micros = LogHelper::parseEpochMicros(filter.value);
+            if(!micros.has_value())
+            {
+                return std::nullopt;
+            }
+            predicate.key.micros = micros.value();
+        }
+        else
+        {
+            // Only full TIMESTAMP_FMT values order the same as text and as DATETIME
+            if(filter.value.size() != floor.text.size())
+            {
+                return std::nullopt;
+            }
+            predicate.key.text = filter.value;
+        }
+        return predicate;
+    }
+
+    if(!binaryText || (predicate.op != CompareOp::Equal && predicate.op != CompareOp::NotEqual))
+    {
+        return std::nullopt;
+    }
+
+    predicate.text = filter.value;
+    if(field == FIELD_LOG_LEVEL)
+    {
+        // The compact schema rejects UNKNOWN as a filter value
+        if(!isCanonicalLevel(filter.value) || filter.value == LOG_LEVEL_UNKNOWN)
+        {
+            return std::nullopt;
+        }
+        predicate.column = Predicate::Column::Level;
+    }
+    else if(field == FIELD_LOG_MESSAGE)
+    {
+        predicate.column = Predicate::Column::Message;
+    }
+    else if(field == FIELD_LOG_FUNCTION)
+    {
+        predicate.column = Predicate::Column::Function;
+    }
+    else if(field == FIELD_LOG_FILE)
+    {
+        predicate.column = Predicate::Column::File;
+    }
+    else if(field == FIELD_LOG_THREAD_ID)
+    {
+        predicate.column = Predicate::Column::ThreadId;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+    return predicate;
+}
+
+/**
+ * @brief Checks if a lower timestamp bound excludes every entry at or below the floor.
+ * @param predicate Timestamp predicate.
+ * @return bool True if all matching entries are cached.
+ */
+bool LogTailCache::covers(const Predicate& predicate) const
+{
+    if(predicate.column != Predicate::Column::Timestamp)
+    {
+        return false;
+    }
+
+    const int result = timestampFormat == TimestampFormat::EpochMicros
+                       ? compareNumbers(predicate.key.micros, floor.micros)
+                       : predicate.key.text.compare(floor.text);
+    switch(predicate.op)
+    {
+        case CompareOp::Greater:
+            return result >= 0;
+        case CompareOp::GreaterEqual:
+        case CompareOp::Equal:
+            return result > 0;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Compares the timestamp of an entry with a key.
+ * @param entry The entry.
+ * @param key The key.
+ * @return int Negative, zero or positive.
+ */
+int LogTailCache::compareTimestamp(const LogEntry& entry, const Key& key) const
+{
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        return compareNumbers(entry.timestampUs, key.micros);
+    }
+    const int result = entry.timestamp.compare(key.text);
+    return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+/**
+ * @brief Selects the IDs the database assigned since the last append.
+ * @param database Connection that wrote the entries.
+ * @param filter Range of the new rows (id > last, or timestamp > floor).
+ * @param param Value bound to the filter.
+ * @return std::vector<int64_t> IDs in ascending order.
+ */
+std::vector<int64_t> LogTailCache::selectIds(IDatabase& database, const Filter& filter, const std::string& param) const
+{
+    std::string query = QueryBuilder::buildSelect(
+                            databaseType,
+                            logsTableName,
+    { FIELD_LOG_ID },
+    { filter },
+    FIELD_LOG_ID
+                        );
+
+    const ResultSet result = database.queryResultSet(query, { param });
+    const size_t colId = result.columnIndex(FIELD_LOG_ID);
+
+    std::vector<int64_t> ids;
+    ids.reserve(result.rowCount());
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        ids.push_back(result.getInt64(row, colId));
+    }
+    return ids;
+}
+
+/**
+ * @brief Converts a written entry to the form LogReader returns it in.
+ * @param entry The entry (the ID is set).
+ * @return bool False if its level is not a LOG_LEVEL_* name or its source could not be resolved.
+ */
+bool LogTailCache::normalize(LogEntry& entry)
+{
+    if(!isCanonicalLevel(entry.level))
+    {
+        return false;
+    }
+
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        entry.timestamp = LogHelper::formatEpochMicros(entry.timestampUs);
+    }
+    else
+    {
+        entry.timestampUs = 0;
+    }
+
+#ifdef SQLG_USE_SOURCE_INFO
+    auto it = sources.find(entry.sourceId);
+    if(it == sources.end())
+    {
+        if(!sourceResolver)
+        {
+            return false;
+        }
+        auto source = entry.sourceId == SOURCE_NOT_FOUND ? std::nullopt : sourceResolver(entry.sourceId);
+        if(source.has_value() && (source.value().uuid.empty() || source.value().name.empty()))
+        {
+            source.reset();
+        }
+        it = sources.emplace(entry.sourceId, std::move(source)).first;
+    }
+    entry.sourceUuid = it->second.has_value() ? it->second.value().uuid : std::string();
+    entry.sourceName = it->second.has_value() ? it->second.value().name : std::string();
+#endif
+    return true;
+}
+
+/**
+ * @brief Drops the entries and moves the floor to now (mutex held).
+ */
+void LogTailCache::reset()
+{
+    entries.clear();
+    raiseFloor(nowKey());
+}
+
+/**
+ * @brief Moves the floor to a key if it is newer.
+ * @param key The key.
+ */
+void LogTailCache::raiseFloor(const Key& key)
+{
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        floor.micros = std::max(floor.micros, key.micros);
+    }
+    else if(key.text > floor.text)
+    {
+        floor.text = key.text;
+    }
+}
+
+/**
+ * @brief Gets the key of an entry.
+ * @param entry The entry.
+ * @return Key Timestamp key.
+ */
+LogTailCache::Key LogTailCache::keyOf(const LogEntry& entry) const
+{
+    Key key;
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        key.micros = entry.timestampUs;
+    }
+    else
+    {
+        key.text = entry.timestamp;
+    }
+    return key;
+}
+
+/**
+ * @brief Gets the key of the current time.
+ * @return Key Timestamp key.
+ */
+LogTailCache::Key LogTailCache::nowKey() const
+{
+    const auto now = std::chrono::system_clock::now();
+    Key key;
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        key.micros = LogHelper::toEpochMicros(now);
+    }
+    else
+    {
+        key.text = LogHelper::formatTime(now);
+    }
+    return key;
+}
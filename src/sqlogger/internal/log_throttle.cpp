@@ -0,0 +1,237 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <functional>
+#include <random>
+#include <thread>
+#include "sqlogger/internal/log_throttle.h"
+
+/**
+ * @brief Constructs a throttle.
+ * @param sampleRate Probability of keeping an entry below sampleLevel (1 = keep all).
+ * @param sampleLevel Entries below this level are sampled.
+ * @param perSite Entries per second kept for each call site (0 = unlimited).
+ * @param perLevel Entries per second kept for each level (0 = unlimited).
+ * @param dedupWindow Window in which identical entries of a call site are folded (0 = disabled).
+ */
+LogThrottle::LogThrottle(const double sampleRate, const LogLevel sampleLevel,
+                         const size_t perSite, const size_t perLevel,
+                         const std::chrono::milliseconds& dedupWindow)
+    : sampleRate(sampleRate),
+      sampleLevel(sampleLevel),
+      perSite(perSite),
+      perLevel(perLevel),
+      dedupWindow(dedupWindow)
+{
+}
+
+/**
+ * @brief Decides whether an entry is logged.
+ * @param level The severity level.
+ * @param message The message (or format string).
+ * @param args Packed format arguments (compared together with the message).
+ * @param function The calling function.
+ * @param file The calling file.
+ * @param line The calling line.
+ * @param repeat Set to the pending repeat count of the call site when it must be logged
+ * before the entry (the entry itself may still be dropped).
+ * @return Verdict Accept if the entry is logged.
+ */
+LogThrottle::Verdict LogThrottle::admit(const LogLevel level, std::string_view message, std::string_view args,
+                                        std::string_view function, std::string_view file, const int line,
+                                        std::optional<Repeat>& repeat)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const uint64_t key = std::hash<std::string_view> {}(file) * 31 + static_cast<uint64_t>(line);
+    Shard& shard = shards[key % LOG_THROTTLE_SHARDS];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Site& site = getSite(shard, key, file, line);
+
+    // The last message is stored as message '\0' args
+    const bool same = site.level == level
+                      && site.message.size() == message.size() + 1 + args.size()
+                      && site.message.compare(0, message.size(), message) == 0
+                      && site.message.compare(message.size() + 1, args.size(), args) == 0;
+
+    if(dedupWindow.count() > 0 && same && now - site.dedupStart < dedupWindow)
+    {
+        ++site.repeats;
+        repeated.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::Repeated;
+    }
+
+    if(!sample(level))
+    {
+        sampled.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::Sampled;
+    }
+
+    if(perSite > 0 && now - site.windowStart >= std::chrono::seconds(1))
+    {
+        site.windowStart = now;
+        site.windowCount = 0;
+    }
+    if((perSite > 0 && site.windowCount >= perSite) || !admitLevel(level, now))
+    {
+        rateLimited.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::RateLimited;
+    }
+    ++site.windowCount;
+
+    if(dedupWindow.count() > 0)
+    {
+        // The repeat count belongs right before the next logged entry of the site
+        if(site.repeats > 0)
+        {
+            repeat = Repeat{ site.level, site.function, site.file, site.line, site.repeats };
+            site.repeats = 0;
+        }
+        if(!same)
+        {
+            site.message.assign(message);
+            site.message.push_back('\0');
+            site.message.append(args);
+            site.function.assign(function);
+            site.level = level;
+        }
+        site.dedupStart = now;
+    }
+    return Verdict::Accept;
+}
+
+/**
+ * @brief Takes the pending repeat counts of every call site (e.g. on flush).
+ * @return std::vector<Repeat> Repeat counts to log.
+ */
+std::vector<LogThrottle::Repeat> LogThrottle::takeRepeats()
+{
+    std::vector<Repeat> result;
+    for(auto & shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for(auto & bucket : shard.sites)
+        {
+            for(auto & site : bucket.second)
+            {
+                if(site.repeats > 0)
+                {
+                    result.push_back(Repeat{ site.level, site.function, site.file, site.line, site.repeats });
+                    site.repeats = 0;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Gets the suppression counters.
+ * @return Stats Counters.
+ */
+LogThrottle::Stats LogThrottle::getStats() const
+{
+    Stats stats;
+    stats.sampled = sampled.load(std::memory_order_relaxed);
+    stats.rateLimited = rateLimited.load(std::memory_order_relaxed);
+    stats.repeated = repeated.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief Resets the suppression counters.
+ */
+void LogThrottle::resetStats()
+{
+    sampled = 0;
+    rateLimited = 0;
+    repeated = 0;
+}
+
+/**
+ * @brief Finds or adds a call site (shard mutex held).
+ * @param shard Shard of the site.
+ * @param key Hash of file and line.
+ * @param file The calling file.
+ * @param line The calling line.
+ * @return Site& Call site state.
+ */
+LogThrottle::Site& LogThrottle::getSite(Shard& shard, const uint64_t key, std::string_view file, const int line)
+{
+    auto & bucket = shard.sites[key];
+    for(auto & site : bucket)
+    {
+        if(site.line == line && site.file == file)
+        {
+            return site;
+        }
+    }
+
+    Site site;
+    site.file = std::string(file);
+    site.line = line;
+    bucket.push_back(std::move(site));
+    return bucket.back();
+}
+
+/**
+ * @brief Checks the sample rate.
+ * @param level The severity level.
+ * @return bool True if the entry is kept.
+ */
+bool LogThrottle::sample(const LogLevel level) const
+{
+    if(sampleRate >= 1.0 || level >= sampleLevel)
+    {
+        return true;
+    }
+
+    thread_local std::minstd_rand engine(static_cast<std::minstd_rand::result_type>(
+            std::hash<std::thread::id> {}(std::this_thread::get_id())
+            ^ static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count())));
+    return std::uniform_real_distribution<double>(0.0, 1.0)(engine) < sampleRate;
+}
+
+/**
+ * @brief Checks and counts the rate limit of a level.
+ * @param level The severity level.
+ * @param now Current time.
+ * @return bool True if the entry is kept.
+ */
+bool LogThrottle::admitLevel(const LogLevel level, const std::chrono::steady_clock::time_point& now)
+{
+    const int index = static_cast<int>(level);
+    if(perLevel == 0 || index < 0 || index >= LOG_THROTTLE_LEVELS)
+    {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(levelMutex);
+    if(now - levelStart[index] >= std::chrono::seconds(1))
+    {
+        levelStart[index] = now;
+        levelCount[index] = 0;
+    }
+    if(levelCount[index] >= perLevel)
+    {
+        return false;
+    }
+    ++levelCount[index];
+    return true;
+}
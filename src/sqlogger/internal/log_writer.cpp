@@ -17,7 +17,9 @@
  * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
  */
 
+#include <algorithm>
 #include "sqlogger/internal/log_writer.h"
+#include "sqlogger/log_helper.h"
 
 /**
  * @brief Writes a log entry to the database.
@@ -26,47 +28,84 @@
  */
 bool LogWriter::writeLog(const LogEntry& entry)
 {
-    std::vector<std::pair<std::string, std::string>> values =
-    {
-#ifdef SQLG_USE_SOURCE_INFO
-        {FIELD_LOG_SOURCES_ID, std::to_string(entry.sourceId)},
-#endif
-        {FIELD_LOG_TIMESTAMP, entry.timestamp},
-        {FIELD_LOG_LEVEL, entry.level},
-        {FIELD_LOG_MESSAGE, entry.message},
-        {FIELD_LOG_FUNCTION, entry.function},
-        {FIELD_LOG_FILE, entry.file},
-        {FIELD_LOG_LINE, std::to_string(entry.line)},
-        {FIELD_LOG_THREAD_ID, entry.threadId}
-    };
-
-    std::string query = QueryBuilder::buildInsert(
-                            database.getDatabaseType(),
-                            logsTableName,
-                            values
-                        );
+    const LogEntryList compressed = messageCompressor
+                                    ? messageCompressor->compressMessages(database, LogEntryList{ entry })
+                                    : LogEntryList();
+    const LogEntry& stored = compressed.empty() ? entry : compressed.front();
 
-    std::vector<std::string> params;
-    for(const auto & [_, value] : values)
+    // Joins an open group, but never opens one
+    const bool grouped = beginGroupWrite(false);
+    bool written = false;
+    if(partitions)
     {
-        params.push_back(value);
+        const int day = partitions->dayOf(entry);
+        if(preparePartition(day))
+        {
+            const std::string table = getPartitionTable(day);
+            written = !table.empty() && insertLog(stored, table);
+        }
     }
-
-    return database.execute(query, params);
+    else
+    {
+        written = insertLog(stored, logsTableName);
+    }
+    if(grouped)
+    {
+        written = endGroupWrite(LogEntryList{ entry }, written, false);
+    }
+    if(tailCache)
+    {
+        cacheWritten(LogEntryList{ entry }, written);
+    }
+    return written;
 }
 
 /**
  * @brief Executes a batch insert of log entries into the database.
- * Constructs and executes a parameterized batch INSERT query optimized for the current database type.
- * @param entries List of log entries to insert. Each entry must contain all required fields.
+ * @param entries List of log entries to insert.
  * @return bool True if the batch insert succeeded, false otherwise.
- * @throws std::runtime_error If database execution fails (handled internally).
+ * @see insertLogBatch()
  */
 bool LogWriter::writeLogBatch(const LogEntryList& entries)
 {
-    if(entries.empty()) return true;
+    // A trained dictionary is stored before the batch, outside its transaction
+    const LogEntryList compressed = messageCompressor
+                                    ? messageCompressor->compressMessages(database, entries)
+                                    : LogEntryList();
+    const LogEntryList& stored = messageCompressor ? compressed : entries;
 
-    const std::vector<std::string> fields =
+    const bool grouped = beginGroupWrite(true);
+    bool written = insertEntries(stored);
+    if(grouped)
+    {
+        written = endGroupWrite(entries, written, true);
+    }
+    if(tailCache)
+    {
+        cacheWritten(entries, written);
+    }
+    return written;
+}
+
+/**
+ * @brief Inserts stored (compressed) entries into the log table or their partitions.
+ * @param entries List of log entries to insert.
+ * @return bool True if the insert succeeded, false otherwise.
+ */
+bool LogWriter::insertEntries(const LogEntryList& entries)
+{
+    return partitions
+           ? insertPartitionedBatch(entries)
+           : insertLogBatch(entries, logsTableName);
+}
+
+/**
+ * @brief Gets the log table columns written by the inserts, in parameter order.
+ * @return const std::vector<std::string>& Column names.
+ */
+const std::vector<std::string> & LogWriter::getInsertFields()
+{
+    static const std::vector<std::string> fields =
     {
 #ifdef SQLG_USE_SOURCE_INFO
         FIELD_LOG_SOURCES_ID,
@@ -79,35 +118,934 @@ bool LogWriter::writeLogBatch(const LogEntryList& entries)
         FIELD_LOG_LINE,
         FIELD_LOG_THREAD_ID
     };
+    return fields;
+}
 
-    std::string query = QueryBuilder::buildBatchInsert(
-                            logsTableName,
-                            fields,
-                            entries.size(),
-                            database.getDatabaseType()
-                        );
+/**
+ * @brief Inserts a log entry.
+ * @param entry The log entry to write.
+ * @param table Target table (the log table or a SQLite partition table).
+ * @return True if the log entry was written successfully, false otherwise.
+ */
+bool LogWriter::insertLog(const LogEntry& entry, const std::string& table)
+{
+    if(database.supportsNativeLogs())
+    {
+        return database.insertLogs(table, LogEntryList{ entry });
+    }
+
+    const bool epochTimestamps = timestampFormat == TimestampFormat::EpochMicros;
 
-    // SQL
-    std::vector<std::string> params;
-    if(database.getDatabaseType() != DataBaseType::MongoDB)
+    std::optional<CompactColumns> compact;
+    if(dictionaries)
     {
-        params.reserve(entries.size() * fields.size());
+        compact = toCompactColumns(entry);
+        if(!compact.has_value())
+        {
+            return false;
+        }
+    }
+
+    // A one-row batch insert: the statement text is cached by QueryBuilder
+    const std::string query = QueryBuilder::buildBatchInsert(
+                                  table,
+                                  getInsertFields(),
+                                  1,
+                                  database.getDatabaseType()
+                              );
+
+    DbParamList params =
+    {
+#ifdef SQLG_USE_SOURCE_INFO
+        DbParam(entry.sourceId),
+#endif
+        epochTimestamps ? DbParam(entry.timestampUs) : DbParam(entry.timestamp),
+        compact ? DbParam(compact->level) : DbParam(entry.level),
+        DbParam(entry.message),
+        compact ? DbParam(compact->function) : DbParam(entry.function),
+        compact ? DbParam(compact->file) : DbParam(entry.file),
+        DbParam(entry.line),
+        compact ? DbParam(compact->threadId) : DbParam(entry.threadId)
+    };
+
+    return database.execute(query, params);
+}
+
+/**
+ * @brief Inserts a batch of log entries.
+ * Constructs and executes a parameterized batch INSERT query optimized for the current database type,
+ * or loads the entries with IDatabase::bulkInsert() once the batch reaches the bulk-load threshold.
+ * @param entries List of log entries to insert. Each entry must contain all required fields.
+ * @param table Target table (the log table or a SQLite partition table).
+ * @return bool True if the batch insert succeeded, false otherwise.
+ * @throws std::runtime_error If database execution fails (handled internally).
+ */
+bool LogWriter::insertLogBatch(const LogEntryList& entries, const std::string& table)
+{
+    if(entries.empty()) return true;
+
+    if(database.supportsNativeLogs())
+    {
+        // No SQL: the backend stores the entries as they are, writes are never transactional
+        return database.insertLogs(table, entries);
+    }
+
+    const std::vector<std::string> & fields = getInsertFields();
+
+    const bool epochTimestamps = timestampFormat == TimestampFormat::EpochMicros;
+    const bool useBulk = bulkLoadThreshold > 0 && entries.size() >= bulkLoadThreshold && database.supportsBulkInsert();
+
+    // Compact schema: resolve the dictionary ids before binding the batch
+    std::vector<CompactColumns> compact;
+    if(dictionaries)
+    {
+        compact.reserve(entries.size());
         for(const auto & entry : entries)
         {
+            auto columns = toCompactColumns(entry);
+            if(!columns.has_value())
+            {
+                return false;
+            }
+            compact.push_back(columns.value());
+        }
+    }
+
+    std::string query;
+    if(!useBulk)
+    {
+        query = QueryBuilder::buildBatchInsert(
+                    table,
+                    fields,
+                    entries.size(),
+                    database.getDatabaseType()
+                );
+    }
+
+    // SQL: typed parameters reference the entries, bulk load needs the text form
+    std::vector<std::string> bulkValues;
+    DbParamList params;
+    if(useBulk)
+    {
+        bulkValues.reserve(entries.size() * fields.size());
+        for(size_t i = 0; i < entries.size(); ++i)
+        {
+            const auto & entry = entries[i];
 #ifdef SQLG_USE_SOURCE_INFO
-            params.push_back(std::to_string(entry.sourceId));
+            bulkValues.push_back(std::to_string(entry.sourceId));
 #endif
-            params.push_back(entry.timestamp);
-            params.push_back(entry.level);
-            params.push_back(entry.message);
-            params.push_back(entry.function);
-            params.push_back(entry.file);
-            params.push_back(std::to_string(entry.line));
-            params.push_back(entry.threadId);
+            bulkValues.push_back(epochTimestamps ? std::to_string(entry.timestampUs) : entry.timestamp);
+            bulkValues.push_back(compact.empty() ? entry.level : std::to_string(compact[i].level));
+            bulkValues.push_back(entry.message);
+            bulkValues.push_back(compact.empty() ? entry.function : std::to_string(compact[i].function));
+            bulkValues.push_back(compact.empty() ? entry.file : std::to_string(compact[i].file));
+            bulkValues.push_back(std::to_string(entry.line));
+            bulkValues.push_back(compact.empty() ? entry.threadId : std::to_string(compact[i].threadId));
+        }
+    }
+    else if(database.getDatabaseType() != DataBaseType::MongoDB)
+    {
+        params.reserve(entries.size() * fields.size());
+        for(size_t i = 0; i < entries.size(); ++i)
+        {
+            const auto & entry = entries[i];
+#ifdef SQLG_USE_SOURCE_INFO
+            params.emplace_back(entry.sourceId);
+#endif
+            if(epochTimestamps)
+            {
+                params.emplace_back(entry.timestampUs);
+            }
+            else
+            {
+                params.emplace_back(entry.timestamp);
+            }
+            if(!compact.empty())
+            {
+                params.emplace_back(compact[i].level);
+                params.emplace_back(entry.message);
+                params.emplace_back(compact[i].function);
+                params.emplace_back(compact[i].file);
+                params.emplace_back(entry.line);
+                params.emplace_back(compact[i].threadId);
+                continue;
+            }
+            params.emplace_back(entry.level);
+            params.emplace_back(entry.message);
+            params.emplace_back(entry.function);
+            params.emplace_back(entry.file);
+            params.emplace_back(entry.line);
+            params.emplace_back(entry.threadId);
         }
     }
 
-    return database.execute(query, params);
+    return useBulk
+           ? database.bulkInsert(table, fields, bulkValues)
+           : database.execute(query, params);
+}
+
+/**
+ * @brief Inserts a batch of log entries into their partitions.
+ * On SQLite every run of entries of the same day is a separate insert, and
+ * several runs are written in one transaction unless a group is open.
+ * @param entries List of log entries to insert.
+ * @return bool True if the batch insert succeeded, false otherwise.
+ */
+bool LogWriter::insertPartitionedBatch(const LogEntryList& entries)
+{
+    if(entries.empty()) return true;
+
+    // Runs of consecutive entries of the same day: first entry, day
+    std::vector<std::pair<size_t, int>> runs;
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        const int day = partitions->dayOf(entries[i]);
+        if(runs.empty() || runs.back().second != day)
+        {
+            runs.emplace_back(i, day);
+        }
+    }
+
+    // DDL first, the inserts may share a transaction
+    for(const auto & run : runs)
+    {
+        if(!preparePartition(run.second))
+        {
+            return false;
+        }
+    }
+
+    if(database.getDatabaseType() != DataBaseType::SQLite)
+    {
+        // Declarative partitions: the database routes the rows of the parent table
+        return insertLogBatch(entries, logsTableName);
+    }
+
+    if(runs.size() == 1)
+    {
+        const std::string table = getPartitionTable(runs.front().second);
+        return !table.empty() && insertLogBatch(entries, table);
+    }
+
+    const bool ownTransaction = !groupOpen && database.beginTransaction();
+    bool written = true;
+    for(size_t r = 0; r < runs.size() && written; ++r)
+    {
+        const size_t end = r + 1 < runs.size() ? runs[r + 1].first : entries.size();
+        const std::string table = getPartitionTable(runs[r].second);
+        written = !table.empty()
+                  && insertLogBatch(LogEntryList(entries.begin() + runs[r].first, entries.begin() + end), table);
+    }
+
+    if(ownTransaction)
+    {
+        if(written && database.commitTransaction())
+        {
+            return true;
+        }
+        database.rollbackTransaction();
+        loadPartitions();
+        if(dictionaries)
+        {
+            dictionaries->clear();
+        }
+        return false;
+    }
+    return written;
+}
+
+/**
+ * @brief Makes sure the partition of a day exists before writing to it.
+ * Writing to the newest partition creates the next one and applies the retention policy.
+ * @param day Day as YYYYMMDD.
+ * @return bool True if the partition exists.
+ */
+bool LogWriter::preparePartition(const int day)
+{
+    if(!partitions->covers(day) && !createPartition(day))
+    {
+        return false;
+    }
+
+    const auto newest = partitions->getNewestDay();
+    if(newest.has_value() && day >= newest.value())
+    {
+        // The day rolled over: keep a partition ahead of the writes, retried by the next write on failure
+        createPartition(LogPartitions::addDays(newest.value(), 1));
+        dropExpiredPartitions();
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the table the entries of a day are inserted into.
+ * On SQLite switching to another partition table synchronizes its ID sequence first.
+ * @param day Day as YYYYMMDD.
+ * @return std::string Partition table (SQLite) or log table, empty if the sequence could not be synchronized.
+ */
+std::string LogWriter::getPartitionTable(const int day)
+{
+    if(database.getDatabaseType() != DataBaseType::SQLite)
+    {
+        return logsTableName;
+    }
+
+    const std::string table = partitions->getName(day);
+    if(partitions->getLastWrittenDay() != day)
+    {
+        if(!syncPartitionSequence(table))
+        {
+            return "";
+        }
+        partitions->setLastWrittenDay(day);
+    }
+    return table;
+}
+
+/**
+ * @brief Creates the partition of a day.
+ * @param day Day as YYYYMMDD.
+ * @return bool True if the partition exists afterwards.
+ */
+bool LogWriter::createPartition(const int day)
+{
+    const DataBaseType type = database.getDatabaseType();
+    const std::string name = partitions->getName(day);
+
+    std::vector<std::string> statements;
+    if(type == DataBaseType::SQLite)
+    {
+        statements.push_back(QueryBuilder::buildCreateTable(buildLogsTable(name), type));
+        if(indexesEnabled)
+        {
+            const auto indexStatements = getCreateIndexStatements(name);
+            statements.insert(statements.end(), indexStatements.begin(), indexStatements.end());
+        }
+
+        std::vector<int> days = partitions->getDays();
+        days.insert(std::upper_bound(days.begin(), days.end(), day), day);
+        const auto viewStatements = getPartitionViewStatements(days);
+        statements.insert(statements.end(), viewStatements.begin(), viewStatements.end());
+    }
+    else
+    {
+        statements.push_back(QueryBuilder::buildCreatePartition(
+                                 type,
+                                 logsTableName,
+                                 FIELD_LOG_TIMESTAMP,
+                                 name,
+                                 partitions->getLowerBound(day),
+                                 partitions->getUpperBound(day),
+                                 !partitions->getNewestDay().has_value()
+                             ));
+    }
+
+    if(executeAtomically(statements))
+    {
+        partitions->add(day);
+        return true;
+    }
+
+    // Another writer may have created it first
+    loadPartitions();
+    return partitions->covers(day);
+}
+
+/**
+ * @brief Creates the partitions of today and tomorrow if missing.
+ * @return bool True if both exist afterwards.
+ */
+bool LogWriter::createCurrentPartitions()
+{
+    const int today = LogPartitions::today();
+
+    bool created = true;
+    for(const int day : { today, LogPartitions::addDays(today, 1) })
+    {
+        if(!partitions->covers(day) && !createPartition(day))
+        {
+            created = false;
+        }
+    }
+    return created;
+}
+
+/**
+* @brief Drops the partitions expired by the retention policy, with all their rows.
+* @return size_t Number of dropped partitions.
+*/
+size_t LogWriter::dropExpiredPartitions()
+{
+    if(!partitions)
+    {
+        return 0;
+    }
+
+    const std::vector<int> expired = partitions->getExpiredDays();
+    return expired.empty() ? 0 : dropPartitions(expired);
+}
+
+/**
+ * @brief Drops partitions with all their rows (the newest is never dropped).
+ * @param days Days of the partitions.
+ * @return size_t Number of dropped partitions.
+ */
+size_t LogWriter::dropPartitions(const std::vector<int> & days)
+{
+    const DataBaseType type = database.getDatabaseType();
+    const auto newest = partitions->getNewestDay();
+
+    std::vector<int> dropped;
+    for(const int day : days)
+    {
+        if(day != newest)
+        {
+            dropped.push_back(day);
+        }
+    }
+    if(dropped.empty())
+    {
+        return 0;
+    }
+
+    if(type == DataBaseType::SQLite)
+    {
+        // The sequences of the dropped tables go with them
+        partitions->raiseIdFloor(getPartitionSequence());
+
+        std::vector<int> kept;
+        for(const int day : partitions->getDays())
+        {
+            if(std::find(dropped.begin(), dropped.end(), day) == dropped.end())
+            {
+                kept.push_back(day);
+            }
+        }
+
+        // Readers see the old or the new view, never a dropped table
+        std::vector<std::string> statements = getPartitionViewStatements(kept);
+        std::vector<std::string> drops;
+        for(const int day : dropped)
+        {
+            drops.push_back(QueryBuilder::buildDropPartition(type, logsTableName, partitions->getName(day)));
+        }
+        statements.insert(statements.begin() + 1, drops.begin(), drops.end());
+
+        if(!executeAtomically(statements))
+        {
+            loadPartitions();
+            dropped.clear();
+        }
+    }
+    else
+    {
+        std::vector<int> done;
+        for(const int day : dropped)
+        {
+            const std::string query = QueryBuilder::buildDropPartition(type, logsTableName, partitions->getName(day));
+            if(!query.empty() && database.execute(query))
+            {
+                done.push_back(day);
+            }
+        }
+        dropped = done;
+    }
+
+    for(const int day : dropped)
+    {
+        partitions->remove(day);
+    }
+    if(tailCache && !dropped.empty())
+    {
+        tailCache->invalidate();
+    }
+    return dropped.size();
+}
+
+/**
+ * @brief Reloads the partitions from the database.
+ */
+void LogWriter::loadPartitions()
+{
+    std::string query = QueryBuilder::buildPartitionsQuery(
+                            database.getDatabaseType(),
+                            logsTableName
+                        );
+
+    if(query.empty())
+    {
+        return;
+    }
+
+    const ResultSet result = database.queryResultSet(query);
+    const size_t colName = result.columnIndex(FIELD_PARTITION_NAME);
+
+    std::vector<int> days;
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        const auto day = partitions->parseName(result.getString(row, colName));
+        if(day.has_value())
+        {
+            days.push_back(day.value());
+        }
+    }
+    partitions->assign(days);
+}
+
+/**
+ * @brief Gets the statements recreating the SQLite view over the partition tables.
+ * @param days Days of the partitions in the view.
+ * @return std::vector<std::string> DROP VIEW and CREATE VIEW statements.
+ */
+std::vector<std::string> LogWriter::getPartitionViewStatements(const std::vector<int> & days) const
+{
+    const DataBaseType type = database.getDatabaseType();
+
+    std::vector<std::string> tables;
+    tables.reserve(days.size());
+    for(const int day : days)
+    {
+        tables.push_back(partitions->getName(day));
+    }
+
+    std::vector<std::string> statements = { QueryBuilder::buildDropView(type, logsTableName) };
+    if(!tables.empty())
+    {
+        statements.push_back(QueryBuilder::buildCreateUnionView(type, logsTableName, tables));
+    }
+    return statements;
+}
+
+/**
+ * @brief Moves the SQLite ID sequence of a partition table past every ID assigned so far.
+ * Each table has its own AUTOINCREMENT sequence, so IDs stay unique and ascending across partitions.
+ * @param table Partition table name.
+ * @return bool True if the sequence was updated.
+ */
+bool LogWriter::syncPartitionSequence(const std::string& table)
+{
+    const DataBaseType type = database.getDatabaseType();
+    const int64_t sequence = getPartitionSequence();
+
+    std::vector<Filter> filters =
+    {
+        {Filter::Type::Unknown, FIELD_SEQUENCE_NAME, "=", table}
+    };
+
+    std::string deleteQuery = QueryBuilder::buildDelete(type, SQLITE_SEQUENCE_TABLE, filters);
+    std::string insertQuery = QueryBuilder::buildInsert(
+                                  type,
+                                  SQLITE_SEQUENCE_TABLE,
+    { {FIELD_SEQUENCE_NAME, table}, {FIELD_SEQUENCE_SEQ, std::to_string(sequence)} }
+                              );
+
+    return database.execute(deleteQuery, DbParamList{ DbParam(table) })
+           && database.execute(insertQuery, DbParamList{ DbParam(table), DbParam(sequence) });
+}
+
+/**
+ * @brief Gets the highest AUTOINCREMENT sequence value of the SQLite partition tables.
+ * @return int64_t Highest sequence value (0 if nothing was written yet).
+ */
+int64_t LogWriter::getPartitionSequence()
+{
+    std::string query = QueryBuilder::buildSelect(
+                            database.getDatabaseType(),
+                            SQLITE_SEQUENCE_TABLE,
+    { FIELD_SEQUENCE_NAME, FIELD_SEQUENCE_SEQ },
+    {}
+                        );
+
+    const ResultSet result = database.queryResultSet(query);
+    const size_t colName = result.columnIndex(FIELD_SEQUENCE_NAME);
+    const size_t colSeq = result.columnIndex(FIELD_SEQUENCE_SEQ);
+
+    int64_t sequence = partitions->getIdFloor();
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        if(partitions->parseName(result.getString(row, colName)).has_value())
+        {
+            sequence = std::max(sequence, result.getInt64(row, colSeq));
+        }
+    }
+    return sequence;
+}
+
+/**
+ * @brief Executes statements in one transaction (as part of the open group, if any).
+ * @param statements Statements to execute.
+ * @return bool True if every statement succeeded.
+ */
+bool LogWriter::executeAtomically(const std::vector<std::string> & statements)
+{
+    // Inside a group a failure rolls back only these statements
+    const bool savepoint = groupOpen && database.execute(std::string("SAVEPOINT ") + LOG_ATOMIC_SAVEPOINT);
+    const bool ownTransaction = !groupOpen && statements.size() > 1 && database.beginTransaction();
+    for(const auto & statement : statements)
+    {
+        if(statement.empty() || database.execute(statement))
+        {
+            continue;
+        }
+
+        if(ownTransaction)
+        {
+            database.rollbackTransaction();
+        }
+        else if(groupOpen && !(savepoint && rollbackToSavepoint(LOG_ATOMIC_SAVEPOINT)))
+        {
+            recoverGroup();
+        }
+        return false;
+    }
+
+    if(savepoint && !database.execute(std::string("RELEASE SAVEPOINT ") + LOG_ATOMIC_SAVEPOINT))
+    {
+        recoverGroup();
+        return false;
+    }
+    return !ownTransaction || database.commitTransaction();
+}
+
+/**
+* @brief Enables group commit: consecutive batches are coalesced into one transaction.
+* The transaction is committed after maxBatches batches, once window has elapsed since
+* it was opened, or on commitPending(). Each write runs under a savepoint, so a failed
+* batch rolls back only itself; if the group itself is lost (e.g. a failed commit)
+* its writes are written again one by one, see takeLostEntries().
+* @param maxBatches Number of batches per transaction (0 or 1 disables group commit).
+* @param window Maximum transaction age (0 = no time limit).
+* @warning While a group is open the connection holds the write lock (SQLite).
+*/
+void LogWriter::setGroupCommit(const size_t maxBatches, const std::chrono::milliseconds window)
+{
+    commitPending();
+    groupCommitBatches = maxBatches;
+    groupCommitWindow = window;
+}
+
+/**
+* @brief Enables the native bulk-load path for large batches.
+* Batches with at least threshold entries are written with IDatabase::bulkInsert()
+* (COPY / LOAD DATA) if the backend supports it, smaller ones with a batch INSERT.
+* @param threshold Minimum batch size for bulk load (0 = disabled).
+*/
+void LogWriter::setBulkLoadThreshold(const size_t threshold)
+{
+    bulkLoadThreshold = threshold;
+}
+
+/**
+* @brief Sets the timestamp column format used by createLogsTable() and the inserts.
+* With TimestampFormat::EpochMicros LogEntry::timestampUs is stored and LogEntry::timestamp is ignored.
+* @param format Timestamp format (must match an existing table).
+*/
+void LogWriter::setTimestampFormat(const TimestampFormat format)
+{
+    timestampFormat = format;
+}
+
+/**
+* @brief Selects the compact schema used by createLogsTable() and the inserts.
+* The level is stored as an integer (LogHelper::levelToInt()) and function, file
+* and thread ID as ids into dictionary tables, resolved through the shared cache.
+* @param dictionaries Dictionaries of the log table (nullptr = standard schema).
+*/
+void LogWriter::setCompactSchema(std::shared_ptr<LogDictionaries> dictionaries)
+{
+    this->dictionaries = std::move(dictionaries);
+}
+
+/**
+* @brief Splits the log table into daily partitions (see LogPartitions).
+* Must be set before createLogsTable(). Partitions are created for today and tomorrow,
+* then ahead of the writes, which also drop the partitions expired by the retention policy.
+* @param partitions Partitions of the log table (nullptr = plain table).
+*/
+void LogWriter::setPartitions(std::shared_ptr<LogPartitions> partitions)
+{
+    this->partitions = std::move(partitions);
+}
+
+/**
+* @brief Sets the tail cache that receives the written entries.
+* A failed write, a rolled back group and a cleared table invalidate the cache.
+* @param tailCache Tail cache (nullptr = disabled).
+*/
+void LogWriter::setTailCache(std::shared_ptr<LogTailCache> tailCache)
+{
+    this->tailCache = std::move(tailCache);
+}
+
+/**
+* @brief Compresses the message column (see LogMessageCompressor).
+* Must be set before createLogsTable(), which creates the dictionary table.
+* The tail cache still receives the uncompressed entries.
+* @param messageCompressor Compressor of the log table (nullptr = plain messages).
+*/
+void LogWriter::setMessageCompression(std::shared_ptr<LogMessageCompressor> messageCompressor)
+{
+    this->messageCompressor = std::move(messageCompressor);
+}
+
+/**
+* @brief Commits the open group transaction.
+* @param force If false, commits only when the group window has elapsed.
+* @return bool True if nothing was pending, the commit succeeded or the writes of the failed group were written again.
+*/
+bool LogWriter::commitPending(const bool force)
+{
+    if(!groupOpen)
+    {
+        return true;
+    }
+
+    if(!force && !isCommitDue())
+    {
+        return true;
+    }
+
+    if(!database.commitTransaction())
+    {
+        // The batches of the group were reported written
+        return recoverGroup();
+    }
+    groupOpen = false;
+    groupWrites.clear();
+    return true;
+}
+
+/**
+* @brief Rolls back the open group transaction.
+* Dictionary ids cached during the group are dropped along with it.
+*/
+void LogWriter::rollbackGroup()
+{
+    database.rollbackTransaction();
+    groupOpen = false;
+    groupWrites.clear();
+    resetCaches();
+}
+
+/**
+* @brief Drops the cached state a rollback may have invalidated
+* (dictionary ids, message dictionaries, partitions and the tail cache).
+*/
+void LogWriter::resetCaches()
+{
+    if(dictionaries)
+    {
+        dictionaries->clear();
+    }
+    if(messageCompressor)
+    {
+        // A dictionary trained in the rolled back writes is gone
+        messageCompressor->reload(database);
+    }
+    if(partitions)
+    {
+        // Partitions created in the rolled back writes are gone (SQLite and PostgreSQL DDL is transactional)
+        loadPartitions();
+    }
+    if(tailCache)
+    {
+        tailCache->invalidate();
+    }
+}
+
+/**
+* @brief Starts a write inside the group transaction.
+* Sets a savepoint, so a failed write rolls back only itself.
+* @param open Whether a group is opened if none is open.
+* @return bool True if the write runs in the group, false if it runs on its own.
+*/
+bool LogWriter::beginGroupWrite(const bool open)
+{
+    if(!groupOpen)
+    {
+        // Native log backends never write transactionally
+        if(!open || groupCommitBatches <= 1 || database.supportsNativeLogs() || !database.beginTransaction())
+        {
+            return false;
+        }
+        groupOpen = true;
+        groupBatches = 0;
+        groupStart = std::chrono::steady_clock::now();
+    }
+
+    if(!database.execute(std::string("SAVEPOINT ") + LOG_GROUP_WRITE_SAVEPOINT))
+    {
+        recoverGroup();
+        return false;
+    }
+    return true;
+}
+
+/**
+* @brief Ends a write started with beginGroupWrite().
+* A failed write is rolled back to its savepoint, the writes before it stay in the group.
+* @param entries The entries of the write (uncompressed).
+* @param written Whether the write succeeded.
+* @param batch Whether the write counts as a group batch (and may commit the group).
+* @return bool True if the write is in the group (or committed), false otherwise.
+*/
+bool LogWriter::endGroupWrite(const LogEntryList& entries, const bool written, const bool batch)
+{
+    if(!groupOpen)
+    {
+        // Recovered during the write, which was rolled back with the group
+        return false;
+    }
+
+    if(!written)
+    {
+        if(rollbackToSavepoint(LOG_GROUP_WRITE_SAVEPOINT))
+        {
+            resetCaches();
+        }
+        else
+        {
+            recoverGroup();
+        }
+        return false;
+    }
+
+    if(!database.execute(std::string("RELEASE SAVEPOINT ") + LOG_GROUP_WRITE_SAVEPOINT))
+    {
+        recoverGroup();
+        return false;
+    }
+
+    if(batch && (++groupBatches >= groupCommitBatches || isCommitDue()))
+    {
+        if(!database.commitTransaction())
+        {
+            // The writes before this one are written again, this one is reported failed
+            recoverGroup();
+            return false;
+        }
+        groupOpen = false;
+        groupWrites.clear();
+        return true;
+    }
+
+    groupWrites.push_back(entries);
+    return true;
+}
+
+/**
+* @brief Checks whether the group window has elapsed since the open group was started.
+* @return bool True if the open group must be committed.
+*/
+bool LogWriter::isCommitDue() const
+{
+    return groupCommitWindow.count() > 0
+           && std::chrono::steady_clock::now() - groupStart >= groupCommitWindow;
+}
+
+/**
+* @brief Rolls back to a savepoint and releases it.
+* @param name Savepoint name.
+* @return bool True if the transaction is usable again.
+*/
+bool LogWriter::rollbackToSavepoint(const std::string& name)
+{
+    return database.execute("ROLLBACK TO SAVEPOINT " + name)
+           && database.execute("RELEASE SAVEPOINT " + name);
+}
+
+/**
+* @brief Rolls back the open group and writes its writes again, each on its own.
+* Entries that still cannot be written are counted by takeLostEntries().
+* @return bool True if every write of the group was written again.
+*/
+bool LogWriter::recoverGroup()
+{
+    const std::vector<LogEntryList> writes = std::move(groupWrites);
+    rollbackGroup();
+
+    bool written = true;
+    for(const auto & entries : writes)
+    {
+        const LogEntryList compressed = messageCompressor
+                                        ? messageCompressor->compressMessages(database, entries)
+                                        : LogEntryList();
+        if(!insertEntries(messageCompressor ? compressed : entries))
+        {
+            lostEntries += entries.size();
+            written = false;
+        }
+    }
+    return written;
+}
+
+/**
+* @brief Gets and resets the number of entries lost with a rolled back group.
+* They were reported written, then could not be written again after the rollback.
+* @return size_t Lost entries since the last call.
+*/
+size_t LogWriter::takeLostEntries()
+{
+    const size_t lost = lostEntries;
+    lostEntries = 0;
+    return lost;
+}
+
+/**
+* @brief Passes a write to the tail cache.
+* @param entries The entries of the write.
+* @param written Whether the write succeeded.
+*/
+void LogWriter::cacheWritten(const LogEntryList& entries, const bool written)
+{
+    if(written)
+    {
+        tailCache->append(database, entries);
+    }
+    else
+    {
+        tailCache->invalidate();
+    }
+}
+
+/**
+* @brief Encodes the level, function, file and thread ID of an entry.
+* New values are added to the dictionary tables.
+* @param entry The log entry.
+* @return std::optional<CompactColumns> Encoded values, or std::nullopt if a dictionary insert failed.
+*/
+std::optional<LogWriter::CompactColumns> LogWriter::toCompactColumns(const LogEntry& entry)
+{
+    const auto function = dictionaries->function.getId(database, entry.function);
+    const auto file = dictionaries->file.getId(database, entry.file);
+    const auto threadId = dictionaries->threadId.getId(database, entry.threadId);
+    if(!function.has_value() || !file.has_value() || !threadId.has_value())
+    {
+        return std::nullopt;
+    }
+
+    return CompactColumns
+    {
+        LogHelper::levelToInt(LogHelper::stringToLevel(entry.level)),
+        function.value(),
+        file.value(),
+        threadId.value()
+    };
+}
+
+/**
+* @brief Gets the time left before the open group transaction must be committed.
+* @return std::chrono::milliseconds Remaining time, or the full window if no group is open.
+*/
+std::chrono::milliseconds LogWriter::getGroupCommitRemaining() const
+{
+    if(!groupOpen)
+    {
+        return groupCommitWindow;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - groupStart);
+    return elapsed >= groupCommitWindow ? std::chrono::milliseconds(0) : groupCommitWindow - elapsed;
 }
 
 /**
@@ -115,13 +1053,43 @@ bool LogWriter::writeLogBatch(const LogEntryList& entries)
  */
 void LogWriter::clearLogs()
 {
-    std::string query = QueryBuilder::buildDelete(
-                            database.getDatabaseType(),
-                            logsTableName,
-                            {} // No filters
-                        );
+    if(database.supportsNativeLogs())
+    {
+        database.clearTable(logsTableName);
+        return;
+    }
 
-    database.execute(query);
+    std::string table = logsTableName;
+    if(partitions)
+    {
+        // Dropping partitions is cheaper than deleting their rows, only the newest is emptied
+        dropPartitions(partitions->getDays());
+        const auto newest = partitions->getNewestDay();
+        if(database.getDatabaseType() == DataBaseType::SQLite)
+        {
+            table = newest.has_value() ? partitions->getName(newest.value()) : "";
+        }
+    }
+
+    if(!table.empty())
+    {
+        std::string query = QueryBuilder::buildDelete(
+                                database.getDatabaseType(),
+                                table,
+                                {} // No filters
+                            );
+
+        database.execute(query);
+    }
+
+    if(partitions)
+    {
+        createCurrentPartitions();
+    }
+    if(tailCache)
+    {
+        tailCache->clear();
+    }
 }
 
 #ifdef SQLG_USE_SOURCE_INFO
@@ -130,6 +1098,12 @@ void LogWriter::clearLogs()
 */
 void LogWriter::clearSources()
 {
+    if(database.supportsNativeLogs())
+    {
+        database.clearTable(SOURCES_TABLE_NAME);
+        return;
+    }
+
     std::string query = QueryBuilder::buildDelete(
                             database.getDatabaseType(),
                             SOURCES_TABLE_NAME,
@@ -137,6 +1111,11 @@ void LogWriter::clearSources()
                         );
 
     database.execute(query);
+    if(tailCache)
+    {
+        // Cached source names are gone with the table
+        tailCache->clear();
+    }
 }
 #endif
 
@@ -145,6 +1124,46 @@ void LogWriter::clearSources()
  */
 void LogWriter::createLogsTable()
 {
+    if(database.supportsNativeLogs())
+        return; // Tables are created on first write
+
+    if(dictionaries)
+    {
+        dictionaries->createTables(database);
+    }
+
+    if(messageCompressor)
+    {
+        messageCompressor->createTable(database);
+    }
+
+    if(partitions)
+    {
+        const DataBaseType type = database.getDatabaseType();
+        const bool tableExists = !database.query(QueryBuilder::buildTableExistsQuery(type, logsTableName)).empty();
+        if(type == DataBaseType::SQLite)
+        {
+            // The log table is a view over the partition tables
+            if(tableExists && database.query(QueryBuilder::buildViewExistsQuery(type, logsTableName)).empty())
+            {
+                throw std::runtime_error(ERR_MSG_TABLE_NOT_PARTITIONED + logsTableName);
+            }
+        }
+        else if(!tableExists)
+        {
+            database.execute(QueryBuilder::buildCreateTable(buildLogsTable(logsTableName), type));
+        }
+
+        loadPartitions();
+        createCurrentPartitions();
+
+        if(type == DataBaseType::SQLite && database.query(QueryBuilder::buildViewExistsQuery(type, logsTableName)).empty())
+        {
+            executeAtomically(getPartitionViewStatements(partitions->getDays()));
+        }
+        return;
+    }
+
     std::string checkQueryLogs = QueryBuilder::buildTableExistsQuery(
                                      database.getDatabaseType(),
                                      logsTableName
@@ -164,23 +1183,8 @@ void LogWriter::createLogsTable()
       )
         return; // Skip if exists
 
-    auto logTable = DatabaseSchema::createTableBuilder(logsTableName)
-                    .addStandardField<FieldType::Int64>(FIELD_LOG_ID, true, false, true)  // PRIMARY AUTOINCREMENT KEY
-#ifdef SQLG_USE_SOURCE_INFO
-                    .addStandardField<FieldType::Int64>(FIELD_LOG_SOURCES_ID, false, false, false)
-                    .addForeignKey(FIELD_LOG_SOURCES_ID, SOURCES_TABLE_NAME, FIELD_SOURCES_ID)
-#endif
-                    .addStandardField<FieldType::DateTime>(FIELD_LOG_TIMESTAMP, false, false)
-                    .addStandardField<FieldType::String>(FIELD_LOG_LEVEL, false, false)
-                    .addStandardField<FieldType::String>(FIELD_LOG_MESSAGE, false, false)
-                    .addStandardField<FieldType::String>(FIELD_LOG_FUNCTION, false, false)
-                    .addStandardField<FieldType::String>(FIELD_LOG_FILE, false, false)
-                    .addStandardField<FieldType::Int32>(FIELD_LOG_LINE, false, false)
-                    .addStandardField<FieldType::String>(FIELD_LOG_THREAD_ID, false, false)
-                    .build();
-
     std::string query = QueryBuilder::buildCreateTable(
-                            logTable,
+                            buildLogsTable(logsTableName),
                             database.getDatabaseType()
                         );
 
@@ -191,43 +1195,125 @@ void LogWriter::createLogsTable()
 }
 
 /**
- * @brief Creates indexes on the log table for faster queries.
+ * @brief Creates the sources table (with source info), the log table and, unless deferred, the indexes.
+ * The layout is recorded in SCHEMA_TABLE_NAME once everything exists; a later start with the
+ * same layout reads that marker instead of probing every table and index.
+ * Must be called after the schema setters (timestamp format, compact schema, indexes, partitions, full-text search).
+ * @param withIndexes False to leave the indexes to a later createIndexes() (Config::deferIndexes).
+ * @return bool True if every index exists afterwards (always true if withIndexes is false).
  */
-void LogWriter::createIndexes()
+bool LogWriter::createSchema(const bool withIndexes)
 {
-    const std::string idxPrefix = "idx_";
+    if(database.supportsNativeLogs())
+        return true; // Tables are created on first write
 
-    std::vector<std::string> logIndexes =
+    const std::string signature = getSchemaSignature();
+    if(withIndexes && loadSchemaVersion() == signature)
     {
-        FIELD_LOG_TIMESTAMP,
-        FIELD_LOG_LEVEL,
-        FIELD_LOG_FILE,
-        FIELD_LOG_THREAD_ID,
-        FIELD_LOG_FUNCTION
-    };
+        // Same layout as last time: only the daily partitions move between runs
+        indexesEnabled = true;
+        if(partitions)
+        {
+            loadPartitions();
+            createCurrentPartitions();
+        }
+        return true;
+    }
 
-    for(const auto & field : logIndexes)
+#ifdef SQLG_USE_SOURCE_INFO
+    createSourcesTable();
+#endif
+    createLogsTable();
+    if(!withIndexes)
+        return true;
+
+    const bool created = createIndexes();
+    if(created)
     {
-        std::string checkQuery = QueryBuilder::buildIndexExistsQuery(
-                                     database.getDatabaseType(),
-                                     idxPrefix + field
-                                 );
+        storeSchemaVersion(signature);
+    }
+    return created;
+}
 
-        if(!checkQuery.empty() && !database.query(checkQuery).empty())
-            continue; // Skip if exists
+/**
+ * @brief Builds the definition of the log table or of a SQLite partition table.
+ * @param tableName Table name.
+ * @return DatabaseSchema::TableBuilder::BuiltTable Table definition.
+ */
+DatabaseSchema::TableBuilder::BuiltTable LogWriter::buildLogsTable(const std::string& tableName) const
+{
+    auto logBuilder = DatabaseSchema::createTableBuilder(tableName);
+    logBuilder.addStandardField<FieldType::Int64>(FIELD_LOG_ID, true, false, true); // PRIMARY AUTOINCREMENT KEY
+#ifdef SQLG_USE_SOURCE_INFO
+    logBuilder.addStandardField<FieldType::Int64>(FIELD_LOG_SOURCES_ID, false, false, false);
+    logBuilder.addForeignKey(FIELD_LOG_SOURCES_ID, SOURCES_TABLE_NAME, FIELD_SOURCES_ID);
+#endif
 
-        std::string query = QueryBuilder::buildCreateIndex(
-                                database.getDatabaseType(),
-                                logsTableName,
-                                idxPrefix + field,
-        { field }
-                            );
+    if(timestampFormat == TimestampFormat::EpochMicros)
+    {
+        logBuilder.addStandardField<FieldType::Int64>(FIELD_LOG_TIMESTAMP, false, false);
+    }
+    else
+    {
+        logBuilder.addStandardField<FieldType::DateTime>(FIELD_LOG_TIMESTAMP, false, false);
+    }
 
-        if(!query.empty())
+    if(dictionaries)
+    {
+        // Compact schema: integer level, dictionary ids instead of repeated strings
+        logBuilder.addStandardField<FieldType::Int32>(FIELD_LOG_LEVEL, false, false)
+        .addStandardField<FieldType::String>(FIELD_LOG_MESSAGE, false, false)
+        .addStandardField<FieldType::Int64>(FIELD_LOG_FUNCTION, false, false)
+        .addStandardField<FieldType::Int64>(FIELD_LOG_FILE, false, false)
+        .addStandardField<FieldType::Int32>(FIELD_LOG_LINE, false, false)
+        .addStandardField<FieldType::Int64>(FIELD_LOG_THREAD_ID, false, false);
+    }
+    else
+    {
+        logBuilder.addStandardField<FieldType::String>(FIELD_LOG_LEVEL, false, false)
+        .addStandardField<FieldType::String>(FIELD_LOG_MESSAGE, false, false)
+        .addStandardField<FieldType::String>(FIELD_LOG_FUNCTION, false, false)
+        .addStandardField<FieldType::String>(FIELD_LOG_FILE, false, false)
+        .addStandardField<FieldType::Int32>(FIELD_LOG_LINE, false, false)
+        .addStandardField<FieldType::String>(FIELD_LOG_THREAD_ID, false, false);
+    }
+
+    if(partitions && database.getDatabaseType() != DataBaseType::SQLite)
+    {
+        // Declarative partitions, created by createPartition()
+        logBuilder.setRangePartition(FIELD_LOG_TIMESTAMP);
+    }
+
+    return logBuilder.build();
+}
+
+/**
+ * @brief Creates the configured indexes on the log table (and the source table indexes).
+ * Existing indexes are kept; only MySQL, which lacks CREATE INDEX IF NOT EXISTS, queries for them first.
+ * @return bool True if every index exists afterwards.
+ */
+bool LogWriter::createIndexes()
+{
+    if(database.supportsNativeLogs())
+        return true; // No secondary indexes
+
+    bool created = true;
+    for(const auto & table : getIndexedTables())
+    {
+        for(const auto & query : getCreateIndexStatements(table))
         {
-            database.execute(query);
+            if(!database.execute(query))
+            {
+                created = false;
+            }
         }
     }
+    indexesEnabled = true;
+
+    if(fullTextSearch && !createFullTextIndex())
+    {
+        created = false;
+    }
 
 #ifdef SQLG_USE_SOURCE_INFO
     std::vector<std::string> sourceIndexes =
@@ -238,27 +1324,314 @@ void LogWriter::createIndexes()
 
     for(const auto & field : sourceIndexes)
     {
-        std::string checkQuery = QueryBuilder::buildIndexExistsQuery(
-                                     database.getDatabaseType(),
-                                     idxPrefix + field
-                                 );
-
-        if(!database.query(checkQuery).empty())
+        const std::string indexName = INDEX_PREFIX + field;
+        if(indexExists(indexName))
             continue; // Skip if exists
 
         std::string query = QueryBuilder::buildCreateIndex(
                                 database.getDatabaseType(),
                                 SOURCES_TABLE_NAME,
-                                idxPrefix + field,
+                                indexName,
         { field }
                             );
 
+        if(!query.empty() && !database.execute(query))
+        {
+            created = false;
+        }
+    }
+#endif
+
+    return created;
+}
+
+/**
+ * @brief Drops the configured log table indexes, e.g. before a bulk load.
+ * @return bool True if every index was dropped or did not exist.
+ */
+bool LogWriter::dropIndexes()
+{
+    if(database.supportsNativeLogs())
+        return true; // No secondary indexes
+
+    const bool checkExists = database.getDatabaseType() == DataBaseType::MySQL;
+
+    bool dropped = true;
+    for(const auto & table : getIndexedTables())
+    {
+        for(const auto & index : indexes)
+        {
+            const std::string indexName = getIndexName(index, table);
+            if(checkExists && !indexExists(indexName))
+                continue; // Nothing to drop
+
+            std::string query = QueryBuilder::buildDropIndex(
+                                    database.getDatabaseType(),
+                                    table,
+                                    indexName
+                                );
+
+            if(!query.empty() && !database.execute(query))
+            {
+                dropped = false;
+            }
+        }
+    }
+    indexesEnabled = false;
+
+    // The next start must create the indexes again
+    storeSchemaVersion("");
+
+    if(fullTextSearch && !dropFullTextIndex())
+    {
+        dropped = false;
+    }
+    return dropped;
+}
+
+/**
+ * @brief Sets the log table indexes created by createIndexes() and dropped by dropIndexes().
+ * @param indexes Indexes, each a list of columns (empty = no secondary indexes).
+ */
+void LogWriter::setIndexes(const std::vector<LogIndex> & indexes)
+{
+    this->indexes = indexes;
+}
+
+/**
+ * @brief Adds a full-text index on the message column to the indexes of createIndexes() and dropIndexes().
+ * SQLite uses an FTS5 table kept in sync by triggers, PostgreSQL a GIN index, MySQL a FULLTEXT index;
+ * rows written before the index existed are indexed too. Not supported with SQLite partitions.
+ * @param enabled True to create the full-text index.
+ */
+void LogWriter::setFullTextSearch(const bool enabled)
+{
+    fullTextSearch = enabled;
+}
+
+/**
+* @brief Gets the name of a log table index.
+* Indexes of the default table keep the plain idx_<columns> names, other tables
+* include the table name, since index names are shared by the whole database.
+* @param index Index columns.
+* @param table Indexed table (the log table or a SQLite partition table).
+* @return std::string Index name.
+*/
+std::string LogWriter::getIndexName(const LogIndex& index, const std::string& table) const
+{
+    std::string name = INDEX_PREFIX;
+    if(table != LOG_TABLE_NAME)
+    {
+        name += table + "_";
+    }
+    return name + StringHelper::join(index, "_");
+}
+
+/**
+ * @brief Gets the tables holding the log table indexes.
+ * @return std::vector<std::string> The SQLite partition tables, or the log table.
+ */
+std::vector<std::string> LogWriter::getIndexedTables() const
+{
+    if(!partitions || database.getDatabaseType() != DataBaseType::SQLite)
+    {
+        // Indexes of a partitioned table apply to all of its partitions
+        return { logsTableName };
+    }
+
+    std::vector<std::string> tables;
+    for(const int day : partitions->getDays())
+    {
+        tables.push_back(partitions->getName(day));
+    }
+    return tables;
+}
+
+/**
+ * @brief Gets the statements creating the configured indexes on a table.
+ * @param table Table name.
+ * @return std::vector<std::string> CREATE INDEX statements of the missing indexes.
+ */
+std::vector<std::string> LogWriter::getCreateIndexStatements(const std::string& table)
+{
+    std::vector<std::string> statements;
+    for(const auto & index : indexes)
+    {
+        const std::string indexName = getIndexName(index, table);
+        if(indexExists(indexName))
+            continue; // Skip if exists
+
+        std::string query = QueryBuilder::buildCreateIndex(
+                                database.getDatabaseType(),
+                                table,
+                                indexName,
+                                index
+                            );
+
         if(!query.empty())
         {
-            database.execute(query);
+            statements.push_back(query);
         }
     }
+    return statements;
+}
+
+/**
+* @brief Gets the schema version marker of the current layout.
+* @return std::string Marker text (schema version, layout, timestamp format, partitioning, indexes).
+*/
+std::string LogWriter::getSchemaSignature() const
+{
+    std::vector<std::string> indexColumns;
+    for(const auto & index : indexes)
+    {
+        indexColumns.push_back(StringHelper::join(index, INDEX_COLUMN_DELIMITER));
+    }
+
+    const std::vector<std::string> parts =
+    {
+        std::to_string(SCHEMA_VERSION),
+        dictionaries ? "compact" : "standard",
+        timestampFormat == TimestampFormat::EpochMicros ? "micros" : "text",
+        partitions ? "daily" : "single",
+        fullTextSearch ? "fts" : "",
+        messageCompressor ? "zstd" : "",
+#ifdef SQLG_USE_SOURCE_INFO
+        SOURCES_TABLE_NAME,
+#endif
+        StringHelper::join(indexColumns, INDEX_DELIMITER)
+    };
+    return StringHelper::join(parts, SCHEMA_SIGNATURE_DELIMITER);
+}
+
+/**
+* @brief Reads the schema version marker of the log table.
+* @return std::string Stored marker, or an empty string if missing (or a schema table is missing).
+*/
+std::string LogWriter::loadSchemaVersion()
+{
+    const DataBaseType type = database.getDatabaseType();
+    std::vector<std::string> requiredTables = { logsTableName };
+#ifdef SQLG_USE_SOURCE_INFO
+    requiredTables.push_back(SOURCES_TABLE_NAME);
 #endif
+
+    const std::string query = QueryBuilder::buildSchemaVersionQuery(type, SCHEMA_TABLE_NAME, logsTableName, requiredTables);
+    if(query.empty())
+    {
+        return "";
+    }
+
+    // The marker table is tiny and created once; IF NOT EXISTS keeps the lookup free of errors
+    auto markerTable = DatabaseSchema::createTableBuilder(SCHEMA_TABLE_NAME)
+                       .addStandardField<FieldType::String>(FIELD_SCHEMA_TABLE, true, false, false) // PRIMARY KEY
+                       .addStandardField<FieldType::String>(FIELD_SCHEMA_VERSION, false, false, false)
+                       .build();
+    database.execute(QueryBuilder::buildCreateTable(markerTable, type));
+
+    const ResultSet result = database.queryResultSet(query);
+    return result.rowCount() > 0 ? result.getString(0, result.columnIndex(FIELD_SCHEMA_VERSION)) : "";
+}
+
+/**
+* @brief Replaces the schema version marker of the log table.
+* @param signature Marker text (empty = only remove the stored marker).
+*/
+void LogWriter::storeSchemaVersion(const std::string& signature)
+{
+    const DataBaseType type = database.getDatabaseType();
+    if(QueryBuilder::buildSchemaVersionQuery(type, SCHEMA_TABLE_NAME, logsTableName, {}).empty())
+    {
+        return; // No marker table
+    }
+
+    std::vector<Filter> filters =
+    {
+        {Filter::Type::Unknown, FIELD_SCHEMA_TABLE, "=", logsTableName}
+    };
+    database.execute(QueryBuilder::buildDelete(type, SCHEMA_TABLE_NAME, filters), DbParamList{ DbParam(logsTableName) });
+
+    if(!signature.empty())
+    {
+        std::vector<std::pair<std::string, std::string>> values =
+        {
+            {FIELD_SCHEMA_TABLE, logsTableName},
+            {FIELD_SCHEMA_VERSION, signature}
+        };
+        database.execute(QueryBuilder::buildInsert(type, SCHEMA_TABLE_NAME, values),
+                         DbParamList{ DbParam(logsTableName), DbParam(signature) });
+    }
+}
+
+/**
+* @brief Checks if an index exists (MySQL only, other backends use IF [NOT] EXISTS).
+* @param indexName Index name.
+* @return bool True if the index exists.
+*/
+bool LogWriter::indexExists(const std::string& indexName)
+{
+    if(database.getDatabaseType() != DataBaseType::MySQL)
+    {
+        return false;
+    }
+
+    std::string checkQuery = QueryBuilder::buildIndexExistsQuery(
+                                 database.getDatabaseType(),
+                                 indexName
+                             );
+
+    return !checkQuery.empty() && !database.query(checkQuery).empty();
+}
+
+/**
+* @brief Creates the full-text index on the message column if it does not exist.
+* @return bool True if the index exists afterwards.
+*/
+bool LogWriter::createFullTextIndex()
+{
+    const DataBaseType type = database.getDatabaseType();
+    const std::string indexName = getIndexName({ FIELD_LOG_MESSAGE }, logsTableName) + FTS_SUFFIX;
+    if(indexExists(indexName))
+        return true;
+
+    // The SQLite full-text table starts empty, unlike the PostgreSQL and MySQL indexes
+    const std::string ftsExistsQuery = type == DataBaseType::SQLite
+                                       ? QueryBuilder::buildTableExistsQuery(type, logsTableName + FTS_SUFFIX)
+                                       : "";
+    const bool rebuild = !ftsExistsQuery.empty() && database.query(ftsExistsQuery).empty();
+
+    for(const auto & query : QueryBuilder::buildCreateFullTextIndex(type, logsTableName, indexName, FIELD_LOG_MESSAGE))
+    {
+        if(!database.execute(query))
+        {
+            return false;
+        }
+    }
+
+    const std::string rebuildQuery = QueryBuilder::buildRebuildFullTextIndex(type, logsTableName);
+    return !rebuild || rebuildQuery.empty() || database.execute(rebuildQuery);
+}
+
+/**
+* @brief Drops the full-text index on the message column.
+* @return bool True if the index was dropped or did not exist.
+*/
+bool LogWriter::dropFullTextIndex()
+{
+    const DataBaseType type = database.getDatabaseType();
+    const std::string indexName = getIndexName({ FIELD_LOG_MESSAGE }, logsTableName) + FTS_SUFFIX;
+    if(type == DataBaseType::MySQL && !indexExists(indexName))
+        return true; // Nothing to drop
+
+    bool dropped = true;
+    for(const auto & query : QueryBuilder::buildDropFullTextIndex(type, logsTableName, indexName))
+    {
+        if(!database.execute(query))
+        {
+            dropped = false;
+        }
+    }
+    return dropped;
 }
 
 #ifdef SQLG_USE_SOURCE_INFO
@@ -269,6 +1642,9 @@ void LogWriter::createIndexes()
  */
 void LogWriter::createSourcesTable()
 {
+    if(database.supportsNativeLogs())
+        return; // Sources are stored natively
+
     std::string checkQuerySources = QueryBuilder::buildTableExistsQuery(
                                         database.getDatabaseType(),
                                         SOURCES_TABLE_NAME
@@ -304,6 +1680,11 @@ void LogWriter::createSourcesTable()
  */
 int LogWriter::addSource(const std::string& name, const std::string& uuid)
 {
+    if(database.supportsNativeLogs())
+    {
+        return database.insertSource(uuid.empty() ? LogHelper::generateUUID() : uuid, name);
+    }
+
     std::vector<std::pair<std::string, std::string>> values =
     {
         {FIELD_SOURCES_UUID, uuid.empty() ? LogHelper::generateUUID() : uuid},
@@ -317,7 +1698,7 @@ int LogWriter::addSource(const std::string& name, const std::string& uuid)
                                   values
                               );
 
-    if(!database.execute(insertQuery, { uuid, name }))
+    if(!database.execute(insertQuery, DbParamList{ DbParam(uuid), DbParam(name) }))
     {
         return SOURCE_NOT_FOUND;
     }
@@ -340,4 +1721,50 @@ int LogWriter::addSource(const std::string& name, const std::string& uuid)
     auto result = database.query(selectQuery, { uuid });
     return !result.empty() ? std::stoi(result[0][FIELD_SOURCES_ID]) : SOURCE_NOT_FOUND;
 }
+
+/**
+* @brief Adds a source, or gets the stored one with the same UUID, in one round trip.
+* @param name The name of the source (kept as stored if the UUID exists).
+* @param uuid The UUID of the source.
+* @return std::optional<SourceInfo> The stored source, or std::nullopt if the database has no
+* INSERT ... RETURNING (or it failed); use getSourceByUuid() and addSource() then.
+*/
+std::optional<SourceInfo> LogWriter::registerSource(const std::string& name, const std::string& uuid)
+{
+    if(database.supportsNativeLogs() || !database.supportsReturning())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::pair<std::string, std::string>> values =
+    {
+        {FIELD_SOURCES_UUID, uuid},
+        {FIELD_SOURCES_NAME, name}
+    };
+
+    std::string query = QueryBuilder::buildUpsertReturning(
+                            database.getDatabaseType(),
+                            SOURCES_TABLE_NAME,
+                            values,
+                            FIELD_SOURCES_UUID,
+    { FIELD_SOURCES_ID, FIELD_SOURCES_NAME }
+                        );
+
+    if(query.empty())
+    {
+        return std::nullopt;
+    }
+
+    const ResultSet result = database.queryResultSet(query, { uuid, name });
+    if(result.rowCount() == 0)
+    {
+        return std::nullopt;
+    }
+
+    SourceInfo source;
+    source.sourceId = result.getInt(0, result.columnIndex(FIELD_SOURCES_ID), SOURCE_NOT_FOUND);
+    source.uuid = uuid;
+    source.name = result.getString(0, result.columnIndex(FIELD_SOURCES_NAME));
+    return source;
+}
 #endif
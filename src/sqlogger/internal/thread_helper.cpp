@@ -0,0 +1,212 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include "sqlogger/internal/thread_helper.h"
+#include "sqlogger/internal/log_strings.h"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+/**
+ * @brief Applies the affinity and priority of the settings to the calling thread.
+ * @param settings Settings to apply.
+ * @param errMsg[out] Error message of the first setting that could not be applied.
+ * @return bool True if every setting was applied.
+ */
+bool ThreadHelper::apply(const Settings& settings, std::string& errMsg)
+{
+    bool applied = true;
+    if(!settings.cpus.empty())
+    {
+        applied = setAffinity(settings.cpus, errMsg);
+    }
+
+    std::string priorityError;
+    if(settings.priority.has_value() && !setPriority(settings.priority.value(), priorityError))
+    {
+        if(applied)
+        {
+            errMsg = priorityError;
+        }
+        applied = false;
+    }
+    return applied;
+}
+
+/**
+ * @brief Restricts the calling thread to a set of CPUs.
+ * @param cpus CPU indexes (empty = no change).
+ * @param errMsg[out] Error message.
+ * @return bool True on success, false if the call failed or the platform has no affinity API.
+ */
+bool ThreadHelper::setAffinity(const std::vector<int> & cpus, std::string& errMsg)
+{
+    if(cpus.empty())
+    {
+        return true;
+    }
+
+#if defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for(const int cpu : cpus)
+    {
+        if(cpu < 0 || cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+        {
+            errMsg = ERR_MSG_INVALID_CPU + std::to_string(cpu);
+            return false;
+        }
+        mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+    if(SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+    {
+        errMsg = ERR_MSG_FAILED_SET_AFFINITY + std::to_string(GetLastError());
+        return false;
+    }
+    return true;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO( & set);
+    for(const int cpu : cpus)
+    {
+        if(cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            errMsg = ERR_MSG_INVALID_CPU + std::to_string(cpu);
+            return false;
+        }
+        CPU_SET(cpu, & set);
+    }
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), & set);
+    if(error != 0)
+    {
+        errMsg = ERR_MSG_FAILED_SET_AFFINITY + std::string(std::strerror(error));
+        return false;
+    }
+    return true;
+#else
+    errMsg = ERR_MSG_AFFINITY_NOT_SUPPORTED;
+    return false;
+#endif
+}
+
+/**
+ * @brief Gets the CPUs the calling thread may run on.
+ * @return std::vector<int> CPU indexes (empty if the platform has no affinity API).
+ */
+std::vector<int> ThreadHelper::getAffinity()
+{
+    std::vector<int> cpus;
+#if defined(_WIN32)
+    // Setting a mask returns the previous one
+    const DWORD_PTR all = ~static_cast<DWORD_PTR>(0);
+    const DWORD_PTR mask = SetThreadAffinityMask(GetCurrentThread(), all);
+    if(mask != 0)
+    {
+        SetThreadAffinityMask(GetCurrentThread(), mask);
+        for(int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); ++cpu)
+        {
+            if(mask & (static_cast<DWORD_PTR>(1) << cpu)) cpus.push_back(cpu);
+        }
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO( & set);
+    if(pthread_getaffinity_np(pthread_self(), sizeof(set), & set) == 0)
+    {
+        for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(CPU_ISSET(cpu, & set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * @brief Sets the priority of the calling thread.
+ * Linux sets the thread's nice value (raising it requires CAP_SYS_NICE), Windows maps
+ * it to the nearest thread priority class.
+ * @param priority Nice value (THREAD_HELPER_PRIORITY_MIN - THREAD_HELPER_PRIORITY_MAX).
+ * @param errMsg[out] Error message.
+ * @return bool True on success, false if the call failed or the platform has no per-thread priority.
+ */
+bool ThreadHelper::setPriority(const int priority, std::string& errMsg)
+{
+    if(priority < THREAD_HELPER_PRIORITY_MIN || priority > THREAD_HELPER_PRIORITY_MAX)
+    {
+        errMsg = ERR_MSG_INVALID_THREAD_PRIORITY + std::to_string(priority);
+        return false;
+    }
+
+#if defined(_WIN32)
+    int level = THREAD_PRIORITY_NORMAL;
+    if(priority <= -15) level = THREAD_PRIORITY_HIGHEST;
+    else if(priority < 0) level = THREAD_PRIORITY_ABOVE_NORMAL;
+    else if(priority >= 15) level = THREAD_PRIORITY_LOWEST;
+    else if(priority > 0) level = THREAD_PRIORITY_BELOW_NORMAL;
+    if(!SetThreadPriority(GetCurrentThread(), level))
+    {
+        errMsg = ERR_MSG_FAILED_SET_THREAD_PRIORITY + std::to_string(GetLastError());
+        return false;
+    }
+    return true;
+#elif defined(__linux__)
+    // Linux applies the nice value of PRIO_PROCESS to a single thread when given its TID
+    const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+    if(setpriority(PRIO_PROCESS, tid, priority) != 0)
+    {
+        errMsg = ERR_MSG_FAILED_SET_THREAD_PRIORITY + std::string(std::strerror(errno));
+        return false;
+    }
+    return true;
+#else
+    errMsg = ERR_MSG_THREAD_PRIORITY_NOT_SUPPORTED;
+    return false;
+#endif
+}
+
+/**
+ * @brief Hints the CPU that the calling thread is spinning.
+ */
+void ThreadHelper::relax()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
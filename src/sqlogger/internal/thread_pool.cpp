@@ -19,59 +19,42 @@
 
 #include "sqlogger/internal/thread_pool.h"
 
+thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+thread_local size_t ThreadPool::currentIndex = 0;
+
 /**
  * @brief Constructs a ThreadPool with the specified number of threads.
+ * Returns once every worker has applied the settings.
  * @param numThreads The number of threads in the pool.
+ * @param settings Affinity, priority and idle wait of the workers.
  */
-ThreadPool::ThreadPool(size_t numThreads) : stop(false), tasksInProgress(0)
+ThreadPool::ThreadPool(size_t numThreads, const ThreadHelper::Settings& settings)
+    : settings(settings), stop(false), queuedTasks(0), tasksInProgress(0), nextQueue(0)
 {
     for(size_t i = 0; i < numThreads; ++i)
     {
-        workers.emplace_back([this]
-        {
-            while(true)
-            {
-                std::function<void()> task;
-
-                {
-                    std::unique_lock<std::mutex> lock(this->queueMutex);
-                    this->condition.wait(lock, [this]
-                    {
-                        return this->stop || !this->tasks.empty();
-                    });
-
-                    if(this->stop && this->tasks.empty())
-                    {
-                        return;
-                    }
-
-                    task = std::move(this->tasks.front());
-                    this->tasks.pop();
-                    tasksInProgress++;
-                }
-
-                task();
-
-                {
-                    std::unique_lock<std::mutex> lock(this->queueMutex);
-                    tasksInProgress--;
-                    if(tasksInProgress == 0 && tasks.empty())
-                    {
-                        completionCondition.notify_all();
-                    }
-                }
-            }
-        });
+        queues.push_back(std::make_unique<WorkerQueue>());
     }
+
+    for(size_t i = 0; i < numThreads; ++i)
+    {
+        workers.emplace_back( & ThreadPool::workerLoop, this, i);
+    }
+
+    std::unique_lock<std::mutex> lock(waitMutex);
+    startCondition.wait(lock, [this]
+    {
+        return startedWorkers == workers.size();
+    });
 }
 
 /**
- * @brief Destructor for ThreadPool. Stops all threads.
+ * @brief Destructor for ThreadPool. Runs the queued tasks and stops all threads.
  */
 ThreadPool::~ThreadPool()
 {
     {
-        std::unique_lock<std::mutex> lock(queueMutex);
+        std::unique_lock<std::mutex> lock(waitMutex);
         stop = true;
     }
     condition.notify_all();
@@ -82,17 +65,186 @@ ThreadPool::~ThreadPool()
     }
 }
 
+/**
+ * @brief Pushes a task to a worker queue and wakes a worker.
+ * @param task The task to queue.
+ */
+void ThreadPool::push(Task&& task)
+{
+    if(queues.empty())
+    {
+        // No workers: run inline
+        task();
+        return;
+    }
+
+    const size_t index = currentPool == this
+                         ? currentIndex
+                         : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    {
+        // Counted first, so the task is never taken before it is counted
+        std::unique_lock<std::mutex> lock(waitMutex);
+        queuedTasks++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+}
+
+/**
+ * @brief Takes a task from the worker's own queue, or steals one from another queue.
+ * @param index The worker index.
+ * @param task Receives the task.
+ * @return True if a task was taken.
+ */
+bool ThreadPool::tryTake(size_t index, Task& task)
+{
+    for(size_t i = 0; i < queues.size(); ++i)
+    {
+        WorkerQueue& queue = * queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            // In progress before leaving the queue count, so the pool never looks idle in between
+            tasksInProgress++;
+            queuedTasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Worker thread body.
+ * @param index The worker index.
+ */
+void ThreadPool::workerLoop(size_t index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    std::string errMsg;
+    const bool applied = ThreadHelper::apply(settings, errMsg);
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        if(!applied && setupError.empty())
+        {
+            setupError = errMsg;
+        }
+        ++startedWorkers;
+    }
+    startCondition.notify_all();
+
+    auto idleSince = std::chrono::steady_clock::now();
+    bool idle = false;
+    while(true)
+    {
+        Task task;
+        if(!tryTake(index, task))
+        {
+            if(!idle)
+            {
+                idle = true;
+                idleSince = std::chrono::steady_clock::now();
+            }
+            if(!waitForTask(idleSince))
+            {
+                return;
+            }
+            continue;
+        }
+
+        idle = false;
+        task();
+        task = Task();
+
+        if(--tasksInProgress == 0 && queuedTasks == 0)
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            completionCondition.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Waits until a task is queued or the pool stops, as chosen by the wait strategy.
+ * @param idleSince Time the worker ran out of tasks.
+ * @return False if the pool stopped with no queued tasks (the worker must exit).
+ */
+bool ThreadPool::waitForTask(const std::chrono::steady_clock::time_point& idleSince)
+{
+    if(settings.wait != WaitStrategy::Block)
+    {
+        // The queue count is read without locking the queues, so spinning does not slow producers down
+        const auto spinUntil = idleSince + std::chrono::microseconds(THREAD_HELPER_HYBRID_SPIN_US);
+        while(queuedTasks.load(std::memory_order_acquire) == 0)
+        {
+            if(stop)
+            {
+                return false;
+            }
+            if(settings.wait == WaitStrategy::Hybrid && std::chrono::steady_clock::now() >= spinUntil)
+            {
+                break;
+            }
+            ThreadHelper::relax();
+        }
+        if(queuedTasks.load(std::memory_order_acquire) > 0)
+        {
+            return true;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(waitMutex);
+    condition.wait(lock, [this]
+    {
+        return stop || queuedTasks > 0;
+    });
+
+    if(stop && queuedTasks == 0)
+    {
+        return false;
+    }
+
+    // Counted but not pushed yet: let the producer finish
+    lock.unlock();
+    std::this_thread::yield();
+    return true;
+}
+
+/**
+ * @brief Gets the error of a worker that could not apply the settings.
+ * @return std::string Error message (empty if every worker applied them).
+ */
+std::string ThreadPool::getSetupError() const
+{
+    std::lock_guard<std::mutex> lock(waitMutex);
+    return setupError;
+}
+
+/**
+ * @brief Waits for all tasks to complete.
+ */
 void ThreadPool::waitForCompletion()
 {
-    std::unique_lock<std::mutex> lock(queueMutex);
+    std::unique_lock<std::mutex> lock(waitMutex);
     completionCondition.wait(lock, [this]
     {
-        return tasks.empty() && tasksInProgress == 0;
+        return queuedTasks == 0 && tasksInProgress == 0;
     });
 }
 
+/**
+ * @brief Checks if the task queue is empty and no tasks are in progress.
+ * @return True if the queue is empty and no tasks are in progress, false otherwise.
+ */
 bool ThreadPool::isQueueEmpty()
 {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    return tasks.empty() && tasksInProgress == 0;
+    return queuedTasks == 0 && tasksInProgress == 0;
 }
@@ -17,8 +17,11 @@
  * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
  */
 
+#include <cctype>
 #include "sqlogger/log_config.h"
 #include "sqlogger/internal/ini_parser.h"
+#include "sqlogger/internal/log_cipher.h"
+#include "sqlogger/internal/log_message_compressor.h"
 
 namespace LogConfig
 {
@@ -172,6 +175,47 @@ namespace LogConfig
                     config.numThreads = std::nullopt;
                 }
             }
+            if(loggerSection.count(LOG_INI_KEY_THREAD_AFFINITY))
+            {
+                config.threadAffinity = stringToCpuList(loggerSection.at(LOG_INI_KEY_THREAD_AFFINITY));
+            }
+            if(loggerSection.count(LOG_INI_KEY_THREAD_PRIORITY))
+            {
+                try
+                {
+                    config.threadPriority = std::stoi(loggerSection.at(LOG_INI_KEY_THREAD_PRIORITY));
+                }
+                catch(const std::exception&)
+                {
+                    config.threadPriority = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_WAIT_STRATEGY))
+            {
+                config.waitStrategy = stringToWaitStrategy(loggerSection.at(LOG_INI_KEY_WAIT_STRATEGY));
+            }
+            if(loggerSection.count(LOG_INI_KEY_CONNECTION_POOL_SIZE))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_CONNECTION_POOL_SIZE)))
+                {
+                    config.connectionPoolSize = std::stoi(loggerSection.at(LOG_INI_KEY_CONNECTION_POOL_SIZE));
+                }
+                else
+                {
+                    config.connectionPoolSize = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_READ_POOL_SIZE))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_READ_POOL_SIZE)))
+                {
+                    config.readPoolSize = std::stoi(loggerSection.at(LOG_INI_KEY_READ_POOL_SIZE));
+                }
+                else
+                {
+                    config.readPoolSize = std::nullopt;
+                }
+            }
             if(loggerSection.count(LOG_INI_KEY_ONLY_FILE_NAMES))
             {
                 config.onlyFileNames = LogHelper::toLowerCase(loggerSection.at(LOG_INI_KEY_ONLY_FILE_NAMES)) == "true";
@@ -202,6 +246,261 @@ namespace LogConfig
                     config.batchSize = std::nullopt;
                 }
             }
+            if(loggerSection.count(LOG_INI_KEY_FLUSH_INTERVAL_MS))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_FLUSH_INTERVAL_MS)))
+                {
+                    config.flushIntervalMs = std::stoi(loggerSection.at(LOG_INI_KEY_FLUSH_INTERVAL_MS));
+                }
+                else
+                {
+                    config.flushIntervalMs = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_MAX_BATCH_BYTES))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_MAX_BATCH_BYTES)))
+                {
+                    config.maxBatchBytes = std::stoi(loggerSection.at(LOG_INI_KEY_MAX_BATCH_BYTES));
+                }
+                else
+                {
+                    config.maxBatchBytes = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_ADAPTIVE_BATCH))
+            {
+                config.adaptiveBatch = LogHelper::toLowerCase(loggerSection.at(LOG_INI_KEY_ADAPTIVE_BATCH)) == "true";
+            }
+            if(loggerSection.count(LOG_INI_KEY_TARGET_BATCH_LATENCY_MS))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_TARGET_BATCH_LATENCY_MS)))
+                {
+                    config.targetBatchLatencyMs = std::stoi(loggerSection.at(LOG_INI_KEY_TARGET_BATCH_LATENCY_MS));
+                }
+                else
+                {
+                    config.targetBatchLatencyMs = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_GROUP_COMMIT_BATCHES))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_GROUP_COMMIT_BATCHES)))
+                {
+                    config.groupCommitBatches = std::stoi(loggerSection.at(LOG_INI_KEY_GROUP_COMMIT_BATCHES));
+                }
+                else
+                {
+                    config.groupCommitBatches = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_GROUP_COMMIT_WINDOW_MS))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_GROUP_COMMIT_WINDOW_MS)))
+                {
+                    config.groupCommitWindowMs = std::stoi(loggerSection.at(LOG_INI_KEY_GROUP_COMMIT_WINDOW_MS));
+                }
+                else
+                {
+                    config.groupCommitWindowMs = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_BULK_LOAD_THRESHOLD))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_BULK_LOAD_THRESHOLD)))
+                {
+                    config.bulkLoadThreshold = std::stoi(loggerSection.at(LOG_INI_KEY_BULK_LOAD_THRESHOLD));
+                }
+                else
+                {
+                    config.bulkLoadThreshold = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_USE_RING))
+            {
+                config.useRing = LogHelper::toLowerCase(loggerSection.at(LOG_INI_KEY_USE_RING)) == "true";
+            }
+            if(loggerSection.count(LOG_INI_KEY_RING_CAPACITY))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_RING_CAPACITY)))
+                {
+                    config.ringCapacity = std::stoi(loggerSection.at(LOG_INI_KEY_RING_CAPACITY));
+                }
+                else
+                {
+                    config.ringCapacity = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_BACK_PRESSURE))
+            {
+                config.backPressure = stringToBackPressure(loggerSection.at(LOG_INI_KEY_BACK_PRESSURE));
+            }
+            if(loggerSection.count(LOG_INI_KEY_BACK_PRESSURE_LEVEL))
+            {
+                if(LogHelper::stringToLevel(loggerSection.at(LOG_INI_KEY_BACK_PRESSURE_LEVEL)) != LogLevel::Unknown)
+                {
+                    config.backPressureLevel = LogHelper::stringToLevel(loggerSection.at(LOG_INI_KEY_BACK_PRESSURE_LEVEL));
+                }
+                else
+                {
+                    config.backPressureLevel = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_PRIORITY_LEVEL))
+            {
+                if(LogHelper::stringToLevel(loggerSection.at(LOG_INI_KEY_PRIORITY_LEVEL)) != LogLevel::Unknown)
+                {
+                    config.priorityLevel = LogHelper::stringToLevel(loggerSection.at(LOG_INI_KEY_PRIORITY_LEVEL));
+                }
+                else
+                {
+                    config.priorityLevel = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_SPOOL_PATH))
+            {
+                config.spoolPath = loggerSection.at(LOG_INI_KEY_SPOOL_PATH);
+            }
+            if(loggerSection.count(LOG_INI_KEY_SPOOL_MAX_BYTES))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_SPOOL_MAX_BYTES)))
+                {
+                    config.spoolMaxBytes = std::stoll(loggerSection.at(LOG_INI_KEY_SPOOL_MAX_BYTES));
+                }
+                else
+                {
+                    config.spoolMaxBytes = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_SPOOL_RETRY_MS))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_SPOOL_RETRY_MS)))
+                {
+                    config.spoolRetryMs = std::stoi(loggerSection.at(LOG_INI_KEY_SPOOL_RETRY_MS));
+                }
+                else
+                {
+                    config.spoolRetryMs = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_SAMPLE_RATE))
+            {
+                try
+                {
+                    config.sampleRate = std::stod(loggerSection.at(LOG_INI_KEY_SAMPLE_RATE));
+                }
+                catch(const std::exception&)
+                {
+                    config.sampleRate = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_SAMPLE_LEVEL))
+            {
+                if(LogHelper::stringToLevel(loggerSection.at(LOG_INI_KEY_SAMPLE_LEVEL)) != LogLevel::Unknown)
+                {
+                    config.sampleLevel = LogHelper::stringToLevel(loggerSection.at(LOG_INI_KEY_SAMPLE_LEVEL));
+                }
+                else
+                {
+                    config.sampleLevel = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_RATE_LIMIT_PER_SITE))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_RATE_LIMIT_PER_SITE)))
+                {
+                    config.rateLimitPerSite = std::stoi(loggerSection.at(LOG_INI_KEY_RATE_LIMIT_PER_SITE));
+                }
+                else
+                {
+                    config.rateLimitPerSite = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_RATE_LIMIT_PER_LEVEL))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_RATE_LIMIT_PER_LEVEL)))
+                {
+                    config.rateLimitPerLevel = std::stoi(loggerSection.at(LOG_INI_KEY_RATE_LIMIT_PER_LEVEL));
+                }
+                else
+                {
+                    config.rateLimitPerLevel = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_DEDUP_WINDOW_MS))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_DEDUP_WINDOW_MS)))
+                {
+                    config.dedupWindowMs = std::stoi(loggerSection.at(LOG_INI_KEY_DEDUP_WINDOW_MS));
+                }
+                else
+                {
+                    config.dedupWindowMs = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_SINK_QUEUE_SIZE))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_SINK_QUEUE_SIZE)))
+                {
+                    config.sinkQueueSize = std::stoi(loggerSection.at(LOG_INI_KEY_SINK_QUEUE_SIZE));
+                }
+                else
+                {
+                    config.sinkQueueSize = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_FILE_SINK_PATH))
+            {
+                config.fileSinkPath = loggerSection.at(LOG_INI_KEY_FILE_SINK_PATH);
+            }
+            if(loggerSection.count(LOG_INI_KEY_FILE_SINK_FORMAT))
+            {
+                config.fileSinkFormat = LogExport::stringToFormat(loggerSection.at(LOG_INI_KEY_FILE_SINK_FORMAT));
+            }
+            if(loggerSection.count(LOG_INI_KEY_FILE_SINK_MAX_BYTES))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_FILE_SINK_MAX_BYTES)))
+                {
+                    config.fileSinkMaxBytes = std::stoll(loggerSection.at(LOG_INI_KEY_FILE_SINK_MAX_BYTES));
+                }
+                else
+                {
+                    config.fileSinkMaxBytes = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_FILE_SINK_ROTATE_SECONDS))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_FILE_SINK_ROTATE_SECONDS)))
+                {
+                    config.fileSinkRotateSeconds = std::stoi(loggerSection.at(LOG_INI_KEY_FILE_SINK_ROTATE_SECONDS));
+                }
+                else
+                {
+                    config.fileSinkRotateSeconds = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_FILE_SINK_MAX_FILES))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_FILE_SINK_MAX_FILES)))
+                {
+                    config.fileSinkMaxFiles = std::stoi(loggerSection.at(LOG_INI_KEY_FILE_SINK_MAX_FILES));
+                }
+                else
+                {
+                    config.fileSinkMaxFiles = std::nullopt;
+                }
+            }
+            if(loggerSection.count(LOG_INI_KEY_TAIL_CACHE_SIZE))
+            {
+                if(LogHelper::isNumeric(loggerSection.at(LOG_INI_KEY_TAIL_CACHE_SIZE)))
+                {
+                    config.tailCacheSize = std::stoi(loggerSection.at(LOG_INI_KEY_TAIL_CACHE_SIZE));
+                }
+                else
+                {
+                    config.tailCacheSize = std::nullopt;
+                }
+            }
         }
         if(iniData.count(LOG_INI_SECTION_DATABASE))
         {
@@ -214,6 +513,68 @@ namespace LogConfig
             {
                 config.databaseTable = databaseSection.at(LOG_INI_KEY_DATABASE_TABLE);
             }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_TIMESTAMP_FORMAT))
+            {
+                config.timestampFormat = stringToTimestampFormat(databaseSection.at(LOG_INI_KEY_DATABASE_TIMESTAMP_FORMAT));
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_SCHEMA))
+            {
+                config.schemaLayout = stringToSchemaLayout(databaseSection.at(LOG_INI_KEY_DATABASE_SCHEMA));
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_INDEXES))
+            {
+                config.indexes = stringToIndexes(databaseSection.at(LOG_INI_KEY_DATABASE_INDEXES));
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_DEFER_INDEXES))
+            {
+                config.deferIndexes = LogHelper::toLowerCase(databaseSection.at(LOG_INI_KEY_DATABASE_DEFER_INDEXES)) == "true";
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_MEMORY_MAX_BYTES))
+            {
+                if(LogHelper::isNumeric(databaseSection.at(LOG_INI_KEY_DATABASE_MEMORY_MAX_BYTES)))
+                {
+                    config.memoryMaxBytes = std::stoll(databaseSection.at(LOG_INI_KEY_DATABASE_MEMORY_MAX_BYTES));
+                }
+                else
+                {
+                    config.memoryMaxBytes = std::nullopt;
+                }
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_PARTITIONING))
+            {
+                config.partitioning = stringToPartitioning(databaseSection.at(LOG_INI_KEY_DATABASE_PARTITIONING));
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_RETENTION_DAYS))
+            {
+                if(LogHelper::isNumeric(databaseSection.at(LOG_INI_KEY_DATABASE_RETENTION_DAYS)))
+                {
+                    config.retentionDays = std::stoi(databaseSection.at(LOG_INI_KEY_DATABASE_RETENTION_DAYS));
+                }
+                else
+                {
+                    config.retentionDays = std::nullopt;
+                }
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH))
+            {
+                config.fullTextSearch = LogHelper::toLowerCase(databaseSection.at(LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH)) == "true";
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_SHARE_CONNECTION))
+            {
+                config.shareConnection = LogHelper::toLowerCase(databaseSection.at(LOG_INI_KEY_DATABASE_SHARE_CONNECTION)) == "true";
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_ENCRYPT_MESSAGES))
+            {
+                config.encryptMessages = LogHelper::toLowerCase(databaseSection.at(LOG_INI_KEY_DATABASE_ENCRYPT_MESSAGES)) == "true";
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_COMPRESS_MESSAGES))
+            {
+                config.compressMessages = LogHelper::toLowerCase(databaseSection.at(LOG_INI_KEY_DATABASE_COMPRESS_MESSAGES)) == "true";
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_SHARD_ROUTING))
+            {
+                config.shardRouting = stringToShardRouting(databaseSection.at(LOG_INI_KEY_DATABASE_SHARD_ROUTING));
+            }
             if(databaseSection.count(LOG_INI_KEY_DATABASE_HOST))
             {
                 config.databaseHost = databaseSection.at(LOG_INI_KEY_DATABASE_HOST);
@@ -229,6 +590,21 @@ namespace LogConfig
                     config.databasePort = std::nullopt;
                 }
             }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_READ_HOST))
+            {
+                config.databaseReadHost = databaseSection.at(LOG_INI_KEY_DATABASE_READ_HOST);
+            }
+            if(databaseSection.count(LOG_INI_KEY_DATABASE_READ_PORT))
+            {
+                if(LogHelper::isNumeric(databaseSection.at(LOG_INI_KEY_DATABASE_READ_PORT)))
+                {
+                    config.databaseReadPort = std::stoi(databaseSection.at(LOG_INI_KEY_DATABASE_READ_PORT));
+                }
+                else
+                {
+                    config.databaseReadPort = std::nullopt;
+                }
+            }
             if(databaseSection.count(LOG_INI_KEY_DATABASE_USER))
             {
                 config.databaseUser = databaseSection.at(LOG_INI_KEY_DATABASE_USER);
@@ -256,6 +632,93 @@ namespace LogConfig
                 }
             }
         }
+        // Shard sections are numbered from 1 without gaps
+        for(int shard = 1; shard <= LOG_SHARDS_MAX; ++shard)
+        {
+            const std::string sectionName = std::string(LOG_INI_SECTION_DATABASE) + LOG_INI_SECTION_DATABASE_SHARD_SEPARATOR + std::to_string(shard);
+            if(!iniData.count(sectionName))
+            {
+                break;
+            }
+
+            const auto& shardSection = iniData[sectionName];
+            DatabaseTarget target;
+            if(shardSection.count(LOG_INI_KEY_DATABASE_NAME))
+            {
+                target.name = shardSection.at(LOG_INI_KEY_DATABASE_NAME);
+            }
+            if(shardSection.count(LOG_INI_KEY_DATABASE_HOST))
+            {
+                target.host = shardSection.at(LOG_INI_KEY_DATABASE_HOST);
+            }
+            if(shardSection.count(LOG_INI_KEY_DATABASE_PORT) && LogHelper::isNumeric(shardSection.at(LOG_INI_KEY_DATABASE_PORT)))
+            {
+                target.port = std::stoi(shardSection.at(LOG_INI_KEY_DATABASE_PORT));
+            }
+            if(shardSection.count(LOG_INI_KEY_DATABASE_USER))
+            {
+                target.user = shardSection.at(LOG_INI_KEY_DATABASE_USER);
+            }
+            if(shardSection.count(LOG_INI_KEY_DATABASE_PASS))
+            {
+                if(!config.passKey.has_value() || config.passKey.value().empty())
+                {
+                    throw std::runtime_error(ERR_MSG_PASSKEY_EMPTY);
+                }
+                target.pass = LogCrypto::decrypt(shardSection.at(LOG_INI_KEY_DATABASE_PASS), config.passKey.value());
+            }
+
+            if(!config.shards.has_value())
+            {
+                config.shards = std::vector<DatabaseTarget>();
+            }
+            config.shards->push_back(std::move(target));
+        }
+        if(iniData.count(LOG_INI_SECTION_SQLITE))
+        {
+            const auto& sqliteSection = iniData[LOG_INI_SECTION_SQLITE];
+            if(sqliteSection.count(LOG_INI_KEY_SQLITE_JOURNAL_MODE))
+            {
+                config.sqliteJournalMode = sqliteSection.at(LOG_INI_KEY_SQLITE_JOURNAL_MODE);
+            }
+            if(sqliteSection.count(LOG_INI_KEY_SQLITE_SYNCHRONOUS))
+            {
+                config.sqliteSynchronous = sqliteSection.at(LOG_INI_KEY_SQLITE_SYNCHRONOUS);
+            }
+            if(sqliteSection.count(LOG_INI_KEY_SQLITE_CACHE_SIZE))
+            {
+                if(LogHelper::isNumeric(sqliteSection.at(LOG_INI_KEY_SQLITE_CACHE_SIZE)))
+                {
+                    config.sqliteCacheSize = std::stoi(sqliteSection.at(LOG_INI_KEY_SQLITE_CACHE_SIZE));
+                }
+                else
+                {
+                    config.sqliteCacheSize = std::nullopt;
+                }
+            }
+            if(sqliteSection.count(LOG_INI_KEY_SQLITE_MMAP_SIZE))
+            {
+                if(LogHelper::isNumeric(sqliteSection.at(LOG_INI_KEY_SQLITE_MMAP_SIZE)))
+                {
+                    config.sqliteMmapSize = std::stoll(sqliteSection.at(LOG_INI_KEY_SQLITE_MMAP_SIZE));
+                }
+                else
+                {
+                    config.sqliteMmapSize = std::nullopt;
+                }
+            }
+            if(sqliteSection.count(LOG_INI_KEY_SQLITE_PAGE_SIZE))
+            {
+                if(LogHelper::isNumeric(sqliteSection.at(LOG_INI_KEY_SQLITE_PAGE_SIZE)))
+                {
+                    config.sqlitePageSize = std::stoi(sqliteSection.at(LOG_INI_KEY_SQLITE_PAGE_SIZE));
+                }
+                else
+                {
+                    config.sqlitePageSize = std::nullopt;
+                }
+            }
+        }
         if(iniData.count(LOG_INI_SECTION_TRANSPORT))
         {
             const auto& transportSection = iniData[LOG_INI_SECTION_TRANSPORT];
@@ -279,6 +742,50 @@ namespace LogConfig
                     config.transportPort = std::nullopt;
                 }
             }
+            if(transportSection.count(LOG_INI_KEY_TRANSPORT_BATCH_MAX_ENTRIES))
+            {
+                if(LogHelper::isNumeric(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_ENTRIES)))
+                {
+                    config.transportBatchMaxEntries = std::stoi(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_ENTRIES));
+                }
+                else
+                {
+                    config.transportBatchMaxEntries = std::nullopt;
+                }
+            }
+            if(transportSection.count(LOG_INI_KEY_TRANSPORT_BATCH_MAX_BYTES))
+            {
+                if(LogHelper::isNumeric(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_BYTES)))
+                {
+                    config.transportBatchMaxBytes = std::stoi(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_BYTES));
+                }
+                else
+                {
+                    config.transportBatchMaxBytes = std::nullopt;
+                }
+            }
+            if(transportSection.count(LOG_INI_KEY_TRANSPORT_BATCH_MAX_DELAY))
+            {
+                if(LogHelper::isNumeric(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_DELAY)))
+                {
+                    config.transportBatchMaxDelay = std::stoi(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_DELAY));
+                }
+                else
+                {
+                    config.transportBatchMaxDelay = std::nullopt;
+                }
+            }
+            if(transportSection.count(LOG_INI_KEY_TRANSPORT_BATCH_MAX_IN_FLIGHT))
+            {
+                if(LogHelper::isNumeric(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_IN_FLIGHT)))
+                {
+                    config.transportBatchMaxInFlight = std::stoi(transportSection.at(LOG_INI_KEY_TRANSPORT_BATCH_MAX_IN_FLIGHT));
+                }
+                else
+                {
+                    config.transportBatchMaxInFlight = std::nullopt;
+                }
+            }
         }
 #ifdef SQLG_USE_SOURCE_INFO
         if(iniData.count(LOG_INI_SECTION_SOURCE))
@@ -317,7 +824,27 @@ namespace LogConfig
         }
         if(config.numThreads.has_value())
         {
-            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_NUM_THREADS] = std::to_string(config.numThreads.value());
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_NUM_THREADS] = std::to_string(config.numThreads.value());
+        }
+        if(config.threadAffinity.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_THREAD_AFFINITY] = cpuListToString(config.threadAffinity.value());
+        }
+        if(config.threadPriority.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_THREAD_PRIORITY] = std::to_string(config.threadPriority.value());
+        }
+        if(config.waitStrategy.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_WAIT_STRATEGY] = waitStrategyToString(config.waitStrategy.value());
+        }
+        if(config.connectionPoolSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_CONNECTION_POOL_SIZE] = std::to_string(config.connectionPoolSize.value());
+        }
+        if(config.readPoolSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_READ_POOL_SIZE] = std::to_string(config.readPoolSize.value());
         }
         if(config.onlyFileNames.has_value())
         {
@@ -335,6 +862,114 @@ namespace LogConfig
         {
             iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_BATCH_SIZE] = std::to_string(config.batchSize.value());
         }
+        if(config.flushIntervalMs.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_FLUSH_INTERVAL_MS] = std::to_string(config.flushIntervalMs.value());
+        }
+        if(config.maxBatchBytes.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_MAX_BATCH_BYTES] = std::to_string(config.maxBatchBytes.value());
+        }
+        if(config.adaptiveBatch.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_ADAPTIVE_BATCH] = config.adaptiveBatch.value() ? "true" : "false";
+        }
+        if(config.targetBatchLatencyMs.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_TARGET_BATCH_LATENCY_MS] = std::to_string(config.targetBatchLatencyMs.value());
+        }
+        if(config.groupCommitBatches.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_GROUP_COMMIT_BATCHES] = std::to_string(config.groupCommitBatches.value());
+        }
+        if(config.groupCommitWindowMs.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_GROUP_COMMIT_WINDOW_MS] = std::to_string(config.groupCommitWindowMs.value());
+        }
+        if(config.bulkLoadThreshold.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_BULK_LOAD_THRESHOLD] = std::to_string(config.bulkLoadThreshold.value());
+        }
+        if(config.useRing.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_USE_RING] = config.useRing.value() ? "true" : "false";
+        }
+        if(config.ringCapacity.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_RING_CAPACITY] = std::to_string(config.ringCapacity.value());
+        }
+        if(config.backPressure.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_BACK_PRESSURE] = backPressureToString(config.backPressure.value());
+        }
+        if(config.backPressureLevel.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_BACK_PRESSURE_LEVEL] = LogHelper::levelToString(config.backPressureLevel.value());
+        }
+        if(config.priorityLevel.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_PRIORITY_LEVEL] = LogHelper::levelToString(config.priorityLevel.value());
+        }
+        if(config.spoolPath.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_SPOOL_PATH] = config.spoolPath.value();
+        }
+        if(config.spoolMaxBytes.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_SPOOL_MAX_BYTES] = std::to_string(config.spoolMaxBytes.value());
+        }
+        if(config.spoolRetryMs.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_SPOOL_RETRY_MS] = std::to_string(config.spoolRetryMs.value());
+        }
+        if(config.sampleRate.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_SAMPLE_RATE] = std::to_string(config.sampleRate.value());
+        }
+        if(config.sampleLevel.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_SAMPLE_LEVEL] = LogHelper::levelToString(config.sampleLevel.value());
+        }
+        if(config.rateLimitPerSite.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_RATE_LIMIT_PER_SITE] = std::to_string(config.rateLimitPerSite.value());
+        }
+        if(config.rateLimitPerLevel.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_RATE_LIMIT_PER_LEVEL] = std::to_string(config.rateLimitPerLevel.value());
+        }
+        if(config.dedupWindowMs.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_DEDUP_WINDOW_MS] = std::to_string(config.dedupWindowMs.value());
+        }
+        if(config.sinkQueueSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_SINK_QUEUE_SIZE] = std::to_string(config.sinkQueueSize.value());
+        }
+        if(config.fileSinkPath.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_FILE_SINK_PATH] = config.fileSinkPath.value();
+        }
+        if(config.fileSinkFormat.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_FILE_SINK_FORMAT] = LogExport::formatToString(config.fileSinkFormat.value());
+        }
+        if(config.fileSinkMaxBytes.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_FILE_SINK_MAX_BYTES] = std::to_string(config.fileSinkMaxBytes.value());
+        }
+        if(config.fileSinkRotateSeconds.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_FILE_SINK_ROTATE_SECONDS] = std::to_string(config.fileSinkRotateSeconds.value());
+        }
+        if(config.fileSinkMaxFiles.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_FILE_SINK_MAX_FILES] = std::to_string(config.fileSinkMaxFiles.value());
+        }
+        if(config.tailCacheSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_LOGGER][LOG_INI_KEY_TAIL_CACHE_SIZE] = std::to_string(config.tailCacheSize.value());
+        }
         if(config.databaseName.has_value())
         {
             iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_NAME] = config.databaseName.value();
@@ -343,6 +978,86 @@ namespace LogConfig
         {
             iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_TABLE] = config.databaseTable.value();
         }
+        if(config.timestampFormat.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_TIMESTAMP_FORMAT] = timestampFormatToString(config.timestampFormat.value());
+        }
+        if(config.schemaLayout.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_SCHEMA] = schemaLayoutToString(config.schemaLayout.value());
+        }
+        if(config.indexes.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_INDEXES] = indexesToString(config.indexes.value());
+        }
+        if(config.deferIndexes.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_DEFER_INDEXES] = config.deferIndexes.value() ? "true" : "false";
+        }
+        if(config.memoryMaxBytes.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_MEMORY_MAX_BYTES] = std::to_string(config.memoryMaxBytes.value());
+        }
+        if(config.partitioning.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_PARTITIONING] = partitioningToString(config.partitioning.value());
+        }
+        if(config.retentionDays.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_RETENTION_DAYS] = std::to_string(config.retentionDays.value());
+        }
+        if(config.fullTextSearch.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH] = config.fullTextSearch.value() ? "true" : "false";
+        }
+        if(config.shareConnection.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_SHARE_CONNECTION] = config.shareConnection.value() ? "true" : "false";
+        }
+        if(config.encryptMessages.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_ENCRYPT_MESSAGES] = config.encryptMessages.value() ? "true" : "false";
+        }
+        if(config.compressMessages.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_COMPRESS_MESSAGES] = config.compressMessages.value() ? "true" : "false";
+        }
+        if(config.shardRouting.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_SHARD_ROUTING] = shardRoutingToString(config.shardRouting.value());
+        }
+        if(config.shards.has_value())
+        {
+            for(size_t shard = 0; shard < config.shards->size(); ++shard)
+            {
+                const DatabaseTarget& target = config.shards->at(shard);
+                auto& shardSection = iniData[std::string(LOG_INI_SECTION_DATABASE) + LOG_INI_SECTION_DATABASE_SHARD_SEPARATOR + std::to_string(shard + 1)];
+                if(target.name.has_value())
+                {
+                    shardSection[LOG_INI_KEY_DATABASE_NAME] = target.name.value();
+                }
+                if(target.host.has_value())
+                {
+                    shardSection[LOG_INI_KEY_DATABASE_HOST] = target.host.value();
+                }
+                if(target.port.has_value())
+                {
+                    shardSection[LOG_INI_KEY_DATABASE_PORT] = std::to_string(target.port.value());
+                }
+                if(target.user.has_value())
+                {
+                    shardSection[LOG_INI_KEY_DATABASE_USER] = target.user.value();
+                }
+                if(target.pass.has_value())
+                {
+                    if(!config.passKey.has_value() || config.passKey.value().empty())
+                    {
+                        throw std::runtime_error(ERR_MSG_PASSKEY_EMPTY);
+                    }
+                    shardSection[LOG_INI_KEY_DATABASE_PASS] = LogCrypto::encrypt(target.pass.value(), config.passKey.value());
+                }
+            }
+        }
         if(config.databaseHost.has_value())
         {
             iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_HOST] = config.databaseHost.value();
@@ -351,6 +1066,14 @@ namespace LogConfig
         {
             iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_PORT] = std::to_string(config.databasePort.value());
         }
+        if(config.databaseReadHost.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_READ_HOST] = config.databaseReadHost.value();
+        }
+        if(config.databaseReadPort.has_value())
+        {
+            iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_READ_PORT] = std::to_string(config.databaseReadPort.value());
+        }
         if(config.databaseUser.has_value())
         {
             iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_USER] = config.databaseUser.value();
@@ -370,6 +1093,26 @@ namespace LogConfig
         {
             iniData[LOG_INI_SECTION_DATABASE][LOG_INI_KEY_DATABASE_TYPE] = DataBaseHelper::databaseTypeToString(config.databaseType.value());
         }
+        if(config.sqliteJournalMode.has_value())
+        {
+            iniData[LOG_INI_SECTION_SQLITE][LOG_INI_KEY_SQLITE_JOURNAL_MODE] = config.sqliteJournalMode.value();
+        }
+        if(config.sqliteSynchronous.has_value())
+        {
+            iniData[LOG_INI_SECTION_SQLITE][LOG_INI_KEY_SQLITE_SYNCHRONOUS] = config.sqliteSynchronous.value();
+        }
+        if(config.sqliteCacheSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_SQLITE][LOG_INI_KEY_SQLITE_CACHE_SIZE] = std::to_string(config.sqliteCacheSize.value());
+        }
+        if(config.sqliteMmapSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_SQLITE][LOG_INI_KEY_SQLITE_MMAP_SIZE] = std::to_string(config.sqliteMmapSize.value());
+        }
+        if(config.sqlitePageSize.has_value())
+        {
+            iniData[LOG_INI_SECTION_SQLITE][LOG_INI_KEY_SQLITE_PAGE_SIZE] = std::to_string(config.sqlitePageSize.value());
+        }
 #ifdef SQLG_USE_SOURCE_INFO
         if(config.sourceUuid.has_value())
         {
@@ -394,6 +1137,7 @@ namespace LogConfig
     *
     * @note Connection string format varies by database type:
     *       - Mock/SQLite: Returns just the database name (or empty string)
+    *       - Memory: "Name=value;MaxBytes=value" format (MaxBytes only if memoryMaxBytes is set)
     *       - MySQL: "host=value;user=value;password=value" format
     *       - PostgreSQL: "host=value user=value password=value" format (space-separated)
     *       - MongoDB: "host=value;user=value;password=value" format
@@ -422,6 +1166,16 @@ namespace LogConfig
                 return config.databaseName.value_or("");
                 break;
 
+            case DataBaseType::Memory:
+            {
+                std::string connectionString = std::string(MEMORY_CON_STR_NAME) + "=" + config.databaseName.value_or("");
+                if(config.memoryMaxBytes.has_value())
+                    connectionString += std::string(";") + MEMORY_CON_STR_MAX_BYTES + "=" + std::to_string(std::max(config.memoryMaxBytes.value(), 0LL));
+
+                return connectionString;
+            }
+            break;
+
             case DataBaseType::MySQL:
             {
                 std::vector<std::string> parts;
@@ -485,6 +1239,91 @@ namespace LogConfig
         }
     };
 
+    /**
+    * @brief Gets the maximum batch size allowed by a configuration
+    * @param config Configuration object containing database type and bulk-load threshold
+    * @return int DataBaseHelper::getMaxBatchSize() of the database type, or DB_MAX_BATCH_BULK
+    *         if the backend supports bulk load and every batch too large for an INSERT
+    *         (bulkLoadThreshold <= INSERT limit) goes through it
+    * @see DataBaseHelper::isBulkLoadSupported()
+    */
+    int getMaxBatchSize(const Config& config)
+    {
+        if(!config.databaseType.has_value())
+        {
+            throw std::runtime_error(ERR_MSG_DB_TYPE_NOT_SPECIFIED);
+        }
+
+        const int insertLimit = DataBaseHelper::getMaxBatchSize(config.databaseType.value());
+        const int threshold = config.bulkLoadThreshold.value_or(LOG_DEFAULT_BULK_LOAD_THRESHOLD);
+
+        if(DataBaseHelper::isBulkLoadSupported(config.databaseType.value()) && threshold > 0 && threshold <= insertLimit)
+        {
+            return DB_MAX_BATCH_BULK;
+        }
+        return insertLimit;
+    }
+
+    /**
+    * @brief Extracts the logger thread settings from a LogConfig::Config object
+    * @param config Configuration object containing thread affinity, priority and wait strategy
+    * @return ThreadHelper::Settings Settings applied by every logger thread when it starts
+    */
+    ThreadHelper::Settings getThreadSettings(const Config& config)
+    {
+        ThreadHelper::Settings settings;
+        settings.cpus = config.threadAffinity.value_or(std::vector<int>());
+        settings.priority = config.threadPriority;
+        settings.wait = config.waitStrategy.value_or(LOG_DEFAULT_WAIT_STRATEGY);
+        return settings;
+    }
+
+    /**
+    * @brief Gets the configuration of every shard
+    * @param config Configuration object containing [Database] and the shard targets
+    * @return std::vector<Config> One configuration per shard ([Database] first), only the
+    *         connection parameters differ; a single item if sharding is not configured
+    */
+    std::vector<Config> getShardConfigs(const Config& config)
+    {
+        std::vector<Config> shardConfigs{ config };
+        if(!config.shards.has_value())
+        {
+            return shardConfigs;
+        }
+
+        for(const auto & target : config.shards.value())
+        {
+            Config shardConfig = config;
+            shardConfig.shards = std::nullopt;
+            if(target.name.has_value()) shardConfig.databaseName = target.name;
+            if(target.host.has_value()) shardConfig.databaseHost = target.host;
+            if(target.port.has_value()) shardConfig.databasePort = target.port;
+            if(target.user.has_value()) shardConfig.databaseUser = target.user;
+            if(target.pass.has_value()) shardConfig.databasePass = target.pass;
+            shardConfigs.push_back(std::move(shardConfig));
+        }
+        shardConfigs.front().shards = std::nullopt;
+        return shardConfigs;
+    };
+
+    /**
+    * @brief Extracts SQLite connection tuning from a LogConfig::Config object
+    * @param config Configuration object containing [SQLite] parameters
+    * @return SQLitePragmas Pragmas to apply on every SQLite (re)connect
+    * @see SQLiteDatabase
+    */
+    SQLitePragmas configToSQLitePragmas(const Config& config)
+    {
+        SQLitePragmas pragmas;
+        pragmas.journalMode = config.sqliteJournalMode;
+        pragmas.synchronous = config.sqliteSynchronous;
+        pragmas.cacheSize = config.sqliteCacheSize;
+        pragmas.mmapSize = config.sqliteMmapSize;
+        pragmas.pageSize = config.sqlitePageSize;
+        return pragmas;
+    }
+
     /**
     * @brief Checks for potential SQL injection patterns in input string
     * @param input The string to validate
@@ -513,7 +1352,7 @@ namespace LogConfig
     * - invalidParams: List of invalid parameters with error messages
     * @note This method combines results from all specific validators (name, database, etc.)
     * @see validateName(), validateDatabase(), validateThreads()
-    * @see validateSource(), validateBatch(), validateLogLevel()
+    * @see validateSource(), validateBatch(), validateLogLevel(), validateThrottle(), validateSinks()
     */
     ValidateResult Config::validate() const
     {
@@ -543,6 +1382,36 @@ namespace LogConfig
             finalResult.merge(batchResult);
         }
 
+        ValidateResult ringResult = validateRing();
+        if(!ringResult.ok())
+        {
+            finalResult.merge(ringResult);
+        }
+
+        ValidateResult spoolResult = validateSpool();
+        if(!spoolResult.ok())
+        {
+            finalResult.merge(spoolResult);
+        }
+
+        ValidateResult throttleResult = validateThrottle();
+        if(!throttleResult.ok())
+        {
+            finalResult.merge(throttleResult);
+        }
+
+        ValidateResult sinksResult = validateSinks();
+        if(!sinksResult.ok())
+        {
+            finalResult.merge(sinksResult);
+        }
+
+        ValidateResult sqliteResult = validateSQLite();
+        if(!sqliteResult.ok())
+        {
+            finalResult.merge(sqliteResult);
+        }
+
         ValidateResult databaseResult = validateDatabase();
         if(!databaseResult.ok())
         {
@@ -666,6 +1535,154 @@ namespace LogConfig
             }
         };
 
+        if(databaseReadHost && (databaseReadHost->empty()
+                                || (databaseType && !DataBaseHelper::isDataBaseServer( * databaseType))))
+        {
+            result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_READ_HOST),
+                              "Read host must be a non empty replica address of a MySQL or PostgreSQL server");
+        }
+
+        if(databaseReadPort && ( * databaseReadPort > LOG_MAX_PORT_NUM || * databaseReadPort < LOG_MIN_PORT_NUM))
+        {
+            result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_READ_PORT),
+                              "Port number must be between " + std::to_string(LOG_MIN_PORT_NUM)
+                              + " and " + std::to_string(LOG_MAX_PORT_NUM));
+        }
+
+        if(memoryMaxBytes && * memoryMaxBytes < 0)
+        {
+            result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_MEMORY_MAX_BYTES),
+                              "Memory max bytes cannot be negative (" + std::to_string( * memoryMaxBytes) + ")");
+        }
+
+        const bool dailyPartitions = partitioning.value_or(Partitioning::None) == Partitioning::Daily;
+        if(dailyPartitions && databaseType && !DataBaseHelper::isPartitioningSupported( * databaseType))
+        {
+            result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_PARTITIONING),
+                              "Partitioning is supported by SQLite, MySQL and PostgreSQL only");
+        }
+
+        if(retentionDays && * retentionDays < 0)
+        {
+            result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_RETENTION_DAYS),
+                              "Retention days cannot be negative (" + std::to_string( * retentionDays) + ")");
+        }
+        else if(retentionDays && * retentionDays > 0 && !dailyPartitions)
+        {
+            result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_RETENTION_DAYS),
+                              "Retention drops whole partitions and requires Daily partitioning");
+        }
+
+        if(fullTextSearch.value_or(false) && databaseType)
+        {
+            if(!DataBaseHelper::isFullTextSearchSupported( * databaseType))
+            {
+                result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH),
+                                  "Full-text search is supported by SQLite, MySQL and PostgreSQL only");
+            }
+            else if(dailyPartitions && * databaseType != DataBaseType::PostgreSQL)
+            {
+                // SQLite partitions are separate tables, MySQL partitioned tables have no FULLTEXT indexes
+                result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH),
+                                  "Full-text search with Daily partitioning is supported by PostgreSQL only");
+            }
+        }
+
+        if(encryptMessages.value_or(false))
+        {
+            const std::string tag = tagDatabase + std::string(LOG_INI_KEY_DATABASE_ENCRYPT_MESSAGES);
+            if(!LogCipher::isSupported())
+            {
+                result.addInvalid(tag, ERR_MSG_CIPHER_NOT_SUPPORTED);
+            }
+            else if(!passKey.has_value() || passKey.value().empty())
+            {
+                result.addInvalid(tag, "Message encryption requires a pass key");
+            }
+            else if(databaseType && !DataBaseHelper::isEncryptionSupported( * databaseType))
+            {
+                result.addInvalid(tag, "Message encryption is supported by SQLite, MySQL and PostgreSQL only");
+            }
+            else if(fullTextSearch.value_or(false))
+            {
+                // The index would only see ciphertext
+                result.addInvalid(tag, "Message encryption can't be combined with full-text search");
+            }
+        }
+
+        if(compressMessages.value_or(false))
+        {
+            const std::string tag = tagDatabase + std::string(LOG_INI_KEY_DATABASE_COMPRESS_MESSAGES);
+            if(!LogMessageCompressor::isSupported())
+            {
+                result.addInvalid(tag, ERR_MSG_MESSAGE_COMPRESSION_NOT_SUPPORTED);
+            }
+            else if(databaseType && !DataBaseHelper::isMessageCompressionSupported( * databaseType))
+            {
+                result.addInvalid(tag, "Message compression is supported by SQLite, MySQL and PostgreSQL only");
+            }
+            else if(encryptMessages.value_or(false))
+            {
+                // Ciphertext doesn't compress
+                result.addInvalid(tag, "Message compression can't be combined with message encryption");
+            }
+            else if(fullTextSearch.value_or(false))
+            {
+                // The index would only see compressed text
+                result.addInvalid(tag, "Message compression can't be combined with full-text search");
+            }
+        }
+
+        if(shards.has_value() && !shards->empty())
+        {
+            if(shards->size() > LOG_SHARDS_MAX)
+            {
+                result.addInvalid(tagDatabase, "More than " + std::to_string(LOG_SHARDS_MAX) + " shards");
+            }
+
+            // The sharded database stores the entries like a backend without SQL
+            if(dailyPartitions)
+            {
+                result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_PARTITIONING), "Partitioning can't be combined with sharding");
+            }
+            if(fullTextSearch.value_or(false))
+            {
+                result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_FULL_TEXT_SEARCH), "Full-text search can't be combined with sharding");
+            }
+            if(shareConnection.value_or(false))
+            {
+                result.addInvalid(tagDatabase + std::string(LOG_INI_KEY_DATABASE_SHARE_CONNECTION), "Shared connections can't be combined with sharding");
+            }
+
+            for(size_t shard = 0; shard < shards->size(); ++shard)
+            {
+                const DatabaseTarget& target = shards->at(shard);
+                const std::string tagShard = "[" + std::string(LOG_INI_SECTION_DATABASE) + LOG_INI_SECTION_DATABASE_SHARD_SEPARATOR + std::to_string(shard + 1) + "]";
+                if(!target.name && !target.host && !target.port)
+                {
+                    result.addInvalid(tagShard, "Shard needs its own database name, host or port");
+                }
+                if(target.name && target.name->empty())
+                {
+                    result.addInvalid(tagShard + LOG_INI_KEY_DATABASE_NAME, "Shard database name is empty");
+                }
+                else if(target.name && containsSQLInjection(target.name.value()))
+                {
+                    result.addInvalid(tagShard + LOG_INI_KEY_DATABASE_NAME, ERR_MSG_DANGEROUS_SQL_PAT + std::string("'") + target.name.value() + std::string("'"));
+                }
+                if(target.user && containsSQLInjection(target.user.value()))
+                {
+                    result.addInvalid(tagShard + LOG_INI_KEY_DATABASE_USER, ERR_MSG_DANGEROUS_SQL_PAT + std::string("'") + target.user.value() + std::string("'"));
+                }
+                if(target.port && ( * target.port > LOG_MAX_PORT_NUM || * target.port < LOG_MIN_PORT_NUM))
+                {
+                    result.addInvalid(tagShard + LOG_INI_KEY_DATABASE_PORT,
+                                      "Port number must be between " + std::to_string(LOG_MIN_PORT_NUM)
+                                      + " and " + std::to_string(LOG_MAX_PORT_NUM));
+                }
+            }
+        }
+
         validateSQLInjection(LOG_INI_KEY_DATABASE_NAME, databaseName);
         validateSQLInjection(LOG_INI_KEY_DATABASE_TABLE, databaseTable);
         validateSQLInjection(LOG_INI_KEY_DATABASE_USER, databaseUser);
@@ -682,6 +1699,12 @@ namespace LogConfig
     * @details Checks:
     * - Thread count is within allowed range (1-256)
     * - Thread count is present if async mode is enabled
+    * - Connection pool size is within allowed range (0-256) and used only with MySQL/PostgreSQL
+    * - Tail cache size is not negative (the cache is not used with a connection pool)
+    * - Read pool size is within allowed range (0-256), used only with SQLite, MySQL and PostgreSQL,
+    *   and on SQLite only with a WAL database file (other journal modes block readers while writing)
+    * - CPU indexes of the thread affinity are not negative
+    * - Thread priority is within THREAD_HELPER_PRIORITY_MIN - THREAD_HELPER_PRIORITY_MAX
     */
     ValidateResult Config::validateThreads() const
     {
@@ -706,6 +1729,66 @@ namespace LogConfig
                 result.addInvalid(tagLogger + std::string(LOG_INI_KEY_NUM_THREADS), detail.str());
             }
         }
+
+        if(threadAffinity && std::any_of(threadAffinity->begin(), threadAffinity->end(), [](const int cpu)
+    {
+        return cpu < 0;
+    }))
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_THREAD_AFFINITY),
+                              "CPU index cannot be negative (" + cpuListToString( * threadAffinity) + ")");
+        }
+        if(threadPriority && ( * threadPriority < THREAD_HELPER_PRIORITY_MIN || * threadPriority > THREAD_HELPER_PRIORITY_MAX))
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_THREAD_PRIORITY),
+                              "Thread priority must be within " + std::to_string(THREAD_HELPER_PRIORITY_MIN)
+                              + " - " + std::to_string(THREAD_HELPER_PRIORITY_MAX)
+                              + " (" + std::to_string( * threadPriority) + ")");
+        }
+
+        if(connectionPoolSize)
+        {
+            if( * connectionPoolSize < 0 || * connectionPoolSize > LOG_NUM_THREADS_MAX)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_CONNECTION_POOL_SIZE),
+                                  "Connection pool size must be between 0 and " + std::to_string(LOG_NUM_THREADS_MAX)
+                                  + " (" + std::to_string( * connectionPoolSize) + ")");
+            }
+            else if( * connectionPoolSize > 0 && databaseType
+                     && !DataBaseHelper::isConnectionPoolSupported( * databaseType))
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_CONNECTION_POOL_SIZE),
+                                  "Connection pool is supported only for MySQL and PostgreSQL");
+            }
+        }
+
+        if(readPoolSize)
+        {
+            if( * readPoolSize < 0 || * readPoolSize > LOG_NUM_THREADS_MAX)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_READ_POOL_SIZE),
+                                  "Read pool size must be between 0 and " + std::to_string(LOG_NUM_THREADS_MAX)
+                                  + " (" + std::to_string( * readPoolSize) + ")");
+            }
+            else if( * readPoolSize > 0 && databaseType
+                     && !DataBaseHelper::isReadPoolSupported( * databaseType))
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_READ_POOL_SIZE),
+                                  "Read pool is supported only for SQLite, MySQL and PostgreSQL");
+            }
+            else if( * readPoolSize > 0 && databaseType && * databaseType == DataBaseType::SQLite
+                     && ((sqliteJournalMode && LogHelper::toUpperCase( * sqliteJournalMode) != "WAL")
+                         || (databaseName && * databaseName == ":memory:")))
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_READ_POOL_SIZE),
+                                  "Read pool requires a SQLite database file in WAL journal mode");
+            }
+        }
+
+        if(tailCacheSize && * tailCacheSize < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_TAIL_CACHE_SIZE), "Tail cache size can't be negative");
+        }
         return result;
     };
 
@@ -718,6 +1801,8 @@ namespace LogConfig
     * @details Checks:
     * - Batch size is within allowed range for database type (1-10000 depends on database type)
     * - Batch size is present if async mode is enabled
+    * - Flush interval, max batch bytes and group commit settings are not negative
+    * - The adaptive batching target latency is positive
     * @see getMaxBatchSize()
     * @see DB_MAX_BATCH_SQLITE, DB_MAX_BATCH_MYSQL, DB_MAX_BATCH_POSTGRESQL
     */
@@ -740,7 +1825,8 @@ namespace LogConfig
             {
                 if(databaseType)
                 {
-                    if( * batchSize < 1 || * batchSize > DataBaseHelper::getMaxBatchSize( * databaseType))
+                    const int maxBatchSize = LogConfig::getMaxBatchSize( * this);
+                    if( * batchSize < 1 || * batchSize > maxBatchSize)
                     {
                         std::ostringstream detail;
                         detail << "Batch size for "
@@ -748,12 +1834,42 @@ namespace LogConfig
                                << " could not be "
                                << (batchSize < DB_MIN_BATCH_SIZE
                                    ? "lesser than " + std::to_string(DB_MIN_BATCH_SIZE)
-                                   : "bigger than " + std::to_string(DataBaseHelper::getMaxBatchSize( * databaseType)))
+                                   : "bigger than " + std::to_string(maxBatchSize))
                                << " (" << * batchSize << ")";
                         result.addInvalid(tagLogger + std::string(LOG_INI_KEY_BATCH_SIZE), detail.str());
                     }
                 }
             }
+
+            if(flushIntervalMs && * flushIntervalMs < 0)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_FLUSH_INTERVAL_MS), "Flush interval can't be negative");
+            }
+
+            if(maxBatchBytes && * maxBatchBytes < 0)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_MAX_BATCH_BYTES), "Max batch bytes can't be negative");
+            }
+
+            if(adaptiveBatch.value_or(LOG_DEFAULT_ADAPTIVE_BATCH) && targetBatchLatencyMs && * targetBatchLatencyMs <= 0)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_TARGET_BATCH_LATENCY_MS), "Target batch latency must be positive");
+            }
+
+            if(bulkLoadThreshold && * bulkLoadThreshold < 0)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_BULK_LOAD_THRESHOLD), "Bulk load threshold can't be negative");
+            }
+
+            if(groupCommitBatches && * groupCommitBatches < 0)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_GROUP_COMMIT_BATCHES), "Group commit batches can't be negative");
+            }
+
+            if(groupCommitWindowMs && * groupCommitWindowMs < 0)
+            {
+                result.addInvalid(tagLogger + std::string(LOG_INI_KEY_GROUP_COMMIT_WINDOW_MS), "Group commit window can't be negative");
+            }
         }
         return result;
     };
@@ -785,6 +1901,180 @@ namespace LogConfig
         return result;
     }
 
+    /**
+    * @brief Validates ingestion ring configuration
+    * @return ValidateResult Contains:
+    * - success: true if ring configuration is valid
+    * - missingParams: Empty (ring parameters have default values)
+    * - invalidParams: Contains error if ring capacity is out of valid range
+    * @details Checks:
+    * - Ring capacity is within allowed range (LOG_RING_CAPACITY_MIN - LOG_RING_CAPACITY_MAX)
+    */
+    ValidateResult Config::validateRing() const
+    {
+        ValidateResult result;
+
+        if(useRing && useRing.value() && ringCapacity
+                && ( * ringCapacity < LOG_RING_CAPACITY_MIN || * ringCapacity > LOG_RING_CAPACITY_MAX))
+        {
+            std::ostringstream detail;
+            detail << "Ring capacity must be between "
+                   << LOG_RING_CAPACITY_MIN << " and " << LOG_RING_CAPACITY_MAX
+                   << " (" << * ringCapacity << ")";
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_RING_CAPACITY), detail.str());
+        }
+        return result;
+    }
+
+    /**
+    * @brief Validates spool configuration
+    * @return ValidateResult Contains:
+    * - success: true if spool configuration is valid
+    * - missingParams: Empty (spool parameters have default values)
+    * - invalidParams: Contains errors for negative sizes or delays
+    * @details Checks:
+    * - Spool max bytes and retry delay are not negative
+    */
+    ValidateResult Config::validateSpool() const
+    {
+        ValidateResult result;
+
+        if(spoolMaxBytes && * spoolMaxBytes < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_SPOOL_MAX_BYTES),
+                              "Spool max bytes cannot be negative (" + std::to_string( * spoolMaxBytes) + ")");
+        }
+        if(spoolRetryMs && * spoolRetryMs < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_SPOOL_RETRY_MS),
+                              "Spool retry delay cannot be negative (" + std::to_string( * spoolRetryMs) + ")");
+        }
+        return result;
+    }
+
+    /**
+    * @brief Validates sampling, rate limit and duplicate suppression configuration
+    * @return ValidateResult Contains:
+    * - success: true if the throttling configuration is valid
+    * - missingParams: Empty (throttling parameters have default values)
+    * - invalidParams: Contains errors for out of range values
+    * @details Checks:
+    * - Sample rate is within 0 - 1
+    * - Rate limits and dedup window are not negative
+    */
+    ValidateResult Config::validateThrottle() const
+    {
+        ValidateResult result;
+
+        if(sampleRate && ( * sampleRate < 0.0 || * sampleRate > 1.0))
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_SAMPLE_RATE),
+                              "Sample rate must be within 0 - 1 (" + std::to_string( * sampleRate) + ")");
+        }
+        if(rateLimitPerSite && * rateLimitPerSite < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_RATE_LIMIT_PER_SITE),
+                              "Rate limit cannot be negative (" + std::to_string( * rateLimitPerSite) + ")");
+        }
+        if(rateLimitPerLevel && * rateLimitPerLevel < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_RATE_LIMIT_PER_LEVEL),
+                              "Rate limit cannot be negative (" + std::to_string( * rateLimitPerLevel) + ")");
+        }
+        if(dedupWindowMs && * dedupWindowMs < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_DEDUP_WINDOW_MS),
+                              "Dedup window cannot be negative (" + std::to_string( * dedupWindowMs) + ")");
+        }
+        return result;
+    }
+
+    /**
+    * @brief Validates sink configuration
+    * @return ValidateResult Contains:
+    * - success: true if the sink configuration is valid
+    * - missingParams: Empty (sink parameters have default values)
+    * - invalidParams: Contains errors for out of range values
+    * @details Checks:
+    * - Sink queue size is positive
+    * - File sink rotation size, age and segment count are not negative
+    */
+    ValidateResult Config::validateSinks() const
+    {
+        ValidateResult result;
+
+        if(sinkQueueSize && * sinkQueueSize <= 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_SINK_QUEUE_SIZE),
+                              "Sink queue size must be positive (" + std::to_string( * sinkQueueSize) + ")");
+        }
+        if(fileSinkMaxBytes && * fileSinkMaxBytes < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_FILE_SINK_MAX_BYTES),
+                              "File sink max bytes cannot be negative (" + std::to_string( * fileSinkMaxBytes) + ")");
+        }
+        if(fileSinkRotateSeconds && * fileSinkRotateSeconds < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_FILE_SINK_ROTATE_SECONDS),
+                              "File sink rotation age cannot be negative (" + std::to_string( * fileSinkRotateSeconds) + ")");
+        }
+        if(fileSinkMaxFiles && * fileSinkMaxFiles < 0)
+        {
+            result.addInvalid(tagLogger + std::string(LOG_INI_KEY_FILE_SINK_MAX_FILES),
+                              "File sink segment count cannot be negative (" + std::to_string( * fileSinkMaxFiles) + ")");
+        }
+        return result;
+    }
+
+    /**
+    * @brief Validates SQLite pragma configuration
+    * @return ValidateResult Contains:
+    * - success: true if SQLite configuration is valid
+    * - missingParams: Empty (SQLite parameters have default values)
+    * - invalidParams: Contains errors for unknown modes or out of range sizes
+    * @details Checks:
+    * - Journal mode is one of DELETE, TRUNCATE, PERSIST, MEMORY, WAL, OFF
+    * - Synchronous mode is one of OFF, NORMAL, FULL, EXTRA
+    * - Page size is a power of two within LOG_SQLITE_PAGE_SIZE_MIN - LOG_SQLITE_PAGE_SIZE_MAX
+    * - Memory map size is not negative
+    */
+    ValidateResult Config::validateSQLite() const
+    {
+        ValidateResult result;
+
+        static const std::vector<std::string> journalModes = { "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF" };
+        static const std::vector<std::string> synchronousModes = { "OFF", "NORMAL", "FULL", "EXTRA" };
+
+        if(sqliteJournalMode && std::find(journalModes.begin(), journalModes.end(),
+                                          LogHelper::toUpperCase( * sqliteJournalMode)) == journalModes.end())
+        {
+            result.addInvalid(tagSQLite + std::string(LOG_INI_KEY_SQLITE_JOURNAL_MODE), "Unknown journal mode: " + * sqliteJournalMode);
+        }
+
+        if(sqliteSynchronous && std::find(synchronousModes.begin(), synchronousModes.end(),
+                                          LogHelper::toUpperCase( * sqliteSynchronous)) == synchronousModes.end())
+        {
+            result.addInvalid(tagSQLite + std::string(LOG_INI_KEY_SQLITE_SYNCHRONOUS), "Unknown synchronous mode: " + * sqliteSynchronous);
+        }
+
+        if(sqlitePageSize && ( * sqlitePageSize < LOG_SQLITE_PAGE_SIZE_MIN || * sqlitePageSize > LOG_SQLITE_PAGE_SIZE_MAX
+                               || ( * sqlitePageSize & ( * sqlitePageSize - 1)) != 0))
+        {
+            std::ostringstream detail;
+            detail << "Page size must be a power of two between "
+                   << LOG_SQLITE_PAGE_SIZE_MIN << " and " << LOG_SQLITE_PAGE_SIZE_MAX
+                   << " (" << * sqlitePageSize << ")";
+            result.addInvalid(tagSQLite + std::string(LOG_INI_KEY_SQLITE_PAGE_SIZE), detail.str());
+        }
+
+        if(sqliteMmapSize && * sqliteMmapSize < 0)
+        {
+            result.addInvalid(tagSQLite + std::string(LOG_INI_KEY_SQLITE_MMAP_SIZE), "Memory map size can't be negative");
+        }
+
+        return result;
+    }
+
 #ifdef SQLG_USE_SOURCE_INFO
     /**
     * @brief Validates source UUID configuration (if enabled)
@@ -820,5 +2110,329 @@ namespace LogConfig
         return result;
     };
 #endif
-};
 
+    /**
+    * @brief Converts BackPressure to its string representation
+    * @param policy Back-pressure policy
+    * @return std::string Policy name (LOG_BACK_PRESSURE_STR_*)
+    */
+    std::string backPressureToString(const BackPressure policy)
+    {
+        switch(policy)
+        {
+            case BackPressure::DropNewest:
+                return LOG_BACK_PRESSURE_STR_DROP_NEWEST;
+            case BackPressure::DropBelowLevel:
+                return LOG_BACK_PRESSURE_STR_DROP_BELOW_LEVEL;
+            case BackPressure::Block:
+            default:
+                return LOG_BACK_PRESSURE_STR_BLOCK;
+        }
+    };
+
+    /**
+    * @brief Converts string to BackPressure
+    * @param policy Policy name (case insensitive)
+    * @return std::optional<BackPressure> Policy, or std::nullopt if unknown
+    */
+    std::optional<BackPressure> stringToBackPressure(const std::string& policy)
+    {
+        const std::string lower = LogHelper::toLowerCase(policy);
+
+        if(lower == LogHelper::toLowerCase(LOG_BACK_PRESSURE_STR_BLOCK)) return BackPressure::Block;
+        if(lower == LogHelper::toLowerCase(LOG_BACK_PRESSURE_STR_DROP_NEWEST)) return BackPressure::DropNewest;
+        if(lower == LogHelper::toLowerCase(LOG_BACK_PRESSURE_STR_DROP_BELOW_LEVEL)) return BackPressure::DropBelowLevel;
+
+        return std::nullopt;
+    };
+
+    /**
+    * @brief Converts TimestampFormat to its string representation
+    * @param format Timestamp format
+    * @return std::string Format name (LOG_TIMESTAMP_FORMAT_STR_*)
+    */
+    std::string timestampFormatToString(const TimestampFormat format)
+    {
+        switch(format)
+        {
+            case TimestampFormat::EpochMicros:
+                return LOG_TIMESTAMP_FORMAT_STR_EPOCH_MICROS;
+            case TimestampFormat::Text:
+            default:
+                return LOG_TIMESTAMP_FORMAT_STR_TEXT;
+        }
+    };
+
+    /**
+    * @brief Converts string to TimestampFormat
+    * @param format Format name (case insensitive)
+    * @return std::optional<TimestampFormat> Format, or std::nullopt if unknown
+    */
+    std::optional<TimestampFormat> stringToTimestampFormat(const std::string& format)
+    {
+        const std::string lower = LogHelper::toLowerCase(format);
+
+        if(lower == LogHelper::toLowerCase(LOG_TIMESTAMP_FORMAT_STR_TEXT)) return TimestampFormat::Text;
+        if(lower == LogHelper::toLowerCase(LOG_TIMESTAMP_FORMAT_STR_EPOCH_MICROS)) return TimestampFormat::EpochMicros;
+
+        return std::nullopt;
+    };
+
+    /**
+    * @brief Converts SchemaLayout to its string representation
+    * @param layout Schema layout
+    * @return std::string Layout name (LOG_SCHEMA_LAYOUT_STR_*)
+    */
+    std::string schemaLayoutToString(const SchemaLayout layout)
+    {
+        switch(layout)
+        {
+            case SchemaLayout::Compact:
+                return LOG_SCHEMA_LAYOUT_STR_COMPACT;
+            case SchemaLayout::Standard:
+            default:
+                return LOG_SCHEMA_LAYOUT_STR_STANDARD;
+        }
+    };
+
+    /**
+    * @brief Converts string to SchemaLayout
+    * @param layout Layout name (case insensitive)
+    * @return std::optional<SchemaLayout> Layout, or std::nullopt if unknown
+    */
+    std::optional<SchemaLayout> stringToSchemaLayout(const std::string& layout)
+    {
+        const std::string lower = LogHelper::toLowerCase(layout);
+
+        if(lower == LogHelper::toLowerCase(LOG_SCHEMA_LAYOUT_STR_STANDARD)) return SchemaLayout::Standard;
+        if(lower == LogHelper::toLowerCase(LOG_SCHEMA_LAYOUT_STR_COMPACT)) return SchemaLayout::Compact;
+
+        return std::nullopt;
+    };
+
+    /**
+    * @brief Converts Partitioning to its string representation
+    * @param partitioning Partitioning mode
+    * @return std::string Mode name (LOG_PARTITIONING_STR_*)
+    */
+    std::string partitioningToString(const Partitioning partitioning)
+    {
+        switch(partitioning)
+        {
+            case Partitioning::Daily:
+                return LOG_PARTITIONING_STR_DAILY;
+            case Partitioning::None:
+            default:
+                return LOG_PARTITIONING_STR_NONE;
+        }
+    };
+
+    /**
+    * @brief Converts string to Partitioning
+    * @param partitioning Mode name (case insensitive)
+    * @return std::optional<Partitioning> Mode, or std::nullopt if unknown
+    */
+    std::optional<Partitioning> stringToPartitioning(const std::string& partitioning)
+    {
+        const std::string lower = LogHelper::toLowerCase(partitioning);
+
+        if(lower == LogHelper::toLowerCase(LOG_PARTITIONING_STR_NONE)) return Partitioning::None;
+        if(lower == LogHelper::toLowerCase(LOG_PARTITIONING_STR_DAILY)) return Partitioning::Daily;
+
+        return std::nullopt;
+    };
+
+    /**
+    * @brief Converts ShardRouting to its string representation
+    * @param routing Shard routing
+    * @return std::string Routing name (LOG_SHARD_ROUTING_STR_*)
+    */
+    std::string shardRoutingToString(const ShardRouting routing)
+    {
+        switch(routing)
+        {
+            case ShardRouting::RoundRobin:
+                return LOG_SHARD_ROUTING_STR_ROUND_ROBIN;
+            case ShardRouting::Source:
+            default:
+                return LOG_SHARD_ROUTING_STR_SOURCE;
+        }
+    };
+
+    /**
+    * @brief Converts string to ShardRouting
+    * @param routing Routing name (case insensitive)
+    * @return std::optional<ShardRouting> Routing, or std::nullopt if unknown
+    */
+    std::optional<ShardRouting> stringToShardRouting(const std::string& routing)
+    {
+        const std::string lower = LogHelper::toLowerCase(routing);
+
+        if(lower == LogHelper::toLowerCase(LOG_SHARD_ROUTING_STR_SOURCE)) return ShardRouting::Source;
+        if(lower == LogHelper::toLowerCase(LOG_SHARD_ROUTING_STR_ROUND_ROBIN)) return ShardRouting::RoundRobin;
+
+        return std::nullopt;
+    };
+
+    /**
+    * @brief Converts an index list to its string representation
+    * @param indexes Indexes
+    * @return std::string Indexes separated by INDEX_DELIMITER, columns by INDEX_COLUMN_DELIMITER
+    */
+    std::string indexesToString(const std::vector<LogIndex> & indexes)
+    {
+        std::vector<std::string> parts;
+        parts.reserve(indexes.size());
+        for(const auto & index : indexes)
+        {
+            parts.push_back(StringHelper::join(index, INDEX_COLUMN_DELIMITER));
+        }
+        return StringHelper::join(parts, INDEX_DELIMITER);
+    };
+
+    /**
+    * @brief Converts string to an index list
+    * @param indexes Indexes separated by INDEX_DELIMITER, columns by INDEX_COLUMN_DELIMITER (spaces ignored)
+    * @return std::optional<std::vector<LogIndex>> Indexes, or std::nullopt if a column is not an indexable log field
+    */
+    std::optional<std::vector<LogIndex>> stringToIndexes(const std::string& indexes)
+    {
+        // Column names end up in CREATE INDEX, only known fields are accepted
+        static const std::vector<std::string> indexableFields =
+        {
+            FIELD_LOG_TIMESTAMP,
+            FIELD_LOG_LEVEL,
+            FIELD_LOG_FUNCTION,
+            FIELD_LOG_FILE,
+            FIELD_LOG_LINE,
+            FIELD_LOG_THREAD_ID
+#ifdef SQLG_USE_SOURCE_INFO
+            , FIELD_LOG_SOURCES_ID
+#endif
+        };
+
+        std::string compact = indexes;
+        compact.erase(std::remove_if(compact.begin(), compact.end(), [](const unsigned char ch)
+        {
+            return std::isspace(ch);
+        }), compact.end());
+
+        std::vector<LogIndex> result;
+        if(compact.empty())
+        {
+            return result;
+        }
+
+        for(const auto & part : StringHelper::split(compact, INDEX_DELIMITER))
+        {
+            LogIndex index = StringHelper::split(part, INDEX_COLUMN_DELIMITER);
+            for(const auto & column : index)
+            {
+                if(std::find(indexableFields.begin(), indexableFields.end(), column) == indexableFields.end())
+                {
+                    return std::nullopt;
+                }
+            }
+            result.push_back(std::move(index));
+        }
+
+        return result;
+    };
+
+    /**
+    * @brief Converts WaitStrategy to its string representation
+    * @param strategy Wait strategy
+    * @return std::string Strategy name (LOG_WAIT_STRATEGY_STR_*)
+    */
+    std::string waitStrategyToString(const WaitStrategy strategy)
+    {
+        switch(strategy)
+        {
+            case WaitStrategy::Spin:
+                return LOG_WAIT_STRATEGY_STR_SPIN;
+            case WaitStrategy::Hybrid:
+                return LOG_WAIT_STRATEGY_STR_HYBRID;
+            case WaitStrategy::Block:
+            default:
+                return LOG_WAIT_STRATEGY_STR_BLOCK;
+        }
+    };
+
+    /**
+    * @brief Converts string to WaitStrategy
+    * @param strategy Strategy name (case insensitive)
+    * @return std::optional<WaitStrategy> Strategy, or std::nullopt if unknown
+    */
+    std::optional<WaitStrategy> stringToWaitStrategy(const std::string& strategy)
+    {
+        const std::string lower = LogHelper::toLowerCase(strategy);
+
+        if(lower == LogHelper::toLowerCase(LOG_WAIT_STRATEGY_STR_BLOCK)) return WaitStrategy::Block;
+        if(lower == LogHelper::toLowerCase(LOG_WAIT_STRATEGY_STR_SPIN)) return WaitStrategy::Spin;
+        if(lower == LogHelper::toLowerCase(LOG_WAIT_STRATEGY_STR_HYBRID)) return WaitStrategy::Hybrid;
+
+        return std::nullopt;
+    };
+
+    /**
+    * @brief Converts a CPU list to its string representation
+    * @param cpus CPU indexes
+    * @return std::string CPUs separated by LOG_CPU_LIST_DELIMITER
+    */
+    std::string cpuListToString(const std::vector<int> & cpus)
+    {
+        std::vector<std::string> parts;
+        parts.reserve(cpus.size());
+        for(const int cpu : cpus)
+        {
+            parts.push_back(std::to_string(cpu));
+        }
+        return StringHelper::join(parts, LOG_CPU_LIST_DELIMITER);
+    };
+
+    /**
+    * @brief Converts string to a CPU list
+    * @param cpus CPUs and ranges separated by LOG_CPU_LIST_DELIMITER ("0,2,4-7", spaces ignored)
+    * @return std::optional<std::vector<int>> CPU indexes, or std::nullopt if an item is not a CPU or range
+    */
+    std::optional<std::vector<int>> stringToCpuList(const std::string& cpus)
+    {
+        std::string compact = cpus;
+        compact.erase(std::remove_if(compact.begin(), compact.end(), [](const unsigned char ch)
+        {
+            return std::isspace(ch);
+        }), compact.end());
+
+        std::vector<int> result;
+        if(compact.empty())
+        {
+            return result;
+        }
+
+        for(const auto & part : StringHelper::split(compact, LOG_CPU_LIST_DELIMITER))
+        {
+            const std::vector<std::string> range = StringHelper::split(part, LOG_CPU_RANGE_DELIMITER);
+            if(range.empty() || range.size() > 2
+                    || !std::all_of(range.begin(), range.end(), [](const std::string & cpu)
+        {
+            return !cpu.empty() && LogHelper::isNumeric(cpu);
+            }))
+            {
+                return std::nullopt;
+            }
+
+            const int first = std::stoi(range.front());
+            const int last = std::stoi(range.back());
+            if(last < first || last > LOG_CPU_INDEX_MAX)
+            {
+                return std::nullopt;
+            }
+            for(int cpu = first; cpu <= last; ++cpu)
+            {
+                result.push_back(cpu);
+            }
+        }
+
+        return result;
+    };
+};
@@ -18,6 +18,11 @@
  */
 
 #include "sqlogger/log_helper.h"
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <ctime>
+#include <sstream>
 
 /**
 * @brief Joins a vector of strings into a single string with a delimiter
@@ -63,6 +68,23 @@ std::vector<std::string> StringHelper::split(const std::string& str, const std::
     return result;
 }
 
+/**
+* @brief Splits a string into words separated by whitespace
+* @param str The string to split
+* @return std::vector<std::string> The words (empty parts are skipped)
+*/
+std::vector<std::string> StringHelper::splitWords(const std::string& str)
+{
+    std::vector<std::string> words;
+    std::istringstream stream(str);
+    std::string word;
+    while(stream >> word)
+    {
+        words.push_back(word);
+    }
+    return words;
+}
+
 #ifdef SQLG_USE_SOURCE_INFO
 /**
  * @brief Generates a UUID.
@@ -220,8 +242,10 @@ LogLevel LogHelper::intToLevel(const int levelInt)
 std::string LogHelper::formatTime(const std::chrono::system_clock::time_point& tp, const char* timeFormat)
 {
     auto in_time_t = std::chrono::system_clock::to_time_t(tp);
+    std::tm tm = {};
+    toLocalTime(in_time_t, tm);
     std::stringstream ss;
-    ss << std::put_time(std::localtime( & in_time_t), TIMESTAMP_FMT);
+    ss << std::put_time( & tm, TIMESTAMP_FMT);
     return ss.str();
 }
 
@@ -249,6 +273,113 @@ std::chrono::system_clock::time_point LogHelper::parseTime(const std::string& ti
     return std::chrono::system_clock::from_time_t(std::mktime( & tm));
 }
 
+/**
+* @brief Converts a time_point to microseconds since the epoch
+* @param tp The time_point to convert
+* @return int64_t Microseconds since the Unix epoch
+*/
+int64_t LogHelper::toEpochMicros(const std::chrono::system_clock::time_point& tp)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+/**
+* @brief Converts a time to local calendar time (thread-safe, unlike std::localtime)
+* @param time Seconds since the Unix epoch
+* @param tm Receives the local calendar time
+* @return bool False if the time can't be converted
+* @note Uses localtime_s on Windows and localtime_r elsewhere
+*/
+bool LogHelper::toLocalTime(const std::time_t time, std::tm& tm)
+{
+#if defined(_WIN32)
+    return localtime_s( & tm, & time) == 0;
+#else
+    return localtime_r( & time, & tm) != nullptr;
+#endif
+}
+
+/**
+* @brief Formats microseconds since the epoch as local time with a microsecond fraction
+* @param micros Microseconds since the Unix epoch
+* @return std::string TIMESTAMP_FMT text followed by ".ffffff"
+* @note Uses the system's local time zone for conversion
+*/
+std::string LogHelper::formatEpochMicros(const int64_t micros)
+{
+    // Floor division keeps the fraction positive before 1970
+    int64_t seconds = micros / 1000000;
+    int64_t fraction = micros % 1000000;
+    if(fraction < 0)
+    {
+        fraction += 1000000;
+        --seconds;
+    }
+
+    const std::time_t time = static_cast<std::time_t>(seconds);
+    std::tm tm = {};
+    if(!toLocalTime(time, tm))
+    {
+        return std::to_string(micros);
+    }
+
+    char buffer[48];
+    const size_t length = std::strftime(buffer, sizeof(buffer), TIMESTAMP_FMT, & tm);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%06lld", static_cast<long long>(fraction));
+    return buffer;
+}
+
+/**
+* @brief Parses a timestamp into microseconds since the epoch
+* @param timestamp Either an integer (already in microseconds) or TIMESTAMP_FMT text
+*        with an optional ".ffffff" fraction (local time)
+* @return std::optional<int64_t> Microseconds, or std::nullopt if the text can't be parsed
+* @see formatEpochMicros() for inverse operation
+*/
+std::optional<int64_t> LogHelper::parseEpochMicros(const std::string& timestamp)
+{
+    int64_t micros = 0;
+    const char* begin = timestamp.data();
+    const char* end = begin + timestamp.size();
+    auto [ptr, ec] = std::from_chars(begin, end, micros);
+    if(ec == std::errc() && ptr == end)
+    {
+        return micros;
+    }
+
+    std::tm tm = {};
+    std::istringstream ss(timestamp);
+    ss >> std::get_time( & tm, TIMESTAMP_FMT);
+    if(ss.fail())
+    {
+        return std::nullopt;
+    }
+    tm.tm_isdst = -1;
+
+    int64_t fraction = 0;
+    if(ss.peek() == '.')
+    {
+        ss.get();
+        int digits = 0;
+        while(std::isdigit(ss.peek()) && digits < 6)
+        {
+            fraction = fraction * 10 + (ss.get() - '0');
+            ++digits;
+        }
+        for(; digits < 6; ++digits)
+        {
+            fraction *= 10;
+        }
+    }
+
+    const std::time_t time = std::mktime( & tm);
+    if(time == static_cast<std::time_t>(-1))
+    {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(time) * 1000000 + fraction;
+}
+
 /**
  * @brief Gets the current timestamp as a string.
  * @param timeFormat The format of the timestamp.
@@ -257,7 +388,8 @@ std::chrono::system_clock::time_point LogHelper::parseTime(const std::string& ti
 std::string LogHelper::getCurrentTimestamp(const char* timeFormat)
 {
     auto now = std::time(nullptr);
-    auto tm = * std::localtime( & now);
+    std::tm tm = {};
+    toLocalTime(now, tm);
     std::ostringstream oss;
     oss << std::put_time( & tm, timeFormat);
     return oss.str();
@@ -274,3 +406,13 @@ std::string LogHelper::threadIdToString(std::thread::id id)
     oss << id;
     return oss.str();
 }
+
+/**
+ * @brief Gets the calling thread's ID as a string.
+ * @return const std::string& Thread ID, converted once per thread and cached.
+ */
+const std::string& LogHelper::currentThreadId()
+{
+    thread_local const std::string threadId = threadIdToString(std::this_thread::get_id());
+    return threadId;
+}
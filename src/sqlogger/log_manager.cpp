@@ -45,25 +45,32 @@ SQLogger& LogManager::createLogger(const std::string& name,
 {
     std::lock_guard<std::mutex> lock(mutex);
 
-    if(loggers.count(name))
+    const auto current = std::atomic_load( & loggers);
+    if(current->count(name))
     {
         throw std::runtime_error(ERR_MSG_LOGGER_EXISTS + name);
     }
 
-    if(!config.databaseType)
+    const bool shared = config.shareConnection.value_or(false);
+    LogConfig::Config loggerConfig = config;
+    if(shared)
     {
-        throw std::runtime_error(ERR_MSG_DB_TYPE_NOT_SPECIFIED);
+        // Transactions of a shared connection must end on the thread that began them
+        loggerConfig.groupCommitBatches = 0;
     }
 
-    std::string connectionString = LogConfig::configToConnectionString(config);
-    auto db = DatabaseFactory::create( * config.databaseType, connectionString);
+    auto db = shared ? createSharedDatabase(config) : createDatabase(config);
 
-    loggers[name] = std::unique_ptr<SQLogger>(new SQLogger(std::move(db), config
+    auto logger = std::shared_ptr<SQLogger>(new SQLogger(std::move(db), loggerConfig
 #ifdef SQLG_USE_SOURCE_INFO
-                    , std::move(sourceInfo)
+                                            , std::move(sourceInfo)
 #endif
-                                                          ));
-    return *loggers[name];
+                                                        ));
+
+    auto updated = std::make_shared<LoggerMap>( * current);
+    updated->emplace(name, logger);
+    std::atomic_store( & loggers, std::shared_ptr<const LoggerMap>(std::move(updated)));
+    return * logger;
 }
 
 /**
@@ -74,15 +81,15 @@ SQLogger& LogManager::createLogger(const std::string& name,
  */
 SQLogger& LogManager::getLogger(const std::string& name)
 {
-    std::lock_guard<std::mutex> lock(mutex);
+    const auto snapshot = std::atomic_load( & loggers);
 
-    auto it = loggers.find(name);
-    if(it == loggers.end())
+    auto it = snapshot->find(name);
+    if(it == snapshot->end())
     {
         std::string errorMsg = ERR_MSG_LOGGER_NAME_NOT_FOUND + name + " " + ERR_MSG_AVAILABLE_LOGGERS;
 
         std::vector<std::string> availableLoggers;
-        for(const auto & pair : loggers)
+        for(const auto & pair : * snapshot)
         {
             availableLoggers.push_back(pair.first);
         }
@@ -102,6 +109,19 @@ SQLogger& LogManager::getLogger(const std::string& name)
     return *(it->second);
 }
 
+/**
+ * @brief Gets a handle of an existing logger by name, without throwing
+ * The handle keeps the logger object alive after removeLogger() (it is shut down then)
+ * @param name Logger name to retrieve
+ * @return std::shared_ptr<SQLogger> The logger, or nullptr if not found
+ */
+std::shared_ptr<SQLogger> LogManager::findLogger(const std::string& name) const
+{
+    const auto snapshot = std::atomic_load( & loggers);
+    auto it = snapshot->find(name);
+    return it != snapshot->end() ? it->second : nullptr;
+}
+
 /**
  * @brief Removes a logger by name
  * @param name Logger name to remove
@@ -110,11 +130,13 @@ SQLogger& LogManager::getLogger(const std::string& name)
 void LogManager::removeLogger(const std::string& name)
 {
     std::lock_guard<std::mutex> lock(mutex);
-    auto it = loggers.find(name);
-    if(it != loggers.end())
+    auto updated = std::make_shared<LoggerMap>( * std::atomic_load( & loggers));
+    auto it = updated->find(name);
+    if(it != updated->end())
     {
         it->second->shutdown();
-        loggers.erase(it);
+        updated->erase(it);
+        std::atomic_store( & loggers, std::shared_ptr<const LoggerMap>(std::move(updated)));
     }
     else
     {
@@ -136,12 +158,13 @@ void LogManager::removeLogger(const std::string& name)
 int LogManager::removeAllLoggers()
 {
     std::lock_guard<std::mutex> lock(mutex);
-    const int count = loggers.size();
-    for(auto & [name, logger] : loggers)
+    const auto current = std::atomic_load( & loggers);
+    const int count = current->size();
+    for(auto & [name, logger] : * current)
     {
         logger->shutdown();
     }
-    loggers.clear();
+    std::atomic_store( & loggers, std::make_shared<const LoggerMap>());
     return count;
 }
 
@@ -155,7 +178,7 @@ int LogManager::removeAllLoggers()
  */
 int LogManager::getCount() const
 {
-    return loggers.size();
+    return std::atomic_load( & loggers)->size();
 }
 
 /**
@@ -165,8 +188,8 @@ int LogManager::getCount() const
  */
 std::optional<LogConfig::Config> LogManager::getLoggerConfig(const std::string& name)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    if(auto it = loggers.find(name); it != loggers.end())
+    const auto snapshot = std::atomic_load( & loggers);
+    if(auto it = snapshot->find(name); it != snapshot->end())
     {
         return it->second->getConfig();
     }
@@ -179,15 +202,33 @@ std::optional<LogConfig::Config> LogManager::getLoggerConfig(const std::string&
  */
 std::map<std::string, LogConfig::Config> LogManager::getAllLoggersConfigs()
 {
-    std::lock_guard<std::mutex> lock(mutex);
+    const auto snapshot = std::atomic_load( & loggers);
     std::map<std::string, LogConfig::Config> result;
-    for(const auto & [name, logger] : loggers)
+    for(const auto & [name, logger] : * snapshot)
     {
         result.emplace(name, logger->getConfig());
     }
     return result;
 }
 
+/**
+ * @brief Gets the number of open connections shared by loggers
+ * @return int Connections used by loggers created with LogConfig::Config::shareConnection
+ */
+int LogManager::getSharedConnectionCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    int count = 0;
+    for(const auto & [key, connection] : connections)
+    {
+        if(!connection.expired())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
 /**
  * @brief Creates a database instance based on configuration
  * @param config Configuration object containing database parameters. Must have:
@@ -209,6 +250,44 @@ std::unique_ptr<IDatabase> LogManager::createDatabase(const LogConfig::Config& c
         throw std::runtime_error(ERR_MSG_DB_TYPE_NOT_SPECIFIED);
     }
 
+    if(config.shards.has_value() && !config.shards->empty())
+    {
+        return std::make_unique<ShardedDatabase>(config);
+    }
+
     std::string connStr = LogConfig::configToConnectionString(config);
-    return DatabaseFactory::create( * config.databaseType, connStr);
+    return DatabaseFactory::create( * config.databaseType, connStr, LogConfig::configToSQLitePragmas(config));
+}
+
+/**
+ * @brief Gets a user of the shared connection for a configuration, opening it on first use
+ * The caller holds the manager mutex.
+ * @param config Configuration object containing database parameters
+ * @return std::unique_ptr<IDatabase> Database forwarding to the shared connection
+ * @see createDatabase()
+ */
+std::unique_ptr<IDatabase> LogManager::createSharedDatabase(const LogConfig::Config& config)
+{
+    if(!config.databaseType)
+    {
+        throw std::runtime_error(ERR_MSG_DB_TYPE_NOT_SPECIFIED);
+    }
+
+    // The connection keeps the SQLite pragmas of the logger that opened it
+    const std::string key = DataBaseHelper::databaseTypeToString( * config.databaseType)
+                            + "|" + LogConfig::configToConnectionString(config);
+
+    auto connection = connections[key].lock();
+    if(!connection)
+    {
+        connection = std::make_shared<SharedConnection>(createDatabase(config));
+        connections[key] = connection;
+    }
+
+    for(auto it = connections.begin(); it != connections.end();)
+    {
+        it = it->second.expired() ? connections.erase(it) : std::next(it);
+    }
+
+    return std::make_unique<SharedDatabase>(connection);
 }
@@ -0,0 +1,449 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "sqlogger/log_metrics.h"
+
+// Upper bounds of the latency histogram buckets in microseconds ("le" labels in seconds)
+static const uint64_t LATENCY_BOUNDS_US[] =
+{
+    1, 2, 5, 10, 25, 50, 100, 250, 500,
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000
+};
+
+/**
+ * @brief Escapes a label value (backslash, double quote and line feed).
+ * @param value Label value.
+ * @return std::string Escaped value.
+ */
+static std::string escapeLabel(const std::string& value)
+{
+    std::string result;
+    result.reserve(value.size());
+    for(const char c : value)
+    {
+        switch(c)
+        {
+            case '\\':
+                result += "\\\\";
+                break;
+            case '"':
+                result += "\\\"";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                result += c;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Formats a number of microseconds as seconds.
+ * @param valueUs Value in microseconds.
+ * @return std::string Seconds without trailing zeros.
+ */
+static std::string microsToSeconds(const uint64_t valueUs)
+{
+    std::ostringstream stream;
+    stream << valueUs / 1000000;
+    const uint64_t fraction = valueUs % 1000000;
+    if(fraction != 0)
+    {
+        std::ostringstream digits;
+        digits << std::setw(6) << std::setfill('0') << fraction;
+        std::string text = digits.str();
+        text.erase(text.find_last_not_of('0') + 1);
+        stream << '.' << text;
+    }
+    return stream.str();
+}
+
+/**
+ * @brief Writes the HELP and TYPE lines of a metric family.
+ * @param out Output stream.
+ * @param name Metric name without prefix (counters include the "_total" suffix).
+ * @param type Metric type (counter, gauge or histogram).
+ * @param help Help text.
+ * @param format Exposition format (OpenMetrics names a counter family without "_total").
+ */
+static void writeFamily(std::ostringstream& out, const std::string& name, const char* type, const char* help,
+                        const LogMetrics::Format format)
+{
+    std::string family = METRICS_PREFIX + name;
+    const std::string suffix = "_total";
+    if(format == LogMetrics::Format::OpenMetrics && std::string(type) == "counter"
+            && family.size() > suffix.size() && family.compare(family.size() - suffix.size(), suffix.size(), suffix) == 0)
+    {
+        family.resize(family.size() - suffix.size());
+    }
+    out << "# HELP " << family << " " << help << "\n"
+        << "# TYPE " << family << " " << type << "\n";
+}
+
+/**
+ * @brief Writes one sample line for every logger.
+ * @param out Output stream.
+ * @param samples Logger samples.
+ * @param labels Label set of each sample.
+ * @param name Metric name without prefix.
+ * @param value Gets the value of a sample.
+ */
+template<typename Value>
+static void writeValues(std::ostringstream& out, const std::vector<LogMetrics::Sample> & samples,
+                        const std::vector<std::string> & labels, const std::string& name, Value value)
+{
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+        out << METRICS_PREFIX << name << "{" << labels[i] << "} " << value(samples[i].stats) << "\n";
+    }
+}
+
+/**
+ * @brief Constructs a stopped publisher.
+ * @param interval Publish interval.
+ */
+LogMetrics::LogMetrics(const std::chrono::milliseconds& interval)
+    : interval(interval)
+{
+}
+
+/**
+ * @brief Destructor. Stops the publish thread.
+ */
+LogMetrics::~LogMetrics()
+{
+    stop();
+}
+
+/**
+ * @brief Collects the statistics of every logger registered in LogManager.
+ * @return std::vector<Sample> One sample per logger, ordered by logger name.
+ */
+std::vector<LogMetrics::Sample> LogMetrics::collect()
+{
+    std::vector<Sample> samples;
+    LogManager::getInstance().forEach([ & samples](const std::string & name, SQLogger & logger)
+    {
+        const LogConfig::Config config = logger.getConfig();
+
+        Sample sample;
+        sample.logger = name;
+        sample.databaseType = config.databaseType.has_value()
+                              ? DataBaseHelper::databaseTypeToString(config.databaseType.value())
+                              : std::string();
+#ifdef SQLG_USE_SOURCE_INFO
+        sample.source = config.sourceName.value_or(config.sourceUuid.value_or(""));
+#endif
+        sample.stats = logger.getStats();
+        samples.push_back(std::move(sample));
+    });
+
+    std::sort(samples.begin(), samples.end(), [](const Sample & a, const Sample & b)
+    {
+        return a.logger < b.logger;
+    });
+    return samples;
+}
+
+/**
+ * @brief Renders samples as metrics text.
+ * @param samples Samples to render.
+ * @param format Exposition format.
+ * @return std::string Metrics text.
+ */
+std::string LogMetrics::format(const std::vector<Sample> & samples, const Format format)
+{
+    std::vector<std::string> labels;
+    labels.reserve(samples.size());
+    for(const auto & sample : samples)
+    {
+        labels.push_back(std::string(METRICS_LABEL_LOGGER) + "=\"" + escapeLabel(sample.logger) + "\","
+                         + METRICS_LABEL_DB_TYPE + "=\"" + escapeLabel(sample.databaseType) + "\","
+                         + METRICS_LABEL_SOURCE + "=\"" + escapeLabel(sample.source) + "\"");
+    }
+
+    std::ostringstream out;
+    if(!samples.empty())
+    {
+        const struct
+        {
+            const char* name;
+            const char* help;
+            uint64_t SQLogger::Stats::* field;
+        } counters[] =
+        {
+            { "entries_logged_total", "Entries processed by the writers.", & SQLogger::Stats::totalLogged },
+            { "entries_failed_total", "Entries that could not be written or spooled.", & SQLogger::Stats::totalFailed },
+            { "entries_dropped_total", "Entries dropped by the back-pressure policy.", & SQLogger::Stats::totalDropped },
+            { "entries_spooled_total", "Entries written to the local spool.", & SQLogger::Stats::totalSpooled },
+            { "entries_replayed_total", "Entries replayed from the local spool.", & SQLogger::Stats::totalReplayed },
+            { "entries_sampled_total", "Entries dropped by sampling.", & SQLogger::Stats::totalSampled },
+            { "entries_rate_limited_total", "Entries dropped by a rate limit.", & SQLogger::Stats::totalRateLimited },
+            { "entries_repeated_total", "Identical entries folded into a repeat count.", & SQLogger::Stats::totalRepeated },
+            { "sink_written_total", "Entries written by the additional sinks.", & SQLogger::Stats::totalSinkWritten },
+            { "sink_dropped_total", "Entries an additional sink missed (full queue or failed write).", & SQLogger::Stats::totalSinkDropped },
+            { "tail_cache_hits_total", "Queries answered by the tail cache.", & SQLogger::Stats::tailCacheHits },
+            { "tail_cache_misses_total", "Queries the tail cache passed to the database.", & SQLogger::Stats::tailCacheMisses }
+        };
+        for(const auto & counter : counters)
+        {
+            writeFamily(out, counter.name, "counter", counter.help, format);
+            writeValues(out, samples, labels, counter.name, [ & counter](const SQLogger::Stats & stats)
+            {
+                return stats.*counter.field;
+            });
+        }
+
+        writeFamily(out, "flushes_total", "counter", "Batches written.", format);
+        writeValues(out, samples, labels, "flushes_total", [](const SQLogger::Stats & stats)
+        {
+            return stats.flushCount;
+        });
+
+        writeFamily(out, "process_seconds_total", "counter", "Time spent processing entries.", format);
+        writeValues(out, samples, labels, "process_seconds_total", [](const SQLogger::Stats & stats)
+        {
+            return microsToSeconds(stats.totalProcessTimeUs);
+        });
+
+        writeFamily(out, "queue_depth", "gauge", "Entries handed over by log calls and not yet taken by a writer.", format);
+        writeValues(out, samples, labels, "queue_depth", [](const SQLogger::Stats & stats)
+        {
+            return stats.queueDepth;
+        });
+
+        writeFamily(out, "queue_depth_max", "gauge", "Largest queue depth since the last statistics reset.", format);
+        writeValues(out, samples, labels, "queue_depth_max", [](const SQLogger::Stats & stats)
+        {
+            return stats.maxQueueDepth;
+        });
+
+        writeFamily(out, "batch_size_max", "gauge", "Largest batch since the last statistics reset.", format);
+        writeValues(out, samples, labels, "batch_size_max", [](const SQLogger::Stats & stats)
+        {
+            return stats.maxBatchSize;
+        });
+
+        const struct
+        {
+            const char* name;
+            const char* help;
+            LatencyHistogram::Snapshot SQLogger::Stats::* field;
+        } histograms[] =
+        {
+            { "enqueue_latency_seconds", "Time a log call spends handing its entry over.", & SQLogger::Stats::enqueueLatency },
+            { "queue_wait_seconds", "Time from the hand-over until a writer takes the entry.", & SQLogger::Stats::queueWait },
+            { "db_execute_seconds", "Time of one database write.", & SQLogger::Stats::dbExecute },
+            { "end_to_end_seconds", "Time from the log call until the entry is written.", & SQLogger::Stats::endToEnd }
+        };
+        for(const auto & histogram : histograms)
+        {
+            writeFamily(out, histogram.name, "histogram", histogram.help, format);
+            const std::string name = METRICS_PREFIX + std::string(histogram.name);
+            for(size_t i = 0; i < samples.size(); ++i)
+            {
+                const LatencyHistogram::Snapshot& snapshot = samples[i].stats.*histogram.field;
+                for(const uint64_t bound : LATENCY_BOUNDS_US)
+                {
+                    out << name << "_bucket{" << labels[i] << ",le=\"" << microsToSeconds(bound) << "\"} "
+                        << snapshot.countAtOrBelow(bound) << "\n";
+                }
+                out << name << "_bucket{" << labels[i] << ",le=\"+Inf\"} " << snapshot.count << "\n"
+                    << name << "_sum{" << labels[i] << "} " << microsToSeconds(snapshot.sumUs) << "\n"
+                    << name << "_count{" << labels[i] << "} " << snapshot.count << "\n";
+            }
+        }
+    }
+
+    if(format == Format::OpenMetrics)
+    {
+        out << "# EOF\n";
+    }
+    return out.str();
+}
+
+/**
+ * @brief Collects and renders the statistics of every registered logger (the body of a /metrics response).
+ * @param format Exposition format.
+ * @return std::string Metrics text.
+ */
+std::string LogMetrics::scrape(const Format format)
+{
+    return LogMetrics::format(collect(), format);
+}
+
+/**
+ * @brief Gets the HTTP Content-Type of a format.
+ * @param format Exposition format.
+ * @return const char* Content type.
+ */
+const char* LogMetrics::contentType(const Format format)
+{
+    return format == Format::OpenMetrics
+           ? "application/openmetrics-text; version=1.0.0; charset=utf-8"
+           : "text/plain; version=0.0.4; charset=utf-8";
+}
+
+/**
+ * @brief Writes the metrics to a file every round (replaced atomically, so readers never see a partial file).
+ * @param path File path (empty disables the file).
+ * @param format Exposition format (OpenMetrics is not read by the node_exporter textfile collector).
+ */
+void LogMetrics::setTextFile(const std::string& path, const Format format)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    textFile = path;
+    textFileFormat = format;
+}
+
+/**
+ * @brief Calls a handler with the metrics every round.
+ * @param handler Handler (empty disables it).
+ * @param format Exposition format.
+ */
+void LogMetrics::setHandler(Handler handler, const Format format)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->handler = std::move(handler);
+    handlerFormat = format;
+}
+
+/**
+ * @brief Pushes the Stats of every logger through a transport every round.
+ * @param transport Transport client (nullptr disables pushing); must outlive the publisher.
+ */
+void LogMetrics::setTransport(ITransport* transport)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->transport = transport;
+}
+
+/**
+ * @brief Starts the publish thread (the first round runs after one interval).
+ */
+void LogMetrics::start()
+{
+    if(publisher.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = false;
+    }
+    publisher = std::thread( & LogMetrics::publishLoop, this);
+}
+
+/**
+ * @brief Stops the publish thread.
+ */
+void LogMetrics::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+
+    if(publisher.joinable())
+    {
+        publisher.join();
+    }
+}
+
+/**
+ * @brief Publishes one round now.
+ * @return bool False if the text file could not be written.
+ */
+bool LogMetrics::publish()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const std::vector<Sample> samples = collect();
+    bool written = true;
+
+    if(!textFile.empty())
+    {
+        // Written beside the target and renamed over it
+        const std::string tempFile = textFile + ".tmp";
+        {
+            std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+            file << format(samples, textFileFormat);
+            written = static_cast<bool>(file);
+        }
+
+        std::error_code error;
+        if(written)
+        {
+            std::filesystem::rename(tempFile, textFile, error);
+            written = !error;
+        }
+        if(!written)
+        {
+            std::filesystem::remove(tempFile, error);
+        }
+    }
+
+    if(handler)
+    {
+        handler(format(samples, handlerFormat));
+    }
+
+    if(transport)
+    {
+        for(const auto & sample : samples)
+        {
+            transport->pushStats(sample.stats);
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Publish thread body.
+ */
+void LogMetrics::publishLoop()
+{
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while(true)
+    {
+        stopCondition.wait_for(lock, interval, [this]
+        {
+            return stopping;
+        });
+        if(stopping)
+        {
+            break;
+        }
+
+        lock.unlock();
+        publish();
+        lock.lock();
+    }
+}
@@ -0,0 +1,214 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include "sqlogger/log_sink.h"
+#include "sqlogger/internal/fs_helper.h"
+
+/**
+ * @brief Opens (or creates) the current segment and its directory.
+ * An existing non-empty segment is appended to, except for XML and JSON, whose closed
+ * document is rotated first.
+ * @param path Path of the current segment.
+ * @param format Output format.
+ * @param maxBytes Rotation size in bytes (0 = no size limit).
+ * @param rotateInterval Rotation age of a segment (0 = no age limit).
+ * @param maxFiles Number of rotated segments kept (0 = rotated segments are deleted).
+ * @throws std::runtime_error If the file or its directory cannot be created.
+ */
+LogFileSink::LogFileSink(const std::string& path,
+                         const LogExport::Format& format,
+                         const uint64_t maxBytes,
+                         const std::chrono::seconds& rotateInterval,
+                         const int maxFiles)
+    : path(path),
+      format(format),
+      maxBytes(maxBytes),
+      rotateInterval(rotateInterval),
+      maxFiles(std::max(maxFiles, 0)),
+      buffer(LOG_EXPORT_BUFFER_SIZE)
+{
+    std::string errMsg;
+    if(!FSHelper::createDir(path, errMsg))
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_CREATE_DIR + errMsg);
+    }
+
+    std::error_code error;
+    const auto size = std::filesystem::file_size(path, error);
+    if(!error && size > 0 && !LogExport::formatHeader(format).empty())
+    {
+        // The footer closed the document, entries can't be appended after it
+        FSHelper::rotateSegments(path, this->maxFiles, errMsg);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!open())
+    {
+        throw std::runtime_error(ERR_MSG_FAILED_OPEN_FILE + path);
+    }
+}
+
+/**
+ * @brief Writes the buffered entries and the format footer.
+ */
+LogFileSink::~LogFileSink()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    close();
+}
+
+/**
+ * @brief Appends entries to the current segment, rotating it first when it is full or too old.
+ * @param entries The log entries.
+ * @return bool True if the entries were handed to the stream buffer.
+ */
+bool LogFileSink::write(const LogEntryList& entries)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Chunks bound how far a segment can grow past maxBytes
+    for(size_t offset = 0; offset < entries.size(); offset += LOG_EXPORT_CHUNK_SIZE)
+    {
+        if(needRotation() && !rotate())
+        {
+            return false;
+        }
+        if(!file.is_open() && !open())
+        {
+            return false;
+        }
+
+        const size_t count = std::min<size_t>(LOG_EXPORT_CHUNK_SIZE, entries.size() - offset);
+        text.clear();
+        LogExport::formatEntries(text, format, entries.data() + offset, count, empty);
+        if(!writeText(text))
+        {
+            return false;
+        }
+        empty = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the stream buffer to the file.
+ */
+void LogFileSink::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(file.is_open())
+    {
+        file.flush();
+    }
+}
+
+/**
+ * @brief Gets the number of rotations since the sink was created.
+ * @return uint64_t Rotation count.
+ */
+uint64_t LogFileSink::getRotations() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return rotations;
+}
+
+/**
+ * @brief Opens the current segment for appending and writes the header to an empty one.
+ * @return bool True if the segment is open.
+ */
+bool LogFileSink::open()
+{
+    std::error_code error;
+    const auto size = std::filesystem::file_size(path, error);
+    fileBytes = error ? 0 : static_cast<uint64_t>(size);
+    empty = fileBytes == 0;
+    opened = std::chrono::steady_clock::now();
+
+    // The buffer must be set before the file is opened to take effect
+    file.clear();
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, std::ios::out | std::ios::app | std::ios::binary);
+    if(!file.is_open())
+    {
+        return false;
+    }
+
+    return !empty || writeText(LogExport::formatHeader(format));
+}
+
+/**
+ * @brief Writes the footer and closes the current segment.
+ */
+void LogFileSink::close()
+{
+    if(!file.is_open())
+    {
+        return;
+    }
+
+    writeText(LogExport::formatFooter(format, empty));
+    file.close();
+}
+
+/**
+ * @brief Closes the current segment, shifts the numbered segments and opens a new one.
+ * @return bool True if the new segment is open.
+ */
+bool LogFileSink::rotate()
+{
+    close();
+
+    // A segment that can't be moved away is appended to
+    std::string errMsg;
+    if(FSHelper::rotateSegments(path, maxFiles, errMsg))
+    {
+        ++rotations;
+    }
+    return open();
+}
+
+/**
+ * @brief Checks if the current segment must be rotated before more entries are appended.
+ * @return bool True if the segment holds entries and reached maxBytes or rotateInterval.
+ */
+bool LogFileSink::needRotation() const
+{
+    if(empty)
+    {
+        return false;
+    }
+
+    return (maxBytes > 0 && fileBytes >= maxBytes)
+           || (rotateInterval.count() > 0 && std::chrono::steady_clock::now() - opened >= rotateInterval);
+}
+
+/**
+ * @brief Writes text to the current segment.
+ * @param data Text to write.
+ * @return bool True if the stream accepted the text.
+ */
+bool LogFileSink::writeText(const std::string& data)
+{
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    fileBytes += data.size();
+    return file.good();
+}
@@ -33,8 +33,9 @@ SQLogger::SQLogger(std::unique_ptr<IDatabase> database, const LogConfig::Config&
       config(config),
       writer( * this->database, config.databaseTable.value_or(LOG_TABLE_NAME)),
       reader( * this->database, config.databaseTable.value_or(LOG_TABLE_NAME)),
-      threadPool(config.numThreads.value_or(LOG_DEFAULT_NUM_THREADS)),
-      running(true)
+      threadPool(config.numThreads.value_or(LOG_DEFAULT_NUM_THREADS), LogConfig::getThreadSettings(config)),
+      running(true),
+      minLevel(config.minLogLevel.value_or(LOG_DEFAULT_MIN_LOG_LEVEL))
 #ifdef SQLG_USE_SOURCE_INFO
     , sourceInfo(sourceInfo)
     , sourceId(sourceInfo.has_value() && sourceInfo.value().sourceId != SOURCE_NOT_FOUND ? sourceInfo.value().sourceId : SOURCE_NOT_FOUND)
@@ -42,59 +43,196 @@ SQLogger::SQLogger(std::unique_ptr<IDatabase> database, const LogConfig::Config&
 {
     std::scoped_lock lock(dbMutex);
 
-#ifdef SQLG_USE_SOURCE_INFO
+    if(!threadPool.getSetupError().empty())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_THREAD_SETTINGS + threadPool.getSetupError());
+    }
 
-    std::scoped_lock sourceLock(sourceMutex);
+    const TimestampFormat timestampFormat = config.timestampFormat.value_or(TimestampFormat::Text);
+    writer.setTimestampFormat(timestampFormat);
+    reader.setTimestampFormat(timestampFormat);
 
-    // Create sources table first!
-    writer.createSourcesTable();
+    // The shards keep their own schema, partitions and pooled connections would bypass the routing
+    const bool sharded = config.shards.has_value() && !config.shards->empty();
 
-    if(this->sourceInfo.has_value())
+    // Backends without SQL keep their own string pools
+    if(config.schemaLayout.value_or(SchemaLayout::Standard) == SchemaLayout::Compact
+            && !this->database->supportsNativeLogs())
     {
-        // Get existing source with uuid.
-        auto storedSource = reader.getSourceByUuid(this->sourceInfo.value().uuid);
+        dictionaries = std::make_shared<LogDictionaries>(config.databaseTable.value_or(LOG_TABLE_NAME));
+        writer.setCompactSchema(dictionaries);
+        reader.setCompactSchema(dictionaries);
+    }
 
-        // Compare existing source uuid with this uuid.
-        if(storedSource.has_value() && storedSource.value().uuid == this->sourceInfo.value().uuid)
-        {
-            this->sourceId = storedSource.value().sourceId;
-            this->sourceInfo = storedSource;
-        }
-        else
-        {
-            // Or add new source.
-            this->sourceId = writer.addSource(this->sourceInfo->name, this->sourceInfo->uuid);
-            this->sourceInfo = reader.getSourceById(this->sourceId);
-        }
+    // The shards compress their own messages
+    if(config.compressMessages.value_or(false) && !this->database->supportsNativeLogs()
+            && DataBaseHelper::isMessageCompressionSupported(this->database->getDatabaseType()))
+    {
+        messageCompressor = std::make_shared<LogMessageCompressor>(config.databaseTable.value_or(LOG_TABLE_NAME));
+        writer.setMessageCompression(messageCompressor);
+        reader.setMessageCompression(messageCompressor);
     }
-    else if(config.sourceUuid.has_value() && config.sourceName.has_value() && !config.sourceUuid->empty() && !config.sourceName->empty())
+
+    if(config.indexes.has_value())
+    {
+        writer.setIndexes(config.indexes.value());
+    }
+
+    if(config.partitioning.value_or(Partitioning::None) == Partitioning::Daily && !sharded
+            && DataBaseHelper::isPartitioningSupported(this->database->getDatabaseType()))
     {
-        // Get existing source with config uuid.
-        auto storedSource = reader.getSourceByUuid(config.sourceUuid.value());
+        partitions = std::make_shared<LogPartitions>(config.databaseTable.value_or(LOG_TABLE_NAME),
+                     this->database->getDatabaseType(),
+                     timestampFormat,
+                     config.retentionDays.value_or(LOG_DEFAULT_RETENTION_DAYS));
+        writer.setPartitions(partitions);
+    }
+
+    // Partitions of SQLite are separate tables, of MySQL can't have FULLTEXT indexes
+    fullTextSearch = config.fullTextSearch.value_or(false) && !sharded
+                     && DataBaseHelper::isFullTextSearchSupported(this->database->getDatabaseType())
+                     && (!partitions || this->database->getDatabaseType() == DataBaseType::PostgreSQL);
+    writer.setFullTextSearch(fullTextSearch);
+
+    // One marker lookup instead of a probe per table and index when the layout is unchanged
+    writer.createSchema(!config.deferIndexes.value_or(false));
+    if(!config.deferIndexes.value_or(false))
+    {
+        fullTextIndexed = fullTextSearch;
+        reader.setFullTextSearch(fullTextSearch);
+    }
+
+#ifdef SQLG_USE_SOURCE_INFO
+    registerSource();
+#endif
 
-        // Compare existing source uuid with config uuid.
-        if(storedSource.has_value() && storedSource.value().uuid == config.sourceUuid.value())
+    if(dictionaries)
+    {
+        // Warm up: known values are never looked up again
+        dictionaries->load( * this->database);
+    }
+
+    if(messageCompressor)
+    {
+        // Continue with the newest stored dictionary instead of training a new one
+        messageCompressor->load( * this->database);
+    }
+
+    const int groupCommitBatches = config.groupCommitBatches.value_or(LOG_DEFAULT_GROUP_COMMIT_BATCHES);
+    const int groupCommitWindowMs = config.groupCommitWindowMs.value_or(LOG_DEFAULT_GROUP_COMMIT_WINDOW_MS);
+    writer.setGroupCommit(std::max(groupCommitBatches, 0), std::chrono::milliseconds(std::max(groupCommitWindowMs, 0)));
+    writer.setBulkLoadThreshold(std::max(config.bulkLoadThreshold.value_or(LOG_DEFAULT_BULK_LOAD_THRESHOLD), 0));
+
+    const int connectionPoolSize = config.connectionPoolSize.value_or(LOG_DEFAULT_CONNECTION_POOL_SIZE);
+    if(!config.syncMode.value() && connectionPoolSize > 0 && !sharded
+            && DataBaseHelper::isConnectionPoolSupported(this->database->getDatabaseType()))
+    {
+        // Connections are opened on first use
+        connectionPool = std::make_unique<ConnectionPool>(connectionPoolSize, [config]()
         {
-            this->sourceId = storedSource.value().sourceId;
-            this->sourceInfo = storedSource;
-        }
-        else
+            return DatabaseFactory::create( * config.databaseType,
+                                            LogConfig::configToConnectionString(config),
+                                            LogConfig::configToSQLitePragmas(config));
+        });
+    }
+
+    const int readPoolSize = config.readPoolSize.value_or(LOG_DEFAULT_READ_POOL_SIZE);
+    if(readPoolSize > 0 && !sharded && DataBaseHelper::isReadPoolSupported(this->database->getDatabaseType()))
+    {
+        // Queries go to the replica when one is configured
+        LogConfig::Config readConfig = config;
+        readConfig.databaseHost = config.databaseReadHost.has_value() ? config.databaseReadHost : config.databaseHost;
+        readConfig.databasePort = config.databaseReadPort.has_value() ? config.databaseReadPort : config.databasePort;
+        readPool = std::make_unique<ConnectionPool>(readPoolSize, [readConfig]()
         {
-            // Or add new source.
-            this->sourceId = writer.addSource(this->sourceInfo->name, this->sourceInfo->uuid);
-            this->sourceInfo = reader.getSourceById(this->sourceId);
-        }
+            return DatabaseFactory::create( * readConfig.databaseType,
+                                            LogConfig::configToConnectionString(readConfig),
+                                            LogConfig::configToSQLitePragmas(readConfig));
+        });
+        queryThreads = static_cast<size_t>(readPoolSize);
     }
-    else
+
+    if(config.encryptMessages.value_or(false)
+            && DataBaseHelper::isEncryptionSupported(this->database->getDatabaseType()))
     {
-        // Or add new source with default name
-        this->sourceId = writer.addSource(SOURCE_DEFAULT_NAME);
-        this->sourceInfo = reader.getSourceById(this->sourceId);
+        cipher = std::make_shared<LogCipher>(config.getPassKey());
+        reader.setCipher(cipher);
     }
+
+    const int tailCacheSize = config.tailCacheSize.value_or(LOG_DEFAULT_TAIL_CACHE_SIZE);
+    if(tailCacheSize > 0 && !connectionPool && !cipher && !this->database->supportsNativeLogs())
+    {
+        // The cache would keep the plaintext of encrypted messages in memory
+        // Pooled connections write in parallel, so the IDs of a write could not be told apart
+        tailCache = std::make_shared<LogTailCache>(static_cast<size_t>(tailCacheSize),
+                    config.databaseTable.value_or(LOG_TABLE_NAME),
+                    this->database->getDatabaseType(),
+                    timestampFormat);
+#ifdef SQLG_USE_SOURCE_INFO
+        // Called by the writer with dbMutex held
+        tailCache->setSourceResolver([this](const int id)
+        {
+            return reader.getSourceById(id);
+        });
 #endif
+        writer.setTailCache(tailCache);
+    }
 
-    writer.createLogsTable();
-    writer.createIndexes();
+    const double sampleRate = config.sampleRate.value_or(LOG_DEFAULT_SAMPLE_RATE);
+    const int rateLimitPerSite = config.rateLimitPerSite.value_or(LOG_DEFAULT_RATE_LIMIT_PER_SITE);
+    const int rateLimitPerLevel = config.rateLimitPerLevel.value_or(LOG_DEFAULT_RATE_LIMIT_PER_LEVEL);
+    const int dedupWindowMs = config.dedupWindowMs.value_or(LOG_DEFAULT_DEDUP_WINDOW_MS);
+    if(sampleRate < 1.0 || rateLimitPerSite > 0 || rateLimitPerLevel > 0 || dedupWindowMs > 0)
+    {
+        throttle = std::make_unique<LogThrottle>(sampleRate,
+                   config.sampleLevel.value_or(LOG_DEFAULT_SAMPLE_LEVEL),
+                   static_cast<size_t>(std::max(rateLimitPerSite, 0)),
+                   static_cast<size_t>(std::max(rateLimitPerLevel, 0)),
+                   std::chrono::milliseconds(std::max(dedupWindowMs, 0)));
+    }
+
+    if(config.useBatch.value_or(false) && config.adaptiveBatch.value_or(LOG_DEFAULT_ADAPTIVE_BATCH))
+    {
+        // The configured flush interval bounds the tuned one; without it entries wait at most the target
+        const int targetMs = config.targetBatchLatencyMs.value_or(LOG_DEFAULT_TARGET_BATCH_LATENCY_MS);
+        const int flushIntervalMs = config.flushIntervalMs.value_or(LOG_DEFAULT_FLUSH_INTERVAL_MS);
+        batchTuner = std::make_unique<BatchTuner>(DB_MIN_BATCH_SIZE,
+                     static_cast<size_t>(std::max(LogConfig::getMaxBatchSize(config), DB_MIN_BATCH_SIZE)),
+                     static_cast<size_t>(config.batchSize.value_or(DB_MIN_BATCH_SIZE)),
+                     std::chrono::milliseconds(targetMs),
+                     std::chrono::milliseconds(flushIntervalMs > 0 ? flushIntervalMs : targetMs));
+    }
+
+    if(!config.fileSinkPath.value_or("").empty())
+    {
+        addSink(std::make_shared<LogFileSink>(config.fileSinkPath.value(),
+                                              config.fileSinkFormat.value_or(LOG_DEFAULT_FILE_SINK_FORMAT),
+                                              static_cast<uint64_t>(std::max(config.fileSinkMaxBytes.value_or(LOG_DEFAULT_FILE_SINK_MAX_BYTES), 0LL)),
+                                              std::chrono::seconds(std::max(config.fileSinkRotateSeconds.value_or(LOG_DEFAULT_FILE_SINK_ROTATE_SECONDS), 0)),
+                                              config.fileSinkMaxFiles.value_or(LOG_DEFAULT_FILE_SINK_MAX_FILES)),
+                static_cast<size_t>(std::max(config.sinkQueueSize.value_or(LOG_DEFAULT_SINK_QUEUE_SIZE), 1)));
+    }
+
+    if(!config.spoolPath.value_or("").empty())
+    {
+        // Replays entries left by a previous run as soon as the constructor releases dbMutex
+        spool = std::make_unique<LogSpool>(config.spoolPath.value(),
+                                           static_cast<uint64_t>(std::max(config.spoolMaxBytes.value_or(LOG_DEFAULT_SPOOL_MAX_BYTES), 0LL)));
+        spoolDrainer = std::thread( & SQLogger::spoolDrainerLoop, this);
+    }
+
+    if(config.useRing.value_or(LOG_DEFAULT_USE_RING))
+    {
+        ingestRing = std::make_unique<MPSCRing<LogTask>>(config.ringCapacity.value_or(LOG_DEFAULT_RING_CAPACITY));
+        ringWriter = std::thread( & SQLogger::ringWriterLoop, this);
+    }
+    else if(config.useBatch.value_or(false)
+            && (getFlushInterval().count() > 0
+                || (groupCommitBatches > 1 && groupCommitWindowMs > 0)))
+    {
+        flushTimer = std::thread( & SQLogger::flushTimerLoop, this);
+        flushTimerStarted = true;
+    }
 }
 
 /**
@@ -114,14 +252,40 @@ SQLogger::~SQLogger()
  */
 void SQLogger::shutdown()
 {
+    // Pending repeat counts and the entries buffered with them are written before the threads stop
+    if(running && throttle)
+    {
+        logPendingRepeats();
+        if(config.useBatch.value())
+        {
+            flushBatch();
+        }
+    }
+
     running = false;
+    stopFlushTimer();
+    stopRingWriter();
+
     if(!config.syncMode.value())
     {
         threadPool.waitForCompletion();
     }
 
+    stopSpoolDrainer();
+    stopSinks();
+
+    std::unique_ptr<ThreadPool> queries;
+    {
+        std::lock_guard<std::mutex> lock(queryPoolMutex);
+        queryPoolStopped = true;
+        queries = std::move(queryPool);
+    }
+    // Runs the queued queries; destroyed without the lock, so their callbacks may query again
+    queries.reset();
+
     if(database)
     {
+        commitGroup();
         database.reset();
     }
 }
@@ -133,7 +297,7 @@ void SQLogger::shutdown()
 */
 void SQLogger::log(const LogLevel level, const std::string& message)
 {
-    logAdd(level, message, __func__, __FILE__, __LINE__, threadIdToString(std::this_thread::get_id()));
+    logAdd(level, message, __func__, __FILE__, __LINE__, currentThreadId());
 }
 
 /**
@@ -144,14 +308,16 @@ void SQLogger::log(const LogLevel level, const std::string& message)
  * @param file The file where the log message was created.
  * @param line The line number where the log message was created.
  * @param threadId The ID of the thread that created the log message.
+ * @param args Format arguments (if active, message is their format string).
  */
-void SQLogger::logAdd(const LogLevel level, const std::string& message, const std::string& function, const std::string& file, int line, const std::string& threadId)
+void SQLogger::logAdd(const LogLevel level, std::string_view message, std::string_view function, std::string_view file, int line, std::string_view threadId,
+                      LogArgs args)
 {
-    if(level < config.minLogLevel.value()) return;
+    if(!isLevelEnabled(level)) return;
 
-    std::string fileName = config.onlyFileNames.value()
-                           ? FSHelper::toFilename(file)
-                           : file;
+    std::string_view fileName = config.onlyFileNames.value()
+                                ? FSHelper::toFilenameView(file)
+                                : file;
 
 #ifdef SQLG_USE_SOURCE_INFO
     if(sourceId == SOURCE_NOT_FOUND)
@@ -161,28 +327,226 @@ void SQLogger::logAdd(const LogLevel level, const std::string& message, const st
     }
 #endif
 
+    // Storm protection before anything is copied; priority entries are never throttled
+    if(throttle && !isPriorityLevel(level))
+    {
+        std::optional<LogThrottle::Repeat> repeat;
+        const LogThrottle::Verdict verdict = throttle->admit(level, message, args.bytes(), function, fileName, line, repeat);
+        if(repeat.has_value())
+        {
+            logRepeat(repeat.value(), threadId);
+        }
+        if(verdict != LogThrottle::Verdict::Accept)
+        {
+            return;
+        }
+    }
+
     LogTask task
     {
         level,
-        message,
-        function,
-        fileName,
+        std::string(message),
+        std::string(function),
+        std::string(fileName),
         line,
-        threadId,
+        std::string(threadId),
+        std::chrono::system_clock::now()
+#ifdef SQLG_USE_SOURCE_INFO
+        , sourceId
+#endif
+        , std::move(args)
+    };
+
+    enqueueTask(std::move(task));
+}
+
+/**
+ * @brief Logs the "Last message repeated N times" entry of a call site.
+ * @param repeat The pending repeat count.
+ * @param threadId The ID of the thread logging the entry.
+ */
+void SQLogger::logRepeat(const LogThrottle::Repeat& repeat, std::string_view threadId)
+{
+    LogTask task
+    {
+        repeat.level,
+        repeat.message(),
+        repeat.function,
+        repeat.file,
+        repeat.line,
+        std::string(threadId),
         std::chrono::system_clock::now()
 #ifdef SQLG_USE_SOURCE_INFO
         , sourceId
 #endif
     };
 
+    enqueueTask(std::move(task));
+}
+
+/**
+ * @brief Logs the pending repeat counts of every call site (before a flush).
+ */
+void SQLogger::logPendingRepeats()
+{
+    if(!throttle)
+    {
+        return;
+    }
+
+    for(const auto & repeat : throttle->takeRepeats())
+    {
+        logRepeat(repeat, LogHelper::currentThreadId());
+    }
+}
+
+/**
+ * @brief Logs entries received from another process (e.g. by a LogCollector).
+ * The entries take the same path as local log calls (ring, batch buffer or asynchronous
+ * drain), so entries of all senders are merged into the logger's batches and group commits.
+ * Level, message, location, thread ID and timestampUs are kept (the timestamp text is
+ * parsed if timestampUs is 0); entries below the minimum level are skipped.
+ * @param entries The log entries (with SQLG_USE_SOURCE_INFO, a positive sourceId is stored
+ * instead of the logger's own source).
+ * @return size_t Number of entries accepted.
+ */
+size_t SQLogger::logEntries(const LogEntryList& entries)
+{
+    size_t accepted = 0;
+    for(const auto & entry : entries)
+    {
+        const LogLevel level = stringToLevel(entry.level);
+        if(!isLevelEnabled(level)) continue;
+
+        std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+        if(entry.timestampUs != 0)
+        {
+            timestamp = std::chrono::system_clock::time_point(std::chrono::microseconds(entry.timestampUs));
+        }
+        else if(!entry.timestamp.empty())
+        {
+            try
+            {
+                timestamp = parseTime(entry.timestamp);
+            }
+            catch(const std::exception&)
+            {
+                // keep the receive time
+            }
+        }
+
+        LogTask task
+        {
+            level,
+            entry.message,
+            entry.function,
+            config.onlyFileNames.value() ? FSHelper::toFilename(entry.file) : entry.file,
+            entry.line,
+            entry.threadId,
+            timestamp
+#ifdef SQLG_USE_SOURCE_INFO
+            , entry.sourceId > 0 ? entry.sourceId : sourceId.load()
+#endif
+        };
+
+        if(enqueueTask(std::move(task)))
+        {
+            ++accepted;
+        }
+    }
+    return accepted;
+}
+
+/**
+ * @brief Hands a task to the configured write path and records the enqueue latency and queue depth.
+ * @param task The log task.
+ * @return bool False if the task was dropped by the ring back-pressure policy.
+ * @see dispatchTask()
+ */
+bool SQLogger::enqueueTask(LogTask&& task)
+{
+    const auto start = std::chrono::steady_clock::now();
+    task.enqueued = start;
+
+    // Sinks take their copies first, the database path may block
+    if(const auto sinks = std::atomic_load( & sinkQueues))
+    {
+        for(const auto & queue : * sinks)
+        {
+            queue->push(task);
+        }
+    }
+
+    // Counted before the hand-over, so a writer taking the task never sees a negative depth
+    const uint64_t depth = statsCounters.queueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+    atomicStoreMax(statsCounters.maxQueueDepth, depth);
+
+    const bool accepted = dispatchTask(std::move(task));
+    if(!accepted)
+    {
+        statsCounters.queueDepth.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    statsCounters.enqueueLatency.record(static_cast<uint64_t>(elapsed.count()));
+    return accepted;
+}
+
+/**
+ * @brief Hands a task to the configured write path (ring, batch buffer, synchronous or asynchronous write).
+ * @param task The log task.
+ * @return bool False if the task was dropped by the ring back-pressure policy.
+ */
+bool SQLogger::dispatchTask(LogTask&& task)
+{
+    if(ingestRing)
+    {
+        return ringPush(std::move(task));
+    }
+
     if(config.useBatch.value())
     {
-        std::lock_guard<std::recursive_mutex> lock(batchMutex);
-        batchBuffer.push_back(task);
+        const bool priority = isPriorityLevel(task.level);
+        bool started = false;
+        std::vector<LogTask> priorityBatch;
+        uint64_t before = 0;
+        {
+            std::lock_guard<std::recursive_mutex> lock(batchMutex);
+            started = batchBuffer.empty();
+            batchBytes += taskSizeBytes(task);
+            batchBuffer.push_back(std::move(task));
 
-        if(batchBuffer.size() >= config.batchSize.value())
+            const int maxBatchBytes = config.maxBatchBytes.value_or(LOG_DEFAULT_MAX_BATCH_BYTES);
+
+            if(priority)
+            {
+                // Taken out here, written below without batchMutex
+                priorityBatch = taskBuffers.acquire(static_cast<size_t>(std::max(getBatchSize(), 1)));
+                priorityBatch.swap(batchBuffer);
+                batchBytes = 0;
+                before = drain.submitted();
+            }
+            else if(batchBuffer.size() >= static_cast<size_t>(getBatchSize())
+                    || (maxBatchBytes > 0 && batchBytes >= static_cast<size_t>(maxBatchBytes)))
+            {
+                flushBatch();
+            }
+        }
+
+        if(priority)
         {
-            flushBatch();
+            // Durable before the log call returns, behind the entries logged before it
+            writePriorityBatch(priorityBatch, before);
+        }
+        else if(started && flushTimerStarted)
+        {
+            // The timer may be in an idle sleep; let it schedule the new entry's deadline.
+            // Outside batchMutex: the timer takes batchMutex while holding flushTimerMutex.
+            {
+                std::lock_guard<std::mutex> lock(flushTimerMutex);
+                ++flushTimerWakes;
+            }
+            flushTimerCondition.notify_one();
         }
     }
     else
@@ -193,38 +557,198 @@ void SQLogger::logAdd(const LogLevel level, const std::string& message, const st
         }
         else
         {
-            threadPool.enqueue([this, task]
+            // Hand the task over to a single queued drain instead of one pool task per entry
+            bool schedule = false;
             {
-                processTask(task);
-            });
+                std::lock_guard<std::mutex> lock(asyncMutex);
+                task.sequence = drain.submit();
+                asyncTasks.push_back(std::move(task));
+                const size_t maxDrains = connectionPool ? connectionPool->getMaxSize() : 1;
+                schedule = asyncDrainsScheduled < maxDrains;
+                if(schedule)
+                {
+                    ++asyncDrainsScheduled;
+                }
+            }
+
+            if(schedule)
+            {
+                threadPool.enqueue([this]
+                {
+                    drainAsyncTasks();
+                });
+            }
         }
     }
+    return true;
 }
 
 /**
- * @brief Waits until the task queue is empty.
+ * @brief Waits until every task handed to the writers so far has been written.
+ * Returns as soon as the last of them lands; tasks logged during the wait are not waited for.
  * @param timeout The maximum time to wait.
- * @return True if the queue is empty within the timeout, false otherwise.
+ * @return True if the tasks were written within the timeout, false otherwise.
  */
 bool SQLogger::waitUntilEmpty(const std::chrono::milliseconds& timeout)
 {
-    if(config.syncMode.value())
+    if(config.syncMode.value() && !ingestRing)
     {
         return true;
     }
 
-    auto start = std::chrono::steady_clock::now();
-    while(!threadPool.isQueueEmpty())
+    return drain.waitFor(drain.submitted(), timeout);
+}
+
+/**
+ * @brief Adds a sink that receives every entry handed to the logger from now on.
+ * The sink gets its own bounded queue and writer thread, fed by the log call before the
+ * entry takes the database path, so neither a slow database nor another sink delays it.
+ * A full queue drops the sink's copy of new entries (see Stats::totalSinkDropped).
+ * @param sink The sink.
+ * @param queueSize Maximum number of entries queued for the sink.
+ * @see LogConfig::Config::fileSinkPath
+ */
+void SQLogger::addSink(std::shared_ptr<ILogSink> sink, const size_t queueSize)
+{
+    if(!sink)
+    {
+        return;
+    }
+
+    auto queue = std::make_shared<SinkQueue<LogTask>>(std::move(sink), std::max<size_t>(queueSize, 1), [this](LogTask && task)
+    {
+        return convertTaskToEntry(std::move(task));
+    }, LogConfig::getThreadSettings(config));
+
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    const auto current = std::atomic_load( & sinkQueues);
+    auto sinks = current ? std::make_shared<SinkQueueList>( * current) : std::make_shared<SinkQueueList>();
+    sinks->push_back(std::move(queue));
+    std::atomic_store( & sinkQueues, std::shared_ptr<const SinkQueueList>(std::move(sinks)));
+}
+
+/**
+ * @brief Waits until every sink has written and flushed the entries queued so far.
+ * @param timeout The maximum time to wait for each sink.
+ * @return True if every sink queue ran empty within the timeout, false otherwise.
+ */
+bool SQLogger::waitForSinks(const std::chrono::milliseconds& timeout)
+{
+    bool empty = true;
+    if(const auto sinks = std::atomic_load( & sinkQueues))
+    {
+        for(const auto & queue : * sinks)
+        {
+            empty = queue->waitUntilEmpty(timeout) && empty;
+        }
+    }
+    return empty;
+}
+
+/**
+ * @brief Waits until entries logged before the given time point are committed to the database.
+ * Flushes the batch buffer, waits for the writers and commits the open group-commit transaction.
+ * @param before Entries whose log call returned before this time point are waited for.
+ * @param timeout The maximum time to wait.
+ * @return True if the entries are durable within the timeout, false otherwise.
+ */
+bool SQLogger::waitUntilDurable(const std::chrono::system_clock::time_point& before, const std::chrono::milliseconds& timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    // Entries stamped before a future time point may still be logged until then
+    const auto ahead = std::chrono::duration_cast<std::chrono::milliseconds>(before - std::chrono::system_clock::now());
+    if(ahead.count() > 0)
     {
-        if(std::chrono::steady_clock::now() - start > timeout)
+        if(ahead > timeout)
         {
+            std::this_thread::sleep_for(timeout);
             return false;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::this_thread::sleep_for(ahead);
+    }
+
+    if(config.useBatch.value())
+    {
+        flushBatch();
+    }
+
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if(!waitUntilEmpty(std::max(remaining, std::chrono::milliseconds(0))))
+    {
+        return false;
+    }
+
+    commitGroup();
+    return true;
+}
+
+/**
+ * @brief Enters bulk-load mode: drops the configured log table indexes.
+ * Rows written until endBulkLoad() maintain no secondary index, which makes a
+ * large backfill much cheaper; queries without an index scan the table meanwhile.
+ * @return True if the indexes were dropped, false otherwise.
+ * @see Config::deferIndexes
+ */
+bool SQLogger::beginBulkLoad()
+{
+    std::lock_guard<std::mutex> lock(dbMutex);
+
+    // DDL must not run inside an open group transaction
+    writer.commitPending();
+    countLostEntries();
+
+    // MATCH filters fall back to LIKE until the full-text index is rebuilt
+    fullTextIndexed = false;
+    reader.setFullTextSearch(false);
+    if(!writer.dropIndexes())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_FAILED_DROP_INDEXES);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Leaves bulk-load mode: waits for pending writes and rebuilds the log table indexes.
+ * @param timeout The maximum time to wait for pending writes before building the indexes.
+ * @return True if every index was built, false otherwise.
+ */
+bool SQLogger::endBulkLoad(const std::chrono::milliseconds& timeout)
+{
+    // Best effort: rows written later are indexed on insert anyway
+    waitUntilDurable(std::chrono::system_clock::now(), timeout);
+
+    std::lock_guard<std::mutex> lock(dbMutex);
+    writer.commitPending();
+    countLostEntries();
+    if(!writer.createIndexes())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_FAILED_CREATE_INDEXES);
+        return false;
     }
+
+    fullTextIndexed = fullTextSearch;
+    reader.setFullTextSearch(fullTextSearch);
     return true;
 }
 
+/**
+ * @brief Applies the retention policy now: drops the expired daily partitions with all their rows.
+ * Writes apply it as well, each time they reach the newest partition.
+ * @return size_t Number of dropped partitions (0 if the log table is not partitioned).
+ * @see LogConfig::Config::partitioning, LogConfig::Config::retentionDays
+ */
+size_t SQLogger::applyRetention()
+{
+    std::lock_guard<std::mutex> lock(dbMutex);
+
+    // DDL must not run inside an open group transaction
+    writer.commitPending();
+    countLostEntries();
+    return writer.dropExpiredPartitions();
+}
+
 /**
 * @brief Exports log entries to a specified format file.
 * @param filePath The path to the output file.
@@ -232,92 +756,148 @@ bool SQLogger::waitUntilEmpty(const std::chrono::milliseconds& timeout)
 * @param entryList The list of log entries to export.
 * @param delimiter The delimiter to use between fields.
 * @param name Whether to include field names in the output.
+* @param compression Output compression.
+*/
+void SQLogger::exportTo(const std::string& filePath,
+                        const LogExport::Format& format,
+                        const LogEntryList& entryList,
+                        const std::string& delimiter,
+                        bool name,
+                        const LogCompress::Compression& compression)
+{
+    LogExport::exportTo(filePath, format, entryList, delimiter, name, compression);
+}
+
+/**
+* @brief Exports the log entries matching the filters straight from the database, ordered by ID.
+* Entries are streamed page by page (see forEachLog()) into a LogExport::Writer,
+* so the result set is never held in memory.
+* @param filePath The path to the output file.
+* @param format Format of the output file.
+* @param filters Vector of Filter objects defining search criteria (empty exports everything).
+* @param delimiter The delimiter to use between fields.
+* @param name Whether to include field names in the output.
+* @param threads Number of formatting (and compression) threads (0 or 1 formats on the calling thread).
+* @param compression Output compression, applied per chunk on the formatting threads.
+* @return size_t Number of exported entries.
+* @throws std::runtime_error If the file cannot be created or written, or reading the entries fails.
 */
-void SQLogger::exportTo(const std::string& filePath, const LogExport::Format& format, const LogEntryList& entryList, const std::string& delimiter, bool name)
+size_t SQLogger::exportLogs(const std::string& filePath,
+                            const LogExport::Format& format,
+                            const std::vector<Filter> & filters,
+                            const std::string& delimiter,
+                            bool name,
+                            const size_t threads,
+                            const LogCompress::Compression& compression)
 {
-    LogExport::exportTo(filePath, format, entryList, delimiter, name);
+    LogExport::Writer writer(filePath, format, delimiter, name, threads, compression);
+    forEachLog(filters, [ & writer](const LogEntry & entry)
+    {
+        writer.write(entry);
+        return true;
+    }, LOG_EXPORT_PAGE_SIZE);
+    writer.close();
+    return writer.count();
 }
 
+/**
+* @brief Sets the internal error log file (buffered lines are written to the previous one first).
+* @param errLogFile The error log file path.
+*/
 void SQLogger::setErrorLogPath(const std::string& errLogFile)
 {
-    errorLogFile = errLogFile;
+    errorLog.setPath(errLogFile);
 }
 
 /**
  * @brief Processes a single log task.
- * @param task The log task to process.
+ * The task's strings are moved into the written entry.
+ * @param task The log task to process (only its level, timestamps and sequence are kept).
  */
-void SQLogger::processTask(const LogTask& task)
+void SQLogger::processTask(LogTask& task)
 {
-    auto startTime = std::chrono::high_resolution_clock::now();
+    auto startTime = std::chrono::steady_clock::now();
     bool success = false;
+    recordTaken(task, startTime);
 
+    LogEntryList entries = entryBuffers.acquire(1);
     try
     {
-        std::scoped_lock lock(dbMutex, statsMutex);
-        std::string levelStr = levelToString(task.level);
-        std::string timestamp = getCurrentTimestamp();
-
-        LogEntry entry = convertTaskToEntry(task);
-
-        if(!writer.writeLog(entry))
-        {
-            success = false;
-            LOG_INTERNAL_ERROR(ERR_MSG_FAILED_QUERY);
-        }
-
-        success = true;
+        // Not an initializer list: that would copy the entry
+        entries.push_back(convertTaskToEntry(std::move(task)));
+        success = writeOrSpool(entries);
     }
     catch(const std::exception& e)
     {
         success = false;
         LOG_INTERNAL_ERROR(ERR_MSG_FAILED_TASK + std::string(e.what()));
     }
+    entryBuffers.release(std::move(entries));
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto taskTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    if(success)
+    {
+        recordWritten(task, std::chrono::system_clock::now());
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto taskTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
     updateSingleEntryStats(taskTime, success);
 }
 
 /**
  * @brief Processes a batch of log tasks.
- * @param batch The batch of log tasks to process.
+ * The tasks' strings are moved into the written entries, the entry list is taken from entryBuffers.
+ * @param batch The batch of log tasks to process (only their level, timestamps and sequence are kept).
  */
-void SQLogger::processBatch(const std::vector<LogTask> & batch)
+void SQLogger::processBatch(std::vector<LogTask> & batch)
 {
-    auto startTime = std::chrono::high_resolution_clock::now();
+    if(batch.empty())
+    {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
     bool success = false;
+    for(const auto & task : batch)
+    {
+        recordTaken(task, startTime);
+    }
 
+    LogEntryList entries = entryBuffers.acquire(batch.size());
     try
     {
-        std::scoped_lock lock(dbMutex, statsMutex);
-
         // Convert tasks to entries
-        LogEntryList entries;
-        entries.reserve(batch.size());
-        for(const auto & task : batch)
+        for(auto & task : batch)
         {
-            entries.push_back(convertTaskToEntry(task));
+            entries.push_back(convertTaskToEntry(std::move(task)));
         }
 
-        if(!writer.writeLogBatch(entries))
-        {
-            success = false;
-            LOG_INTERNAL_ERROR(ERR_MSG_FAILED_BATCH_QUERY);
-        }
-
-        success = true;
+        success = writeOrSpool(entries);
     }
     catch(const std::exception& e)
     {
         success = false;
         LOG_INTERNAL_ERROR(ERR_MSG_FAILED_BATCH_TASK + std::string(e.what()));
     }
+    entryBuffers.release(std::move(entries));
+
+    if(success)
+    {
+        const auto written = std::chrono::system_clock::now();
+        for(const auto & task : batch)
+        {
+            recordWritten(task, written);
+        }
+    }
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto batchTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    auto endTime = std::chrono::steady_clock::now();
+    auto batchTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
 
     updateBatchStats(batch.size(), batchTime, success);
+    if(batchTuner)
+    {
+        batchTuner->record(batch.size(), static_cast<uint64_t>(batchTime), statsCounters.queueDepth.load(std::memory_order_relaxed));
+    }
 }
 
 /**
@@ -328,9 +908,30 @@ void SQLogger::processBatch(const std::vector<LogTask> & batch)
  */
 void SQLogger::flush()
 {
+    logPendingRepeats();
+
+    if(ingestRing)
+    {
+        waitUntilEmpty();
+        commitGroup();
+        return;
+    }
+
     if(config.useBatch.value())
     {
         flushBatch();
+
+        if(config.syncMode.value())
+        {
+            commitGroup();
+        }
+        else
+        {
+            threadPool.enqueue([this]
+            {
+                commitGroup();
+            });
+        }
     }
 }
 
@@ -360,104 +961,858 @@ bool SQLogger::isBatchEnabled() const
 }
 
 /**
- * @brief Gets the current batch size used for buffered logging operations.
- * @return int The maximum number of log entries that will be buffered
- * before being written to the database. Returns 0 if batching is disabled.
- * @see setBatchSize()
+ * @brief Gets the current batch size used for buffered logging operations.
+ * With adaptive batching this is the size currently chosen by the tuner.
+ * @return int The maximum number of log entries that will be buffered
+ * before being written to the database. Returns 0 if batching is disabled.
+ * @see setBatchSize()
+ * @see LogConfig::Config::adaptiveBatch
+ */
+int SQLogger::getBatchSize() const
+{
+    if(!isBatchEnabled())
+    {
+        return 0;
+    }
+    return batchTuner ? static_cast<int>(batchTuner->getBatchSize()) : config.batchSize.value();
+}
+
+/**
+ * @brief Gets the current maximum age of a partial batch before a background flush.
+ * With adaptive batching this is the interval currently chosen by the tuner.
+ * @return std::chrono::milliseconds Flush interval (0 = disabled).
+ * @see LogConfig::Config::flushIntervalMs
+ */
+std::chrono::milliseconds SQLogger::getFlushInterval() const
+{
+    if(batchTuner)
+    {
+        return batchTuner->getFlushInterval();
+    }
+    return std::chrono::milliseconds(config.flushIntervalMs.value_or(LOG_DEFAULT_FLUSH_INTERVAL_MS));
+}
+
+/**
+ * @brief Sets the maximum batch size for buffered logging.
+ * Updates the batch size configuration and ensures thread-safe operation:
+ * 1. If reducing batch size, flushes current buffer if it exceeds new size
+ * 2. If disabling batching (size=0), performs immediate flush
+ * @param size New maximum batch size (0 to disable batching)
+ * @throws std::invalid_argument If size is negative or bigger than DB_MAX_BATCH_
+ * @see flush()
+ * @see isBatchEnabled()
+ * @see DataBaseHelper::getMaxBatchSize()
+ * @see DB_MAX_BATCH_SQLITE, DB_MAX_BATCH_MYSQL, DB_MAX_BATCH_POSTGRESQL.
+ */
+void SQLogger::setBatchSize(const int size)
+{
+    const int maxBatchSize = LogConfig::getMaxBatchSize(config);
+
+    if(size > maxBatchSize || maxBatchSize == DB_BATCH_NOT_SUPPORTED)
+    {
+        throw std::invalid_argument("Batch size for selected database can't be negative or bigger than: " + maxBatchSize);
+    }
+
+    if(size < 0)
+    {
+        throw std::invalid_argument("Batch size can't be negative");
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(batchMutex);
+
+    // Flush if: 1) Disabling batching, or 2) Shrinking below current buffer size
+    if((size == 0 && config.useBatch.value()) || (config.useBatch.value() && batchBuffer.size() > size))
+    {
+        flushBatch();
+    }
+
+    config.batchSize.value() = size;
+    config.useBatch.value() = (size > 0);
+    if(batchTuner && size > 0)
+    {
+        batchTuner->reset(static_cast<size_t>(size));
+    }
+}
+
+/**
+ * @brief Forces immediate processing (writes to the database) of all batched log entries, if useBatch = true.
+ * This method:
+ * 1. Atomically moves all entries from the batch buffer to a local vector
+ * 2. Processes them either:
+ * - Synchronously (in current thread) if syncMode=true
+ * - Asynchronously (via thread pool) if syncMode=false
+ * @see Config
+ * @see processBatch()
+ * @see syncMode
+ */
+void SQLogger::flushBatch()
+{
+    if(batchBuffer.empty()) return;
+
+    // The batch buffer continues in a recycled vector that already has the batch capacity
+    std::vector<LogTask> currentBatch = taskBuffers.acquire(static_cast<size_t>(std::max(getBatchSize(), 1)));
+    uint64_t first = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(batchMutex);
+        currentBatch.swap(batchBuffer);
+        batchBytes = 0;
+        if(!config.syncMode.value())
+        {
+            // Under batchMutex, so a later priority entry waits for this batch
+            first = drain.submit(currentBatch.size());
+        }
+    }
+
+    if(config.syncMode.value())
+    {
+        processBatch(currentBatch);
+        taskBuffers.release(std::move(currentBatch));
+    }
+    else
+    {
+        threadPool.enqueue([this, first, batch = std::move(currentBatch)]() mutable
+        {
+            const size_t count = batch.size();
+            processBatch(batch);
+            taskBuffers.release(std::move(batch));
+            drain.complete(first, count);
+        });
+    }
+}
+
+/**
+ * @brief Writes a batch ending with a priority entry in the calling thread and commits
+ * the open group-commit transaction. Called without batchMutex, so other producers keep
+ * buffering; in async mode it first waits for the batches handed to the thread pool
+ * before it, so the priority entry is stored behind them.
+ * @param batch The batch taken out of the batch buffer.
+ * @param before drain.submitted() when the batch was taken out.
+ */
+void SQLogger::writePriorityBatch(std::vector<LogTask> & batch, const uint64_t before)
+{
+    if(!config.syncMode.value())
+    {
+        drain.wait(before);
+    }
+    processBatch(batch);
+    taskBuffers.release(std::move(batch));
+    commitGroup();
+}
+
+/**
+ * @brief Background flush timer thread body.
+ * Flushes the batch buffer once its oldest entry is older than getFlushInterval().
+ * @see LogConfig::Config::flushIntervalMs
+ */
+void SQLogger::flushTimerLoop()
+{
+    applyThreadSettings();
+
+    const auto groupWindow = std::chrono::milliseconds(config.groupCommitWindowMs.value_or(LOG_DEFAULT_GROUP_COMMIT_WINDOW_MS));
+
+    std::unique_lock<std::mutex> timerLock(flushTimerMutex);
+    while(!flushTimerStop)
+    {
+        // Re-read every round: adaptive batching changes the interval at runtime
+        const auto interval = getFlushInterval();
+        const auto idleWait = interval.count() > 0 ? interval : groupWindow;
+
+        // Sleep until the oldest buffered entry reaches the interval age or the group window expires
+        auto wait = idleWait;
+        if(interval.count() > 0)
+        {
+            std::lock_guard<std::recursive_mutex> lock(batchMutex);
+            if(!batchBuffer.empty())
+            {
+                auto age = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - batchBuffer.front().timestamp);
+                wait = std::min(wait, age >= interval ? std::chrono::milliseconds(0) : interval - age);
+            }
+        }
+        if(groupWindow.count() > 0)
+        {
+            std::lock_guard<std::mutex> lock(dbMutex);
+            wait = std::min(wait, writer.getGroupCommitRemaining());
+        }
+
+        const uint64_t wakes = flushTimerWakes;
+        flushTimerCondition.wait_for(timerLock, wait, [this, wakes]
+        {
+            return flushTimerStop || flushTimerWakes != wakes;
+        });
+
+        if(flushTimerStop)
+        {
+            break;
+        }
+        if(flushTimerWakes != wakes)
+        {
+            // A new entry started the buffer: recompute the wait from its timestamp
+            continue;
+        }
+
+        timerLock.unlock();
+        if(interval.count() > 0)
+        {
+            std::lock_guard<std::recursive_mutex> lock(batchMutex);
+            if(!batchBuffer.empty() && std::chrono::system_clock::now() - batchBuffer.front().timestamp >= interval)
+            {
+                flushBatch();
+            }
+        }
+        if(groupWindow.count() > 0)
+        {
+            commitGroup(false);
+        }
+        timerLock.lock();
+    }
+}
+
+/**
+ * @brief Stops the background flush timer thread.
+ */
+void SQLogger::stopFlushTimer()
+{
+    {
+        std::lock_guard<std::mutex> lock(flushTimerMutex);
+        flushTimerStop = true;
+        flushTimerStarted = false;
+    }
+    flushTimerCondition.notify_all();
+
+    if(flushTimer.joinable())
+    {
+        flushTimer.join();
+    }
+}
+
+/**
+ * @brief Commits the open group-commit transaction (if any).
+ * @param force If false, commits only when the group window has elapsed.
+ * @see LogWriter::commitPending()
+ */
+void SQLogger::commitGroup(const bool force)
+{
+    std::lock_guard<std::mutex> lock(dbMutex);
+    if(!writer.commitPending(force))
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_FAILED_GROUP_COMMIT);
+    }
+    countLostEntries();
+}
+
+/**
+ * @brief Counts the entries the writer lost with a rolled back group as failed.
+ * @note Must be called with dbMutex held.
+ * @see LogWriter::takeLostEntries()
+ */
+void SQLogger::countLostEntries()
+{
+    const size_t lost = writer.takeLostEntries();
+    if(lost > 0)
+    {
+        statsCounters.totalFailed.fetch_add(lost, std::memory_order_relaxed);
+        LOG_INTERNAL_ERROR(ERR_MSG_GROUP_ENTRIES_LOST + std::to_string(lost));
+    }
+}
+
+/**
+ * @brief Gets the approximate memory footprint of a task, used for maxBatchBytes accounting.
+ * @param task The log task.
+ * @return size_t Size in bytes (struct size plus string payloads).
+ */
+size_t SQLogger::taskSizeBytes(const LogTask& task)
+{
+    return sizeof(LogTask)
+           + task.message.size()
+           + task.args.size()
+           + task.function.size()
+           + task.file.size()
+           + task.threadId.size();
+}
+
+/**
+ * @brief Pushes a task into the ingestion ring applying the back-pressure policy.
+ * Lock-free on the fast path; when the ring is full the task is either dropped
+ * or the producer spins until the writer frees a slot (see BackPressure).
+ * @param task The log task to enqueue.
+ * @return True if the task was enqueued, false if it was dropped.
+ * @see LogConfig::Config::backPressure
+ */
+bool SQLogger::ringPush(LogTask&& task)
+{
+    const BackPressure policy = config.backPressure.value_or(BackPressure::Block);
+    const bool canDrop = policy == BackPressure::DropNewest
+                         || (policy == BackPressure::DropBelowLevel
+                             && task.level < config.backPressureLevel.value_or(LOG_DEFAULT_RING_DROP_LEVEL));
+
+    // Sequence before push, so waitUntilEmpty() never misses a task that is in the ring
+    const uint64_t sequence = drain.submit();
+    task.sequence = sequence;
+
+    while(!ingestRing->tryPush(std::move(task)))
+    {
+        if(canDrop || !running)
+        {
+            drain.complete(sequence);
+            ringDropped++;
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Ring writer thread body.
+ * Drains the ingestion ring, builds batches of up to batchSize tasks and
+ * writes them to the database. Exits after the ring is drained once stop is requested.
+ */
+void SQLogger::ringWriterLoop()
+{
+    applyThreadSettings();
+
+    const WaitStrategy wait = config.waitStrategy.value_or(LOG_DEFAULT_WAIT_STRATEGY);
+    std::vector<LogTask> batch;
+    LogTask task;
+    bool pendingCommit = false;
+    std::optional<std::chrono::steady_clock::time_point> idleSince;
+
+    while(true)
+    {
+        const size_t maxBatch = config.useBatch.value_or(false)
+                                ? std::max(getBatchSize(), 1)
+                                : 1;
+        const int maxBatchBytes = config.maxBatchBytes.value_or(LOG_DEFAULT_MAX_BATCH_BYTES);
+        size_t bytes = 0;
+
+        batch.clear();
+        while(batch.size() < maxBatch
+                && (maxBatchBytes <= 0 || bytes < static_cast<size_t>(maxBatchBytes))
+                && ingestRing->tryPop(task))
+        {
+            bytes += taskSizeBytes(task);
+            batch.push_back(std::move(task));
+        }
+
+        if(batch.empty())
+        {
+            // Writer is idle: commit the open group right away
+            if(pendingCommit)
+            {
+                commitGroup();
+                pendingCommit = false;
+            }
+
+            if(ringStop)
+            {
+                break;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if(!idleSince.has_value())
+            {
+                idleSince = now;
+            }
+            if(wait == WaitStrategy::Spin
+                    || (wait == WaitStrategy::Hybrid && now - idleSince.value() < std::chrono::microseconds(THREAD_HELPER_HYBRID_SPIN_US)))
+            {
+                ThreadHelper::relax();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(LOG_RING_IDLE_SLEEP_US));
+            }
+            continue;
+        }
+        idleSince.reset();
+
+        const bool priority = std::any_of(batch.begin(), batch.end(), [this](const LogTask & pending)
+        {
+            return isPriorityLevel(pending.level);
+        });
+
+        if(batch.size() == 1)
+        {
+            processTask(batch.front());
+        }
+        else
+        {
+            processBatch(batch);
+            pendingCommit = true;
+        }
+
+        // Priority entries do not wait in the open group for the ring to run empty
+        if(priority)
+        {
+            commitGroup();
+            pendingCommit = false;
+        }
+        completeTasks(batch);
+    }
+}
+
+/**
+ * @brief Thread pool task writing the tasks queued by asynchronous non-batch logging.
+ * Takes everything queued so far and writes it with as few batch INSERTs as the
+ * database allows, so concurrent log calls do not each wait for dbMutex.
+ * With a connection pool, up to connectionPoolSize drains run in parallel.
+ */
+void SQLogger::drainAsyncTasks()
+{
+    // The hand-off queue continues in a recycled vector
+    std::vector<LogTask> tasks = taskBuffers.acquire();
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        tasks.swap(asyncTasks);
+        --asyncDrainsScheduled;
+    }
+    if(tasks.empty())
+    {
+        // A parallel drain took everything already
+        taskBuffers.release(std::move(tasks));
+        return;
+    }
+
+    const int maxBatchSize = LogConfig::getMaxBatchSize(config);
+    if(tasks.size() == 1 || maxBatchSize <= 1)
+    {
+        for(auto & task : tasks)
+        {
+            processTask(task);
+        }
+        completeTasks(tasks);
+        taskBuffers.release(std::move(tasks));
+        return;
+    }
+
+    if(tasks.size() <= static_cast<size_t>(maxBatchSize))
+    {
+        processBatch(tasks);
+        completeTasks(tasks);
+    }
+    else
+    {
+        std::vector<LogTask> batch = taskBuffers.acquire(static_cast<size_t>(maxBatchSize));
+        for(size_t begin = 0; begin < tasks.size(); begin += batch.size())
+        {
+            const size_t count = std::min(tasks.size() - begin, static_cast<size_t>(maxBatchSize));
+            batch.assign(std::make_move_iterator(tasks.begin() + begin),
+                         std::make_move_iterator(tasks.begin() + begin + count));
+            processBatch(batch);
+            completeTasks(batch);
+        }
+        taskBuffers.release(std::move(batch));
+    }
+    taskBuffers.release(std::move(tasks));
+
+    // Nothing else queued: commit the open group right away
+    bool idle = false;
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        idle = asyncTasks.empty();
+    }
+    if(idle)
+    {
+        commitGroup();
+    }
+}
+
+/**
+ * @brief Reports written tasks to the drain tracker.
+ * Consecutive sequence numbers are reported as one range.
+ * @param tasks The written (or failed) tasks.
+ */
+void SQLogger::completeTasks(const std::vector<LogTask> & tasks)
+{
+    for(size_t i = 0; i < tasks.size();)
+    {
+        const uint64_t first = tasks[i].sequence;
+        uint64_t count = 1;
+        while(i + count < tasks.size() && tasks[i + count].sequence == first + count)
+        {
+            ++count;
+        }
+        drain.complete(first, count);
+        i += count;
+    }
+}
+
+/**
+ * @brief Writes entries through a connection leased from the connection pool.
+ * Used instead of the shared connection (and dbMutex) when connectionPoolSize > 0,
+ * so asynchronous workers write in parallel.
+ * @param entries The log entries to write.
+ * @return True if the entries were written successfully, false otherwise.
+ * @throws std::runtime_error If no pooled connection could be opened.
+ */
+bool SQLogger::writePooled(const LogEntryList& entries)
+{
+    ConnectionPool::Lease lease = connectionPool->acquire();
+
+    LogWriter pooledWriter(lease.get(), config.databaseTable.value_or(LOG_TABLE_NAME));
+    pooledWriter.setBulkLoadThreshold(std::max(config.bulkLoadThreshold.value_or(LOG_DEFAULT_BULK_LOAD_THRESHOLD), 0));
+    pooledWriter.setTimestampFormat(config.timestampFormat.value_or(TimestampFormat::Text));
+    pooledWriter.setCompactSchema(dictionaries);
+    pooledWriter.setPartitions(partitions);
+    pooledWriter.setMessageCompression(messageCompressor);
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool written = entries.size() == 1
+                         ? pooledWriter.writeLog(entries.front())
+                         : pooledWriter.writeLogBatch(entries);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    statsCounters.dbExecute.record(static_cast<uint64_t>(elapsed.count()));
+    if(!written)
+    {
+        // Reopen on next use in case the connection is broken
+        lease.invalidate();
+    }
+    return written;
+}
+
+/**
+ * @brief Stops the ring writer thread after it drains the ingestion ring.
+ */
+void SQLogger::stopRingWriter()
+{
+    ringStop = true;
+    if(ringWriter.joinable())
+    {
+        ringWriter.join();
+    }
+}
+
+/**
+ * @brief Writes entries through the pooled or the shared connection.
+ * With message encryption the batch is encrypted first, by the calling worker and
+ * without dbMutex, so pooled workers encrypt in parallel.
+ * @param entries The log entries to write.
+ * @return True if the entries were written successfully, false otherwise.
+ */
+bool SQLogger::writeEntries(const LogEntryList& entries)
+{
+    if(cipher)
+    {
+        const LogEntryList encrypted = cipher->encryptMessages(entries);
+        return writeStored(encrypted);
+    }
+    return writeStored(entries);
+}
+
+/**
+ * @brief Writes entries as they are stored through the pooled or the shared connection.
+ * @param entries The log entries to write (messages already encrypted if enabled).
+ * @return True if the entries were written successfully, false otherwise.
+ */
+bool SQLogger::writeStored(const LogEntryList& entries)
+{
+    if(connectionPool)
+    {
+        return writePooled(entries);
+    }
+
+    std::scoped_lock lock(dbMutex);
+    const auto start = std::chrono::steady_clock::now();
+    const bool written = entries.size() == 1
+                         ? writer.writeLog(entries.front())
+                         : writer.writeLogBatch(entries);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    statsCounters.dbExecute.record(static_cast<uint64_t>(elapsed.count()));
+    countLostEntries();
+    return written;
+}
+
+/**
+ * @brief Writes entries to the database, or to the local spool if it is enabled and
+ * the write fails. While the spool holds entries, new entries are appended behind
+ * them without touching the database, so the order is kept and a failing backend
+ * (and its reconnect) stays off the logging path until the spool is replayed.
+ * With message encryption the spool holds the encrypted entries, as stored.
+ * @param entries The log entries to write.
+ * @return True if the entries were written or spooled, false otherwise.
+ */
+bool SQLogger::writeOrSpool(const LogEntryList& entries)
+{
+    if(!spool)
+    {
+        if(!writeEntries(entries))
+        {
+            LOG_INTERNAL_ERROR(entries.size() == 1 ? ERR_MSG_FAILED_QUERY : ERR_MSG_FAILED_BATCH_QUERY);
+            return false;
+        }
+        return true;
+    }
+
+    LogEntryList encrypted;
+    if(cipher)
+    {
+        encrypted = cipher->encryptMessages(entries);
+    }
+    const LogEntryList& stored = cipher ? encrypted : entries;
+
+    if(!spool->empty())
+    {
+        return spoolEntries(stored);
+    }
+
+    bool written = false;
+    try
+    {
+        written = writeStored(stored);
+    }
+    catch(const std::exception& e)
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_FAILED_BATCH_TASK + std::string(e.what()));
+    }
+
+    if(!written)
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_SPOOL_ENGAGED + spool->getPath());
+        return spoolEntries(stored);
+    }
+    return true;
+}
+
+/**
+ * @brief Appends entries to the local spool and wakes the spool drainer.
+ * @param entries The log entries to spool (messages already encrypted if enabled).
+ * @return True if the entries were spooled, false if the spool is full or failed.
+ */
+bool SQLogger::spoolEntries(const LogEntryList& entries)
+{
+    if(!spool->append(entries))
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_SPOOL_FULL + spool->getPath());
+        return false;
+    }
+
+    statsCounters.totalSpooled.fetch_add(entries.size(), std::memory_order_relaxed);
+
+    {
+        // Taken so the drainer cannot miss the wake-up between its check and its wait
+        std::lock_guard<std::mutex> lock(spoolMutex);
+    }
+    spoolCondition.notify_all();
+    return true;
+}
+
+/**
+ * @brief Replays the oldest spooled entries into the database.
+ * The entries are consumed only after they are written and committed.
+ * @param maxEntries Entries replayed in one batch.
+ * @return True if the entries were replayed, false if writing failed.
+ */
+bool SQLogger::replaySpool(const size_t maxEntries)
+{
+    try
+    {
+        LogEntryList entries;
+        if(spool->peek(entries, maxEntries) > 0)
+        {
+            // Spooled as stored, so not encrypted again
+            bool written = writeStored(entries);
+            if(written && !connectionPool)
+            {
+                std::lock_guard<std::mutex> lock(dbMutex);
+                written = writer.commitPending(true);
+                countLostEntries();
+            }
+            if(!written)
+            {
+                return false;
+            }
+        }
+
+        spool->consume();
+
+        statsCounters.totalReplayed.fetch_add(entries.size(), std::memory_order_relaxed);
+        return true;
+    }
+    catch(const std::exception& e)
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_SPOOL_REPLAY_FAILED + std::string(e.what()));
+        return false;
+    }
+}
+
+/**
+ * @brief Spool drainer thread body.
+ * Replays the spool in batches of the database's maximum batch size while it holds
+ * entries; a failed replay is retried after spoolRetryMs, doubled up to LOG_SPOOL_RETRY_MAX_MS.
+ */
+void SQLogger::spoolDrainerLoop()
+{
+    applyThreadSettings();
+
+    const auto retryMin = std::chrono::milliseconds(std::max(config.spoolRetryMs.value_or(LOG_DEFAULT_SPOOL_RETRY_MS), 1));
+    const auto retryMax = std::max(retryMin, std::chrono::milliseconds(LOG_SPOOL_RETRY_MAX_MS));
+    const int maxBatch = DataBaseHelper::getMaxBatchSize(config.databaseType.value_or(DataBaseType::Mock));
+    const size_t replayBatch = maxBatch > 0 ? static_cast<size_t>(maxBatch) : 1;
+    auto retry = retryMin;
+
+    std::unique_lock<std::mutex> lock(spoolMutex);
+    while(!spoolStop)
+    {
+        if(spool->empty())
+        {
+            spoolCondition.wait(lock, [this]
+            {
+                return spoolStop || !spool->empty();
+            });
+            continue;
+        }
+
+        lock.unlock();
+        const bool replayed = replaySpool(replayBatch);
+        lock.lock();
+
+        if(replayed)
+        {
+            retry = retryMin;
+            spoolCondition.notify_all();
+        }
+        else
+        {
+            spoolCondition.wait_for(lock, retry, [this]
+            {
+                return spoolStop;
+            });
+            retry = std::min(retry * 2, retryMax);
+        }
+    }
+}
+
+/**
+ * @brief Stops the spool drainer thread. Unreplayed entries stay in the spool file.
  */
-int SQLogger::getBatchSize() const
+void SQLogger::stopSpoolDrainer()
 {
-    return isBatchEnabled() ? config.batchSize.value() : 0;
+    {
+        std::lock_guard<std::mutex> lock(spoolMutex);
+        spoolStop = true;
+    }
+    spoolCondition.notify_all();
+    if(spoolDrainer.joinable())
+    {
+        spoolDrainer.join();
+    }
 }
 
+#ifdef SQLG_USE_SOURCE_INFO
 /**
- * @brief Sets the maximum batch size for buffered logging.
- * Updates the batch size configuration and ensures thread-safe operation:
- * 1. If reducing batch size, flushes current buffer if it exceeds new size
- * 2. If disabling batching (size=0), performs immediate flush
- * @param size New maximum batch size (0 to disable batching)
- * @throws std::invalid_argument If size is negative or bigger than DB_MAX_BATCH_
- * @see flush()
- * @see isBatchEnabled()
- * @see DataBaseHelper::getMaxBatchSize()
- * @see DB_MAX_BATCH_SQLITE, DB_MAX_BATCH_MYSQL, DB_MAX_BATCH_POSTGRESQL.
+ * @brief Registers the logger's source (constructor argument, Config::sourceUuid or a new default source).
+ * Uses one upsert where the database supports INSERT ... RETURNING. The caller holds dbMutex.
  */
-void SQLogger::setBatchSize(const int size)
+void SQLogger::registerSource()
 {
-    const int maxBatchSize = DataBaseHelper::getMaxBatchSize(database->getDatabaseType());
+    std::scoped_lock sourceLock(sourceMutex);
 
-    if(size > maxBatchSize || maxBatchSize == DB_BATCH_NOT_SUPPORTED)
+    std::string name = SOURCE_DEFAULT_NAME;
+    std::string uuid;
+    if(sourceInfo.has_value())
     {
-        throw std::invalid_argument("Batch size for selected database can't be negative or bigger than: " + maxBatchSize);
+        name = sourceInfo.value().name;
+        uuid = sourceInfo.value().uuid;
     }
-
-    if(size < 0)
+    else if(config.sourceUuid.has_value() && config.sourceName.has_value() && !config.sourceUuid->empty() && !config.sourceName->empty())
     {
-        throw std::invalid_argument("Batch size can't be negative");
+        name = config.sourceName.value();
+        uuid = config.sourceUuid.value();
     }
 
-    std::lock_guard<std::recursive_mutex> lock(batchMutex);
+    if(uuid.empty())
+    {
+        // Without a UUID every logger is a new source
+        uuid = LogHelper::generateUUID();
+    }
 
-    // Flush if: 1) Disabling batching, or 2) Shrinking below current buffer size
-    if((size == 0 && config.useBatch.value()) || (config.useBatch.value() && batchBuffer.size() > size))
+    auto registered = writer.registerSource(name, uuid);
+    if(registered.has_value())
     {
-        flushBatch();
+        sourceId = registered.value().sourceId;
+        sourceInfo = registered;
+        return;
     }
 
-    config.batchSize.value() = size;
-    config.useBatch.value() = (size > 0);
+    // Get existing source with uuid, or add a new one
+    auto storedSource = reader.getSourceByUuid(uuid);
+    if(storedSource.has_value() && storedSource.value().uuid == uuid)
+    {
+        sourceId = storedSource.value().sourceId;
+        sourceInfo = storedSource;
+    }
+    else
+    {
+        sourceId = writer.addSource(name, uuid);
+        sourceInfo = reader.getSourceById(sourceId);
+    }
 }
+#endif
 
 /**
- * @brief Forces immediate processing (writes to the database) of all batched log entries, if useBatch = true.
- * This method:
- * 1. Atomically moves all entries from the batch buffer to a local vector
- * 2. Processes them either:
- * - Synchronously (in current thread) if syncMode=true
- * - Asynchronously (via thread pool) if syncMode=false
- * @see Config
- * @see processBatch()
- * @see syncMode
+ * @brief Applies the configured affinity and priority to the calling logger thread.
+ * Failures are reported to the error log; the thread keeps running unpinned.
  */
-void SQLogger::flushBatch()
+void SQLogger::applyThreadSettings()
 {
-    if(batchBuffer.empty()) return;
-
-    std::vector<LogTask> currentBatch;
+    std::string errMsg;
+    if(!ThreadHelper::apply(LogConfig::getThreadSettings(config), errMsg))
     {
-        std::lock_guard<std::recursive_mutex> lock(batchMutex);
-        currentBatch.swap(batchBuffer);
+        LOG_INTERNAL_ERROR(ERR_MSG_THREAD_SETTINGS + errMsg);
     }
+}
 
-    if(config.syncMode.value())
+/**
+ * @brief Writes the queued entries of every sink and stops the sink threads.
+ */
+void SQLogger::stopSinks()
+{
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    if(const auto sinks = std::atomic_load( & sinkQueues))
     {
-        processBatch(currentBatch);
+        for(const auto & queue : * sinks)
+        {
+            queue->stop();
+        }
     }
-    else
+}
+
+/**
+ * @brief Waits until the local spool has been replayed into the database.
+ * @param timeout The maximum time to wait.
+ * @return True if the spool is empty (or disabled) within the timeout, false otherwise.
+ * @see LogConfig::Config::spoolPath
+ */
+bool SQLogger::waitForSpool(const std::chrono::milliseconds& timeout)
+{
+    if(!spool)
     {
-        threadPool.enqueue([this, currentBatch]
-        {
-            processBatch(currentBatch);
-        });
+        return true;
     }
+
+    std::unique_lock<std::mutex> lock(spoolMutex);
+    return spoolCondition.wait_for(lock, timeout, [this]
+    {
+        return spool->empty();
+    });
 }
 
 /**
  * @brief Converts an internal LogTask structure to a persistent LogEntry.
- * @param task The source LogTask containing raw logging information.
+ * @param task The source LogTask containing raw logging information (its strings are moved from).
  * @return LogEntry Log entry ready for storage.
  * @note Automatically generates timestamp and log level in string representation.
  * @warning The returned entry's ID field will be 0 until stored in database.
  * @warning Returned LogEntry not contain SourceInfo information.
  */
-LogEntry SQLogger::convertTaskToEntry(const LogTask& task) const
+LogEntry SQLogger::convertTaskToEntry(LogTask&& task) const
 {
-    std::string fileName = config.onlyFileNames.value()
-                           ? FSHelper::toFilename(task.file)
-                           : task.file;
-
+    // onlyFileNames is already applied by logAdd() and logEntries()
     std::string levelStr = levelToString(task.level);
-    std::string timestamp = getCurrentTimestamp();
+
+    // Capture time taken in logAdd(); text is only produced for the Text column format
+    const bool epochTimestamps = config.timestampFormat.value_or(TimestampFormat::Text) == TimestampFormat::EpochMicros;
+    std::string timestamp = epochTimestamps ? std::string() : formatTime(task.timestamp);
 
     LogEntry entry
     {
@@ -467,15 +1822,16 @@ LogEntry SQLogger::convertTaskToEntry(const LogTask& task) const
 #endif
         timestamp,
         levelStr,
-        task.message,
-        task.function,
-        task.file,
+        task.args.isActive() ? task.args.format(task.message) : std::move(task.message),
+        std::move(task.function),
+        std::move(task.file),
         task.line,
-        task.threadId
+        std::move(task.threadId)
 #ifdef SQLG_USE_SOURCE_INFO
         , "" // uuid (empty)
         , "" // sourceName (empty)
 #endif
+        , toEpochMicros(task.timestamp)
     };
 
     return entry;
@@ -483,6 +1839,9 @@ LogEntry SQLogger::convertTaskToEntry(const LogTask& task) const
 
 /**
 * @brief Logs an error message to the error log file.
+* The line is buffered and written by a background thread; repeated messages
+* and messages over the rate limit are reported as counts.
+* @see ErrorLog
 * @param errorMessage The error message to log.
 * @param function The function where the log message was created.
 * @param file The file where the log message was created.
@@ -494,25 +1853,7 @@ void SQLogger::logError(const std::string& errorMessage,
                         const int line
                        )
 {
-    std::lock_guard<std::mutex> lock(errorLogMutex);
-    if(FSHelper::needLogRotation(errorLogFile))
-    {
-        FSHelper::rotateLog(errorLogFile);
-    }
-
-    std::ofstream errorLog(errorLogFile, std::ios::app);
-    if(!errorLog.is_open())
-    {
-        std::cerr << ERR_MSG_FAILED_OPEN_ERR_LOG << errorLogFile << std::endl;
-        return;
-    }
-    errorLog << getCurrentTimestamp() << " [ERROR] "
-             << "\"" << errorMessage << "\""
-             << " " << function
-             << " " << file
-             << ":" << line
-             << std::endl;
-    errorLog.close();
+    errorLog.write(errorMessage, function, file, line);
 }
 
 /**
@@ -541,23 +1882,18 @@ void SQLogger::clearLogs(
  * @brief Updates statistics for a single log entry processing operation.
  * This method updates internal performance metrics when a single log entry
  * has been processed (written to database or exported).
- * @param processTimeMs The time taken to process the log entry in milliseconds.
+ * @param processTimeUs The time taken to process the log entry in microseconds.
  * @param success Whether the operation was successful (default: true).
  * If false, increments the failed entries counter.
  */
-void SQLogger::updateSingleEntryStats(const uint64_t processTimeMs,
+void SQLogger::updateSingleEntryStats(const uint64_t processTimeUs,
                                       const bool success)
 {
-    std::lock_guard<std::mutex> lock(statsMutex);
-
-    currentStats.totalLogged++;
-    if(!success) currentStats.totalFailed++;
+    statsCounters.totalLogged.fetch_add(1, std::memory_order_relaxed);
+    if(!success) statsCounters.totalFailed.fetch_add(1, std::memory_order_relaxed);
 
-    if(processTimeMs > currentStats.maxProcessTimeMs)
-    {
-        currentStats.maxProcessTimeMs = processTimeMs;
-    }
-    currentStats.totalProcessTimeMs += processTimeMs;
+    atomicStoreMax(statsCounters.maxProcessTimeUs, processTimeUs);
+    statsCounters.totalProcessTimeUs.fetch_add(processTimeUs, std::memory_order_relaxed);
 }
 
 /**
@@ -565,30 +1901,48 @@ void SQLogger::updateSingleEntryStats(const uint64_t processTimeMs,
  * Updates aggregated performance metrics when a batch of log entries
  * has been processed. Handles both successful and failed batch operations.
  * @param batchSize Number of log entries in the processed batch.
- * @param processTimeMs Total time taken to process the entire batch in milliseconds.
+ * @param processTimeUs Total time taken to process the entire batch in microseconds.
  * @param success Whether the batch operation succeeded (default: true).
  * If false, all entries in batch are counted as failed.
  */
 void SQLogger::updateBatchStats(const size_t batchSize,
-                                const uint64_t processTimeMs,
+                                const uint64_t processTimeUs,
                                 const bool success)
 {
-    std::lock_guard<std::mutex> lock(statsMutex);
+    statsCounters.totalLogged.fetch_add(batchSize, std::memory_order_relaxed);
+    if(!success) statsCounters.totalFailed.fetch_add(batchSize, std::memory_order_relaxed);
 
-    currentStats.totalLogged += batchSize;
-    if(!success) currentStats.totalFailed += batchSize;
+    atomicStoreMax(statsCounters.maxBatchSize, batchSize);
+    atomicStoreMin(statsCounters.minBatchSize, batchSize);
+    statsCounters.batchEntries.fetch_add(batchSize, std::memory_order_relaxed);
 
-    currentStats.maxBatchSize = std::max(currentStats.maxBatchSize, batchSize);
-
-    currentStats.minBatchSize = currentStats.flushCount == 0 ? batchSize : std::min(currentStats.minBatchSize, batchSize);
+    atomicStoreMax(statsCounters.maxProcessTimeUs, processTimeUs);
+    statsCounters.totalProcessTimeUs.fetch_add(processTimeUs, std::memory_order_relaxed);
+    statsCounters.flushCount.fetch_add(1, std::memory_order_relaxed);
+}
 
-    currentStats.avgBatchSize = (currentStats.avgBatchSize* currentStats.flushCount + batchSize) /
-                                (currentStats.flushCount + 1);
+/**
+ * @brief Records that a writer took a task: its queue wait, and the lower queue depth.
+ * @param task The log task.
+ * @param taken The time the writer took the task.
+ */
+void SQLogger::recordTaken(const LogTask& task, const std::chrono::steady_clock::time_point& taken)
+{
+    statsCounters.queueDepth.fetch_sub(1, std::memory_order_relaxed);
 
-    currentStats.maxProcessTimeMs = std::max(currentStats.maxProcessTimeMs, processTimeMs);
+    const auto wait = std::chrono::duration_cast<std::chrono::microseconds>(taken - task.enqueued);
+    statsCounters.queueWait.record(static_cast<uint64_t>(std::max<int64_t>(wait.count(), 0)));
+}
 
-    currentStats.totalProcessTimeMs += processTimeMs;
-    currentStats.flushCount++;
+/**
+ * @brief Records the end-to-end latency of a written task.
+ * @param task The log task.
+ * @param written The time the task was written.
+ */
+void SQLogger::recordWritten(const LogTask& task, const std::chrono::system_clock::time_point& written)
+{
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(written - task.timestamp);
+    statsCounters.endToEnd.record(static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0)));
 }
 
 /**
@@ -597,22 +1951,97 @@ void SQLogger::updateBatchStats(const size_t batchSize,
  */
 SQLogger::Stats SQLogger::getStats() const
 {
-    std::lock_guard<std::mutex> lock(statsMutex);
-    return currentStats;
+    Stats stats;
+    stats.totalLogged = statsCounters.totalLogged.load(std::memory_order_relaxed);
+    stats.totalFailed = statsCounters.totalFailed.load(std::memory_order_relaxed);
+    stats.totalDropped = ringDropped;
+    stats.totalSpooled = statsCounters.totalSpooled.load(std::memory_order_relaxed);
+    stats.totalReplayed = statsCounters.totalReplayed.load(std::memory_order_relaxed);
+    if(throttle)
+    {
+        const LogThrottle::Stats throttleStats = throttle->getStats();
+        stats.totalSampled = throttleStats.sampled;
+        stats.totalRateLimited = throttleStats.rateLimited;
+        stats.totalRepeated = throttleStats.repeated;
+    }
+    if(const auto sinks = std::atomic_load( & sinkQueues))
+    {
+        for(const auto & queue : * sinks)
+        {
+            const auto sinkStats = queue->getStats();
+            stats.totalSinkWritten += sinkStats.written;
+            stats.totalSinkDropped += sinkStats.dropped;
+        }
+    }
+    if(tailCache)
+    {
+        stats.tailCacheHits = tailCache->getHits();
+        stats.tailCacheMisses = tailCache->getMisses();
+    }
+
+    stats.flushCount = statsCounters.flushCount.load(std::memory_order_relaxed);
+    stats.maxBatchSize = statsCounters.maxBatchSize.load(std::memory_order_relaxed);
+    stats.minBatchSize = stats.flushCount > 0 ? statsCounters.minBatchSize.load(std::memory_order_relaxed) : 0;
+    stats.avgBatchSize = stats.flushCount > 0
+                         ? static_cast<double>(statsCounters.batchEntries.load(std::memory_order_relaxed)) / stats.flushCount
+                         : 0.0;
+
+    stats.maxProcessTimeUs = statsCounters.maxProcessTimeUs.load(std::memory_order_relaxed);
+    stats.totalProcessTimeUs = statsCounters.totalProcessTimeUs.load(std::memory_order_relaxed);
+    stats.maxProcessTimeMs = stats.maxProcessTimeUs / 1000;
+    stats.totalProcessTimeMs = stats.totalProcessTimeUs / 1000;
+
+    stats.queueDepth = statsCounters.queueDepth.load(std::memory_order_relaxed);
+    stats.maxQueueDepth = statsCounters.maxQueueDepth.load(std::memory_order_relaxed);
+    stats.enqueueLatency = statsCounters.enqueueLatency.snapshot();
+    stats.queueWait = statsCounters.queueWait.snapshot();
+    stats.dbExecute = statsCounters.dbExecute.snapshot();
+    stats.endToEnd = statsCounters.endToEnd.snapshot();
+    return stats;
 }
 
 /**
  * @brief Resets all logging statistics to zero.
- * Atomically clears all accumulated performance metrics including:
+ * Clears all accumulated performance metrics including:
  * - Total logged/failed entries
  * - Batch processing statistics
  * - Timing measurements
+ * The queue depth is a gauge and is kept (maxQueueDepth restarts from it).
  * @see getStats()
  */
 void SQLogger::resetStats()
 {
-    std::lock_guard<std::mutex> lock(statsMutex);
-    currentStats = {};
+    statsCounters.totalLogged = 0;
+    statsCounters.totalFailed = 0;
+    statsCounters.totalSpooled = 0;
+    statsCounters.totalReplayed = 0;
+    statsCounters.batchEntries = 0;
+    statsCounters.maxBatchSize = 0;
+    statsCounters.minBatchSize = UINT64_MAX;
+    statsCounters.flushCount = 0;
+    statsCounters.totalProcessTimeUs = 0;
+    statsCounters.maxProcessTimeUs = 0;
+    statsCounters.maxQueueDepth = statsCounters.queueDepth.load();
+    statsCounters.enqueueLatency.reset();
+    statsCounters.queueWait.reset();
+    statsCounters.dbExecute.reset();
+    statsCounters.endToEnd.reset();
+    ringDropped = 0;
+    if(throttle)
+    {
+        throttle->resetStats();
+    }
+    if(const auto sinks = std::atomic_load( & sinkQueues))
+    {
+        for(const auto & queue : * sinks)
+        {
+            queue->resetStats();
+        }
+    }
+    if(tailCache)
+    {
+        tailCache->resetCounters();
+    }
 }
 
 /**
@@ -634,14 +2063,48 @@ std::string SQLogger::getFormattedStats(const Stats stats)
        << "[Entries]" << std::endl
        << "Total entries: " << stats.totalLogged << "" << std::endl
        << "Failed entries: " << stats.totalFailed << "" << std::endl
+       << "Dropped entries: " << stats.totalDropped << "" << std::endl
+       << "Spooled entries: " << stats.totalSpooled << "" << std::endl
+       << "Replayed entries: " << stats.totalReplayed << "" << std::endl
+       << "Sampled out entries: " << stats.totalSampled << "" << std::endl
+       << "Rate limited entries: " << stats.totalRateLimited << "" << std::endl
+       << "Repeated entries: " << stats.totalRepeated << "" << std::endl
+       << "[Sinks]" << std::endl
+       << "Written entries: " << stats.totalSinkWritten << "" << std::endl
+       << "Dropped entries: " << stats.totalSinkDropped << "" << std::endl
+       << "[Tail cache]" << std::endl
+       << "Hits: " << stats.tailCacheHits << "" << std::endl
+       << "Misses: " << stats.tailCacheMisses << "" << std::endl
        << "[Batch statistics]" << std::endl
        << "Max size: " << stats.maxBatchSize << "" << std::endl
        << "Min size: " << stats.minBatchSize << "" << std::endl
        << "Avg size: " << std::fixed << std::setprecision(2) << stats.avgBatchSize << "" << std::endl
        << "Flush operations: " << stats.flushCount << "" << std::endl
        << "[Performance]" << std::endl
-       << "Max process time: " << stats.maxProcessTimeMs << " ms" << std::endl
-       << "Avg process time: " << stats.avgProcessTime() << " ms" << std::endl;
+       << "Max process time: " << stats.maxProcessTimeUs << " us" << std::endl
+       << "Avg process time: " << stats.avgProcessTime() << " ms" << std::endl
+       << "[Queue]" << std::endl
+       << "Depth: " << stats.queueDepth << "" << std::endl
+       << "Max depth: " << stats.maxQueueDepth << "" << std::endl
+       << "[Latency]" << std::endl;
+
+    const std::pair<const char*, const LatencyHistogram::Snapshot*> histograms[] =
+    {
+        { "Enqueue", & stats.enqueueLatency },
+        { "Queue wait", & stats.queueWait },
+        { "DB execute", & stats.dbExecute },
+        { "End to end", & stats.endToEnd }
+    };
+    for(const auto & histogram : histograms)
+    {
+        const LatencyHistogram::Snapshot& snapshot = * histogram.second;
+        ss << histogram.first << ": "
+           << "p50 " << snapshot.percentileUs(50.0) << " us, "
+           << "p99 " << snapshot.percentileUs(99.0) << " us, "
+           << "p99.9 " << snapshot.percentileUs(99.9) << " us, "
+           << "max " << snapshot.maxUs << " us "
+           << "(" << snapshot.count << ")" << std::endl;
+    }
     return ss.str();
 }
 
@@ -658,12 +2121,15 @@ std::string SQLogger::getFormattedStats(const Stats stats)
 */
 std::string SQLogger::getFormattedStats() const
 {
-    std::lock_guard<std::mutex> lock(statsMutex);
-    return SQLogger::getFormattedStats(currentStats);
+    return SQLogger::getFormattedStats(getStats());
 }
 
 /**
 * @brief Retrieves log entries from the database matching specified filters.
+* With LogConfig::Config::tailCacheSize set, queries with a recent lower timestamp
+* bound are answered from the tail cache without the database.
+* With LogConfig::Config::readPoolSize set, the query runs on a separate connection
+* and does not block logging.
 *
 * @param filters Vector of Filter objects defining search criteria.
 *        Each filter specifies:
@@ -681,6 +2147,7 @@ std::string SQLogger::getFormattedStats() const
 *        - Requires positive limit to take effect
 *
 * @return LogEntryList List of log entries ordered by timestamp (descending).
+* @see LogTailCache
 */
 LogEntryList SQLogger::getLogsByFilters(const std::vector<Filter> & filters,
                                         const int limit,
@@ -690,8 +2157,264 @@ LogEntryList SQLogger::getLogsByFilters(const std::vector<Filter> & filters,
     {
         LOG_INTERNAL_ERROR(ERR_MSG_TIMEOUT_TASK_QUEUE);
     }
-    std::scoped_lock lock(logMutex, dbMutex);
-    return reader.getLogsByFilters(filters, limit, offset);
+
+    if(tailCache)
+    {
+        // Recent entries are answered without the database locks
+        auto cached = tailCache->find(filters, limit, offset);
+        if(cached.has_value())
+        {
+            return std::move(cached.value());
+        }
+    }
+
+    return withReader([ & ](LogReader & logReader)
+    {
+        return logReader.getLogsByFilters(filters, limit, offset);
+    });
+}
+
+/**
+* @brief Runs getLogsByFilters() on the query threads without blocking the caller.
+* With LogConfig::Config::readPoolSize set there is one query thread per read connection,
+* so independent queries run concurrently; otherwise one thread serializes them on the
+* write connection.
+* @param filters Vector of Filter objects defining search criteria.
+* @param limit Maximum number of log entries to return (-1 = no limit).
+* @param offset Number of log entries to skip (-1 = disabled).
+* @return std::future<LogEntryList> Entries, or the query's exception
+*         (std::runtime_error once the logger is shut down).
+*/
+std::future<LogEntryList> SQLogger::getLogsByFiltersAsync(const std::vector<Filter> & filters,
+        const int limit,
+        const int offset)
+{
+    auto promise = std::make_shared<std::promise<LogEntryList>>();
+    std::future<LogEntryList> result = promise->get_future();
+    const bool queued = enqueueQuery([this, promise, filters, limit, offset]()
+    {
+        try
+        {
+            promise->set_value(getLogsByFilters(filters, limit, offset));
+        }
+        catch(...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    if(!queued)
+    {
+        promise->set_exception(std::make_exception_ptr(std::runtime_error(ERR_MSG_QUERY_AFTER_SHUTDOWN)));
+    }
+    return result;
+}
+
+/**
+* @brief Runs getLogsByFilters() on the query threads and passes the result to a callback
+* (the callback style of ITransport::LogPullHandler).
+* The callback runs on a query thread; a failed query is reported to the error log and
+* passes an empty list.
+* @param filters Vector of Filter objects defining search criteria.
+* @param limit Maximum number of log entries to return (-1 = no limit).
+* @param offset Number of log entries to skip (-1 = disabled).
+* @param callback Receives the entries.
+*/
+void SQLogger::getLogsByFiltersAsync(const std::vector<Filter> & filters,
+                                     const int limit,
+                                     const int offset,
+                                     std::function<void(LogEntryList)> callback)
+{
+    auto shared = std::make_shared<std::function<void(LogEntryList)>>(std::move(callback));
+    const bool queued = enqueueQuery([this, shared, filters, limit, offset]()
+    {
+        LogEntryList entries;
+        try
+        {
+            entries = getLogsByFilters(filters, limit, offset);
+        }
+        catch(const std::exception& e)
+        {
+            LOG_INTERNAL_ERROR(e.what());
+        }
+        ( * shared)(std::move(entries));
+    });
+    if(!queued)
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_QUERY_AFTER_SHUTDOWN);
+        ( * shared)(LogEntryList());
+    }
+}
+
+/**
+ * @brief Queues a task on the query threads, starting them on first use.
+ * @param task The task to run.
+ * @return bool False if the logger is shut down (the task is not run).
+ */
+bool SQLogger::enqueueQuery(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(queryPoolMutex);
+    if(queryPoolStopped)
+    {
+        return false;
+    }
+    if(!queryPool)
+    {
+        queryPool = std::make_unique<ThreadPool>(queryThreads);
+    }
+    queryPool->enqueue(std::move(task));
+    return true;
+}
+
+/**
+* @brief Retrieves log entries whose message contains all of the given words.
+* Shortcut for a FILTER_OP_MATCH filter on the message column, which can be combined
+* with other filters in getLogsByFilters(). With LogConfig::Config::fullTextSearch set
+* the words are looked up in the full-text index (whole words, case insensitive),
+* otherwise every word is matched as a substring with LIKE.
+* @param text Search words separated by whitespace (no words = all entries).
+* @param limit Maximum number of log entries to return (-1 = no limit).
+* @param offset Number of log entries to skip (-1 = disabled), requires positive limit.
+* @return LogEntryList List of log entries ordered by timestamp (descending).
+*/
+LogEntryList SQLogger::searchLogs(const std::string& text,
+                                  const int limit,
+                                  const int offset)
+{
+    return getLogsByFilters({ { Filter::Type::Unknown, FIELD_LOG_MESSAGE, FILTER_OP_MATCH, text } }, limit, offset);
+}
+
+/**
+* @brief Counts the log entries matching the filters per value of a column.
+* The database groups and counts the rows (GROUP BY), only the counts are transferred.
+* @param field Log table column, e.g. FIELD_LOG_LEVEL or FIELD_LOG_FILE.
+* @param filters Filters, combined with AND.
+* @return LogCounts Number of entries per value (NULL values are counted under "").
+* @throws std::invalid_argument If the field or a filter op is invalid.
+*/
+LogCounts SQLogger::countBy(const std::string& field, const std::vector<Filter> & filters)
+{
+    if(!waitUntilEmpty())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_TIMEOUT_TASK_QUEUE);
+    }
+
+    return withReader([ & ](LogReader & logReader)
+    {
+        return logReader.countBy(field, filters);
+    });
+}
+
+/**
+* @brief Counts the log entries matching the filters per time bucket.
+* @param bucketSeconds Bucket width in seconds (e.g. 60 for entries per minute),
+*        buckets are aligned to multiples of it.
+* @param filters Filters, combined with AND.
+* @return LogCounts Number of entries per bucket start (TIMESTAMP_FMT local time), empty buckets are omitted.
+* @throws std::invalid_argument If the bucket width or a filter op is invalid.
+*/
+LogCounts SQLogger::histogram(const int bucketSeconds, const std::vector<Filter> & filters)
+{
+    if(!waitUntilEmpty())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_TIMEOUT_TASK_QUEUE);
+    }
+
+    return withReader([ & ](LogReader & logReader)
+    {
+        return logReader.histogram(bucketSeconds, filters);
+    });
+}
+
+/**
+* @brief Counts the log entries matching the filters per time bucket and value of a column,
+* e.g. errors per minute per source.
+* @param field Log table column, e.g. FIELD_LOG_SOURCES_ID.
+* @param bucketSeconds Bucket width in seconds, buckets are aligned to multiples of it.
+* @param filters Filters, combined with AND.
+* @return LogHistogram Number of entries per bucket start (TIMESTAMP_FMT local time) and value.
+* @throws std::invalid_argument If the field, the bucket width or a filter op is invalid.
+*/
+LogHistogram SQLogger::histogramBy(const std::string& field, const int bucketSeconds, const std::vector<Filter> & filters)
+{
+    if(!waitUntilEmpty())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_TIMEOUT_TASK_QUEUE);
+    }
+
+    return withReader([ & ](LogReader & logReader)
+    {
+        return logReader.histogramBy(field, bucketSeconds, filters);
+    });
+}
+
+/**
+* @brief Streams log entries matching the filters to a callback, ordered by ID.
+* Memory use is constant regardless of the number of matching entries.
+* @param filters Vector of Filter objects defining search criteria.
+* @param callback Function called for each entry; return false to stop the scan.
+* @param pageSize Rows per keyset page (WHERE id > last ORDER BY id LIMIT pageSize).
+*        - 0 streams everything with a single query (default); without LogConfig::Config::readPoolSize
+*        the callback runs with the database lock held and must not log to or query this logger
+*        - Positive values read a page, release the database lock and then pass the page to the
+*        callback, so logging is not blocked and the callback may log (memory use grows with pageSize)
+*        (with LogConfig::Config::readPoolSize set logging is never blocked by the scan)
+* @param afterId Only entries with an ID greater than this are visited (resume point).
+* @return size_t Number of entries passed to the callback.
+* @throws std::runtime_error If a query fails.
+*/
+size_t SQLogger::forEachLog(const std::vector<Filter> & filters,
+                            const LogCallback& callback,
+                            const int pageSize,
+                            const int64_t afterId)
+{
+    if(!waitUntilEmpty())
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_TIMEOUT_TASK_QUEUE);
+    }
+
+    if(pageSize <= 0)
+    {
+        return withReader([ & ](LogReader & logReader)
+        {
+            return logReader.forEachLog(filters, callback, 0, afterId);
+        });
+    }
+
+    size_t visited = 0;
+    int64_t lastId = afterId;
+    LogEntryList page;
+    page.reserve(static_cast<size_t>(pageSize));
+
+    while(true)
+    {
+        page.clear();
+        withReader([ & ](LogReader & logReader)
+        {
+            return logReader.forEachLog(filters, [ & ](const LogEntry & entry)
+            {
+                page.push_back(entry);
+                return page.size() < static_cast<size_t>(pageSize);
+            }, pageSize, lastId);
+        });
+
+        // Outside the database lock, so the callback may log
+        for(const auto & entry : page)
+        {
+            lastId = entry.id;
+            ++visited;
+            if(!callback(entry))
+            {
+                return visited;
+            }
+        }
+
+        if(page.size() < static_cast<size_t>(pageSize))
+        {
+            break;
+        }
+    }
+
+    return visited;
 }
 
 /**
@@ -814,7 +2537,9 @@ LogEntryList SQLogger::getLogsByFunction(const std::string& function,
  */
 void SQLogger::setLogLevel(LogLevel minLevel)
 {
-    config.minLogLevel.value() = minLevel;
+    std::lock_guard<std::mutex> lock(configMutex);
+    config.minLogLevel = minLevel;
+    this->minLevel.store(minLevel, std::memory_order_relaxed);
 }
 
 /**
@@ -824,7 +2549,7 @@ void SQLogger::setLogLevel(LogLevel minLevel)
  */
 LogLevel SQLogger::getMinLogLevel() const
 {
-    return config.minLogLevel.value();
+    return minLevel.load(std::memory_order_relaxed);
 }
 
 /**
@@ -919,6 +2644,39 @@ int SQLogger::addSource(const std::string& name, const std::string& uuid)
 }
 #endif
 
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+* @brief Gets the ID of a source by UUID, adding the source if it is new.
+* Unlike addSource(), the logger's own source is not changed (used for remote senders).
+* @param name The name of the source.
+* @param uuid The UUID of the source.
+* @return The source ID, or SOURCE_NOT_FOUND if the source could not be added.
+*/
+int SQLogger::findOrAddSource(const std::string& name, const std::string& uuid)
+{
+    std::scoped_lock Lock(dbMutex, sourceMutex);
+
+    auto registered = writer.registerSource(name, uuid);
+    if(registered.has_value())
+    {
+        return registered.value().sourceId;
+    }
+
+    auto storedSource = reader.getSourceByUuid(uuid);
+    if(storedSource.has_value())
+    {
+        return storedSource.value().sourceId;
+    }
+
+    const int id = writer.addSource(name, uuid);
+    if(id == SOURCE_NOT_FOUND)
+    {
+        LOG_INTERNAL_ERROR(ERR_MSG_FAILED_TO_ADD_SOURCE + name);
+    }
+    return id;
+}
+#endif
+
 #ifdef SQLG_USE_SOURCE_INFO
 /**
  * @brief Retrieves a source by its source ID.
@@ -0,0 +1,1381 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include "sqlogger/transport/backends/grpc_transport.h"
+#include "sqlogger/transport/transport_batcher.h"
+#include "sqlogger/internal/log_binary.h"
+#include "sqlogger/internal/log_serializer.h"
+
+namespace
+{
+    /**
+     * @brief Copies bytes into a gRPC buffer.
+     * @param data Bytes to send.
+     * @return grpc::ByteBuffer Buffer.
+     */
+    grpc::ByteBuffer toBuffer(const std::string& data)
+    {
+        grpc::Slice slice(data);
+        return grpc::ByteBuffer(& slice, 1);
+    }
+
+    /**
+     * @brief Copies a received gRPC buffer into a string.
+     * @param buffer Received buffer.
+     * @return std::string Bytes (empty if the buffer cannot be read).
+     */
+    std::string toString(const grpc::ByteBuffer& buffer)
+    {
+        std::string data;
+        std::vector<grpc::Slice> slices;
+        if(!buffer.Dump(& slices).ok())
+        {
+            return data;
+        }
+        data.reserve(buffer.Length());
+        for(const auto & slice : slices)
+        {
+            data.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+        }
+        return data;
+    }
+
+    /**
+     * @brief Appends a zigzag LEB128 varint.
+     * @param out Buffer to append to.
+     * @param value Value.
+     */
+    void appendVarint(std::string& out, const int64_t value)
+    {
+        uint64_t raw = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        while(raw >= 0x80)
+        {
+            out += static_cast<char>((raw & 0x7F) | 0x80);
+            raw >>= 7;
+        }
+        out += static_cast<char>(raw);
+    }
+
+    /**
+     * @brief Reads a zigzag LEB128 varint.
+     * @param data Encoded data.
+     * @param pos Read position, advanced past the value.
+     * @return int64_t Value.
+     * @throws std::runtime_error If the data ends inside the value.
+     */
+    int64_t readVarint(const std::string& data, size_t& pos)
+    {
+        uint64_t raw = 0;
+        for(int shift = 0; shift < 64; shift += 7)
+        {
+            if(pos >= data.size())
+            {
+                break;
+            }
+            const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+            raw |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if((byte & 0x80) == 0)
+            {
+                return static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+            }
+        }
+        throw std::runtime_error(ERR_MSG_TRANSPORT_INVALID_REQUEST);
+    }
+
+    /**
+     * @brief Encodes a PullLogs query: limit, offset, then the filters as JSON.
+     * @param filters Filters.
+     * @param limit Maximum number of entries.
+     * @param offset Pagination offset.
+     * @return std::string Encoded query.
+     */
+    std::string encodePullRequest(const std::vector<Filter> & filters, const int limit, const int offset)
+    {
+        std::string out;
+        appendVarint(out, limit);
+        appendVarint(out, offset);
+        out += LogSerializer::Json::serializeFilters(filters);
+        return out;
+    }
+
+    /**
+     * @brief Decodes a PullLogs query.
+     * @param data Encoded query.
+     * @param filters Receives the filters.
+     * @param limit Receives the limit.
+     * @param offset Receives the offset.
+     * @throws std::runtime_error If the query is malformed.
+     */
+    void decodePullRequest(const std::string& data, std::vector<Filter> & filters, int& limit, int& offset)
+    {
+        size_t pos = 0;
+        limit = static_cast<int>(readVarint(data, pos));
+        offset = static_cast<int>(readVarint(data, pos));
+        filters = LogSerializer::Json::parseFilters(data.substr(pos));
+    }
+
+    /**
+     * @brief Encodes logger statistics as varints.
+     * @param stats Statistics.
+     * @return std::string Encoded statistics.
+     */
+    std::string encodeStats(const SQLogger::Stats& stats)
+    {
+        int64_t avgBatchSize = 0;
+        std::memcpy(& avgBatchSize, & stats.avgBatchSize, sizeof(avgBatchSize));
+
+        std::string out;
+        appendVarint(out, static_cast<int64_t>(stats.totalLogged));
+        appendVarint(out, static_cast<int64_t>(stats.totalFailed));
+        appendVarint(out, static_cast<int64_t>(stats.totalDropped));
+        appendVarint(out, static_cast<int64_t>(stats.maxBatchSize));
+        appendVarint(out, static_cast<int64_t>(stats.minBatchSize));
+        appendVarint(out, avgBatchSize);
+        appendVarint(out, static_cast<int64_t>(stats.maxProcessTimeMs));
+        appendVarint(out, static_cast<int64_t>(stats.totalProcessTimeMs));
+        appendVarint(out, static_cast<int64_t>(stats.flushCount));
+        return out;
+    }
+
+    /**
+     * @brief Decodes logger statistics.
+     * @param data Encoded statistics.
+     * @return SQLogger::Stats Statistics.
+     * @throws std::runtime_error If the data is malformed.
+     */
+    SQLogger::Stats decodeStats(const std::string& data)
+    {
+        size_t pos = 0;
+        SQLogger::Stats stats;
+        stats.totalLogged = static_cast<uint64_t>(readVarint(data, pos));
+        stats.totalFailed = static_cast<uint64_t>(readVarint(data, pos));
+        stats.totalDropped = static_cast<uint64_t>(readVarint(data, pos));
+        stats.maxBatchSize = static_cast<uint64_t>(readVarint(data, pos));
+        stats.minBatchSize = static_cast<uint64_t>(readVarint(data, pos));
+        const int64_t avgBatchSize = readVarint(data, pos);
+        std::memcpy(& stats.avgBatchSize, & avgBatchSize, sizeof(avgBatchSize));
+        stats.maxProcessTimeMs = static_cast<uint64_t>(readVarint(data, pos));
+        stats.totalProcessTimeMs = static_cast<uint64_t>(readVarint(data, pos));
+        stats.flushCount = static_cast<uint32_t>(readVarint(data, pos));
+        return stats;
+    }
+}
+
+/**
+ * @struct GrpcTransport::Impl
+ * @brief Channel, push stream, server and handlers of a GrpcTransport.
+ */
+struct GrpcTransport::Impl
+{
+    class PushStream;
+    class PullCall;
+    class PushReactor;
+    class PullReactor;
+    class StatsReactor;
+    class LogService;
+
+    /**
+     * @brief Constructs the state from the [Transport] settings.
+     * @param config Configuration.
+     */
+    explicit Impl(const LogConfig::Config& config);
+
+    /**
+     * @brief Closes the push stream, stops the server and waits for pending calls.
+     */
+    ~Impl();
+
+    /**
+     * @brief Calls the error handler, if any.
+     * @param message Error message.
+     */
+    void reportError(const std::string& message);
+
+    /**
+     * @brief Gets the client stub, creating the channel on first use.
+     * @return grpc::GenericStub* Stub, or nullptr if no endpoint is configured (clientMutex held).
+     */
+    grpc::GenericStub* getStub();
+
+    /**
+     * @brief Gets the push stream, opening a new one if there is none or the last one failed.
+     * @return std::shared_ptr<PushStream> Stream, or nullptr if no endpoint is configured.
+     */
+    std::shared_ptr<PushStream> getStream();
+
+    /**
+     * @brief Closes the push stream after its batches are acknowledged.
+     */
+    void closeStream();
+
+    /**
+     * @brief Stops the server, cancelling calls still running after the grace period.
+     */
+    void stopServer();
+
+    /**
+     * @brief Passes a received batch to the batch handler (or to the per-entry handler).
+     * @param entries Received entries.
+     * @param callback Called once with the status of the batch.
+     */
+    void dispatchBatch(const LogEntryList& entries, std::function<void(bool)> callback);
+
+    /**
+     * @brief Registers an outstanding client call (pull or stats).
+     */
+    void beginCall();
+
+    /**
+     * @brief Unregisters an outstanding client call.
+     */
+    void endCall();
+
+    std::string target; /**< host:port of the server to push to. */
+    size_t maxInFlight; /**< Unacknowledged batches per push stream. */
+
+    mutable std::mutex handlerMutex; /**< Guards the handlers. */
+    LogPushHandler pushHandler; /**< Per-entry push handler. */
+    LogBatchPushHandler batchPushHandler; /**< Batch push handler. */
+    LogPullHandler pullHandler; /**< Pull handler. */
+    ConfigHandler configHandler; /**< Configuration handler (no wire method yet). */
+    ErrorHandler errorHandler; /**< Error handler. */
+    StatsHandler statsHandler; /**< Statistics handler. */
+
+    std::mutex clientMutex; /**< Guards channel, stub and stream. */
+    std::shared_ptr<grpc::Channel> channel; /**< Client channel. */
+    std::unique_ptr<grpc::GenericStub> stub; /**< Client stub. */
+    std::shared_ptr<PushStream> stream; /**< Current push stream. */
+
+    std::mutex callMutex; /**< Guards calls. */
+    std::condition_variable callCv; /**< Signals finished calls. */
+    size_t calls = 0; /**< Outstanding pull and stats calls. */
+
+    mutable std::mutex serverMutex; /**< Guards service, server and port. */
+    std::unique_ptr<LogService> service; /**< Generic service of the server. */
+    std::unique_ptr<grpc::Server> server; /**< Running server. */
+    int port = 0; /**< Bound port. */
+
+    std::atomic<uint64_t> bytesSent{ 0 }; /**< Payload bytes sent. */
+    std::atomic<uint64_t> bytesReceived{ 0 }; /**< Payload bytes received. */
+    std::atomic<uint32_t> activeConnections{ 0 }; /**< Open server push streams. */
+};
+
+/**
+ * @class GrpcTransport::Impl::PushStream
+ * @brief Client side of the PushLogs stream: one write at a time, acks matched in order.
+ */
+class GrpcTransport::Impl::PushStream : public grpc::ClientBidiReactor<grpc::ByteBuffer, grpc::ByteBuffer>
+{
+    public:
+        /**
+         * @brief Opens the stream.
+         * @param impl Owning transport state.
+         * @param stub Client stub.
+         */
+        PushStream(Impl& impl, grpc::GenericStub& stub) : impl(impl)
+        {
+            stub.PrepareBidiStreamingCall(& context, GRPC_TRANSPORT_METHOD_PUSH_LOGS, grpc::StubOptions(), this);
+            AddHold(); // writes start outside reactions; released when reading ends
+            StartRead(& response);
+            StartCall();
+        }
+
+        /**
+         * @brief Sends a batch, blocking while maxInFlight batches are unacknowledged.
+         * @param batch Encoded batch.
+         * @param callback Called with the ack of the batch (false if the stream fails).
+         */
+        void send(const std::string& batch, std::function<void(bool)> callback)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]()
+            {
+                return failed || closing || acks.size() < impl.maxInFlight;
+            });
+            if(failed || closing)
+            {
+                lock.unlock();
+                callback(false);
+                return;
+            }
+
+            acks.push_back(std::move(callback));
+            impl.bytesSent += batch.size();
+            queue.push_back(toBuffer(batch));
+            if(writing)
+            {
+                return; // OnWriteDone() sends it
+            }
+            writing = true;
+            current = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            StartWrite(& current);
+        }
+
+        /**
+         * @brief Checks if the stream can no longer send.
+         * @return bool True if the stream failed or is closing.
+         */
+        bool isFailed()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return failed || closing;
+        }
+
+        /**
+         * @brief Half-closes the stream and waits until the server acknowledged every batch.
+         * The call is cancelled if this takes longer than GRPC_TRANSPORT_STOP_TIMEOUT_MSEC.
+         */
+        void close()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            const bool first = !closing;
+            closing = true;
+            cv.notify_all();
+            const bool idle = first && !writing && !failed;
+            if(idle)
+            {
+                writesDone = true;
+                lock.unlock();
+                StartWritesDone();
+                lock.lock();
+            }
+            const auto isDone = [this]()
+            {
+                return done;
+            };
+            if(!cv.wait_for(lock, std::chrono::milliseconds(GRPC_TRANSPORT_STOP_TIMEOUT_MSEC), isDone))
+            {
+                lock.unlock();
+                context.TryCancel();
+                lock.lock();
+                cv.wait(lock, isDone);
+            }
+        }
+
+        void OnWriteDone(bool ok) override
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if(ok && !queue.empty())
+            {
+                current = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+                StartWrite(& current);
+                return;
+            }
+            writing = false;
+            if(ok && closing && !writesDone)
+            {
+                writesDone = true;
+                lock.unlock();
+                StartWritesDone();
+            }
+        }
+
+        void OnReadDone(bool ok) override
+        {
+            if(ok)
+            {
+                const std::string ack = toString(response);
+                impl.bytesReceived += ack.size();
+                std::function<void(bool)> callback;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!acks.empty())
+                    {
+                        callback = std::move(acks.front());
+                        acks.pop_front();
+                    }
+                    cv.notify_all();
+                }
+                if(callback)
+                {
+                    callback(!ack.empty() && ack[0] == 1);
+                }
+                StartRead(& response);
+                return;
+            }
+
+            // The server finished the stream or the connection failed
+            std::deque<std::function<void(bool)>> lost;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+                lost.swap(acks);
+                cv.notify_all();
+            }
+            for(auto & callback : lost)
+            {
+                callback(false);
+            }
+            RemoveHold();
+        }
+
+        void OnDone(const grpc::Status& status) override
+        {
+            bool closed = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = closing;
+            }
+            if(!status.ok() && !(closed && status.error_code() == grpc::StatusCode::CANCELLED))
+            {
+                impl.reportError(ERR_MSG_TRANSPORT_CALL_FAILED + status.error_message());
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            done = true;
+            cv.notify_all(); // under the lock: close() may destroy the stream right after
+        }
+
+    private:
+        Impl& impl; /**< Owning transport state. */
+        grpc::ClientContext context; /**< Call context. */
+        grpc::ByteBuffer current; /**< Batch being written. */
+        grpc::ByteBuffer response; /**< Ack being read. */
+
+        std::mutex mutex; /**< Guards the members below. */
+        std::condition_variable cv; /**< Signals acks, failure and completion. */
+        std::deque<grpc::ByteBuffer> queue; /**< Batches waiting for the writer. */
+        std::deque<std::function<void(bool)>> acks; /**< Callbacks of unacknowledged batches. */
+        bool writing = false; /**< A write is outstanding. */
+        bool closing = false; /**< close() was called. */
+        bool writesDone = false; /**< The stream was half-closed. */
+        bool failed = false; /**< Reading ended; nothing can be sent anymore. */
+        bool done = false; /**< OnDone() was called. */
+};
+
+/**
+ * @class GrpcTransport::Impl::PullCall
+ * @brief Client side of one PullLogs call; deletes itself when done.
+ */
+class GrpcTransport::Impl::PullCall : public grpc::ClientBidiReactor<grpc::ByteBuffer, grpc::ByteBuffer>
+{
+    public:
+        /**
+         * @brief Starts the call.
+         * @param impl Owning transport state.
+         * @param stub Client stub.
+         * @param query Encoded query.
+         * @param callback Receives the entries.
+         */
+        PullCall(Impl& impl, grpc::GenericStub& stub, const std::string& query, std::function<void(LogEntryList)> callback)
+            : impl(impl), request(toBuffer(query)), callback(std::move(callback))
+        {
+            impl.beginCall();
+            impl.bytesSent += query.size();
+            stub.PrepareBidiStreamingCall(& context, GRPC_TRANSPORT_METHOD_PULL_LOGS, grpc::StubOptions(), this);
+            StartWriteLast(& request, grpc::WriteOptions());
+            StartRead(& response);
+            StartCall();
+        }
+
+        void OnReadDone(bool ok) override
+        {
+            if(!ok)
+            {
+                return;
+            }
+            const std::string block = toString(response);
+            impl.bytesReceived += block.size();
+            try
+            {
+                LogEntryList chunk = LogSerializer::Binary::parseLogs(block);
+                entries.insert(entries.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+            }
+            catch(const std::runtime_error& e)
+            {
+                error = e.what();
+                context.TryCancel();
+                return;
+            }
+            StartRead(& response);
+        }
+
+        void OnDone(const grpc::Status& status) override
+        {
+            if(error.empty() && !status.ok())
+            {
+                error = ERR_MSG_TRANSPORT_CALL_FAILED + status.error_message();
+            }
+            if(!error.empty())
+            {
+                impl.reportError(error);
+                entries.clear();
+            }
+            callback(std::move(entries));
+
+            Impl& owner = impl;
+            delete this;
+            owner.endCall();
+        }
+
+    private:
+        Impl& impl; /**< Owning transport state. */
+        grpc::ClientContext context; /**< Call context. */
+        grpc::ByteBuffer request; /**< Encoded query. */
+        grpc::ByteBuffer response; /**< Block being read. */
+        std::function<void(LogEntryList)> callback; /**< Receives the entries. */
+        LogEntryList entries; /**< Entries received so far. */
+        std::string error; /**< First error. */
+};
+
+/**
+ * @class GrpcTransport::Impl::PushReactor
+ * @brief Server side of a PushLogs stream.
+ * Batches are dispatched as they arrive and acknowledged in arrival order; reading pauses
+ * while GRPC_TRANSPORT_SERVER_WINDOW batches are unacknowledged.
+ */
+class GrpcTransport::Impl::PushReactor : public grpc::ServerGenericBidiReactor
+{
+    public:
+        /**
+         * @brief Starts reading the stream.
+         * @param impl Owning transport state.
+         */
+        explicit PushReactor(Impl& impl) : impl(impl)
+        {
+            ++impl.activeConnections;
+            StartRead(& request);
+        }
+
+        void OnReadDone(bool ok) override
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if(finished)
+            {
+                return;
+            }
+            if(!ok)
+            {
+                readClosed = true;
+                writeNext(lock);
+                return;
+            }
+            lock.unlock();
+
+            const std::string block = toString(request);
+            impl.bytesReceived += block.size();
+            LogEntryList entries;
+            try
+            {
+                entries = LogSerializer::Binary::parseLogs(block);
+            }
+            catch(const std::runtime_error& e)
+            {
+                lock.lock();
+                finish(lock, grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what()));
+                return;
+            }
+
+            auto slot = std::make_shared<Slot>();
+            lock.lock();
+            slots.push_back(slot);
+            ++outstanding;
+            const bool resume = slots.size() < GRPC_TRANSPORT_SERVER_WINDOW;
+            readPaused = !resume;
+            lock.unlock();
+
+            impl.dispatchBatch(entries, [this, slot](bool success)
+            {
+                onAck(slot, success);
+            });
+            if(resume)
+            {
+                StartRead(& request);
+            }
+        }
+
+        void OnWriteDone(bool ok) override
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            writing = false;
+            if(!ok)
+            {
+                finish(lock, grpc::Status(grpc::StatusCode::UNAVAILABLE, ERR_MSG_TRANSPORT_CALL_FAILED));
+                return;
+            }
+            writeNext(lock);
+        }
+
+        void OnCancel() override
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finish(lock, grpc::Status::CANCELLED);
+        }
+
+        void OnDone() override
+        {
+            --impl.activeConnections;
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCalled = true;
+            const bool last = outstanding == 0;
+            lock.unlock();
+            if(last)
+            {
+                delete this;
+            }
+        }
+
+    private:
+        /**
+         * @struct Slot
+         * @brief Status of one received batch.
+         */
+        struct Slot
+        {
+            bool done = false; /**< The handler answered. */
+            bool success = false; /**< Handler status. */
+        };
+
+        /**
+         * @brief Records a handler answer and writes the acks that are ready.
+         * @param slot Batch slot.
+         * @param success Handler status.
+         */
+        void onAck(const std::shared_ptr<Slot> & slot, const bool success)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            slot->done = true;
+            slot->success = success;
+            --outstanding;
+            if(doneCalled)
+            {
+                const bool last = outstanding == 0;
+                lock.unlock();
+                if(last)
+                {
+                    delete this; // the stream ended before the handler answered
+                }
+                return;
+            }
+            writeNext(lock);
+        }
+
+        /**
+         * @brief Writes the next ack, resumes reading or finishes the stream.
+         * @param lock Held lock on mutex (released).
+         */
+        void writeNext(std::unique_lock<std::mutex> & lock)
+        {
+            if(writing || finished)
+            {
+                return;
+            }
+            if(!slots.empty() && slots.front()->done)
+            {
+                ack = toBuffer(std::string(1, slots.front()->success ? 1 : 0));
+                slots.pop_front();
+                writing = true;
+                const bool resume = readPaused && !readClosed;
+                readPaused = false;
+                lock.unlock();
+                impl.bytesSent += 1;
+                StartWrite(& ack);
+                if(resume)
+                {
+                    StartRead(& request);
+                }
+                return;
+            }
+            if(readClosed && slots.empty())
+            {
+                finish(lock, grpc::Status::OK);
+            }
+        }
+
+        /**
+         * @brief Finishes the stream once.
+         * @param lock Held lock on mutex (released).
+         * @param status Final status.
+         */
+        void finish(std::unique_lock<std::mutex> & lock, const grpc::Status& status)
+        {
+            if(finished)
+            {
+                return;
+            }
+            finished = true;
+            lock.unlock();
+            Finish(status);
+        }
+
+        Impl& impl; /**< Owning transport state. */
+        grpc::ByteBuffer request; /**< Batch being read. */
+        grpc::ByteBuffer ack; /**< Ack being written. */
+
+        std::mutex mutex; /**< Guards the members below. */
+        std::deque<std::shared_ptr<Slot>> slots; /**< Unacknowledged batches in arrival order. */
+        size_t outstanding = 0; /**< Handler answers still expected. */
+        bool writing = false; /**< A write is outstanding. */
+        bool readPaused = false; /**< Reading stopped at the window limit. */
+        bool readClosed = false; /**< The client half-closed the stream. */
+        bool finished = false; /**< Finish() was called. */
+        bool doneCalled = false; /**< OnDone() was called. */
+};
+
+/**
+ * @class GrpcTransport::Impl::PullReactor
+ * @brief Server side of a PullLogs call: reads the query and streams the result in blocks.
+ */
+class GrpcTransport::Impl::PullReactor : public grpc::ServerGenericBidiReactor
+{
+    public:
+        /**
+         * @brief Starts reading the query.
+         * @param impl Owning transport state.
+         */
+        explicit PullReactor(Impl& impl) : impl(impl)
+        {
+            StartRead(& request);
+        }
+
+        void OnReadDone(bool ok) override
+        {
+            if(!ok)
+            {
+                Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, ERR_MSG_TRANSPORT_INVALID_REQUEST));
+                return;
+            }
+
+            std::vector<Filter> filters;
+            int limit = 0;
+            int offset = 0;
+            const std::string query = toString(request);
+            impl.bytesReceived += query.size();
+            try
+            {
+                decodePullRequest(query, filters, limit, offset);
+            }
+            catch(const std::exception& e)
+            {
+                Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what()));
+                return;
+            }
+
+            LogPullHandler handler;
+            {
+                std::lock_guard<std::mutex> lock(impl.handlerMutex);
+                handler = impl.pullHandler;
+            }
+            if(!handler)
+            {
+                Finish(grpc::Status(grpc::StatusCode::UNIMPLEMENTED, ERR_MSG_TRANSPORT_NO_HANDLER GRPC_TRANSPORT_METHOD_PULL_LOGS));
+                return;
+            }
+
+            // OnDone() cannot run before Finish(), so the reactor outlives the handler call
+            handler(filters, limit, offset, [this](LogEntryList entries)
+            {
+                for(size_t first = 0; first < entries.size(); first += GRPC_TRANSPORT_PULL_CHUNK)
+                {
+                    std::string block;
+                    LogSerializer::Binary::appendLogs(block, entries.data() + first,
+                                                      std::min<size_t>(GRPC_TRANSPORT_PULL_CHUNK, entries.size() - first));
+                    impl.bytesSent += block.size();
+                    blocks.push_back(toBuffer(block));
+                }
+                writeNext();
+            });
+        }
+
+        void OnWriteDone(bool ok) override
+        {
+            if(!ok)
+            {
+                Finish(grpc::Status(grpc::StatusCode::UNAVAILABLE, ERR_MSG_TRANSPORT_CALL_FAILED));
+                return;
+            }
+            writeNext();
+        }
+
+        void OnDone() override
+        {
+            delete this;
+        }
+
+    private:
+        /**
+         * @brief Writes the next block, or finishes after the last one.
+         */
+        void writeNext()
+        {
+            if(blocks.empty())
+            {
+                Finish(grpc::Status::OK);
+                return;
+            }
+            current = std::move(blocks.front());
+            blocks.pop_front();
+            StartWrite(& current);
+        }
+
+        Impl& impl; /**< Owning transport state. */
+        grpc::ByteBuffer request; /**< Encoded query. */
+        grpc::ByteBuffer current; /**< Block being written. */
+        std::deque<grpc::ByteBuffer> blocks; /**< Blocks left to write. */
+};
+
+/**
+ * @class GrpcTransport::Impl::StatsReactor
+ * @brief Server side of a PushStats call.
+ */
+class GrpcTransport::Impl::StatsReactor : public grpc::ServerGenericBidiReactor
+{
+    public:
+        /**
+         * @brief Starts reading the statistics.
+         * @param impl Owning transport state.
+         */
+        explicit StatsReactor(Impl& impl) : impl(impl)
+        {
+            StartRead(& request);
+        }
+
+        void OnReadDone(bool ok) override
+        {
+            if(!ok)
+            {
+                Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, ERR_MSG_TRANSPORT_INVALID_REQUEST));
+                return;
+            }
+
+            const std::string data = toString(request);
+            impl.bytesReceived += data.size();
+            SQLogger::Stats stats;
+            try
+            {
+                stats = decodeStats(data);
+            }
+            catch(const std::runtime_error& e)
+            {
+                Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what()));
+                return;
+            }
+
+            StatsHandler handler;
+            {
+                std::lock_guard<std::mutex> lock(impl.handlerMutex);
+                handler = impl.statsHandler;
+            }
+            if(handler)
+            {
+                handler(stats);
+            }
+            response = toBuffer(std::string());
+            StartWriteAndFinish(& response, grpc::WriteOptions(), grpc::Status::OK);
+        }
+
+        void OnDone() override
+        {
+            delete this;
+        }
+
+    private:
+        Impl& impl; /**< Owning transport state. */
+        grpc::ByteBuffer request; /**< Encoded statistics. */
+        grpc::ByteBuffer response; /**< Empty reply. */
+};
+
+/**
+ * @class GrpcTransport::Impl::LogService
+ * @brief Generic service routing the log service methods to their reactors.
+ */
+class GrpcTransport::Impl::LogService : public grpc::CallbackGenericService
+{
+    public:
+        /**
+         * @brief Constructs the service.
+         * @param impl Owning transport state.
+         */
+        explicit LogService(Impl& impl) : impl(impl) {};
+
+        grpc::ServerGenericBidiReactor* CreateReactor(grpc::GenericCallbackServerContext* context) override
+        {
+            const std::string& method = context->method();
+            if(method == GRPC_TRANSPORT_METHOD_PUSH_LOGS)
+            {
+                return new PushReactor(impl);
+            }
+            if(method == GRPC_TRANSPORT_METHOD_PULL_LOGS)
+            {
+                return new PullReactor(impl);
+            }
+            if(method == GRPC_TRANSPORT_METHOD_PUSH_STATS)
+            {
+                return new StatsReactor(impl);
+            }
+            return grpc::CallbackGenericService::CreateReactor(context); // UNIMPLEMENTED
+        }
+
+    private:
+        Impl& impl; /**< Owning transport state. */
+};
+
+/**
+ * @brief Constructs the state from the [Transport] settings.
+ * @param config Configuration.
+ */
+GrpcTransport::Impl::Impl(const LogConfig::Config& config)
+    : maxInFlight(TransportBatchPolicy::fromConfig(config).maxInFlight)
+{
+    if(config.transportHost.has_value() && config.transportPort.has_value())
+    {
+        target = config.transportHost.value() + ":" + std::to_string(config.transportPort.value());
+    }
+}
+
+/**
+ * @brief Closes the push stream, stops the server and waits for pending calls.
+ */
+GrpcTransport::Impl::~Impl()
+{
+    closeStream();
+    stopServer();
+
+    std::unique_lock<std::mutex> lock(callMutex);
+    callCv.wait(lock, [this]()
+    {
+        return calls == 0;
+    });
+}
+
+/**
+ * @brief Calls the error handler, if any.
+ * @param message Error message.
+ */
+void GrpcTransport::Impl::reportError(const std::string& message)
+{
+    ErrorHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(handlerMutex);
+        handler = errorHandler;
+    }
+    if(handler)
+    {
+        handler(message);
+    }
+}
+
+/**
+ * @brief Gets the client stub, creating the channel on first use.
+ * @return grpc::GenericStub* Stub, or nullptr if no endpoint is configured (clientMutex held).
+ */
+grpc::GenericStub* GrpcTransport::Impl::getStub()
+{
+    if(!stub && !target.empty())
+    {
+        grpc::ChannelArguments args;
+        args.SetMaxReceiveMessageSize(GRPC_TRANSPORT_MAX_MESSAGE_SIZE);
+        args.SetMaxSendMessageSize(GRPC_TRANSPORT_MAX_MESSAGE_SIZE);
+        channel = grpc::CreateCustomChannel(target, grpc::InsecureChannelCredentials(), args);
+        stub = std::make_unique<grpc::GenericStub>(channel);
+    }
+    return stub.get();
+}
+
+/**
+ * @brief Gets the push stream, opening a new one if there is none or the last one failed.
+ * @return std::shared_ptr<PushStream> Stream, or nullptr if no endpoint is configured.
+ */
+std::shared_ptr<GrpcTransport::Impl::PushStream> GrpcTransport::Impl::getStream()
+{
+    std::lock_guard<std::mutex> lock(clientMutex);
+    if(stream && !stream->isFailed())
+    {
+        return stream;
+    }
+    grpc::GenericStub* client = getStub();
+    if(!client)
+    {
+        return nullptr;
+    }
+    if(stream)
+    {
+        stream->close(); // waits until the failed stream is done
+    }
+    stream = std::make_shared<PushStream>(*this, *client);
+    return stream;
+}
+
+/**
+ * @brief Closes the push stream after its batches are acknowledged.
+ */
+void GrpcTransport::Impl::closeStream()
+{
+    std::lock_guard<std::mutex> lock(clientMutex);
+    if(stream)
+    {
+        stream->close();
+        stream.reset();
+    }
+}
+
+/**
+ * @brief Stops the server, cancelling calls still running after the grace period.
+ */
+void GrpcTransport::Impl::stopServer()
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if(server)
+    {
+        server->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(GRPC_TRANSPORT_STOP_TIMEOUT_MSEC));
+        server->Wait();
+        server.reset();
+        service.reset();
+        port = 0;
+    }
+}
+
+/**
+ * @brief Passes a received batch to the batch handler (or to the per-entry handler).
+ * @param entries Received entries.
+ * @param callback Called once with the status of the batch.
+ */
+void GrpcTransport::Impl::dispatchBatch(const LogEntryList& entries, std::function<void(bool)> callback)
+{
+    LogBatchPushHandler batchHandler;
+    LogPushHandler entryHandler;
+    {
+        std::lock_guard<std::mutex> lock(handlerMutex);
+        batchHandler = batchPushHandler;
+        entryHandler = pushHandler;
+    }
+
+    if(batchHandler)
+    {
+        batchHandler(entries, std::move(callback));
+        return;
+    }
+    if(!entryHandler || entries.empty())
+    {
+        callback(entries.empty() && entryHandler);
+        return;
+    }
+
+    struct Pending
+    {
+        std::mutex mutex;
+        size_t remaining;
+        bool success = true;
+        std::function<void(bool)> callback;
+    };
+    auto pending = std::make_shared<Pending>();
+    pending->remaining = entries.size();
+    pending->callback = std::move(callback);
+    for(const auto & entry : entries)
+    {
+        entryHandler(entry, [pending](bool success)
+        {
+            std::unique_lock<std::mutex> lock(pending->mutex);
+            pending->success = pending->success && success;
+            if(--pending->remaining == 0)
+            {
+                const bool result = pending->success;
+                lock.unlock();
+                pending->callback(result);
+            }
+        });
+    }
+}
+
+/**
+ * @brief Registers an outstanding client call (pull or stats).
+ */
+void GrpcTransport::Impl::beginCall()
+{
+    std::lock_guard<std::mutex> lock(callMutex);
+    ++calls;
+}
+
+/**
+ * @brief Unregisters an outstanding client call.
+ */
+void GrpcTransport::Impl::endCall()
+{
+    std::lock_guard<std::mutex> lock(callMutex);
+    --calls;
+    callCv.notify_all();
+}
+
+/**
+ * @brief Constructs a transport (nothing is connected or bound yet).
+ * @param config Configuration ([Transport] Host, Port and BatchMaxInFlight).
+ */
+GrpcTransport::GrpcTransport(const LogConfig::Config& config)
+    : impl(std::make_unique<Impl>(config))
+{
+}
+
+/**
+ * @brief Closes the push stream and stops the server.
+ */
+GrpcTransport::~GrpcTransport() = default;
+
+/**
+ * @brief Starts the server side
+ * @param host The host address to listen to
+ * @param port The port number to use (0 picks a free port, see getPort())
+ * @return true if started successfully, false otherwise
+ */
+bool GrpcTransport::start(const std::string& host, uint16_t port)
+{
+    const std::string address = host + ":" + std::to_string(port);
+    {
+        std::lock_guard<std::mutex> lock(impl->serverMutex);
+        if(impl->server)
+        {
+            return true;
+        }
+
+        auto service = std::make_unique<Impl::LogService>(*impl);
+        int boundPort = 0;
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort(address, grpc::InsecureServerCredentials(), & boundPort);
+        builder.SetMaxReceiveMessageSize(GRPC_TRANSPORT_MAX_MESSAGE_SIZE);
+        builder.SetMaxSendMessageSize(GRPC_TRANSPORT_MAX_MESSAGE_SIZE);
+        builder.RegisterCallbackGenericService(service.get());
+        auto server = builder.BuildAndStart();
+        if(server && boundPort > 0)
+        {
+            impl->service = std::move(service);
+            impl->server = std::move(server);
+            impl->port = boundPort;
+            return true;
+        }
+    }
+    impl->reportError(ERR_MSG_TRANSPORT_START_FAILED + address);
+    return false;
+}
+
+/**
+ * @brief Stops the server side and closes the client push stream
+ */
+void GrpcTransport::stop()
+{
+    impl->closeStream();
+    impl->stopServer();
+}
+
+/**
+ * @brief Checks if the server side is running
+ * @return true if the server is active, false otherwise
+ */
+bool GrpcTransport::isRunning() const
+{
+    std::lock_guard<std::mutex> lock(impl->serverMutex);
+    return impl->server != nullptr;
+}
+
+/**
+ * @brief Gets the port the server listens to
+ * @return uint16_t Bound port, 0 if the server is not running
+ */
+uint16_t GrpcTransport::getPort() const
+{
+    std::lock_guard<std::mutex> lock(impl->serverMutex);
+    return static_cast<uint16_t>(impl->port);
+}
+
+/**
+ * @brief Sets the handler for log pushes (batches are split into single entries)
+ * @param handler Callback function to handle incoming log pushes
+ */
+void GrpcTransport::setLogPushHandler(LogPushHandler handler)
+{
+    std::lock_guard<std::mutex> lock(impl->handlerMutex);
+    impl->pushHandler = std::move(handler);
+}
+
+/**
+ * @brief Sets the handler for batched log pushes (takes precedence over setLogPushHandler)
+ * @param handler Callback function to handle incoming log batches
+ */
+void GrpcTransport::setLogBatchPushHandler(LogBatchPushHandler handler)
+{
+    std::lock_guard<std::mutex> lock(impl->handlerMutex);
+    impl->batchPushHandler = std::move(handler);
+}
+
+/**
+ * @brief Sets the handler for log pull operations
+ * @param handler Callback function to handle log retrieval requests
+ */
+void GrpcTransport::setLogPullHandler(LogPullHandler handler)
+{
+    std::lock_guard<std::mutex> lock(impl->handlerMutex);
+    impl->pullHandler = std::move(handler);
+}
+
+/**
+ * @brief Sets the handler for configuration updates
+ * @param handler Callback function to handle configuration changes
+ */
+void GrpcTransport::setConfigHandler(ConfigHandler handler)
+{
+    std::lock_guard<std::mutex> lock(impl->handlerMutex);
+    impl->configHandler = std::move(handler);
+}
+
+/**
+ * @brief Sets the handler for error notifications
+ * @param handler Callback function to handle transport errors
+ */
+void GrpcTransport::setErrorHandler(ErrorHandler handler)
+{
+    std::lock_guard<std::mutex> lock(impl->handlerMutex);
+    impl->errorHandler = std::move(handler);
+}
+
+/**
+ * @brief Sets the handler for statistics updates
+ * @param handler Callback function to receive statistics
+ */
+void GrpcTransport::setStatsHandler(StatsHandler handler)
+{
+    std::lock_guard<std::mutex> lock(impl->handlerMutex);
+    impl->statsHandler = std::move(handler);
+}
+
+/**
+ * @brief Pushes a log entry as a batch of one
+ * @param entry The log entry to send
+ * @param callback Callback to receive operation status (true = success)
+ */
+void GrpcTransport::pushLog(const LogEntry& entry, std::function<void(bool)> callback)
+{
+    pushLogs(LogEntryList{ entry }, std::move(callback));
+}
+
+/**
+ * @brief Pushes a batch over the push stream, blocking while BatchMaxInFlight batches are unacknowledged
+ * @param entries The log entries to send
+ * @param callback Callback to receive the batch status (true = success), called once
+ */
+void GrpcTransport::pushLogs(const LogEntryList& entries, std::function<void(bool)> callback)
+{
+    if(!callback)
+    {
+        callback = [](bool) {};
+    }
+    if(entries.empty())
+    {
+        callback(true);
+        return;
+    }
+
+    auto stream = impl->getStream();
+    if(!stream)
+    {
+        impl->reportError(ERR_MSG_TRANSPORT_NO_ENDPOINT);
+        callback(false);
+        return;
+    }
+    stream->send(LogSerializer::Binary::serializeLogs(entries), std::move(callback));
+}
+
+/**
+ * @brief Retrieves logs matching specified filters from the server
+ * @param filters Vector of filters to apply
+ * @param limit Maximum number of entries to return
+ * @param offset Pagination offset
+ * @param callback Callback to receive the resulting LogEntryList (empty on failure)
+ */
+void GrpcTransport::pullLogs(const std::vector<Filter> & filters, int limit, int offset,
+                             std::function<void(LogEntryList)> callback)
+{
+    grpc::GenericStub* stub = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl->clientMutex);
+        stub = impl->getStub();
+    }
+    if(!stub)
+    {
+        impl->reportError(ERR_MSG_TRANSPORT_NO_ENDPOINT);
+        callback({});
+        return;
+    }
+    new Impl::PullCall(*impl, *stub, encodePullRequest(filters, limit, offset), std::move(callback)); // deletes itself
+}
+
+/**
+ * @brief Publishes statistics to the server
+ * @param stats Statistics data to send
+ */
+void GrpcTransport::pushStats(const SQLogger::Stats& stats)
+{
+    grpc::GenericStub* stub = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl->clientMutex);
+        stub = impl->getStub();
+    }
+    if(!stub)
+    {
+        impl->reportError(ERR_MSG_TRANSPORT_NO_ENDPOINT);
+        return;
+    }
+
+    struct Call
+    {
+        grpc::ClientContext context;
+        grpc::ByteBuffer request;
+        grpc::ByteBuffer response;
+    };
+    auto call = new Call();
+    const std::string data = encodeStats(stats);
+    call->request = toBuffer(data);
+    impl->bytesSent += data.size();
+    impl->beginCall();
+
+    Impl* state = impl.get();
+    stub->UnaryCall(& call->context, GRPC_TRANSPORT_METHOD_PUSH_STATS, grpc::StubOptions(),
+                    & call->request, & call->response, [state, call](grpc::Status status)
+    {
+        if(!status.ok())
+        {
+            state->reportError(ERR_MSG_TRANSPORT_CALL_FAILED + status.error_message());
+        }
+        delete call;
+        state->endCall();
+    });
+}
+
+/**
+ * @brief Gets current transport statistics
+ * @return TransportStats structure with current metrics
+ */
+TransportStats GrpcTransport::getStats() const
+{
+    TransportStats stats;
+    stats.bytesSent = impl->bytesSent;
+    stats.bytesReceived = impl->bytesReceived;
+    stats.activeConnections = impl->activeConnections;
+    return stats;
+}
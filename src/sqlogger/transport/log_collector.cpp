@@ -0,0 +1,222 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include "sqlogger/transport/log_collector.h"
+
+/**
+ * @brief Binds the transport handlers to the logger.
+ * @param transport Server transport (must outlive the collector).
+ * @param logger Logger storing the entries (must outlive the collector).
+ * @param durableAcks Acknowledge after the entries are committed (true) or once queued (false).
+ */
+LogCollector::LogCollector(ITransport& transport, SQLogger& logger, const bool durableAcks)
+    : transport(transport), logger(logger), durableAcks(durableAcks)
+{
+    if(durableAcks)
+    {
+        ackThread = std::thread(& LogCollector::ackLoop, this);
+    }
+
+    transport.setLogBatchPushHandler([this](const LogEntryList & entries, std::function<void(bool)> callback)
+    {
+        onBatch(entries, std::move(callback));
+    });
+
+    transport.setLogPullHandler([this](const std::vector<Filter> & filters, int limit, int offset,
+                                       std::function<void(LogEntryList)> callback)
+    {
+        // Answered on the logger's query threads, the transport thread is not blocked
+        this->logger.getLogsByFiltersAsync(filters, limit > 0 ? limit : -1, offset > 0 ? offset : -1, std::move(callback));
+    });
+}
+
+/**
+ * @brief Stops the collector.
+ */
+LogCollector::~LogCollector()
+{
+    stop();
+}
+
+/**
+ * @brief Starts the transport server.
+ * @param host The host address to listen to.
+ * @param port The port number to use.
+ * @return bool True if the transport started.
+ */
+bool LogCollector::start(const std::string& host, uint16_t port)
+{
+    return transport.start(host, port);
+}
+
+/**
+ * @brief Stops the transport and acknowledges the batches still waiting for durability.
+ */
+void LogCollector::stop()
+{
+    if(transport.isRunning())
+    {
+        transport.stop();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    if(ackThread.joinable())
+    {
+        ackThread.join();
+    }
+}
+
+/**
+ * @brief Gets the collector counters.
+ * @return Stats Counters.
+ */
+LogCollector::Stats LogCollector::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+/**
+ * @brief Push handler: hands a batch to the logger and schedules its ack.
+ * @param entries Received entries.
+ * @param callback Batch status callback.
+ */
+void LogCollector::onBatch(const LogEntryList& entries, std::function<void(bool)> callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(stopping)
+        {
+            callback(false);
+            return;
+        }
+    }
+
+    size_t accepted = 0;
+    try
+    {
+#ifdef SQLG_USE_SOURCE_INFO
+        LogEntryList local(entries);
+        for(auto & entry : local)
+        {
+            entry.sourceId = entry.sourceUuid.empty() ? 0 : resolveSource(entry.sourceUuid, entry.sourceName);
+        }
+        accepted = logger.logEntries(local);
+#else
+        accepted = logger.logEntries(entries);
+#endif
+    }
+    catch(const std::exception& e)
+    {
+        logger.logError(e.what(), __func__, __FILE__, __LINE__);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stats.batches;
+            ++stats.failedBatches;
+        }
+        callback(false);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.batches;
+        stats.entries += accepted;
+        stats.skipped += entries.size() - accepted;
+        if(durableAcks)
+        {
+            pendingAcks.push_back(std::move(callback));
+            cv.notify_all();
+            return;
+        }
+    }
+    callback(true);
+}
+
+/**
+ * @brief Ack thread body: waits for durability once per group of received batches.
+ */
+void LogCollector::ackLoop()
+{
+    std::vector<std::function<void(bool)>> group;
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true)
+    {
+        cv.wait(lock, [this]()
+        {
+            return stopping || !pendingAcks.empty();
+        });
+        if(pendingAcks.empty())
+        {
+            break; // stopping and nothing left to acknowledge
+        }
+
+        group.swap(pendingAcks);
+        lock.unlock();
+
+        const bool durable = logger.waitUntilDurable(std::chrono::system_clock::now(),
+                             std::chrono::milliseconds(LOG_COLLECTOR_ACK_TIMEOUT_MSEC));
+        for(auto & callback : group)
+        {
+            callback(durable);
+        }
+
+        lock.lock();
+        if(!durable)
+        {
+            stats.failedBatches += group.size();
+        }
+        group.clear();
+    }
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @brief Gets the local ID of a sender's source, registering it on first use.
+ * @param uuid Source UUID.
+ * @param name Source name.
+ * @return int Source ID, or 0 to store the logger's own source.
+ */
+int LogCollector::resolveSource(const std::string& uuid, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(sourceMutex);
+    auto it = sources.find(uuid);
+    if(it != sources.end())
+    {
+        return it->second;
+    }
+
+    const int id = logger.findOrAddSource(name.empty() ? uuid : name, uuid);
+    if(id == SOURCE_NOT_FOUND)
+    {
+        return 0; // not cached: retried with the next batch
+    }
+    sources.emplace(uuid, id);
+    {
+        std::lock_guard<std::mutex> statsLock(mutex);
+        stats.sources = sources.size();
+    }
+    return id;
+}
+#endif
@@ -0,0 +1,240 @@
+/*
+ * This file is part of SQLogger.
+ *
+ * SQLogger is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SQLogger is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SQLogger. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (C) 2025 Sergey K. sergey[no_spam]@greenblit.com
+ */
+
+
+#include <memory>
+#include "sqlogger/transport/transport_batcher.h"
+
+/**
+ * @brief Builds a policy from the [Transport] Batch* settings (defaults for unset values).
+ * @param config Configuration.
+ * @return TransportBatchPolicy Policy.
+ */
+TransportBatchPolicy TransportBatchPolicy::fromConfig(const LogConfig::Config& config)
+{
+    TransportBatchPolicy policy;
+    if(config.transportBatchMaxEntries.value_or(0) > 0)
+    {
+        policy.maxEntries = static_cast<size_t>(config.transportBatchMaxEntries.value());
+    }
+    if(config.transportBatchMaxBytes.value_or(0) > 0)
+    {
+        policy.maxBytes = static_cast<size_t>(config.transportBatchMaxBytes.value());
+    }
+    if(config.transportBatchMaxDelay.value_or(-1) >= 0)
+    {
+        policy.maxDelay = std::chrono::milliseconds(config.transportBatchMaxDelay.value());
+    }
+    if(config.transportBatchMaxInFlight.value_or(0) > 0)
+    {
+        policy.maxInFlight = static_cast<size_t>(config.transportBatchMaxInFlight.value());
+    }
+    return policy;
+}
+
+/**
+ * @brief Constructs a batcher and starts its linger thread.
+ * @param transport Transport to push to (must outlive the batcher).
+ * @param policy Batching limits.
+ */
+TransportBatcher::TransportBatcher(ITransport& transport, const TransportBatchPolicy& policy)
+    : transport(transport), policy(policy)
+{
+    if(this->policy.maxEntries == 0)
+    {
+        this->policy.maxEntries = 1;
+    }
+    if(this->policy.maxInFlight == 0)
+    {
+        this->policy.maxInFlight = 1;
+    }
+    batch.reserve(this->policy.maxEntries);
+    lingerThread = std::thread(& TransportBatcher::lingerLoop, this);
+}
+
+/**
+ * @brief Sends the pending batch, waits for in-flight batches and stops the linger thread.
+ */
+TransportBatcher::~TransportBatcher()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    if(lingerThread.joinable())
+    {
+        lingerThread.join();
+    }
+}
+
+/**
+ * @brief Adds an entry to the current batch, sending the batch when it is full.
+ * @param entry The log entry.
+ * @param callback Optional status callback of the entry.
+ */
+void TransportBatcher::push(const LogEntry& entry, std::function<void(bool)> callback)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    // A full batch is waiting for an in-flight slot; do not grow it past the limits
+    cv.wait(lock, [this]()
+    {
+        return batch.size() < policy.maxEntries && batchBytes < policy.maxBytes;
+    });
+    if(batch.empty())
+    {
+        batchStart = std::chrono::steady_clock::now();
+        cv.notify_all(); // wake the linger thread
+    }
+    batch.push_back(entry);
+    batchBytes += entrySize(entry);
+    if(callback)
+    {
+        callbacks.push_back(std::move(callback));
+    }
+
+    if(batch.size() >= policy.maxEntries || batchBytes >= policy.maxBytes)
+    {
+        sendBatch(lock);
+    }
+}
+
+/**
+ * @brief Sends the current batch and waits until every batch is acknowledged.
+ * @param timeout Maximum time to wait.
+ * @return bool True if nothing is in flight anymore.
+ */
+bool TransportBatcher::flush(const std::chrono::milliseconds& timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!batch.empty())
+    {
+        sendBatch(lock);
+    }
+    return cv.wait_for(lock, timeout, [this]()
+    {
+        return inFlight == 0 && batch.empty();
+    });
+}
+
+/**
+ * @brief Gets the batching counters.
+ * @return Stats Counters.
+ */
+TransportBatcher::Stats TransportBatcher::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+/**
+ * @brief Sends the current batch once an in-flight slot is free.
+ * @param lock Held lock on mutex (released while pushing).
+ */
+void TransportBatcher::sendBatch(std::unique_lock<std::mutex>& lock)
+{
+    const uint64_t current = generation;
+    cv.wait(lock, [this, current]()
+    {
+        return inFlight < policy.maxInFlight || generation != current;
+    });
+    if(generation != current || batch.empty())
+    {
+        return; // another thread sent this batch while we waited
+    }
+
+    LogEntryList entries;
+    entries.swap(batch);
+    batch.reserve(policy.maxEntries);
+    auto entryCallbacks = std::make_shared<std::vector<std::function<void(bool)>>>(std::move(callbacks));
+    callbacks.clear();
+    batchBytes = 0;
+    ++generation;
+    ++inFlight;
+    ++stats.batches;
+    stats.entries += entries.size();
+
+    // The transport may acknowledge synchronously, so it is called without the lock
+    lock.unlock();
+    transport.pushLogs(entries, [this, entryCallbacks](bool success)
+    {
+        // Entry callbacks run before the slot is released, so flush() returns after them
+        for(auto & callback : * entryCallbacks)
+        {
+            callback(success);
+        }
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            --inFlight;
+            if(!success)
+            {
+                ++stats.failedBatches;
+            }
+            cv.notify_all(); // under the lock: the destructor may run as soon as it is released
+        }
+    });
+    lock.lock();
+}
+
+/**
+ * @brief Sends partial batches after maxDelay.
+ */
+void TransportBatcher::lingerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!stop)
+    {
+        if(batch.empty())
+        {
+            cv.wait(lock, [this]()
+            {
+                return stop || !batch.empty();
+            });
+            continue;
+        }
+
+        const uint64_t current = generation;
+        const auto deadline = batchStart + policy.maxDelay;
+        cv.wait_until(lock, deadline, [this, current]()
+        {
+            return stop || generation != current;
+        });
+        if(!stop && generation == current && !batch.empty() && std::chrono::steady_clock::now() >= deadline)
+        {
+            sendBatch(lock);
+        }
+    }
+}
+
+/**
+ * @brief Estimates the encoded size of an entry.
+ * @param entry The log entry.
+ * @return size_t Size in bytes.
+ */
+size_t TransportBatcher::entrySize(const LogEntry& entry)
+{
+    return TRANSPORT_BATCH_ENTRY_OVERHEAD
+           + entry.timestamp.size() + entry.level.size() + entry.message.size()
+           + entry.function.size() + entry.file.size() + entry.threadId.size()
+#ifdef SQLG_USE_SOURCE_INFO
+           + entry.sourceUuid.size() + entry.sourceName.size()
+#endif
+           ;
+}
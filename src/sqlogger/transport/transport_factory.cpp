@@ -28,6 +28,7 @@
  * @throws std::invalid_argument If unknown transport type is requested
  * @note Actual available transports depend on compile-time definitions:
  * - REST transport requires SQLG_USE_REST definition
+ * - gRPC transport requires SQLG_USE_GRPC definition
  */
 std::unique_ptr<ITransport> TransportFactory::create(const TransportType& type, const LogConfig::Config& config)
 {
@@ -43,6 +44,14 @@ std::unique_ptr<ITransport> TransportFactory::create(const TransportType& type,
         }
         break;
         case TransportType::GRPC:
+        {
+#ifdef SQLG_USE_GRPC
+            return std::make_unique<GrpcTransport>(config);
+#else
+            throw std::runtime_error("gRPC transport is not enabled (SQLG_USE_GRPC not defined)");
+#endif
+        }
+        break;
         case TransportType::WEBSOCKETS:
         {
             throw std::runtime_error("Transport type not implemented yet");
@@ -21,8 +21,16 @@
 #include <iostream>
 #include <thread>
 #include <filesystem>
+#include <array>
+#include <future>
+#include <set>
+#include <algorithm>
 #include "sqlogger/log_manager.h"
+#include "sqlogger/log_metrics.h"
+#include "sqlogger/internal/log_columnar.h"
 #include "sqlogger/transport/transport_factory.h"
+#include "sqlogger/transport/transport_batcher.h"
+#include "sqlogger/transport/log_collector.h"
 
 #ifdef SQLG_USE_REST
     #pragma message("REST support enabled.")
@@ -79,6 +87,7 @@ constexpr auto TEST_DATABASE_PASS = "test";
 constexpr auto TEST_ENC_DEC_PASS_KEY = "iknowyoursecrets";
 constexpr auto TEST_ENC_DEC_STRING = "test_string";
 constexpr auto TEST_DATABASE_FILE = "test_logs.db";
+constexpr auto TEST_CONNECTION_POOL_FILE = "test_connection_pool.db";
 
 #ifdef SQLG_USE_REST
 // Test transport params
@@ -818,6 +827,21 @@ void removeTestFiles()
         }
     }
 
+    // Still open by the pool when testConnectionPool() returns
+    const auto poolFilePath = std::filesystem::absolute(TEST_CONNECTION_POOL_FILE);
+
+    if(std::filesystem::exists(poolFilePath))
+    {
+        try
+        {
+            std::filesystem::remove(poolFilePath);
+        }
+        catch(const std::exception& e)
+        {
+            std::cout << "Can't remove database file: " << poolFilePath << "(" << e.what() << ")" << std::endl;
+        }
+    }
+
     const auto exportBasePath = std::filesystem::absolute(TEST_EXPORT_FILE);
     std::vector<std::filesystem::path> exportPaths;
 
@@ -826,6 +850,7 @@ void removeTestFiles()
     exportPaths.emplace_back(exportBasePath.string() + ".xml");
     exportPaths.emplace_back(exportBasePath.string() + ".json");
     exportPaths.emplace_back(exportBasePath.string() + ".yaml");
+    exportPaths.emplace_back(exportBasePath.string() + ".ndjson");
 
     for(const auto & exportPath : exportPaths)
     {
@@ -924,6 +949,15 @@ void testConfigSaveLoad()
     showMessage(testName + " started...");
 
     LogConfig::Config config = getDefaultConfig();
+    config.sqliteJournalMode = "WAL";
+    config.sqliteSynchronous = "NORMAL";
+    config.sqliteCacheSize = -8192;
+    config.sqliteMmapSize = 134217728;
+    config.connectionPoolSize = 0;
+    config.timestampFormat = TimestampFormat::EpochMicros;
+    config.schemaLayout = SchemaLayout::Compact;
+    config.indexes = std::vector<LogIndex> { { FIELD_LOG_TIMESTAMP }, { FIELD_LOG_LEVEL, FIELD_LOG_TIMESTAMP } };
+    config.deferIndexes = true;
 
     saveConfig(config, LOG_DEFAULT_INI_FILENAME);
 
@@ -932,10 +966,15 @@ void testConfigSaveLoad()
     assert(loadedConfig.name == config.name);
     assert(loadedConfig.syncMode == config.syncMode);
     assert(loadedConfig.numThreads == config.numThreads);
+    assert(loadedConfig.connectionPoolSize == config.connectionPoolSize);
     assert(loadedConfig.onlyFileNames == config.onlyFileNames);
     assert(loadedConfig.minLogLevel == config.minLogLevel);
     assert(loadedConfig.databaseName == config.databaseName);
     assert(loadedConfig.databaseTable == config.databaseTable);
+    assert(loadedConfig.timestampFormat == config.timestampFormat);
+    assert(loadedConfig.schemaLayout == config.schemaLayout);
+    assert(loadedConfig.indexes == config.indexes);
+    assert(loadedConfig.deferIndexes == config.deferIndexes);
     assert(loadedConfig.databaseHost == config.databaseHost);
     assert(loadedConfig.databasePort == config.databasePort);
     assert(loadedConfig.databaseUser == config.databaseUser);
@@ -943,6 +982,15 @@ void testConfigSaveLoad()
     assert(loadedConfig.databaseType == config.databaseType);
     assert(loadedConfig.useBatch == config.useBatch);
     assert(loadedConfig.batchSize == config.batchSize);
+    assert(loadedConfig.useRing == config.useRing);
+    assert(loadedConfig.ringCapacity == config.ringCapacity);
+    assert(loadedConfig.backPressure == config.backPressure);
+    assert(loadedConfig.backPressureLevel == config.backPressureLevel);
+    assert(loadedConfig.sqliteJournalMode == config.sqliteJournalMode);
+    assert(loadedConfig.sqliteSynchronous == config.sqliteSynchronous);
+    assert(loadedConfig.sqliteCacheSize == config.sqliteCacheSize);
+    assert(loadedConfig.sqliteMmapSize == config.sqliteMmapSize);
+    assert(loadedConfig.sqlitePageSize == config.sqlitePageSize);
 #ifdef SQLG_USE_SOURCE_INFO
     assert(loadedConfig.sourceUuid == config.sourceUuid);
     assert(loadedConfig.sourceName == config.sourceName);
@@ -1102,6 +1150,7 @@ void testMultiConnectionStress()
 
         case DataBaseType::Mock:
         case DataBaseType::SQLite:
+        case DataBaseType::Memory:
         default:
         {
             std::cout << std::endl << "Skipping multi-connection test" << std::endl << std::endl;
@@ -1366,152 +1415,5072 @@ void testEntryConversion()
 }
 
 /**
- * @brief Cleanup function to shut down the logger.
+ * @brief Test lock-free ingestion ring with Block and DropNewest back-pressure policies.
  */
-void cleanup()
+void testRingIngestion()
 {
-    std::stringstream ss;
-    ss << "Shutdown " << (LogManager::getInstance().getCount() > 1
-                          ? "loggers: "
-                          : "logger: ");
+    std::string testName = "Ring Ingestion test";
+    showMessage(testName + " started...");
 
-    auto loggersConfig = LogManager::getInstance().getAllLoggersConfigs();
+    const int numThreads = 8;
+    const int logsPerThread = 500;
 
-    std::vector<std::string> loggers;
+    auto runProducers = [ & ](SQLogger & ringLogger)
+    {
+        std::vector<std::thread> threads;
+        for(int i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([ & ringLogger, i]()
+            {
+                for(int j = 0; j < logsPerThread; ++j)
+                {
+                    SQLOG_INFO(ringLogger) << "Ring thread " << i << ", log " << j;
+                }
+            });
+        }
+        for(auto & thread : threads)
+        {
+            thread.join();
+        }
+        ringLogger.flush();
+        ringLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC * 5));
+    };
 
-    for(auto & [name, config] : loggersConfig)
+    // Block: nothing may be lost
     {
-        loggers.emplace_back(name);
+        LogConfig::Config config = getTestConfig();
+        config.name = "ring_logger";
+        config.databaseTable = "ring_logs";
+        config.useBatch = true;
+        config.batchSize = 100;
+        config.useRing = true;
+        config.ringCapacity = 1024;
+        config.backPressure = BackPressure::Block;
+
+        SQLogger& ringLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+        ringLogger.clearLogs();
+        ringLogger.resetStats();
+
+        runProducers(ringLogger);
+
+        auto logs = ringLogger.getAllLogs();
+        assert(logs.size() == numThreads * logsPerThread);
+        assert(ringLogger.getStats().totalDropped == 0);
+
+        LogManager::getInstance().removeLogger(config.name.value());
     }
 
-    ss << StringHelper::join(loggers, ", ");
+    // DropNewest: every message is either written or counted as dropped
+    {
+        LogConfig::Config config = getTestConfig();
+        config.name = "ring_drop_logger";
+        config.databaseTable = "ring_drop_logs";
+        config.useBatch = true;
+        config.batchSize = 100;
+        config.useRing = true;
+        config.ringCapacity = 16;
+        config.backPressure = BackPressure::DropNewest;
+
+        SQLogger& ringLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+        ringLogger.clearLogs();
+        ringLogger.resetStats();
 
-    showMessage(ss.str());
-    LogManager::getInstance().removeAllLoggers();
+        runProducers(ringLogger);
+
+        auto logs = ringLogger.getAllLogs();
+        auto stats = ringLogger.getStats();
+        assert(logs.size() + stats.totalDropped == numThreads * logsPerThread);
+
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    showMessage(testName + " passed!\n");
 }
 
-int main(int argc, char* argv[])
+/**
+ * @brief Test time-based (FlushIntervalMs) and size-based (MaxBatchBytes) auto-flush in batch mode.
+ */
+void testAutoFlush()
 {
-    // Parse args
-    std::string configFile = [ & ]()
+    std::string testName = "Auto Flush test";
+    showMessage(testName + " started...");
+
+    const int numLogs = 5;
+
+    auto createFlushLogger = [](const std::string & name, const int flushIntervalMs, const int maxBatchBytes) -> SQLogger &
     {
-        if(argc > 1)
+        LogConfig::Config config = getTestConfig();
+        config.name = name;
+        config.databaseTable = name + "_logs";
+        config.useBatch = true;
+        config.batchSize = TEST_BATCH_SIZE;
+        config.flushIntervalMs = flushIntervalMs;
+        config.maxBatchBytes = maxBatchBytes;
+
+        SQLogger& flushLogger = LogManager::getInstance().createLogger(name, config
+#ifdef SQLG_USE_SOURCE_INFO
+                                , TEST_SOURCE_INFO
+#endif
+                                                                      );
+        flushLogger.clearLogs();
+        return flushLogger;
+    };
+
+    // Partial batch must reach the database after FlushIntervalMs without explicit flush()
+    {
+        SQLogger& flushLogger = createFlushLogger("interval_flush", 100, 0);
+        for(int i = 0; i < numLogs; ++i)
         {
-            std::string arg = argv[1];
-            if(arg == "-h" || arg == "--help")
-            {
-                std::cout << SQLOGGER_DESCRIPTION << std::endl;
-                std::cout << "Usage: " << argv[0] << " [config.ini]" << std::endl;
-                exit(0);
-            }
-            else if(arg == "-v" || arg == "--version")
-            {
-                std::cout << SQLOGGER_PROJECT_NAME << " v." << SQLOGGER_VERSION_FULL << std::endl;
-                exit(0);
-            }
-            return arg;
+            SQLOG_INFO(flushLogger) << "Interval flush log " << i;
         }
-        return std::string();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        flushLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
+
+        assert(flushLogger.getAllLogs().size() == numLogs);
+        LogManager::getInstance().removeLogger("interval_flush");
     }
-    ();
 
-    std::cout << SQLOGGER_PROJECT_NAME << " v." << SQLOGGER_VERSION_FULL << std::endl;
+    // An entry arriving while the timer idles must be flushed about one interval later, not two
+    {
+        const int intervalMs = 200;
+        SQLogger& flushLogger = createFlushLogger("idle_flush", intervalMs, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs / 4));
+
+        const auto start = std::chrono::steady_clock::now();
+        SQLOG_INFO(flushLogger) << "Idle flush log";
+        while(flushLogger.getAllLogs().empty()
+                && std::chrono::steady_clock::now() - start < std::chrono::milliseconds(intervalMs * 4))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
 
-    if(!configFile.empty())
-        std::cout << "Test config file: " << configFile << std::endl;
+        assert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(intervalMs * 2 - intervalMs / 10));
+        LogManager::getInstance().removeLogger("idle_flush");
+    }
 
-    LogConfig::Config config = getTestConfig(configFile);
+    // Buffer exceeding MaxBatchBytes must be flushed immediately
+    {
+        SQLogger& flushLogger = createFlushLogger("bytes_flush", 0, 1);
+        for(int i = 0; i < numLogs; ++i)
+        {
+            SQLOG_INFO(flushLogger) << "Bytes flush log " << i;
+        }
 
-    DataBaseType requestedDb = config.databaseType.value();
+        flushLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
 
-    if(!DataBaseHelper::isDataBaseSupported(requestedDb))
+        assert(flushLogger.getAllLogs().size() == numLogs);
+        LogManager::getInstance().removeLogger("bytes_flush");
+    }
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test group commit: several batches share one transaction that becomes visible on flush().
+ */
+void testGroupCommit()
+{
+    if(testConfig.databaseType.value() != DataBaseType::SQLite)
     {
-        std::cerr << "Requested database type " << DataBaseHelper::databaseTypeToString(requestedDb) <<  " not supported in this build";
-        return 1;
+        std::cout << std::endl << "Skipping group commit test" << std::endl << std::endl;
+        return;
     }
 
-    // Create logger
-    SQLogger& logger = getTestLogger(config);
+    std::string testName = "Group Commit test";
+    showMessage(testName + " started...");
 
-    std::string TEST_CONN_STRING =  LogConfig::configToConnectionString(config);
+    const int numLogs = 23;
+    const std::string countQuery = "SELECT COUNT(*) AS cnt FROM group_commit_logs";
 
-    // Getting database type
-    DataBaseType dbType = logger.getDataBaseType();
+    LogConfig::Config config = getTestConfig();
+    config.name = "group_commit";
+    config.databaseTable = "group_commit_logs";
+    config.useBatch = true;
+    config.syncMode = true;
+    config.batchSize = 10;
+    config.groupCommitBatches = 5;
 
-    // Getting string representation of the database type
-    std::stringstream dbTypeString;
-    dbTypeString << DataBaseHelper::databaseTypeToString(dbType);
+    SQLogger& groupLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    groupLogger.clearLogs();
 
-    std::cout << "Tested on: ";
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(groupLogger) << "Group commit log " << i;
+    }
 
-    switch(dbType)
+    // Written batches stay in the open transaction, invisible to other connections
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == 0);
+
+    groupLogger.flush();
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == numLogs);
+
+    verifyDb.disconnect();
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test that a failed batch inside an open group rolls back only itself.
+ */
+void testGroupCommitFailure()
+{
+    if(testConfig.databaseType.value() != DataBaseType::SQLite)
     {
-        case DataBaseType::Mock:
-            dbTypeString << " data";
-            break;
+        std::cout << std::endl << "Skipping group commit failure test" << std::endl << std::endl;
+        return;
+    }
 
-        case DataBaseType::SQLite:
-            dbTypeString << " database" << std::endl << "Database file: " << config.databaseName.value();
-            break;
+    std::string testName = "Group Commit Failure test";
+    showMessage(testName + " started...");
 
-        case DataBaseType::MySQL:
-        case DataBaseType::PostgreSQL:
-        case DataBaseType::MongoDB:
-            dbTypeString << " database" << std::endl << "Connection string: " << TEST_CONN_STRING;
-            break;
+    const int batchSize = 10;
+    const std::string countQuery = "SELECT COUNT(*) AS cnt FROM group_failure_logs";
 
-        default:
-            break;
+    LogConfig::Config config = getTestConfig();
+    config.name = "group_failure";
+    config.databaseTable = "group_failure_logs";
+    config.useBatch = true;
+    config.syncMode = true;
+    config.batchSize = batchSize;
+    config.groupCommitBatches = 5;
+
+    SQLogger& groupLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    groupLogger.clearLogs();
+
+    // Aborts the insert statement of the second batch, the transaction stays open
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    assert(verifyDb.execute("CREATE TRIGGER group_failure_reject BEFORE INSERT ON group_failure_logs "
+                            "WHEN NEW.message = 'Rejected' BEGIN SELECT RAISE(ABORT, 'rejected'); END;"));
+
+    for(int i = 0; i < batchSize; ++i)
+    {
+        SQLOG_INFO(groupLogger) << "Group failure log " << i;
+    }
+    for(int i = 0; i < batchSize; ++i)
+    {
+        SQLOG_INFO(groupLogger) << (i == batchSize / 2 ? std::string("Rejected") : "Group failure log " + std::to_string(batchSize + i));
+    }
+    for(int i = 0; i < batchSize; ++i)
+    {
+        SQLOG_INFO(groupLogger) << "Group failure log " << 2 * batchSize + i;
     }
 
-    std::cout << dbTypeString.str() << std::endl;
+    // The first and third batch are committed, only the second one failed
+    groupLogger.flush();
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == 2 * batchSize);
+    assert(std::stoi(verifyDb.query(countQuery + " WHERE message = 'Group failure log 0'").at(0).at("cnt")) == 1);
+    assert(groupLogger.getStats().totalFailed == static_cast<uint64_t>(batchSize));
 
-    // Getting logger name
-    std::string loggerName = logger.getName();
-    std::cout << "Logger name: " << loggerName << std::endl;
+    assert(verifyDb.execute("DROP TRIGGER group_failure_reject;"));
+    verifyDb.disconnect();
+    LogManager::getInstance().removeLogger(config.name.value());
 
-    // Getting sync mode
-    bool isSyncMode = logger.isSyncMode();
-    std::cout << "Sync Mode: " << (isSyncMode ? "ON" : "OFF") << std::endl;
-    std::cout << (isSyncMode ? "" : std::string("Number of threads: " + std::to_string(logger.getNumThreads()) + "\n"));
+    showMessage(testName + " passed!\n");
+}
 
-    // Getting use batch
-    bool useBatch = logger.isBatchEnabled();
-    std::cout << "Batch Insert: " << (useBatch ? "ON" : "OFF") << std::endl;
-    std::cout << (useBatch ?  std::string("Batch size: " + std::to_string(logger.getBatchSize()) + "\n") : "");
+/**
+ * @brief Test SQLite pragmas from config are applied on connect and reapplied on reconnect.
+ */
+void testSQLitePragmas()
+{
+    std::string testName = "SQLite Pragmas test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.sqliteJournalMode = "WAL";
+    config.sqliteSynchronous = "FULL";
+    config.sqliteCacheSize = -4096;
+    config.sqliteMmapSize = 0;
+    assert(config.validate().ok());
+
+    auto pragmaValue = [](SQLiteDatabase & db, const std::string & pragma)
+    {
+        return db.query("PRAGMA " + pragma + ";").at(0).at(pragma);
+    };
 
+    const std::string dbPath = "test_pragmas.db";
+    SQLiteDatabase db(dbPath, LogConfig::configToSQLitePragmas(config));
+
+    assert(LogHelper::toLowerCase(pragmaValue(db, "journal_mode")) == "wal");
+    assert(pragmaValue(db, "synchronous") == "2"); // FULL
+    assert(pragmaValue(db, "cache_size") == "-4096");
+
+    db.disconnect();
+    assert(db.connect(dbPath));
+    assert(pragmaValue(db, "synchronous") == "2");
+    assert(pragmaValue(db, "cache_size") == "-4096");
+
+    config.sqliteSynchronous = "SOMETIMES";
+    config.sqlitePageSize = 1000;
+    assert(!config.validate().ok());
+
+    db.disconnect();
+    std::filesystem::remove(dbPath);
+    std::filesystem::remove(dbPath + "-wal");
+    std::filesystem::remove(dbPath + "-shm");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test bulk-load helpers and batch INSERT fallback on backends without a bulk path.
+ */
+void testBulkLoad()
+{
+    std::string testName = "Bulk Load test";
+    showMessage(testName + " started...");
+
+    // COPY / LOAD DATA text encoding
+    const std::vector<std::string> values = { "a\tb", "line1\nline2", "back\\slash", "plain" };
+    assert(DataBaseHelper::encodeBulkRows(values, 2) == "a\\tb\tline1\\nline2\nback\\\\slash\tplain\n");
+
+    // Bulk path lifts the INSERT batch limit only for backends that have one
+    LogConfig::Config bulkConfig = getTestConfig();
+    bulkConfig.bulkLoadThreshold = 100;
+    bulkConfig.databaseType = DataBaseType::PostgreSQL;
+    assert(LogConfig::getMaxBatchSize(bulkConfig) == DB_MAX_BATCH_BULK);
+    bulkConfig.databaseType = DataBaseType::SQLite;
+    assert(LogConfig::getMaxBatchSize(bulkConfig) == DB_MAX_BATCH_SQLITE);
+
+    // Backends without bulkInsert() keep using batch INSERT
+    LogConfig::Config config = getTestConfig();
+    config.name = "bulk_load";
+    config.databaseTable = "bulk_load_logs";
+    config.useBatch = true;
+    config.batchSize = 10;
+    config.bulkLoadThreshold = 5;
+
+    SQLogger& bulkLogger = LogManager::getInstance().createLogger(config.name.value(), config
 #ifdef SQLG_USE_SOURCE_INFO
-    std::cout << "Source Info: ON" << std::endl;
-#else
-    std::cout << "Source Info: OFF" << std::endl;
+                           , TEST_SOURCE_INFO
 #endif
+                                                                 );
+    bulkLogger.clearLogs();
 
-#ifdef SQLG_USE_AES
-    std::cout << "AES Support: ON" << std::endl;
-#else
-    std::cout << "AES Support: OFF" << std::endl;
-#endif
+    const int numLogs = 25;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(bulkLogger) << "Bulk load log " << i;
+    }
+    bulkLogger.flush();
+    bulkLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
 
-    std::cout << std::endl;
+    assert(bulkLogger.getAllLogs().size() == numLogs);
+    LogManager::getInstance().removeLogger(config.name.value());
 
-    try
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test typed parameter binding through IDatabase::execute(query, DbParamList).
+ */
+void testTypedParams()
+{
+    std::string testName = "Typed Params test";
+    showMessage(testName + " started...");
+
+    SQLiteDatabase db("test_typed_params.db");
+    assert(db.execute("DROP TABLE IF EXISTS typed_params;"));
+    assert(db.execute("CREATE TABLE typed_params (num INTEGER, txt TEXT, opt TEXT);"));
+
+    const std::string message = "typed message";
+    const std::string_view prefix = std::string_view(message).substr(0, 5); // Not null-terminated
+
+    IDatabase& database = db;
+    assert(database.execute("INSERT INTO typed_params (num, txt, opt) VALUES (?, ?, ?);",
+                            { DbParam(int64_t(1) << 40), DbParam(message), DbParam() }));
+    assert(database.execute("INSERT INTO typed_params (num, txt, opt) VALUES (?, ?, ?);",
+                            { DbParam(-7), DbParam(prefix), DbParam(message) }));
+
+    auto rows = db.query("SELECT num, typeof(num) AS num_type, txt, opt IS NULL AS opt_null FROM typed_params ORDER BY rowid;");
+    assert(rows.size() == 2);
+    assert(rows[0].at("num") == std::to_string(int64_t(1) << 40));
+    assert(rows[0].at("num_type") == "integer");
+    assert(rows[0].at("txt") == message);
+    assert(rows[0].at("opt_null") == "1");
+    assert(rows[1].at("num") == "-7");
+    assert(rows[1].at("txt") == "typed");
+    assert(rows[1].at("opt_null") == "0");
+
+    db.disconnect();
+    std::filesystem::remove("test_typed_params.db");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test the columnar ResultSet and its SQLite query path.
+ */
+void testResultSet()
+{
+    std::string testName = "Result Set test";
+    showMessage(testName + " started...");
+
+    ResultSet manual;
+    manual.setColumns({ "id", "name" });
+    manual.appendValue("42");
+    manual.appendValue("first");
+    manual.appendValue("-3");
+    manual.appendNull();
+    assert(manual.rowCount() == 2);
+    assert(manual.columnCount() == 2);
+    assert(manual.columnIndex("name") == 1);
+    assert(manual.columnIndex("missing") == ResultSet::npos);
+    assert(manual.getInt(0, 0) == 42);
+    assert(manual.getInt64(1, 0) == -3);
+    assert(manual.getText(0, 1) == "first");
+    assert(manual.isNull(1, 1));
+    assert(manual.getInt(1, 1, 7) == 7);
+    assert(manual.getString(0, ResultSet::npos).empty());
+
+    auto rows = manual.toRows("NULL");
+    assert(rows.size() == 2);
+    assert(rows[1].at("name") == "NULL");
+    ResultSet roundTrip = ResultSet::fromRows(rows);
+    assert(roundTrip.rowCount() == 2);
+    assert(roundTrip.getText(0, roundTrip.columnIndex("name")) == "first");
+
+    SQLiteDatabase db("test_result_set.db");
+    assert(db.execute("DROP TABLE IF EXISTS result_set;"));
+    assert(db.execute("CREATE TABLE result_set (num INTEGER, txt TEXT);"));
+    const int rowCount = 100;
+    for(int i = 0; i < rowCount; ++i)
     {
-        testEncryptDecrypt();
-        testConfigSaveLoad();
-        testBasicFunctionality();
-        testFilterByLevel();
-        testFilterByFunction();
-        testFilterByThreadId();
-        testFilterByFile();
-        testFilterByTimestampRange();
-        testMultiFilters();
-        testLimitOffset();
+        const std::string text = "row " + std::to_string(i);
+        assert(db.execute("INSERT INTO result_set (num, txt) VALUES (?, ?);",
+                          DbParamList{ DbParam(i), i % 10 == 0 ? DbParam() : DbParam(text) }));
+    }
+
+    ResultSet result = db.queryResultSet("SELECT num, txt FROM result_set WHERE num >= ? ORDER BY num;", { "50" });
+    assert(result.rowCount() == rowCount - 50);
+    const size_t colNum = result.columnIndex("num");
+    const size_t colTxt = result.columnIndex("txt");
+    assert(colNum == 0 && colTxt == 1);
+    for(size_t row = 0; row < result.rowCount(); ++row)
+    {
+        const int num = result.getInt(row, colNum);
+        assert(num == 50 + static_cast<int>(row));
+        if(num % 10 == 0)
+        {
+            assert(result.isNull(row, colTxt));
+        }
+        else
+        {
+            assert(result.getText(row, colTxt) == "row " + std::to_string(num));
+        }
+    }
+
+    assert(db.queryResultSet("SELECT num FROM result_set WHERE num < 0;").empty());
+
+    db.disconnect();
+    std::filesystem::remove("test_result_set.db");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test streaming log scans with forEachLog and keyset pagination.
+ */
+void testLogCursor()
+{
+    std::string testName = "Log Cursor test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "log_cursor";
+    config.databaseTable = "log_cursor_logs";
+
+    SQLogger& cursorLogger = LogManager::getInstance().createLogger(config.name.value(), config
 #ifdef SQLG_USE_SOURCE_INFO
-        testSourceInfo();
-        testGetSourceByUuid();
-        testGetAllSources();
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+    cursorLogger.clearLogs();
+
+    const int numLogs = 250;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        if(i % 5 == 0)
+        {
+            SQLOG_WARNING(cursorLogger) << "Cursor log " << i;
+        }
+        else
+        {
+            SQLOG_INFO(cursorLogger) << "Cursor log " << i;
+        }
+    }
+    cursorLogger.flush();
+    cursorLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
+
+    // Single streamed query and keyset pages visit the same entries in ID order
+    for(const int pageSize : { 0, 64, 50 })
+    {
+        int lastId = 0;
+        size_t count = 0;
+        const size_t visited = cursorLogger.forEachLog({}, [ & ](const LogEntry & entry)
+        {
+            assert(entry.id > lastId);
+            assert(entry.message == "Cursor log " + std::to_string(count));
+#ifdef SQLG_USE_SOURCE_INFO
+            assert(entry.sourceName == TEST_SOURCE_INFO.name);
+#endif
+            lastId = entry.id;
+            ++count;
+            return true;
+        }, pageSize);
+        assert(visited == numLogs);
+        assert(count == numLogs);
+    }
+
+    // Early stop
+    size_t stopCount = 0;
+    assert(cursorLogger.forEachLog({}, [ & ](const LogEntry&)
+    {
+        return ++stopCount < 10;
+    }, 4) == 10);
+    assert(stopCount == 10);
+
+    // Resume after a known ID
+    int resumeId = 0;
+    size_t seen = 0;
+    cursorLogger.forEachLog({}, [ & ](const LogEntry & entry)
+    {
+        resumeId = entry.id;
+        return ++seen < 100;
+    });
+    assert(cursorLogger.forEachLog({}, [](const LogEntry&)
+    {
+        return true;
+    }, 32, resumeId) == numLogs - 100);
+
+    // Filters are combined with the keyset condition
+    Filter filter;
+    filter.type = Filter::Type::Level;
+    filter.field = filter.typeToField();
+    filter.op = "=";
+    filter.value = levelToString(LogLevel::Warning);
+    assert(cursorLogger.forEachLog({ filter }, [](const LogEntry & entry)
+    {
+        return entry.level == levelToString(LogLevel::Warning);
+    }, 7) == numLogs / 5);
+
+    // Pages are passed to the callback after the database lock is released, so it may log
+    size_t logged = 0;
+    assert(cursorLogger.forEachLog({}, [ & ](const LogEntry&)
+    {
+        SQLOG_INFO(cursorLogger) << "Logged from a scan";
+        return ++logged < 20;
+    }, 8) == 20);
+    cursorLogger.flush();
+
+    // A failing query is reported, not taken for the end of the scan
+    if(testConfig.databaseType.value() == DataBaseType::SQLite)
+    {
+        SQLiteDatabase renameDb(config.databaseName.value());
+        renameDb.connect(config.databaseName.value());
+        assert(renameDb.execute("ALTER TABLE log_cursor_logs RENAME TO log_cursor_moved;"));
+
+        for(const int pageSize : { 0, 16 })
+        {
+            bool failed = false;
+            try
+            {
+                cursorLogger.forEachLog({}, [](const LogEntry&)
+                {
+                    return true;
+                }, pageSize);
+            }
+            catch(const std::runtime_error&)
+            {
+                failed = true;
+            }
+            assert(failed);
+        }
+
+        assert(renameDb.execute("ALTER TABLE log_cursor_moved RENAME TO log_cursor_logs;"));
+        renameDb.disconnect();
+    }
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+#ifdef SQLG_USE_SOURCE_INFO
+/**
+ * @class SourceCountingDatabase
+ * @brief SQLite database that counts queries against the sources table.
+ */
+class SourceCountingDatabase : public SQLiteDatabase
+{
+    public:
+        using SQLiteDatabase::SQLiteDatabase;
+
+        ResultSet queryResultSet(const std::string& query,
+                                 const std::vector<std::string> & params = {}) override
+        {
+            if(query.find(SOURCES_TABLE_NAME) != std::string::npos)
+            {
+                ++sourceQueries;
+            }
+            return SQLiteDatabase::queryResultSet(query, params);
+        }
+
+        int sourceQueries = 0; /**< Number of sources table queries. */
+};
+
+/**
+ * @brief Test that LogReader resolves each distinct source once per query.
+ */
+void testSourceLookup()
+{
+    std::string testName = "Source Lookup test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.databaseTable = "source_lookup_logs";
+
+    SourceInfo otherSource;
+    otherSource.sourceId = 0;
+    otherSource.name = "other_source";
+    otherSource.uuid = "9b1f4c7e-2d3a-4e5f-8a6b-0c1d2e3f4a5b";
+
+    config.name = "source_lookup_main";
+    SQLogger& mainLogger = LogManager::getInstance().createLogger(config.name.value(), config, TEST_SOURCE_INFO);
+    mainLogger.clearLogs();
+    config.name = "source_lookup_other";
+    SQLogger& otherLogger = LogManager::getInstance().createLogger(config.name.value(), config, otherSource);
+
+    const int numLogs = 20;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(mainLogger) << "main";
+        SQLOG_INFO(otherLogger) << "other";
+    }
+    mainLogger.flush();
+    otherLogger.flush();
+    mainLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
+    otherLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
+
+    SourceCountingDatabase db(config.databaseName.value());
+    LogReader reader(db, config.databaseTable.value());
+    auto logs = reader.getLogsByFilters({});
+    assert(logs.size() == 2 * numLogs);
+    assert(db.sourceQueries == 2);
+    for(const auto & entry : logs)
+    {
+        assert(entry.sourceName == (entry.message == "main" ? TEST_SOURCE_INFO.name : otherSource.name));
+    }
+
+    LogManager::getInstance().removeLogger("source_lookup_other");
+    LogManager::getInstance().removeLogger("source_lookup_main");
+
+    showMessage(testName + " passed!\n");
+}
+#endif
+
+/**
+ * @brief Test the work-stealing ThreadPool and the coalesced asynchronous write path.
+ */
+void testThreadPool()
+{
+    std::string testName = "Thread Pool test";
+    showMessage(testName + " started...");
+
+    {
+        ThreadPool pool(4);
+        std::atomic<int> counter{ 0 };
+
+        // Move-only capture, inline and heap-stored callables, nested enqueue from a worker
+        auto owned = std::make_unique<int>(5);
+        pool.enqueue([ &counter, value = std::move(owned)]()
+        {
+            counter += * value;
+        });
+
+        std::array<char, THREAD_POOL_TASK_INLINE_SIZE * 2> large{};
+        large[0] = 3;
+        pool.enqueue([ &counter, large]()
+        {
+            counter += large[0];
+        });
+
+        pool.enqueue([ &counter, &pool]()
+        {
+            pool.enqueue([ &counter]()
+            {
+                counter += 2;
+            });
+        });
+
+        std::vector<std::thread> producers;
+        for(int t = 0; t < 4; ++t)
+        {
+            producers.emplace_back([ &pool, &counter]()
+            {
+                for(int i = 0; i < 1000; ++i)
+                {
+                    pool.enqueue([ &counter]()
+                    {
+                        counter++;
+                    });
+                }
+            });
+        }
+        for(auto & producer : producers)
+        {
+            producer.join();
+        }
+
+        pool.waitForCompletion();
+        assert(pool.isQueueEmpty());
+        assert(counter == 5 + 3 + 2 + 4000);
+    }
+
+    // Asynchronous non-batch logging drains queued entries into batch writes
+    LogConfig::Config config = getTestConfig();
+    config.name = "thread_pool";
+    config.databaseTable = "thread_pool_logs";
+    config.syncMode = false;
+    config.useBatch = false;
+    config.numThreads = 4;
+
+    SQLogger& asyncLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    asyncLogger.clearLogs();
+
+    const int numThreads = 4;
+    const int logsPerThread = 250;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([ &asyncLogger, t]()
+        {
+            for(int i = 0; i < logsPerThread; ++i)
+            {
+                SQLOG_INFO(asyncLogger) << "Async log " << t << ":" << i;
+            }
+        });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    assert(asyncLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC * 10)));
+    assert(asyncLogger.getAllLogs().size() == numThreads * logsPerThread);
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test ConnectionPool lazy opening, blocking, invalidation and health checks.
+ */
+void testConnectionPool()
+{
+    std::string testName = "Connection Pool test";
+    showMessage(testName + " started...");
+
+    std::atomic<int> opened{ 0 };
+    ConnectionPool pool(2, [ &opened]()
+    {
+        opened++;
+        return std::make_unique<SQLiteDatabase>(TEST_CONNECTION_POOL_FILE);
+    }, std::chrono::milliseconds(0));
+
+    // Connections are opened lazily
+    assert(pool.getMaxSize() == 2);
+    assert(pool.getOpenCount() == 0);
+
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        assert(opened == 2);
+        assert(pool.getOpenCount() == 2);
+
+        // A third caller waits for a returned connection
+        std::atomic<bool> acquired{ false };
+        std::thread waiter([ &]()
+        {
+            auto third = pool.acquire();
+            acquired = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(!acquired);
+
+        first.invalidate();
+        {
+            auto released = std::move(first);
+        }
+        waiter.join();
+        assert(acquired);
+        assert(opened == 3); // Invalidated connection was reopened
+    }
+
+    // Idle connections are reused (and pinged, as the interval is 0)
+    {
+        auto lease = pool.acquire();
+        assert(lease.get().execute("SELECT 1"));
+        assert(opened == 3);
+
+        // Broken connections are reopened on the next acquire
+        lease.get().disconnect();
+    }
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        assert(first.get().isConnected() && second.get().isConnected());
+        assert(opened == 4);
+    }
+
+    // Pooling is rejected for SQLite
+    LogConfig::Config config = getTestConfig();
+    config.connectionPoolSize = 2;
+    assert(!config.validate().ok());
+    config.connectionPoolSize = 0;
+    assert(config.validate().ok());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test DrainTracker out-of-order completion and SQLogger::waitUntilDurable().
+ */
+void testDrainTracker()
+{
+    std::string testName = "Drain Tracker test";
+    showMessage(testName + " started...");
+
+    {
+        DrainTracker tracker;
+        assert(tracker.waitFor(tracker.submitted(), std::chrono::milliseconds(0)));
+
+        const uint64_t first = tracker.submit(3);
+        const uint64_t last = tracker.submit();
+        assert(first == 0 && last == 3);
+
+        // Later entries complete first: the prefix only moves once the gap closes
+        tracker.complete(last);
+        tracker.complete(first + 1, 2);
+        assert(tracker.completed() == 0);
+        assert(!tracker.waitFor(tracker.submitted(), std::chrono::milliseconds(10)));
+
+        std::thread writer([ &tracker, first]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            tracker.complete(first);
+        });
+        assert(tracker.waitFor(tracker.submitted(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+        assert(tracker.completed() == 4);
+        writer.join();
+    }
+
+    if(testConfig.databaseType.value() == DataBaseType::SQLite)
+    {
+        const int numLogs = 37;
+        const std::string countQuery = "SELECT COUNT(*) AS cnt FROM drain_logs";
+
+        LogConfig::Config config = getTestConfig();
+        config.name = "drain";
+        config.databaseTable = "drain_logs";
+        config.useBatch = true;
+        config.syncMode = false;
+        config.batchSize = 10;
+        config.groupCommitBatches = 100;
+        config.groupCommitWindowMs = 0;
+        config.flushIntervalMs = 0;
+
+        SQLogger& drainLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                                , TEST_SOURCE_INFO
+#endif
+                                                                      );
+        drainLogger.clearLogs();
+
+        for(int i = 0; i < numLogs; ++i)
+        {
+            SQLOG_INFO(drainLogger) << "Drain log " << i;
+        }
+
+        // Buffered and group-committed entries become visible to other connections
+        assert(drainLogger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+        SQLiteDatabase verifyDb(config.databaseName.value());
+        verifyDb.connect(config.databaseName.value());
+        assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == numLogs);
+        verifyDb.disconnect();
+
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test LogMessage formatting through reused per-thread streams.
+ */
+void testLogStream()
+{
+    std::string testName = "Log Stream test";
+    showMessage(testName + " started...");
+
+    {
+        auto stream = LogStream::acquire();
+        stream->stream() << std::hex << 255;
+        assert(stream->view() == "ff");
+        LogStream* reused = stream.get();
+        LogStream::release(std::move(stream));
+
+        // Released streams come back empty and with default formatting
+        stream = LogStream::acquire();
+        assert(stream.get() == reused);
+        stream->stream() << 255;
+        assert(stream->view() == "255");
+
+        const std::string longText(LOG_STREAM_INLINE_SIZE * 3 + 7, 'x');
+        stream->stream() << "head:" << longText << ":tail";
+        assert(stream->view() == "255head:" + longText + ":tail");
+        LogStream::release(std::move(stream));
+    }
+
+    assert(currentThreadId() == threadIdToString(std::this_thread::get_id()));
+    assert(FSHelper::toFilenameView("dir/sub\\file.cpp") == "file.cpp");
+    assert(FSHelper::toFilenameView("file.cpp") == "file.cpp");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "log_stream";
+    config.databaseTable = "log_stream_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+
+    SQLogger& streamLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+    streamLogger.clearLogs();
+
+    // A message logged while another one is being formatted takes its own stream
+    struct Nested
+    {
+        SQLogger& logger;
+    };
+    auto nestedText = [](const Nested & nested)
+    {
+        SQLOG_DEBUG(nested.logger) << "inner " << 1;
+        return "outer";
+    };
+    SQLOG_INFO(streamLogger) << nestedText(Nested{ streamLogger }) << " " << 2;
+
+    const std::string longMessage(LOG_STREAM_INLINE_SIZE + 1, 'y');
+    SQLOG_WARNING(streamLogger) << longMessage;
+
+    LogEntryList entries = streamLogger.getAllLogs();
+    assert(entries.size() == 3);
+    assert(entries[0].message == "inner 1");
+    assert(entries[1].message == "outer 2");
+    assert(entries[1].threadId == currentThreadId());
+    assert(entries[2].message == longMessage);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test that disabled SQLOG_* calls do not evaluate their operands.
+ */
+void testLevelCheck()
+{
+    std::string testName = "Level Check test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "level_check";
+    config.databaseTable = "level_check_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+    config.minLogLevel = LogLevel::Info;
+
+    SQLogger& levelLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    levelLogger.clearLogs();
+
+    int evaluated = 0;
+    auto expensive = [ &evaluated]()
+    {
+        return ++evaluated;
+    };
+
+    assert(!levelLogger.isLevelEnabled(LogLevel::Debug));
+    assert(levelLogger.isLevelEnabled(LogLevel::Warning));
+
+    SQLOG_DEBUG(levelLogger) << "Skipped " << expensive();
+    assert(evaluated == 0);
+
+    // Expands to a complete if/else, so it nests safely in unbraced branches
+    if(evaluated == 0)
+        SQLOG_INFO(levelLogger) << "Logged " << expensive();
+    else
+        assert(false);
+    assert(evaluated == 1);
+
+    levelLogger.setLogLevel(LogLevel::Debug);
+    assert(levelLogger.getMinLogLevel() == LogLevel::Debug);
+    assert(levelLogger.getConfig().minLogLevel.value() == LogLevel::Debug);
+    SQLOG_DEBUG(levelLogger) << "Logged " << expensive();
+    assert(evaluated == 2);
+
+    assert(levelLogger.getAllLogs().size() == 2);
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test the fmt-style logging API and LogArgs formatting.
+ */
+void testFormatApi()
+{
+    std::string testName = "Format API test";
+    showMessage(testName + " started...");
+
+    const std::string name = "alice";
+    assert(LogArgs::pack(42, name, 2.5, true, 'x').format("user {} ({}) took {} ms, ok={} {}") == "user 42 (alice) took 2.5 ms, ok=true x");
+    assert(LogArgs::pack(-7, 18446744073709551615ULL).format("{:>8} {}") == "-7 18446744073709551615");
+    assert(LogArgs::pack(1).format("{{}} {} {} }}") == "{} 1 {} }");
+    assert(LogArgs::pack(LogLevel::Error, std::string_view("view"), static_cast<const char*>(nullptr)).format("{} {} {}") == "4 view (null)");
+    assert(LogArgs::pack().format("no {args") == "no {args");
+    assert(!LogArgs().isActive());
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "format_api";
+    config.databaseTable = "format_api_logs";
+    config.syncMode = false;
+    config.useBatch = true;
+    config.batchSize = 4;
+    config.minLogLevel = LogLevel::Info;
+
+    SQLogger& formatLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+    formatLogger.clearLogs();
+
+    const int numLogs = 10;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        formatLogger.info("request {} took {} ms", i, i * 1.5);
+    }
+    formatLogger.debug("filtered {}", 0);
+    formatLogger.error(std::string("plain {{text}}"));
+    const int line = __LINE__ - 1;
+
+    assert(formatLogger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    LogEntryList entries = formatLogger.getAllLogs();
+    assert(entries.size() == numLogs + 1);
+
+    // Batches are written in parallel: match messages regardless of row order
+    for(int i = 0; i < numLogs; ++i)
+    {
+        std::ostringstream expected;
+        expected << "request " << i << " took " << i * 1.5 << " ms";
+        assert(std::any_of(entries.begin(), entries.end(), [ & ](const LogEntry & entry)
+        {
+            return entry.message == expected.str();
+        }));
+    }
+
+    auto lastIt = std::find_if(entries.begin(), entries.end(), [](const LogEntry & entry)
+    {
+        return entry.level == levelToString(LogLevel::Error);
+    });
+    assert(lastIt != entries.end());
+    const LogEntry& last = * lastIt;
+    assert(last.message == "plain {text}");
+    assert(last.level == levelToString(LogLevel::Error));
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+    assert(last.function == __func__);
+    assert(last.line == line);
+    assert(last.file.find("test_logger.cpp") != std::string::npos);
+#endif
+    (void)line;
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test integer epoch microsecond timestamps (TimestampFormat::EpochMicros).
+ */
+void testEpochTimestamps()
+{
+    std::string testName = "Epoch Timestamps test";
+    showMessage(testName + " started...");
+
+    const int64_t sample = toEpochMicros(std::chrono::system_clock::now());
+    const std::string sampleText = formatEpochMicros(sample);
+    assert(sampleText.size() == std::string("YYYY-MM-DD HH:MM:SS.ffffff").size());
+    assert(parseEpochMicros(sampleText) == sample);
+    assert(parseEpochMicros(std::to_string(sample)) == sample);
+    assert(parseEpochMicros(sampleText.substr(0, sampleText.find('.'))) == sample - sample % 1000000);
+    assert(!parseEpochMicros("not a time").has_value());
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "epoch_timestamps";
+    config.databaseTable = "epoch_timestamps_logs";
+    config.syncMode = false;
+    config.useBatch = false;
+    config.timestampFormat = TimestampFormat::EpochMicros;
+
+    SQLogger& epochLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    epochLogger.clearLogs();
+
+    // Entries logged within the same second keep their order and distinct times
+    const int64_t before = toEpochMicros(std::chrono::system_clock::now());
+    SQLOG_INFO(epochLogger) << "First";
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    const int64_t middle = toEpochMicros(std::chrono::system_clock::now());
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    SQLOG_INFO(epochLogger) << "Second";
+    const int64_t after = toEpochMicros(std::chrono::system_clock::now());
+    assert(epochLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    LogEntryList entries = epochLogger.getAllLogs();
+    assert(entries.size() == 2);
+    for(const auto & entry : entries)
+    {
+        assert(entry.timestampUs >= before && entry.timestampUs <= after);
+        assert(entry.timestamp == formatEpochMicros(entry.timestampUs));
+    }
+
+    // Range filters accept text (with or without a fraction) or microseconds
+    LogEntryList later = epochLogger.getLogsByTimestampRange(formatEpochMicros(middle), formatEpochMicros(after + 1));
+    assert(later.size() == 1 && later.front().message == "Second");
+    later = epochLogger.getLogsByTimestampRange(std::to_string(middle), std::to_string(after + 1));
+    assert(later.size() == 1 && later.front().message == "Second");
+
+    bool rejected = false;
+    try
+    {
+        epochLogger.getLogsByTimestampRange("bad", "value");
+    }
+    catch(const std::invalid_argument&)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test the compact schema (integer level, dictionary-encoded function/file/thread ID).
+ */
+void testCompactSchema()
+{
+    std::string testName = "Compact Schema test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "compact_schema";
+    config.databaseTable = "compact_schema_logs";
+    config.syncMode = false;
+    config.useBatch = true;
+    config.batchSize = 4;
+    config.schemaLayout = SchemaLayout::Compact;
+
+    SQLogger& compactLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                              , TEST_SOURCE_INFO
+#endif
+                                                                    );
+    compactLogger.clearLogs();
+
+    for(int i = 0; i < 10; ++i)
+    {
+        SQLOG_INFO(compactLogger) << "Info " << i;
+    }
+    SQLOG_WARNING(compactLogger) << "Warning";
+    SQLOG_ERROR(compactLogger) << "Error";
+    compactLogger.flush();
+    assert(compactLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    // Values are decoded when read
+    LogEntryList entries = compactLogger.getAllLogs();
+    assert(entries.size() == 12);
+    const std::string function = entries.front().function;
+    const std::string threadId = entries.front().threadId;
+    for(const auto & entry : entries)
+    {
+        assert(!entry.function.empty() && entry.function == function);
+        assert(!entry.file.empty());
+        assert(entry.threadId == threadId);
+    }
+
+    // Filters are converted to levels and dictionary ids
+    assert(compactLogger.getLogsByLevel(LogLevel::Info).size() == 10);
+    assert(compactLogger.getLogsByFilters({ {Filter::Type::Level, FIELD_LOG_LEVEL, ">=", LOG_LEVEL_WARNING} }).size() == 2);
+    assert(compactLogger.getLogsByFunction(function).size() == 12);
+    assert(compactLogger.getLogsByThreadId(threadId).size() == 12);
+    assert(compactLogger.getLogsByFile(entries.front().file).size() == 12);
+    assert(compactLogger.getLogsByFile("no_such_file.cpp").empty());
+    assert(compactLogger.getLogsByFilters({ {Filter::Type::File, FIELD_LOG_FILE, "!=", "no_such_file.cpp"} }).size() == 12);
+
+    bool rejected = false;
+    try
+    {
+        compactLogger.getLogsByFilters({ {Filter::Type::File, FIELD_LOG_FILE, "LIKE", "%.cpp"} });
+    }
+    catch(const std::invalid_argument&)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    // A new logger decodes existing rows after loading the dictionaries
+    SQLogger& reopenedLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+    entries = reopenedLogger.getLogsByLevel(LogLevel::Error);
+    assert(entries.size() == 1);
+    assert(entries.front().message == "Error" && entries.front().function == function && entries.front().threadId == threadId);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test configurable indexes and bulk-load mode (dropped and rebuilt indexes).
+ */
+void testIndexConfig()
+{
+    std::string testName = "Index Config test";
+    showMessage(testName + " started...");
+
+    const auto parsed = LogConfig::stringToIndexes(" timestamp, level+timestamp ");
+    assert(parsed.has_value() && parsed->size() == 2);
+    assert(parsed->at(1) == LogIndex({ FIELD_LOG_LEVEL, FIELD_LOG_TIMESTAMP }));
+    assert(LogConfig::indexesToString(parsed.value()) == "timestamp,level+timestamp");
+    assert(LogConfig::stringToIndexes("").has_value() && LogConfig::stringToIndexes("")->empty());
+    assert(!LogConfig::stringToIndexes("level+message").has_value());
+    assert(!LogConfig::stringToIndexes("level);DROP TABLE logs;--").has_value());
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "index_config";
+    config.databaseTable = "index_config_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+    config.indexes = LogConfig::stringToIndexes("level+timestamp,thread_id");
+    config.deferIndexes = true;
+
+    const std::string indexQuery = "SELECT name FROM sqlite_master WHERE type = 'index' AND name LIKE 'idx_"
+                                   + config.databaseTable.value() + "_%'";
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+
+    SQLogger& indexLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+
+    // Deferred: the table starts without secondary indexes
+    assert(verifyDb.query(indexQuery).empty());
+
+    for(int i = 0; i < 10; ++i)
+    {
+        SQLOG_INFO(indexLogger) << "Backfill " << i;
+    }
+    assert(indexLogger.endBulkLoad());
+
+    auto indexes = verifyDb.query(indexQuery);
+    assert(indexes.size() == 2);
+    for(const auto & row : indexes)
+    {
+        const std::string& name = row.at("name");
+        assert(name == "idx_index_config_logs_level_timestamp" || name == "idx_index_config_logs_thread_id");
+    }
+
+    assert(indexLogger.beginBulkLoad());
+    assert(verifyDb.query(indexQuery).empty());
+    SQLOG_INFO(indexLogger) << "Backfill without indexes";
+    assert(indexLogger.endBulkLoad());
+    assert(verifyDb.query(indexQuery).size() == 2);
+    assert(indexLogger.getLogsByLevel(LogLevel::Info).size() == 11);
+
+    verifyDb.disconnect();
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests streaming export from the database with parallel formatting.
+ */
+void testStreamingExport()
+{
+    std::string testName = "Streaming Export test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "streaming_export";
+    config.databaseTable = "streaming_export_logs";
+
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    verifyDb.disconnect();
+
+    SQLogger& exportLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+
+    // More than one chunk, so several chunks are formatted concurrently
+    const size_t count = LOG_EXPORT_CHUNK_SIZE * 2 + 100;
+    for(size_t i = 0; i < count; ++i)
+    {
+        SQLOG_INFO(exportLogger) << "Export \"" << i << "\"\n";
+    }
+    assert(exportLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC * 10)));
+    exportLogger.flush();
+
+    LogEntryList allLogs = exportLogger.getAllLogs();
+    assert(allLogs.size() == count);
+    std::sort(allLogs.begin(), allLogs.end(), [](const LogEntry & a, const LogEntry & b)
+    {
+        return a.id < b.id;
+    });
+
+    auto readFile = [](const std::string & filePath)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    const std::string basePath = std::filesystem::absolute(TEST_EXPORT_FILE).string() + "_stream";
+    const std::array<std::pair<LogExport::Format, std::string>, 7> formats =
+    {
+        {
+            {LogExport::Format::TXT, ".txt"},
+            {LogExport::Format::CSV, ".csv"},
+            {LogExport::Format::XML, ".xml"},
+            {LogExport::Format::JSON, ".json"},
+            {LogExport::Format::YAML, ".yaml"},
+            {LogExport::Format::NDJSON, ".ndjson"},
+            {LogExport::Format::BINARY, ".sqlb"}
+        }
+    };
+
+    for(const auto & [format, extension] : formats)
+    {
+        const std::string listPath = basePath + "_list" + extension;
+        const std::string parallelPath = basePath + "_parallel" + extension;
+        const std::string inlinePath = basePath + "_inline" + extension;
+
+        SQLogger::exportTo(listPath, format, allLogs);
+        assert(exportLogger.exportLogs(parallelPath, format) == count);
+        assert(exportLogger.exportLogs(inlinePath, format, {}, ENTRY_DELIMITER, true, 0) == count);
+
+        const std::string expected = readFile(listPath);
+        assert(!expected.empty());
+        assert(readFile(parallelPath) == expected);
+        assert(readFile(inlinePath) == expected);
+
+        std::filesystem::remove(listPath);
+        std::filesystem::remove(parallelPath);
+        std::filesystem::remove(inlinePath);
+    }
+
+    // Filters are applied by the database
+    const std::vector<Filter> filters = { {Filter::Type::Level, FIELD_LOG_LEVEL, "=", LOG_LEVEL_ERROR} };
+    assert(exportLogger.exportLogs(basePath + "_empty.json", LogExport::Format::JSON, filters) == 0);
+    assert(readFile(basePath + "_empty.json") == "[\n]\n");
+    std::filesystem::remove(basePath + "_empty.json");
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests compressed export (one gzip member / zstd frame per chunk).
+ */
+void testCompressedExport()
+{
+    std::string testName = "Compressed Export test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "compressed_export";
+    config.databaseTable = "compressed_export_logs";
+
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    verifyDb.disconnect();
+
+    SQLogger& exportLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+
+    const size_t count = LOG_EXPORT_CHUNK_SIZE + 100;
+    for(size_t i = 0; i < count; ++i)
+    {
+        SQLOG_INFO(exportLogger) << "Compressed export " << i;
+    }
+    assert(exportLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC * 10)));
+    exportLogger.flush();
+
+    auto readFile = [](const std::string & filePath)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    const std::string basePath = std::filesystem::absolute(TEST_EXPORT_FILE).string() + "_compressed";
+    assert(exportLogger.exportLogs(basePath + ".csv", LogExport::Format::CSV) == count);
+    const std::string plain = readFile(basePath + ".csv");
+
+    for(const auto compression : { LogCompress::Compression::Gzip, LogCompress::Compression::Zstd })
+    {
+        const std::string filePath = basePath + ".csv" + LogCompress::extension(compression);
+        if(!LogCompress::isSupported(compression))
+        {
+            bool thrown = false;
+            try
+            {
+                exportLogger.exportLogs(filePath, LogExport::Format::CSV, {}, ENTRY_DELIMITER, true, 2, compression);
+            }
+            catch(const std::runtime_error&)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+            continue;
+        }
+
+        assert(exportLogger.exportLogs(filePath, LogExport::Format::CSV, {}, ENTRY_DELIMITER, true, 2, compression) == count);
+        const std::string compressed = readFile(filePath);
+        assert(compressed.size() < plain.size());
+        assert(LogCompress::decompress(compressed, compression) == plain);
+
+        // An empty export is still a valid compressed file
+        const std::string emptyPath = basePath + "_empty.json" + LogCompress::extension(compression);
+        SQLogger::exportTo(emptyPath, LogExport::Format::JSON, {}, ENTRY_DELIMITER, true, compression);
+        assert(LogCompress::decompress(readFile(emptyPath), compression) == "[\n]\n");
+
+        std::filesystem::remove(filePath);
+        std::filesystem::remove(emptyPath);
+    }
+    std::filesystem::remove(basePath + ".csv");
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests NDJSON (JSON Lines) export and incremental parsing.
+ */
+void testNdjson()
+{
+    std::string testName = "NDJSON test";
+    showMessage(testName + " started...");
+
+    LogEntryList entries;
+    for(int i = 0; i < 100; ++i)
+    {
+        LogEntry entry;
+        entry.id = i + 1;
+        entry.timestamp = "2025-01-01 12:00:00.000";
+        entry.level = LogHelper::levelToString(i % 2 == 0 ? LogLevel::Info : LogLevel::Error);
+        entry.message = i == 0 ? "multi\nline\tmessage" : "NDJSON message " + std::to_string(i);
+        entry.function = "testNdjson";
+        entry.file = "file_" + std::to_string(i % 10) + ".cpp";
+        entry.line = i;
+        entry.threadId = "12345";
+#ifdef SQLG_USE_SOURCE_INFO
+        entry.sourceId = 1;
+        entry.sourceUuid = TEST_SOURCE_UUID;
+        entry.sourceName = TEST_SOURCE_NAME;
+#endif
+        entries.push_back(entry);
+    }
+
+    // One line per entry, even for messages with line breaks
+    const std::string lines = LogSerializer::Json::serializeLogLines(entries);
+    assert(static_cast<size_t>(std::count(lines.begin(), lines.end(), '\n')) == entries.size());
+    assert(LogSerializer::Json::serializeLogLine(entries[0]).find('\n') == std::string::npos);
+
+    const LogEntryList parsed = LogSerializer::Json::parseLogLines(lines);
+    assert(parsed.size() == entries.size());
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        assert(parsed[i].id == entries[i].id);
+        assert(parsed[i].timestamp == entries[i].timestamp);
+        assert(parsed[i].level == entries[i].level);
+        assert(parsed[i].message == entries[i].message);
+        assert(parsed[i].file == entries[i].file);
+        assert(parsed[i].line == entries[i].line);
+        assert(parsed[i].threadId == entries[i].threadId);
+#ifdef SQLG_USE_SOURCE_INFO
+        assert(parsed[i].sourceId == entries[i].sourceId);
+        assert(parsed[i].sourceUuid == entries[i].sourceUuid);
+#endif
+    }
+
+    // Export and read the file back line by line, stopping early
+    const std::string filePath = std::filesystem::absolute(TEST_EXPORT_FILE).string() + ".ndjson";
+    SQLogger::exportTo(filePath, LogExport::Format::NDJSON, entries);
+
+    std::ifstream input(filePath);
+    int lastId = 0;
+    const size_t visited = LogSerializer::Json::parseLogLines(input, [ & lastId](const LogEntry & entry)
+    {
+        assert(entry.id == lastId + 1);
+        lastId = entry.id;
+        return entry.id < 10;
+    });
+    assert(visited == 10 && lastId == 10);
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests the built-in single-pass JSON parser and escaping.
+ */
+void testJsonParser()
+{
+    std::string testName = "JSON Parser test";
+    showMessage(testName + " started...");
+
+    // Escaping round trip, including runs longer than one SIMD block
+    LogEntry entry{};
+    entry.id = 7;
+    entry.timestamp = "2025-01-01 12:00:00.000";
+    entry.level = LOG_LEVEL_INFO;
+    entry.message = std::string("quote \" backslash \\ tab \t cr \r bell \x07 ") + std::string(40, 'x') + "\n\"end\"";
+    entry.function = "testJsonParser";
+    entry.file = "C:\\logs\\test.cpp";
+    entry.line = 42;
+    entry.threadId = "1";
+#ifdef SQLG_USE_SOURCE_INFO
+    entry.sourceId = 3;
+    entry.sourceUuid = TEST_SOURCE_UUID;
+    entry.sourceName = TEST_SOURCE_NAME;
+#endif
+
+    for(const auto & json : { LogSerializer::Json::serializeLog(entry), LogSerializer::Json::serializeLogLine(entry) })
+    {
+        const LogEntry parsed = LogSerializer::Json::parseLog(json);
+        assert(parsed.id == entry.id && parsed.line == entry.line);
+        assert(parsed.message == entry.message);
+        assert(parsed.file == entry.file);
+#ifdef SQLG_USE_SOURCE_INFO
+        assert(parsed.sourceId == entry.sourceId);
+        assert(parsed.sourceName == entry.sourceName);
+#endif
+    }
+    assert(LogSerializer::Json::serializeLogLine(entry).find("bell \\u0007") != std::string::npos);
+
+#ifndef SQLG_USE_EXTERNAL_JSON_PARSER
+    // Any field order, unknown fields and unicode escapes
+    const LogEntry parsed = LogSerializer::Json::parseLog(
+                                "{ \"Extra\": [1, {\"a\": \"}\"}], \"Line\": 5, \"ThreadID\": \"9\", \"File\": \"f\","
+                                " \"Function\": \"fn\", \"Message\": \"caf\\u00e9 \\ud83d\\ude00\", \"Level\": \"INFO\","
+                                " \"Timestamp\": \"t\", \"ID\": -1 }");
+    assert(parsed.id == -1 && parsed.line == 5 && parsed.threadId == "9");
+    assert(parsed.message == "caf\xc3\xa9 \xf0\x9f\x98\x80");
+
+    bool thrown = false;
+    try
+    {
+        LogSerializer::Json::parseLog("{\"ID\": 1, \"Message\": \"unterminated}");
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+#endif
+
+    assert(LogSerializer::Json::parseLogs("[]").empty());
+
+    // Filters round trip, with quotes and braces inside the value
+    Filter filter;
+    filter.field = "Message";
+    filter.op = "LIKE";
+    filter.value = "%{\"x\"}%";
+    const auto filters = LogSerializer::Json::parseFilters(LogSerializer::Json::serializeFilters({ filter, filter }));
+    assert(filters.size() == 2 && filters[1].value == filter.value && filters[1].op == filter.op);
+    assert(LogSerializer::Json::parseFilters("").empty());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests the binary encoding (dictionary, deltas, zero-copy views).
+ */
+void testBinaryFormat()
+{
+    std::string testName = "Binary Format test";
+    showMessage(testName + " started...");
+
+    LogEntryList entries;
+    for(int i = 0; i < 1000; ++i)
+    {
+        LogEntry entry{};
+        entry.id = i % 100 == 99 ? i - 50 : i + 1; // some negative deltas
+        entry.timestampUs = 1735732800000000LL + i * 1500;
+        entry.timestamp = "2025-01-01 12:00:" + std::to_string(10 + i / 100) + "." + std::to_string(100000 + i);
+        entry.level = LogHelper::levelToString(i % 3 == 0 ? LogLevel::Warning : LogLevel::Info);
+        entry.message = "Binary message \"" + std::to_string(i) + "\"\n";
+        entry.function = "function_" + std::to_string(i % 4);
+        entry.file = "file_" + std::to_string(i % 10) + ".cpp";
+        entry.line = i % 7 - 3;
+        entry.threadId = std::to_string(1000 + i % 8);
+#ifdef SQLG_USE_SOURCE_INFO
+        entry.sourceId = 1;
+        entry.sourceUuid = TEST_SOURCE_UUID;
+        entry.sourceName = TEST_SOURCE_NAME;
+#endif
+        entries.push_back(entry);
+    }
+
+    const std::string encoded = LogSerializer::Binary::serializeLogs(entries);
+    assert(LogSerializer::Binary::isBinary(encoded));
+    assert(encoded.size() * 3 < LogSerializer::Json::serializeLogLines(entries).size());
+
+    // Two concatenated blocks decode as one sequence
+    const std::string twice = encoded + encoded;
+    const LogEntryList decoded = LogSerializer::Binary::parseLogs(twice);
+    assert(decoded.size() == entries.size() * 2);
+    for(size_t i = 0; i < decoded.size(); ++i)
+    {
+        const LogEntry& expected = entries[i % entries.size()];
+        assert(decoded[i].id == expected.id);
+        assert(decoded[i].timestampUs == expected.timestampUs);
+        assert(decoded[i].timestamp == expected.timestamp);
+        assert(decoded[i].level == expected.level);
+        assert(decoded[i].message == expected.message);
+        assert(decoded[i].function == expected.function);
+        assert(decoded[i].file == expected.file);
+        assert(decoded[i].line == expected.line);
+        assert(decoded[i].threadId == expected.threadId);
+#ifdef SQLG_USE_SOURCE_INFO
+        assert(decoded[i].sourceId == expected.sourceId);
+        assert(decoded[i].sourceUuid == expected.sourceUuid);
+#endif
+    }
+
+    // Views point into the encoded buffer
+    const size_t visited = LogSerializer::Binary::parseLogs(encoded, [ & encoded](const LogSerializer::Binary::LogEntryView & view)
+    {
+        assert(view.message.data() >= encoded.data() && view.message.data() < encoded.data() + encoded.size());
+        return view.id < 10;
+    });
+    assert(visited == 10);
+
+    auto throws = [](const std::string & data)
+    {
+        try
+        {
+            LogSerializer::Binary::parseLogs(data);
+        }
+        catch(const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+    assert(throws(encoded.substr(0, encoded.size() / 2)));
+    assert(throws("JSON" + encoded));
+    std::string future = encoded;
+    future[LOG_BINARY_MAGIC_SIZE] = static_cast<char>(LOG_BINARY_VERSION + 1);
+    assert(throws(future));
+    assert(LogSerializer::Binary::parseLogs(std::string()).empty());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @class MockTransport
+ * @brief In-memory ITransport recording pushed batches (test only).
+ * Per-entry pushes are left to the ITransport fallback when batchSupport is false.
+ * With deferAcks set, batch acknowledgements are held until ackAll().
+ * Server-side handlers are stored, so tests can feed batches as if received.
+ */
+class MockTransport : public ITransport
+{
+    public:
+        bool start(const std::string&, uint16_t) override
+        {
+            return true;
+        }
+        void stop() override {}
+        bool isRunning() const override
+        {
+            return true;
+        }
+        void setLogPushHandler(LogPushHandler) override {}
+        void setLogBatchPushHandler(LogBatchPushHandler handler) override
+        {
+            batchHandler = std::move(handler);
+        }
+        void setLogPullHandler(LogPullHandler handler) override
+        {
+            pullHandler = std::move(handler);
+        }
+        void setConfigHandler(ConfigHandler) override {}
+        void setErrorHandler(ErrorHandler) override {}
+        void setStatsHandler(StatsHandler) override {}
+        void pullLogs(const std::vector<Filter> &, int, int, std::function<void(LogEntryList)> callback) override
+        {
+            callback({});
+        }
+        void pushStats(const SQLogger::Stats&) override {}
+        TransportStats getStats() const override
+        {
+            return {};
+        }
+
+        void pushLog(const LogEntry& entry, std::function<void(bool)> callback) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++singlePushes;
+            callback(entry.message != "fail");
+        }
+
+        void pushLogs(const LogEntryList& entries, std::function<void(bool)> callback) override
+        {
+            if(!batchSupport)
+            {
+                ITransport::pushLogs(entries, std::move(callback));
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            batchSizes.push_back(entries.size());
+            maxPending = std::max(maxPending, pending.size() + 1);
+            if(deferAcks)
+            {
+                pending.push_back(std::move(callback));
+                return;
+            }
+            lock.unlock();
+            callback(true);
+        }
+
+        void ackAll(const bool success)
+        {
+            std::vector<std::function<void(bool)>> callbacks;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                callbacks.swap(pending);
+            }
+            for(auto & callback : callbacks)
+            {
+                callback(success);
+            }
+        }
+
+        size_t pendingCount()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return pending.size();
+        }
+
+        std::mutex mutex;
+        bool batchSupport = true;
+        std::atomic<bool> deferAcks{ false };
+        std::vector<size_t> batchSizes;
+        std::vector<std::function<void(bool)>> pending;
+        size_t maxPending = 0;
+        size_t singlePushes = 0;
+        LogBatchPushHandler batchHandler; /**< Set by a LogCollector. */
+        LogPullHandler pullHandler; /**< Set by a LogCollector. */
+};
+
+/**
+ * @brief Test for batched transport pushes (size and linger triggers, in-flight limit, fallback).
+ */
+void testTransportBatching()
+{
+    std::string testName = "Transport Batching test";
+    showMessage(testName + " started...");
+
+    LogEntry entry{};
+    entry.level = LOG_LEVEL_INFO;
+    entry.message = "batched";
+
+    // Size trigger: 250 entries at 100 per batch, the remainder sent by flush()
+    {
+        MockTransport transport;
+        TransportBatchPolicy policy;
+        policy.maxEntries = 100;
+        policy.maxDelay = std::chrono::milliseconds(10000);
+        TransportBatcher batcher(transport, policy);
+
+        std::atomic<int> acked{ 0 };
+        for(int i = 0; i < 250; ++i)
+        {
+            batcher.push(entry, [&acked](bool success)
+            {
+                if(success) ++acked;
+            });
+        }
+        assert(transport.batchSizes.size() == 2);
+        assert(batcher.flush());
+        assert((transport.batchSizes == std::vector<size_t> { 100, 100, 50 }));
+        assert(acked == 250);
+        assert(batcher.getStats().batches == 3);
+        assert(batcher.getStats().entries == 250);
+    }
+
+    // Linger trigger: a partial batch is sent after maxDelay without flush()
+    {
+        MockTransport transport;
+        TransportBatchPolicy policy;
+        policy.maxDelay = std::chrono::milliseconds(20);
+        TransportBatcher batcher(transport, policy);
+        batcher.push(entry);
+        batcher.push(entry);
+        for(int i = 0; i < 200; ++i)
+        {
+            {
+                std::lock_guard<std::mutex> lock(transport.mutex);
+                if(!transport.batchSizes.empty()) break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        std::lock_guard<std::mutex> lock(transport.mutex);
+        assert((transport.batchSizes == std::vector<size_t> { 2 }));
+    }
+
+    // In-flight limit: push() blocks until an acknowledgement frees a slot
+    {
+        MockTransport transport;
+        transport.deferAcks = true;
+        TransportBatchPolicy policy;
+        policy.maxEntries = 10;
+        policy.maxInFlight = 2;
+        policy.maxDelay = std::chrono::milliseconds(10000);
+        TransportBatcher batcher(transport, policy);
+
+        std::atomic<int> failed{ 0 };
+        std::thread producer([&]()
+        {
+            for(int i = 0; i < 40; ++i)
+            {
+                batcher.push(entry, [&failed](bool success)
+                {
+                    if(!success) ++failed;
+                });
+            }
+        });
+        while(transport.pendingCount() < 2)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(transport.pendingCount() == 2); // third batch is held back
+        transport.ackAll(false);
+        transport.deferAcks = false;
+        transport.ackAll(true);
+        producer.join();
+        assert(batcher.flush());
+        transport.ackAll(true);
+        assert(transport.maxPending <= 2);
+        assert(failed == 20);
+        assert(batcher.getStats().failedBatches == 2);
+        assert(batcher.getStats().entries == 40);
+    }
+
+    // Fallback: transports without batch support get one pushLog() per entry
+    {
+        MockTransport transport;
+        transport.batchSupport = false;
+        LogEntryList entries(5, entry);
+        bool result = false;
+        transport.pushLogs(entries, [&result](bool success)
+        {
+            result = success;
+        });
+        assert(result && transport.singlePushes == 5);
+        entries[2].message = "fail";
+        transport.pushLogs(entries, [&result](bool success)
+        {
+            result = success;
+        });
+        assert(!result && transport.singlePushes == 10);
+    }
+
+    // Policy from configuration
+    {
+        LogConfig::Config config;
+        config.transportBatchMaxEntries = 64;
+        config.transportBatchMaxDelay = 0;
+        const TransportBatchPolicy policy = TransportBatchPolicy::fromConfig(config);
+        assert(policy.maxEntries == 64);
+        assert(policy.maxDelay.count() == 0);
+        assert(policy.maxBytes == TRANSPORT_BATCH_DEFAULT_MAX_BYTES);
+        assert(policy.maxInFlight == TRANSPORT_BATCH_DEFAULT_MAX_IN_FLIGHT);
+    }
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the collector server mode (merged senders, durable acks, pulls).
+ */
+void testLogCollector()
+{
+    if(testConfig.databaseType.value() != DataBaseType::SQLite)
+    {
+        std::cout << std::endl << "Skipping log collector test" << std::endl << std::endl;
+        return;
+    }
+
+    std::string testName = "Log Collector test";
+    showMessage(testName + " started...");
+
+    const int senders = 3;
+    const int batchesPerSender = 10;
+    const int entriesPerBatch = 20;
+    const int total = senders * batchesPerSender * entriesPerBatch;
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "collector";
+    config.databaseTable = "collector_logs";
+    config.useBatch = true;
+    config.syncMode = false;
+    config.batchSize = 100;
+    config.groupCommitBatches = 4;
+
+    SQLogger& collectorLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                                , TEST_SOURCE_INFO
+#endif
+                                                                      );
+    collectorLogger.clearLogs();
+
+    MockTransport transport;
+    {
+        LogCollector collector(transport, collectorLogger);
+        assert(transport.batchHandler && transport.pullHandler);
+
+        std::atomic<int> acked{ 0 };
+        std::atomic<int> failed{ 0 };
+        std::vector<std::thread> threads;
+        for(int sender = 0; sender < senders; ++sender)
+        {
+            threads.emplace_back([&, sender]()
+            {
+                for(int batch = 0; batch < batchesPerSender; ++batch)
+                {
+                    LogEntryList entries;
+                    for(int i = 0; i < entriesPerBatch; ++i)
+                    {
+                        LogEntry entry{};
+                        entry.level = LOG_LEVEL_INFO;
+                        entry.message = "collected " + std::to_string(batch * entriesPerBatch + i);
+                        entry.function = __FUNCTION__;
+                        entry.file = __FILE__;
+                        entry.line = __LINE__;
+                        entry.threadId = "sender-" + std::to_string(sender);
+                        entry.timestampUs = 1735732800000000LL + i;
+#ifdef SQLG_USE_SOURCE_INFO
+                        entry.sourceUuid = "00000000-0000-4000-8000-00000000000" + std::to_string(sender);
+                        entry.sourceName = "node-" + std::to_string(sender);
+#endif
+                        entries.push_back(entry);
+                    }
+                    transport.batchHandler(entries, [&](bool success)
+                    {
+                        ++(success ? acked : failed);
+                    });
+                }
+            });
+        }
+        for(auto & thread : threads)
+        {
+            thread.join();
+        }
+        for(int i = 0; i < 1000 && acked + failed < senders * batchesPerSender; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        assert(acked == senders * batchesPerSender && failed == 0);
+
+        // Durable acks: the rows are committed and visible to another connection
+        SQLiteDatabase verifyDb(config.databaseName.value());
+        verifyDb.connect(config.databaseName.value());
+        assert(std::stoi(verifyDb.query("SELECT COUNT(*) AS cnt FROM collector_logs").at(0).at("cnt")) == total);
+        verifyDb.disconnect();
+
+        // Pulls are answered on the logger's query threads
+        std::promise<LogEntryList> pull;
+        transport.pullHandler({ {Filter::Type::ThreadId, FIELD_LOG_THREAD_ID, "=", "sender-1"} }, 0, 0,
+                              [&pull](LogEntryList entries)
+        {
+            pull.set_value(std::move(entries));
+        });
+        const LogEntryList pulled = pull.get_future().get();
+        assert(pulled.size() == batchesPerSender * entriesPerBatch);
+
+        const LogCollector::Stats stats = collector.getStats();
+        assert(stats.batches == senders * batchesPerSender);
+        assert(stats.entries == total && stats.skipped == 0 && stats.failedBatches == 0);
+#ifdef SQLG_USE_SOURCE_INFO
+        assert(stats.sources == senders);
+        assert(collectorLogger.getLogsBySourceUuid("00000000-0000-4000-8000-000000000002").size() == batchesPerSender * entriesPerBatch);
+        assert(collectorLogger.getSourceByUuid(TEST_SOURCE_UUID).has_value());
+#endif
+
+        collector.stop();
+        bool lateStatus = true;
+        transport.batchHandler(LogEntryList(1, pulled.front()), [&lateStatus](bool success)
+        {
+            lateStatus = success;
+        });
+        assert(!lateStatus);
+    }
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the local spool: record recovery, replayed offset and replay after a failed write.
+ */
+void testSpool()
+{
+    std::string testName = "Spool test";
+    showMessage(testName + " started...");
+
+    const std::string spoolPath = "test_spool/spool.bin";
+    std::filesystem::remove_all("test_spool");
+
+    auto makeEntry = [](const int i)
+    {
+        LogEntry entry{};
+        entry.timestamp = "2025-01-01 12:00:00.000";
+        entry.timestampUs = 1735732800000000LL + i;
+        entry.level = LogHelper::levelToString(LogLevel::Info);
+        entry.message = "Spool message " + std::to_string(i);
+        entry.function = "testSpool";
+        entry.file = "test_logger.cpp";
+        entry.line = i;
+        entry.threadId = "1";
+        return entry;
+    };
+
+    {
+        LogSpool spool(spoolPath);
+        assert(spool.empty());
+        assert(spool.append({ makeEntry(0), makeEntry(1) }));
+        assert(spool.append({ makeEntry(2) }));
+
+        // Whole records are returned and nothing is consumed until consume()
+        LogEntryList entries;
+        assert(spool.peek(entries, 1) == 2);
+        entries.clear();
+        assert(spool.peek(entries, 1) == 2 && entries[1].message == "Spool message 1");
+        spool.consume();
+        assert(!spool.empty());
+    }
+
+    {
+        // Torn tail of a crashed append
+        std::ofstream torn(spoolPath, std::ios::binary | std::ios::app);
+        torn.write("\x40\x00\x00\x00garbage", 11);
+    }
+
+    {
+        // Reopened spool continues after the replayed records and drops the torn tail
+        LogSpool spool(spoolPath);
+        assert(spool.append({ makeEntry(3) }));
+
+        LogEntryList entries;
+        assert(spool.peek(entries, 100) == 2);
+        assert(entries[0].message == "Spool message 2" && entries[1].message == "Spool message 3");
+        assert(entries[1].timestampUs == 1735732800000003LL && entries[1].line == 3);
+        spool.consume();
+        assert(spool.empty() && std::filesystem::file_size(spoolPath) == 0);
+
+        LogSpool small("test_spool/small.bin", 64);
+        LogEntry big = makeEntry(4);
+        big.message.assign(100, 'x');
+        assert(!small.append({ big }));
+        assert(small.empty());
+    }
+
+    if(testConfig.databaseType.value() == DataBaseType::SQLite)
+    {
+        LogConfig::Config config = getTestConfig();
+        config.name = "spool";
+        config.databaseTable = "spool_logs";
+        config.syncMode = true;
+        config.useBatch = false;
+        config.spoolPath = spoolPath;
+        config.spoolRetryMs = 20;
+        if(LogCipher::isSupported())
+        {
+            config.encryptMessages = true;
+            config.passKey = TEST_ENC_DEC_PASS_KEY;
+        }
+        assert(config.validate().ok());
+
+        SQLogger& spoolLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                                , TEST_SOURCE_INFO
+#endif
+                                                                      );
+        spoolLogger.clearLogs();
+        spoolLogger.resetStats();
+
+        SQLiteDatabase outageDb(config.databaseName.value());
+        outageDb.connect(config.databaseName.value());
+
+        SQLOG_INFO(spoolLogger) << "Spool log 0";
+
+        // Writes fail while the table is away
+        assert(outageDb.execute("ALTER TABLE spool_logs RENAME TO spool_logs_away"));
+        const int numLogs = 5;
+        for(int i = 1; i <= numLogs; ++i)
+        {
+            SQLOG_INFO(spoolLogger) << "Spool log " << i;
+        }
+        assert(spoolLogger.getStats().totalSpooled == numLogs);
+        assert(spoolLogger.getStats().totalFailed == 0);
+        assert(!spoolLogger.waitForSpool(std::chrono::milliseconds(100)));
+
+        {
+            // Spooled as stored: no plaintext on disk with message encryption
+            std::ifstream spooled(spoolPath, std::ios::binary);
+            const std::string bytes((std::istreambuf_iterator<char>(spooled)), std::istreambuf_iterator<char>());
+            assert((bytes.find("Spool log") == std::string::npos) == config.encryptMessages.value_or(false));
+        }
+
+        assert(outageDb.execute("ALTER TABLE spool_logs_away RENAME TO spool_logs"));
+        assert(spoolLogger.waitForSpool(std::chrono::milliseconds(5000)));
+        assert(spoolLogger.getStats().totalReplayed == numLogs);
+
+        const LogEntryList logs = spoolLogger.getAllLogs();
+        assert(logs.size() == numLogs + 1);
+        for(int i = 0; i <= numLogs; ++i)
+        {
+            assert(logs[i].message == "Spool log " + std::to_string(i));
+        }
+
+        outageDb.disconnect();
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    std::filesystem::remove_all("test_spool");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the buffered error log: deduplication, rate limit and rotation.
+ */
+void testErrorLog()
+{
+    std::string testName = "Error Log test";
+    showMessage(testName + " started...");
+
+    const std::string logPath = "test_error_log/errors.txt";
+    std::filesystem::remove_all("test_error_log");
+    FSHelper::createDir(logPath);
+
+    auto readLines = [](const std::string & path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream in(path);
+        for(std::string line; std::getline(in, line);)
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    };
+
+    {
+        ErrorLog errorLog(logPath, 5);
+        for(int i = 0; i < 100; ++i)
+        {
+            errorLog.write("Connection lost", "writer", "logger.cpp", 42);
+        }
+        for(int i = 0; i < 20; ++i)
+        {
+            errorLog.write("Query " + std::to_string(i) + " failed", "writer", "logger.cpp", 43);
+        }
+        errorLog.flush();
+
+        const ErrorLog::Stats stats = errorLog.getStats();
+        assert(stats.repeated == 99);
+        assert(stats.suppressed == 16);
+
+        const std::vector<std::string> lines = readLines(logPath);
+        assert(lines.size() == 7 && stats.written == 7);
+        assert(lines[0].find("[ERROR] \"Connection lost\" writer logger.cpp:42") != std::string::npos);
+        assert(lines[1].find("Last message repeated 99 times") != std::string::npos);
+        assert(lines[2].find("\"Query 0 failed\"") != std::string::npos);
+        assert(lines[6].find("16 messages suppressed") != std::string::npos);
+    }
+
+    {
+        // Rotation is driven by the bytes written, the file never grows past maxBytes
+        ErrorLog errorLog(logPath, 0, 512);
+        for(int i = 0; i < 50; ++i)
+        {
+            errorLog.write("Rotated message " + std::to_string(i), "writer", "logger.cpp", i);
+            errorLog.flush();
+            assert(std::filesystem::file_size(logPath) <= 512);
+        }
+        assert(readLines(logPath).back().find("Rotated message 49") != std::string::npos);
+    }
+
+    {
+        // Lines reach the file from the background thread without flush()
+        ErrorLog errorLog(logPath);
+        errorLog.setPath("test_error_log/other.txt");
+        errorLog.write("Background message", "writer", "logger.cpp", 1);
+        bool written = false;
+        for(int i = 0; i < 100 && !written; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const std::vector<std::string> lines = readLines("test_error_log/other.txt");
+            written = !lines.empty() && lines.back().find("Background message") != std::string::npos;
+        }
+        assert(written);
+    }
+
+    std::filesystem::remove_all("test_error_log");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the latency histograms and queue counters of SQLogger::Stats.
+ */
+void testLatencyStats()
+{
+    std::string testName = "Latency Stats test";
+    showMessage(testName + " started...");
+
+    // Buckets are exact below 16 µs and within 1/16 above
+    for(uint64_t value : { 0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 100ULL, 999ULL, 123456ULL, 1ULL << 39 })
+    {
+        const uint64_t highest = LatencyHistogram::bucketHighest(LatencyHistogram::bucketIndex(value));
+        assert(highest >= value && highest - value <= value / LatencyHistogram::SUB_BUCKETS);
+    }
+    assert(LatencyHistogram::bucketIndex(UINT64_MAX) == LatencyHistogram::BUCKETS - 1);
+
+    LatencyHistogram histogram;
+    for(uint64_t i = 1; i <= 1000; ++i)
+    {
+        histogram.record(i);
+    }
+    histogram.record(50000, 10);
+    LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    assert(snapshot.count == 1010 && snapshot.maxUs == 50000);
+    assert(snapshot.percentileUs(50.0) >= 505 && snapshot.percentileUs(50.0) <= 540);
+    assert(snapshot.percentileUs(99.0) >= 990 && snapshot.percentileUs(99.0) <= 1023);
+    assert(snapshot.percentileUs(99.9) == 50000);
+    snapshot.merge(histogram.snapshot());
+    assert(snapshot.count == 2020 && snapshot.buckets[LatencyHistogram::bucketIndex(1)] == 2);
+    histogram.reset();
+    assert(histogram.snapshot().count == 0 && histogram.snapshot().percentileUs(99.0) == 0);
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "latency";
+    config.databaseTable = "latency_logs";
+    config.syncMode = false;
+    config.useBatch = true;
+    config.batchSize = 10;
+
+    SQLogger& latencyLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                              , TEST_SOURCE_INFO
+#endif
+                                                                    );
+    latencyLogger.clearLogs();
+    latencyLogger.resetStats();
+
+    const uint64_t numLogs = 100;
+    for(uint64_t i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(latencyLogger) << "Latency log " << i;
+    }
+    latencyLogger.flush();
+    assert(latencyLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    const SQLogger::Stats stats = latencyLogger.getStats();
+    assert(stats.totalLogged == numLogs && stats.totalFailed == 0);
+    assert(stats.enqueueLatency.count == numLogs);
+    assert(stats.queueWait.count == numLogs);
+    assert(stats.endToEnd.count == numLogs);
+    assert(stats.dbExecute.count >= 1 && stats.dbExecute.count <= numLogs);
+    assert(stats.queueDepth == 0 && stats.maxQueueDepth >= 1);
+    assert(stats.endToEnd.percentileUs(99.0) >= stats.queueWait.percentileUs(50.0));
+    assert(SQLogger::getFormattedStats(stats).find("Queue wait: p50 ") != std::string::npos);
+
+    latencyLogger.resetStats();
+    assert(latencyLogger.getStats().endToEnd.count == 0);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the Prometheus/OpenMetrics export of the LogManager loggers.
+ */
+void testMetrics()
+{
+    std::string testName = "Metrics test";
+    showMessage(testName + " started...");
+
+    auto countLines = [](const std::string & text, const std::string & prefix)
+    {
+        size_t count = 0;
+        std::istringstream stream(text);
+        for(std::string line; std::getline(stream, line);)
+        {
+            if(line.compare(0, prefix.size(), prefix) == 0) ++count;
+        }
+        return count;
+    };
+
+    // Labels are escaped and histograms are cumulative
+    LogMetrics::Sample sample;
+    sample.logger = "say \"hi\"";
+    sample.databaseType = "Mock";
+    sample.stats.totalLogged = 7;
+    sample.stats.queueWait.merge([]
+    {
+        LatencyHistogram::Snapshot snapshot;
+        snapshot.buckets.assign(LatencyHistogram::BUCKETS, 0);
+        snapshot.buckets[LatencyHistogram::bucketIndex(3)] = 2;
+        snapshot.buckets[LatencyHistogram::bucketIndex(20000000)] = 1;
+        snapshot.count = 3;
+        snapshot.sumUs = 20000006;
+        snapshot.maxUs = 20000000;
+        return snapshot;
+    }());
+    const std::string labels = "logger=\"say \\\"hi\\\"\",db_type=\"Mock\",source=\"\"";
+    std::string text = LogMetrics::format({ sample });
+    assert(text.find("# TYPE sqlogger_entries_logged_total counter\n") != std::string::npos);
+    assert(text.find("sqlogger_entries_logged_total{" + labels + "} 7\n") != std::string::npos);
+    assert(text.find("sqlogger_queue_wait_seconds_bucket{" + labels + ",le=\"2e-06\"} 0\n") == std::string::npos);
+    assert(text.find("sqlogger_queue_wait_seconds_bucket{" + labels + ",le=\"0.000005\"} 2\n") != std::string::npos);
+    assert(text.find("sqlogger_queue_wait_seconds_bucket{" + labels + ",le=\"10\"} 2\n") != std::string::npos);
+    assert(text.find("sqlogger_queue_wait_seconds_bucket{" + labels + ",le=\"+Inf\"} 3\n") != std::string::npos);
+    assert(text.find("sqlogger_queue_wait_seconds_sum{" + labels + "} 20.000006\n") != std::string::npos);
+    assert(text.find("# EOF") == std::string::npos);
+
+    text = LogMetrics::format({ sample }, LogMetrics::Format::OpenMetrics);
+    assert(text.find("# TYPE sqlogger_entries_logged counter\n") != std::string::npos);
+    assert(text.size() > 6 && text.compare(text.size() - 6, 6, "# EOF\n") == 0);
+    assert(LogMetrics::format({}, LogMetrics::Format::OpenMetrics) == "# EOF\n");
+
+    // Every registered logger is published with its own labels
+    const std::vector<std::string> names = { "metrics_a", "metrics_b" };
+    for(const auto & name : names)
+    {
+        LogConfig::Config config = getTestConfig();
+        config.name = name;
+        config.databaseTable = name + "_logs";
+        config.syncMode = true;
+        config.useBatch = false;
+#ifdef SQLG_USE_SOURCE_INFO
+        config.sourceName = "metrics source";
+#endif
+
+        SQLogger& metricsLogger = LogManager::getInstance().createLogger(name, config
+#ifdef SQLG_USE_SOURCE_INFO
+                                  , TEST_SOURCE_INFO
+#endif
+                                                                        );
+        metricsLogger.clearLogs();
+        metricsLogger.resetStats();
+        SQLOG_INFO(metricsLogger) << "Metrics log";
+    }
+
+    const std::vector<LogMetrics::Sample> samples = LogMetrics::collect();
+    assert(samples.size() == static_cast<size_t>(LogManager::getInstance().getCount()));
+    text = LogMetrics::scrape();
+    const std::string dbType = DataBaseHelper::databaseTypeToString(getTestConfig().databaseType.value());
+    for(const auto & name : names)
+    {
+#ifdef SQLG_USE_SOURCE_INFO
+        const std::string source = "metrics source";
+#else
+        const std::string source;
+#endif
+        const std::string series = "sqlogger_entries_logged_total{logger=\"" + name + "\",db_type=\"" + dbType
+                                   + "\",source=\"" + source + "\"} 1\n";
+        assert(text.find(series) != std::string::npos);
+    }
+    assert(countLines(text, "# TYPE ") == 21);
+    assert(countLines(text, "sqlogger_queue_depth{") == samples.size());
+
+    // Periodic publishing to a text file and a handler
+    const std::string metricsPath = "test_metrics.prom";
+    std::filesystem::remove(metricsPath);
+    std::mutex handlerMutex;
+    std::string published;
+    {
+        LogMetrics metrics(std::chrono::milliseconds(10));
+        metrics.setTextFile(metricsPath);
+        metrics.setHandler([ & ](const std::string & metricsText)
+        {
+            std::lock_guard<std::mutex> lock(handlerMutex);
+            published = metricsText;
+        }, LogMetrics::Format::OpenMetrics);
+        metrics.start();
+        for(int i = 0; i < 200; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::lock_guard<std::mutex> lock(handlerMutex);
+            if(!published.empty()) break;
+        }
+        metrics.stop();
+        assert(metrics.publish());
+    }
+    assert(published.find("logger=\"metrics_a\"") != std::string::npos);
+    std::ifstream file(metricsPath);
+    const std::string fileText((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    assert(fileText.find("sqlogger_end_to_end_seconds_count{logger=\"metrics_b\"") != std::string::npos);
+    assert(!std::filesystem::exists(metricsPath + ".tmp"));
+    file.close();
+    std::filesystem::remove(metricsPath);
+
+    for(const auto & name : names)
+    {
+        LogManager::getInstance().removeLogger(name);
+    }
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the in-memory columnar backend (DataBaseType::Memory).
+ */
+void testMemoryDatabase()
+{
+    std::string testName = "Memory Database test";
+    showMessage(testName + " started...");
+
+    const LogLevel levels[] = { LogLevel::Debug, LogLevel::Info, LogLevel::Warning, LogLevel::Error };
+    const int64_t baseUs = 1735732800000000LL;
+    auto makeEntries = [ & ](const int count, const int64_t first)
+    {
+        LogEntryList entries;
+        for(int i = 0; i < count; ++i)
+        {
+            LogEntry entry{};
+            entry.timestampUs = baseUs + (first + i) * 1000;
+            entry.level = levelToString(levels[i % 4]);
+            entry.message = "Memory message " + std::to_string(first + i);
+            entry.function = "function_" + std::to_string(i % 3);
+            entry.file = "memory_" + std::to_string(i % 5) + ".cpp";
+            entry.line = i;
+            entry.threadId = "thread_" + std::to_string(i % 2);
+            entries.push_back(std::move(entry));
+        }
+        return entries;
+    };
+
+    // Native storage and filters
+    MemoryDatabase database(std::string(MEMORY_CON_STR_NAME) + "=test_memory;" + MEMORY_CON_STR_MAX_BYTES + "=0");
+    assert(database.isConnected() && database.supportsNativeLogs());
+    assert(database.getDatabaseType() == DataBaseType::Memory);
+    assert(!database.execute("SELECT 1") && database.query("SELECT 1").empty());
+    assert(!database.beginTransaction());
+    assert(database.insertLogs("memory_logs", makeEntries(10000, 0)));
+
+    auto count = [ & ](const std::vector<Filter> & filters, const std::string & orderBy = FIELD_LOG_ID,
+                       const int limit = 0, const int offset = 0)
+    {
+        return database.selectLogs("memory_logs", filters, orderBy, limit, offset, [](LogEntry&)
+        {
+            return true;
+        });
+    };
+    assert(count({}) == 10000);
+    assert(count({ { Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(LogLevel::Error) } }) == 2500);
+    assert(count({ { Filter::Type::File, FIELD_LOG_FILE, "LIKE", "MEMORY_1%" } }) == 2000);
+    assert(count({ { Filter::Type::Function, FIELD_LOG_FUNCTION, "IN", "function_0, function_2" } }) == 6667);
+    assert(count({ { Filter::Type::Unknown, FIELD_LOG_MESSAGE, "LIKE", "%message 99_" } }) == 10);
+    assert(count({ { Filter::Type::Unknown, FIELD_LOG_ID, ">", "9990" } }) == 10);
+    assert(count({ { Filter::Type::Unknown, FIELD_LOG_LINE, "IS NULL", "" } }) == 0);
+    assert(count({ { Filter::Type::TimestampRange, FIELD_LOG_TIMESTAMP, ">=", std::to_string(baseUs + 5000 * 1000) },
+        { Filter::Type::TimestampRange, FIELD_LOG_TIMESTAMP, "<", std::to_string(baseUs + 5100 * 1000) },
+        { Filter::Type::ThreadId, FIELD_LOG_THREAD_ID, "!=", "thread_1" }
+    }) == 50);
+    assert(count({}, FIELD_LOG_TIMESTAMP, 100, 9950) == 50);
+
+    bool unknownField = false;
+    try
+    {
+        count({ { Filter::Type::Unknown, "no_such_column", "=", "1" } });
+    }
+    catch(const std::invalid_argument&)
+    {
+        unknownField = true;
+    }
+    assert(unknownField);
+
+    // Out of order timestamps are sorted, ties keep the ID order
+    LogEntryList late = makeEntries(1, -1);
+    assert(database.insertLogs("memory_logs", late));
+    int64_t lastUs = INT64_MIN;
+    int64_t firstId = 0;
+    database.selectLogs("memory_logs", {}, FIELD_LOG_TIMESTAMP, 1, 0, [ & ](LogEntry & entry)
+    {
+        firstId = entry.id;
+        lastUs = entry.timestampUs;
+        return true;
+    });
+    assert(firstId == 10001 && lastUs == baseUs - 1000);
+    assert(!late.empty() && late.front().message == "Memory message -1");
+
+    // Connections to the same name share the data
+    {
+        MemoryDatabase shared("test_memory");
+        assert(shared.getMaxBytes() == 0);
+        assert(shared.selectLogs("memory_logs", {}, FIELD_LOG_ID, 0, 0, [](LogEntry&)
+        {
+            return true;
+        }) == 10001);
+    }
+
+    assert(database.clearTable("memory_logs") && count({}) == 0);
+
+    // Fixed budget: the oldest chunks are evicted, IDs keep growing
+    const size_t budget = 2 * 1024 * 1024;
+    MemoryDatabase ring(std::string(MEMORY_CON_STR_NAME) + "=test_memory_ring;" + MEMORY_CON_STR_MAX_BYTES + "=" + std::to_string(budget));
+    for(int i = 0; i < 20; ++i)
+    {
+        assert(ring.insertLogs("memory_logs", makeEntries(MEMORY_CHUNK_ROWS, i * MEMORY_CHUNK_ROWS)));
+        assert(ring.getMemoryUsage("memory_logs") <= budget + budget / 2);
+    }
+    assert(ring.getEvictedRows("memory_logs") > 0);
+    int lastId = 0;
+    const size_t kept = ring.selectLogs("memory_logs", {}, FIELD_LOG_ID, 0, 0, [ & ](LogEntry & entry)
+    {
+        assert(entry.id > lastId);
+        lastId = entry.id;
+        return true;
+    });
+    assert(kept + ring.getEvictedRows("memory_logs") == 20 * MEMORY_CHUNK_ROWS);
+    assert(lastId == 20 * MEMORY_CHUNK_ROWS);
+
+    // Through the logger
+    LogConfig::Config config = getTestConfig();
+    config.name = "memory";
+    config.databaseType = DataBaseType::Memory;
+    config.databaseName = "test_memory_logger";
+    config.databaseTable = "memory_logger_logs";
+    config.memoryMaxBytes = 1LL << 20;
+    config.syncMode = false;
+    config.useBatch = true;
+    config.batchSize = 100;
+    config.groupCommitBatches = 4;
+    assert(LogConfig::configToConnectionString(config) == "Name=test_memory_logger;MaxBytes=1048576");
+
+    SQLogger& memoryLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+    memoryLogger.clearLogs();
+    assert(memoryLogger.getDataBaseType() == DataBaseType::Memory);
+
+    const int numLogs = 500;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        if(i % 5 == 0)
+        {
+            SQLOG_WARNING(memoryLogger) << "Memory log " << i;
+        }
+        else
+        {
+            SQLOG_INFO(memoryLogger) << "Memory log " << i;
+        }
+    }
+    memoryLogger.flush();
+    assert(memoryLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    Filter warning { Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(LogLevel::Warning) };
+    const LogEntryList warnings = memoryLogger.getLogsByFilters({ warning });
+    assert(warnings.size() == numLogs / 5);
+#ifdef SQLG_USE_SOURCE_INFO
+    assert(warnings.front().sourceName == TEST_SOURCE_INFO.name);
+#endif
+    assert(memoryLogger.getLogsByFilters({}, 10, 20).size() == 10);
+
+    int lastLogId = 0;
+    assert(memoryLogger.forEachLog({}, [ & ](const LogEntry & entry)
+    {
+        assert(entry.id > lastLogId && entry.message.rfind("Memory log ", 0) == 0);
+        lastLogId = entry.id;
+        return true;
+    }, 64) == numLogs);
+    assert(memoryLogger.getStats().totalFailed == 0);
+
+    memoryLogger.clearLogs();
+    assert(memoryLogger.getLogsByFilters({}).empty());
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the in-process tail cache answering recent getLogsByFilters() queries.
+ */
+void testTailCache()
+{
+    std::string testName = "Tail Cache test";
+    showMessage(testName + " started...");
+
+    auto sameEntries = [](const LogEntryList & a, const LogEntryList & b)
+    {
+        if(a.size() != b.size())
+        {
+            return false;
+        }
+        for(size_t i = 0; i < a.size(); ++i)
+        {
+            if(a[i].id != b[i].id || a[i].timestamp != b[i].timestamp || a[i].timestampUs != b[i].timestampUs
+                    || a[i].level != b[i].level || a[i].message != b[i].message || a[i].function != b[i].function
+                    || a[i].file != b[i].file || a[i].line != b[i].line || a[i].threadId != b[i].threadId
+#ifdef SQLG_USE_SOURCE_INFO
+                    || a[i].sourceId != b[i].sourceId || a[i].sourceUuid != b[i].sourceUuid || a[i].sourceName != b[i].sourceName
+#endif
+              )
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    // LIKE is never answered by the cache
+    const Filter anyMessage { Filter::Type::Unknown, FIELD_LOG_MESSAGE, "LIKE", "%" };
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "tail_cache";
+    config.databaseTable = "tail_cache_logs";
+    config.syncMode = false;
+    config.useBatch = true;
+    config.batchSize = 50;
+    config.timestampFormat = TimestampFormat::EpochMicros;
+    config.tailCacheSize = 1000;
+
+    SQLogger& cacheLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    cacheLogger.clearLogs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    const std::string since = std::to_string(toEpochMicros(std::chrono::system_clock::now()));
+
+    const int numLogs = 300;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        if(i % 3 == 0)
+        {
+            SQLOG_WARNING(cacheLogger) << "Tail log " << i;
+        }
+        else
+        {
+            SQLOG_INFO(cacheLogger) << "Tail log " << i;
+        }
+    }
+    cacheLogger.flush();
+    assert(cacheLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    cacheLogger.resetStats();
+
+    // Recent entries come from the cache and equal the database rows
+    const Filter recent { Filter::Type::TimestampRange, FIELD_LOG_TIMESTAMP, ">=", since };
+    const Filter warning { Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(LogLevel::Warning) };
+    const LogEntryList cached = cacheLogger.getLogsByFilters({ recent, warning });
+    assert(cached.size() == numLogs / 3);
+    assert(sameEntries(cached, cacheLogger.getLogsByFilters({ recent, warning, anyMessage })));
+    assert(sameEntries(cacheLogger.getLogsByFilters({ recent }, 10, 25), cacheLogger.getLogsByFilters({ recent, anyMessage }, 10, 25)));
+    const Filter notWarning { Filter::Type::Level, FIELD_LOG_LEVEL, "!=", levelToString(LogLevel::Warning) };
+    const Filter firstId { Filter::Type::Unknown, FIELD_LOG_ID, "<=", std::to_string(cached.front().id) };
+    assert(sameEntries(cacheLogger.getLogsByFilters({ recent, notWarning, firstId }),
+                       cacheLogger.getLogsByFilters({ recent, notWarning, firstId, anyMessage })));
+#ifdef SQLG_USE_SOURCE_INFO
+    assert(cached.front().sourceName == TEST_SOURCE_INFO.name);
+#endif
+
+    SQLogger::Stats stats = cacheLogger.getStats();
+    assert(stats.tailCacheHits == 3 && stats.tailCacheMisses == 3);
+
+    // Without a recent lower bound the database is queried
+    assert(cacheLogger.getLogsByFilters({ warning }).size() == numLogs / 3);
+    assert(cacheLogger.getStats().tailCacheMisses == 4);
+
+    // Evicted entries move the floor past the earlier bound
+    for(int i = 0; i < 1500; ++i)
+    {
+        SQLOG_DEBUG(cacheLogger) << "Tail fill " << i;
+    }
+    cacheLogger.flush();
+    assert(cacheLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    assert(cacheLogger.getLogsByFilters({ recent, warning }).size() == numLogs / 3);
+    stats = cacheLogger.getStats();
+    assert(stats.tailCacheHits == 3 && stats.tailCacheMisses == 5);
+
+    // Rows added by another writer are detected at the next write
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    const std::string beforeForeign = std::to_string(toEpochMicros(std::chrono::system_clock::now()));
+    {
+        LogConfig::Config foreignConfig = config;
+        foreignConfig.name = "tail_cache_foreign";
+        foreignConfig.syncMode = true;
+        foreignConfig.useBatch = false;
+        foreignConfig.tailCacheSize = 0;
+        SQLogger& foreignLogger = LogManager::getInstance().createLogger(foreignConfig.name.value(), foreignConfig
+#ifdef SQLG_USE_SOURCE_INFO
+                                  , TEST_SOURCE_INFO
+#endif
+                                                                        );
+        SQLOG_INFO(foreignLogger) << "Foreign log";
+        LogManager::getInstance().removeLogger(foreignConfig.name.value());
+    }
+    SQLOG_INFO(cacheLogger) << "Own log";
+    cacheLogger.flush();
+    assert(cacheLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    const Filter afterForeign { Filter::Type::TimestampRange, FIELD_LOG_TIMESTAMP, ">=", beforeForeign };
+    const LogEntryList mixed = cacheLogger.getLogsByFilters({ afterForeign });
+    assert(mixed.size() == 2 && mixed.front().message == "Foreign log");
+    assert(cacheLogger.getStats().tailCacheHits == 3);
+
+    // Text timestamps: entries are cached once the clock has left the second of the floor
+    LogConfig::Config textConfig = config;
+    textConfig.name = "tail_cache_text";
+    textConfig.databaseTable = "tail_cache_text_logs";
+    textConfig.timestampFormat = TimestampFormat::Text;
+    SQLogger& textLogger = LogManager::getInstance().createLogger(textConfig.name.value(), textConfig
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+    textLogger.clearLogs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    const std::string sinceText = formatTime(std::chrono::system_clock::now());
+    for(int i = 0; i < 20; ++i)
+    {
+        SQLOG_ERROR(textLogger) << "Text tail log " << i;
+    }
+    textLogger.flush();
+    assert(textLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    textLogger.resetStats();
+    const Filter recentText { Filter::Type::TimestampRange, FIELD_LOG_TIMESTAMP, ">=", sinceText };
+    const LogEntryList textCached = textLogger.getLogsByFilters({ recentText }, 5);
+    assert(textCached.size() == 5 && textCached.front().timestampUs == 0);
+    assert(sameEntries(textCached, textLogger.getLogsByFilters({ recentText, anyMessage }, 5)));
+    assert(textLogger.getStats().tailCacheHits == 1);
+
+    LogManager::getInstance().removeLogger(textConfig.name.value());
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the read pool: queries run on separate connections and do not block logging.
+ */
+void testReadPool()
+{
+    std::string testName = "Read Pool test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "read_pool";
+    config.databaseTable = "read_pool_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+    config.minLogLevel = LogLevel::Info;
+    config.readPoolSize = 2;
+    assert(config.validate().ok());
+
+    SQLogger& poolLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+    poolLogger.clearLogs();
+
+    const int numLogs = 100;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(poolLogger) << "Read pool log " << i;
+    }
+
+    // A synchronous write completes while the scan holds its cursor open
+    size_t written = 0;
+    const Filter scanned { Filter::Type::Unknown, FIELD_LOG_MESSAGE, "LIKE", "Read pool log %" };
+    const size_t visited = poolLogger.forEachLog({ scanned }, [ & ](const LogEntry & entry)
+    {
+        if(written == 0)
+        {
+            auto write = std::async(std::launch::async, [ & ]()
+            {
+                SQLOG_WARNING(poolLogger) << "Written during scan";
+            });
+            assert(write.wait_for(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)) == std::future_status::ready);
+            ++written;
+        }
+        return true;
+    });
+    assert(written == 1);
+    assert(visited == numLogs); // the scan reads the snapshot taken when it started
+
+    // Entries written before a query are visible to it
+    const Filter warning { Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(LogLevel::Warning) };
+    const LogEntryList warnings = poolLogger.getLogsByFilters({ warning });
+    assert(warnings.size() == 1 && warnings.front().message == "Written during scan");
+#ifdef SQLG_USE_SOURCE_INFO
+    assert(warnings.front().sourceName == TEST_SOURCE_INFO.name);
+#endif
+    assert(poolLogger.getAllLogs().size() == numLogs + 1);
+    assert(poolLogger.forEachLog({}, [](const LogEntry&)
+    {
+        return true;
+    }, 7) == numLogs + 1);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    // Readers need WAL on SQLite and a separate database behind every connection
+    config.sqliteJournalMode = "DELETE";
+    assert(!config.validate().ok());
+    config.sqliteJournalMode = "WAL";
+    config.databaseReadHost = "replica.local";
+    assert(!config.validate().ok());
+    config.databaseReadHost = std::nullopt;
+    config.databaseType = DataBaseType::Memory;
+    assert(!config.validate().ok());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the placeholders of filtered DELETE statements
+ */
+void testDeletePlaceholders()
+{
+    std::string testName = "Delete Placeholders test";
+    showMessage(testName + " started...");
+
+    const std::vector<Filter> filters =
+    {
+        {Filter::Type::Unknown, "name", "=", "a"},
+        {Filter::Type::Unknown, "value", "<", "10"}
+    };
+
+    // Positional "?" for SQLite and MySQL, numbered "$n" for PostgreSQL
+    const std::string sqliteQuery = QueryBuilder::buildDelete(DataBaseType::SQLite, "t", filters);
+    assert(sqliteQuery.find("?1") == std::string::npos);
+    assert(std::count(sqliteQuery.begin(), sqliteQuery.end(), '?') == 2);
+    const std::string postgresQuery = QueryBuilder::buildDelete(DataBaseType::PostgreSQL, "t", filters);
+    assert(postgresQuery.find("$1") != std::string::npos && postgresQuery.find("$2") != std::string::npos);
+    assert(postgresQuery.find("$11") == std::string::npos);
+
+    const std::string tableName = "delete_placeholders";
+    const std::string dbName = getTestConfig().databaseName.value();
+    SQLiteDatabase db(dbName);
+    db.connect(dbName);
+    db.execute("DROP TABLE IF EXISTS " + tableName);
+    db.execute("CREATE TABLE " + tableName + " (name TEXT, value INTEGER)");
+    db.execute("INSERT INTO " + tableName + " VALUES ('a', 1), ('a', 20), ('b', 2)");
+
+    // The second parameter used to be unbound (?11), so nothing was deleted
+    assert(db.execute(QueryBuilder::buildDelete(DataBaseType::SQLite, tableName, filters), std::vector<std::string>{ "a", "10" }));
+    ResultSet rows = db.queryResultSet("SELECT name, value FROM " + tableName + " ORDER BY name");
+    assert(rows.rowCount() == 2);
+    assert(rows.getString(0, 0) == "a" && rows.getInt64(0, 1) == 20);
+
+    db.execute("DROP TABLE IF EXISTS " + tableName);
+    db.disconnect();
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for daily partitions of the log table and the partition-dropping retention policy (SQLite).
+ */
+void testPartitions()
+{
+    std::string testName = "Partitions test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "partitions";
+    config.databaseTable = "partitioned_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+    config.minLogLevel = LogLevel::Info;
+    config.partitioning = Partitioning::Daily;
+    config.retentionDays = 3;
+    assert(config.validate().ok());
+
+    SQLogger& partLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+    partLogger.clearLogs();
+
+    const int today = LogPartitions::today();
+    auto timestampOf = [](const int day, const std::string & time)
+    {
+        char date[16];
+        std::snprintf(date, sizeof(date), "%04d-%02d-%02d", day / 10000, day / 100 % 100, day % 100);
+        return std::string(date) + " " + time;
+    };
+    auto entryOf = [ & ](const int day, const std::string & message)
+    {
+        LogEntry entry;
+        entry.timestamp = timestampOf(day, "12:00:00");
+        entry.level = LOG_LEVEL_INFO;
+        entry.message = message;
+        entry.function = "testPartitions";
+        entry.file = "test_logger.cpp";
+        entry.line = __LINE__;
+        entry.threadId = "1";
+        return entry;
+    };
+
+    // Three entries on each of four days, then one more on the oldest day
+    const std::vector<int> days = { LogPartitions::addDays(today, -10), LogPartitions::addDays(today, -5),
+                                    LogPartitions::addDays(today, -1), today
+                                  };
+    LogEntryList entries;
+    for(const int day : days)
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            entries.push_back(entryOf(day, "Partition log " + std::to_string(day)));
+        }
+    }
+    entries.push_back(entryOf(days.front(), "Late partition log"));
+    assert(partLogger.logEntries(entries) == entries.size());
+
+    // IDs are unique and ascending across the partition tables
+    LogEntryList stored = partLogger.getAllLogs();
+    assert(stored.size() == entries.size());
+    std::set<int> ids;
+    int lateId = 0;
+    for(const auto & entry : stored)
+    {
+        ids.insert(entry.id);
+        if(entry.message == "Late partition log")
+        {
+            lateId = entry.id;
+        }
+    }
+    assert(ids.size() == stored.size());
+    assert(lateId == * ids.rbegin());
+
+    // Range queries read through the view over the partitions
+    const LogEntryList range = partLogger.getLogsByTimestampRange(timestampOf(days[1], "00:00:00"),
+                               timestampOf(days[2], "23:59:59"));
+    assert(range.size() == 6);
+    for(const auto & entry : range)
+    {
+        assert(entry.message == "Partition log " + std::to_string(days[1])
+               || entry.message == "Partition log " + std::to_string(days[2]));
+    }
+
+    // Retention drops the partitions older than three days with all their rows
+    assert(partLogger.applyRetention() == 2);
+    assert(partLogger.applyRetention() == 0);
+    stored = partLogger.getAllLogs();
+    assert(stored.size() == 6);
+
+    // IDs keep growing after the partition holding the highest one was dropped
+    SQLOG_INFO(partLogger) << "After retention";
+    const LogEntryList after = partLogger.getLogsByFilters({ { Filter::Type::Unknown, FIELD_LOG_MESSAGE, "=", "After retention" } });
+    assert(after.size() == 1 && after.front().id > lateId);
+
+    // Partitions are found again by a new logger
+    LogManager::getInstance().removeLogger(config.name.value());
+    SQLogger& reopened = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                         , TEST_SOURCE_INFO
+#endif
+                                                               );
+    assert(reopened.getAllLogs().size() == 7);
+    reopened.clearLogs();
+    assert(reopened.getAllLogs().empty());
+    SQLOG_INFO(reopened) << "After clear";
+    assert(reopened.getAllLogs().size() == 1);
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    // A plain log table can't be partitioned in place
+    LogConfig::Config plainConfig = getTestConfig();
+    plainConfig.name = "partitions_plain";
+    plainConfig.databaseTable = "plain_partition_logs";
+    LogManager::getInstance().createLogger(plainConfig.name.value(), plainConfig
+#ifdef SQLG_USE_SOURCE_INFO
+                                           , TEST_SOURCE_INFO
+#endif
+                                          );
+    LogManager::getInstance().removeLogger(plainConfig.name.value());
+    plainConfig.partitioning = Partitioning::Daily;
+    bool rejected = false;
+    try
+    {
+        LogManager::getInstance().createLogger(plainConfig.name.value(), plainConfig
+#ifdef SQLG_USE_SOURCE_INFO
+                                               , TEST_SOURCE_INFO
+#endif
+                                              );
+    }
+    catch(const std::runtime_error&)
+    {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // Retention needs partitions, partitions need a SQL backend
+    config.partitioning = Partitioning::None;
+    assert(!config.validate().ok());
+    config.partitioning = Partitioning::Daily;
+    config.retentionDays = -1;
+    assert(!config.validate().ok());
+    config.retentionDays = 0;
+    config.databaseType = DataBaseType::Memory;
+    assert(!config.validate().ok());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for full-text search on the message column.
+ * Checks word matching through the full-text index, MATCH combined with other filters,
+ * indexing of rows written without the index (bulk-load mode) and the LIKE fallback.
+ */
+void testFullTextSearch()
+{
+    std::string testName = "Full-Text Search test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "full_text_search";
+    config.databaseTable = "fts_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+    config.minLogLevel = LogLevel::Info;
+    config.fullTextSearch = true;
+    assert(config.validate().ok());
+
+    SQLogger& ftsLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                          , TEST_SOURCE_INFO
+#endif
+                                                                );
+    ftsLogger.clearLogs();
+
+    SQLOG_INFO(ftsLogger) << "Connection refused by upstream server";
+    SQLOG_ERROR(ftsLogger) << "Connection timeout while reading response";
+    SQLOG_INFO(ftsLogger) << "Request served in 12 ms";
+    SQLOG_WARNING(ftsLogger) << "Disk \"quota\" almost exceeded";
+
+    // All words must occur, as whole words, in any case
+    assert(ftsLogger.searchLogs("connection").size() == 2);
+    assert(ftsLogger.searchLogs("CONNECTION refused").size() == 1);
+    assert(ftsLogger.searchLogs("refused timeout").empty());
+    assert(ftsLogger.searchLogs("connect").empty());
+    assert(ftsLogger.searchLogs("\"quota\"").size() == 1);
+    assert(ftsLogger.searchLogs("  ").size() == 4);
+    assert(ftsLogger.searchLogs("connection", 1).size() == 1);
+
+    // MATCH combines with other filters
+    LogEntryList errors = ftsLogger.getLogsByFilters(
+    {
+        { Filter::Type::Unknown, FIELD_LOG_MESSAGE, FILTER_OP_MATCH, "connection" },
+        { Filter::Type::Unknown, FIELD_LOG_LEVEL, "=", LOG_LEVEL_ERROR }
+    });
+    assert(errors.size() == 1 && errors.front().message == "Connection timeout while reading response");
+
+    size_t streamed = 0;
+    ftsLogger.forEachLog({ { Filter::Type::Unknown, FIELD_LOG_MESSAGE, FILTER_OP_MATCH, "connection" } }, [ & ](const LogEntry &)
+    {
+        ++streamed;
+        return true;
+    }, 1);
+    assert(streamed == 2);
+
+    // Rows written while the index is dropped are indexed when it is rebuilt
+    assert(ftsLogger.beginBulkLoad());
+    SQLOG_INFO(ftsLogger) << "Connection restored after retry";
+    assert(ftsLogger.searchLogs("connection").size() == 3); // LIKE fallback
+    assert(ftsLogger.endBulkLoad());
+    assert(ftsLogger.searchLogs("connection retry").size() == 1);
+    assert(ftsLogger.searchLogs("connection").size() == 3);
+
+    // Deleted rows leave the index
+    ftsLogger.clearLogs();
+    assert(ftsLogger.searchLogs("connection").empty());
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    // Without the index every word is matched as a substring
+    config.name = "like_search";
+    config.databaseTable = "like_search_logs";
+    config.fullTextSearch = false;
+    SQLogger& likeLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+    likeLogger.clearLogs();
+    SQLOG_INFO(likeLogger) << "Connection refused by upstream server";
+    SQLOG_INFO(likeLogger) << "Request served in 12 ms";
+    assert(likeLogger.searchLogs("connect refused").size() == 1);
+    assert(likeLogger.searchLogs("served").size() == 1);
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    // Backends without SQL have no full-text index
+    LogConfig::Config memoryConfig = config;
+    memoryConfig.databaseType = DataBaseType::Memory;
+    memoryConfig.databaseName = "test_memory_fts";
+    assert(memoryConfig.validate().ok());
+    memoryConfig.fullTextSearch = true;
+    assert(!memoryConfig.validate().ok());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the aggregation queries (countBy(), histogram(), histogramBy()).
+ * Runs the same checks on the standard schema, the compact schema with epoch
+ * timestamps and the in-memory backend.
+ */
+void testAggregation()
+{
+    std::string testName = "Aggregation test";
+    showMessage(testName + " started...");
+
+    auto entryOf = [](const std::string & time, const std::string & level, const std::string & file)
+    {
+        LogEntry entry;
+        entry.timestamp = "2025-03-01 " + time;
+        entry.level = level;
+        entry.message = "Aggregated log";
+        entry.function = "testAggregation";
+        entry.file = file;
+        entry.line = __LINE__;
+        entry.threadId = "1";
+        return entry;
+    };
+    const LogEntryList entries =
+    {
+        entryOf("10:00:05", LOG_LEVEL_INFO, "a.cpp"),
+        entryOf("10:00:40", LOG_LEVEL_ERROR, "a.cpp"),
+        entryOf("10:01:10", LOG_LEVEL_ERROR, "b.cpp"),
+        entryOf("10:05:00", LOG_LEVEL_WARNING, "b.cpp"),
+        entryOf("11:00:00", LOG_LEVEL_ERROR, "a.cpp")
+    };
+    const Filter errors { Filter::Type::Level, FIELD_LOG_LEVEL, "=", LOG_LEVEL_ERROR };
+
+    auto check = [ & ](LogConfig::Config config)
+    {
+        config.syncMode = true;
+        config.useBatch = false;
+        config.minLogLevel = LogLevel::Info;
+        SQLogger& aggLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                              , TEST_SOURCE_INFO
+#endif
+                                                                    );
+        aggLogger.clearLogs();
+        assert(aggLogger.logEntries(entries) == entries.size());
+
+        const LogCounts levels = aggLogger.countBy(FIELD_LOG_LEVEL);
+        assert(levels.size() == 3 && levels.at(LOG_LEVEL_ERROR) == 3
+               && levels.at(LOG_LEVEL_INFO) == 1 && levels.at(LOG_LEVEL_WARNING) == 1);
+
+        const LogCounts files = aggLogger.countBy(FIELD_LOG_FILE, { errors });
+        assert(files.size() == 2 && files.at("a.cpp") == 2 && files.at("b.cpp") == 1);
+
+        const LogCounts perMinute = aggLogger.histogram(60);
+        assert(perMinute.size() == 4);
+        assert(perMinute.at("2025-03-01 10:00:00") == 2 && perMinute.at("2025-03-01 10:01:00") == 1);
+        assert(perMinute.at("2025-03-01 10:05:00") == 1 && perMinute.at("2025-03-01 11:00:00") == 1);
+
+        const LogCounts errorsPerHour = aggLogger.histogram(3600, { errors });
+        assert(errorsPerHour.size() == 2);
+        assert(errorsPerHour.at("2025-03-01 10:00:00") == 2 && errorsPerHour.at("2025-03-01 11:00:00") == 1);
+
+        const LogHistogram errorsPerMinuteFile = aggLogger.histogramBy(FIELD_LOG_FILE, 60, { errors });
+        assert(errorsPerMinuteFile.size() == 3);
+        assert(errorsPerMinuteFile.at("2025-03-01 10:00:00").at("a.cpp") == 1);
+        assert(errorsPerMinuteFile.at("2025-03-01 10:01:00").at("b.cpp") == 1);
+        assert(errorsPerMinuteFile.at("2025-03-01 11:00:00").size() == 1);
+
+        bool thrown = false;
+        try
+        {
+            aggLogger.countBy("unknown_column");
+        }
+        catch(const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try
+        {
+            aggLogger.histogram(0);
+        }
+        catch(const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        aggLogger.clearLogs();
+        assert(aggLogger.countBy(FIELD_LOG_LEVEL).empty());
+        LogManager::getInstance().removeLogger(config.name.value());
+    };
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "aggregation";
+    config.databaseTable = "aggregation_logs";
+    check(config);
+
+    config.name = "aggregation_compact";
+    config.databaseTable = "aggregation_compact_logs";
+    config.schemaLayout = SchemaLayout::Compact;
+    config.timestampFormat = TimestampFormat::EpochMicros;
+    check(config);
+
+    config.name = "aggregation_memory";
+    config.databaseType = DataBaseType::Memory;
+    config.databaseName = "test_memory_aggregation";
+    config.databaseTable = "aggregation_memory_logs";
+    config.schemaLayout = std::nullopt;
+    config.timestampFormat = std::nullopt;
+    check(config);
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the statement text cache of QueryBuilder.
+ */
+void testQueryTextCache()
+{
+    std::string testName = "Query Text Cache test";
+    showMessage(testName + " started...");
+
+    const std::vector<std::string> fields = { "a", "b" };
+    const std::string sqlite = QueryBuilder::buildBatchInsert("text_cache", fields, 3, DataBaseType::SQLite);
+    assert(sqlite == "INSERT INTO \"text_cache\" (\"a\", \"b\") VALUES (?, ?), (?, ?), (?, ?)");
+    const std::string postgres = QueryBuilder::buildBatchInsert("text_cache", fields, 2, DataBaseType::PostgreSQL);
+    assert(postgres == "INSERT INTO \"text_cache\" (\"a\", \"b\") VALUES ($1, $2), ($3, $4)");
+
+    // Hits return the same text without adding entries
+    const size_t cached = QueryBuilder::getCachedTextCount();
+    assert(QueryBuilder::buildBatchInsert("text_cache", fields, 3, DataBaseType::SQLite) == sqlite);
+    assert(QueryBuilder::getCachedTextCount() == cached);
+    assert(QueryBuilder::buildBatchInsert("text_cache", fields, 3, DataBaseType::MySQL)
+           == "INSERT INTO `text_cache` (`a`, `b`) VALUES (?, ?), (?, ?), (?, ?)");
+    assert(QueryBuilder::getCachedTextCount() == std::min<size_t>(cached + 1, QUERY_TEXT_CACHE_SIZE));
+
+    // The cache is bounded
+    for(size_t rows = 1; rows <= QUERY_TEXT_CACHE_SIZE + 10; ++rows)
+    {
+        QueryBuilder::buildBatchInsert("text_cache", fields, rows, DataBaseType::SQLite);
+    }
+    assert(QueryBuilder::getCachedTextCount() == QUERY_TEXT_CACHE_SIZE);
+    assert(QueryBuilder::buildBatchInsert("text_cache", fields, 3, DataBaseType::SQLite) == sqlite);
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test BufferPool recycling and the move-only task pipeline of the batch and asynchronous paths.
+ */
+void testBufferPool()
+{
+    std::string testName = "Buffer Pool test";
+    showMessage(testName + " started...");
+
+    {
+        BufferPool<std::string> pool(1);
+        std::vector<std::string> buffer = pool.acquire(16);
+        assert(buffer.empty() && buffer.capacity() >= 16);
+        buffer.push_back("value");
+        const std::string* storage = buffer.data();
+
+        // Released buffers keep their storage, the pool holds at most maxBuffers
+        pool.release(std::move(buffer));
+        pool.release(std::vector<std::string>(4));
+        pool.release(std::vector<std::string>());
+        assert(pool.size() == 1);
+
+        std::vector<std::string> reused = pool.acquire();
+        assert(reused.empty() && reused.data() == storage);
+        assert(pool.getReuses() == 1 && pool.size() == 0);
+    }
+
+    struct PipelineCase
+    {
+        bool useBatch;
+        bool syncMode;
+    };
+    const std::vector<PipelineCase> cases = { {true, true}, {true, false}, {false, false} };
+    for(const auto & pipeline : cases)
+    {
+        LogConfig::Config config = getTestConfig();
+        config.name = "buffer_pool";
+        config.databaseTable = "buffer_pool_logs";
+        config.useBatch = pipeline.useBatch;
+        config.syncMode = pipeline.syncMode;
+        config.batchSize = 8;
+        config.flushIntervalMs = 0;
+
+        SQLogger& poolLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+        poolLogger.clearLogs();
+
+        // Longer than any small-string buffer, so the text really moves between tasks and entries
+        const std::string padding(64, 'x');
+        const int numLogs = 50;
+        for(int i = 0; i < numLogs; ++i)
+        {
+            if(i % 2 == 0)
+            {
+                poolLogger.info("pooled {} {}", i, padding);
+            }
+            else
+            {
+                SQLOG_INFO(poolLogger) << "pooled " << i << " " << padding;
+            }
+        }
+        poolLogger.flush();
+
+        assert(poolLogger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+        LogEntryList entries = poolLogger.getAllLogs();
+        assert(entries.size() == numLogs);
+        for(int i = 0; i < numLogs; ++i)
+        {
+            const std::string expected = "pooled " + std::to_string(i) + " " + padding;
+            assert(std::any_of(entries.begin(), entries.end(), [ & ](const LogEntry & entry)
+            {
+                return entry.message == expected && !entry.function.empty() && !entry.file.empty() && !entry.threadId.empty();
+            }));
+        }
+
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test BatchTuner decisions and a logger with adaptive batching.
+ */
+void testAdaptiveBatch()
+{
+    std::string testName = "Adaptive Batch test";
+    showMessage(testName + " started...");
+
+    {
+        BatchTuner tuner(1, 1000, 100, std::chrono::milliseconds(10), std::chrono::milliseconds(50));
+        assert(tuner.getBatchSize() == 100);
+        assert(tuner.getFlushInterval() == std::chrono::milliseconds(50));
+
+        // Burst: a queue deeper than one batch grows it, at most to what fits the target
+        tuner.record(100, 1000, 500);
+        assert(tuner.getBatchSize() == 151);
+        assert(tuner.getFlushInterval() == std::chrono::milliseconds(9));
+        tuner.record(151, 9060, 500);
+        assert(tuner.getBatchSize() == 166);
+
+        // Over the target: shrink by a quarter
+        tuner.record(166, 20000, 500);
+        assert(tuner.getBatchSize() == 125);
+        assert(tuner.getFlushInterval() == std::chrono::milliseconds(2));
+
+        // Idle: partial batches with a short queue move the size toward their size
+        tuner.record(5, 100, 0);
+        assert(tuner.getBatchSize() == 65);
+
+        // The range bounds every decision
+        for(int i = 0; i < 50; ++i)
+        {
+            tuner.record(1, 50000, 0);
+        }
+        assert(tuner.getBatchSize() == 1);
+
+        tuner.reset(5000);
+        assert(tuner.getBatchSize() == 1000);
+        assert(tuner.getFlushInterval() == std::chrono::milliseconds(50));
+    }
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "adaptive_batch";
+    config.databaseTable = "adaptive_batch_logs";
+    config.useBatch = true;
+    config.syncMode = false;
+    config.batchSize = 10;
+    config.flushIntervalMs = 0;
+    config.adaptiveBatch = true;
+    config.targetBatchLatencyMs = 50;
+    assert(config.validate().ok());
+
+    LogConfig::Config invalid = config;
+    invalid.targetBatchLatencyMs = 0;
+    assert(!invalid.validate().ok());
+
+    SQLogger& adaptiveLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+    adaptiveLogger.clearLogs();
+
+    // The tuner runs the flush timer even without a configured interval
+    assert(adaptiveLogger.getFlushInterval().count() > 0);
+
+    const int numLogs = 2000;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(adaptiveLogger) << "Adaptive log " << i;
+    }
+
+    // A partial last batch is written by the timer (at most TargetBatchLatencyMs old), without flush()
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    assert(adaptiveLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    assert(adaptiveLogger.getAllLogs().size() == numLogs);
+    assert(adaptiveLogger.getBatchSize() >= DB_MIN_BATCH_SIZE
+           && adaptiveLogger.getBatchSize() <= LogConfig::getMaxBatchSize(config));
+
+    adaptiveLogger.setBatchSize(7);
+    assert(adaptiveLogger.getBatchSize() == 7);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test priority entries: written and committed with the buffered entries before the log call returns.
+ */
+void testPriorityLevel()
+{
+    if(testConfig.databaseType.value() != DataBaseType::SQLite)
+    {
+        std::cout << std::endl << "Skipping priority level test" << std::endl << std::endl;
+        return;
+    }
+
+    std::string testName = "Priority Level test";
+    showMessage(testName + " started...");
+
+    const std::string countQuery = "SELECT COUNT(*) AS cnt FROM priority_logs";
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "priority";
+    config.databaseTable = "priority_logs";
+    config.useBatch = true;
+    config.syncMode = false;
+    config.batchSize = 1000;
+    config.flushIntervalMs = 0;
+    config.groupCommitBatches = 100;
+    config.groupCommitWindowMs = 0;
+    config.priorityLevel = LogLevel::Error;
+
+    SQLogger& priorityLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+    priorityLogger.clearLogs();
+
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+
+    const int numLogs = 20;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(priorityLogger) << "Buffered log " << i;
+    }
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == 0);
+
+    // No wait: the entry and everything buffered before it are committed already
+    SQLOG_ERROR(priorityLogger) << "Priority log";
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == numLogs + 1);
+
+    SQLOG_WARNING(priorityLogger) << "Below the priority level";
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == numLogs + 1);
+    priorityLogger.flush();
+    assert(priorityLogger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    assert(std::stoi(verifyDb.query(countQuery).at(0).at("cnt")) == numLogs + 2);
+
+    assert(priorityLogger.getStats().totalLogged == numLogs + 2);
+    verifyDb.disconnect();
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    // Small batches go to the thread pool: a priority entry is still stored behind them
+    config.name = "priority_order";
+    config.databaseTable = "priority_order_logs";
+    config.batchSize = 5;
+    SQLogger& orderLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                            , TEST_SOURCE_INFO
+#endif
+                                                                  );
+    orderLogger.clearLogs();
+
+    const int numOrdered = 200;
+    for(int i = 0; i < numOrdered; ++i)
+    {
+        if(i % 10 == 9)
+        {
+            SQLOG_ERROR(orderLogger) << "Ordered log " << i;
+        }
+        else
+        {
+            SQLOG_INFO(orderLogger) << "Ordered log " << i;
+        }
+    }
+    orderLogger.flush();
+    assert(orderLogger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    std::vector<int> ids(numOrdered, 0);
+    const LogEntryList ordered = orderLogger.getAllLogs();
+    assert(ordered.size() == numOrdered);
+    for(const auto & entry : ordered)
+    {
+        ids[std::stoi(entry.message.substr(entry.message.rfind(' ') + 1))] = entry.id;
+    }
+    int maxBefore = 0;
+    for(int i = 0; i < numOrdered; ++i)
+    {
+        if(i % 10 == 9)
+        {
+            assert(ids[i] > maxBefore);
+        }
+        maxBefore = std::max(maxBefore, ids[i]);
+    }
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test LogThrottle sampling, rate limits and duplicate folding, and a throttled logger.
+ */
+void testThrottle()
+{
+    std::string testName = "Throttle test";
+    showMessage(testName + " started...");
+
+    using Verdict = LogThrottle::Verdict;
+    std::optional<LogThrottle::Repeat> repeat;
+
+    {
+        LogThrottle throttle(1.0, LogLevel::Warning, 0, 0, std::chrono::seconds(60));
+        assert(throttle.admit(LogLevel::Warning, "storm", "", "f", "a.cpp", 1, repeat) == Verdict::Accept);
+        for(int i = 0; i < 4; ++i)
+        {
+            assert(throttle.admit(LogLevel::Warning, "storm", "", "f", "a.cpp", 1, repeat) == Verdict::Repeated);
+        }
+        // Same text with other arguments, or from another site, is not a repeat
+        assert(throttle.admit(LogLevel::Warning, "storm", "x", "f", "a.cpp", 1, repeat) == Verdict::Accept);
+        assert(repeat.has_value() && repeat->count == 4 && repeat->file == "a.cpp" && repeat->line == 1);
+        assert(repeat->message() == "Last message repeated 4 times");
+        repeat.reset();
+        assert(throttle.admit(LogLevel::Warning, "storm", "x", "f", "a.cpp", 2, repeat) == Verdict::Accept);
+        assert(!repeat.has_value());
+
+        assert(throttle.admit(LogLevel::Warning, "storm", "x", "f", "a.cpp", 2, repeat) == Verdict::Repeated);
+        const auto pending = throttle.takeRepeats();
+        assert(pending.size() == 1 && pending[0].count == 1 && pending[0].line == 2);
+        assert(throttle.takeRepeats().empty());
+        assert(throttle.getStats().repeated == 5);
+    }
+
+    {
+        LogThrottle throttle(1.0, LogLevel::Warning, 3, 5, std::chrono::milliseconds(0));
+        int accepted = 0;
+        for(int i = 0; i < 6; ++i)
+        {
+            accepted += throttle.admit(LogLevel::Info, std::to_string(i), "", "f", "a.cpp", 1, repeat) == Verdict::Accept;
+        }
+        assert(accepted == 3);
+
+        // The level limit spans call sites, other levels have their own window
+        assert(throttle.admit(LogLevel::Info, "b", "", "f", "b.cpp", 1, repeat) == Verdict::Accept);
+        assert(throttle.admit(LogLevel::Info, "c", "", "f", "c.cpp", 1, repeat) == Verdict::Accept);
+        assert(throttle.admit(LogLevel::Info, "d", "", "f", "d.cpp", 1, repeat) == Verdict::RateLimited);
+        assert(throttle.admit(LogLevel::Error, "e", "", "f", "d.cpp", 1, repeat) == Verdict::Accept);
+        assert(throttle.getStats().rateLimited == 4);
+        throttle.resetStats();
+        assert(throttle.getStats().rateLimited == 0);
+    }
+
+    {
+        LogThrottle none(0.0, LogLevel::Warning, 0, 0, std::chrono::milliseconds(0));
+        assert(none.admit(LogLevel::Debug, "a", "", "f", "a.cpp", 1, repeat) == Verdict::Sampled);
+        assert(none.admit(LogLevel::Warning, "a", "", "f", "a.cpp", 1, repeat) == Verdict::Accept);
+
+        LogThrottle half(0.5, LogLevel::Warning, 0, 0, std::chrono::milliseconds(0));
+        int kept = 0;
+        for(int i = 0; i < 2000; ++i)
+        {
+            kept += half.admit(LogLevel::Debug, "a", "", "f", "a.cpp", 1, repeat) == Verdict::Accept;
+        }
+        assert(kept > 800 && kept < 1200);
+        assert(half.getStats().sampled == static_cast<uint64_t>(2000 - kept));
+    }
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "throttle";
+    config.databaseTable = "throttle_logs";
+    config.useBatch = true;
+    config.syncMode = false;
+    config.batchSize = 100;
+    config.dedupWindowMs = 60000;
+    config.rateLimitPerSite = 100;
+    config.priorityLevel = LogLevel::Error;
+    assert(config.validate().ok());
+
+    LogConfig::Config invalid = config;
+    invalid.sampleRate = 1.5;
+    assert(!invalid.validate().ok());
+
+    SQLogger& throttleLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                               , TEST_SOURCE_INFO
+#endif
+                                                                     );
+    throttleLogger.clearLogs();
+
+    const int numLogs = 500;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_WARNING(throttleLogger) << "Same warning";
+    }
+    int limited = 0;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(throttleLogger) << "Distinct info " << i;
+    }
+    for(int i = 0; i < 3; ++i)
+    {
+        // Priority entries are never throttled
+        SQLOG_ERROR(throttleLogger) << "Same error";
+    }
+
+    throttleLogger.flush();
+    assert(throttleLogger.waitUntilDurable(std::chrono::system_clock::now(), std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+
+    const SQLogger::Stats stats = throttleLogger.getStats();
+    assert(stats.totalRepeated == numLogs - 1);
+    limited = static_cast<int>(stats.totalRateLimited);
+    assert(limited > 0 && limited <= numLogs - 100);
+
+    LogEntryList entries = throttleLogger.getAllLogs();
+    assert(entries.size() == static_cast<size_t>(1 + 1 + (numLogs - limited) + 3));
+    assert(std::count_if(entries.begin(), entries.end(), [](const LogEntry & entry)
+    {
+        return entry.message == "Last message repeated " + std::to_string(numLogs - 1) + " times"
+               && entry.level == levelToString(LogLevel::Warning);
+    }) == 1);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the file sink and additional sinks (rotation, fan-out, independent queues).
+ */
+void testFileSink()
+{
+    std::string testName = "File sink test";
+    showMessage(testName + " started...");
+
+    std::filesystem::remove_all("test_sink");
+
+    const auto countFileLines = [](const std::string & path)
+    {
+        std::ifstream in(path);
+        size_t lines = 0;
+        for(std::string line; std::getline(in, line);)
+        {
+            ++lines;
+        }
+        return lines;
+    };
+
+    LogEntry sample;
+    sample.timestamp = "2025-01-01 00:00:00.000";
+    sample.level = levelToString(LogLevel::Info);
+    sample.message = "File sink entry";
+    sample.function = __func__;
+    sample.file = __FILE__;
+    sample.line = __LINE__;
+    sample.threadId = "1";
+
+    {
+        // 100 NDJSON lines of ~200 bytes, rotated every 1 KB, two segments kept
+        LogFileSink sink("test_sink/rotate.ndjson", LogExport::Format::NDJSON, 1024, std::chrono::seconds(0), 2);
+        for(int i = 0; i < 100; ++i)
+        {
+            assert(sink.write(LogEntryList{ sample }));
+        }
+        sink.flush();
+        assert(sink.getRotations() > 2);
+        assert(std::filesystem::exists("test_sink/rotate.ndjson.1"));
+        assert(std::filesystem::exists("test_sink/rotate.ndjson.2"));
+        assert(!std::filesystem::exists("test_sink/rotate.ndjson.3"));
+        assert(std::filesystem::file_size("test_sink/rotate.ndjson.1") < 2048);
+        assert(countFileLines("test_sink/rotate.ndjson.1") > 0);
+    }
+
+    {
+        LogFileSink sink("test_sink/closed.json", LogExport::Format::JSON);
+        assert(sink.write(LogEntryList{ sample, sample }));
+    }
+    {
+        // A closed JSON document is moved away instead of appended to
+        LogFileSink sink("test_sink/closed.json", LogExport::Format::JSON);
+        assert(sink.write(LogEntryList{ sample }));
+    }
+    assert(std::filesystem::exists("test_sink/closed.json.1"));
+    {
+        std::ifstream in("test_sink/closed.json");
+        const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        assert(text.front() == '[' && text.find(']') == text.size() - 2);
+        assert(text.find(sample.message) == text.rfind(sample.message));
+    }
+
+    /**
+     * @brief Sink counting the entries it receives, slowed down to show its queue is independent.
+     */
+    class CountingSink : public ILogSink
+    {
+        public:
+            bool write(const LogEntryList& entries) override
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                count += entries.size();
+                return true;
+            }
+
+            std::string getName() const override
+            {
+                return "counting";
+            }
+
+            std::atomic<size_t> count{ 0 };
+    };
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "file_sink";
+    config.databaseTable = "file_sink_logs";
+    config.fileSinkPath = "test_sink/logger.ndjson";
+    config.fileSinkFormat = LogExport::Format::NDJSON;
+    config.sinkQueueSize = 100000;
+    assert(config.validate().ok());
+
+    LogConfig::Config invalid = config;
+    invalid.sinkQueueSize = 0;
+    assert(!invalid.validate().ok());
+
+    SQLogger& sinkLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+    sinkLogger.clearLogs();
+
+    auto counting = std::make_shared<CountingSink>();
+    sinkLogger.addSink(counting);
+
+    const int numLogs = 1000;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(sinkLogger) << "Sink entry " << i;
+    }
+
+    sinkLogger.flush();
+    assert(sinkLogger.waitForSinks(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    assert(countFileLines("test_sink/logger.ndjson") == static_cast<size_t>(numLogs));
+    assert(counting->count == static_cast<size_t>(numLogs));
+
+    const SQLogger::Stats stats = sinkLogger.getStats();
+    assert(stats.totalSinkWritten == static_cast<uint64_t>(numLogs) * 2);
+    assert(stats.totalSinkDropped == 0);
+
+    std::ifstream in("test_sink/logger.ndjson");
+    std::string first;
+    std::getline(in, first);
+    assert(first.find("Sink entry 0") != std::string::npos);
+    in.close();
+
+    LogManager::getInstance().removeLogger(config.name.value());
+    std::filesystem::remove_all("test_sink");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the logger thread settings (CPU lists, affinity and wait strategies).
+ */
+void testThreadSettings()
+{
+    std::string testName = "Thread settings test";
+    showMessage(testName + " started...");
+
+    assert(LogConfig::stringToCpuList("0, 2,4-6") == std::vector<int>({ 0, 2, 4, 5, 6 }));
+    assert(LogConfig::stringToCpuList("").value().empty());
+    assert(!LogConfig::stringToCpuList("3-1").has_value());
+    assert(!LogConfig::stringToCpuList("1,a").has_value());
+    assert(!LogConfig::stringToCpuList("1-2-3").has_value());
+    assert(LogConfig::cpuListToString({ 1, 3 }) == "1,3");
+    assert(LogConfig::stringToWaitStrategy("spin") == WaitStrategy::Spin);
+    assert(LogConfig::waitStrategyToString(WaitStrategy::Hybrid) == LOG_WAIT_STRATEGY_STR_HYBRID);
+    assert(!LogConfig::stringToWaitStrategy("sleep").has_value());
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "thread_settings";
+    config.databaseTable = "thread_settings_logs";
+    config.useBatch = true;
+    config.batchSize = 100;
+    config.useRing = true;
+    config.threadPriority = THREAD_HELPER_PRIORITY_MAX + 1;
+    assert(!config.validate().ok());
+    config.threadPriority = std::nullopt;
+
+    // Pin to a CPU the test may run on (containers may not have CPU 0)
+    const std::vector<int> allowed = ThreadHelper::getAffinity();
+    if(!allowed.empty())
+    {
+        config.threadAffinity = std::vector<int>{ allowed.front() };
+    }
+
+    for(const WaitStrategy wait : { WaitStrategy::Spin, WaitStrategy::Hybrid, WaitStrategy::Block })
+    {
+        ThreadHelper::Settings settings;
+        settings.cpus = config.threadAffinity.value_or(std::vector<int>());
+        settings.wait = wait;
+
+        std::atomic<int> done{ 0 };
+        std::atomic<int> pinned{ 0 };
+        {
+            ThreadPool pool(2, settings);
+            assert(pool.getSetupError().empty());
+            for(int i = 0; i < 100; ++i)
+            {
+                pool.enqueue([ &, settings]
+                {
+                    pinned += settings.cpus.empty() || ThreadHelper::getAffinity() == settings.cpus;
+                    ++done;
+                });
+            }
+            pool.waitForCompletion();
+        }
+        assert(done == 100);
+        assert(pinned == 100);
+    }
+
+    config.waitStrategy = WaitStrategy::Spin;
+    assert(config.validate().ok());
+
+    SQLogger& pinnedLogger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                                                                   );
+    pinnedLogger.clearLogs();
+
+    const int numLogs = 200;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        SQLOG_INFO(pinnedLogger) << "Pinned entry " << i;
+    }
+    assert(pinnedLogger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC)));
+    assert(pinnedLogger.getAllLogs().size() == static_cast<size_t>(numLogs));
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for a logger whose source comes from Config::sourceUuid and Config::sourceName.
+ */
+void testConfigSource()
+{
+    std::string testName = "Config Source test";
+
+#ifdef SQLG_USE_SOURCE_INFO
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "config_source";
+    config.sourceUuid = "1b4e28ba-2fa1-11d2-883f-0016d3cca427";
+    config.sourceName = "config_source";
+
+    {
+        // No SourceInfo argument: the configured source is registered
+        SQLogger& logger = LogManager::getInstance().createLogger(config.name.value(), config);
+        auto source = logger.getSourceByUuid(config.sourceUuid.value());
+        assert(source.has_value() && source->name == config.sourceName.value());
+
+        SQLOG_INFO(logger) << "From the configured source";
+        logger.waitUntilEmpty(std::chrono::milliseconds(TEST_WAIT_UNTIL_EMPTY_MSEC));
+        logger.flush();
+        LogEntryList logs = logger.getLogsBySourceUuid(config.sourceUuid.value());
+        assert(logs.size() == 1 && logs.front().sourceName == config.sourceName.value());
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    showMessage(testName + " passed!\n");
+#else
+    showMessage(testName + " skipped (SQLG_USE_SOURCE_INFO not defined).");
+#endif
+}
+
+/**
+ * @brief Tests the schema version marker and the single round trip source registration.
+ */
+void testSchemaVersion()
+{
+    std::string testName = "Schema Version test";
+    showMessage(testName + " started...");
+
+    const std::string upsert = QueryBuilder::buildUpsertReturning(DataBaseType::SQLite, "t", { {"k", "1"}, {"v", "2"} }, "k", { "id" });
+    assert(upsert.find("ON CONFLICT") != std::string::npos && upsert.find("RETURNING") != std::string::npos);
+    assert(QueryBuilder::buildUpsertReturning(DataBaseType::MySQL, "t", { {"k", "1"} }, "k", { "id" }).empty());
+    assert(QueryBuilder::buildSchemaVersionQuery(DataBaseType::Mock, SCHEMA_TABLE_NAME, "t", {}).empty());
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "schema_version";
+    config.databaseTable = "schema_version_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+
+    const std::string markerQuery = std::string("SELECT ") + FIELD_SCHEMA_VERSION + " FROM " + SCHEMA_TABLE_NAME
+                                    + " WHERE " + FIELD_SCHEMA_TABLE + " = '" + config.databaseTable.value() + "'";
+    const std::string indexQuery = "SELECT name FROM sqlite_master WHERE type = 'index' AND name LIKE 'idx_"
+                                   + config.databaseTable.value() + "_%'";
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+
+    auto openLogger = [ & ]() -> SQLogger&
+    {
+        return LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+        , TEST_SOURCE_INFO
+#endif
+                                                     );
+    };
+
+    // First start: tables and indexes are created, then the marker is stored
+    SQLogger& first = openLogger();
+    SQLOG_INFO(first) << "First start";
+#ifdef SQLG_USE_SOURCE_INFO
+    const auto firstSource = first.getSourceByUuid(TEST_SOURCE_UUID);
+    assert(firstSource.has_value());
+#endif
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    auto marker = verifyDb.query(markerQuery);
+    assert(marker.size() == 1);
+    const std::string version = marker.at(0).at(FIELD_SCHEMA_VERSION);
+    assert(version.find(std::to_string(SCHEMA_VERSION) + SCHEMA_SIGNATURE_DELIMITER) == 0);
+
+    // Same layout: the marker is reused, the source keeps its id
+    SQLogger& second = openLogger();
+    SQLOG_INFO(second) << "Second start";
+    assert(second.getLogsByLevel(LogLevel::Info).size() == 2);
+#ifdef SQLG_USE_SOURCE_INFO
+    const auto secondSource = second.getSourceByUuid(TEST_SOURCE_UUID);
+    assert(secondSource.has_value() && secondSource->sourceId == firstSource->sourceId);
+    assert(second.findOrAddSource(TEST_SOURCE_NAME, TEST_SOURCE_UUID) == firstSource->sourceId);
+#endif
+    LogManager::getInstance().removeLogger(config.name.value());
+    assert(verifyDb.query(markerQuery).at(0).at(FIELD_SCHEMA_VERSION) == version);
+
+    // Another index layout migrates the indexes and replaces the marker
+    config.indexes = LogConfig::stringToIndexes("level+timestamp");
+    openLogger();
+    LogManager::getInstance().removeLogger(config.name.value());
+    assert(verifyDb.query(markerQuery).at(0).at(FIELD_SCHEMA_VERSION) != version);
+    bool migrated = false;
+    for(const auto & row : verifyDb.query(indexQuery))
+    {
+        migrated = migrated || row.at("name") == "idx_schema_version_logs_level_timestamp";
+    }
+    assert(migrated);
+
+    // A table dropped behind the logger's back is created again despite the marker
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    SQLogger& third = openLogger();
+    SQLOG_INFO(third) << "After drop";
+    assert(third.getLogsByLevel(LogLevel::Info).size() == 1);
+
+    // Dropped indexes invalidate the marker until the next full start
+    assert(third.beginBulkLoad());
+    assert(verifyDb.query(markerQuery).empty());
+    assert(third.endBulkLoad());
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    verifyDb.disconnect();
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests snapshot lookups of LogManager and loggers sharing one connection.
+ */
+void testSharedConnection()
+{
+    std::string testName = "Shared Connection test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.syncMode = true;
+    config.useBatch = false;
+    config.shareConnection = true;
+    config.groupCommitBatches = 4;
+
+    LogConfig::Config configA = config;
+    configA.name = "shared_a";
+    configA.databaseTable = "shared_a_logs";
+    LogConfig::Config configB = config;
+    configB.name = "shared_b";
+    configB.databaseTable = "shared_b_logs";
+
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + configA.databaseTable.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + configB.databaseTable.value());
+
+    LogManager& manager = LogManager::getInstance();
+    const int sharedBefore = manager.getSharedConnectionCount();
+    SQLogger& loggerA = manager.createLogger(configA.name.value(), configA
+#ifdef SQLG_USE_SOURCE_INFO
+                        , TEST_SOURCE_INFO
+#endif
+                                            );
+    SQLogger& loggerB = manager.createLogger(configB.name.value(), configB
+#ifdef SQLG_USE_SOURCE_INFO
+                        , TEST_SOURCE_INFO
+#endif
+                                            );
+
+    // One connection for both, group commit is off for shared connections
+    assert(manager.getSharedConnectionCount() == sharedBefore + 1);
+    assert(loggerA.getConfig().groupCommitBatches.value() == 0);
+
+    // Lookups race with loggers being created and removed
+    constexpr int numThreads = 4;
+    constexpr int numLogs = 50;
+    std::atomic<bool> lookupOk{ true };
+    std::vector<std::thread> threads;
+    for(int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([ &, t]()
+        {
+            SQLogger& logger = t % 2 == 0 ? manager.getLogger(configA.name.value()) : manager.getLogger(configB.name.value());
+            for(int i = 0; i < numLogs; ++i)
+            {
+                SQLOG_INFO(logger) << "Shared " << t << " " << i;
+                if(!manager.findLogger(configA.name.value()) || &manager.getLogger(configB.name.value()) != &loggerB)
+                {
+                    lookupOk = false;
+                }
+            }
+        });
+    }
+
+    LogConfig::Config configC = config;
+    configC.name = "shared_c";
+    configC.databaseTable = "shared_c_logs";
+    for(int i = 0; i < 5; ++i)
+    {
+        manager.createLogger(configC.name.value(), configC
+#ifdef SQLG_USE_SOURCE_INFO
+                             , TEST_SOURCE_INFO
+#endif
+                            );
+        manager.removeLogger(configC.name.value());
+    }
+
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+    assert(lookupOk);
+    assert(manager.findLogger(configC.name.value()) == nullptr);
+
+    assert(loggerA.getLogsByLevel(LogLevel::Info).size() == numLogs * numThreads / 2);
+    assert(loggerB.getLogsByLevel(LogLevel::Info).size() == numLogs * numThreads / 2);
+
+    // A handle outlives the removal, the connection closes with its last logger
+    auto handle = manager.findLogger(configA.name.value());
+    manager.removeLogger(configA.name.value());
+    assert(handle && manager.findLogger(configA.name.value()) == nullptr);
+    handle.reset();
+    assert(manager.getSharedConnectionCount() == sharedBefore + 1);
+    manager.removeLogger(configB.name.value());
+    assert(manager.getSharedConnectionCount() == sharedBefore);
+
+    verifyDb.disconnect();
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the AES-GCM encryption of the message column
+ */
+void testMessageEncryption()
+{
+    std::string testName = "Message Encryption test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.syncMode = true;
+    config.useBatch = false;
+    config.name = "encrypted";
+    config.databaseTable = "encrypted_logs";
+    config.encryptMessages = true;
+    config.passKey = TEST_ENC_DEC_PASS_KEY;
+
+    // Options the stored ciphertext can't serve
+    LogConfig::Config invalid = config;
+    invalid.passKey.reset();
+    assert(!invalid.validate().ok());
+    invalid = config;
+    invalid.fullTextSearch = true;
+    assert(!invalid.validate().ok());
+
+    if(!LogCipher::isSupported())
+    {
+        assert(!config.validate().ok());
+        showMessage(testName + " passed!\n");
+        return;
+    }
+    assert(config.validate().ok());
+
+    LogCipher cipher(TEST_ENC_DEC_PASS_KEY);
+    const std::string secret = "card 4111 1111 1111 1111";
+    const std::string first = cipher.encrypt(secret);
+    const std::string second = cipher.encrypt(secret);
+    assert(LogCipher::isEncrypted(first) && first != second); // fresh nonce per message
+    assert(cipher.decrypt(first).value() == secret);
+    assert(cipher.decrypt(cipher.encrypt("")).value().empty());
+    assert(cipher.decrypt("plain text").value() == "plain text");
+
+    LogCipher otherKey("another key");
+    assert(!otherKey.decrypt(first).has_value());
+    std::string tampered = first;
+    tampered[tampered.size() / 2] = tampered[tampered.size() / 2] == 'A' ? 'B' : 'A';
+    assert(!cipher.decrypt(tampered).has_value());
+
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+
+    {
+        SQLogger& logger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+
+        constexpr int numThreads = 4;
+        constexpr int numLogs = 25;
+        std::vector<std::thread> threads;
+        for(int t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([ &, t]()
+            {
+                for(int i = 0; i < numLogs; ++i)
+                {
+                    SQLOG_INFO(logger) << "Secret " << t << " " << i;
+                }
+            });
+        }
+        for(auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        // Stored encrypted, read back as plaintext
+        ResultSet stored = verifyDb.queryResultSet("SELECT " + std::string(FIELD_LOG_MESSAGE) + " FROM " + config.databaseTable.value() + ";");
+        assert(stored.rowCount() == numThreads * numLogs);
+        for(size_t row = 0; row < stored.rowCount(); ++row)
+        {
+            const std::string message = stored.getString(row, 0);
+            assert(LogCipher::isEncrypted(message) && message.find("Secret") == std::string::npos);
+        }
+
+        LogEntryList logs = logger.getLogsByLevel(LogLevel::Info);
+        assert(logs.size() == numThreads * numLogs);
+        for(const auto & entry : logs)
+        {
+            assert(entry.message.rfind("Secret ", 0) == 0);
+        }
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    verifyDb.disconnect();
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Tests the Parquet and Arrow IPC export.
+ */
+void testColumnarExport()
+{
+    std::string testName = "Columnar Export test";
+    showMessage(testName + " started...");
+
+    assert(LogExport::stringToFormat("parquet") == LogExport::Format::PARQUET);
+    assert(LogExport::stringToFormat("Arrow") == LogExport::Format::ARROW);
+    assert(LogExport::isColumnar(LogExport::Format::PARQUET) && !LogExport::isColumnar(LogExport::Format::CSV));
+
+    // Columnar formats have no text form (e.g. for the file sink)
+    bool thrown = false;
+    try
+    {
+        LogExport::formatHeader(LogExport::Format::PARQUET);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    LogEntryList entries;
+    const size_t count = LOG_EXPORT_CHUNK_SIZE * 2 + 100; // several batches, dictionaries grow between them
+    for(size_t i = 0; i < count; ++i)
+    {
+        LogEntry entry;
+        entry.id = static_cast<int>(i + 1);
+        entry.timestamp = "2025-01-01 12:00:00.000";
+        entry.level = LogHelper::levelToString(i % 3 == 0 ? LogLevel::Info : LogLevel::Error);
+        entry.message = "Columnar message " + std::to_string(i);
+        entry.function = "testColumnarExport";
+        entry.file = "file_" + std::to_string(i * 20 / count) + ".cpp";
+        entry.line = static_cast<int>(i % 500);
+        entry.threadId = std::to_string(1000 + i % 4);
+#ifdef SQLG_USE_SOURCE_INFO
+        entry.sourceId = 1;
+        entry.sourceUuid = "550e8400-e29b-41d4-a716-446655440000";
+        entry.sourceName = "Source";
+#endif
+        entries.push_back(entry);
+    }
+
+    auto readFile = [](const std::string & filePath)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    const std::string basePath = std::filesystem::absolute(TEST_EXPORT_FILE).string() + "_columnar";
+    SQLogger::exportTo(basePath + ".csv", LogExport::Format::CSV, entries);
+    const size_t csvSize = readFile(basePath + ".csv").size();
+
+    const std::vector<std::pair<LogExport::Format, std::string>> formats =
+    {
+        {LogExport::Format::PARQUET, ".parquet"},
+        {LogExport::Format::ARROW, ".arrow"}
+    };
+    for(const auto & [format, extension] : formats)
+    {
+        const std::string filePath = basePath + extension;
+        if(!LogExport::isSupported(format))
+        {
+            thrown = false;
+            try
+            {
+                SQLogger::exportTo(filePath, format, entries);
+            }
+            catch(const std::runtime_error&)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+            continue;
+        }
+
+        const std::string magic = format == LogExport::Format::PARQUET ? "PAR1" : "ARROW1";
+        for(const auto compression : { LogCompress::Compression::None, LogCompress::Compression::Zstd })
+        {
+            if(!LogColumnarWriter::isSupported(format, compression))
+            {
+                continue;
+            }
+            LogExport::Writer writer(filePath, format, ENTRY_DELIMITER, true, 2, compression);
+            for(const auto & entry : entries)
+            {
+                writer.write(entry);
+            }
+            writer.close();
+            assert(writer.count() == count);
+
+            const std::string data = readFile(filePath);
+            assert(data.compare(0, magic.size(), magic) == 0);
+            assert(data.compare(data.size() - magic.size(), magic.size(), magic) == 0);
+            assert(data.size() < csvSize);
+        }
+
+        // An empty export is still a valid file
+        SQLogger::exportTo(basePath + "_empty" + extension, format, {});
+        assert(readFile(basePath + "_empty" + extension).compare(0, magic.size(), magic) == 0);
+    }
+
+    // Arrow IPC buffers have no gzip codec
+    thrown = false;
+    try
+    {
+        SQLogger::exportTo(basePath + ".arrow", LogExport::Format::ARROW, entries, ENTRY_DELIMITER, true, LogCompress::Compression::Gzip);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::filesystem::remove(basePath + ".csv");
+    for(const auto & [format, extension] : formats)
+    {
+        std::filesystem::remove(basePath + extension);
+        std::filesystem::remove(basePath + "_empty" + extension);
+    }
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the asynchronous query API
+ */
+void testAsyncQueries()
+{
+    std::string testName = "Async Queries test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "async_queries";
+    config.databaseTable = "async_queries_logs";
+    config.syncMode = true;
+    config.useBatch = false;
+    config.readPoolSize = 4;
+    assert(config.validate().ok());
+
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    verifyDb.disconnect();
+
+    SQLogger& logger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                       , TEST_SOURCE_INFO
+#endif
+                                                             );
+
+    constexpr int numLevels = 4;
+    constexpr int numLogs = 50;
+    const LogLevel levels[numLevels] = { LogLevel::Debug, LogLevel::Info, LogLevel::Warning, LogLevel::Error };
+    for(int i = 0; i < numLogs; ++i)
+    {
+        for(int l = 0; l <= i % numLevels; ++l)
+        {
+            logger.log(levels[l], "Async query " + std::to_string(i));
+        }
+    }
+
+    auto expected = [&](const int level)
+    {
+        int count = 0;
+        for(int i = 0; i < numLogs; ++i)
+        {
+            count += level <= i % numLevels;
+        }
+        return static_cast<size_t>(count);
+    };
+
+    // Independent queries are issued at once and collected later
+    std::vector<std::future<LogEntryList>> futures;
+    for(int q = 0; q < 20; ++q)
+    {
+        const int level = q % numLevels;
+        futures.push_back(logger.getLogsByFiltersAsync({ {Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(levels[level])} }));
+    }
+    for(int q = 0; q < 20; ++q)
+    {
+        assert(futures[q].get().size() == expected(q % numLevels));
+    }
+
+    // Limit and offset as in getLogsByFilters()
+    assert(logger.getLogsByFiltersAsync({}, 10, 5).get().size() == 10);
+
+    // Callback style, run on a query thread
+    std::promise<LogEntryList> called;
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> otherThread{ false };
+    logger.getLogsByFiltersAsync({ {Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(LogLevel::Error)} }, -1, -1,
+                                 [ &](LogEntryList entries)
+    {
+        otherThread = std::this_thread::get_id() != caller;
+        called.set_value(std::move(entries));
+    });
+    assert(called.get_future().get().size() == expected(3));
+    assert(otherThread);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for sharding the log table across several SQLite databases.
+ */
+void testSharding()
+{
+    std::string testName = "Sharding test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.name = "sharded";
+    config.databaseTable = "sharded_logs";
+    config.syncMode = true;
+    config.useBatch = true;
+    config.batchSize = 10;
+    config.shardRouting = ShardRouting::RoundRobin;
+    config.shards = std::vector<LogConfig::DatabaseTarget>(2);
+    config.shards->at(0).name = "test_shard_1.db";
+    config.shards->at(1).name = "test_shard_2.db";
+    assert(config.validate().ok());
+
+    const std::vector<LogConfig::Config> shardConfigs = LogConfig::getShardConfigs(config);
+    assert(shardConfigs.size() == 3);
+    assert(shardConfigs[1].databaseName.value() == "test_shard_1.db");
+    for(const auto & shardConfig : shardConfigs)
+    {
+        SQLiteDatabase shardDb(shardConfig.databaseName.value());
+        shardDb.connect(shardConfig.databaseName.value());
+        shardDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+        shardDb.disconnect();
+    }
+
+    // The INI file keeps the targets in [Database.N] sections
+    saveConfig(config, "test_shards.ini");
+    const LogConfig::Config loaded = loadConfig("test_shards.ini", TEST_ENC_DEC_PASS_KEY);
+    assert(loaded.shards.has_value() && loaded.shards->size() == 2);
+    assert(loaded.shards->at(1).name.value() == "test_shard_2.db");
+    assert(loaded.shardRouting.value() == ShardRouting::RoundRobin);
+    std::remove("test_shards.ini");
+
+    // Features of a single SQL database are rejected
+    LogConfig::Config invalid = config;
+    invalid.fullTextSearch = true;
+    assert(!invalid.validate().ok());
+
+    SQLogger& logger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                       , TEST_SOURCE_INFO
+#endif
+                                                             );
+
+    constexpr int numLogs = 60;
+    for(int i = 0; i < numLogs; ++i)
+    {
+        logger.log(i % 2 == 0 ? LogLevel::Info : LogLevel::Error, "Shard " + std::to_string(i));
+    }
+    logger.flush();
+
+    // Whole batches go to the shards in turn
+    for(const auto & shardConfig : shardConfigs)
+    {
+        SQLiteDatabase shardDb(shardConfig.databaseName.value());
+        shardDb.connect(shardConfig.databaseName.value());
+        const auto rows = shardDb.query("SELECT COUNT(*) AS n FROM " + config.databaseTable.value());
+        assert(!rows.empty() && std::stoi(rows.front().at("n")) == numLogs / 3);
+        shardDb.disconnect();
+    }
+
+    // Merged by timestamp, limit and offset apply to the merged entries
+    const LogEntryList all = logger.getLogsByFilters({});
+    assert(all.size() == numLogs);
+    std::set<int> ids;
+    for(size_t i = 0; i < all.size(); ++i)
+    {
+        ids.insert(all[i].id);
+        assert(i == 0 || all[i - 1].timestamp <= all[i].timestamp);
+    }
+    assert(ids.size() == numLogs);
+
+    const LogEntryList page = logger.getLogsByFilters({}, 10, 25);
+    assert(page.size() == 10);
+    for(size_t i = 0; i < page.size(); ++i)
+    {
+        assert(page[i].id == all[25 + i].id);
+    }
+
+    assert(logger.getLogsByFilters({ {Filter::Type::Level, FIELD_LOG_LEVEL, "=", levelToString(LogLevel::Error)} }).size() == numLogs / 2);
+
+    // ID order across the shards, global IDs select the entry of their shard
+    std::vector<int> scanned;
+    logger.forEachLog({}, [ & ](const LogEntry & entry)
+    {
+        scanned.push_back(entry.id);
+        return true;
+    });
+    assert(scanned.size() == numLogs);
+    assert(std::is_sorted(scanned.begin(), scanned.end()));
+
+    const LogEntry& probe = all[numLogs / 2];
+    const LogEntryList byId = logger.getLogsByFilters({ {Filter::Type::Unknown, FIELD_LOG_ID, "=", std::to_string(probe.id)} });
+    assert(byId.size() == 1 && byId.front().message == probe.message);
+
+    const size_t above = static_cast<size_t>(std::count_if(scanned.begin(), scanned.end(), [ & ](const int id)
+    {
+        return id > probe.id;
+    }));
+    assert(logger.getLogsByFilters({ {Filter::Type::Unknown, FIELD_LOG_ID, ">", std::to_string(probe.id)} }).size() == above);
+
+    LogManager::getInstance().removeLogger(config.name.value());
+    std::remove("test_shard_1.db");
+    std::remove("test_shard_2.db");
+
+    showMessage(testName + " passed!\n");
+}
+
+/**
+ * @brief Test for the zstd compression of the message column
+ */
+void testMessageCompression()
+{
+    std::string testName = "Message Compression test";
+    showMessage(testName + " started...");
+
+    LogConfig::Config config = getTestConfig();
+    config.syncMode = true;
+    config.useBatch = true;
+    config.batchSize = 500;
+    config.name = "compressed";
+    config.databaseTable = "compressed_logs";
+    config.compressMessages = true;
+
+    // Options the compressed text can't serve
+    LogConfig::Config invalid = config;
+    invalid.encryptMessages = true;
+    invalid.passKey = TEST_ENC_DEC_PASS_KEY;
+    assert(!invalid.validate().ok());
+    invalid = config;
+    invalid.fullTextSearch = true;
+    assert(!invalid.validate().ok());
+
+    if(!LogMessageCompressor::isSupported())
+    {
+        assert(!config.validate().ok());
+        bool thrown = false;
+        try
+        {
+            LogMessageCompressor compressor(config.databaseTable.value());
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        showMessage(testName + " passed!\n");
+        return;
+    }
+    assert(config.validate().ok());
+
+    const std::string dictTable = config.databaseTable.value() + LOG_ZSTD_TABLE_SUFFIX;
+    SQLiteDatabase verifyDb(config.databaseName.value());
+    verifyDb.connect(config.databaseName.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + dictTable);
+
+    // Enough long messages to train a dictionary, then compress the rest with it
+    constexpr int numLogs = 16000;
+    auto messageOf = [](const int i)
+    {
+        return i % 10 == 0
+               ? "ok " + std::to_string(i)
+               : "Request " + std::to_string(i) + " from client 10.0." + std::to_string(i % 256) + "." + std::to_string(i % 7)
+               + " finished with status " + (i % 3 ? "200" : "404") + " after " + std::to_string(i % 97) + " ms for /api/v1/items/"
+               + std::to_string(i % 50);
+    };
+
+    {
+        SQLogger& logger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+        for(int i = 0; i < numLogs; ++i)
+        {
+            SQLOG_INFO(logger) << messageOf(i);
+        }
+        logger.flush();
+
+        LogEntryList logs = logger.getLogsByLevel(LogLevel::Info);
+        assert(logs.size() == numLogs);
+        std::set<std::string> messages;
+        for(const auto & entry : logs)
+        {
+            messages.insert(entry.message);
+        }
+        assert(messages.count(messageOf(1)) && messages.count(messageOf(numLogs - 1)) && messages.count(messageOf(10)));
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    // Short messages stay plain, long ones are compressed once the dictionary exists
+    ResultSet stored = verifyDb.queryResultSet("SELECT " + std::string(FIELD_LOG_MESSAGE) + " FROM " + config.databaseTable.value() + ";");
+    assert(stored.rowCount() == numLogs);
+    size_t compressed = 0;
+    for(size_t row = 0; row < stored.rowCount(); ++row)
+    {
+        const std::string message = stored.getString(row, 0);
+        if(LogMessageCompressor::isCompressed(message))
+        {
+            ++compressed;
+        }
+        else
+        {
+            assert(message.rfind("ok ", 0) == 0 || message.rfind("Request ", 0) == 0);
+        }
+    }
+    assert(compressed > 0);
+    assert(verifyDb.queryResultSet("SELECT * FROM " + dictTable + ";").rowCount() >= 1);
+
+    // A new logger reads the stored dictionaries
+    {
+        SQLogger& logger = LogManager::getInstance().createLogger(config.name.value(), config
+#ifdef SQLG_USE_SOURCE_INFO
+                           , TEST_SOURCE_INFO
+#endif
+                                                                 );
+        LogEntryList logs = logger.getLogsByLevel(LogLevel::Info);
+        assert(logs.size() == numLogs);
+        for(const auto & entry : logs)
+        {
+            assert(!LogMessageCompressor::isCompressed(entry.message));
+        }
+        LogManager::getInstance().removeLogger(config.name.value());
+    }
+
+    LogMessageCompressor compressor(config.databaseTable.value());
+    assert(compressor.decompress("plain text").value() == "plain text");
+    assert(!compressor.decompress(std::string(LOG_ZSTD_PREFIX) + "1:AAAA").has_value()); // dictionary not loaded
+
+    verifyDb.execute("DROP TABLE IF EXISTS " + config.databaseTable.value());
+    verifyDb.execute("DROP TABLE IF EXISTS " + dictTable);
+    verifyDb.disconnect();
+
+    showMessage(testName + " passed!\n");
+}
+
+#ifdef SQLG_USE_GRPC
+/**
+ * @brief Test for the gRPC transport over loopback (push stream, pull stream, stats).
+ */
+void testGrpcTransport()
+{
+    std::string testName = "gRPC Transport test";
+    showMessage(testName + " started...");
+
+    const int total = 1500;
+    std::mutex mutex;
+    LogEntryList received;
+    std::atomic<uint64_t> statsLogged{ 0 };
+
+    LogConfig::Config serverConfig;
+    GrpcTransport server(serverConfig);
+    server.setLogBatchPushHandler([&](const LogEntryList & entries, std::function<void(bool)> callback)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.insert(received.end(), entries.begin(), entries.end());
+        }
+        callback(true);
+    });
+    server.setLogPullHandler([&](const std::vector<Filter> & filters, int limit, int offset,
+                                 std::function<void(LogEntryList)> callback)
+    {
+        assert(filters.size() == 1 && filters[0].value == LOG_LEVEL_INFO);
+        std::lock_guard<std::mutex> lock(mutex);
+        LogEntryList page;
+        for(int i = offset; i < static_cast<int>(received.size()) && (limit <= 0 || i < offset + limit); ++i)
+        {
+            page.push_back(received[i]);
+        }
+        callback(page);
+    });
+    server.setStatsHandler([&](const SQLogger::Stats & stats)
+    {
+        statsLogged = stats.totalLogged;
+    });
+    assert(server.start("127.0.0.1", 0));
+    assert(server.isRunning() && server.getPort() > 0);
+
+    LogConfig::Config clientConfig;
+    clientConfig.transportHost = "127.0.0.1";
+    clientConfig.transportPort = server.getPort();
+    clientConfig.transportBatchMaxInFlight = 2;
+    auto client = TransportFactory::create(TransportType::GRPC, clientConfig);
+
+    // Push through the batcher: 15 batches over one stream, acknowledged in order
+    {
+        TransportBatchPolicy policy = TransportBatchPolicy::fromConfig(clientConfig);
+        policy.maxEntries = 100;
+        TransportBatcher batcher(*client, policy);
+        std::atomic<int> acked{ 0 };
+        for(int i = 0; i < total; ++i)
+        {
+            LogEntry entry{};
+            entry.id = i + 1;
+            entry.level = LOG_LEVEL_INFO;
+            entry.message = "grpc " + std::to_string(i);
+            entry.function = __FUNCTION__;
+            entry.file = __FILE__;
+            entry.line = __LINE__;
+            batcher.push(entry, [&acked](bool success)
+            {
+                if(success) ++acked;
+            });
+        }
+        assert(batcher.flush());
+        assert(acked == total);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(received.size() == total);
+        for(int i = 0; i < total; ++i)
+        {
+            assert(received[i].message == "grpc " + std::to_string(i));
+        }
+    }
+
+    // Pull: the result spans more than one response block
+    auto pull = [&](int limit, int offset)
+    {
+        std::promise<LogEntryList> promise;
+        auto future = promise.get_future();
+        client->pullLogs({ {Filter::Type::Level, FIELD_LOG_LEVEL, "=", LOG_LEVEL_INFO} }, limit, offset,
+                         [&promise](LogEntryList entries)
+        {
+            promise.set_value(std::move(entries));
+        });
+        return future.get();
+    };
+    LogEntryList page = pull(0, 0);
+    assert(page.size() == total && page.back().message == "grpc " + std::to_string(total - 1));
+    page = pull(10, 100);
+    assert(page.size() == 10 && page.front().message == "grpc 100" && page.front().line == received[100].line);
+
+    // Stats
+    SQLogger::Stats stats;
+    stats.totalLogged = total;
+    stats.avgBatchSize = 12.5;
+    client->pushStats(stats);
+    for(int i = 0; i < 200 && statsLogged != total; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assert(statsLogged == total);
+    assert(client->getStats().bytesSent > 0 && client->getStats().bytesReceived > 0);
+
+    // Pushes to a stopped server fail
+    client->stop();
+    server.stop();
+    assert(!server.isRunning());
+    std::promise<bool> failed;
+    client->pushLogs(LogEntryList(3, received.front()), [&failed](bool success)
+    {
+        failed.set_value(success);
+    });
+    assert(!failed.get_future().get());
+
+    showMessage(testName + " passed!\n");
+}
+#endif
+
+/**
+ * @brief Cleanup function to shut down the logger.
+ */
+void cleanup()
+{
+    std::stringstream ss;
+    ss << "Shutdown " << (LogManager::getInstance().getCount() > 1
+                          ? "loggers: "
+                          : "logger: ");
+
+    auto loggersConfig = LogManager::getInstance().getAllLoggersConfigs();
+
+    std::vector<std::string> loggers;
+
+    for(auto & [name, config] : loggersConfig)
+    {
+        loggers.emplace_back(name);
+    }
+
+    ss << StringHelper::join(loggers, ", ");
+
+    showMessage(ss.str());
+    LogManager::getInstance().removeAllLoggers();
+}
+
+int main(int argc, char* argv[])
+{
+    // Parse args
+    std::string configFile = [ & ]()
+    {
+        if(argc > 1)
+        {
+            std::string arg = argv[1];
+            if(arg == "-h" || arg == "--help")
+            {
+                std::cout << SQLOGGER_DESCRIPTION << std::endl;
+                std::cout << "Usage: " << argv[0] << " [config.ini]" << std::endl;
+                exit(0);
+            }
+            else if(arg == "-v" || arg == "--version")
+            {
+                std::cout << SQLOGGER_PROJECT_NAME << " v." << SQLOGGER_VERSION_FULL << std::endl;
+                exit(0);
+            }
+            return arg;
+        }
+        return std::string();
+    }
+    ();
+
+    std::cout << SQLOGGER_PROJECT_NAME << " v." << SQLOGGER_VERSION_FULL << std::endl;
+
+    if(!configFile.empty())
+        std::cout << "Test config file: " << configFile << std::endl;
+
+    LogConfig::Config config = getTestConfig(configFile);
+
+    DataBaseType requestedDb = config.databaseType.value();
+
+    if(!DataBaseHelper::isDataBaseSupported(requestedDb))
+    {
+        std::cerr << "Requested database type " << DataBaseHelper::databaseTypeToString(requestedDb) <<  " not supported in this build";
+        return 1;
+    }
+
+    // Create logger
+    SQLogger& logger = getTestLogger(config);
+
+    std::string TEST_CONN_STRING =  LogConfig::configToConnectionString(config);
+
+    // Getting database type
+    DataBaseType dbType = logger.getDataBaseType();
+
+    // Getting string representation of the database type
+    std::stringstream dbTypeString;
+    dbTypeString << DataBaseHelper::databaseTypeToString(dbType);
+
+    std::cout << "Tested on: ";
+
+    switch(dbType)
+    {
+        case DataBaseType::Mock:
+        case DataBaseType::Memory:
+            dbTypeString << " data";
+            break;
+
+        case DataBaseType::SQLite:
+            dbTypeString << " database" << std::endl << "Database file: " << config.databaseName.value();
+            break;
+
+        case DataBaseType::MySQL:
+        case DataBaseType::PostgreSQL:
+        case DataBaseType::MongoDB:
+            dbTypeString << " database" << std::endl << "Connection string: " << TEST_CONN_STRING;
+            break;
+
+        default:
+            break;
+    }
+
+    std::cout << dbTypeString.str() << std::endl;
+
+    // Getting logger name
+    std::string loggerName = logger.getName();
+    std::cout << "Logger name: " << loggerName << std::endl;
+
+    // Getting sync mode
+    bool isSyncMode = logger.isSyncMode();
+    std::cout << "Sync Mode: " << (isSyncMode ? "ON" : "OFF") << std::endl;
+    std::cout << (isSyncMode ? "" : std::string("Number of threads: " + std::to_string(logger.getNumThreads()) + "\n"));
+
+    // Getting use batch
+    bool useBatch = logger.isBatchEnabled();
+    std::cout << "Batch Insert: " << (useBatch ? "ON" : "OFF") << std::endl;
+    std::cout << (useBatch ?  std::string("Batch size: " + std::to_string(logger.getBatchSize()) + "\n") : "");
+
+#ifdef SQLG_USE_SOURCE_INFO
+    std::cout << "Source Info: ON" << std::endl;
+#else
+    std::cout << "Source Info: OFF" << std::endl;
+#endif
+
+#ifdef SQLG_USE_AES
+    std::cout << "AES Support: ON" << std::endl;
+#else
+    std::cout << "AES Support: OFF" << std::endl;
+#endif
+
+    std::cout << std::endl;
+
+    try
+    {
+        testEncryptDecrypt();
+        testConfigSaveLoad();
+        testBasicFunctionality();
+        testFilterByLevel();
+        testFilterByFunction();
+        testFilterByThreadId();
+        testFilterByFile();
+        testFilterByTimestampRange();
+        testMultiFilters();
+        testLimitOffset();
+#ifdef SQLG_USE_SOURCE_INFO
+        testSourceInfo();
+        testGetSourceByUuid();
+        testGetAllSources();
 #endif
         testMultiThread();
+        testRingIngestion();
+        testAutoFlush();
+        testGroupCommit();
+        testGroupCommitFailure();
+        testSQLitePragmas();
+        testBulkLoad();
+        testTypedParams();
+        testResultSet();
+        testLogCursor();
+        testThreadPool();
+        testConnectionPool();
+        testDrainTracker();
+        testLogStream();
+        testLevelCheck();
+        testFormatApi();
+        testEpochTimestamps();
+        testCompactSchema();
+        testIndexConfig();
+        testStreamingExport();
+        testCompressedExport();
+        testNdjson();
+        testJsonParser();
+        testBinaryFormat();
+        testTransportBatching();
+        testLogCollector();
+    testSpool();
+    testErrorLog();
+    testLatencyStats();
+    testMetrics();
+    testMemoryDatabase();
+    testTailCache();
+    testReadPool();
+    testDeletePlaceholders();
+    testPartitions();
+    testFullTextSearch();
+    testAggregation();
+    testQueryTextCache();
+    testBufferPool();
+    testAdaptiveBatch();
+    testPriorityLevel();
+    testThrottle();
+    testFileSink();
+    testThreadSettings();
+    testConfigSource();
+    testSchemaVersion();
+    testSharedConnection();
+    testMessageEncryption();
+    testColumnarExport();
+    testAsyncQueries();
+    testSharding();
+    testMessageCompression();
+#ifdef SQLG_USE_GRPC
+        testGrpcTransport();
+#endif
+#ifdef SQLG_USE_SOURCE_INFO
+        testSourceLookup();
+#endif
         testFileExport();
         testClearLogs();
         testPerformance();